@@ -0,0 +1,931 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CoreStd.h"
+#include "base/job-system/JobSystem.h"
+
+#include "base/CompressedTextureDecoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace cc {
+
+namespace {
+
+// The inner loops are written as plain fixed-size loops over the 4 channels of a texel so the
+// compiler can vectorize them (SSE2/NEON), there is no hand written intrinsics path to maintain.
+
+constexpr uint32_t MIN_BLOCK_ROWS_PER_JOB = 4;
+
+inline uint8_t clampByte(int value) {
+    return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+inline uint32_t readBE32(const uint8_t *p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+inline uint64_t readLE64(const uint8_t *p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) value = (value << 8) | p[i];
+    return value;
+}
+
+inline uint64_t reverseBits64(uint64_t v) {
+    v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+    v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+    v = ((v >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((v & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    v = ((v >> 8) & 0x00FF00FF00FF00FFULL) | ((v & 0x00FF00FF00FF00FFULL) << 8);
+    v = ((v >> 16) & 0x0000FFFF0000FFFFULL) | ((v & 0x0000FFFF0000FFFFULL) << 16);
+    return (v >> 32) | (v << 32);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// ETC1 / ETC2 / EAC
+
+constexpr int ETC1_MODIFIERS[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+constexpr int ETC2_DISTANCES[8]    = {3, 6, 11, 16, 23, 32, 41, 64};
+constexpr int EAC_MODIFIERS[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8},
+};
+
+inline int extend4(uint32_t c) { return static_cast<int>((c & 0xF) * 17); }
+inline int extend5(uint32_t c) { return static_cast<int>(((c & 0x1F) << 3) | ((c & 0x1F) >> 2)); }
+inline int extend6(uint32_t c) { return static_cast<int>(((c & 0x3F) << 2) | ((c & 0x3F) >> 4)); }
+inline int extend7(uint32_t c) { return static_cast<int>(((c & 0x7F) << 1) | ((c & 0x7F) >> 6)); }
+inline int signExtend3(uint32_t c) { return static_cast<int>(c & 3) - static_cast<int>(c & 4); }
+
+// Pixels of an ETC block are indexed column major: i = x * 4 + y.
+inline uint32_t etcPixelIndex(uint32_t lo, uint32_t i) {
+    return (((lo >> (16 + i)) & 1) << 1) | ((lo >> i) & 1);
+}
+
+// Decodes the 8 byte ETC1/ETC2 color block into texels (RGBA8, row major, alpha untouched).
+void decodeEtcColorBlock(const uint8_t *block, bool etc2, uint8_t *texels) {
+    const uint32_t hi = readBE32(block);
+    const uint32_t lo = readBE32(block + 4);
+
+    int base[2][3];
+    if (hi & 2) {
+        const int r = static_cast<int>((hi >> 27) & 0x1F) + signExtend3(hi >> 24);
+        const int g = static_cast<int>((hi >> 19) & 0x1F) + signExtend3(hi >> 16);
+        const int b = static_cast<int>((hi >> 11) & 0x1F) + signExtend3(hi >> 8);
+
+        if (etc2 && (r < 0 || r > 31 || g < 0 || g > 31 || b < 0 || b > 31)) {
+            int paint[4][3];
+            if (r < 0 || r > 31) { // T mode
+                const int c1[3] = {extend4((((hi >> 27) & 3) << 2) | ((hi >> 24) & 3)), extend4(hi >> 20), extend4(hi >> 16)};
+                const int c2[3] = {extend4(hi >> 12), extend4(hi >> 8), extend4(hi >> 4)};
+                const int d     = ETC2_DISTANCES[(((hi >> 2) & 3) << 1) | (hi & 1)];
+                for (int c = 0; c < 3; ++c) {
+                    paint[0][c] = c1[c];
+                    paint[1][c] = c2[c] + d;
+                    paint[2][c] = c2[c];
+                    paint[3][c] = c2[c] - d;
+                }
+            } else if (g < 0 || g > 31) { // H mode
+                const uint32_t r1 = (hi >> 27) & 0xF;
+                const uint32_t g1 = (((hi >> 24) & 7) << 1) | ((hi >> 20) & 1);
+                const uint32_t b1 = (((hi >> 19) & 1) << 3) | ((hi >> 15) & 7);
+                const uint32_t r2 = (hi >> 11) & 0xF;
+                const uint32_t g2 = (hi >> 7) & 0xF;
+                const uint32_t b2 = (hi >> 3) & 0xF;
+                const uint32_t v1 = (r1 << 8) | (g1 << 4) | b1;
+                const uint32_t v2 = (r2 << 8) | (g2 << 4) | b2;
+                const int d       = ETC2_DISTANCES[(((hi >> 2) & 1) << 2) | ((hi & 1) << 1) | (v1 >= v2 ? 1 : 0)];
+                const int c1[3]   = {extend4(r1), extend4(g1), extend4(b1)};
+                const int c2[3]   = {extend4(r2), extend4(g2), extend4(b2)};
+                for (int c = 0; c < 3; ++c) {
+                    paint[0][c] = c1[c] + d;
+                    paint[1][c] = c1[c] - d;
+                    paint[2][c] = c2[c] + d;
+                    paint[3][c] = c2[c] - d;
+                }
+            } else { // planar mode
+                const int ro = extend6(hi >> 25);
+                const int go = extend7((((hi >> 24) & 1) << 6) | ((hi >> 17) & 0x3F));
+                const int bo = extend6((((hi >> 16) & 1) << 5) | (((hi >> 11) & 3) << 3) | ((hi >> 7) & 7));
+                const int rh = extend6((((hi >> 2) & 0x1F) << 1) | (hi & 1));
+                const int gh = extend7(lo >> 25);
+                const int bh = extend6(lo >> 19);
+                const int rv = extend6(lo >> 13);
+                const int gv = extend7(lo >> 6);
+                const int bv = extend6(lo);
+                for (int y = 0; y < 4; ++y) {
+                    for (int x = 0; x < 4; ++x) {
+                        uint8_t *t = texels + (y * 4 + x) * 4;
+                        t[0]       = clampByte((x * (rh - ro) + y * (rv - ro) + 4 * ro + 2) >> 2);
+                        t[1]       = clampByte((x * (gh - go) + y * (gv - go) + 4 * go + 2) >> 2);
+                        t[2]       = clampByte((x * (bh - bo) + y * (bv - bo) + 4 * bo + 2) >> 2);
+                    }
+                }
+                return;
+            }
+
+            for (uint32_t i = 0; i < 16; ++i) {
+                const int *p = paint[etcPixelIndex(lo, i)];
+                uint8_t *t   = texels + ((i & 3) * 4 + (i >> 2)) * 4;
+                t[0]         = clampByte(p[0]);
+                t[1]         = clampByte(p[1]);
+                t[2]         = clampByte(p[2]);
+            }
+            return;
+        }
+
+        base[0][0] = extend5(hi >> 27);
+        base[0][1] = extend5(hi >> 19);
+        base[0][2] = extend5(hi >> 11);
+        base[1][0] = extend5(static_cast<uint32_t>(r));
+        base[1][1] = extend5(static_cast<uint32_t>(g));
+        base[1][2] = extend5(static_cast<uint32_t>(b));
+    } else {
+        base[0][0] = extend4(hi >> 28);
+        base[1][0] = extend4(hi >> 24);
+        base[0][1] = extend4(hi >> 20);
+        base[1][1] = extend4(hi >> 16);
+        base[0][2] = extend4(hi >> 12);
+        base[1][2] = extend4(hi >> 8);
+    }
+
+    const int *modifiers[2] = {ETC1_MODIFIERS[(hi >> 5) & 7], ETC1_MODIFIERS[(hi >> 2) & 7]};
+    const bool flip         = hi & 1;
+    for (uint32_t i = 0; i < 16; ++i) {
+        const uint32_t x     = i >> 2;
+        const uint32_t y     = i & 3;
+        const uint32_t sub   = flip ? (y >= 2) : (x >= 2);
+        const uint32_t index = etcPixelIndex(lo, i);
+        const int magnitude  = modifiers[sub][index & 1];
+        const int delta      = (index & 2) ? -magnitude : magnitude;
+        uint8_t *t           = texels + (y * 4 + x) * 4;
+        for (int c = 0; c < 3; ++c) t[c] = clampByte(base[sub][c] + delta);
+    }
+}
+
+// Decodes an 8 byte EAC block into channel `channel` of the RGBA8 texels.
+void decodeEacBlock(const uint8_t *block, bool eleven, uint8_t *texels, uint32_t channel) {
+    const int base       = block[0];
+    const int multiplier = block[1] >> 4;
+    const int *table     = EAC_MODIFIERS[block[1] & 0xF];
+    uint64_t indices     = 0;
+    for (int i = 2; i < 8; ++i) indices = (indices << 8) | block[i];
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        const int modifier = table[(indices >> (45 - 3 * i)) & 7];
+        int value;
+        if (eleven) {
+            value = base * 8 + 4 + modifier * (multiplier ? multiplier * 8 : 1);
+            value = std::min(std::max(value, 0), 2047) >> 3;
+        } else {
+            value = base + modifier * multiplier;
+        }
+        texels[((i & 3) * 4 + (i >> 2)) * 4 + channel] = clampByte(value);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// ASTC (2D, LDR profile)
+
+struct IseQuant {
+    uint8_t trits;
+    uint8_t quints;
+    uint8_t bits;
+};
+
+// Indexed by quantization method, QUANT_2 .. QUANT_256.
+constexpr IseQuant ISE_QUANTS[21] = {
+    {0, 0, 1}, {1, 0, 0}, {0, 0, 2}, {0, 1, 0}, {1, 0, 1}, {0, 0, 3}, {0, 1, 1}, {1, 0, 2}, {0, 0, 4}, {0, 1, 2}, {1, 0, 3}, {0, 0, 5}, {0, 1, 3}, {1, 0, 4}, {0, 0, 6}, {0, 1, 4}, {1, 0, 5}, {0, 0, 7}, {0, 1, 5}, {1, 0, 6}, {0, 0, 8}};
+
+constexpr uint32_t QUANT_6            = 4;
+constexpr uint32_t MAX_COLOR_VALUES   = 18;
+constexpr uint32_t MAX_WEIGHTS        = 64;
+constexpr uint32_t MAX_BLOCK_TEXELS   = 144;
+constexpr uint8_t ASTC_ERROR_COLOR[4] = {255, 0, 255, 255};
+
+struct BitStream {
+    uint64_t lo;
+    uint64_t hi;
+
+    // Reads count (<= 32) bits starting at bit start, bits at or above `end` read as zero.
+    uint32_t read(uint32_t start, uint32_t count, uint32_t end = 128) const {
+        if (start >= end || count == 0) return 0;
+        count = std::min(count, end - start);
+        uint64_t value;
+        if (start >= 64) {
+            value = hi >> (start - 64);
+        } else if (start + count <= 64) {
+            value = lo >> start;
+        } else {
+            value = (lo >> start) | (hi << (64 - start));
+        }
+        return static_cast<uint32_t>(value & ((1ULL << count) - 1));
+    }
+};
+
+uint32_t iseBitCount(uint32_t count, uint32_t quant) {
+    const IseQuant &q = ISE_QUANTS[quant];
+    return q.bits * count + (q.trits ? (8 * count + 4) / 5 : 0) + (q.quints ? (7 * count + 2) / 3 : 0);
+}
+
+void decodeTrits(uint32_t t, uint32_t out[5]) {
+    uint32_t c;
+    if (((t >> 2) & 7) == 7) {
+        c      = (((t >> 5) & 7) << 2) | (t & 3);
+        out[4] = 2;
+        out[3] = 2;
+    } else {
+        c = t & 0x1F;
+        if (((t >> 5) & 3) == 3) {
+            out[4] = 2;
+            out[3] = (t >> 7) & 1;
+        } else {
+            out[4] = (t >> 7) & 1;
+            out[3] = (t >> 5) & 3;
+        }
+    }
+    if ((c & 3) == 3) {
+        out[2] = 2;
+        out[1] = (c >> 4) & 1;
+        out[0] = (((c >> 3) & 1) << 1) | ((c >> 2) & 1 & ~(c >> 3));
+    } else if (((c >> 2) & 3) == 3) {
+        out[2] = 2;
+        out[1] = 2;
+        out[0] = c & 3;
+    } else {
+        out[2] = (c >> 4) & 1;
+        out[1] = (c >> 2) & 3;
+        out[0] = (((c >> 1) & 1) << 1) | (c & 1 & ~(c >> 1));
+    }
+}
+
+void decodeQuints(uint32_t q, uint32_t out[3]) {
+    if (((q >> 1) & 3) == 3 && ((q >> 5) & 3) == 0) {
+        out[2] = ((q & 1) << 2) | ((((q >> 4) & 1) & ~q & 1) << 1) | (((q >> 3) & 1) & ~q & 1);
+        out[1] = 4;
+        out[0] = 4;
+        return;
+    }
+    uint32_t c;
+    if (((q >> 1) & 3) == 3) {
+        out[2] = 4;
+        c      = (((q >> 3) & 3) << 3) | ((~(q >> 5) & 3) << 1) | (q & 1);
+    } else {
+        out[2] = (q >> 5) & 3;
+        c      = q & 0x1F;
+    }
+    if ((c & 7) == 5) {
+        out[1] = 4;
+        out[0] = (c >> 3) & 3;
+    } else {
+        out[1] = (c >> 3) & 3;
+        out[0] = c & 7;
+    }
+}
+
+// Decodes count integer sequence encoded values; each output is (trit/quint << bits) | bits.
+void decodeIse(const BitStream &stream, uint32_t start, uint32_t count, uint32_t quant, uint8_t *out) {
+    const IseQuant &q  = ISE_QUANTS[quant];
+    const uint32_t end = start + iseBitCount(count, quant);
+    const uint32_t n   = q.bits;
+    uint32_t pos       = start;
+
+    if (q.trits) {
+        for (uint32_t i = 0; i < count; i += 5) {
+            uint32_t m[5];
+            uint32_t t = 0;
+            m[0]       = stream.read(pos, n, end), pos += n;
+            t |= stream.read(pos, 2, end), pos += 2;
+            m[1] = stream.read(pos, n, end), pos += n;
+            t |= stream.read(pos, 2, end) << 2, pos += 2;
+            m[2] = stream.read(pos, n, end), pos += n;
+            t |= stream.read(pos, 1, end) << 4, pos += 1;
+            m[3] = stream.read(pos, n, end), pos += n;
+            t |= stream.read(pos, 2, end) << 5, pos += 2;
+            m[4] = stream.read(pos, n, end), pos += n;
+            t |= stream.read(pos, 1, end) << 7, pos += 1;
+            uint32_t trits[5];
+            decodeTrits(t, trits);
+            for (uint32_t j = 0; j < 5 && i + j < count; ++j) out[i + j] = static_cast<uint8_t>((trits[j] << n) | m[j]);
+        }
+    } else if (q.quints) {
+        for (uint32_t i = 0; i < count; i += 3) {
+            uint32_t m[3];
+            uint32_t v = 0;
+            m[0]       = stream.read(pos, n, end), pos += n;
+            v |= stream.read(pos, 3, end), pos += 3;
+            m[1] = stream.read(pos, n, end), pos += n;
+            v |= stream.read(pos, 2, end) << 3, pos += 2;
+            m[2] = stream.read(pos, n, end), pos += n;
+            v |= stream.read(pos, 2, end) << 5, pos += 2;
+            uint32_t quints[3];
+            decodeQuints(v, quints);
+            for (uint32_t j = 0; j < 3 && i + j < count; ++j) out[i + j] = static_cast<uint8_t>((quints[j] << n) | m[j]);
+        }
+    } else {
+        for (uint32_t i = 0; i < count; ++i, pos += n) out[i] = static_cast<uint8_t>(stream.read(pos, n, end));
+    }
+}
+
+uint32_t replicateBits(uint32_t value, uint32_t bits, uint32_t targetBits) {
+    uint32_t result = 0;
+    int shift       = static_cast<int>(targetBits);
+    while (shift > 0) {
+        shift -= static_cast<int>(bits);
+        result |= shift >= 0 ? value << shift : value >> -shift;
+    }
+    return result & ((1U << targetBits) - 1);
+}
+
+uint8_t unquantizeColor(uint32_t value, uint32_t quant) {
+    const IseQuant &q = ISE_QUANTS[quant];
+    const uint32_t n  = q.bits;
+    if (!q.trits && !q.quints) return static_cast<uint8_t>(replicateBits(value, n, 8));
+
+    const uint32_t m = value & ((1U << n) - 1);
+    const uint32_t d = value >> n;
+    const uint32_t a = (m & 1) ? 0x1FF : 0;
+    const uint32_t b = (m >> 1) & 1;
+    const uint32_t c = (m >> 2) & 1;
+    uint32_t bb      = 0;
+    uint32_t cc      = 0;
+    if (q.trits) {
+        switch (n) {
+            case 1: cc = 204; break;
+            case 2: cc = 93, bb = b * 0x116; break;
+            case 3: cc = 44, bb = c * 0x10A + b * 0x85; break;
+            case 4: cc = 22, bb = (((m >> 1) & 7) << 6) | ((m >> 1) & 7); break;
+            case 5: cc = 11, bb = (((m >> 1) & 0xF) << 5) | ((m >> 3) & 3); break;
+            default: cc = 5, bb = (((m >> 1) & 0x1F) << 4) | ((m >> 5) & 1); break;
+        }
+    } else {
+        switch (n) {
+            case 1: cc = 113; break;
+            case 2: cc = 54, bb = b * 0x10C; break;
+            case 3: cc = 26, bb = c * 0x105 + b * 0x82; break;
+            case 4: cc = 13, bb = (((m >> 1) & 7) << 6) | ((m >> 2) & 3); break;
+            default: cc = 6, bb = (((m >> 1) & 0xF) << 5) | ((m >> 4) & 1); break;
+        }
+    }
+    uint32_t t = (d * cc + bb) ^ a;
+    return static_cast<uint8_t>((a & 0x80) | (t >> 2));
+}
+
+uint8_t unquantizeWeight(uint32_t value, uint32_t quant) {
+    const IseQuant &q = ISE_QUANTS[quant];
+    const uint32_t n  = q.bits;
+    uint32_t t;
+    if (!q.trits && !q.quints) {
+        t = replicateBits(value, n, 6);
+    } else if (n == 0) {
+        constexpr uint8_t TRIT_VALUES[3]  = {0, 32, 63};
+        constexpr uint8_t QUINT_VALUES[5] = {0, 16, 32, 47, 63};
+        t                                 = q.trits ? TRIT_VALUES[value] : QUINT_VALUES[value];
+    } else {
+        const uint32_t m = value & ((1U << n) - 1);
+        const uint32_t d = value >> n;
+        const uint32_t a = (m & 1) ? 0x7F : 0;
+        const uint32_t b = (m >> 1) & 1;
+        const uint32_t c = (m >> 2) & 1;
+        uint32_t bb      = 0;
+        uint32_t cc      = 0;
+        if (q.trits) {
+            switch (n) {
+                case 1: cc = 50; break;
+                case 2: cc = 23, bb = b * 0x45; break;
+                default: cc = 11, bb = c * 0x41 + b * 0x20; break;
+            }
+        } else {
+            switch (n) {
+                case 1: cc = 28; break;
+                default: cc = 13, bb = b * 0x42; break;
+            }
+        }
+        t = (d * cc + bb) ^ a;
+        t = (a & 0x20) | (t >> 2);
+    }
+    return static_cast<uint8_t>(t > 32 ? t + 1 : t);
+}
+
+struct AstcBlockMode {
+    uint32_t weightsX;
+    uint32_t weightsY;
+    uint32_t weightQuant;
+    bool dualPlane;
+};
+
+// Follows the 2D block mode layout table of the ASTC specification.
+bool decodeBlockMode(uint32_t mode, AstcBlockMode *out) {
+    uint32_t quant   = (mode >> 4) & 1;
+    uint32_t high    = (mode >> 9) & 1;
+    uint32_t dual    = (mode >> 10) & 1;
+    const uint32_t a = (mode >> 5) & 3;
+
+    if (mode & 3) {
+        quant |= (mode & 3) << 1;
+        const uint32_t b = (mode >> 7) & 3;
+        switch ((mode >> 2) & 3) {
+            case 0: out->weightsX = b + 4, out->weightsY = a + 2; break;
+            case 1: out->weightsX = b + 8, out->weightsY = a + 2; break;
+            case 2: out->weightsX = a + 2, out->weightsY = b + 8; break;
+            default:
+                if (mode & 0x100) {
+                    out->weightsX = (b & 1) + 2, out->weightsY = a + 2;
+                } else {
+                    out->weightsX = a + 2, out->weightsY = (b & 1) + 6;
+                }
+                break;
+        }
+    } else {
+        if (((mode >> 2) & 3) == 0) return false; // reserved
+        quant |= ((mode >> 2) & 3) << 1;
+        const uint32_t b = (mode >> 9) & 3;
+        switch ((mode >> 7) & 3) {
+            case 0: out->weightsX = 12, out->weightsY = a + 2; break;
+            case 1: out->weightsX = a + 2, out->weightsY = 12; break;
+            case 2:
+                out->weightsX = a + 6, out->weightsY = b + 6;
+                dual = high = 0;
+                break;
+            default:
+                if (a == 0) {
+                    out->weightsX = 6, out->weightsY = 10;
+                } else if (a == 1) {
+                    out->weightsX = 10, out->weightsY = 6;
+                } else {
+                    return false; // reserved
+                }
+                break;
+        }
+    }
+
+    out->weightQuant = (quant - 2) + 6 * high;
+    out->dualPlane   = dual != 0;
+    return true;
+}
+
+inline void bitTransferSigned(int &a, int &b) {
+    b >>= 1;
+    b |= a & 0x80;
+    a >>= 1;
+    a &= 0x3F;
+    if (a & 0x20) a -= 0x40;
+}
+
+inline void blueContract(int c[4]) {
+    c[0] = (c[0] + c[2]) >> 1;
+    c[1] = (c[1] + c[2]) >> 1;
+}
+
+// Decodes the endpoints of one partition, returns false for HDR and reserved endpoint modes.
+bool decodeEndpoints(uint32_t mode, const uint8_t *values, uint8_t e0[4], uint8_t e1[4]) {
+    int v[8];
+    for (uint32_t i = 0; i < 8; ++i) v[i] = i < 2 * ((mode >> 2) + 1) ? values[i] : 0;
+
+    int c0[4];
+    int c1[4];
+    switch (mode) {
+        case 0: // luminance, direct
+            c0[0] = c0[1] = c0[2] = v[0], c0[3] = 255;
+            c1[0] = c1[1] = c1[2] = v[1], c1[3] = 255;
+            break;
+        case 1: { // luminance, base + offset
+            const int l0 = (v[0] >> 2) | (v[1] & 0xC0);
+            const int l1 = std::min(l0 + (v[1] & 0x3F), 255);
+            c0[0] = c0[1] = c0[2] = l0, c0[3] = 255;
+            c1[0] = c1[1] = c1[2] = l1, c1[3] = 255;
+            break;
+        }
+        case 4: // luminance + alpha, direct
+            c0[0] = c0[1] = c0[2] = v[0], c0[3] = v[2];
+            c1[0] = c1[1] = c1[2] = v[1], c1[3] = v[3];
+            break;
+        case 5: // luminance + alpha, base + offset
+            bitTransferSigned(v[1], v[0]);
+            bitTransferSigned(v[3], v[2]);
+            c0[0] = c0[1] = c0[2] = v[0], c0[3] = v[2];
+            c1[0] = c1[1] = c1[2] = v[0] + v[1], c1[3] = v[2] + v[3];
+            break;
+        case 6:  // RGB, base + scale
+        case 10: // RGB, base + scale, plus two alpha
+            c0[0] = (v[0] * v[3]) >> 8, c0[1] = (v[1] * v[3]) >> 8, c0[2] = (v[2] * v[3]) >> 8;
+            c1[0] = v[0], c1[1] = v[1], c1[2] = v[2];
+            c0[3] = mode == 10 ? v[4] : 255;
+            c1[3] = mode == 10 ? v[5] : 255;
+            break;
+        case 8:  // RGB, direct
+        case 12: // RGBA, direct
+            c0[0] = v[0], c0[1] = v[2], c0[2] = v[4], c0[3] = mode == 12 ? v[6] : 255;
+            c1[0] = v[1], c1[1] = v[3], c1[2] = v[5], c1[3] = mode == 12 ? v[7] : 255;
+            if (v[1] + v[3] + v[5] < v[0] + v[2] + v[4]) {
+                std::swap(c0, c1);
+                blueContract(c0);
+                blueContract(c1);
+            }
+            break;
+        case 9:  // RGB, base + offset
+        case 13: // RGBA, base + offset
+            bitTransferSigned(v[1], v[0]);
+            bitTransferSigned(v[3], v[2]);
+            bitTransferSigned(v[5], v[4]);
+            if (mode == 13) {
+                bitTransferSigned(v[7], v[6]);
+            } else {
+                v[6] = 255, v[7] = 0;
+            }
+            c0[0] = v[0], c0[1] = v[2], c0[2] = v[4], c0[3] = v[6];
+            c1[0] = v[0] + v[1], c1[1] = v[2] + v[3], c1[2] = v[4] + v[5], c1[3] = v[6] + v[7];
+            if (v[1] + v[3] + v[5] < 0) {
+                std::swap(c0, c1);
+                blueContract(c0);
+                blueContract(c1);
+            }
+            break;
+        default: // HDR or reserved
+            return false;
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        e0[i] = clampByte(c0[i]);
+        e1[i] = clampByte(c1[i]);
+    }
+    return true;
+}
+
+uint32_t hashPartitionSeed(uint32_t p) {
+    p ^= p >> 15;
+    p *= 0xEEDE0891; // (2^4 + 1) * (2^7 + 1) * (2^17 - 1)
+    p ^= p >> 5;
+    p += p << 16;
+    p ^= p >> 7;
+    p ^= p >> 3;
+    p ^= p << 6;
+    p ^= p >> 17;
+    return p;
+}
+
+// Partition selection function of the ASTC specification, for 2D blocks.
+uint32_t selectPartition(uint32_t seed, uint32_t x, uint32_t y, uint32_t partitionCount, bool smallBlock) {
+    if (smallBlock) {
+        x <<= 1;
+        y <<= 1;
+    }
+    seed += (partitionCount - 1) * 1024;
+    const uint32_t rnum = hashPartitionSeed(seed);
+
+    uint32_t s[8];
+    for (uint32_t i = 0; i < 8; ++i) {
+        s[i] = (rnum >> (i * 4)) & 0xF;
+        s[i] *= s[i];
+    }
+
+    uint32_t sh1;
+    uint32_t sh2;
+    if (seed & 1) {
+        sh1 = (seed & 2) ? 4 : 5;
+        sh2 = partitionCount == 3 ? 6 : 5;
+    } else {
+        sh1 = partitionCount == 3 ? 6 : 5;
+        sh2 = (seed & 2) ? 4 : 5;
+    }
+    for (uint32_t i = 0; i < 8; i += 2) {
+        s[i] >>= sh1;
+        s[i + 1] >>= sh2;
+    }
+
+    const uint32_t a = (s[0] * x + s[1] * y + (rnum >> 14)) & 0x3F;
+    const uint32_t b = (s[2] * x + s[3] * y + (rnum >> 10)) & 0x3F;
+    const uint32_t c = partitionCount < 3 ? 0 : (s[4] * x + s[5] * y + (rnum >> 6)) & 0x3F;
+    const uint32_t d = partitionCount < 4 ? 0 : (s[6] * x + s[7] * y + (rnum >> 2)) & 0x3F;
+
+    if (a >= b && a >= c && a >= d) return 0;
+    if (b >= c && b >= d) return 1;
+    if (c >= d) return 2;
+    return 3;
+}
+
+void fillAstcErrorBlock(uint32_t texelCount, uint8_t *texels) {
+    for (uint32_t i = 0; i < texelCount; ++i) memcpy(texels + i * 4, ASTC_ERROR_COLOR, 4);
+}
+
+// Decodes one ASTC block into blockWidth * blockHeight RGBA8 texels.
+void decodeAstcBlock(const uint8_t *block, uint32_t blockWidth, uint32_t blockHeight, bool srgb, uint8_t *texels) {
+    const BitStream stream{readLE64(block), readLE64(block + 8)};
+    const uint32_t texelCount = blockWidth * blockHeight;
+    const uint32_t mode       = stream.read(0, 11);
+
+    if ((mode & 0x1FF) == 0x1FC) { // void extent, a single color
+        if (mode & 0x200) {
+            fillAstcErrorBlock(texelCount, texels); // HDR
+            return;
+        }
+        uint8_t color[4];
+        for (uint32_t c = 0; c < 4; ++c) color[c] = static_cast<uint8_t>(stream.read(64 + c * 16, 16) >> 8);
+        for (uint32_t i = 0; i < texelCount; ++i) memcpy(texels + i * 4, color, 4);
+        return;
+    }
+
+    AstcBlockMode blockMode;
+    if (!decodeBlockMode(mode, &blockMode) || blockMode.weightsX > blockWidth || blockMode.weightsY > blockHeight) {
+        fillAstcErrorBlock(texelCount, texels);
+        return;
+    }
+
+    const uint32_t partitionCount = stream.read(11, 2) + 1;
+    const uint32_t planeCount     = blockMode.dualPlane ? 2 : 1;
+    const uint32_t gridSize       = blockMode.weightsX * blockMode.weightsY;
+    const uint32_t weightCount    = gridSize * planeCount;
+    const uint32_t weightBits     = iseBitCount(weightCount, blockMode.weightQuant);
+    if (weightCount > MAX_WEIGHTS || weightBits < 24 || weightBits > 96 || (blockMode.dualPlane && partitionCount == 4)) {
+        fillAstcErrorBlock(texelCount, texels);
+        return;
+    }
+
+    uint32_t endpointModes[4];
+    uint32_t partitionSeed = 0;
+    uint32_t colorStart    = 17;
+    uint32_t extraCemBits  = 0;
+    if (partitionCount == 1) {
+        endpointModes[0] = stream.read(13, 4);
+    } else {
+        partitionSeed          = stream.read(13, 10);
+        colorStart             = 29;
+        const uint32_t cemBits = stream.read(23, 6);
+        const uint32_t classes = cemBits & 3;
+        if (classes == 0) {
+            for (uint32_t i = 0; i < partitionCount; ++i) endpointModes[i] = cemBits >> 2;
+        } else {
+            extraCemBits           = 3 * partitionCount - 4;
+            const uint32_t encoded = cemBits | (stream.read(128 - weightBits - extraCemBits, extraCemBits) << 6);
+            for (uint32_t i = 0; i < partitionCount; ++i) {
+                const uint32_t c = (encoded >> (2 + i)) & 1;
+                const uint32_t m = (encoded >> (2 + partitionCount + 2 * i)) & 3;
+                endpointModes[i] = ((classes - 1 + c) << 2) | m;
+            }
+        }
+    }
+
+    const uint32_t colorEnd      = 128 - weightBits - extraCemBits - (blockMode.dualPlane ? 2 : 0);
+    const uint32_t dualComponent = blockMode.dualPlane ? stream.read(colorEnd, 2) : 4;
+
+    uint32_t valueCount = 0;
+    for (uint32_t i = 0; i < partitionCount; ++i) valueCount += 2 * ((endpointModes[i] >> 2) + 1);
+    if (valueCount > MAX_COLOR_VALUES || colorEnd <= colorStart) {
+        fillAstcErrorBlock(texelCount, texels);
+        return;
+    }
+
+    uint32_t colorQuant = 20;
+    while (colorQuant >= QUANT_6 && iseBitCount(valueCount, colorQuant) > colorEnd - colorStart) --colorQuant;
+    if (colorQuant < QUANT_6) {
+        fillAstcErrorBlock(texelCount, texels);
+        return;
+    }
+
+    uint8_t values[MAX_COLOR_VALUES];
+    decodeIse(stream, colorStart, valueCount, colorQuant, values);
+    for (uint32_t i = 0; i < valueCount; ++i) values[i] = unquantizeColor(values[i], colorQuant);
+
+    uint8_t endpoints[4][2][4];
+    for (uint32_t i = 0, offset = 0; i < partitionCount; ++i) {
+        if (!decodeEndpoints(endpointModes[i], values + offset, endpoints[i][0], endpoints[i][1])) {
+            fillAstcErrorBlock(texelCount, texels);
+            return;
+        }
+        offset += 2 * ((endpointModes[i] >> 2) + 1);
+    }
+
+    // weights are stored bit reversed from the top of the block
+    const BitStream reversed{reverseBits64(stream.hi), reverseBits64(stream.lo)};
+    uint8_t weights[MAX_WEIGHTS];
+    decodeIse(reversed, 0, weightCount, blockMode.weightQuant, weights);
+    for (uint32_t i = 0; i < weightCount; ++i) weights[i] = unquantizeWeight(weights[i], blockMode.weightQuant);
+
+    // infill the weight grid to the texel footprint, bilinearly
+    const uint32_t ds = (1024 + blockWidth / 2) / (blockWidth - 1);
+    const uint32_t dt = (1024 + blockHeight / 2) / (blockHeight - 1);
+    const bool smallBlock = texelCount < 31;
+    for (uint32_t y = 0; y < blockHeight; ++y) {
+        for (uint32_t x = 0; x < blockWidth; ++x) {
+            const uint32_t gs  = (ds * x * (blockMode.weightsX - 1) + 32) >> 6;
+            const uint32_t gt  = (dt * y * (blockMode.weightsY - 1) + 32) >> 6;
+            const uint32_t js  = gs >> 4;
+            const uint32_t fs  = gs & 0xF;
+            const uint32_t jt  = gt >> 4;
+            const uint32_t ft  = gt & 0xF;
+            const uint32_t w11 = (fs * ft + 8) >> 4;
+            const uint32_t w10 = ft - w11;
+            const uint32_t w01 = fs - w11;
+            const uint32_t w00 = 16 - fs - ft + w11;
+            const uint32_t v0  = js + jt * blockMode.weightsX;
+
+            uint32_t planeWeights[2];
+            for (uint32_t p = 0; p < planeCount; ++p) {
+                auto weightAt = [&](uint32_t index) -> uint32_t {
+                    return index < gridSize ? weights[index * planeCount + p] : 0;
+                };
+                planeWeights[p] = (weightAt(v0) * w00 + weightAt(v0 + 1) * w01 + weightAt(v0 + blockMode.weightsX) * w10 +
+                                   weightAt(v0 + blockMode.weightsX + 1) * w11 + 8) >>
+                                  4;
+            }
+
+            const uint32_t partition = partitionCount > 1 ? selectPartition(partitionSeed, x, y, partitionCount, smallBlock) : 0;
+            const uint8_t *e0        = endpoints[partition][0];
+            const uint8_t *e1        = endpoints[partition][1];
+            uint8_t *t               = texels + (y * blockWidth + x) * 4;
+            for (uint32_t c = 0; c < 4; ++c) {
+                const uint32_t w  = planeWeights[c == dualComponent ? 1 : 0];
+                const uint32_t c0 = srgb && c < 3 ? (e0[c] << 8) | 0x80 : e0[c] * 257;
+                const uint32_t c1 = srgb && c < 3 ? (e1[c] << 8) | 0x80 : e1[c] * 257;
+                t[c]              = static_cast<uint8_t>(((c0 * (64 - w) + c1 * w + 32) >> 6) >> 8);
+            }
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+enum class BlockCodec {
+    NONE,
+    ETC1,
+    ETC2_RGB,
+    ETC2_RGBA,
+    EAC_R,
+    EAC_RG,
+    ASTC,
+};
+
+struct BlockLayout {
+    BlockCodec codec;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytes;
+    bool srgb;
+};
+
+BlockLayout getBlockLayout(gfx::Format format) {
+    switch (format) {
+        case gfx::Format::ETC_RGB8: return {BlockCodec::ETC1, 4, 4, 8, false};
+        case gfx::Format::ETC2_RGB8:
+        case gfx::Format::ETC2_SRGB8: return {BlockCodec::ETC2_RGB, 4, 4, 8, false};
+        case gfx::Format::ETC2_RGBA8:
+        case gfx::Format::ETC2_SRGB8_A8: return {BlockCodec::ETC2_RGBA, 4, 4, 16, false};
+        case gfx::Format::EAC_R11: return {BlockCodec::EAC_R, 4, 4, 8, false};
+        case gfx::Format::EAC_RG11: return {BlockCodec::EAC_RG, 4, 4, 16, false};
+#define CC_ASTC_LAYOUT(W, H)                                              \
+    case gfx::Format::ASTC_RGBA_##W##X##H: return {BlockCodec::ASTC, W, H, 16, false}; \
+    case gfx::Format::ASTC_SRGBA_##W##X##H: return {BlockCodec::ASTC, W, H, 16, true};
+            CC_ASTC_LAYOUT(4, 4)
+            CC_ASTC_LAYOUT(5, 4)
+            CC_ASTC_LAYOUT(5, 5)
+            CC_ASTC_LAYOUT(6, 5)
+            CC_ASTC_LAYOUT(6, 6)
+            CC_ASTC_LAYOUT(8, 5)
+            CC_ASTC_LAYOUT(8, 6)
+            CC_ASTC_LAYOUT(8, 8)
+            CC_ASTC_LAYOUT(10, 5)
+            CC_ASTC_LAYOUT(10, 6)
+            CC_ASTC_LAYOUT(10, 8)
+            CC_ASTC_LAYOUT(10, 10)
+            CC_ASTC_LAYOUT(12, 10)
+            CC_ASTC_LAYOUT(12, 12)
+#undef CC_ASTC_LAYOUT
+        default: return {BlockCodec::NONE, 0, 0, 0, false};
+    }
+}
+
+void decodeBlock(const BlockLayout &layout, const uint8_t *block, uint8_t *texels) {
+    switch (layout.codec) {
+        case BlockCodec::ETC1:
+        case BlockCodec::ETC2_RGB:
+            for (uint32_t i = 0; i < 16; ++i) texels[i * 4 + 3] = 255;
+            decodeEtcColorBlock(block, layout.codec == BlockCodec::ETC2_RGB, texels);
+            break;
+        case BlockCodec::ETC2_RGBA:
+            decodeEacBlock(block, false, texels, 3);
+            decodeEtcColorBlock(block + 8, true, texels);
+            break;
+        case BlockCodec::EAC_R:
+        case BlockCodec::EAC_RG:
+            for (uint32_t i = 0; i < 16; ++i) {
+                texels[i * 4 + 1] = 0;
+                texels[i * 4 + 2] = 0;
+                texels[i * 4 + 3] = 255;
+            }
+            decodeEacBlock(block, true, texels, 0);
+            if (layout.codec == BlockCodec::EAC_RG) decodeEacBlock(block + 8, true, texels, 1);
+            break;
+        case BlockCodec::ASTC:
+            decodeAstcBlock(block, layout.width, layout.height, layout.srgb, texels);
+            break;
+        default:
+            break;
+    }
+}
+
+void storeBlock(const uint8_t *texels, const BlockLayout &layout, uint32_t blockX, uint32_t blockY, uint32_t width, uint32_t height,
+                DecodedTextureFormat dstFormat, uint8_t *dst) {
+    const uint32_t x0   = blockX * layout.width;
+    const uint32_t y0   = blockY * layout.height;
+    const uint32_t cols = std::min(layout.width, width - x0);
+    const uint32_t rows = std::min(layout.height, height - y0);
+    for (uint32_t y = 0; y < rows; ++y) {
+        const uint8_t *src = texels + y * layout.width * 4;
+        if (dstFormat == DecodedTextureFormat::RGBA8) {
+            memcpy(dst + ((y0 + y) * width + x0) * 4, src, cols * 4);
+        } else {
+            uint8_t *row = dst + ((y0 + y) * width + x0) * 2;
+            for (uint32_t x = 0; x < cols; ++x, src += 4) {
+                const uint16_t pixel = static_cast<uint16_t>(((src[0] >> 3) << 11) | ((src[1] >> 2) << 5) | (src[2] >> 3));
+                row[x * 2]           = static_cast<uint8_t>(pixel & 0xFF);
+                row[x * 2 + 1]       = static_cast<uint8_t>(pixel >> 8);
+            }
+        }
+    }
+}
+
+void decodeBlockRows(const BlockLayout &layout, const uint8_t *src, uint32_t blocksX, uint32_t beginRow, uint32_t endRow, uint32_t width,
+                     uint32_t height, DecodedTextureFormat dstFormat, uint8_t *dst) {
+    uint8_t texels[MAX_BLOCK_TEXELS * 4];
+    for (uint32_t by = beginRow; by < endRow; ++by) {
+        const uint8_t *block = src + static_cast<size_t>(by) * blocksX * layout.bytes;
+        for (uint32_t bx = 0; bx < blocksX; ++bx, block += layout.bytes) {
+            decodeBlock(layout, block, texels);
+            storeBlock(texels, layout, bx, by, width, height, dstFormat, dst);
+        }
+    }
+}
+
+} // namespace
+
+bool isSoftwareDecodable(gfx::Format format) {
+    return getBlockLayout(format).codec != BlockCodec::NONE;
+}
+
+size_t getDecodedTextureSize(uint32_t width, uint32_t height, DecodedTextureFormat dstFormat) {
+    return static_cast<size_t>(width) * height * (dstFormat == DecodedTextureFormat::RGBA8 ? 4 : 2);
+}
+
+bool decodeCompressedTexture(gfx::Format format, const uint8_t *src, size_t srcLength, uint32_t width, uint32_t height,
+                             DecodedTextureFormat dstFormat, uint8_t *dst, bool multiThreaded) {
+    const BlockLayout layout = getBlockLayout(format);
+    if (layout.codec == BlockCodec::NONE || !src || !dst || !width || !height) return false;
+
+    const uint32_t blocksX = (width + layout.width - 1) / layout.width;
+    const uint32_t blocksY = (height + layout.height - 1) / layout.height;
+    if (srcLength < static_cast<size_t>(blocksX) * blocksY * layout.bytes) return false;
+
+    const uint32_t jobCount = multiThreaded ? std::min(JobSystem::getInstance()->threadCount() + 1, blocksY / MIN_BLOCK_ROWS_PER_JOB) : 0;
+    if (jobCount > 1) {
+        const uint32_t rowsPerJob = (blocksY + jobCount - 1) / jobCount;
+        JobGraph graph(JobSystem::getInstance());
+        graph.createForEachIndexJob(1U, jobCount, 1U, [&](uint job) {
+            decodeBlockRows(layout, src, blocksX, job * rowsPerJob, std::min(blocksY, (job + 1) * rowsPerJob), width, height, dstFormat, dst);
+        });
+        graph.run();
+        decodeBlockRows(layout, src, blocksX, 0, std::min(blocksY, rowsPerJob), width, height, dstFormat, dst);
+        graph.waitForAll();
+        return true;
+    }
+
+    decodeBlockRows(layout, src, blocksX, 0, blocksY, width, height, dstFormat, dst);
+    return true;
+}
+
+} // namespace cc
@@ -0,0 +1,66 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "renderer/gfx-base/GFXDef.h"
+
+namespace cc {
+
+/**
+ * Software decoders for the block compressed formats, used when the device doesn't support
+ * a format natively.
+ *
+ * Supported: ETC1, ETC2 RGB8/RGBA8 (sRGB included), EAC R11/RG11 (unsigned) and ASTC 2D LDR.
+ * ETC2 punch-through alpha, signed EAC and ASTC HDR blocks are not supported, HDR ASTC blocks
+ * decode to the error color (magenta).
+ *
+ * Only the first mip level is decoded. jsb.loadImage hands a single level to the engine, so a
+ * texture falling back to these decoders loses its prebuilt mip chain; it has to generate mips
+ * after upload if it samples them.
+ */
+enum class DecodedTextureFormat {
+    RGBA8,
+    RGB565,
+};
+
+// Returns true if the format can be decoded by decodeCompressedTexture.
+bool isSoftwareDecodable(gfx::Format format);
+
+// Size in bytes of the decoded first mip level.
+size_t getDecodedTextureSize(uint32_t width, uint32_t height, DecodedTextureFormat dstFormat);
+
+/**
+ * Decodes the first mip level of a compressed texture into dst, which must hold at least
+ * getDecodedTextureSize(width, height, dstFormat) bytes.
+ * Rows of blocks are spread across the job system when multiThreaded is true.
+ * Returns false if the format is not supported or the source data is too short.
+ */
+bool decodeCompressedTexture(gfx::Format format, const uint8_t *src, size_t srcLength, uint32_t width, uint32_t height,
+                             DecodedTextureFormat dstFormat, uint8_t *dst, bool multiThreaded = true);
+
+} // namespace cc
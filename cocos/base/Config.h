@@ -111,3 +111,28 @@
 #ifndef CC_ENABLE_CACHE_JSB_FUNC_RESULT
     #define CC_ENABLE_CACHE_JSB_FUNC_RESULT 1
 #endif
+
+/** @def CC_ENABLE_SCRIPT_MAPPING_HINT
+ * If enabled, every cc::Object remembers where the script engine found it in its native to
+ * script object map, so converting it to a script value again usually skips hashing.
+ */
+#ifndef CC_ENABLE_SCRIPT_MAPPING_HINT
+    #define CC_ENABLE_SCRIPT_MAPPING_HINT 1
+#endif
+
+/** @def CC_ENABLE_LAZY_BINDING_REGISTRATION
+ * If enabled, optional binding modules such as spine, dragonBones and physics are registered
+ * the first time script reads their namespace instead of when the script engine starts.
+ */
+#ifndef CC_ENABLE_LAZY_BINDING_REGISTRATION
+    #define CC_ENABLE_LAZY_BINDING_REGISTRATION 1
+#endif
+
+/** @def CC_ENABLE_SCRIPT_STARTUP_TIMING
+ * If enabled, the script engine logs how long binding registration takes and how long after
+ * its start the first script runs, and every lazily registered module logs its registration time.
+ * Meant for measuring startup, it is off by default.
+ */
+#ifndef CC_ENABLE_SCRIPT_STARTUP_TIMING
+    #define CC_ENABLE_SCRIPT_STARTUP_TIMING 0
+#endif
@@ -0,0 +1,136 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cc {
+
+/**
+ * Move-only `void()` callable with small buffer optimization.
+ *
+ * Callables up to `Capacity` bytes which are nothrow movable are stored inline,
+ * larger ones fall back to the heap. Unlike std::function, a lambda capturing a
+ * few pointers and a std::string or two never allocates.
+ */
+template <size_t Capacity>
+class InlineTask final {
+public:
+    InlineTask() = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, InlineTask>::value>>
+    InlineTask(F &&function) { // NOLINT(google-explicit-constructor)
+        using T = std::decay_t<F>;
+        if constexpr (isInline<T>()) {
+            new (_storage) T(std::forward<F>(function));
+            _ops = &InlineOps<T>::OPS;
+        } else {
+            *reinterpret_cast<T **>(_storage) = new T(std::forward<F>(function));
+            _ops                              = &HeapOps<T>::OPS;
+        }
+    }
+
+    InlineTask(InlineTask &&rhs) noexcept { moveFrom(rhs); }
+    InlineTask &operator=(InlineTask &&rhs) noexcept {
+        if (this != &rhs) {
+            reset();
+            moveFrom(rhs);
+        }
+        return *this;
+    }
+
+    InlineTask(const InlineTask &) = delete;
+    InlineTask &operator=(const InlineTask &) = delete;
+
+    ~InlineTask() { reset(); }
+
+    inline explicit operator bool() const { return _ops != nullptr; }
+    inline void     operator()() { _ops->invoke(_storage); }
+
+    inline void reset() {
+        if (_ops) {
+            _ops->destroy(_storage);
+            _ops = nullptr;
+        }
+    }
+
+    template <typename T>
+    static constexpr bool isInline() {
+        return sizeof(T) <= Capacity && alignof(T) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<T>::value;
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void *storage);
+        void (*move)(void *dst, void *src);
+        void (*destroy)(void *storage);
+    };
+
+    template <typename T>
+    struct InlineOps {
+        static void invoke(void *storage) { (*static_cast<T *>(storage))(); }
+        static void move(void *dst, void *src) {
+            new (dst) T(std::move(*static_cast<T *>(src)));
+            static_cast<T *>(src)->~T();
+        }
+        static void      destroy(void *storage) { static_cast<T *>(storage)->~T(); }
+        static const Ops OPS;
+    };
+
+    template <typename T>
+    struct HeapOps {
+        static void      invoke(void *storage) { (**static_cast<T **>(storage))(); }
+        static void      move(void *dst, void *src) { *static_cast<T **>(dst) = *static_cast<T **>(src); }
+        static void      destroy(void *storage) { delete *static_cast<T **>(storage); }
+        static const Ops OPS;
+    };
+
+    inline void moveFrom(InlineTask &rhs) {
+        if (rhs._ops) {
+            rhs._ops->move(_storage, rhs._storage);
+            _ops     = rhs._ops;
+            rhs._ops = nullptr;
+        }
+    }
+
+    static_assert(Capacity >= sizeof(void *), "InlineTask needs room for at least a pointer");
+
+    alignas(std::max_align_t) unsigned char _storage[Capacity];
+    const Ops *_ops{nullptr};
+};
+
+template <size_t Capacity>
+template <typename T>
+const typename InlineTask<Capacity>::Ops InlineTask<Capacity>::InlineOps<T>::OPS{&invoke, &move, &destroy};
+
+template <size_t Capacity>
+template <typename T>
+const typename InlineTask<Capacity>::Ops InlineTask<Capacity>::HeapOps<T>::OPS{&invoke, &move, &destroy};
+
+} // namespace cc
@@ -25,11 +25,25 @@
 
 #pragma once
 
+#include <cstdint>
+#include "Config.h"
 #include "memory/Memory.h"
 
 namespace cc {
 
 // Now define all the base classes for each allocation
-using Object = AllocatedObject<GAP>;
+// Object stays an alias, a class named Object would hide se::Object and friends in derived classes
+class CC_DLL GeneralObject : public AllocatedObject<GAP> {
+#if CC_ENABLE_SCRIPT_MAPPING_HINT
+public:
+    // Slot of this object in se::NativePtrToObjectMap when it was last looked up, only a hint
+    uint32_t *getScriptMappingHint() { return &_scriptMappingHint; }
+
+private:
+    uint32_t _scriptMappingHint{UINT32_MAX};
+#endif
+};
+
+using Object = GeneralObject;
 
 } // namespace cc
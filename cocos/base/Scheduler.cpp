@@ -124,9 +124,9 @@ void TimerTargetCallback::cancel() {
 
 // implementation of Scheduler
 
-Scheduler::Scheduler() {
-    // I don't expect to have more than 30 functions to all per frame
-    _functionsToPerform.reserve(MAX_FUNC_TO_PERFORM);
+Scheduler::Scheduler()
+// I don't expect to have more than 30 functions to all per frame
+: _performQueues{PendingQueue(MAX_FUNC_TO_PERFORM), PendingQueue(MAX_FUNC_TO_PERFORM), PendingQueue(MAX_FUNC_TO_PERFORM)} {
 }
 
 Scheduler::~Scheduler() {
@@ -321,15 +321,71 @@ bool Scheduler::isTargetPaused(void *target) {
     return false; // should never get here
 }
 
-void Scheduler::performFunctionInCocosThread(const std::function<void()> &function) {
-    _performMutex.lock();
-    _functionsToPerform.push_back(function);
-    _performMutex.unlock();
+void Scheduler::enqueueFunctionToPerform(PerformTask &&task, PerformPriority priority) {
+    CCASSERT(priority < PerformPriority::COUNT, "Invalid perform priority");
+    PendingFunction pending;
+    pending.task        = std::move(task);
+    pending.enqueueTime = std::chrono::steady_clock::now();
+    pending.generation  = _performGeneration.load(std::memory_order_acquire);
+    _performQueues[static_cast<size_t>(priority)].enqueue(std::move(pending));
 }
 
 void Scheduler::removeAllFunctionsToBePerformedInCocosThread() {
-    std::unique_lock<std::mutex> lock(_performMutex);
-    _functionsToPerform.clear();
+    // The queues are drained on the cocos thread, stale functions are dropped there.
+    _performGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void Scheduler::runFunctionsToPerform() {
+    using Clock = std::chrono::steady_clock;
+
+    // Only run what has been queued so far, functions queued by the ones below run in the next frame.
+    PendingFunction pending;
+    for (size_t i = 0; i < PERFORM_PRIORITY_COUNT; ++i) {
+        while (_performQueues[i].try_dequeue(pending)) {
+            _performBacklog[i].push_back(std::move(pending));
+        }
+    }
+
+    const auto start      = Clock::now();
+    const auto budget     = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(_performBudget));
+    uint32_t   executed   = 0;
+    uint32_t   budgeted   = 0;
+    float      maxLatency = 0.F;
+    for (size_t i = 0; i < PERFORM_PRIORITY_COUNT; ++i) {
+        const bool limited = i == static_cast<size_t>(PerformPriority::LOW) && _performBudget > 0.F;
+        auto &     backlog = _performBacklog[i];
+        while (!backlog.empty()) {
+            const auto now = Clock::now();
+            if (limited && budgeted > 0 && now - start >= budget) {
+                break;
+            }
+            PendingFunction function = std::move(backlog.front());
+            backlog.pop_front();
+            // Reloaded every time as a function may remove the others.
+            if (function.generation != _performGeneration.load(std::memory_order_acquire)) {
+                continue;
+            }
+
+            const float latency = std::chrono::duration<float>(now - function.enqueueTime).count();
+            maxLatency          = std::max(maxLatency, latency);
+            _performStats.averageLatency += (latency - _performStats.averageLatency) * 0.1F;
+
+            function.task();
+            ++executed;
+            if (limited) {
+                ++budgeted;
+            }
+        }
+    }
+
+    _performStats.executed   = executed;
+    _performStats.maxLatency = maxLatency;
+    _performStats.deferred   = 0;
+    for (size_t i = 0; i < PERFORM_PRIORITY_COUNT; ++i) {
+        const auto carried        = static_cast<uint32_t>(_performBacklog[i].size());
+        _performStats.deferred   += carried;
+        _performStats.pending[i] = carried + static_cast<uint32_t>(_performQueues[i].size_approx());
+    }
 }
 
 // main loop
@@ -381,18 +437,7 @@ void Scheduler::update(float dt) {
     // Functions allocated from another thread
     //
 
-    // Testing size is faster than locking / unlocking.
-    // And almost never there will be functions scheduled to be called.
-    if (!_functionsToPerform.empty()) {
-        _performMutex.lock();
-        // fixed #4123: Save the callback functions, they must be invoked after '_performMutex.unlock()', otherwise if new functions are added in callback, it will cause thread deadlock.
-        auto temp = _functionsToPerform;
-        _functionsToPerform.clear();
-        _performMutex.unlock();
-        for (const auto &function : temp) {
-            function();
-        }
-    }
+    runFunctionsToPerform();
 }
 
 } // namespace cc
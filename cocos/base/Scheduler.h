@@ -29,13 +29,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <set>
 #include <unordered_map>
 #include <vector>
 
+#include "base/InlineTask.h"
 #include "base/Ref.h"
+#include "concurrentqueue/concurrentqueue.h"
 //#include "base/Vector.h"
 
 namespace cc {
@@ -104,6 +109,21 @@ private:
  * @{
  */
 
+enum class PerformPriority : uint8_t {
+    HIGH,
+    NORMAL,
+    LOW,
+    COUNT,
+};
+
+struct PerformStats {
+    uint32_t pending[static_cast<size_t>(PerformPriority::COUNT)]{}; // queued or carried over, per priority
+    uint32_t executed{0};                                           // run in the last frame
+    uint32_t deferred{0};                                           // carried over to the next frame
+    float    maxLatency{0.F};                                       // longest wait of the last frame, in seconds
+    float    averageLatency{0.F};                                   // moving average of the wait, in seconds
+};
+
 struct _listEntry;
 struct _hashSelectorEntry;
 struct _hashUpdateEntry;
@@ -255,12 +275,18 @@ public:
     std::set<void *> pauseAllTargetsWithMinPriority(int minPriority);
 
     /** Calls a function on the cocos2d thread. Useful when you need to call a cocos2d function from another thread.
-     This function is thread safe.
+     This function is thread safe and lock free.
+     Functions of the same priority queued from the same thread run in order. HIGH and NORMAL priority functions
+     all run in the next frame, LOW ones run within the perform budget and the rest is carried over.
      @param function The function to be run in cocos2d thread.
+     @param priority The priority class of the function.
      @since v3.0
      @js NA
      */
-    void performFunctionInCocosThread(const std::function<void()> &function);
+    template <typename F>
+    void performFunctionInCocosThread(F &&function, PerformPriority priority = PerformPriority::NORMAL) {
+        enqueueFunctionToPerform(PerformTask(std::forward<F>(function)), priority);
+    }
 
     /**
      * Remove all pending functions queued to be performed with Scheduler::performFunctionInCocosThread
@@ -271,9 +297,30 @@ public:
      */
     void removeAllFunctionsToBePerformedInCocosThread();
 
+    /** Sets the time in seconds spent each frame running LOW priority functions
+     queued with performFunctionInCocosThread, 0 means no limit. At least one function runs per frame.
+     */
+    inline void  setPerformBudget(float seconds) { _performBudget = seconds; }
+    inline float getPerformBudget() const { return _performBudget; }
+
+    /** Statistics of functions queued with performFunctionInCocosThread, updated once per frame. */
+    inline const PerformStats &getPerformStats() const { return _performStats; }
+
     bool isCurrentTargetSalvaged() const { return _currentTargetSalvaged; };
 
 private:
+    using PerformTask = InlineTask<48>;
+
+    struct PendingFunction {
+        PerformTask                           task;
+        std::chrono::steady_clock::time_point enqueueTime;
+        uint32_t                              generation{0};
+    };
+    using PendingQueue = moodycamel::ConcurrentQueue<PendingFunction>;
+
+    void enqueueFunctionToPerform(PerformTask &&task, PerformPriority priority);
+    void runFunctionsToPerform();
+
     // Hash Element used for "selectors with interval"
     struct HashTimerEntry {
         std::vector<Timer *> timers;
@@ -297,8 +344,14 @@ private:
     bool _updateHashLocked = false;
 
     // Used for "perform Function"
-    std::vector<std::function<void()>> _functionsToPerform;
-    std::mutex                         _performMutex;
+    static constexpr size_t PERFORM_PRIORITY_COUNT{static_cast<size_t>(PerformPriority::COUNT)};
+
+    PendingQueue                _performQueues[PERFORM_PRIORITY_COUNT];
+    std::deque<PendingFunction> _performBacklog[PERFORM_PRIORITY_COUNT];
+    // Bumped by removeAllFunctionsToBePerformedInCocosThread, functions queued before are dropped.
+    std::atomic<uint32_t> _performGeneration{0};
+    float                 _performBudget{0.004F};
+    PerformStats          _performStats;
 };
 
 // end of base group
@@ -0,0 +1,639 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "base/ValueBinary.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+
+namespace cc {
+
+// Layout, little endian like every platform the engine runs on:
+//   Header, then container bodies and doubles in write order, then the string table.
+//   A value is a Slot, scalars are stored inline, other types point to their body:
+//     vector        uint32 count, Slot[count]
+//     map           uint32 count, {uint32 key string, Slot}[count] sorted by key
+//     int key map   uint32 count, {int32 key, Slot}[count] sorted by key
+//     packed arrays uint32 count, int32/float[count], doubles are preceded by 4 bytes of padding
+//   The string table is {uint32 offset, uint32 length}[stringCount], strings are NUL terminated.
+
+namespace {
+
+enum : uint8_t {
+    TYPE_NONE = static_cast<uint8_t>(Value::Type::NONE),
+    TYPE_BYTE = static_cast<uint8_t>(Value::Type::BYTE),
+    TYPE_INTEGER = static_cast<uint8_t>(Value::Type::INTEGER),
+    TYPE_UNSIGNED = static_cast<uint8_t>(Value::Type::UNSIGNED),
+    TYPE_FLOAT = static_cast<uint8_t>(Value::Type::FLOAT),
+    TYPE_DOUBLE = static_cast<uint8_t>(Value::Type::DOUBLE),
+    TYPE_BOOLEAN = static_cast<uint8_t>(Value::Type::BOOLEAN),
+    TYPE_STRING = static_cast<uint8_t>(Value::Type::STRING),
+    TYPE_VECTOR = static_cast<uint8_t>(Value::Type::VECTOR),
+    TYPE_MAP = static_cast<uint8_t>(Value::Type::MAP),
+    TYPE_INT_KEY_MAP = static_cast<uint8_t>(Value::Type::INT_KEY_MAP),
+    TYPE_INT_ARRAY,
+    TYPE_FLOAT_ARRAY,
+    TYPE_DOUBLE_ARRAY,
+};
+
+const char MAGIC[4] = {'C', 'C', 'V', 'B'};
+const uint32_t VERSION = 1;
+// bounds the recursion of toValue() on corrupted data
+const uint32_t MAX_DEPTH = 256;
+
+struct Slot {
+    uint8_t type;
+    uint8_t reserved[3];
+    uint32_t payload;
+};
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t stringCount;
+    uint32_t stringTable;
+    Slot root;
+};
+
+struct StringRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
+const uint32_t ENTRY_SIZE = sizeof(uint32_t) + sizeof(Slot);
+
+template <typename T>
+T load(const uint8_t *p) {
+    T value;
+    memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+template <typename T>
+uint32_t bitsOf(T value) {
+    static_assert(sizeof(T) == sizeof(uint32_t), "");
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+template <typename T>
+T fromBits(uint32_t bits) {
+    T value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+class Writer {
+public:
+    Writer() {
+        _buffer.resize(sizeof(Header));
+    }
+
+    std::vector<uint8_t> finish(const Slot &root) {
+        Header header;
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.root = root;
+
+        header.stringCount = static_cast<uint32_t>(_strings.size());
+        header.stringTable = reserve(sizeof(StringRef) * _strings.size(), alignof(StringRef));
+        for (uint32_t i = 0; i < header.stringCount; ++i) {
+            const String &str = *_strings[i];
+            StringRef ref;
+            ref.length = static_cast<uint32_t>(str.length());
+            ref.offset = reserve(str.length() + 1, 1);
+            memcpy(_buffer.data() + ref.offset, str.data(), str.length());
+            memcpy(_buffer.data() + header.stringTable + i * sizeof(StringRef), &ref, sizeof(ref));
+        }
+        memcpy(_buffer.data(), &header, sizeof(header));
+        return std::move(_buffer);
+    }
+
+    Slot encode(const Value &value) {
+        Slot slot = {TYPE_NONE, {0, 0, 0}, 0};
+        slot.type = static_cast<uint8_t>(value.getType());
+        switch (value.getType()) {
+            case Value::Type::BYTE: slot.payload = value.asByte(); break;
+            case Value::Type::INTEGER: slot.payload = bitsOf(value.asInt()); break;
+            case Value::Type::UNSIGNED: slot.payload = value.asUnsignedInt(); break;
+            case Value::Type::FLOAT: slot.payload = bitsOf(value.asFloat()); break;
+            case Value::Type::BOOLEAN: slot.payload = value.asBool() ? 1 : 0; break;
+            case Value::Type::DOUBLE:
+                slot.payload = reserve(sizeof(double), sizeof(double));
+                store(slot.payload, value.asDouble());
+                break;
+            case Value::Type::STRING: slot.payload = intern(value.asString()); break;
+            case Value::Type::VECTOR: slot = encode(value.asValueVector()); break;
+            case Value::Type::MAP: slot = encode(value.asValueMap()); break;
+            case Value::Type::INT_KEY_MAP: slot = encode(value.asIntKeyMap()); break;
+            default: slot.type = TYPE_NONE; break;
+        }
+        return slot;
+    }
+
+    Slot encode(const ValueVector &vector) {
+        Slot slot = {TYPE_VECTOR, {0, 0, 0}, 0};
+        auto count = static_cast<uint32_t>(vector.size());
+        uint8_t packed = packedType(vector);
+        if (packed == TYPE_INT_ARRAY || packed == TYPE_FLOAT_ARRAY) {
+            slot.type = packed;
+            slot.payload = reserve(sizeof(uint32_t) * (count + 1), sizeof(uint32_t));
+            store(slot.payload, count);
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t bits = packed == TYPE_INT_ARRAY ? bitsOf(vector[i].asInt()) : bitsOf(vector[i].asFloat());
+                store(slot.payload + sizeof(uint32_t) * (i + 1), bits);
+            }
+        } else if (packed == TYPE_DOUBLE_ARRAY) {
+            slot.type = packed;
+            slot.payload = reserve(sizeof(double) * (count + 1), sizeof(double));
+            store(slot.payload, count);
+            for (uint32_t i = 0; i < count; ++i) {
+                store(slot.payload + sizeof(double) * (i + 1), vector[i].asDouble());
+            }
+        } else {
+            slot.payload = reserve(sizeof(uint32_t) + sizeof(Slot) * count, sizeof(uint32_t));
+            store(slot.payload, count);
+            for (uint32_t i = 0; i < count; ++i) {
+                // encoding the element may grow the buffer, store it afterwards
+                Slot element = encode(vector[i]);
+                store(slot.payload + sizeof(uint32_t) + sizeof(Slot) * i, element);
+            }
+        }
+        return slot;
+    }
+
+    Slot encode(const ValueMap &map) {
+        std::vector<ValueMap::const_pointer> entries;
+        entries.reserve(map.size());
+        for (const auto &entry : map) {
+            entries.push_back(&entry);
+        }
+        std::sort(entries.begin(), entries.end(), [](ValueMap::const_pointer a, ValueMap::const_pointer b) {
+            return strcmp(a->first.c_str(), b->first.c_str()) < 0;
+        });
+
+        Slot slot = {TYPE_MAP, {0, 0, 0}, 0};
+        auto count = static_cast<uint32_t>(entries.size());
+        slot.payload = reserve(sizeof(uint32_t) + ENTRY_SIZE * count, sizeof(uint32_t));
+        store(slot.payload, count);
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t key = intern(entries[i]->first);
+            Slot element = encode(entries[i]->second);
+            uint32_t offset = slot.payload + sizeof(uint32_t) + ENTRY_SIZE * i;
+            store(offset, key);
+            store(offset + sizeof(uint32_t), element);
+        }
+        return slot;
+    }
+
+    Slot encode(const ValueMapIntKey &map) {
+        std::vector<ValueMapIntKey::const_pointer> entries;
+        entries.reserve(map.size());
+        for (const auto &entry : map) {
+            entries.push_back(&entry);
+        }
+        std::sort(entries.begin(), entries.end(), [](ValueMapIntKey::const_pointer a, ValueMapIntKey::const_pointer b) {
+            return a->first < b->first;
+        });
+
+        Slot slot = {TYPE_INT_KEY_MAP, {0, 0, 0}, 0};
+        auto count = static_cast<uint32_t>(entries.size());
+        slot.payload = reserve(sizeof(uint32_t) + ENTRY_SIZE * count, sizeof(uint32_t));
+        store(slot.payload, count);
+        for (uint32_t i = 0; i < count; ++i) {
+            Slot element = encode(entries[i]->second);
+            uint32_t offset = slot.payload + sizeof(uint32_t) + ENTRY_SIZE * i;
+            store(offset, static_cast<int32_t>(entries[i]->first));
+            store(offset + sizeof(uint32_t), element);
+        }
+        return slot;
+    }
+
+private:
+    uint32_t intern(const String &str) {
+        auto result = _stringIndices.emplace(str, static_cast<uint32_t>(_strings.size()));
+        if (result.second) {
+            _strings.push_back(&result.first->first);
+        }
+        return result.first->second;
+    }
+
+    // Appends zeroed bytes, returns their offset.
+    uint32_t reserve(size_t size, size_t alignment) {
+        size_t offset = (_buffer.size() + alignment - 1) & ~(alignment - 1);
+        _buffer.resize(offset + size);
+        return static_cast<uint32_t>(offset);
+    }
+
+    template <typename T>
+    void store(uint32_t offset, const T &value) {
+        memcpy(_buffer.data() + offset, &value, sizeof(T));
+    }
+
+    static uint8_t packedType(const ValueVector &vector) {
+        if (vector.empty()) {
+            return TYPE_NONE;
+        }
+        auto type = vector.front().getType();
+        if (type != Value::Type::INTEGER && type != Value::Type::FLOAT && type != Value::Type::DOUBLE) {
+            return TYPE_NONE;
+        }
+        for (const auto &value : vector) {
+            if (value.getType() != type) {
+                return TYPE_NONE;
+            }
+        }
+        return type == Value::Type::INTEGER ? TYPE_INT_ARRAY : (type == Value::Type::FLOAT ? TYPE_FLOAT_ARRAY : TYPE_DOUBLE_ARRAY);
+    }
+
+    std::vector<uint8_t> _buffer;
+    std::unordered_map<String, uint32_t> _stringIndices;
+    std::vector<const String *> _strings;
+};
+
+} // namespace
+
+std::vector<uint8_t> encodeBinaryValue(const Value &root) {
+    Writer writer;
+    return writer.finish(writer.encode(root));
+}
+
+std::vector<uint8_t> encodeBinaryValue(const ValueMap &root) {
+    Writer writer;
+    return writer.finish(writer.encode(root));
+}
+
+std::vector<uint8_t> encodeBinaryValue(const ValueVector &root) {
+    Writer writer;
+    return writer.finish(writer.encode(root));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// BinaryValueReader
+
+bool BinaryValueReader::isBinaryValue(const void *data, size_t size) {
+    return data && size >= sizeof(Header) && 0 == memcmp(data, MAGIC, sizeof(MAGIC));
+}
+
+BinaryValueReader::BinaryValueReader(const void *data, size_t size)
+: _data(static_cast<const uint8_t *>(data)),
+  _size(size) {
+    init();
+}
+
+BinaryValueReader::BinaryValueReader(Data &&data)
+: _owned(std::move(data)) {
+    _data = _owned.getBytes();
+    _size = static_cast<size_t>(_owned.getSize());
+    init();
+}
+
+void BinaryValueReader::init() {
+    if (!isBinaryValue(_data, _size)) {
+        return;
+    }
+    auto header = load<Header>(_data);
+    if (header.version != VERSION) {
+        return;
+    }
+    _stringCount = header.stringCount;
+    _stringTable = header.stringTable;
+    _valid = static_cast<uint64_t>(_stringCount) * sizeof(StringRef) <= UINT32_MAX &&
+             at(_stringTable, _stringCount * static_cast<uint32_t>(sizeof(StringRef))) != nullptr;
+}
+
+BinaryValueNode BinaryValueReader::getRoot() const {
+    if (!_valid) {
+        return BinaryValueNode();
+    }
+    auto root = load<Slot>(_data + offsetof(Header, root));
+    return BinaryValueNode(this, root.type, root.payload);
+}
+
+const uint8_t *BinaryValueReader::at(uint32_t offset, uint32_t size) const {
+    if (static_cast<uint64_t>(offset) + size > _size) {
+        return nullptr;
+    }
+    return _data + offset;
+}
+
+const char *BinaryValueReader::getString(uint32_t index) const {
+    if (index >= _stringCount) {
+        return nullptr;
+    }
+    auto ref = load<StringRef>(_data + _stringTable + index * sizeof(StringRef));
+    const uint8_t *str = ref.length < UINT32_MAX ? at(ref.offset, ref.length + 1) : nullptr;
+    if (!str || str[ref.length] != 0) {
+        return nullptr;
+    }
+    return reinterpret_cast<const char *>(str);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// BinaryValueNode
+
+BinaryValueNode::BinaryValueNode(const BinaryValueReader *reader, uint8_t type, uint32_t payload)
+: _reader(reader),
+  _type(type),
+  _payload(payload) {
+}
+
+Value::Type BinaryValueNode::getType() const {
+    if (!_reader || _type > TYPE_DOUBLE_ARRAY) {
+        return Value::Type::NONE;
+    }
+    if (_type >= TYPE_INT_ARRAY) {
+        return Value::Type::VECTOR;
+    }
+    return static_cast<Value::Type>(_type);
+}
+
+const uint8_t *BinaryValueNode::body(uint32_t headerSize, uint32_t elementSize, uint32_t *count) const {
+    const uint8_t *p = _reader->at(_payload, sizeof(uint32_t));
+    if (!p) {
+        return nullptr;
+    }
+    *count = load<uint32_t>(p);
+    uint64_t size = headerSize + static_cast<uint64_t>(*count) * elementSize;
+    if (size > UINT32_MAX || !_reader->at(_payload, static_cast<uint32_t>(size))) {
+        *count = 0;
+        return nullptr;
+    }
+    return p + headerSize;
+}
+
+uint32_t BinaryValueNode::size() const {
+    uint32_t count = 0;
+    switch (getType() == Value::Type::NONE ? static_cast<uint8_t>(TYPE_NONE) : _type) {
+        case TYPE_VECTOR: body(sizeof(uint32_t), sizeof(Slot), &count); break;
+        case TYPE_MAP:
+        case TYPE_INT_KEY_MAP: body(sizeof(uint32_t), ENTRY_SIZE, &count); break;
+        case TYPE_INT_ARRAY:
+        case TYPE_FLOAT_ARRAY: body(sizeof(uint32_t), sizeof(uint32_t), &count); break;
+        case TYPE_DOUBLE_ARRAY: body(sizeof(double), sizeof(double), &count); break;
+        default: break;
+    }
+    return count;
+}
+
+BinaryValueNode BinaryValueNode::operator[](uint32_t index) const {
+    uint32_t count = 0;
+    const uint8_t *p = nullptr;
+    switch (getType() == Value::Type::NONE ? static_cast<uint8_t>(TYPE_NONE) : _type) {
+        case TYPE_VECTOR:
+            p = body(sizeof(uint32_t), sizeof(Slot), &count);
+            if (p && index < count) {
+                auto slot = load<Slot>(p + sizeof(Slot) * index);
+                return BinaryValueNode(_reader, slot.type, slot.payload);
+            }
+            break;
+        case TYPE_INT_ARRAY:
+        case TYPE_FLOAT_ARRAY:
+            p = body(sizeof(uint32_t), sizeof(uint32_t), &count);
+            if (p && index < count) {
+                return BinaryValueNode(_reader, _type == TYPE_INT_ARRAY ? TYPE_INTEGER : TYPE_FLOAT, load<uint32_t>(p + sizeof(uint32_t) * index));
+            }
+            break;
+        case TYPE_DOUBLE_ARRAY:
+            p = body(sizeof(double), sizeof(double), &count);
+            if (p && index < count) {
+                return BinaryValueNode(_reader, TYPE_DOUBLE, static_cast<uint32_t>(p - _reader->_data) + sizeof(double) * index);
+            }
+            break;
+        default:
+            break;
+    }
+    return BinaryValueNode();
+}
+
+BinaryValueNode BinaryValueNode::find(const char *key) const {
+    uint32_t count = 0;
+    const uint8_t *p = getType() == Value::Type::MAP ? body(sizeof(uint32_t), ENTRY_SIZE, &count) : nullptr;
+    if (!p || !key) {
+        return BinaryValueNode();
+    }
+    uint32_t lo = 0;
+    uint32_t hi = count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        const char *midKey = _reader->getString(load<uint32_t>(p + ENTRY_SIZE * mid));
+        if (!midKey) {
+            break;
+        }
+        int result = strcmp(midKey, key);
+        if (result == 0) {
+            auto slot = load<Slot>(p + ENTRY_SIZE * mid + sizeof(uint32_t));
+            return BinaryValueNode(_reader, slot.type, slot.payload);
+        }
+        if (result < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return BinaryValueNode();
+}
+
+BinaryValueNode BinaryValueNode::find(int key) const {
+    uint32_t count = 0;
+    const uint8_t *p = getType() == Value::Type::INT_KEY_MAP ? body(sizeof(uint32_t), ENTRY_SIZE, &count) : nullptr;
+    if (!p) {
+        return BinaryValueNode();
+    }
+    uint32_t lo = 0;
+    uint32_t hi = count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        auto midKey = load<int32_t>(p + ENTRY_SIZE * mid);
+        if (midKey == key) {
+            auto slot = load<Slot>(p + ENTRY_SIZE * mid + sizeof(uint32_t));
+            return BinaryValueNode(_reader, slot.type, slot.payload);
+        }
+        if (midKey < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return BinaryValueNode();
+}
+
+const char *BinaryValueNode::keyAt(uint32_t index) const {
+    uint32_t count = 0;
+    const uint8_t *p = getType() == Value::Type::MAP ? body(sizeof(uint32_t), ENTRY_SIZE, &count) : nullptr;
+    if (!p || index >= count) {
+        return nullptr;
+    }
+    return _reader->getString(load<uint32_t>(p + ENTRY_SIZE * index));
+}
+
+BinaryValueNode BinaryValueNode::valueAt(uint32_t index) const {
+    uint32_t count = 0;
+    auto type = getType();
+    const uint8_t *p = (type == Value::Type::MAP || type == Value::Type::INT_KEY_MAP) ? body(sizeof(uint32_t), ENTRY_SIZE, &count) : nullptr;
+    if (!p || index >= count) {
+        return BinaryValueNode();
+    }
+    auto slot = load<Slot>(p + ENTRY_SIZE * index + sizeof(uint32_t));
+    return BinaryValueNode(_reader, slot.type, slot.payload);
+}
+
+unsigned char BinaryValueNode::asByte() const {
+    return _type == TYPE_BYTE ? static_cast<unsigned char>(_payload) : static_cast<unsigned char>(asInt());
+}
+
+int BinaryValueNode::asInt() const {
+    switch (getType()) {
+        case Value::Type::INTEGER: return fromBits<int32_t>(_payload);
+        case Value::Type::STRING: return atoi(asCString());
+        default: return static_cast<int>(asDouble());
+    }
+}
+
+unsigned int BinaryValueNode::asUnsignedInt() const {
+    switch (getType()) {
+        case Value::Type::UNSIGNED: return _payload;
+        case Value::Type::STRING: return static_cast<unsigned int>(strtoul(asCString(), nullptr, 10));
+        default: return static_cast<unsigned int>(asDouble());
+    }
+}
+
+float BinaryValueNode::asFloat() const {
+    return getType() == Value::Type::FLOAT ? fromBits<float>(_payload) : static_cast<float>(asDouble());
+}
+
+double BinaryValueNode::asDouble() const {
+    switch (getType()) {
+        case Value::Type::BYTE:
+        case Value::Type::UNSIGNED:
+        case Value::Type::BOOLEAN: return _payload;
+        case Value::Type::INTEGER: return fromBits<int32_t>(_payload);
+        case Value::Type::FLOAT: return fromBits<float>(_payload);
+        case Value::Type::DOUBLE: {
+            const uint8_t *p = _reader->at(_payload, sizeof(double));
+            return p ? load<double>(p) : 0.0;
+        }
+        case Value::Type::STRING: {
+            const char *str = asCString();
+            return str ? atof(str) : 0.0;
+        }
+        default: return 0.0;
+    }
+}
+
+bool BinaryValueNode::asBool() const {
+    switch (getType()) {
+        case Value::Type::BOOLEAN: return _payload != 0;
+        case Value::Type::STRING: {
+            const char *str = asCString();
+            return str && strcmp(str, "0") != 0 && strcmp(str, "false") != 0;
+        }
+        default: return asDouble() != 0.0;
+    }
+}
+
+const char *BinaryValueNode::asCString() const {
+    return getType() == Value::Type::STRING ? _reader->getString(_payload) : nullptr;
+}
+
+Value BinaryValueNode::toValue() const {
+    // a node costs at least 4 bytes, a larger count means shared or looping bodies
+    size_t budget = _reader ? _reader->_size / sizeof(uint32_t) : 0;
+    return toValue(0, &budget);
+}
+
+ValueMap BinaryValueNode::toValueMap() const {
+    if (getType() != Value::Type::MAP) {
+        return ValueMap();
+    }
+    Value value = toValue();
+    return std::move(value.asValueMap());
+}
+
+ValueVector BinaryValueNode::toValueVector() const {
+    if (getType() != Value::Type::VECTOR) {
+        return ValueVector();
+    }
+    Value value = toValue();
+    return std::move(value.asValueVector());
+}
+
+Value BinaryValueNode::toValue(uint32_t depth, size_t *budget) const {
+    if (depth > MAX_DEPTH || *budget == 0) {
+        return Value();
+    }
+    --*budget;
+    switch (getType()) {
+        case Value::Type::BYTE: return Value(asByte());
+        case Value::Type::INTEGER: return Value(asInt());
+        case Value::Type::UNSIGNED: return Value(asUnsignedInt());
+        case Value::Type::FLOAT: return Value(asFloat());
+        case Value::Type::DOUBLE: return Value(asDouble());
+        case Value::Type::BOOLEAN: return Value(asBool());
+        case Value::Type::STRING: {
+            const char *str = asCString();
+            return str ? Value(str) : Value();
+        }
+        case Value::Type::VECTOR: {
+            uint32_t count = size();
+            ValueVector vector;
+            vector.reserve(std::min<size_t>(count, *budget));
+            for (uint32_t i = 0; i < count && *budget; ++i) {
+                vector.push_back((*this)[i].toValue(depth + 1, budget));
+            }
+            return Value(std::move(vector));
+        }
+        case Value::Type::MAP: {
+            uint32_t count = size();
+            ValueMap map;
+            map.reserve(std::min<size_t>(count, *budget));
+            for (uint32_t i = 0; i < count && *budget; ++i) {
+                const char *key = keyAt(i);
+                if (key) {
+                    map.emplace(key, valueAt(i).toValue(depth + 1, budget));
+                }
+            }
+            return Value(std::move(map));
+        }
+        case Value::Type::INT_KEY_MAP: {
+            uint32_t count = 0;
+            const uint8_t *p = body(sizeof(uint32_t), ENTRY_SIZE, &count);
+            ValueMapIntKey map;
+            map.reserve(std::min<size_t>(count, *budget));
+            for (uint32_t i = 0; p && i < count && *budget; ++i) {
+                map.emplace(load<int32_t>(p + ENTRY_SIZE * i), valueAt(i).toValue(depth + 1, budget));
+            }
+            return Value(std::move(map));
+        }
+        default: return Value();
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,131 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "base/Data.h"
+#include "base/Macros.h"
+#include "base/Value.h"
+
+namespace cc {
+
+/**
+ * Binary encoding of Value trees, a faster to load alternative to XML plists.
+ *
+ * Every string, keys included, is stored once in a string table. Vectors holding only
+ * integers, floats or doubles are stored as packed arrays. Map entries are sorted by key
+ * so a BinaryValueReader can look up a path without materializing anything else.
+ */
+CC_DLL std::vector<uint8_t> encodeBinaryValue(const Value &root);
+CC_DLL std::vector<uint8_t> encodeBinaryValue(const ValueMap &root);
+CC_DLL std::vector<uint8_t> encodeBinaryValue(const ValueVector &root);
+
+class BinaryValueReader;
+
+/**
+ * View of one value inside an encoded buffer, valid as long as the reader is.
+ * Packed numeric arrays are exposed as vectors.
+ */
+class CC_DLL BinaryValueNode final {
+public:
+    BinaryValueNode() = default;
+
+    Value::Type getType() const;
+    inline bool isNull() const { return getType() == Value::Type::NONE; }
+
+    // Number of elements of a vector or map, 0 for other types.
+    uint32_t size() const;
+
+    // Element of a vector, a null node if out of range.
+    BinaryValueNode operator[](uint32_t index) const;
+
+    // Value of a map or int key map entry, a null node if the key is missing.
+    BinaryValueNode find(const char *key) const;
+    BinaryValueNode find(int key) const;
+
+    // Entries of a map in key order.
+    const char *keyAt(uint32_t index) const;
+    BinaryValueNode valueAt(uint32_t index) const;
+
+    unsigned char asByte() const;
+    int asInt() const;
+    unsigned int asUnsignedInt() const;
+    float asFloat() const;
+    double asDouble() const;
+    bool asBool() const;
+    // Points into the encoded buffer, nullptr if the value isn't a string.
+    const char *asCString() const;
+
+    // Materializes the value and everything below it.
+    Value toValue() const;
+    // Same as toValue(), empty if the value is of another type.
+    ValueMap toValueMap() const;
+    ValueVector toValueVector() const;
+
+private:
+    friend class BinaryValueReader;
+    BinaryValueNode(const BinaryValueReader *reader, uint8_t type, uint32_t payload);
+
+    Value toValue(uint32_t depth, size_t *budget) const;
+    const uint8_t *body(uint32_t headerSize, uint32_t elementSize, uint32_t *count) const;
+
+    const BinaryValueReader *_reader = nullptr;
+    uint8_t _type = 0;
+    uint32_t _payload = 0;
+};
+
+class CC_DLL BinaryValueReader final {
+public:
+    static bool isBinaryValue(const void *data, size_t size);
+
+    // Reads in place, the data must outlive the reader.
+    BinaryValueReader(const void *data, size_t size);
+    // Keeps the data alive for the lifetime of the reader.
+    explicit BinaryValueReader(Data &&data);
+
+    BinaryValueReader(const BinaryValueReader &) = delete;
+    BinaryValueReader &operator=(const BinaryValueReader &) = delete;
+
+    inline bool isValid() const { return _valid; }
+    BinaryValueNode getRoot() const;
+
+private:
+    friend class BinaryValueNode;
+    void init();
+    const uint8_t *at(uint32_t offset, uint32_t size) const;
+    const char *getString(uint32_t index) const;
+
+    Data _owned;
+    const uint8_t *_data = nullptr;
+    size_t _size = 0;
+    bool _valid = false;
+    uint32_t _stringCount = 0;
+    uint32_t _stringTable = 0;
+};
+
+} // namespace cc
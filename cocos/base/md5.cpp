@@ -0,0 +1,165 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/md5.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace cc {
+
+namespace {
+
+constexpr uint32_t SHIFTS[64] = {
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+
+// floor(abs(sin(i + 1)) * 2^32)
+constexpr uint32_t CONSTANTS[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+
+inline uint32_t rotateLeft(uint32_t x, uint32_t c) {
+    return (x << c) | (x >> (32 - c));
+}
+
+} // namespace
+
+MD5::MD5() {
+    reset();
+}
+
+void MD5::reset() {
+    _state[0] = 0x67452301;
+    _state[1] = 0xefcdab89;
+    _state[2] = 0x98badcfe;
+    _state[3] = 0x10325476;
+    _length   = 0;
+}
+
+void MD5::transform(const uint8_t *block) {
+    uint32_t m[16];
+    for (uint32_t i = 0; i < 16; ++i) {
+        m[i] = static_cast<uint32_t>(block[i * 4]) | (static_cast<uint32_t>(block[i * 4 + 1]) << 8) |
+               (static_cast<uint32_t>(block[i * 4 + 2]) << 16) | (static_cast<uint32_t>(block[i * 4 + 3]) << 24);
+    }
+
+    uint32_t a = _state[0];
+    uint32_t b = _state[1];
+    uint32_t c = _state[2];
+    uint32_t d = _state[3];
+    for (uint32_t i = 0; i < 64; ++i) {
+        uint32_t f;
+        uint32_t g;
+        if (i < 16) {
+            f = (b & c) | (~b & d);
+            g = i;
+        } else if (i < 32) {
+            f = (d & b) | (~d & c);
+            g = (5 * i + 1) & 15;
+        } else if (i < 48) {
+            f = b ^ c ^ d;
+            g = (3 * i + 5) & 15;
+        } else {
+            f = c ^ (b | ~d);
+            g = (7 * i) & 15;
+        }
+        const uint32_t temp = d;
+        d                   = c;
+        c                   = b;
+        b                   = b + rotateLeft(a + f + CONSTANTS[i] + m[g], SHIFTS[i]);
+        a                   = temp;
+    }
+
+    _state[0] += a;
+    _state[1] += b;
+    _state[2] += c;
+    _state[3] += d;
+}
+
+void MD5::update(const void *data, size_t length) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    size_t used       = static_cast<size_t>(_length & 63);
+    _length += length;
+
+    if (used) {
+        const size_t fill = std::min(length, 64 - used);
+        memcpy(_buffer + used, bytes, fill);
+        used += fill;
+        bytes += fill;
+        length -= fill;
+        if (used < 64) return;
+        transform(_buffer);
+    }
+    for (; length >= 64; bytes += 64, length -= 64) {
+        transform(bytes);
+    }
+    if (length) memcpy(_buffer, bytes, length);
+}
+
+std::string MD5::finish() {
+    const uint64_t bitLength = _length * 8;
+    const uint8_t pad        = 0x80;
+    const uint8_t zero       = 0;
+    update(&pad, 1);
+    while ((_length & 63) != 56) update(&zero, 1);
+    uint8_t lengthBytes[8];
+    for (uint32_t i = 0; i < 8; ++i) lengthBytes[i] = static_cast<uint8_t>(bitLength >> (i * 8));
+    update(lengthBytes, 8);
+
+    static const char *hex = "0123456789abcdef";
+    std::string digest(32, '0');
+    for (uint32_t i = 0; i < 16; ++i) {
+        const uint8_t byte = static_cast<uint8_t>(_state[i >> 2] >> ((i & 3) * 8));
+        digest[i * 2]      = hex[byte >> 4];
+        digest[i * 2 + 1]  = hex[byte & 0xF];
+    }
+    return digest;
+}
+
+std::string md5Hex(const void *data, size_t length) {
+    MD5 md5;
+    md5.update(data, length);
+    return md5.finish();
+}
+
+bool md5Equals(const std::string &a, const std::string &b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (tolower(static_cast<unsigned char>(a[i])) != tolower(static_cast<unsigned char>(b[i]))) return false;
+    }
+    return true;
+}
+
+} // namespace cc
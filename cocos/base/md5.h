@@ -0,0 +1,63 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "base/Macros.h"
+
+namespace cc {
+
+/**
+ * Incremental MD5 (RFC 1321), feed data with update() as it arrives and call finish() once.
+ */
+class CC_DLL MD5 final {
+public:
+    MD5();
+
+    void update(const void *data, size_t length);
+
+    // Returns the digest as 32 lower case hex characters, the object must be reset() before reuse.
+    std::string finish();
+
+    void reset();
+
+private:
+    void transform(const uint8_t *block);
+
+    uint32_t _state[4];
+    uint64_t _length = 0;
+    uint8_t _buffer[64];
+};
+
+// Digest of a memory block as 32 lower case hex characters.
+std::string CC_DLL md5Hex(const void *data, size_t length);
+
+// Compares two hex digests ignoring case.
+bool CC_DLL md5Equals(const std::string &a, const std::string &b);
+
+} // namespace cc
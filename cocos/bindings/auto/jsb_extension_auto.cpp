@@ -687,6 +687,25 @@ static bool js_extension_AssetsManagerEx_downloadFailedAssets(se::State& s)
 }
 SE_BIND_FUNC(js_extension_AssetsManagerEx_downloadFailedAssets)
 
+static bool js_extension_AssetsManagerEx_getDecompressedBytes(se::State& s)
+{
+    cc::extension::AssetsManagerEx* cobj = SE_THIS_OBJECT<cc::extension::AssetsManagerEx>(s);
+    SE_PRECONDITION2(cobj, false, "js_extension_AssetsManagerEx_getDecompressedBytes : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        double result = cobj->getDecompressedBytes();
+        ok &= nativevalue_to_se(result, s.rval(), nullptr /*ctx*/);
+        SE_PRECONDITION2(ok, false, "js_extension_AssetsManagerEx_getDecompressedBytes : Error processing arguments");
+        SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_extension_AssetsManagerEx_getDecompressedBytes)
+
 static bool js_extension_AssetsManagerEx_getDownloadedBytes(se::State& s)
 {
     cc::extension::AssetsManagerEx* cobj = SE_THIS_OBJECT<cc::extension::AssetsManagerEx>(s);
@@ -839,6 +858,25 @@ static bool js_extension_AssetsManagerEx_getTotalBytes(se::State& s)
 }
 SE_BIND_FUNC(js_extension_AssetsManagerEx_getTotalBytes)
 
+static bool js_extension_AssetsManagerEx_getTotalDecompressBytes(se::State& s)
+{
+    cc::extension::AssetsManagerEx* cobj = SE_THIS_OBJECT<cc::extension::AssetsManagerEx>(s);
+    SE_PRECONDITION2(cobj, false, "js_extension_AssetsManagerEx_getTotalDecompressBytes : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        double result = cobj->getTotalDecompressBytes();
+        ok &= nativevalue_to_se(result, s.rval(), nullptr /*ctx*/);
+        SE_PRECONDITION2(ok, false, "js_extension_AssetsManagerEx_getTotalDecompressBytes : Error processing arguments");
+        SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_extension_AssetsManagerEx_getTotalDecompressBytes)
+
 static bool js_extension_AssetsManagerEx_getTotalFiles(se::State& s)
 {
     cc::extension::AssetsManagerEx* cobj = SE_THIS_OBJECT<cc::extension::AssetsManagerEx>(s);
@@ -1260,6 +1298,7 @@ bool js_register_extension_AssetsManagerEx(se::Object* obj)
 
     cls->defineFunction("checkUpdate", _SE(js_extension_AssetsManagerEx_checkUpdate));
     cls->defineFunction("downloadFailedAssets", _SE(js_extension_AssetsManagerEx_downloadFailedAssets));
+    cls->defineFunction("getDecompressedBytes", _SE(js_extension_AssetsManagerEx_getDecompressedBytes));
     cls->defineFunction("getDownloadedBytes", _SE(js_extension_AssetsManagerEx_getDownloadedBytes));
     cls->defineFunction("getDownloadedFiles", _SE(js_extension_AssetsManagerEx_getDownloadedFiles));
     cls->defineFunction("getLocalManifest", _SE(js_extension_AssetsManagerEx_getLocalManifest));
@@ -1268,6 +1307,7 @@ bool js_register_extension_AssetsManagerEx(se::Object* obj)
     cls->defineFunction("getState", _SE(js_extension_AssetsManagerEx_getState));
     cls->defineFunction("getStoragePath", _SE(js_extension_AssetsManagerEx_getStoragePath));
     cls->defineFunction("getTotalBytes", _SE(js_extension_AssetsManagerEx_getTotalBytes));
+    cls->defineFunction("getTotalDecompressBytes", _SE(js_extension_AssetsManagerEx_getTotalDecompressBytes));
     cls->defineFunction("getTotalFiles", _SE(js_extension_AssetsManagerEx_getTotalFiles));
     cls->defineFunction("isResuming", _SE(js_extension_AssetsManagerEx_isResuming));
     cls->defineFunction("loadLocalManifest", _SE(js_extension_AssetsManagerEx_loadLocalManifest));
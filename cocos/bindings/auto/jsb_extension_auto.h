@@ -82,6 +82,7 @@ bool register_all_extension(se::Object* obj);
 JSB_REGISTER_OBJECT_TYPE(cc::extension::AssetsManagerEx);
 SE_DECLARE_FUNC(js_extension_AssetsManagerEx_checkUpdate);
 SE_DECLARE_FUNC(js_extension_AssetsManagerEx_downloadFailedAssets);
+SE_DECLARE_FUNC(js_extension_AssetsManagerEx_getDecompressedBytes);
 SE_DECLARE_FUNC(js_extension_AssetsManagerEx_getDownloadedBytes);
 SE_DECLARE_FUNC(js_extension_AssetsManagerEx_getDownloadedFiles);
 SE_DECLARE_FUNC(js_extension_AssetsManagerEx_getLocalManifest);
@@ -90,6 +91,7 @@ SE_DECLARE_FUNC(js_extension_AssetsManagerEx_getRemoteManifest);
 SE_DECLARE_FUNC(js_extension_AssetsManagerEx_getState);
 SE_DECLARE_FUNC(js_extension_AssetsManagerEx_getStoragePath);
 SE_DECLARE_FUNC(js_extension_AssetsManagerEx_getTotalBytes);
+SE_DECLARE_FUNC(js_extension_AssetsManagerEx_getTotalDecompressBytes);
 SE_DECLARE_FUNC(js_extension_AssetsManagerEx_getTotalFiles);
 SE_DECLARE_FUNC(js_extension_AssetsManagerEx_isResuming);
 SE_DECLARE_FUNC(js_extension_AssetsManagerEx_loadLocalManifest);
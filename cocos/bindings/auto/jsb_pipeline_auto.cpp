@@ -3046,6 +3046,25 @@ bool js_register_pipeline_RenderStage(se::Object* obj)
 se::Object* __jsb_cc_pipeline_ForwardStage_proto = nullptr;
 se::Class* __jsb_cc_pipeline_ForwardStage_class = nullptr;
 
+static bool js_pipeline_ForwardStage_setStaticUI(se::State& s)
+{
+    cc::pipeline::ForwardStage* cobj = SE_THIS_OBJECT<cc::pipeline::ForwardStage>(s);
+    SE_PRECONDITION2(cobj, false, "js_pipeline_ForwardStage_setStaticUI : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        HolderType<bool, false> arg0 = {};
+        ok &= sevalue_to_native(args[0], &arg0, s.thisObject());
+        SE_PRECONDITION2(ok, false, "js_pipeline_ForwardStage_setStaticUI : Error processing arguments");
+        cobj->setStaticUI(arg0.value());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_pipeline_ForwardStage_setStaticUI)
+
 static bool js_pipeline_ForwardStage_getInitializeInfo(se::State& s)
 {
     const auto& args = s.args();
@@ -3095,6 +3114,7 @@ bool js_register_pipeline_ForwardStage(se::Object* obj)
 {
     auto cls = se::Class::create("ForwardStage", obj, __jsb_cc_pipeline_RenderStage_proto, _SE(js_pipeline_ForwardStage_constructor));
 
+    cls->defineFunction("setStaticUI", _SE(js_pipeline_ForwardStage_setStaticUI));
     cls->defineStaticFunction("getInitializeInfo", _SE(js_pipeline_ForwardStage_getInitializeInfo));
     cls->defineFinalizeFunction(_SE(js_cc_pipeline_ForwardStage_finalize));
     cls->install();
@@ -3699,6 +3719,25 @@ bool js_register_pipeline_LightingStage(se::Object* obj)
 se::Object* __jsb_cc_pipeline_PostprocessStage_proto = nullptr;
 se::Class* __jsb_cc_pipeline_PostprocessStage_class = nullptr;
 
+static bool js_pipeline_PostprocessStage_setStaticUI(se::State& s)
+{
+    cc::pipeline::PostprocessStage* cobj = SE_THIS_OBJECT<cc::pipeline::PostprocessStage>(s);
+    SE_PRECONDITION2(cobj, false, "js_pipeline_PostprocessStage_setStaticUI : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        HolderType<bool, false> arg0 = {};
+        ok &= sevalue_to_native(args[0], &arg0, s.thisObject());
+        SE_PRECONDITION2(ok, false, "js_pipeline_PostprocessStage_setStaticUI : Error processing arguments");
+        cobj->setStaticUI(arg0.value());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_pipeline_PostprocessStage_setStaticUI)
+
 SE_DECLARE_FINALIZE_FUNC(js_cc_pipeline_PostprocessStage_finalize)
 
 static bool js_pipeline_PostprocessStage_constructor(se::State& s) // constructor.c
@@ -3731,6 +3770,7 @@ bool js_register_pipeline_PostprocessStage(se::Object* obj)
 {
     auto cls = se::Class::create("PostprocessStage", obj, __jsb_cc_pipeline_RenderStage_proto, _SE(js_pipeline_PostprocessStage_constructor));
 
+    cls->defineFunction("setStaticUI", _SE(js_pipeline_PostprocessStage_setStaticUI));
     cls->defineFinalizeFunction(_SE(js_cc_pipeline_PostprocessStage_finalize));
     cls->install();
     JSBClassType::registerClass<cc::pipeline::PostprocessStage>(cls);
@@ -196,6 +196,7 @@ bool js_register_cc_pipeline_ForwardStage(se::Object* obj);
 bool register_all_pipeline(se::Object* obj);
 
 JSB_REGISTER_OBJECT_TYPE(cc::pipeline::ForwardStage);
+SE_DECLARE_FUNC(js_pipeline_ForwardStage_setStaticUI);
 SE_DECLARE_FUNC(js_pipeline_ForwardStage_getInitializeInfo);
 SE_DECLARE_FUNC(js_pipeline_ForwardStage_ForwardStage);
 
@@ -289,5 +290,6 @@ bool js_register_cc_pipeline_PostprocessStage(se::Object* obj);
 bool register_all_pipeline(se::Object* obj);
 
 JSB_REGISTER_OBJECT_TYPE(cc::pipeline::PostprocessStage);
+SE_DECLARE_FUNC(js_pipeline_PostprocessStage_setStaticUI);
 SE_DECLARE_FUNC(js_pipeline_PostprocessStage_PostprocessStage);
 
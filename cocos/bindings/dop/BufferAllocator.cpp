@@ -80,7 +80,25 @@ void BufferAllocator::free(uint index) {
         Object *oldObj = _buffers[index];
         oldObj->decRef();
         _buffers.erase(index);
+
+        // the data isn't ours anymore, don't hand it out
+        _bufferDatas[index]     = nullptr;
+        _bufferDataSizes[index] = 0;
+    }
+}
+
+Object *BufferAllocator::getBufferObject(uint index) const {
+    auto iter = _buffers.find(index);
+    return iter != _buffers.end() ? iter->second : nullptr;
+}
+
+BufferAllocator::Stats BufferAllocator::getStats() const {
+    Stats stats;
+    stats.buffers = static_cast<uint>(_buffers.size());
+    for (const auto &buffer : _buffers) {
+        stats.bytes += _bufferDataSizes[buffer.first];
     }
+    return stats;
 }
 
 } // namespace se
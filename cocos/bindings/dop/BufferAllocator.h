@@ -74,12 +74,21 @@ public:
         return reinterpret_cast<T *>(pool->_bufferDatas[index]);
     }
 
+    struct Stats {
+        uint buffers = 0;
+        uint bytes   = 0;
+    };
+
     explicit BufferAllocator(PoolType type);
     ~BufferAllocator() override;
 
     Object *alloc(uint index, uint bytes);
     void    free(uint index);
 
+    // ArrayBuffer allocated for index, nullptr if there is none
+    Object *getBufferObject(uint index) const;
+    Stats   getStats() const;
+
 private:
     static cc::vector<BufferAllocator *> pools;
     static constexpr uint                BUFFER_MASK = ~(1 << 30);
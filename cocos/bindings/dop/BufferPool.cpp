@@ -27,6 +27,9 @@
 #include "base/Macros.h"
 #include "base/memory/Memory.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace se {
 
 cc::vector<BufferPool *> BufferPool::poolMap(BUFFER_POOL_SIZE);
@@ -48,14 +51,205 @@ BufferPool::BufferPool(PoolType type, uint entryBits, uint bytesPerEntry)
 BufferPool::~BufferPool() = default;
 
 Object *BufferPool::allocateNewChunk() {
-    Object *jsObj = _allocator.alloc(static_cast<uint>(_chunks.size()), _bytesPerChunk);
+    auto chunk = static_cast<uint>(_chunks.size());
+    _chunks.push_back(nullptr);
+    _usage.emplace_back();
+
+    Object *jsObj = _allocator.alloc(chunk, _bytesPerChunk);
 
     uint8_t *realPtr = nullptr;
     size_t   len     = 0;
     jsObj->getArrayBufferData(&realPtr, &len);
-    _chunks.push_back(realPtr);
+    _chunks[chunk] = realPtr;
+
+    // script hands out the entries of these chunks by itself, so they count as live until freed here
+    ChunkUsage &usage = _usage[chunk];
+    usage.liveBits.assign((_entriesPerChunk + 63) / 64, ~0ULL);
+    usage.liveCount = _entriesPerChunk;
+    _liveEntries += _entriesPerChunk;
 
     return jsObj;
 }
 
+uint BufferPool::createChunk() {
+    // reuse the slot of a released chunk first, ids of released chunks aren't live anywhere
+    uint chunk = 0;
+    while (chunk < _chunks.size() && _chunks[chunk] != nullptr) {
+        ++chunk;
+    }
+    if (chunk == _chunks.size()) {
+        _chunks.push_back(nullptr);
+        _usage.emplace_back();
+    }
+
+    Object *jsObj = _allocator.alloc(chunk, _bytesPerChunk);
+
+    uint8_t *realPtr = nullptr;
+    size_t   len     = 0;
+    jsObj->getArrayBufferData(&realPtr, &len);
+    _chunks[chunk] = realPtr;
+
+    ChunkUsage &usage = _usage[chunk];
+    usage.liveBits.assign((_entriesPerChunk + 63) / 64, 0ULL);
+    usage.liveCount = 0;
+    return chunk;
+}
+
+uint BufferPool::alloc() {
+    uint chunk = _firstFreeChunk;
+    while (chunk < _chunks.size() && (_chunks[chunk] == nullptr || _usage[chunk].liveCount == _entriesPerChunk)) {
+        ++chunk;
+    }
+    if (chunk >= _chunks.size()) {
+        chunk = createChunk();
+    }
+    _firstFreeChunk = chunk;
+
+    uint entry = takeFreeEntry(chunk);
+    memset(_chunks[chunk] + entry * _bytesPerEntry, 0, _bytesPerEntry);
+    return makeId(chunk, entry);
+}
+
+void BufferPool::free(uint id) {
+    uint chunk = (_chunkMask & id) >> _entryBits;
+    uint entry = _entryMask & id;
+    CCASSERT(chunk < _chunks.size() && entry < _entriesPerChunk, "BufferPool: Invalid buffer pool entry id");
+    if (chunk >= _chunks.size() || !isLive(chunk, entry)) {
+        return;
+    }
+
+    setLive(chunk, entry, false);
+    _firstFreeChunk = std::min(_firstFreeChunk, chunk);
+}
+
+bool BufferPool::isLive(uint id) const {
+    uint chunk = (_chunkMask & id) >> _entryBits;
+    uint entry = _entryMask & id;
+    return chunk < _chunks.size() && entry < _entriesPerChunk && isLive(chunk, entry);
+}
+
+Object *BufferPool::getChunk(uint index) const {
+    return index < _chunks.size() && _chunks[index] ? _allocator.getBufferObject(index) : nullptr;
+}
+
+uint BufferPool::releaseEmptyChunks(cc::vector<uint> *released) {
+    uint count = 0;
+    for (uint chunk = 0; chunk < _chunks.size(); ++chunk) {
+        if (_chunks[chunk] != nullptr && _usage[chunk].liveCount == 0) {
+            releaseChunk(chunk);
+            if (released) {
+                released->push_back(chunk);
+            }
+            ++count;
+        }
+    }
+    // trailing slots are dropped, so the next chunk is appended where script expects it
+    while (!_chunks.empty() && _chunks.back() == nullptr) {
+        _chunks.pop_back();
+        _usage.pop_back();
+    }
+    _firstFreeChunk = std::min(_firstFreeChunk, static_cast<uint>(_chunks.size()));
+    return count;
+}
+
+void BufferPool::compact(cc::vector<uint> *translation, cc::vector<uint> *released) {
+    // keep the fullest chunks, enough of them to hold every live entry, and empty the others into them
+    uint             keepCount = (_liveEntries + _entriesPerChunk - 1) / _entriesPerChunk;
+    cc::vector<uint> chunks;
+    for (uint chunk = 0; chunk < _chunks.size(); ++chunk) {
+        if (_chunks[chunk] != nullptr) {
+            chunks.push_back(chunk);
+        }
+    }
+    std::stable_sort(chunks.begin(), chunks.end(), [this](uint lhs, uint rhs) {
+        return _usage[lhs].liveCount > _usage[rhs].liveCount;
+    });
+    if (keepCount > chunks.size()) {
+        keepCount = static_cast<uint>(chunks.size());
+    }
+    // entries go to the lowest chunks first, which is what alloc does too
+    std::sort(chunks.begin(), chunks.begin() + keepCount);
+
+    uint target = 0;
+    for (uint i = keepCount; i < chunks.size(); ++i) {
+        uint source = chunks[i];
+        for (uint entry = 0; entry < _entriesPerChunk && _usage[source].liveCount > 0; ++entry) {
+            if (!isLive(source, entry)) {
+                continue;
+            }
+            while (_usage[chunks[target]].liveCount == _entriesPerChunk) {
+                ++target;
+            }
+            uint dstChunk = chunks[target];
+            uint dstEntry = takeFreeEntry(dstChunk);
+            memcpy(_chunks[dstChunk] + dstEntry * _bytesPerEntry, _chunks[source] + entry * _bytesPerEntry, _bytesPerEntry);
+            setLive(source, entry, false);
+
+            translation->push_back(makeId(source, entry));
+            translation->push_back(makeId(dstChunk, dstEntry));
+        }
+    }
+
+    releaseEmptyChunks(released);
+    _firstFreeChunk = 0;
+}
+
+BufferPool::Stats BufferPool::getStats() const {
+    Stats stats;
+    stats.liveEntries = _liveEntries;
+    for (const Chunk chunk : _chunks) {
+        if (chunk != nullptr) {
+            ++stats.chunks;
+        }
+    }
+    stats.bytes = stats.chunks * _bytesPerChunk;
+    return stats;
+}
+
+uint BufferPool::takeFreeEntry(uint chunk) {
+    const cc::vector<uint64_t> &liveBits = _usage[chunk].liveBits;
+    for (uint word = 0; word < liveBits.size(); ++word) {
+        uint64_t freeBits = ~liveBits[word];
+        if (freeBits == 0) {
+            continue;
+        }
+        uint bit = 0;
+        while ((freeBits & 1ULL) == 0) {
+            freeBits >>= 1;
+            ++bit;
+        }
+        uint entry = word * 64 + bit;
+        CCASSERT(entry < _entriesPerChunk, "BufferPool: Chunk usage out of sync");
+        setLive(chunk, entry, true);
+        return entry;
+    }
+    CCASSERT(false, "BufferPool: Chunk has no free entry");
+    return 0;
+}
+
+void BufferPool::setLive(uint chunk, uint entry, bool live) {
+    ChunkUsage &usage = _usage[chunk];
+    uint64_t    bit   = 1ULL << (entry % 64);
+    if (live) {
+        usage.liveBits[entry / 64] |= bit;
+        ++usage.liveCount;
+        ++_liveEntries;
+    } else {
+        usage.liveBits[entry / 64] &= ~bit;
+        --usage.liveCount;
+        --_liveEntries;
+    }
+}
+
+bool BufferPool::isLive(uint chunk, uint entry) const {
+    const ChunkUsage &usage = _usage[chunk];
+    return !usage.liveBits.empty() && (usage.liveBits[entry / 64] & (1ULL << (entry % 64))) != 0;
+}
+
+void BufferPool::releaseChunk(uint chunk) {
+    _allocator.free(chunk);
+    _chunks[chunk] = nullptr;
+    _usage[chunk]  = ChunkUsage();
+}
+
 } // namespace se
@@ -39,6 +39,12 @@ class CC_DLL BufferPool final : public cc::Object {
 public:
     using Chunk = uint8_t *;
 
+    struct Stats {
+        uint liveEntries = 0;
+        uint chunks      = 0; // chunks holding memory, released ones aren't counted
+        uint bytes       = 0;
+    };
+
     CC_INLINE static const cc::vector<BufferPool *> &getPoolMap() { return BufferPool::poolMap; }
     CC_INLINE static uint                            getPoolFlag() { return POOL_FLAG; }
 
@@ -50,24 +56,68 @@ public:
         uint chunk = (_chunkMask & id) >> _entryBits;
         uint entry = _entryMask & id;
         CCASSERT(chunk < _chunks.size() && entry < _entriesPerChunk, "BufferPool: Invalid buffer pool entry id");
+        CCASSERT(_chunks[chunk] != nullptr, "BufferPool: Entry id points into a released chunk");
         return reinterpret_cast<T *>(_chunks[chunk] + (entry * _bytesPerEntry));
     }
 
+    // Appends a chunk whose entries are all live, for script that manages entries by itself
     Object *allocateNewChunk();
 
+    // Takes a zeroed entry from the lowest chunk that has one, so live entries stay packed
+    uint alloc();
+    void free(uint id);
+    bool isLive(uint id) const;
+
+    // ArrayBuffer backing the chunk, nullptr once released
+    Object *getChunk(uint index) const;
+    CC_INLINE uint getChunkCount() const { return static_cast<uint>(_chunks.size()); }
+
+    /**
+     * Gives the memory of chunks without live entries back, returns how many were released.
+     * The indices of the released chunks are appended to released if given. Ids into a
+     * released chunk are invalid, as is the ArrayBuffer returned by getChunk for it, until
+     * alloc reuses the slot for a new chunk.
+     */
+    uint releaseEmptyChunks(cc::vector<uint> *released = nullptr);
+
+    /**
+     * Moves live entries into as few chunks as possible and releases the emptied ones.
+     * Appends the old and the new id of every moved entry to translation, and the indices
+     * of the released chunks to released if given. Ids held by script or native have to be
+     * remapped before the pool is used again, so only call it at safe points, e.g. between levels.
+     */
+    void compact(cc::vector<uint> *translation, cc::vector<uint> *released = nullptr);
+
+    Stats getStats() const;
+
 private:
+    struct ChunkUsage {
+        cc::vector<uint64_t> liveBits;
+        uint                 liveCount = 0;
+    };
+
+    uint createChunk();
+    uint makeId(uint chunk, uint entry) const { return POOL_FLAG | (chunk << _entryBits) | entry; }
+    uint takeFreeEntry(uint chunk);
+    void setLive(uint chunk, uint entry, bool live);
+    bool isLive(uint chunk, uint entry) const;
+    void releaseChunk(uint chunk);
+
     static cc::vector<BufferPool *> poolMap;
     static constexpr uint           POOL_FLAG = 1 << 30;
 
-    BufferAllocator   _allocator;
-    cc::vector<Chunk> _chunks;
-    uint              _entryBits       = 1 << 8;
-    uint              _chunkMask       = 0;
-    uint              _entryMask       = 0;
-    uint              _bytesPerChunk   = 0;
-    uint              _entriesPerChunk = 0;
-    uint              _bytesPerEntry   = 0;
-    PoolType          _type            = PoolType::UNKNOWN;
+    BufferAllocator        _allocator;
+    cc::vector<Chunk>      _chunks;
+    cc::vector<ChunkUsage> _usage;
+    uint                   _liveEntries     = 0;
+    uint                   _firstFreeChunk  = 0; // no chunk before it has free entries
+    uint                   _entryBits       = 1 << 8;
+    uint                   _chunkMask       = 0;
+    uint                   _entryMask       = 0;
+    uint                   _bytesPerChunk   = 0;
+    uint                   _entriesPerChunk = 0;
+    uint                   _bytesPerEntry   = 0;
+    PoolType               _type            = PoolType::UNKNOWN;
 };
 
 } // namespace se
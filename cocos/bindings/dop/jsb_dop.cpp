@@ -45,6 +45,112 @@ static bool jsb_BufferPool_allocateNewChunk(se::State &s) { // NOLINT
 }
 SE_BIND_FUNC(jsb_BufferPool_allocateNewChunk);
 
+static bool jsb_BufferPool_alloc(se::State &s) { // NOLINT
+    auto *pool = static_cast<se::BufferPool *>(s.nativeThisObject());
+    SE_PRECONDITION2(pool, false, "jsb_BufferPool_alloc : Invalid Native Object");
+    s.rval().setUint32(pool->alloc());
+    return true;
+}
+SE_BIND_FUNC(jsb_BufferPool_alloc);
+
+static bool jsb_BufferPool_free(se::State &s) { // NOLINT
+    auto *pool = static_cast<se::BufferPool *>(s.nativeThisObject());
+    SE_PRECONDITION2(pool, false, "jsb_BufferPool_free : Invalid Native Object");
+
+    const auto &args = s.args();
+    size_t      argc = args.size();
+    if (argc == 1) {
+        uint id = 0;
+        seval_to_uint(args[0], &id);
+        pool->free(id);
+        return true;
+    }
+
+    SE_REPORT_ERROR("wrong number of arguments: %d", (int)argc);
+    return false;
+}
+SE_BIND_FUNC(jsb_BufferPool_free);
+
+static bool jsb_BufferPool_getChunk(se::State &s) { // NOLINT
+    auto *pool = static_cast<se::BufferPool *>(s.nativeThisObject());
+    SE_PRECONDITION2(pool, false, "jsb_BufferPool_getChunk : Invalid Native Object");
+
+    const auto &args = s.args();
+    size_t      argc = args.size();
+    if (argc == 1) {
+        uint index = 0;
+        seval_to_uint(args[0], &index);
+        se::Object *chunk = pool->getChunk(index);
+        if (chunk) {
+            s.rval().setObject(chunk);
+        } else {
+            s.rval().setNull();
+        }
+        return true;
+    }
+
+    SE_REPORT_ERROR("wrong number of arguments: %d", (int)argc);
+    return false;
+}
+SE_BIND_FUNC(jsb_BufferPool_getChunk);
+
+// Uint32Array holding the values, null if there are none
+static void uintVectorToTypedArray(const cc::vector<uint> &values, se::Value *ret) { // NOLINT
+    if (values.empty()) {
+        ret->setNull();
+    } else {
+        se::HandleObject array(se::Object::createTypedArray(se::Object::TypedArrayType::UINT32, values.data(), values.size() * sizeof(uint)));
+        ret->setObject(array);
+    }
+}
+
+// Returns the indices of the released chunks, their ArrayBuffers and the ids into them are no longer valid
+static bool jsb_BufferPool_releaseEmptyChunks(se::State &s) { // NOLINT
+    auto *pool = static_cast<se::BufferPool *>(s.nativeThisObject());
+    SE_PRECONDITION2(pool, false, "jsb_BufferPool_releaseEmptyChunks : Invalid Native Object");
+
+    cc::vector<uint> released;
+    pool->releaseEmptyChunks(&released);
+    uintVectorToTypedArray(released, &s.rval());
+    return true;
+}
+SE_BIND_FUNC(jsb_BufferPool_releaseEmptyChunks);
+
+// Returns { translation, releasedChunks }: a Uint32Array of (old id, new id) pairs, null if nothing moved,
+// and the indices of the released chunks as releaseEmptyChunks does
+static bool jsb_BufferPool_compact(se::State &s) { // NOLINT
+    auto *pool = static_cast<se::BufferPool *>(s.nativeThisObject());
+    SE_PRECONDITION2(pool, false, "jsb_BufferPool_compact : Invalid Native Object");
+
+    cc::vector<uint> translation;
+    cc::vector<uint> released;
+    pool->compact(&translation, &released);
+
+    se::Value        value;
+    se::HandleObject obj(se::Object::createPlainObject());
+    uintVectorToTypedArray(translation, &value);
+    obj->setProperty("translation", value);
+    uintVectorToTypedArray(released, &value);
+    obj->setProperty("releasedChunks", value);
+    s.rval().setObject(obj);
+    return true;
+}
+SE_BIND_FUNC(jsb_BufferPool_compact);
+
+static bool jsb_BufferPool_getStats(se::State &s) { // NOLINT
+    auto *pool = static_cast<se::BufferPool *>(s.nativeThisObject());
+    SE_PRECONDITION2(pool, false, "jsb_BufferPool_getStats : Invalid Native Object");
+
+    se::BufferPool::Stats stats = pool->getStats();
+    se::HandleObject      obj(se::Object::createPlainObject());
+    obj->setProperty("liveEntries", se::Value(stats.liveEntries));
+    obj->setProperty("chunks", se::Value(stats.chunks));
+    obj->setProperty("bytes", se::Value(stats.bytes));
+    s.rval().setObject(obj);
+    return true;
+}
+SE_BIND_FUNC(jsb_BufferPool_getStats);
+
 SE_DECLARE_FINALIZE_FUNC(jsb_BufferPool_finalize)
 
 static bool jsb_BufferPool_constructor(se::State &s) { // NOLINT
@@ -90,6 +196,12 @@ static bool js_register_se_BufferPool(se::Object *obj) { // NOLINT
     se::Class *cls = se::Class::create("NativeBufferPool", obj, nullptr, _SE(jsb_BufferPool_constructor));
 
     cls->defineFunction("allocateNewChunk", _SE(jsb_BufferPool_allocateNewChunk));
+    cls->defineFunction("alloc", _SE(jsb_BufferPool_alloc));
+    cls->defineFunction("free", _SE(jsb_BufferPool_free));
+    cls->defineFunction("getChunk", _SE(jsb_BufferPool_getChunk));
+    cls->defineFunction("releaseEmptyChunks", _SE(jsb_BufferPool_releaseEmptyChunks));
+    cls->defineFunction("compact", _SE(jsb_BufferPool_compact));
+    cls->defineFunction("getStats", _SE(jsb_BufferPool_getStats));
     cls->install();
     JSBClassType::registerClass<se::BufferPool>(cls);
 
@@ -252,10 +364,24 @@ static bool jsb_BufferAllocator_free(se::State &s) { // NOLINT
 }
 SE_BIND_FUNC(jsb_BufferAllocator_free);
 
+static bool jsb_BufferAllocator_getStats(se::State &s) { // NOLINT
+    auto *bufferAllocator = static_cast<se::BufferAllocator *>(s.nativeThisObject());
+    SE_PRECONDITION2(bufferAllocator, false, "jsb_BufferAllocator_getStats : Invalid Native Object");
+
+    se::BufferAllocator::Stats stats = bufferAllocator->getStats();
+    se::HandleObject           obj(se::Object::createPlainObject());
+    obj->setProperty("buffers", se::Value(stats.buffers));
+    obj->setProperty("bytes", se::Value(stats.bytes));
+    s.rval().setObject(obj);
+    return true;
+}
+SE_BIND_FUNC(jsb_BufferAllocator_getStats);
+
 static bool js_register_se_BufferAllocator(se::Object *obj) { // NOLINT
     se::Class *cls = se::Class::create("NativeBufferAllocator", obj, nullptr, _SE(jsb_BufferAllocator_constructor));
     cls->defineFunction("alloc", _SE(jsb_BufferAllocator_alloc));
     cls->defineFunction("free", _SE(jsb_BufferAllocator_free));
+    cls->defineFunction("getStats", _SE(jsb_BufferAllocator_getStats));
     cls->install();
     JSBClassType::registerClass<se::BufferAllocator>(cls);
 
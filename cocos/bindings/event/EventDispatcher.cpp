@@ -28,6 +28,7 @@
 #include "cocos/bindings/event/CustomEventTypes.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
 #include "cocos/bindings/manual/jsb_global_init.h"
+#include "cocos/storage/local-storage/LocalStorage.h"
 
 namespace {
 se::Value                 _tickVal;
@@ -284,6 +285,8 @@ void EventDispatcher::dispatchOrientationChangeEvent(int orientation) {
 }
 
 void EventDispatcher::dispatchEnterBackgroundEvent() {
+    // the process may be killed while in background
+    localStorageFlush();
     EventDispatcher::doDispatchEvent(EVENT_COME_TO_BACKGROUND, "onPause", se::EmptyValueArray);
 }
 
@@ -25,15 +25,25 @@
 ****************************************************************************/
 
 #include "MappingUtils.h"
+#include <new>
 
 namespace se {
 
+namespace {
+// Enough for the objects of a typical scene, so startup doesn't rehash
+constexpr size_t NATIVE_PTR_TO_OBJECT_MAP_INITIAL_SIZE = 4096;
+} // namespace
+
 // NativePtrToObjectMap
 NativePtrToObjectMap::Map *NativePtrToObjectMap::__nativePtrToObjectMap = nullptr;
 
 bool NativePtrToObjectMap::init() {
-    if (__nativePtrToObjectMap == nullptr)
+    if (__nativePtrToObjectMap == nullptr) {
         __nativePtrToObjectMap = new (std::nothrow) NativePtrToObjectMap::Map();
+        if (__nativePtrToObjectMap != nullptr) {
+            __nativePtrToObjectMap->reserve(NATIVE_PTR_TO_OBJECT_MAP_INITIAL_SIZE);
+        }
+    }
 
     return __nativePtrToObjectMap != nullptr;
 }
@@ -53,6 +63,10 @@ NativePtrToObjectMap::Map::iterator NativePtrToObjectMap::find(void *nativeObj)
     return __nativePtrToObjectMap->find(nativeObj);
 }
 
+NativePtrToObjectMap::Map::iterator NativePtrToObjectMap::find(void *nativeObj, uint32_t *hint) {
+    return __nativePtrToObjectMap->find(nativeObj, hint);
+}
+
 NativePtrToObjectMap::Map::iterator NativePtrToObjectMap::erase(Map::iterator iter) {
     return __nativePtrToObjectMap->erase(iter);
 }
@@ -69,6 +83,10 @@ size_t NativePtrToObjectMap::size() {
     return __nativePtrToObjectMap->size();
 }
 
+void NativePtrToObjectMap::reserve(size_t count) {
+    __nativePtrToObjectMap->reserve(count);
+}
+
 const NativePtrToObjectMap::Map &NativePtrToObjectMap::instance() {
     return *__nativePtrToObjectMap;
 }
@@ -26,25 +26,246 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace se {
 
 class Object;
 
+/**
+ * Open addressing map keyed by native pointers.
+ *
+ * Probing is linear and never wraps around, erasing shifts the entries that follow back instead
+ * of leaving tombstones. An erase(iterator) while iterating therefore still visits every other
+ * entry exactly once, erasing any other key while iterating may skip or repeat entries.
+ * The last slot is always empty and ends every probe.
+ */
+template <typename T>
+class NativePtrMap final {
+public:
+    using value_type = std::pair<void *, T>;
+
+    template <typename V>
+    class Iterator final {
+    public:
+        Iterator() = default;
+        Iterator(V *slot, V *end) : _slot(slot), _end(end) { skipEmpty(); }
+        template <typename U>
+        Iterator(const Iterator<U> &other) : _slot(other._slot), _end(other._end) {} // NOLINT(google-explicit-constructor)
+
+        V &operator*() const { return *_slot; }
+        V *operator->() const { return _slot; }
+
+        Iterator &operator++() {
+            ++_slot;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const Iterator &rhs) const { return _slot == rhs._slot; }
+        bool operator!=(const Iterator &rhs) const { return _slot != rhs._slot; }
+
+    private:
+        void skipEmpty() {
+            while (_slot != _end && _slot->first == nullptr) {
+                ++_slot;
+            }
+        }
+
+        V *_slot{nullptr};
+        V *_end{nullptr};
+
+        template <typename U>
+        friend class Iterator;
+        friend class NativePtrMap;
+    };
+
+    using iterator = Iterator<value_type>;
+    using const_iterator = Iterator<const value_type>;
+
+    // Hint that matches no slot
+    static constexpr uint32_t NO_HINT = UINT32_MAX;
+
+    NativePtrMap() { allocate(MIN_CAPACITY); }
+
+    iterator begin() { return iterator(_slots.data(), _slots.data() + _slots.size()); }
+    iterator end() { return iterator(_slots.data() + _slots.size(), _slots.data() + _slots.size()); }
+    const_iterator begin() const { return const_iterator(_slots.data(), _slots.data() + _slots.size()); }
+    const_iterator end() const { return const_iterator(_slots.data() + _slots.size(), _slots.data() + _slots.size()); }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    iterator find(void *key) {
+        for (size_t i = home(key); _slots[i].first != nullptr; ++i) {
+            if (_slots[i].first == key) {
+                return at(i);
+            }
+        }
+        return end();
+    }
+
+    /**
+     * Looks the slot in *hint up first, only hashes if the key isn't there any more.
+     * *hint is updated to where the key was found.
+     */
+    iterator find(void *key, uint32_t *hint) {
+        if (*hint < _slots.size() && _slots[*hint].first == key) {
+            return at(*hint);
+        }
+        iterator iter = find(key);
+        if (iter != end()) {
+            *hint = static_cast<uint32_t>(iter._slot - _slots.data());
+        }
+        return iter;
+    }
+
+    // Inserts if the key isn't there yet, like std::unordered_map::emplace
+    std::pair<iterator, bool> emplace(void *key, const T &value) {
+        if ((_size + 1) * MAX_LOAD_DEN > _capacity * MAX_LOAD_NUM) {
+            rehash(_capacity * 2);
+        }
+        size_t i = 0;
+        while (!probe(key, &i)) {
+            rehash(_capacity * 2);
+        }
+        if (_slots[i].first == key) {
+            return {at(i), false};
+        }
+        _slots[i] = value_type(key, value);
+        ++_size;
+        return {at(i), true};
+    }
+
+    // Returns the iterator to the entry following the erased one
+    iterator erase(iterator iter) {
+        size_t i = iter._slot - _slots.data();
+        eraseAt(i);
+        return at(i);
+    }
+
+    size_t erase(void *key) {
+        iterator iter = find(key);
+        if (iter == end()) {
+            return 0;
+        }
+        erase(iter);
+        return 1;
+    }
+
+    void clear() {
+        if (_size == 0) {
+            return;
+        }
+        for (auto &slot : _slots) {
+            slot = value_type(nullptr, T());
+        }
+        _size = 0;
+    }
+
+    // Sizes the table for count entries
+    void reserve(size_t count) {
+        size_t capacity = _capacity;
+        while (count * MAX_LOAD_DEN > capacity * MAX_LOAD_NUM) {
+            capacity *= 2;
+        }
+        if (capacity != _capacity) {
+            rehash(capacity);
+        }
+    }
+
+private:
+    static constexpr size_t MIN_CAPACITY = 64;
+    // Slots past the last home slot, so clusters near the end don't force a rehash
+    static constexpr size_t OVERFLOW_SLOTS = 64;
+    static constexpr size_t MAX_LOAD_NUM = 7;
+    static constexpr size_t MAX_LOAD_DEN = 10;
+
+    iterator at(size_t i) { return iterator(_slots.data() + i, _slots.data() + _slots.size()); }
+
+    size_t home(const void *key) const {
+        // Fibonacci hashing, the top bits of the product are well mixed even for aligned pointers
+        auto hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(hash >> _shift);
+    }
+
+    // Finds the slot of key or the empty slot to insert it, false if that would be the last slot
+    bool probe(const void *key, size_t *slot) const {
+        size_t i = home(key);
+        while (_slots[i].first != nullptr && _slots[i].first != key) {
+            ++i;
+        }
+        *slot = i;
+        return _slots[i].first == key || i + 1 < _slots.size();
+    }
+
+    void eraseAt(size_t i) {
+        size_t hole = i;
+        for (size_t k = i + 1; _slots[k].first != nullptr; ++k) {
+            if (home(_slots[k].first) <= hole) {
+                _slots[hole] = _slots[k];
+                hole = k;
+            }
+        }
+        _slots[hole] = value_type(nullptr, T());
+        --_size;
+    }
+
+    void allocate(size_t capacity) {
+        _capacity = capacity;
+        _shift = 64;
+        while (capacity > 1) {
+            capacity >>= 1;
+            --_shift;
+        }
+        _slots.assign(_capacity + OVERFLOW_SLOTS, value_type(nullptr, T()));
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<value_type> old;
+        old.swap(_slots);
+        for (bool placed = false; !placed; capacity *= 2) {
+            allocate(capacity);
+            placed = true;
+            for (const auto &entry : old) {
+                size_t i = 0;
+                if (entry.first == nullptr) {
+                    continue;
+                }
+                if (!probe(entry.first, &i)) {
+                    placed = false;
+                    break;
+                }
+                _slots[i] = entry;
+            }
+        }
+    }
+
+    std::vector<value_type> _slots;
+    size_t _capacity{0};
+    size_t _size{0};
+    uint32_t _shift{64};
+};
+
 class NativePtrToObjectMap {
 public:
     // key: native ptr, value: se::Object
-    using Map = std::unordered_map<void *, Object *>;
+    using Map = NativePtrMap<Object *>;
 
     static bool init();
     static void destroy();
 
     static Map::iterator find(void *nativeObj);
+    // Tries the slot remembered in *hint first, see NativePtrMap::find
+    static Map::iterator find(void *nativeObj, uint32_t *hint);
     static Map::iterator erase(Map::iterator iter);
     static void erase(void *nativeObj);
     static void clear();
     static size_t size();
+    static void reserve(size_t count);
 
     static const Map &instance();
 
@@ -61,7 +282,7 @@ private:
 class NonRefNativePtrCreatedByCtorMap {
 public:
     // key: native ptr, value: non-ref object created by ctor
-    using Map = std::unordered_map<void *, bool>;
+    using Map = NativePtrMap<bool>;
 
     static bool init();
     static void destroy();
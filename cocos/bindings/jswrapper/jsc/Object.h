@@ -32,6 +32,7 @@
 
     #include "Base.h"
     #include "../Value.h"
+    #include "../PropertyKey.h"
     #include "../RefCounter.h"
 
 namespace se {
@@ -68,6 +69,8 @@ public:
          */
     SE_DEPRECATED_ATTRIBUTE static Object *createUint8TypedArray(uint8_t *bytes, size_t byteLength);
 
+    using BufferContentsFreeFunc = void (*)(void *contents, size_t byteLength, void *userData);
+
     enum class TypedArrayType {
         NONE,
         INT8,
@@ -101,6 +104,17 @@ public:
          */
     static Object *createArrayBufferObject(void *bytes, size_t byteLength);
 
+    /**
+         *  @brief Creates a JavaScript Array Buffer object which takes over an existing buffer without copying it.
+         *  @param[in] contents The buffer to be used as the backing store of the Array Buffer object.
+         *  @param[in] byteLength The number of bytes pointed to by the parameter contents.
+         *  @param[in] freeFunc Called with contents, byteLength and freeUserData once the engine no longer needs the buffer, maybe on another thread.
+         *  @param[in] freeUserData Passed to freeFunc.
+         *  @return A Array Buffer Object whose backing store is contents, or nullptr if there is an error, contents is freed then.
+         *  @note The return value (non-null) has to be released manually.
+         */
+    static Object *createExternalArrayBufferObject(void *contents, size_t byteLength, BufferContentsFreeFunc freeFunc, void *freeUserData = nullptr);
+
     /**
          *  @brief Creates a JavaScript Object from a JSON formatted string.
          *  @param[in] jsonStr The utf-8 string containing the JSON string to be parsed.
@@ -141,6 +155,22 @@ public:
          */
     bool setProperty(const char *name, const Value &value);
 
+    /**
+         *  @brief Gets a property with a key whose engine string is created once, for hot paths.
+         *  @param[in] key The property's key.
+         *  @param[out] value The property's value, the undefined value if object doesn't have it.
+         *  @return true if the property's value isn't undefined, otherwise false.
+         */
+    bool getProperty(const PropertyKey &key, Value *value);
+
+    /**
+         *  @brief Sets a property with a key whose engine string is created once, for hot paths.
+         *  @param[in] key The property's key.
+         *  @param[in] value A value to be used as the property's value.
+         *  @return true if the property is set successfully, otherwise false.
+         */
+    bool setProperty(const PropertyKey &key, const Value &value);
+
     /**
          *  @brief Delete a property of an object.
          *  @param[in] name A utf-8 string containing the property's name.
@@ -36,6 +36,8 @@
 
     #include "EJConvertTypedArray.h"
 
+    #include <vector>
+
 namespace se {
 
 namespace {
@@ -55,6 +57,20 @@ bool isInstanceOfConstructor(JSContextRef ctx, JSValueRef value, const char *cto
     }
     return ret;
 }
+
+// JSStrings don't belong to a context, so the keys survive engine restarts
+std::vector<JSStringRef> __propertyKeys;
+
+JSStringRef getPropertyKeyString(const PropertyKey &key) {
+    if (key.getIndex() >= __propertyKeys.size()) {
+        __propertyKeys.resize(key.getIndex() + 1, nullptr);
+    }
+    JSStringRef &jsName = __propertyKeys[key.getIndex()];
+    if (jsName == nullptr) {
+        jsName = JSStringCreateWithUTF8CString(key.getName());
+    }
+    return jsName;
+}
 } // namespace
 
 Object::Object()
@@ -138,6 +154,46 @@ Object *Object::createArrayBufferObject(void *data, size_t byteLength) {
     return obj;
 }
 
+    #if (__MAC_OS_X_VERSION_MAX_ALLOWED >= 101200 || __IPHONE_OS_VERSION_MAX_ALLOWED >= 100000)
+namespace {
+struct ExternalArrayBufferContents {
+    Object::BufferContentsFreeFunc freeFunc;
+    void *                         freeUserData;
+    size_t                         byteLength;
+};
+
+void externalArrayBufferDeallocator(void *bytes, void *deallocatorContext) {
+    auto *contents = static_cast<ExternalArrayBufferContents *>(deallocatorContext);
+    contents->freeFunc(bytes, contents->byteLength, contents->freeUserData);
+    delete contents;
+}
+} // namespace
+    #endif
+
+Object *Object::createExternalArrayBufferObject(void *contents, size_t byteLength, BufferContentsFreeFunc freeFunc, void *freeUserData) {
+    #if (__MAC_OS_X_VERSION_MAX_ALLOWED >= 101200 || __IPHONE_OS_VERSION_MAX_ALLOWED >= 100000)
+    if (isSupportTypedArrayAPI()) {
+        auto *     context   = new ExternalArrayBufferContents{freeFunc, freeUserData, byteLength};
+        JSValueRef exception = nullptr;
+        JSObjectRef jsobj    = JSObjectMakeArrayBufferWithBytesNoCopy(__cx, contents, byteLength, externalArrayBufferDeallocator, context, &exception);
+        if (exception != nullptr) {
+            ScriptEngine::getInstance()->_clearException(exception);
+            externalArrayBufferDeallocator(contents, context);
+            return nullptr;
+        }
+
+        Object *obj = Object::_createJSObject(nullptr, jsobj);
+        if (obj != nullptr)
+            obj->_type = Type::ARRAY_BUFFER;
+        return obj;
+    }
+    #endif
+    // No external buffer support, copy it
+    Object *obj = createArrayBufferObject(contents, byteLength);
+    freeFunc(contents, byteLength, freeUserData);
+    return obj;
+}
+
 Object *Object::createTypedArray(TypedArrayType type, void *data, size_t byteLength) {
     if (type == TypedArrayType::NONE) {
         SE_LOGE("Don't pass se::Object::TypedArrayType::NONE to createTypedArray API!");
@@ -432,6 +488,36 @@ bool Object::setProperty(const char *name, const Value &v) {
     return ret;
 }
 
+bool Object::getProperty(const PropertyKey &key, Value *data) {
+    assert(data != nullptr);
+    data->setUndefined();
+
+    JSValueRef exception = nullptr;
+    JSValueRef jsValue = JSObjectGetProperty(__cx, _obj, getPropertyKeyString(key), &exception);
+    if (exception != nullptr) {
+        ScriptEngine::getInstance()->_clearException(exception);
+        return false;
+    }
+    if (JSValueIsUndefined(__cx, jsValue)) {
+        return false;
+    }
+    internal::jsToSeValue(__cx, jsValue, data);
+    return true;
+}
+
+bool Object::setProperty(const PropertyKey &key, const Value &v) {
+    JSValueRef jsValue = nullptr;
+    internal::seToJsValue(__cx, v, &jsValue);
+
+    JSValueRef exception = nullptr;
+    JSObjectSetProperty(__cx, _obj, getPropertyKeyString(key), jsValue, kJSPropertyAttributeNone, &exception);
+    if (exception != nullptr) {
+        ScriptEngine::getInstance()->_clearException(exception);
+        return false;
+    }
+    return true;
+}
+
 bool Object::defineProperty(const char *name, JSObjectCallAsFunctionCallback getter, JSObjectCallAsFunctionCallback setter) {
     return internal::defineProperty(this, name, getter, setter);
 }
@@ -885,11 +971,21 @@ void Object::setContext(JSContextRef cx) {
 
 void Object::cleanup() {
     ScriptEngine::getInstance()->addAfterCleanupHook([]() {
-        const auto &instance = NativePtrToObjectMap::instance();
+        // Releasing an object may erase other entries, so walk a snapshot of the keys.
+        std::vector<void *> nativeObjs;
+        nativeObjs.reserve(NativePtrToObjectMap::size());
+        for (const auto &e : NativePtrToObjectMap::instance()) {
+            nativeObjs.push_back(e.first);
+        }
+
         se::Object *obj = nullptr;
-        for (const auto &e : instance) {
-            obj = e.second;
-            obj->_isCleanup = true; // _cleanup will invoke NativePtrToObjectMap::erase method which will break this for loop. It isn't needed at ScriptEngine::cleanup step.
+        for (void *key : nativeObjs) {
+            auto iter = NativePtrToObjectMap::find(key);
+            if (iter == NativePtrToObjectMap::end()) {
+                continue;
+            }
+            obj = iter->second;
+            obj->_isCleanup = true; // _cleanup will invoke NativePtrToObjectMap::erase method which isn't needed at ScriptEngine::cleanup step.
             obj->decRef();
         }
 
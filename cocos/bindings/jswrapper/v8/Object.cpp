@@ -34,6 +34,7 @@
 
     #include <memory>
     #include <unordered_map>
+    #include <vector>
 
 namespace se {
 
@@ -42,6 +43,20 @@ std::unique_ptr<std::unordered_map<Object *, void *>> __objectMap; // Currently,
 namespace {
 v8::Isolate *__isolate = nullptr;
 uint32_t _nativeObjectId = 0;
+
+// Internalized names of PropertyKey, they live as long as the isolate
+std::vector<v8::Eternal<v8::String>> __propertyKeys;
+
+v8::Local<v8::String> getPropertyKeyString(const PropertyKey &key) {
+    if (key.getIndex() >= __propertyKeys.size()) {
+        __propertyKeys.resize(key.getIndex() + 1);
+    }
+    v8::Eternal<v8::String> &eternal = __propertyKeys[key.getIndex()];
+    if (eternal.IsEmpty()) {
+        eternal.Set(__isolate, v8::String::NewFromUtf8(__isolate, key.getName(), v8::NewStringType::kInternalized).ToLocalChecked());
+    }
+    return eternal.Get(__isolate);
+}
 } // namespace
 
 Object::Object()
@@ -99,10 +114,20 @@ void Object::cleanup() {
     Object *obj = nullptr;
     Class *cls = nullptr;
 
-    const auto &nativePtrToObjectMap = NativePtrToObjectMap::instance();
-    for (const auto &e : nativePtrToObjectMap) {
-        nativeObj = e.first;
-        obj = e.second;
+    // Finalizers may erase other entries (e.g. spine and dragonBones callbacks), so walk a snapshot of the keys.
+    std::vector<void *> nativeObjs;
+    nativeObjs.reserve(NativePtrToObjectMap::size());
+    for (const auto &e : NativePtrToObjectMap::instance()) {
+        nativeObjs.push_back(e.first);
+    }
+
+    for (void *key : nativeObjs) {
+        auto iter = NativePtrToObjectMap::find(key);
+        if (iter == NativePtrToObjectMap::end()) {
+            continue;
+        }
+        nativeObj = iter->first;
+        obj = iter->second;
 
         if (obj->_finalizeCb != nullptr) {
             obj->_finalizeCb(nativeObj);
@@ -142,6 +167,7 @@ void Object::cleanup() {
     }
 
     __objectMap.reset();
+    __propertyKeys.clear();
     __isolate = nullptr;
 }
 
@@ -193,6 +219,13 @@ Object *Object::createArrayBufferObject(void *data, size_t byteLength) {
     return obj;
 }
 
+Object *Object::createExternalArrayBufferObject(void *contents, size_t byteLength, BufferContentsFreeFunc freeFunc, void *freeUserData) {
+    std::shared_ptr<v8::BackingStore> backingStore = v8::ArrayBuffer::NewBackingStore(contents, byteLength, freeFunc, freeUserData);
+    v8::Local<v8::ArrayBuffer>        jsobj        = v8::ArrayBuffer::New(__isolate, backingStore);
+    Object *                          obj          = Object::_createJSObject(nullptr, jsobj);
+    return obj;
+}
+
 Object *Object::createTypedArray(TypedArrayType type, void *data, size_t byteLength) {
     if (type == TypedArrayType::NONE) {
         SE_LOGE("Don't pass se::Object::TypedArrayType::NONE to createTypedArray API!");
@@ -356,6 +389,40 @@ bool Object::setProperty(const char *name, const Value &data) {
     return true;
 }
 
+bool Object::getProperty(const PropertyKey &key, Value *data) {
+    assert(data != nullptr);
+    data->setUndefined();
+
+    v8::HandleScope handle_scope(__isolate);
+
+    if (_obj.persistent().IsEmpty()) {
+        return false;
+    }
+
+    // A single lookup, a missing property reads as undefined
+    v8::MaybeLocal<v8::Value> result = _obj.handle(__isolate)->Get(__isolate->GetCurrentContext(), getPropertyKeyString(key));
+    if (result.IsEmpty()) {
+        return false;
+    }
+    v8::Local<v8::Value> value = result.ToLocalChecked();
+    if (value->IsUndefined()) {
+        return false;
+    }
+    internal::jsToSeValue(__isolate, value, data);
+    return true;
+}
+
+bool Object::setProperty(const PropertyKey &key, const Value &data) {
+    v8::Local<v8::Value> value;
+    internal::seToJsValue(__isolate, data, &value);
+    v8::Maybe<bool> ret = _obj.handle(__isolate)->Set(__isolate->GetCurrentContext(), getPropertyKeyString(key), value);
+    if (ret.IsNothing()) {
+        SE_LOGD("ERROR: %s, Set return nothing ...\n", __FUNCTION__);
+        return false;
+    }
+    return true;
+}
+
 bool Object::defineProperty(const char *name, v8::AccessorNameGetterCallback getter, v8::AccessorNameSetterCallback setter) {
     v8::MaybeLocal<v8::String> nameValue = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
     if (nameValue.IsEmpty())
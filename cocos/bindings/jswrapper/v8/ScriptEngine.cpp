@@ -242,6 +242,17 @@ void ScriptEngine::callExceptionCallback(const char *location, const char *messa
     }
 }
 
+    #if CC_ENABLE_SCRIPT_STARTUP_TIMING
+void ScriptEngine::logFirstScript(const char *fileName) {
+    if (!_isFirstScriptPending) {
+        return;
+    }
+    _isFirstScriptPending = false;
+    SE_LOGD("ScriptEngine::start, first script (%s) runs %.3f ms after start\n", fileName,
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _startTime).count());
+}
+    #endif
+
 void ScriptEngine::onFatalErrorCallback(const char *location, const char *message) {
     std::string errorStr = "[FATAL ERROR] location: ";
     errorStr += location;
@@ -626,6 +637,12 @@ bool ScriptEngine::start() {
     // After ScriptEngine is started, _registerCallbackArray isn't needed. Therefore, clear it here.
     _registerCallbackArray.clear();
 
+    #if CC_ENABLE_SCRIPT_STARTUP_TIMING
+    SE_LOGD("ScriptEngine::start, bindings registered in %.3f ms\n",
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _startTime).count());
+    _isFirstScriptPending = true;
+    #endif
+
     return ok;
 }
 
@@ -675,6 +692,10 @@ bool ScriptEngine::evalString(const char *script, ssize_t length /* = -1 */, Val
     if (fileName == nullptr)
         fileName = "(no filename)";
 
+    #if CC_ENABLE_SCRIPT_STARTUP_TIMING
+    logFirstScript(fileName);
+    #endif
+
     // Fix the source url is too long displayed in Chrome debugger.
     std::string sourceUrl = fileName;
     static const std::string prefixKey = "/temp/quick-scripts/";
@@ -810,6 +831,10 @@ bool ScriptEngine::saveByteCodeToFile(const std::string &path, const std::string
 }
 
 bool ScriptEngine::runByteCodeFile(const std::string &path_bc, Value *ret /* = nullptr */) {
+    #if CC_ENABLE_SCRIPT_STARTUP_TIMING
+    logFirstScript(path_bc.c_str());
+    #endif
+
     auto fu = cc::FileUtils::getInstance();
 
     cc::Data cachedData;
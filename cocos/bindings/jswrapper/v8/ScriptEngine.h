@@ -27,6 +27,7 @@
 #pragma once
 
 #include "../config.h"
+#include "base/Config.h"
 
 #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
 
@@ -325,6 +326,9 @@ private:
          */
     bool runByteCodeFile(const std::string &path_bc, Value *ret /* = nullptr */);
     void callExceptionCallback(const char *, const char *, const char *);
+    #if CC_ENABLE_SCRIPT_STARTUP_TIMING
+    void logFirstScript(const char *fileName);
+    #endif
 
     std::chrono::steady_clock::time_point _startTime;
     std::vector<RegisterCallback> _registerCallbackArray;
@@ -363,6 +367,9 @@ private:
     bool _isGarbageCollecting;
     bool _isInCleanup;
     bool _isErrorHandleWorking;
+    #if CC_ENABLE_SCRIPT_STARTUP_TIMING
+    bool _isFirstScriptPending{false};
+    #endif
 };
 
 } // namespace se
@@ -30,6 +30,7 @@
 #include "cocos/bindings/manual/jsb_global_init.h"
 #include "cocos/bindings/auto/jsb_cocos_auto.h"
 
+#include "platform/AsyncFileLoader.h"
 #include "storage/local-storage/LocalStorage.h"
 
 using namespace cc;
@@ -277,6 +278,23 @@ static bool JSB_localStorageClear(se::State &s) {
 }
 SE_BIND_FUNC(JSB_localStorageClear)
 
+static bool JSB_localStorageSetFlushInterval(se::State &s) {
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        bool ok = true;
+        float seconds = 0.F;
+        ok = seval_to_float(args[0], &seconds);
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        localStorageSetFlushInterval(seconds);
+        return true;
+    }
+
+    SE_REPORT_ERROR("Invalid number of arguments");
+    return false;
+}
+SE_BIND_FUNC(JSB_localStorageSetFlushInterval)
+
 static bool JSB_localStorageKey(se::State &s) {
     const auto &args = s.args();
     size_t argc = args.size();
@@ -328,6 +346,7 @@ static bool register_sys_localStorage(se::Object *obj) {
     localStorageObj->defineFunction("setItem", _SE(JSB_localStorageSetItem));
     localStorageObj->defineFunction("clear", _SE(JSB_localStorageClear));
     localStorageObj->defineFunction("key", _SE(JSB_localStorageKey));
+    localStorageObj->defineFunction("setFlushInterval", _SE(JSB_localStorageSetFlushInterval));
     localStorageObj->defineProperty("length", _SE(JSB_localStorage_getLength), nullptr);
 
     std::string strFilePath = cc::FileUtils::getInstance()->getWritablePath();
@@ -650,6 +669,65 @@ static bool js_engine_FileUtils_listFilesRecursively(se::State &s) {
 }
 SE_BIND_FUNC(js_engine_FileUtils_listFilesRecursively)
 
+// loadFilesAsync(paths, priority, callback), the callback receives an ArrayBuffer or null per path
+static bool js_engine_FileUtils_loadFilesAsync(se::State &s) {
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 3) {
+        std::vector<std::string> arg0;
+        int32_t arg1 = 0;
+        ok &= seval_to_std_vector_string(args[0], &arg0);
+        ok &= seval_to_int32(args[1], &arg1);
+        SE_PRECONDITION2(ok && args[2].isObject() && args[2].toObject()->isFunction(), false, "js_engine_FileUtils_loadFilesAsync : Error processing arguments");
+
+        std::vector<FileLoadRequest> requests(arg0.size());
+        for (size_t i = 0; i < arg0.size(); ++i) {
+            requests[i].path = std::move(arg0[i]);
+            requests[i].priority = arg1;
+        }
+
+        std::shared_ptr<se::Value> callbackPtr = std::make_shared<se::Value>(args[2]);
+        uint32_t batchId = AsyncFileLoader::getInstance()->loadBatch(requests, [callbackPtr](std::vector<FileLoadResult> &results) {
+            se::AutoHandleScope hs;
+            se::HandleObject list(se::Object::createArrayObject(results.size()));
+            for (uint32_t i = 0; i < static_cast<uint32_t>(results.size()); ++i) {
+                se::Value dataVal;
+                if (results[i].status == FileUtils::Status::OK) {
+                    Data_to_seval(results[i].data, &dataVal);
+                } else {
+                    dataVal.setNull();
+                }
+                list->setArrayElement(i, dataVal);
+            }
+            se::ValueArray seArgs;
+            seArgs.push_back(se::Value(list));
+            callbackPtr->toObject()->call(seArgs, nullptr);
+        });
+        s.rval().setUint32(batchId);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 3);
+    return false;
+}
+SE_BIND_FUNC(js_engine_FileUtils_loadFilesAsync)
+
+static bool js_engine_FileUtils_cancelLoadFiles(se::State &s) {
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        uint32_t arg0 = 0;
+        ok &= seval_to_uint32(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "js_engine_FileUtils_cancelLoadFiles : Error processing arguments");
+        AsyncFileLoader::getInstance()->cancel(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_engine_FileUtils_cancelLoadFiles)
+
 static bool js_se_setExceptionCallback(se::State &s) {
     auto &args = s.args();
     if (args.size() != 1 || !args[0].isObject() || !args[0].toObject()->isFunction()) {
@@ -682,6 +760,8 @@ SE_BIND_FUNC(js_se_setExceptionCallback)
 
 static bool register_filetuils_ext(se::Object *obj) {
     __jsb_cc_FileUtils_proto->defineFunction("listFilesRecursively", _SE(js_engine_FileUtils_listFilesRecursively));
+    __jsb_cc_FileUtils_proto->defineFunction("loadFilesAsync", _SE(js_engine_FileUtils_loadFilesAsync));
+    __jsb_cc_FileUtils_proto->defineFunction("cancelLoadFiles", _SE(js_engine_FileUtils_cancelLoadFiles));
     return true;
 }
 
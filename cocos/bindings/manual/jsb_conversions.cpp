@@ -32,6 +32,78 @@
 #include "gfx-base/GFXDef.h"
 #include "math/Math.h"
 
+namespace {
+
+// Keys of the structs marshalled as plain objects, their engine strings are created once
+const se::PropertyKey KEY_X("x");
+const se::PropertyKey KEY_Y("y");
+const se::PropertyKey KEY_Z("z");
+const se::PropertyKey KEY_W("w");
+const se::PropertyKey KEY_WIDTH("width");
+const se::PropertyKey KEY_HEIGHT("height");
+const se::PropertyKey KEY_MAT4[16] = {
+    se::PropertyKey("m00"), se::PropertyKey("m01"), se::PropertyKey("m02"), se::PropertyKey("m03"),
+    se::PropertyKey("m04"), se::PropertyKey("m05"), se::PropertyKey("m06"), se::PropertyKey("m07"),
+    se::PropertyKey("m08"), se::PropertyKey("m09"), se::PropertyKey("m10"), se::PropertyKey("m11"),
+    se::PropertyKey("m12"), se::PropertyKey("m13"), se::PropertyKey("m14"), se::PropertyKey("m15")};
+
+template <typename T>
+struct FloatField {
+    const se::PropertyKey &key;
+    float T::*member;
+};
+
+const FloatField<cc::Vec2> VEC2_FIELDS[] = {{KEY_X, &cc::Vec2::x}, {KEY_Y, &cc::Vec2::y}};
+const FloatField<cc::Vec3> VEC3_FIELDS[] = {{KEY_X, &cc::Vec3::x}, {KEY_Y, &cc::Vec3::y}, {KEY_Z, &cc::Vec3::z}};
+const FloatField<cc::Vec4> VEC4_FIELDS[] = {{KEY_X, &cc::Vec4::x}, {KEY_Y, &cc::Vec4::y}, {KEY_Z, &cc::Vec4::z}, {KEY_W, &cc::Vec4::w}};
+const FloatField<cc::Size> SIZE_FIELDS[] = {{KEY_WIDTH, &cc::Size::width}, {KEY_HEIGHT, &cc::Size::height}};
+
+// Reads the numbers of a Float32Array, false if it isn't one or its length differs
+bool readFloat32Array(se::Object *obj, float *out, size_t count) {
+    uint8_t *ptr = nullptr;
+    size_t length = 0;
+    if (obj->getTypedArrayType() != se::Object::TypedArrayType::FLOAT32 || !obj->getTypedArrayData(&ptr, &length) || length != count * sizeof(float)) {
+        return false;
+    }
+    memcpy(out, ptr, length);
+    return true;
+}
+
+// Fills the listed fields from an object, or in order from a Float32Array of the same length
+template <typename T, size_t N>
+bool sevalToFloatFields(se::Object *obj, const FloatField<T> (&fields)[N], T *out) {
+    if (obj->isTypedArray()) {
+        float values[N];
+        if (!readFloat32Array(obj, values, N)) {
+            return false;
+        }
+        for (size_t i = 0; i < N; ++i) {
+            out->*fields[i].member = values[i];
+        }
+        return true;
+    }
+
+    se::Value tmp;
+    for (const auto &field : fields) {
+        if (!obj->getProperty(field.key, &tmp) || !tmp.isNumber()) {
+            return false;
+        }
+        out->*field.member = tmp.toFloat();
+    }
+    return true;
+}
+
+template <typename T, size_t N>
+void floatFieldsToSeval(const T &v, const FloatField<T> (&fields)[N], se::Value *ret) {
+    se::HandleObject obj(se::Object::createPlainObject());
+    for (const auto &field : fields) {
+        obj->setProperty(field.key, se::Value(v.*field.member));
+    }
+    ret->setObject(obj);
+}
+
+} // namespace
+
 // seval to native
 
 bool seval_to_int32(const se::Value &v, int32_t *ret) {
@@ -224,58 +296,24 @@ bool seval_to_std_string(const se::Value &v, std::string *ret) {
 bool seval_to_Vec2(const se::Value &v, cc::Vec2 *pt) {
     assert(pt != nullptr);
     SE_PRECONDITION2(v.isObject(), false, "Convert parameter to Vec2 failed!");
-    se::Object *obj = v.toObject();
-    se::Value   x;
-    se::Value   y;
-    bool        ok = obj->getProperty("x", &x);
-    SE_PRECONDITION3(ok && x.isNumber(), false, *pt = cc::Vec2::ZERO);
-    ok = obj->getProperty("y", &y);
-    SE_PRECONDITION3(ok && y.isNumber(), false, *pt = cc::Vec2::ZERO);
-    pt->x = x.toFloat();
-    pt->y = y.toFloat();
+    bool ok = sevalToFloatFields(v.toObject(), VEC2_FIELDS, pt);
+    SE_PRECONDITION3(ok, false, *pt = cc::Vec2::ZERO);
     return true;
 }
 
 bool seval_to_Vec3(const se::Value &v, cc::Vec3 *pt) {
     assert(pt != nullptr);
     SE_PRECONDITION2(v.isObject(), false, "Convert parameter to Vec3 failed!");
-    se::Object *obj = v.toObject();
-    se::Value   x;
-    se::Value   y;
-    se::Value   z;
-    bool        ok = obj->getProperty("x", &x);
-    SE_PRECONDITION3(ok && x.isNumber(), false, *pt = cc::Vec3::ZERO);
-    ok = obj->getProperty("y", &y);
-    SE_PRECONDITION3(ok && y.isNumber(), false, *pt = cc::Vec3::ZERO);
-    ok = obj->getProperty("z", &z);
-    SE_PRECONDITION3(ok && z.isNumber(), false, *pt = cc::Vec3::ZERO);
-    pt->x = x.toFloat();
-    pt->y = y.toFloat();
-    pt->z = z.toFloat();
+    bool ok = sevalToFloatFields(v.toObject(), VEC3_FIELDS, pt);
+    SE_PRECONDITION3(ok, false, *pt = cc::Vec3::ZERO);
     return true;
 }
 
 bool seval_to_Vec4(const se::Value &v, cc::Vec4 *pt) {
     assert(pt != nullptr);
     SE_PRECONDITION2(v.isObject(), false, "Convert parameter to Vec4 failed!");
-    pt->x = pt->y = pt->z = pt->w = 0.0f;
-    se::Object *obj               = v.toObject();
-    se::Value   x;
-    se::Value   y;
-    se::Value   z;
-    se::Value   w;
-    bool        ok = obj->getProperty("x", &x);
-    SE_PRECONDITION3(ok && x.isNumber(), false, *pt = cc::Vec4::ZERO);
-    ok = obj->getProperty("y", &y);
-    SE_PRECONDITION3(ok && y.isNumber(), false, *pt = cc::Vec4::ZERO);
-    ok = obj->getProperty("z", &z);
-    SE_PRECONDITION3(ok && z.isNumber(), false, *pt = cc::Vec4::ZERO);
-    ok = obj->getProperty("w", &w);
-    SE_PRECONDITION3(ok && w.isNumber(), false, *pt = cc::Vec4::ZERO);
-    pt->x = x.toFloat();
-    pt->y = y.toFloat();
-    pt->z = z.toFloat();
-    pt->w = w.toFloat();
+    bool ok = sevalToFloatFields(v.toObject(), VEC4_FIELDS, pt);
+    SE_PRECONDITION3(ok, false, *pt = cc::Vec4::ZERO);
     return true;
 }
 
@@ -308,19 +346,12 @@ bool seval_to_Mat4(const se::Value &v, cc::Mat4 *mat) {
         uint8_t *ptr    = nullptr;
         obj->getTypedArrayData(&ptr, &length);
 
-        memcpy(mat->m, ptr, length);
+        memcpy(mat->m, ptr, std::min(length, sizeof(mat->m)));
     } else {
-        bool        ok = false;
-        se::Value   tmp;
-        std::string prefix = "m";
+        bool      ok = false;
+        se::Value tmp;
         for (uint32_t i = 0; i < 16; ++i) {
-            std::string name;
-            if (i < 10) {
-                name = prefix + "0" + std::to_string(i);
-            } else {
-                name = prefix + std::to_string(i);
-            }
-            ok = obj->getProperty(name.c_str(), &tmp);
+            ok = obj->getProperty(KEY_MAT4[i], &tmp);
             SE_PRECONDITION3(ok, false, *mat = cc::Mat4::IDENTITY);
 
             if (tmp.isNumber()) {
@@ -373,16 +404,8 @@ bool seval_to_uintptr_t(const se::Value &v, uintptr_t *ret) {
 bool seval_to_Size(const se::Value &v, cc::Size *size) {
     assert(size != nullptr);
     SE_PRECONDITION2(v.isObject(), false, "Convert parameter to Size failed!");
-    se::Object *obj = v.toObject();
-    se::Value   width;
-    se::Value   height;
-
-    bool ok = obj->getProperty("width", &width);
-    SE_PRECONDITION3(ok && width.isNumber(), false, *size = cc::Size::ZERO);
-    ok = obj->getProperty("height", &height);
-    SE_PRECONDITION3(ok && height.isNumber(), false, *size = cc::Size::ZERO);
-    size->width  = width.toFloat();
-    size->height = height.toFloat();
+    bool ok = sevalToFloatFields(v.toObject(), SIZE_FIELDS, size);
+    SE_PRECONDITION3(ok, false, *size = cc::Size::ZERO);
     return true;
 }
 
@@ -849,34 +872,19 @@ bool std_string_to_seval(const std::string &v, se::Value *ret) {
 
 bool Vec2_to_seval(const cc::Vec2 &v, se::Value *ret) {
     assert(ret != nullptr);
-    se::HandleObject obj(se::Object::createPlainObject());
-    obj->setProperty("x", se::Value(v.x));
-    obj->setProperty("y", se::Value(v.y));
-    ret->setObject(obj);
-
+    floatFieldsToSeval(v, VEC2_FIELDS, ret);
     return true;
 }
 
 bool Vec3_to_seval(const cc::Vec3 &v, se::Value *ret) {
     assert(ret != nullptr);
-    se::HandleObject obj(se::Object::createPlainObject());
-    obj->setProperty("x", se::Value(v.x));
-    obj->setProperty("y", se::Value(v.y));
-    obj->setProperty("z", se::Value(v.z));
-    ret->setObject(obj);
-
+    floatFieldsToSeval(v, VEC3_FIELDS, ret);
     return true;
 }
 
 bool Vec4_to_seval(const cc::Vec4 &v, se::Value *ret) {
     assert(ret != nullptr);
-    se::HandleObject obj(se::Object::createPlainObject());
-    obj->setProperty("x", se::Value(v.x));
-    obj->setProperty("y", se::Value(v.y));
-    obj->setProperty("z", se::Value(v.z));
-    obj->setProperty("w", se::Value(v.w));
-    ret->setObject(obj);
-
+    floatFieldsToSeval(v, VEC4_FIELDS, ret);
     return true;
 }
 
@@ -894,10 +902,7 @@ bool Mat4_to_seval(const cc::Mat4 &v, se::Value *ret) {
 
 bool Size_to_seval(const cc::Size &v, se::Value *ret) {
     assert(ret != nullptr);
-    se::HandleObject obj(se::Object::createPlainObject());
-    obj->setProperty("width", se::Value(v.width));
-    obj->setProperty("height", se::Value(v.height));
-    ret->setObject(obj);
+    floatFieldsToSeval(v, SIZE_FIELDS, ret);
     return true;
 }
 
@@ -27,6 +27,7 @@
 
 #include "bindings/jswrapper/SeApi.h"
 #include "bindings/manual/jsb_classtype.h"
+#include "cocos/base/Object.h"
 #include "cocos/base/Vector.h"
 #include "cocos/base/Map.h"
 #include "cocos/math/Vec2.h"
@@ -422,6 +423,19 @@ bool DownloadTask_to_seval(const cc::network::DownloadTask &v, se::Value *ret);
 #if USE_GFX_RENDERER
 #endif
 
+// Objects derived from cc::Object remember their slot in the map, so most lookups don't hash
+template <typename T>
+se::NativePtrToObjectMap::Map::iterator find_native_ptr_object(const T *v) {
+    void *nativeObj = const_cast<void *>(static_cast<const void *>(v));
+#if CC_ENABLE_SCRIPT_MAPPING_HINT
+    if constexpr (std::is_convertible<const T *, const cc::Object *>::value) {
+        auto *ccObj = const_cast<cc::Object *>(static_cast<const cc::Object *>(v));
+        return se::NativePtrToObjectMap::find(nativeObj, ccObj->getScriptMappingHint());
+    }
+#endif
+    return se::NativePtrToObjectMap::find(nativeObj);
+}
+
 template <typename T>
 typename std::enable_if<!std::is_base_of<cc::Ref, T>::value, bool>::type
 native_ptr_to_seval(T *v_c, se::Value *ret, bool *isReturnCachedValue = nullptr) {
@@ -434,7 +448,7 @@ native_ptr_to_seval(T *v_c, se::Value *ret, bool *isReturnCachedValue = nullptr)
     }
 
     se::Object *obj = nullptr;
-    auto iter = se::NativePtrToObjectMap::find(v);
+    auto iter = find_native_ptr_object(v);
     if (iter == se::NativePtrToObjectMap::end()) { // If we couldn't find native object in map, then the native object is created from native code. e.g. TMXLayer::getTileAt
         // CC_LOG_DEBUGWARN("WARNING: non-Ref type: (%s) isn't catched!", typeid(*v).name());
         se::Class *cls = JSBClassType::findClass<T>(v);
@@ -470,7 +484,7 @@ native_ptr_to_seval(T &v_ref, se::Value *ret, bool *isReturnCachedValue = nullpt
     }
 
     se::Object *obj = nullptr;
-    auto iter = se::NativePtrToObjectMap::find(v);
+    auto iter = find_native_ptr_object(v);
     if (iter == se::NativePtrToObjectMap::end()) { // If we couldn't find native object in map, then the native object is created from native code. e.g. TMXLayer::getTileAt
         // CC_LOG_DEBUGWARN("WARNING: non-Ref type: (%s) isn't catched!", typeid(*v).name());
         se::Class *cls = JSBClassType::findClass<DecayT>(v);
@@ -501,7 +515,7 @@ bool native_ptr_to_rooted_seval(const typename std::enable_if<!std::is_base_of<c
     }
 
     se::Object *obj = nullptr;
-    auto iter = se::NativePtrToObjectMap::find((void *)v);
+    auto iter = find_native_ptr_object(v);
     if (iter == se::NativePtrToObjectMap::end()) { // If we couldn't find native object in map, then the native object is created from native code. e.g. TMXLayer::getTileAt
         se::Class *cls = JSBClassType::findClass<T>(v);
         assert(cls != nullptr);
@@ -538,7 +552,7 @@ native_ptr_to_seval(T *vp, se::Class *cls, se::Value *ret, bool *isReturnCachedV
     }
 
     se::Object *obj = nullptr;
-    auto iter = se::NativePtrToObjectMap::find(v);
+    auto iter = find_native_ptr_object(v);
     if (iter == se::NativePtrToObjectMap::end()) { // If we couldn't find native object in map, then the native object is created from native code. e.g. TMXLayer::getTileAt
                                                    //        CC_LOG_DEBUGWARN("WARNING: Ref type: (%s) isn't catched!", typeid(*v).name());
         assert(cls != nullptr);
@@ -574,7 +588,7 @@ native_ptr_to_seval(T &v_ref, se::Class *cls, se::Value *ret, bool *isReturnCach
     }
 
     se::Object *obj = nullptr;
-    auto iter = se::NativePtrToObjectMap::find(v);
+    auto iter = find_native_ptr_object(v);
     if (iter == se::NativePtrToObjectMap::end()) { // If we couldn't find native object in map, then the native object is created from native code. e.g. TMXLayer::getTileAt
         //        CC_LOG_DEBUGWARN("WARNING: Ref type: (%s) isn't catched!", typeid(*v).name());
         assert(cls != nullptr);
@@ -605,7 +619,7 @@ bool native_ptr_to_rooted_seval(typename std::enable_if<!std::is_base_of<cc::Ref
     }
 
     se::Object *obj = nullptr;
-    auto iter = se::NativePtrToObjectMap::find(v);
+    auto iter = find_native_ptr_object(v);
     if (iter == se::NativePtrToObjectMap::end()) { // If we couldn't find native object in map, then the native object is created from native code. e.g. TMXLayer::getTileAt
         assert(cls != nullptr);
         obj = se::Object::createObjectWithClass(cls);
@@ -641,7 +655,7 @@ native_ptr_to_seval(T *vp, se::Value *ret, bool *isReturnCachedValue = nullptr)
     }
 
     se::Object *obj = nullptr;
-    auto iter = se::NativePtrToObjectMap::find(v);
+    auto iter = find_native_ptr_object(v);
     if (iter == se::NativePtrToObjectMap::end()) { // If we couldn't find native object in map, then the native object is created from native code. e.g. TMXLayer::getTileAt
                                                    //        CC_LOG_DEBUGWARN("WARNING: Ref type: (%s) isn't catched!", typeid(*v).name());
         se::Class *cls = JSBClassType::findClass<T>(v);
@@ -677,7 +691,7 @@ native_ptr_to_seval(T *vp, se::Class *cls, se::Value *ret, bool *isReturnCachedV
     }
 
     se::Object *obj = nullptr;
-    auto iter = se::NativePtrToObjectMap::find(v);
+    auto iter = find_native_ptr_object(v);
     if (iter == se::NativePtrToObjectMap::end()) { // If we couldn't find native object in map, then the native object is created from native code. e.g. TMXLayer::getTileAt
                                                    //        CC_LOG_DEBUGWARN("WARNING: Ref type: (%s) isn't catched!", typeid(*v).name());
         assert(cls != nullptr);
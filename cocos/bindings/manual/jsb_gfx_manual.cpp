@@ -28,8 +28,11 @@
 #include "bindings/jswrapper/SeApi.h"
 #include "bindings/manual/jsb_conversions.h"
 #include "bindings/manual/jsb_global.h"
+#include "renderer/gfx-base/GFXCommandStream.h"
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
 bool js_gfx_Device_copyBuffersToTexture(se::State &s) {
@@ -458,6 +461,178 @@ static bool js_gfx_InputAssembler_extractDrawInfo(se::State &s) {
 }
 SE_BIND_FUNC(js_gfx_InputAssembler_extractDrawInfo)
 
+/********************************************************
+   CommandStream binding
+ *******************************************************/
+static se::Class *jsb_gfx_CommandStream_class = nullptr; // NOLINT
+
+// replaces the shared storage with a bigger ArrayBuffer exposed as `buffer`, keeping what's been written
+static bool commandStreamReserve(se::Object *jsStream, cc::gfx::CommandStream *stream, uint wordCount) {
+    if (wordCount <= stream->getCapacity()) {
+        return true;
+    }
+    uint capacity = std::max(wordCount, stream->getCapacity() * 2U);
+
+    se::HandleObject buffer(se::Object::createArrayBufferObject(nullptr, capacity * sizeof(uint32_t)));
+    uint8_t *        data   = nullptr;
+    size_t           length = 0;
+    if (!buffer->getArrayBufferData(&data, &length)) {
+        return false;
+    }
+    if (stream->getStorage()) {
+        memcpy(data, stream->getStorage(), stream->getCapacity() * sizeof(uint32_t));
+    }
+    // the property keeps the ArrayBuffer, and so the storage, alive as long as the stream
+    jsStream->setProperty("buffer", se::Value(buffer));
+    stream->setStorage(reinterpret_cast<uint32_t *>(data), capacity);
+    return true;
+}
+
+SE_DECLARE_FINALIZE_FUNC(js_gfx_CommandStream_finalize)
+
+static bool js_gfx_CommandStream_constructor(se::State &s) { // NOLINT
+    const auto &args = s.args();
+    size_t      argc = args.size();
+    if (argc == 1) {
+        uint capacity = 0;
+        bool ok       = seval_to_uint(args[0], &capacity);
+        SE_PRECONDITION2(ok, false, "js_gfx_CommandStream_constructor : Error processing arguments");
+
+        auto *stream = JSB_ALLOC(cc::gfx::CommandStream);
+        s.thisObject()->setPrivateData(stream);
+        se::NonRefNativePtrCreatedByCtorMap::emplace(stream);
+
+        // holds the script objects of the object table, the stream only keeps their native pointers
+        se::HandleObject objects(se::Object::createArrayObject(0));
+        s.thisObject()->setProperty("__objects", se::Value(objects));
+        return commandStreamReserve(s.thisObject(), stream, std::max(capacity, 1U));
+    }
+
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_CTOR(js_gfx_CommandStream_constructor, jsb_gfx_CommandStream_class, js_gfx_CommandStream_finalize)
+
+static bool js_gfx_CommandStream_finalize(se::State &s) { // NOLINT
+    auto iter = se::NonRefNativePtrCreatedByCtorMap::find(s.nativeThisObject());
+    if (iter != se::NonRefNativePtrCreatedByCtorMap::end()) {
+        se::NonRefNativePtrCreatedByCtorMap::erase(iter);
+        auto *cobj = static_cast<cc::gfx::CommandStream *>(s.nativeThisObject());
+        JSB_FREE(cobj);
+    }
+    return true;
+}
+SE_BIND_FINALIZE_FUNC(js_gfx_CommandStream_finalize)
+
+static bool js_gfx_CommandStream_reserve(se::State &s) {
+    auto *cobj = static_cast<cc::gfx::CommandStream *>(s.nativeThisObject());
+    SE_PRECONDITION2(cobj, false, "js_gfx_CommandStream_reserve : Invalid Native Object");
+    const auto &args = s.args();
+    size_t      argc = args.size();
+    if (argc == 1) {
+        uint wordCount = 0;
+        bool ok        = seval_to_uint(args[0], &wordCount);
+        SE_PRECONDITION2(ok, false, "js_gfx_CommandStream_reserve : Error processing arguments");
+        ok = commandStreamReserve(s.thisObject(), cobj, wordCount);
+        SE_PRECONDITION2(ok, false, "js_gfx_CommandStream_reserve : Failed to allocate storage");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_gfx_CommandStream_reserve)
+
+// Only instances of the registered GFXObject subclasses can be referenced by a command stream
+static bool isGFXObjectClass(const se::Class *cls) {
+    const se::Class *gfxClasses[] = {
+        __jsb_cc_gfx_Buffer_class,
+        __jsb_cc_gfx_Texture_class,
+        __jsb_cc_gfx_Sampler_class,
+        __jsb_cc_gfx_Shader_class,
+        __jsb_cc_gfx_RenderPass_class,
+        __jsb_cc_gfx_Framebuffer_class,
+        __jsb_cc_gfx_DescriptorSetLayout_class,
+        __jsb_cc_gfx_PipelineLayout_class,
+        __jsb_cc_gfx_PipelineState_class,
+        __jsb_cc_gfx_DescriptorSet_class,
+        __jsb_cc_gfx_InputAssembler_class,
+        __jsb_cc_gfx_CommandBuffer_class,
+        __jsb_cc_gfx_Queue_class,
+        __jsb_cc_gfx_GlobalBarrier_class,
+        __jsb_cc_gfx_TextureBarrier_class,
+    };
+    return cls && std::find(std::begin(gfxClasses), std::end(gfxClasses), cls) != std::end(gfxClasses);
+}
+
+static bool js_gfx_CommandStream_setObject(se::State &s) {
+    auto *cobj = static_cast<cc::gfx::CommandStream *>(s.nativeThisObject());
+    SE_PRECONDITION2(cobj, false, "js_gfx_CommandStream_setObject : Invalid Native Object");
+    const auto &args = s.args();
+    size_t      argc = args.size();
+    if (argc == 2) {
+        uint index = 0;
+        bool ok    = seval_to_uint(args[0], &index);
+        SE_PRECONDITION2(ok, false, "js_gfx_CommandStream_setObject : Error processing arguments");
+
+        cc::gfx::GFXObject *object = nullptr;
+        if (args[1].isObject()) {
+            se::Object *jsObject = args[1].toObject();
+            SE_PRECONDITION2(isGFXObjectClass(jsObject->_getClass()), false, "js_gfx_CommandStream_setObject : Not a GFX Object");
+            object = static_cast<cc::gfx::GFXObject *>(jsObject->getPrivateData());
+            SE_PRECONDITION2(object, false, "js_gfx_CommandStream_setObject : Invalid GFX Object");
+        }
+
+        se::Value objects;
+        if (s.thisObject()->getProperty("__objects", &objects) && objects.isObject()) {
+            objects.toObject()->setArrayElement(index, object ? args[1] : se::Value::Null);
+        }
+        cobj->setObject(index, object);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+    return false;
+}
+SE_BIND_FUNC(js_gfx_CommandStream_setObject)
+
+static bool js_gfx_CommandStream_replay(se::State &s) {
+    auto *cobj = static_cast<cc::gfx::CommandStream *>(s.nativeThisObject());
+    SE_PRECONDITION2(cobj, false, "js_gfx_CommandStream_replay : Invalid Native Object");
+    const auto &args = s.args();
+    size_t      argc = args.size();
+    if (argc == 2) {
+        cc::gfx::CommandBuffer *cmdBuff   = nullptr;
+        uint                    wordCount = 0;
+
+        bool ok = true;
+        ok &= seval_to_native_ptr(args[0], &cmdBuff);
+        ok &= seval_to_uint(args[1], &wordCount);
+        SE_PRECONDITION2(ok && cmdBuff, false, "js_gfx_CommandStream_replay : Error processing arguments");
+        SE_PRECONDITION2(wordCount <= cobj->getCapacity(), false, "js_gfx_CommandStream_replay : Word count exceeds the stream");
+
+        s.rval().setBoolean(cobj->replay(cmdBuff, wordCount));
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+    return false;
+}
+SE_BIND_FUNC(js_gfx_CommandStream_replay)
+
+static bool js_register_gfx_CommandStream(se::Object *ns) { // NOLINT
+    se::Class *cls = se::Class::create("CommandStream", ns, nullptr, _SE(js_gfx_CommandStream_constructor));
+
+    cls->defineFunction("reserve", _SE(js_gfx_CommandStream_reserve));
+    cls->defineFunction("setObject", _SE(js_gfx_CommandStream_setObject));
+    cls->defineFunction("replay", _SE(js_gfx_CommandStream_replay));
+    cls->defineFinalizeFunction(_SE(js_gfx_CommandStream_finalize));
+    cls->install();
+    JSBClassType::registerClass<cc::gfx::CommandStream>(cls);
+
+    jsb_gfx_CommandStream_class = cls; // NOLINT
+
+    se::ScriptEngine::getInstance()->clearException();
+    return true;
+}
+
 bool register_all_gfx_manual(se::Object *obj) {
     __jsb_cc_gfx_Device_proto->defineFunction("copyBuffersToTexture", _SE(js_gfx_Device_copyBuffersToTexture));
     __jsb_cc_gfx_Device_proto->defineFunction("copyTexImagesToTexture", _SE(js_gfx_Device_copyTexImagesToTexture));
@@ -491,5 +666,7 @@ bool register_all_gfx_manual(se::Object *obj) {
         ns->setProperty("deviceInstance", jsret);
     }
 
+    js_register_gfx_CommandStream(ns);
+
     return true;
 }
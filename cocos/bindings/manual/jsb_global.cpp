@@ -24,16 +24,18 @@
 ****************************************************************************/
 
 #include "jsb_global.h"
+#include "base/CompressedTextureDecoder.h"
 #include "base/CoreStd.h"
 #include "base/Scheduler.h"
-#include "base/ThreadPool.h"
 #include "base/ZipUtils.h"
 #include "base/base64.h"
 #include "gfx-base/GFXDef.h"
+#include "gfx-base/GFXDevice.h"
 #include "jsb_conversions.h"
 #include "network/HttpClient.h"
 #include "platform/Application.h"
 #include "platform/Image.h"
+#include "platform/ImageDecoder.h"
 #include "ui/edit-box/EditBox.h"
 #include "xxtea/xxtea.h"
 
@@ -47,7 +49,6 @@
 
 using namespace cc;
 
-static LegacyThreadPool *__threadPool = nullptr;
 
 static std::shared_ptr<cc::network::Downloader>                                               _localDownloader = nullptr;
 static std::map<std::string, std::function<void(const std::string &, unsigned char *, uint)>> _localDownloaderHandlers;
@@ -534,6 +535,28 @@ uint8_t *convertI2RGBA(uint32_t length, uint8_t *src) {
     return dst;
 }
 
+bool isCompressedFormatSupported(cc::gfx::Format format) {
+    const cc::gfx::Device *device = cc::gfx::Device::getInstance();
+    if (!device) return true;
+
+    switch (format) {
+        case cc::gfx::Format::ETC_RGB8:
+            return device->hasFeature(cc::gfx::Feature::FORMAT_ETC1);
+        case cc::gfx::Format::ETC2_RGB8:
+        case cc::gfx::Format::ETC2_SRGB8:
+        case cc::gfx::Format::ETC2_RGBA8:
+        case cc::gfx::Format::ETC2_SRGB8_A8:
+        case cc::gfx::Format::EAC_R11:
+        case cc::gfx::Format::EAC_RG11:
+            return device->hasFeature(cc::gfx::Feature::FORMAT_ETC2);
+        default:
+            if (format >= cc::gfx::Format::ASTC_RGBA_4X4 && format <= cc::gfx::Format::ASTC_SRGBA_12X12) {
+                return device->hasFeature(cc::gfx::Feature::FORMAT_ASTC);
+            }
+            return true;
+    }
+}
+
 struct ImageInfo *createImageInfo(Image *img) {
     struct ImageInfo *imgInfo = new struct ImageInfo();
     imgInfo->length           = (uint32_t)img->getDataLen();
@@ -543,6 +566,25 @@ struct ImageInfo *createImageInfo(Image *img) {
     imgInfo->format     = img->getRenderFormat();
     imgInfo->compressed = img->isCompressed();
 
+    // Decode on the CPU if the device can't sample the compressed format,
+    // only the first mip level is kept.
+    if (imgInfo->compressed && !isCompressedFormatSupported(imgInfo->format) && cc::isSoftwareDecodable(imgInfo->format)) {
+        const size_t length = cc::getDecodedTextureSize(imgInfo->width, imgInfo->height, cc::DecodedTextureFormat::RGBA8);
+        auto *dst           = reinterpret_cast<uint8_t *>(malloc(length));
+        if (cc::decodeCompressedTexture(imgInfo->format, imgInfo->data, imgInfo->length, imgInfo->width, imgInfo->height,
+                                        cc::DecodedTextureFormat::RGBA8, dst)) {
+            free(imgInfo->data);
+            imgInfo->data       = dst;
+            imgInfo->length     = static_cast<uint32_t>(length);
+            imgInfo->format     = cc::gfx::Format::RGBA8;
+            imgInfo->compressed = false;
+            imgInfo->hasAlpha   = true;
+        } else {
+            SE_LOGE("failed to decode compressed image %s\n", img->getFilePath().c_str());
+            free(dst);
+        }
+    }
+
     // Convert to RGBA888 because standard web api will return only RGBA888.
     // If not, then it may have issue in glTexSubImage. For example, engine
     // will create a big texture, and update its content with small pictures.
@@ -590,49 +632,40 @@ bool jsb_global_load_image(const std::string &path, const se::Value &callbackVal
     std::shared_ptr<se::Value> callbackPtr = std::make_shared<se::Value>(callbackVal);
 
     auto initImageFunc = [path, callbackPtr](const std::string &fullPath, unsigned char *imageData, int imageBytes) {
-        Image *img = new (std::nothrow) Image();
-
-        __threadPool->pushTask([=](int tid) {
-            // NOTE: FileUtils::getInstance()->fullPathForFilename isn't a threadsafe method,
-            // Image::initWithImageFile will call fullPathForFilename internally which may
-            // cause thread race issues. Therefore, we get the full path of file before
-            // going into task callback.
-            // Be careful of invoking any Cocos2d-x interface in a sub-thread.
-            bool loadSucceed = false;
-            if (fullPath.empty()) {
-                loadSucceed = img->initWithImageData(imageData, imageBytes);
-                free(imageData);
+        // Decoded and converted to RGBA on the ImageDecoder threads, the result is handed back on the cocos thread.
+        auto imgInfo = std::make_shared<struct ImageInfo *>(nullptr);
+        auto prepare = [imgInfo](Image *img) {
+            *imgInfo = createImageInfo(img);
+        };
+        // the encoded data must outlive the decode, it's released with the callback even if the decode is dropped
+        std::shared_ptr<unsigned char> source(imageData, free);
+        auto callback = [path, callbackPtr, imgInfo, source](Image *img) {
+            se::AutoHandleScope hs;
+            se::ValueArray      seArgs;
+            se::Value           dataVal;
+
+            if (img) {
+                se::HandleObject retObj(se::Object::createPlainObject());
+                ulong_to_seval((unsigned long)(*imgInfo)->data, &dataVal);
+                retObj->setProperty("data", dataVal);
+                retObj->setProperty("width", se::Value((*imgInfo)->width));
+                retObj->setProperty("height", se::Value((*imgInfo)->height));
+
+                seArgs.push_back(se::Value(retObj));
+
+                delete *imgInfo;
+                img->release();
             } else {
-                loadSucceed = img->initWithImageFile(fullPath);
+                SE_REPORT_ERROR("initWithImageFile: %s failed!", path.c_str());
             }
+            callbackPtr->toObject()->call(seArgs, nullptr);
+        };
 
-            struct ImageInfo *imgInfo = nullptr;
-            if (loadSucceed) {
-                imgInfo = createImageInfo(img);
-            }
-
-            Application::getInstance()->getScheduler()->performFunctionInCocosThread([=]() {
-                se::AutoHandleScope hs;
-                se::ValueArray      seArgs;
-                se::Value           dataVal;
-
-                if (loadSucceed) {
-                    se::HandleObject retObj(se::Object::createPlainObject());
-                    ulong_to_seval((unsigned long)imgInfo->data, &dataVal);
-                    retObj->setProperty("data", dataVal);
-                    retObj->setProperty("width", se::Value(imgInfo->width));
-                    retObj->setProperty("height", se::Value(imgInfo->height));
-
-                    seArgs.push_back(se::Value(retObj));
-
-                    delete imgInfo;
-                } else {
-                    SE_REPORT_ERROR("initWithImageFile: %s failed!", path.c_str());
-                }
-                callbackPtr->toObject()->call(seArgs, nullptr);
-                img->release();
-            });
-        });
+        if (fullPath.empty()) {
+            ImageDecoder::getInstance()->decode(imageData, imageBytes, ImageDecodeOptions(), callback, prepare);
+        } else {
+            ImageDecoder::getInstance()->decodeFile(fullPath, ImageDecodeOptions(), callback, prepare);
+        }
     };
     size_t pos = std::string::npos;
     if (path.find("http://") == 0 || path.find("https://") == 0) {
@@ -837,8 +870,6 @@ SE_BIND_FUNC(JSB_hideInputBox)
 #endif
 
 bool jsb_register_global_variables(se::Object *global) {
-    __threadPool = LegacyThreadPool::newFixedThreadPool(3);
-
     global->defineFunction("require", _SE(require));
     global->defineFunction("requireModule", _SE(moduleRequire));
 
@@ -876,8 +907,8 @@ bool jsb_register_global_variables(se::Object *global) {
     se::ScriptEngine::getInstance()->clearException();
 
     se::ScriptEngine::getInstance()->addBeforeCleanupHook([]() {
-        delete __threadPool;
-        __threadPool = nullptr;
+        // drop pending decodes, their callbacks belong to this VM
+        ImageDecoder::destroyInstance();
 
         PoolManager::getInstance()->getCurrentPool()->clear();
     });
@@ -27,6 +27,7 @@
 #include "cocos/bindings/manual/jsb_module_register.h"
 #include "cocos/bindings/auto/jsb_cocos_auto.h"
 #include "cocos/base/AutoreleasePool.h"
+#include "cocos/base/Config.h"
 #include "cocos/bindings/dop/jsb_dop.h"
 #include "cocos/bindings/auto/jsb_extension_auto.h"
 #include "cocos/bindings/auto/jsb_network_auto.h"
@@ -98,6 +99,112 @@
 
 using namespace cc;
 
+namespace {
+
+/**
+ * A module that owns one property of the global object, which no other module touches.
+ * When lazy registration is enabled, the property is an accessor until script first reads
+ * or writes it, and only then are the module's register callbacks run.
+ */
+struct LazyModule {
+    const char *                       name;
+    se::ScriptEngine::RegisterCallback callbacks[2];
+};
+
+constexpr LazyModule LAZY_MODULES[] = {
+#if USE_MIDDLEWARE && USE_SPINE
+    {"spine", {register_all_spine, register_all_spine_manual}},
+#endif
+#if USE_MIDDLEWARE && USE_DRAGONBONES
+    {"dragonBones", {register_all_dragonbones, register_all_dragonbones_manual}},
+#endif
+#if USE_PHYSICS_PHYSX
+    {"jsb.physics", {register_all_physics, nullptr}},
+#endif
+    {nullptr, {nullptr, nullptr}},
+};
+
+bool registerModule(const LazyModule &module, se::Object *global) {
+    for (auto cb : module.callbacks) {
+        if (cb && !cb(global)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if CC_ENABLE_LAZY_BINDING_REGISTRATION
+
+bool js_materializeModule(se::State &s) {
+    const auto &args = s.args();
+    SE_PRECONDITION2(args.size() == 1 && args[0].isString(), false, "Invalid module name");
+
+    const auto &name = args[0].toString();
+    for (const auto *module = LAZY_MODULES; module->name; ++module) {
+        if (name == module->name) {
+    #if CC_ENABLE_SCRIPT_STARTUP_TIMING
+            auto start = std::chrono::steady_clock::now();
+    #endif
+            bool ok = registerModule(*module, se::ScriptEngine::getInstance()->getGlobalObject());
+    #if CC_ENABLE_SCRIPT_STARTUP_TIMING
+            SE_LOGD("Lazy module %s registered in %.3f ms\n", module->name,
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    #endif
+            SE_PRECONDITION2(ok, false, "Failed to register module %s", module->name);
+            return true;
+        }
+    }
+    SE_REPORT_ERROR("Unknown lazy module %s", name.c_str());
+    return false;
+}
+SE_BIND_FUNC(js_materializeModule)
+
+bool register_lazy_modules(se::Object *global) {
+    if (!LAZY_MODULES[0].name) {
+        return true;
+    }
+
+    // The accessor removes itself before registering, so the module callbacks create the
+    // namespace as a plain data property, exactly as eager registration would.
+    std::string script =
+        "(function (g, names) {\n"
+        "    var materialize = g.__jsb_materializeModule;\n"
+        "    delete g.__jsb_materializeModule;\n"
+        "    names.forEach(function (name) {\n"
+        "        Object.defineProperty(g, name, {\n"
+        "            configurable: true,\n"
+        "            enumerable: true,\n"
+        "            get: function () { delete g[name]; materialize(name); return g[name]; },\n"
+        "            set: function (v) { delete g[name]; materialize(name); g[name] = v; },\n"
+        "        });\n"
+        "    });\n"
+        "})(this, [";
+    for (const auto *module = LAZY_MODULES; module->name; ++module) {
+        script += module == LAZY_MODULES ? "'" : ", '";
+        script += module->name;
+        script += "'";
+    }
+    script += "]);";
+
+    global->defineFunction("__jsb_materializeModule", _SE(js_materializeModule));
+    return se::ScriptEngine::getInstance()->evalString(script.c_str(), static_cast<ssize_t>(script.length()), nullptr, "jsb_lazy_modules");
+}
+
+#else
+
+bool register_lazy_modules(se::Object *global) {
+    for (const auto *module = LAZY_MODULES; module->name; ++module) {
+        if (!registerModule(*module, global)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // CC_ENABLE_LAZY_BINDING_REGISTRATION
+
+} // namespace
+
 bool jsb_register_all_modules() {
     se::ScriptEngine *se = se::ScriptEngine::getInstance();
 
@@ -147,22 +254,10 @@ bool jsb_register_all_modules() {
 
 #if USE_MIDDLEWARE
     se->addRegisterCallback(register_all_editor_support);
-
-    #if USE_SPINE
-    se->addRegisterCallback(register_all_spine);
-    se->addRegisterCallback(register_all_spine_manual);
-    #endif
-
-    #if USE_DRAGONBONES
-    se->addRegisterCallback(register_all_dragonbones);
-    se->addRegisterCallback(register_all_dragonbones_manual);
-    #endif
-
 #endif // USE_MIDDLEWARE
 
-#if USE_PHYSICS_PHYSX
-    se->addRegisterCallback(register_all_physics);
-#endif
+    // spine, dragonBones and physics, see LAZY_MODULES
+    se->addRegisterCallback(register_lazy_modules);
 
 #if (CC_PLATFORM == CC_PLATFORM_MAC_IOS || CC_PLATFORM == CC_PLATFORM_ANDROID)
 
@@ -49,6 +49,68 @@ static bool js_pipeline_RenderPipeline_getMacros(se::State &s) {
 }
 SE_BIND_PROP_GET(js_pipeline_RenderPipeline_getMacros)
 
+static bool js_pipeline_RenderPipeline_getProfilingEnabled(se::State &s) {
+    cc::pipeline::RenderPipeline *cobj = (cc::pipeline::RenderPipeline *)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_pipeline_RenderPipeline_getProfilingEnabled : Invalid Native Object.");
+    s.rval().setBoolean(cobj->getProfiler().isEnabled());
+    return true;
+}
+SE_BIND_PROP_GET(js_pipeline_RenderPipeline_getProfilingEnabled)
+
+static bool js_pipeline_RenderPipeline_setProfilingEnabled(se::State &s) {
+    cc::pipeline::RenderPipeline *cobj = (cc::pipeline::RenderPipeline *)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_pipeline_RenderPipeline_setProfilingEnabled : Invalid Native Object.");
+    const auto &args = s.args();
+    CC_UNUSED bool ok = true;
+    bool enabled = false;
+    ok &= seval_to_boolean(args[0], &enabled);
+    SE_PRECONDITION2(ok, false, "js_pipeline_RenderPipeline_setProfilingEnabled : Error processing new value.");
+    cobj->getProfiler().setEnabled(enabled);
+    return true;
+}
+SE_BIND_PROP_SET(js_pipeline_RenderPipeline_setProfilingEnabled)
+
+static bool js_pipeline_RenderPipeline_getStageTimings(se::State &s) {
+    cc::pipeline::RenderPipeline *cobj = (cc::pipeline::RenderPipeline *)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_pipeline_RenderPipeline_getStageTimings : Invalid Native Object.");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 0) {
+        const auto &timings = cobj->getProfiler().getTimings();
+        se::HandleObject array(se::Object::createArrayObject(timings.size()));
+        for (uint32_t i = 0; i < timings.size(); ++i) {
+            se::HandleObject timing(se::Object::createPlainObject());
+            timing->setProperty("name", se::Value(timings[i].name));
+            timing->setProperty("cpuTime", se::Value(timings[i].cpuTime));
+            timing->setProperty("gpuTime", se::Value(timings[i].gpuTime));
+            timing->setProperty("count", se::Value(timings[i].count));
+            array->setArrayElement(i, se::Value(timing));
+        }
+        s.rval().setObject(array);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_pipeline_RenderPipeline_getStageTimings)
+
+static bool js_pipeline_RenderPipeline_exportStageTrace(se::State &s) {
+    cc::pipeline::RenderPipeline *cobj = (cc::pipeline::RenderPipeline *)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_pipeline_RenderPipeline_exportStageTrace : Invalid Native Object.");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        std::string path;
+        bool ok = seval_to_std_string(args[0], &path);
+        SE_PRECONDITION2(ok, false, "js_pipeline_RenderPipeline_exportStageTrace : Error processing arguments.");
+        s.rval().setBoolean(cobj->getProfiler().exportTrace(path));
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_pipeline_RenderPipeline_exportStageTrace)
+
 static bool JSB_getOrCreatePipelineState(se::State &s) {
     const auto &args = s.args();
     size_t argc = args.size();
@@ -86,5 +148,8 @@ bool register_all_pipeline_manual(se::Object *obj) {
     psmVal.toObject()->defineFunction("getOrCreatePipelineState", _SE(JSB_getOrCreatePipelineState));
 
     __jsb_cc_pipeline_RenderPipeline_proto->defineProperty("macros", _SE(js_pipeline_RenderPipeline_getMacros), nullptr);
+    __jsb_cc_pipeline_RenderPipeline_proto->defineProperty("profilingEnabled", _SE(js_pipeline_RenderPipeline_getProfilingEnabled), _SE(js_pipeline_RenderPipeline_setProfilingEnabled));
+    __jsb_cc_pipeline_RenderPipeline_proto->defineFunction("getStageTimings", _SE(js_pipeline_RenderPipeline_getStageTimings));
+    __jsb_cc_pipeline_RenderPipeline_proto->defineFunction("exportStageTrace", _SE(js_pipeline_RenderPipeline_exportStageTrace));
     return true;
 }
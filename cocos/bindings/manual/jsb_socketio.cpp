@@ -102,6 +102,38 @@ public:
             dataVal.setString(data);
         }
 
+        se::ValueArray args;
+        args.push_back(dataVal);
+        callEventListener(eventName, args);
+
+        if (eventName == "disconnect") {
+            CC_LOG_DEBUG("disconnect ... "); //IDEA:
+        }
+    }
+
+    // The attachments follow the arguments as ArrayBuffers
+    virtual void fireBinaryEventToScript(SIOClient *client, const std::string &eventName, const std::string &data, const std::vector<std::string_view> &attachments) override {
+        CC_LOG_DEBUG("JSB SocketIO::SIODelegate->fireBinaryEventToScript method called from native with name '%s' and %d attachments", eventName.c_str(), static_cast<int>(attachments.size()));
+
+        se::ScriptEngine::getInstance()->clearException();
+        se::AutoHandleScope hs;
+
+        if (cc::Application::getInstance() == nullptr)
+            return;
+
+        if (se::NativePtrToObjectMap::find(client) == se::NativePtrToObjectMap::end())
+            return;
+
+        se::ValueArray args;
+        args.emplace_back(data);
+        for (const auto &attachment : attachments) {
+            se::HandleObject arrayBuffer(se::Object::createArrayBufferObject(const_cast<char *>(attachment.data()), attachment.size()));
+            args.emplace_back(arrayBuffer);
+        }
+        callEventListener(eventName, args);
+    }
+
+    void callEventListener(const std::string &eventName, const se::ValueArray &args) {
         JSB_SIOCallbackRegistry::iterator it = _eventRegistry.find(eventName);
 
         if (it != _eventRegistry.end()) {
@@ -110,15 +142,9 @@ public:
             const se::Value &callback = cbStruct[0];
             const se::Value &target = cbStruct[1];
             if (callback.isObject() && callback.toObject()->isFunction() && target.isObject()) {
-                se::ValueArray args;
-                args.push_back(dataVal);
                 callback.toObject()->call(args, target.toObject());
             }
         }
-
-        if (eventName == "disconnect") {
-            CC_LOG_DEBUG("disconnect ... "); //IDEA:
-        }
     }
 
     void addEvent(const std::string &eventName, const se::Value &callback, const se::Value &target) {
@@ -193,6 +219,27 @@ static bool SocketIO_emit(se::State &s) {
         ok = seval_to_std_string(args[0], &eventName);
         SE_PRECONDITION2(ok, false, "Converting eventName failed!");
 
+        // ArrayBuffers and typed arrays are sent as binary attachments
+        if (argc >= 2 && args[1].isObject() && (args[1].toObject()->isArrayBuffer() || args[1].toObject()->isTypedArray())) {
+            std::vector<std::string_view> attachments;
+            for (int i = 1; i < argc; ++i) {
+                se::Object *obj = args[i].isObject() ? args[i].toObject() : nullptr;
+                uint8_t *bytes = nullptr;
+                size_t length = 0;
+                if (obj && obj->isArrayBuffer()) {
+                    ok = obj->getArrayBufferData(&bytes, &length);
+                } else if (obj && obj->isTypedArray()) {
+                    ok = obj->getTypedArrayData(&bytes, &length);
+                } else {
+                    ok = false;
+                }
+                SE_PRECONDITION2(ok, false, "Converting binary payload failed!");
+                attachments.emplace_back(reinterpret_cast<const char *>(bytes), length);
+            }
+            cobj->emitBinary(eventName, attachments);
+            return true;
+        }
+
         std::string payload;
         if (argc >= 2) {
             const auto &arg1 = args[1];
@@ -312,6 +312,78 @@ static bool WebSocketServer_close(se::State &s) {
 }
 SE_BIND_FUNC(WebSocketServer_close)
 
+static bool WebSocketServer_broadcast(se::State &s) {
+    const auto &args = s.args();
+    int argc = (int)args.size();
+
+    if (argc == 1) {
+        WSSPTR cobj = (WSSPTR)s.nativeThisObject();
+        bool ok = false;
+        if (args[0].isString()) {
+            std::string data;
+            ok = seval_to_std_string(args[0], &data);
+            SE_PRECONDITION2(ok, false, "Convert string failed");
+            cobj->get()->broadcastTextAsync(data);
+        } else if (args[0].isObject()) {
+            se::Object *dataObj = args[0].toObject();
+            uint8_t *ptr = nullptr;
+            size_t length = 0;
+            if (dataObj->isArrayBuffer()) {
+                ok = dataObj->getArrayBufferData(&ptr, &length);
+                SE_PRECONDITION2(ok, false, "getArrayBufferData failed!");
+            } else if (dataObj->isTypedArray()) {
+                ok = dataObj->getTypedArrayData(&ptr, &length);
+                SE_PRECONDITION2(ok, false, "getTypedArrayData failed!");
+            } else {
+                SE_REPORT_ERROR("wrong argument type, string, ArrayBuffer or TypedArray expected");
+                return false;
+            }
+            cobj->get()->broadcastBinaryAsync(ptr, length);
+        } else {
+            SE_REPORT_ERROR("wrong argument type, string, ArrayBuffer or TypedArray expected");
+            return false;
+        }
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting 1", argc);
+    return false;
+}
+SE_BIND_FUNC(WebSocketServer_broadcast)
+
+static bool WebSocketServer_setServiceThreadCount(se::State &s) {
+    const auto &args = s.args();
+    int argc = (int)args.size();
+
+    if (argc == 1) {
+        WSSPTR cobj = (WSSPTR)s.nativeThisObject();
+        uint32_t count = 0;
+        bool ok = seval_to_uint32(args[0], &count);
+        SE_PRECONDITION2(ok, false, "Convert args[0] should be a number");
+        cobj->get()->setServiceThreadCount(count);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting 1", argc);
+    return false;
+}
+SE_BIND_FUNC(WebSocketServer_setServiceThreadCount)
+
+static bool WebSocketServer_setMaxBacklogBytes(se::State &s) {
+    const auto &args = s.args();
+    int argc = (int)args.size();
+
+    if (argc == 1) {
+        WSSPTR cobj = (WSSPTR)s.nativeThisObject();
+        size_t bytes = 0;
+        bool ok = seval_to_size(args[0], &bytes);
+        SE_PRECONDITION2(ok, false, "Convert args[0] should be a number");
+        cobj->get()->setMaxBacklogBytes(bytes);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting 1", argc);
+    return false;
+}
+SE_BIND_FUNC(WebSocketServer_setMaxBacklogBytes)
+
 static bool WebSocketServer_connections(se::State &s) {
     const auto &args = s.args();
     int argc = (int)args.size();
@@ -476,6 +548,30 @@ static bool WebSocketServer_Connection_close(se::State &s) {
 }
 SE_BIND_FUNC(WebSocketServer_Connection_close)
 
+static bool WebSocketServer_Connection_getSendStats(se::State &s) {
+    const auto &args = s.args();
+    int argc = (int)args.size();
+
+    if (argc == 0) {
+        WSCONNPTR cobj = (WSCONNPTR)s.nativeThisObject();
+        if (!cobj) {
+            SE_REPORT_ERROR("Connection is not constructed by WebSocketServer, invalidate format!!");
+            return false;
+        }
+        WebSocketServerConnection::SendStats stats = (*cobj)->getSendStats();
+        se::HandleObject ret(se::Object::createPlainObject());
+        ret->setProperty("backlogFrames", se::Value(stats.backlogFrames));
+        ret->setProperty("backlogBytes", se::Value(static_cast<double>(stats.backlogBytes)));
+        ret->setProperty("sentFrames", se::Value(static_cast<double>(stats.sentFrames)));
+        ret->setProperty("droppedFrames", se::Value(static_cast<double>(stats.droppedFrames)));
+        s.rval().setObject(ret);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting 0", argc);
+    return false;
+}
+SE_BIND_FUNC(WebSocketServer_Connection_getSendStats)
+
 static bool WebSocketServer_Connection_onconnect(se::State &s) {
     const auto &args = s.args();
     int argc = (int)args.size();
@@ -836,6 +932,9 @@ bool register_all_websocket_server(se::Object *obj) {
 
     cls->defineFunction("close", _SE(WebSocketServer_close));
     cls->defineFunction("listen", _SE(WebSocketServer_listen));
+    cls->defineFunction("broadcast", _SE(WebSocketServer_broadcast));
+    cls->defineFunction("setServiceThreadCount", _SE(WebSocketServer_setServiceThreadCount));
+    cls->defineFunction("setMaxBacklogBytes", _SE(WebSocketServer_setMaxBacklogBytes));
     cls->defineProperty("onconnection", nullptr, _SE(WebSocketServer_onconnection));
     cls->defineProperty("onclose", nullptr, _SE(WebSocketServer_onclose));
     cls->defineProperty("connections", _SE(WebSocketServer_connections), nullptr);
@@ -849,6 +948,7 @@ bool register_all_websocket_server(se::Object *obj) {
     cls->defineFinalizeFunction(_SE(WebSocketServer_Connection_finalize));
     cls->defineFunction("close", _SE(WebSocketServer_Connection_close));
     cls->defineFunction("send", _SE(WebSocketServer_Connection_send));
+    cls->defineFunction("getSendStats", _SE(WebSocketServer_Connection_getSendStats));
 
     cls->defineProperty("ontext", nullptr, _SE(WebSocketServer_Connection_ontext));
     cls->defineProperty("onbinary", nullptr, _SE(WebSocketServer_Connection_onbinary));
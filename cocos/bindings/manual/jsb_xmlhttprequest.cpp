@@ -36,6 +36,7 @@
 #include <string>
 #include <functional>
 #include <algorithm>
+#include <memory>
 #include <sstream>
 #include "cocos/bindings/jswrapper/SeApi.h"
 #include "cocos/bindings/manual/jsb_conversions.h"
@@ -154,8 +155,9 @@ public:
     ReadyState getReadyState() const { return _readyState; }
     uint16_t getStatus() const { return _status; }
     const std::string &getStatusText() const { return _statusText; }
-    const std::string &getResponseText() const { return _responseText; }
-    const cc::Data &getResponseData() const { return _responseData; }
+    const std::string &getResponseText();
+    // Hands the response body over to an ArrayBuffer without copying it, later calls return the same object
+    se::Object *getResponseArrayBuffer();
     ResponseType getResponseType() const { return _responseType; }
     void setResponseType(ResponseType type) { _responseType = type; }
 
@@ -176,6 +178,8 @@ private:
     void getHeader(const std::string &header);
     void onResponse(cc::network::HttpClient *client, cc::network::HttpResponse *response);
 
+    void releaseResponseArrayBuffer();
+
     void setHttpRequestData(const char *data, size_t len);
     void sendRequest();
     void setHttpRequestHeader();
@@ -190,7 +194,10 @@ private:
     std::string _statusText;
     std::string _overrideMimeType;
 
-    cc::Data _responseData;
+    // Body as received, taken over from HttpResponse. Decoded into _responseText on first read,
+    // or handed to the ArrayBuffer of `response`, which stays rooted until the next response.
+    std::unique_ptr<std::vector<char>> _responseBody;
+    se::Object *_responseArrayBuffer = nullptr;
 
     cc::network::HttpRequest *_httpRequest;
     //    cc::EventListenerCustom* _resetDirectorListener;
@@ -239,6 +246,7 @@ XMLHttpRequest::~XMLHttpRequest() {
     // Avoid HttpClient response call a released object!
     _httpRequest->setResponseCallback(nullptr);
     CC_SAFE_RELEASE(_httpRequest);
+    releaseResponseArrayBuffer();
 }
 
 bool XMLHttpRequest::open(const std::string &method, const std::string &url) {
@@ -269,6 +277,7 @@ bool XMLHttpRequest::open(const std::string &method, const std::string &url) {
     _status = 0;
     _isAborted = false;
     _isTimeout = false;
+    releaseResponseArrayBuffer();
 
     setReadyState(ReadyState::OPENED);
 
@@ -404,7 +413,8 @@ void XMLHttpRequest::onResponse(HttpClient *client, HttpResponse *response) {
     sprintf(statusString, "HTTP Status Code: %ld, tag = %s", statusCode, tag.c_str());
 
     _responseText.clear();
-    _responseData.clear();
+    _responseBody.reset();
+    releaseResponseArrayBuffer();
 
     if (!response->isSucceed()) {
         std::string errorBuffer = response->getErrorBuffer();
@@ -436,14 +446,9 @@ void XMLHttpRequest::onResponse(HttpClient *client, HttpResponse *response) {
         getHeader(line);
     }
 
-    /** get the response data **/
-    std::vector<char> *buffer = response->getResponseData();
-
-    if (_responseType == ResponseType::STRING || _responseType == ResponseType::JSON) {
-        _responseText.append(buffer->data(), buffer->size());
-    } else {
-        _responseData.copy((unsigned char *)buffer->data(), buffer->size());
-    }
+    /** take the response data over, it's decoded or wrapped when the script reads it **/
+    _responseBody = std::make_unique<std::vector<char>>();
+    _responseBody->swap(*response->getResponseData());
 
     _status = statusCode;
 
@@ -459,6 +464,43 @@ void XMLHttpRequest::onResponse(HttpClient *client, HttpResponse *response) {
     }
 }
 
+const std::string &XMLHttpRequest::getResponseText() {
+    if (_responseBody && (_responseType == ResponseType::STRING || _responseType == ResponseType::JSON)) {
+        _responseText.assign(_responseBody->data(), _responseBody->size());
+        _responseBody.reset();
+    }
+    return _responseText;
+}
+
+se::Object *XMLHttpRequest::getResponseArrayBuffer() {
+    if (_responseArrayBuffer || !_responseBody) {
+        return _responseArrayBuffer;
+    }
+    if (_responseBody->empty()) {
+        _responseBody.reset();
+        _responseArrayBuffer = se::Object::createArrayBufferObject(nullptr, 0);
+    } else {
+        std::vector<char> *body = _responseBody.release();
+        _responseArrayBuffer    = se::Object::createExternalArrayBufferObject(body->data(), body->size(), [](void * /*contents*/, size_t /*byteLength*/, void *userData) {
+            delete static_cast<std::vector<char> *>(userData);
+        },
+                                                                           body);
+    }
+    if (_responseArrayBuffer) {
+        _responseArrayBuffer->root();
+    }
+    return _responseArrayBuffer;
+}
+
+void XMLHttpRequest::releaseResponseArrayBuffer() {
+    // the request may outlive the script engine through the autorelease pool
+    if (_responseArrayBuffer && se::ScriptEngine::getInstance()->isValid()) {
+        _responseArrayBuffer->unroot();
+        _responseArrayBuffer->decRef();
+    }
+    _responseArrayBuffer = nullptr;
+}
+
 void XMLHttpRequest::overrideMimeType(const std::string &mimeType) {
     _overrideMimeType = mimeType;
 }
@@ -860,10 +902,10 @@ static bool XMLHttpRequest_getResponse(se::State &s) {
                     s.rval().setNull();
                 }
             } else if (xhr->getResponseType() == XMLHttpRequest::ResponseType::ARRAY_BUFFER) {
-                const Data &data = xhr->getResponseData();
-                se::HandleObject seObj(se::Object::createArrayBufferObject(data.getBytes(), data.getSize()));
-                if (!seObj.isEmpty()) {
-                    s.rval().setObject(seObj);
+                // The body is handed over once, later reads return the same ArrayBuffer
+                se::Object *arrayBuffer = xhr->getResponseArrayBuffer();
+                if (arrayBuffer) {
+                    s.rval().setObject(arrayBuffer);
                 } else {
                     s.rval().setNull();
                 }
@@ -210,6 +210,7 @@ void DownloaderAndroid::abort(const std::unique_ptr<IDownloadTask> &task) {
 
 void DownloaderAndroid::_onProcess(int taskId, int64_t dl, int64_t dlNow, int64_t dlTotal) {
     DLLOG("DownloaderAndroid::onProgress(taskId: %d, dl: %lld, dlnow: %lld, dltotal: %lld)", taskId, dl, dlNow, dlTotal);
+    // progress posted from another thread may arrive after the task finished, task ids are never reused so it's dropped here
     auto iter = _taskMap.find(taskId);
     if (_taskMap.end() == iter) {
         DLLOG("DownloaderAndroid::onProgress can't find task with id: %d", taskId);
@@ -253,7 +254,7 @@ JNIEXPORT void JNICALL JNI_DOWNLOADER(nativeOnProgress)(JNIEnv *env, jclass claz
         }
         downloader->_onProcess((int)taskId, (int64_t)dl, (int64_t)dlnow, (int64_t)dltotal);
     };
-    cc::Application::getInstance()->getScheduler()->performFunctionInCocosThread(func);
+    cc::Application::getInstance()->getScheduler()->performFunctionInCocosThread(func, cc::PerformPriority::LOW);
 }
 
 JNIEXPORT void JNICALL JNI_DOWNLOADER(nativeOnFinish)(JNIEnv *env, jclass clazz, jint id, jint taskId, jint errCode, jstring errStr, jbyteArray data) {
@@ -287,7 +288,8 @@ JNIEXPORT void JNICALL JNI_DOWNLOADER(nativeOnFinish)(JNIEnv *env, jclass clazz,
         // success
         downloader->_onFinish((int)taskId, (int)errCode, nullptr, dataTmp);
     };
-    cc::Application::getInstance()->getScheduler()->performFunctionInCocosThread(func);
+    // same priority as the progress callbacks, which run in order when posted from the same thread
+    cc::Application::getInstance()->getScheduler()->performFunctionInCocosThread(func, cc::PerformPriority::LOW);
 }
 
 } // extern "C" {
@@ -29,8 +29,10 @@
 #include <set>
 #include <curl/curl.h>
 #include <deque>
+#include <zlib.h>
 
 #include "base/Scheduler.h"
+#include "base/md5.h"
 #include "platform/FileUtils.h"
 #include "platform/Application.h"
 #include "network/Downloader.h"
@@ -44,6 +46,12 @@
     #define CC_CURL_POLL_TIMEOUT_MS 50
 #endif
 
+// Granularity of the resume checkpoints kept next to the temp file, a broken download
+// restarts from the last chunk whose crc still matches the bytes on disk.
+#ifndef CC_DOWNLOAD_CHUNK_SIZE
+    #define CC_DOWNLOAD_CHUNK_SIZE (1024 * 1024)
+#endif
+
 namespace cc {
 namespace network {
 using namespace std;
@@ -63,7 +71,8 @@ public:
 
     DownloadTaskCURL()
     : serialId(_sSerialId++),
-      _fp(nullptr) {
+      _fp(nullptr),
+      _chunkFp(nullptr) {
         _initInternal();
         DLLOG("Construct DownloadTaskCURL %p", this);
     }
@@ -78,10 +87,14 @@ public:
             fclose(_fp);
             _fp = nullptr;
         }
+        if (_chunkFp) {
+            fclose(_chunkFp);
+            _chunkFp = nullptr;
+        }
         DLLOG("Destruct DownloadTaskCURL %p", this);
     }
 
-    bool init(const string &filename, const string &tempSuffix) {
+    bool init(const string &filename, const string &tempSuffix, const string &md5) {
         if (0 == filename.length()) {
             // data task
             _buf.reserve(CURL_MAX_WRITE_SIZE);
@@ -92,6 +105,8 @@ public:
         _fileName = filename;
         _tempFileName = filename;
         _tempFileName.append(tempSuffix);
+        _chunkFileName = _tempFileName + ".chunks";
+        _expectedMD5 = md5;
 
         if (_sStoragePathSet.end() != _sStoragePathSet.find(_tempFileName)) {
             // there is another task uses this storage path
@@ -128,8 +143,8 @@ public:
                 }
             }
 
-            // open file
-            _fp = fopen(util->getSuitableFOpen(_tempFileName).c_str(), "ab");
+            // open file, keep the existing content so a broken download can be resumed in initProc
+            _fp = fopen(util->getSuitableFOpen(_tempFileName).c_str(), util->isFileExist(_tempFileName) ? "r+b" : "w+b");
             if (nullptr == _fp) {
                 _errCode = DownloadTask::ERROR_FILE_OP_FAILED;
                 _errCodeInternal = 0;
@@ -145,6 +160,9 @@ public:
     void initProc() {
         lock_guard<mutex> lock(_mutex);
         _initInternal();
+        if (_fp) {
+            _restoreChunksProc();
+        }
     }
 
     void setErrorProc(int code, int codeInternal, const char *desc) {
@@ -159,6 +177,10 @@ public:
         size_t ret = 0;
         if (_fp) {
             ret = fwrite(buffer, size, count, _fp);
+            _consumeProc(buffer, ret * size);
+        } else if (_fileName.length()) {
+            // the temp file couldn't be reopened, abort the transfer instead of buffering it
+            ret = 0;
         } else {
             ret = size * count;
             auto cap = _buf.capacity();
@@ -203,6 +225,16 @@ private:
     vector<unsigned char> _buf;
     FILE *_fp;
 
+    // streaming verification and resume checkpoints, see _consumeProc
+    string _expectedMD5;
+    MD5 _md5;
+    string _chunkFileName;
+    FILE *_chunkFp;
+    uLong _chunkCrc;
+    int64_t _chunkOffset;
+    int64_t _verifiedBytes;
+    int64_t _tempFileSize;
+
     void _initInternal() {
         _acceptRanges = (false);
         _headerAchieved = (false);
@@ -213,6 +245,132 @@ private:
         _errCodeInternal = (CURLE_OK);
         _header.resize(0);
         _header.reserve(384); // pre alloc header string buffer
+        _md5.reset();
+        _chunkCrc = crc32(0L, Z_NULL, 0);
+        _chunkOffset = 0;
+        _verifiedBytes = 0;
+        _tempFileSize = 0;
+    }
+
+    struct ChunkFileHeader {
+        char magic[4];
+        uint32_t chunkSize;
+        char md5[32];
+    };
+
+    // Hashes the bytes just written and checkpoints every completed chunk.
+    void _consumeProc(const unsigned char *data, size_t len) {
+        if (!_expectedMD5.empty()) {
+            _md5.update(data, len);
+        }
+        while (len) {
+            auto n = static_cast<size_t>(std::min<int64_t>(len, CC_DOWNLOAD_CHUNK_SIZE - _chunkOffset));
+            _chunkCrc = crc32(_chunkCrc, data, static_cast<uInt>(n));
+            _chunkOffset += n;
+            data += n;
+            len -= n;
+            if (CC_DOWNLOAD_CHUNK_SIZE == _chunkOffset) {
+                // the chunk must reach the file before its checkpoint does
+                fflush(_fp);
+                if (_chunkFp) {
+                    auto crc = static_cast<uint32_t>(_chunkCrc);
+                    fwrite(&crc, sizeof(crc), 1, _chunkFp);
+                    fflush(_chunkFp);
+                }
+                _chunkCrc = crc32(0L, Z_NULL, 0);
+                _chunkOffset = 0;
+            }
+        }
+    }
+
+    // Re-checks the chunks recorded by a previous run against the temp file, feeds the
+    // intact prefix to the md5 and positions the file right after it.
+    void _restoreChunksProc() {
+        auto util = FileUtils::getInstance();
+        vector<uint32_t> crcs;
+        FILE *fp = fopen(util->getSuitableFOpen(_chunkFileName).c_str(), "rb");
+        if (fp) {
+            ChunkFileHeader header;
+            if (1 == fread(&header, sizeof(header), 1, fp) && _isChunkFileHeaderValid(header)) {
+                uint32_t crc = 0;
+                while (1 == fread(&crc, sizeof(crc), 1, fp)) {
+                    crcs.push_back(crc);
+                }
+            }
+            fclose(fp);
+        }
+
+        _tempFileSize = util->getFileSize(_tempFileName);
+        size_t verifiedChunks = 0;
+        if (!crcs.empty() && _tempFileSize >= CC_DOWNLOAD_CHUNK_SIZE) {
+            vector<unsigned char> chunk(CC_DOWNLOAD_CHUNK_SIZE);
+            fseek(_fp, 0, SEEK_SET);
+            while (verifiedChunks < crcs.size() && 1 == fread(chunk.data(), chunk.size(), 1, _fp)) {
+                if (crcs[verifiedChunks] != static_cast<uint32_t>(crc32(crc32(0L, Z_NULL, 0), chunk.data(), static_cast<uInt>(chunk.size())))) {
+                    break;
+                }
+                if (!_expectedMD5.empty()) {
+                    _md5.update(chunk.data(), chunk.size());
+                }
+                ++verifiedChunks;
+            }
+        }
+        _verifiedBytes = static_cast<int64_t>(verifiedChunks) * CC_DOWNLOAD_CHUNK_SIZE;
+
+        if (0 == _verifiedBytes && _tempFileSize > 0) {
+            _truncateProc();
+            return;
+        }
+        fseek(_fp, static_cast<long>(_verifiedBytes), SEEK_SET);
+        _openChunkFileProc(crcs.data(), verifiedChunks);
+    }
+
+    // Drops everything received so far, used when the server can't continue from the checkpoint.
+    void _truncateProc() {
+        fclose(_fp);
+        _fp = fopen(FileUtils::getInstance()->getSuitableFOpen(_tempFileName).c_str(), "w+b");
+        if (nullptr == _fp) {
+            _errCode = DownloadTask::ERROR_FILE_OP_FAILED;
+            _errCodeInternal = 0;
+            _errDescription = "Can't reopen file:";
+            _errDescription.append(_tempFileName);
+        }
+        _md5.reset();
+        _chunkCrc = crc32(0L, Z_NULL, 0);
+        _chunkOffset = 0;
+        _verifiedBytes = 0;
+        _tempFileSize = 0;
+        _openChunkFileProc(nullptr, 0);
+    }
+
+    void _openChunkFileProc(const uint32_t *crcs, size_t count) {
+        if (_chunkFp) {
+            fclose(_chunkFp);
+        }
+        _chunkFp = fopen(FileUtils::getInstance()->getSuitableFOpen(_chunkFileName).c_str(), "wb");
+        if (!_chunkFp) {
+            // resuming is best effort, the download itself can go on without checkpoints
+            return;
+        }
+        ChunkFileHeader header;
+        memcpy(header.magic, "CCDL", sizeof(header.magic));
+        header.chunkSize = CC_DOWNLOAD_CHUNK_SIZE;
+        memset(header.md5, 0, sizeof(header.md5));
+        memcpy(header.md5, _expectedMD5.data(), std::min(_expectedMD5.size(), sizeof(header.md5)));
+        fwrite(&header, sizeof(header), 1, _chunkFp);
+        if (count) {
+            fwrite(crcs, sizeof(uint32_t), count, _chunkFp);
+        }
+        fflush(_chunkFp);
+    }
+
+    bool _isChunkFileHeaderValid(const ChunkFileHeader &header) const {
+        // checkpoints of a different version of the content are useless
+        char md5[sizeof(header.md5)] = {0};
+        memcpy(md5, _expectedMD5.data(), std::min(_expectedMD5.size(), sizeof(md5)));
+        return 0 == memcmp(header.magic, "CCDL", sizeof(header.magic)) &&
+               CC_DOWNLOAD_CHUNK_SIZE == header.chunkSize &&
+               0 == memcmp(header.md5, md5, sizeof(md5));
     }
 };
 int DownloadTaskCURL::_sSerialId;
@@ -382,18 +540,17 @@ private:
 
             bool acceptRanges = (string::npos != coTask._header.find("Accept-Ranges")) ? true : false;
 
-            // get current file size
-            int64_t fileSize = 0;
-            if (acceptRanges && coTask._tempFileName.length()) {
-                fileSize = FileUtils::getInstance()->getFileSize(coTask._tempFileName);
-            }
-
             // set header info to coTask
             lock_guard<mutex> lock(coTask._mutex);
             coTask._totalBytesExpected = (int64_t)contentLen;
             coTask._acceptRanges = acceptRanges;
-            if (acceptRanges && fileSize > 0) {
-                coTask._totalBytesReceived = fileSize;
+            if (coTask._verifiedBytes > 0) {
+                // continue after the last verified chunk, unless the server can't or the local file outgrew the content
+                if (acceptRanges && (contentLen <= 0 || coTask._tempFileSize <= (int64_t)contentLen)) {
+                    coTask._totalBytesReceived = coTask._verifiedBytes;
+                } else {
+                    coTask._truncateProc();
+                }
             }
             coTask._headerAchieved = true;
         } while (0);
@@ -665,7 +822,7 @@ DownloaderCURL::~DownloaderCURL() {
 
 IDownloadTask *DownloaderCURL::createCoTask(std::shared_ptr<const DownloadTask> &task) {
     DownloadTaskCURL *coTask = new (std::nothrow) DownloadTaskCURL;
-    coTask->init(task->storagePath, _impl->hints.tempFileNameSuffix);
+    coTask->init(task->storagePath, _impl->hints.tempFileNameSuffix, task->md5);
 
     DLLOG("    DownloaderCURL: createTask: Id(%d)", coTask->serialId);
 
@@ -735,12 +892,33 @@ void DownloaderCURL::_onSchedule(float) {
         if (coTask._fp) {
             fclose(coTask._fp);
             coTask._fp = nullptr;
+            if (coTask._chunkFp) {
+                fclose(coTask._chunkFp);
+                coTask._chunkFp = nullptr;
+            }
             do {
                 if (0 == coTask._fileName.length()) {
                     break;
                 }
 
                 auto util = FileUtils::getInstance();
+                if (DownloadTask::ERROR_NO_ERROR != coTask._errCode) {
+                    // keep the temp file and its checkpoints for resuming
+                    DownloadTaskCURL::_sStoragePathSet.erase(coTask._tempFileName);
+                    break;
+                }
+
+                if (!coTask._expectedMD5.empty() && !md5Equals(coTask._md5.finish(), coTask._expectedMD5)) {
+                    coTask._errCode = DownloadTask::ERROR_CHECKSUM_MISMATCH;
+                    coTask._errCodeInternal = 0;
+                    coTask._errDescription = "Downloaded content doesn't match md5: ";
+                    coTask._errDescription.append(coTask._expectedMD5);
+                    util->removeFile(coTask._tempFileName);
+                    util->removeFile(coTask._chunkFileName);
+                    DownloadTaskCURL::_sStoragePathSet.erase(coTask._tempFileName);
+                    break;
+                }
+                util->removeFile(coTask._chunkFileName);
                 // if file already exist, remove it
                 if (util->isFileExist(coTask._fileName)) {
                     if (false == util->removeFile(coTask._fileName)) {
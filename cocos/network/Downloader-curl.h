@@ -46,6 +46,8 @@ public:
 
     virtual void abort(const std::unique_ptr<IDownloadTask> &task) override;
 
+    virtual bool isMD5VerifiedWhileDownloading() const override { return true; }
+
 protected:
     class Impl;
     std::shared_ptr<Impl> _impl;
@@ -132,7 +132,8 @@ std::shared_ptr<const DownloadTask> Downloader::createDownloadDataTask(const std
 std::shared_ptr<const DownloadTask> Downloader::createDownloadFileTask(const std::string &srcUrl,
                                                                        const std::string &storagePath,
                                                                        const std::map<std::string, std::string> &header,
-                                                                       const std::string &identifier /* = ""*/) {
+                                                                       const std::string &identifier /* = ""*/,
+                                                                       const std::string &md5 /* = ""*/) {
     DownloadTask *task_ = new (std::nothrow) DownloadTask();
     std::shared_ptr<const DownloadTask> task(task_);
     do {
@@ -140,6 +141,7 @@ std::shared_ptr<const DownloadTask> Downloader::createDownloadFileTask(const std
         task_->storagePath = storagePath;
         task_->identifier = identifier;
         task_->header = header;
+        task_->md5 = md5;
         if (0 == srcUrl.length() || 0 == storagePath.length()) {
             if (onTaskError) {
                 onTaskError(*task, DownloadTask::ERROR_INVALID_PARAMS, 0, "URL or storage path is empty.");
@@ -154,9 +156,14 @@ std::shared_ptr<const DownloadTask> Downloader::createDownloadFileTask(const std
 }
 std::shared_ptr<const DownloadTask> Downloader::createDownloadFileTask(const std::string &srcUrl,
                                                                        const std::string &storagePath,
-                                                                       const std::string &identifier /* = ""*/) {
+                                                                       const std::string &identifier /* = ""*/,
+                                                                       const std::string &md5 /* = ""*/) {
     const std::map<std::string, std::string> emptyHeader;
-    return createDownloadFileTask(srcUrl, storagePath, emptyHeader, identifier);
+    return createDownloadFileTask(srcUrl, storagePath, emptyHeader, identifier, md5);
+}
+
+bool Downloader::isMD5VerifiedWhileDownloading() const {
+    return _impl->isMD5VerifiedWhileDownloading();
 }
 
 void Downloader::abort(const DownloadTask &task) {
@@ -49,11 +49,14 @@ public:
     const static int ERROR_FILE_OP_FAILED = -2;
     const static int ERROR_IMPL_INTERNAL = -3;
     const static int ERROR_ABORT = -4;
+    const static int ERROR_CHECKSUM_MISMATCH = -5;
 
     std::string identifier;
     std::string requestURL;
     std::string storagePath;
     std::map<std::string, std::string> header;
+    // Expected md5 of the downloaded content in hex, verified while receiving if the implementation supports it.
+    std::string md5;
 
     DownloadTask();
     virtual ~DownloadTask();
@@ -107,9 +110,15 @@ public:
 
     std::shared_ptr<const DownloadTask> createDownloadDataTask(const std::string &srcUrl, const std::string &identifier = "");
 
-    std::shared_ptr<const DownloadTask> createDownloadFileTask(const std::string &srcUrl, const std::string &storagePath, const std::string &identifier = "");
+    std::shared_ptr<const DownloadTask> createDownloadFileTask(const std::string &srcUrl, const std::string &storagePath, const std::string &identifier = "", const std::string &md5 = "");
 
-    std::shared_ptr<const DownloadTask> createDownloadFileTask(const std::string &srcUrl, const std::string &storagePath, const std::map<std::string, std::string> &header, const std::string &identifier = "");
+    std::shared_ptr<const DownloadTask> createDownloadFileTask(const std::string &srcUrl, const std::string &storagePath, const std::map<std::string, std::string> &header, const std::string &identifier = "", const std::string &md5 = "");
+
+    /**
+     * Whether the md5 passed to createDownloadFileTask is checked against the received bytes,
+     * tasks with a mismatched content fail with ERROR_CHECKSUM_MISMATCH.
+     */
+    bool isMD5VerifiedWhileDownloading() const;
 
     void abort(const DownloadTask &task);
 
@@ -73,6 +73,8 @@ public:
     virtual IDownloadTask *createCoTask(std::shared_ptr<const DownloadTask> &task) = 0;
 
     virtual void abort(const std::unique_ptr<IDownloadTask> &task) = 0;
+
+    virtual bool isMD5VerifiedWhileDownloading() const { return false; }
 };
 
 } // namespace network
@@ -716,7 +716,11 @@ void HttpClient::networkThread() {
 
         // Create a HttpResponse object, the default setting is http access failed
         HttpResponse *response = new (std::nothrow) HttpResponse(request);
-        processResponse(response, _responseMessage);
+        if (request->isCancelled()) {
+            response->setErrorBuffer("Request cancelled");
+        } else {
+            processResponse(response, _responseMessage);
+        }
 
         // add response packet into queue
         _responseQueueMutex.lock();
@@ -861,7 +865,7 @@ void HttpClient::send(HttpRequest *request) {
     request->retain();
 
     _requestQueueMutex.lock();
-    _requestQueue.pushBack(request);
+    insertRequestByPriority(request);
     _requestQueueMutex.unlock();
 
     // Notify thread start to work
@@ -930,6 +934,11 @@ void HttpClient::decreaseThreadCountAndMayDeleteThis() {
     }
 }
 
+void HttpClient::setMaxConcurrentRequests(uint32_t count) {
+    // Requests are sent one by one on this platform
+    _maxConcurrentRequests = count;
+}
+
 void HttpClient::setTimeoutForConnect(int value) {
     std::lock_guard<std::mutex> lock(_timeoutForConnectMutex);
     _timeoutForConnect = value;
@@ -27,6 +27,7 @@
 ****************************************************************************/
 
 #include "network/HttpClient.h"
+#include <algorithm>
 #include <queue>
 #include <errno.h>
 #include <curl/curl.h>
@@ -35,6 +36,10 @@
 #include "platform/StdC.h"
 #include "base/Log.h"
 
+// Transfers waiting for the network wait at most this long before queued requests are looked at again,
+// unless curl_multi_wakeup is available.
+#define CC_HTTP_POLL_TIMEOUT_MS     50
+
 namespace cc {
 
 namespace network {
@@ -47,18 +52,6 @@ static HttpClient *_httpClient = nullptr; // pointer to singleton
 
 typedef size_t (*write_callback)(void *ptr, size_t size, size_t nmemb, void *stream);
 
-// Callback function used by libcurl for collect response data
-static size_t writeData(void *ptr, size_t size, size_t nmemb, void *stream) {
-    std::vector<char> *recvBuffer = (std::vector<char> *)stream;
-    size_t sizes = size * nmemb;
-
-    // add data to the end of recvBuffer
-    // write data maybe called more than once in a single request
-    recvBuffer->insert(recvBuffer->end(), (char *)ptr, (char *)ptr + sizes);
-
-    return sizes;
-}
-
 // Callback function used by libcurl for collect header data
 static size_t writeHeaderData(void *ptr, size_t size, size_t nmemb, void *stream) {
     std::vector<char> *recvBuffer = (std::vector<char> *)stream;
@@ -71,87 +64,55 @@ static size_t writeHeaderData(void *ptr, size_t size, size_t nmemb, void *stream
     return sizes;
 }
 
-static int processGetTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processPostTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processPutTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processDeleteTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-// int processDownloadTask(HttpRequest *task, write_callback callback, void *stream, int32_t *errorCode);
-
-// Worker thread
-void HttpClient::networkThread() {
-    increaseThreadCount();
-
-    while (true) {
-        HttpRequest *request;
-
-        // step 1: send http request if the requestQueue isn't empty
-        {
-            std::lock_guard<std::mutex> lock(_requestQueueMutex);
-            while (_requestQueue.empty()) {
-                _sleepCondition.wait(_requestQueueMutex);
-            }
-            request = _requestQueue.at(0);
-            _requestQueue.erase(0);
+namespace {
+
+// A request in flight on the curl multi handle
+struct HttpTransfer {
+    HttpRequest *request{nullptr};
+    HttpResponse *response{nullptr};
+    CURL *handle{nullptr};
+    curl_slist *headers{nullptr};
+    bool immediate{false};
+    bool bodyStarted{false};
+    char errorBuffer[CURL_ERROR_SIZE]{};
+
+    ~HttpTransfer() {
+        if (handle) {
+            curl_easy_cleanup(handle);
         }
-
-        if (request == _requestSentinel) {
-            break;
+        if (headers) {
+            curl_slist_free_all(headers);
         }
+    }
+};
 
-        // step 2: libcurl sync access
-
-        // Create a HttpResponse object, the default setting is http access failed
-        HttpResponse *response = new (std::nothrow) HttpResponse(request);
+} // namespace
 
-        processResponse(response, _responseMessage);
+// Upper bound of the body buffer reserved up front from Content-Length, larger bodies grow as they arrive
+#define CC_HTTP_MAX_BODY_RESERVE (256 * 1024 * 1024)
 
-        // add response packet into queue
-        _responseQueueMutex.lock();
-        _responseQueue.pushBack(response);
-        _responseQueueMutex.unlock();
+// Callback function used by libcurl for collect response data
+static size_t writeData(void *ptr, size_t size, size_t nmemb, void *stream) {
+    auto *transfer = static_cast<HttpTransfer *>(stream);
+    std::vector<char> *recvBuffer = transfer->response->getResponseData();
+    size_t sizes = size * nmemb;
 
-        _schedulerMutex.lock();
-        if (auto sche = _scheduler.lock()) {
-            sche->performFunctionInCocosThread(CC_CALLBACK_0(HttpClient::dispatchResponseCallbacks, this));
+    // size the buffer once from Content-Length, so a large body isn't moved around while growing
+    if (!transfer->bodyStarted) {
+        transfer->bodyStarted = true;
+#if LIBCURL_VERSION_NUM >= 0x073700
+        curl_off_t contentLength = -1;
+        if (CURLE_OK == curl_easy_getinfo(transfer->handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength) && contentLength > 0) {
+            recvBuffer->reserve(static_cast<size_t>(std::min<curl_off_t>(contentLength, CC_HTTP_MAX_BODY_RESERVE)));
         }
-        _schedulerMutex.unlock();
+#endif
     }
 
-    // cleanup: if worker thread received quit signal, clean up un-completed request queue
-    _requestQueueMutex.lock();
-    _requestQueue.clear();
-    _requestQueueMutex.unlock();
-
-    _responseQueueMutex.lock();
-    _responseQueue.clear();
-    _responseQueueMutex.unlock();
-
-    decreaseThreadCountAndMayDeleteThis();
-}
-
-// Worker thread
-void HttpClient::networkThreadAlone(HttpRequest *request, HttpResponse *response) {
-    increaseThreadCount();
-
-    char responseMessage[RESPONSE_BUFFER_SIZE] = {0};
-    processResponse(response, responseMessage);
-
-    _schedulerMutex.lock();
-    if (auto sche = _scheduler.lock()) {
-        sche->performFunctionInCocosThread([this, response, request] {
-            const ccHttpRequestCallback &callback = request->getResponseCallback();
-
-            if (callback != nullptr) {
-                callback(this, response);
-            }
-            response->release();
-            // do not release in other thread
-            request->release();
-        });
-    }
-    _schedulerMutex.unlock();
+    // add data to the end of recvBuffer
+    // write data maybe called more than once in a single request
+    recvBuffer->insert(recvBuffer->end(), (char *)ptr, (char *)ptr + sizes);
 
-    decreaseThreadCountAndMayDeleteThis();
+    return sizes;
 }
 
 //Configure curl's timeout property
@@ -165,11 +126,11 @@ static bool configureCURL(HttpClient *client, HttpRequest *request, CURL *handle
     if (code != CURLE_OK) {
         return false;
     }
-    code = curl_easy_setopt(handle, CURLOPT_TIMEOUT, request->getTimeout());
+    code = curl_easy_setopt(handle, CURLOPT_TIMEOUT, static_cast<long>(request->getTimeout()));
     if (code != CURLE_OK) {
         return false;
     }
-    code = curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, request->getTimeout());
+    code = curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, static_cast<long>(request->getTimeout()));
     if (code != CURLE_OK) {
         return false;
     }
@@ -190,117 +151,258 @@ static bool configureCURL(HttpClient *client, HttpRequest *request, CURL *handle
 
     curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "");
 
+#ifdef CURL_HTTP_VERSION_2TLS
+    // HTTP/2 over TLS where the server supports it, requests to the same host then share one connection
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x072B00
+    // Rather wait for a connection to multiplex on than open another one
+    curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+#endif
+
     return true;
 }
 
-class CURLRaii {
-    /// Instance of CURL
-    CURL *_curl;
-    /// Keeps custom header data
-    curl_slist *_headers;
+template <class T>
+static bool setOption(CURL *handle, CURLoption option, T data) {
+    return CURLE_OK == curl_easy_setopt(handle, option, data);
+}
 
-public:
-    CURLRaii()
-    : _curl(curl_easy_init()),
-      _headers(nullptr) {
+// Prepares the easy handle of a transfer, the response is written into transfer->response
+static bool initTransfer(HttpClient *client, HttpTransfer *transfer) {
+    HttpRequest *request = transfer->request;
+    CURL *handle = transfer->handle;
+    if (!handle || !configureCURL(client, request, handle, transfer->errorBuffer)) {
+        return false;
     }
 
-    ~CURLRaii() {
-        if (_curl)
-            curl_easy_cleanup(_curl);
-        /* free the linked list for header data */
-        if (_headers)
-            curl_slist_free_all(_headers);
+    /* get custom header data (if set) */
+    std::vector<std::string> headers = request->getHeaders();
+    if (!headers.empty()) {
+        /* append custom headers one by one */
+        for (auto &header : headers)
+            transfer->headers = curl_slist_append(transfer->headers, header.c_str());
+        /* set custom headers for curl */
+        if (!setOption(handle, CURLOPT_HTTPHEADER, transfer->headers))
+            return false;
+    }
+    std::string cookieFilename = client->getCookieFilename();
+    if (!cookieFilename.empty()) {
+        if (!setOption(handle, CURLOPT_COOKIEFILE, cookieFilename.c_str())) {
+            return false;
+        }
+        if (!setOption(handle, CURLOPT_COOKIEJAR, cookieFilename.c_str())) {
+            return false;
+        }
     }
 
-    template <class T>
-    bool setOption(CURLoption option, T data) {
-        return CURLE_OK == curl_easy_setopt(_curl, option, data);
+    bool ok = setOption(handle, CURLOPT_URL, request->getUrl()) &&
+              setOption(handle, CURLOPT_WRITEFUNCTION, static_cast<write_callback>(writeData)) &&
+              setOption(handle, CURLOPT_WRITEDATA, transfer) &&
+              setOption(handle, CURLOPT_HEADERFUNCTION, static_cast<write_callback>(writeHeaderData)) &&
+              setOption(handle, CURLOPT_HEADERDATA, transfer->response->getResponseHeader()) &&
+              setOption(handle, CURLOPT_PRIVATE, transfer);
+    if (!ok) {
+        return false;
     }
 
-    /**
-     * @brief Inits CURL instance for common usage
-     * @param request Null not allowed
-     * @param callback Response write callback
-     * @param stream Response write stream
-     */
-    bool init(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-        if (!_curl)
-            return false;
-        if (!configureCURL(client, request, _curl, errorBuffer))
+    switch (request->getRequestType()) {
+        case HttpRequest::Type::GET: // HTTP GET
+            return setOption(handle, CURLOPT_FOLLOWLOCATION, 1L);
+
+        case HttpRequest::Type::POST: // HTTP POST
+            return setOption(handle, CURLOPT_POST, 1L) && setOption(handle, CURLOPT_POSTFIELDS, request->getRequestData()) && setOption(handle, CURLOPT_POSTFIELDSIZE, static_cast<long>(request->getRequestDataSize()));
+
+        case HttpRequest::Type::PUT:
+            return setOption(handle, CURLOPT_CUSTOMREQUEST, "PUT") && setOption(handle, CURLOPT_POSTFIELDS, request->getRequestData()) && setOption(handle, CURLOPT_POSTFIELDSIZE, static_cast<long>(request->getRequestDataSize()));
+
+        case HttpRequest::Type::HEAD:
+            return setOption(handle, CURLOPT_NOBODY, 1L);
+
+        case HttpRequest::Type::DELETE:
+            return setOption(handle, CURLOPT_CUSTOMREQUEST, "DELETE") && setOption(handle, CURLOPT_FOLLOWLOCATION, 1L);
+
+        default:
+            CCASSERT(false, "CCHttpClient: unknown request type, only GET, POST, PUT, HEAD or DELETE is supported");
             return false;
+    }
+}
 
-        /* get custom header data (if set) */
-        std::vector<std::string> headers = request->getHeaders();
-        if (!headers.empty()) {
-            /* append custom headers one by one */
-            for (auto &header : headers)
-                _headers = curl_slist_append(_headers, header.c_str());
-            /* set custom headers for curl */
-            if (!setOption(CURLOPT_HTTPHEADER, _headers))
-                return false;
+// Worker thread, runs every request on one curl multi handle
+void HttpClient::networkThread() {
+    increaseThreadCount();
+
+    CURLM *multiHandle = curl_multi_init();
+    // Connections are bounded by _maxConcurrentRequests rather than a per host limit, curl would park
+    // the extra transfers in its own pending list and start them in no particular order.
+#ifdef CURLPIPE_MULTIPLEX
+    curl_multi_setopt(multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
+
+    // The multi handle pools connections and DNS already, the share handle adds TLS sessions and cookies.
+    // Only this thread uses it so no lock callbacks are needed.
+    CURLSH *shareHandle = curl_share_init();
+    curl_share_setopt(shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_COOKIE);
+#if LIBCURL_VERSION_NUM >= 0x073900
+    curl_share_setopt(shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+
+    {
+        std::lock_guard<std::mutex> lock(_requestQueueMutex);
+        _multiHandle = multiHandle;
+    }
+
+    std::vector<HttpTransfer *> transfers;
+
+    auto finish = [this, &transfers, multiHandle](HttpTransfer *transfer, CURLcode result) {
+        curl_multi_remove_handle(multiHandle, transfer->handle);
+        transfers.erase(std::find(transfers.begin(), transfers.end(), transfer));
+
+        HttpResponse *response = transfer->response;
+        long responseCode = -1;
+        curl_easy_getinfo(transfer->handle, CURLINFO_RESPONSE_CODE, &responseCode);
+        response->setResponseCode(responseCode);
+        if (transfer->request->isCancelled()) {
+            response->setSucceed(false);
+            response->setErrorBuffer("Request cancelled");
+        } else if (result != CURLE_OK) {
+            response->setSucceed(false);
+            response->setErrorBuffer(transfer->errorBuffer[0] ? transfer->errorBuffer : curl_easy_strerror(result));
+        } else if (responseCode < 200 || responseCode >= 300) {
+            response->setSucceed(false);
+            response->setErrorBuffer(transfer->errorBuffer);
+        } else {
+            response->setSucceed(true);
+        }
+        delete transfer;
+
+        // add response packet into queue
+        _responseQueueMutex.lock();
+        _responseQueue.pushBack(response);
+        _responseQueueMutex.unlock();
+        // Vector retained it
+        response->release();
+
+        _schedulerMutex.lock();
+        if (auto sche = _scheduler.lock()) {
+            sche->performFunctionInCocosThread(CC_CALLBACK_0(HttpClient::dispatchResponseCallbacks, this));
+        }
+        _schedulerMutex.unlock();
+    };
+
+    auto start = [this, &transfers, &finish, multiHandle, shareHandle](HttpRequest *request, bool immediate) {
+        auto *transfer = new (std::nothrow) HttpTransfer();
+        transfer->request = request;
+        // Create a HttpResponse object, the default setting is http access failed
+        transfer->response = new (std::nothrow) HttpResponse(request);
+        transfer->immediate = immediate;
+        transfer->handle = curl_easy_init();
+        transfers.push_back(transfer);
+
+        if (!request->isCancelled() && initTransfer(this, transfer) &&
+            CURLE_OK == curl_easy_setopt(transfer->handle, CURLOPT_SHARE, shareHandle) &&
+            CURLM_OK == curl_multi_add_handle(multiHandle, transfer->handle)) {
+            return;
         }
-        std::string cookieFilename = client->getCookieFilename();
-        if (!cookieFilename.empty()) {
-            if (!setOption(CURLOPT_COOKIEFILE, cookieFilename.c_str())) {
-                return false;
+        finish(transfer, CURLE_FAILED_INIT);
+    };
+
+    bool quit = false;
+    while (!quit) {
+        // step 1: start queued requests, immediate ones don't wait for a free slot
+        {
+            std::lock_guard<std::mutex> lock(_requestQueueMutex);
+            while (transfers.empty() && _requestQueue.empty() && _immediateRequestQueue.empty()) {
+                _sleepCondition.wait(_requestQueueMutex);
             }
-            if (!setOption(CURLOPT_COOKIEJAR, cookieFilename.c_str())) {
-                return false;
+
+            if (!_requestQueue.empty() && _requestQueue.back() == _requestSentinel) {
+                quit = true;
+                break;
+            }
+
+            for (auto *request : _immediateRequestQueue) {
+                start(request, true);
+            }
+            _immediateRequestQueue.clear();
+
+            uint32_t maxConcurrent = _maxConcurrentRequests;
+            while (!_requestQueue.empty()) {
+                auto running = static_cast<uint32_t>(std::count_if(transfers.begin(), transfers.end(), [](HttpTransfer *t) { return !t->immediate; }));
+                if (maxConcurrent != 0 && running >= maxConcurrent) {
+                    break;
+                }
+                // The Vector releases its reference, the one from send() is released after the callback
+                HttpRequest *request = _requestQueue.at(0);
+                _requestQueue.erase(0);
+                start(request, false);
             }
         }
 
-        return setOption(CURLOPT_URL, request->getUrl()) && setOption(CURLOPT_WRITEFUNCTION, callback) && setOption(CURLOPT_WRITEDATA, stream) && setOption(CURLOPT_HEADERFUNCTION, headerCallback) && setOption(CURLOPT_HEADERDATA, headerStream);
-    }
+        // step 2: abort cancelled transfers
+        for (size_t i = transfers.size(); i > 0; --i) {
+            if (transfers[i - 1]->request->isCancelled()) {
+                finish(transfers[i - 1], CURLE_ABORTED_BY_CALLBACK);
+            }
+        }
 
-    /// @param responseCode Null not allowed
-    bool perform(long *responseCode) {
-        if (CURLE_OK != curl_easy_perform(_curl))
-            return false;
-        CURLcode code = curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, responseCode);
-        if (code != CURLE_OK || !(*responseCode >= 200 && *responseCode < 300)) {
-            CC_LOG_ERROR("Curl curl_easy_getinfo failed: %s", curl_easy_strerror(code));
-            return false;
+        // step 3: drive the transfers and collect finished ones
+        int runningHandles = 0;
+        curl_multi_perform(multiHandle, &runningHandles);
+
+        CURLMsg *msg = nullptr;
+        int msgsInQueue = 0;
+        while ((msg = curl_multi_info_read(multiHandle, &msgsInQueue)) != nullptr) {
+            if (msg->msg == CURLMSG_DONE) {
+                HttpTransfer *transfer = nullptr;
+                curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &transfer);
+                finish(transfer, msg->data.result);
+            }
         }
-        // Get some mor data.
 
-        return true;
+        // step 4: wait for network activity, new requests or cancellation
+        if (!transfers.empty()) {
+#if LIBCURL_VERSION_NUM >= 0x074400
+            // Woken up by send() with curl_multi_wakeup
+            curl_multi_poll(multiHandle, nullptr, 0, CC_HTTP_POLL_TIMEOUT_MS, nullptr);
+#else
+            int numfds = 0;
+            curl_multi_wait(multiHandle, nullptr, 0, CC_HTTP_POLL_TIMEOUT_MS, &numfds);
+            if (numfds == 0) {
+                // curl_multi_wait returns right away when there is nothing to wait on, e.g. while resolving
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+#endif
+        }
     }
-};
 
-//Process Get Request
-static int processGetTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_FOLLOWLOCATION, true) && curl.perform(responseCode);
-    return ok ? 0 : 1;
-}
+    {
+        std::lock_guard<std::mutex> lock(_requestQueueMutex);
+        _multiHandle = nullptr;
+    }
 
-//Process POST Request
-static int processPostTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_POST, 1) && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
-}
+    // cleanup: if worker thread received quit signal, drop in flight transfers, the scheduler is gone already
+    for (auto *transfer : transfers) {
+        curl_multi_remove_handle(multiHandle, transfer->handle);
+        transfer->response->release();
+        delete transfer;
+    }
+    curl_multi_cleanup(multiHandle);
+    curl_share_cleanup(shareHandle);
 
-//Process PUT Request
-static int processPutTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_CUSTOMREQUEST, "PUT") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
-}
+    // cleanup: clean up un-completed request queue
+    _requestQueueMutex.lock();
+    _requestQueue.clear();
+    _immediateRequestQueue.clear();
+    _requestQueueMutex.unlock();
 
-//Process HEAD Request
-static int processHeadTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_NOBODY, "HEAD") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
-}
+    _responseQueueMutex.lock();
+    _responseQueue.clear();
+    _responseQueueMutex.unlock();
 
-//Process DELETE Request
-static int processDeleteTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_CUSTOMREQUEST, "DELETE") && curl.setOption(CURLOPT_FOLLOWLOCATION, true) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+    decreaseThreadCountAndMayDeleteThis();
 }
 
 // HttpClient implementation
@@ -332,6 +434,7 @@ void HttpClient::destroyInstance() {
 
     thiz->_requestQueueMutex.lock();
     thiz->_requestQueue.pushBack(thiz->_requestSentinel);
+    thiz->wakeUpNetworkThread();
     thiz->_requestQueueMutex.unlock();
 
     thiz->_sleepCondition.notify_one();
@@ -385,6 +488,15 @@ bool HttpClient::lazyInitThreadSemaphore() {
     return true;
 }
 
+// Needs _requestQueueMutex
+void HttpClient::wakeUpNetworkThread() {
+#if LIBCURL_VERSION_NUM >= 0x074400
+    if (_multiHandle) {
+        curl_multi_wakeup(static_cast<CURLM *>(_multiHandle));
+    }
+#endif
+}
+
 //Add a get task to queue
 void HttpClient::send(HttpRequest *request) {
     if (false == lazyInitThreadSemaphore()) {
@@ -398,24 +510,32 @@ void HttpClient::send(HttpRequest *request) {
     request->retain();
 
     _requestQueueMutex.lock();
-    _requestQueue.pushBack(request);
+    insertRequestByPriority(request);
+    wakeUpNetworkThread();
     _requestQueueMutex.unlock();
 
     // Notify thread start to work
     _sleepCondition.notify_one();
 }
 
+// Starts the request right away, regardless of the queue and the concurrency limit
 void HttpClient::sendImmediate(HttpRequest *request) {
+    if (false == lazyInitThreadSemaphore()) {
+        return;
+    }
+
     if (!request) {
         return;
     }
 
     request->retain();
-    // Create a HttpResponse object, the default setting is http access failed
-    HttpResponse *response = new (std::nothrow) HttpResponse(request);
 
-    auto t = std::thread(&HttpClient::networkThreadAlone, this, request, response);
-    t.detach();
+    _requestQueueMutex.lock();
+    _immediateRequestQueue.pushBack(request);
+    wakeUpNetworkThread();
+    _requestQueueMutex.unlock();
+
+    _sleepCondition.notify_one();
 }
 
 // Poll and notify main thread if responses exists in queue
@@ -427,6 +547,7 @@ void HttpClient::dispatchResponseCallbacks() {
     _responseQueueMutex.lock();
     if (!_responseQueue.empty()) {
         response = _responseQueue.at(0);
+        response->retain();
         _responseQueue.erase(0);
     }
     _responseQueueMutex.unlock();
@@ -445,79 +566,6 @@ void HttpClient::dispatchResponseCallbacks() {
     }
 }
 
-// Process Response
-void HttpClient::processResponse(HttpResponse *response, char *responseMessage) {
-    auto request = response->getHttpRequest();
-    long responseCode = -1;
-    int retValue = 0;
-
-    // Process the request -> get response packet
-    switch (request->getRequestType()) {
-        case HttpRequest::Type::GET: // HTTP GET
-            retValue = processGetTask(this, request,
-                                      writeData,
-                                      response->getResponseData(),
-                                      &responseCode,
-                                      writeHeaderData,
-                                      response->getResponseHeader(),
-                                      responseMessage);
-            break;
-
-        case HttpRequest::Type::POST: // HTTP POST
-            retValue = processPostTask(this, request,
-                                       writeData,
-                                       response->getResponseData(),
-                                       &responseCode,
-                                       writeHeaderData,
-                                       response->getResponseHeader(),
-                                       responseMessage);
-            break;
-
-        case HttpRequest::Type::PUT:
-            retValue = processPutTask(this, request,
-                                      writeData,
-                                      response->getResponseData(),
-                                      &responseCode,
-                                      writeHeaderData,
-                                      response->getResponseHeader(),
-                                      responseMessage);
-            break;
-
-        case HttpRequest::Type::HEAD:
-            retValue = processHeadTask(this, request,
-                                       writeData,
-                                       response->getResponseData(),
-                                       &responseCode,
-                                       writeHeaderData,
-                                       response->getResponseHeader(),
-                                       responseMessage);
-            break;
-
-        case HttpRequest::Type::DELETE:
-            retValue = processDeleteTask(this, request,
-                                         writeData,
-                                         response->getResponseData(),
-                                         &responseCode,
-                                         writeHeaderData,
-                                         response->getResponseHeader(),
-                                         responseMessage);
-            break;
-
-        default:
-            CCASSERT(false, "CCHttpClient: unknown request type, only GET, POST, PUT, HEAD or DELETE is supported");
-            break;
-    }
-
-    // write data to HttpResponse
-    response->setResponseCode(responseCode);
-    if (retValue != 0) {
-        response->setSucceed(false);
-        response->setErrorBuffer(responseMessage);
-    } else {
-        response->setSucceed(true);
-    }
-}
-
 void HttpClient::increaseThreadCount() {
     _threadCountMutex.lock();
     ++_threadCount;
@@ -538,6 +586,12 @@ void HttpClient::decreaseThreadCountAndMayDeleteThis() {
     }
 }
 
+void HttpClient::setMaxConcurrentRequests(uint32_t count) {
+    std::lock_guard<std::mutex> lock(_requestQueueMutex);
+    _maxConcurrentRequests = count;
+    wakeUpNetworkThread();
+}
+
 void HttpClient::setTimeoutForConnect(int value) {
     std::lock_guard<std::mutex> lock(_timeoutForConnectMutex);
     _timeoutForConnect = value;
@@ -29,6 +29,7 @@
 #ifndef __CCHTTPCLIENT_H__
 #define __CCHTTPCLIENT_H__
 
+#include <atomic>
 #include <thread>
 #include <condition_variable>
 #include "base/Vector.h"
@@ -147,6 +148,21 @@ public:
      */
     CC_DEPRECATED_ATTRIBUTE int getTimeoutForRead();
 
+    /**
+     * Set how many requests sent with `send` may be in flight at once, 0 means no limit.
+     * Only honored by the libcurl backend, the others send requests one by one.
+     *
+     * @param count the maximum number of concurrent requests, 8 by default.
+     */
+    void setMaxConcurrentRequests(uint32_t count);
+
+    /**
+     * Get the maximum number of concurrent requests.
+     *
+     * @return uint32_t the maximum number of concurrent requests.
+     */
+    uint32_t getMaxConcurrentRequests() const { return _maxConcurrentRequests; }
+
     HttpCookie *getCookie() const { return _cookie; }
 
     std::mutex &getCookieFileMutex() { return _cookieFileMutex; }
@@ -169,6 +185,20 @@ private:
     void dispatchResponseCallbacks();
 
     void processResponse(HttpResponse *response, char *responseMessage);
+    // Keeps the queue sorted by priority, requests of the same priority stay in order. Needs _requestQueueMutex.
+    void insertRequestByPriority(HttpRequest *request) {
+        ssize_t index = _requestQueue.size();
+        // a queued sentinel stays last, whatever the priority of the request
+        if (index > 0 && _requestQueue.back() == _requestSentinel) {
+            --index;
+        }
+        while (index > 0 && _requestQueue.at(index - 1)->getPriority() < request->getPriority()) {
+            --index;
+        }
+        _requestQueue.insert(index, request);
+    }
+    // Interrupts the network thread while it waits on the network. Needs _requestQueueMutex.
+    void wakeUpNetworkThread();
     void increaseThreadCount();
     void decreaseThreadCountAndMayDeleteThis();
 
@@ -188,7 +218,10 @@ private:
     std::mutex _schedulerMutex;
 
     Vector<HttpRequest *> _requestQueue;
+    Vector<HttpRequest *> _immediateRequestQueue;
     std::mutex _requestQueueMutex;
+    void *_multiHandle{nullptr}; // curl multi handle of the network thread, guarded by _requestQueueMutex
+    std::atomic<uint32_t> _maxConcurrentRequests{8};
 
     Vector<HttpResponse *> _responseQueue;
     std::mutex _responseQueueMutex;
@@ -31,6 +31,7 @@
 #include "base/Ref.h"
 #include "base/Macros.h"
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <functional>
@@ -263,6 +264,32 @@ public:
         return _timeoutInSeconds;
     }
 
+    /**
+     * Set the priority of HttpRequest object, queued requests with a higher priority are sent first.
+     * Requests of the same priority are sent in order. The default priority is 0.
+     *
+     * @param priority the priority.
+     */
+    inline void setPriority(int priority) {
+        _priority = priority;
+    }
+
+    inline int getPriority() const {
+        return _priority;
+    }
+
+    /**
+     * Cancel the request, it's thread safe.
+     * The response callback is still called, with a failed response, unless it has been called already.
+     */
+    inline void cancel() {
+        _cancelled = true;
+    }
+
+    inline bool isCancelled() const {
+        return _cancelled;
+    }
+
 protected:
     // properties
     Type _requestType;                 /// kHttpRequestGet, kHttpRequestPost or other enums
@@ -273,6 +300,8 @@ protected:
     void *_userData;                   /// You can add your customed data here
     std::vector<std::string> _headers; /// custom http headers
     float _timeoutInSeconds;
+    int _priority{0};
+    std::atomic<bool> _cancelled{false};
 };
 
 } // namespace network
@@ -26,6 +26,7 @@
 ****************************************************************************/
 
 #include "network/SocketIO.h"
+#include "network/SocketIOCodec.h"
 #include "network/Uri.h"
 #include <algorithm>
 #include <sstream>
@@ -317,8 +318,15 @@ private:
 
     WebSocket *_ws;
 
+    // socket.io 1.x frames, the buffers are kept for the lifetime of the connection
+    SIOPacketDecoder _decoder;
+    SIOPacketEncoder _encoder;
+
     Map<std::string, SIOClient *> _clients;
 
+    void onMessageV10x(const WebSocket::Data &data);
+    void onPacketV10x(const SIOPacket &packet);
+
 public:
     SIOClientImpl(const Uri &uri, const std::string &caFilePath);
     virtual ~SIOClientImpl();
@@ -347,6 +355,7 @@ public:
     void send(const std::string &endpoint, const std::string &s);
     void send(SocketIOPacket *packet);
     void emit(const std::string &endpoint, const std::string &eventname, const std::string &args);
+    void emitBinary(const std::string &endpoint, const std::string &eventname, const std::vector<std::string_view> &attachments);
 };
 
 //method implementations
@@ -549,11 +558,15 @@ void SIOClientImpl::disconnect() {
         s = "";
         endpoint = "";
 
-        if (_version == SocketIOPacket::SocketIOVersion::V09x)
+        if (_version == SocketIOPacket::SocketIOVersion::V09x) {
             s = "0::" + endpoint;
-        else
-            s = "41" + endpoint;
-        _ws->send(s);
+            _ws->send(s);
+        } else {
+            SIOPacket packet;
+            packet.engineType = SIOEngineType::MESSAGE;
+            packet.type = SIOPacketType::DISCONNECT;
+            _ws->send(_encoder.encode(packet));
+        }
     }
 
     Application::getInstance()->getScheduler()->unscheduleAllForTarget(this);
@@ -585,6 +598,16 @@ void SIOClientImpl::addClient(const std::string &endpoint, SIOClient *client) {
 }
 
 void SIOClientImpl::connectToEndpoint(const std::string &endpoint) {
+    if (_version == SocketIOPacket::SocketIOVersion::V10x) {
+        SIOPacket packet;
+        packet.engineType = SIOEngineType::MESSAGE;
+        packet.type = SIOPacketType::CONNECT;
+        packet.nsp = endpoint;
+        if (_connected) {
+            _ws->send(_encoder.encode(packet));
+        }
+        return;
+    }
     SocketIOPacket *packet = SocketIOPacket::createPacketWithType("connect", _version);
     packet->setEndpoint(endpoint);
     this->send(packet);
@@ -600,16 +623,31 @@ void SIOClientImpl::disconnectFromEndpoint(const std::string &endpoint) {
         if (_connected)
             this->disconnect();
     } else {
-        std::string path = endpoint == "/" ? "" : endpoint;
+        if (_version == SocketIOPacket::SocketIOVersion::V09x) {
+            std::string path = endpoint == "/" ? "" : endpoint;
 
-        std::string s = "0::" + path;
+            std::string s = "0::" + path;
 
-        _ws->send(s);
+            _ws->send(s);
+        } else {
+            SIOPacket packet;
+            packet.engineType = SIOEngineType::MESSAGE;
+            packet.type = SIOPacketType::DISCONNECT;
+            packet.nsp = endpoint;
+            _ws->send(_encoder.encode(packet));
+        }
         _clients.erase(endpoint);
     }
 }
 
 void SIOClientImpl::heartbeat(float /*dt*/) {
+    if (_version == SocketIOPacket::SocketIOVersion::V10x) {
+        if (_connected) {
+            _ws->send(_encoder.encode(SIOEngineType::PING));
+        }
+        CC_LOG_INFO("Heartbeat sent");
+        return;
+    }
     SocketIOPacket *packet = SocketIOPacket::createPacketWithType("heartbeat", _version);
 
     this->send(packet);
@@ -646,6 +684,15 @@ void SIOClientImpl::send(SocketIOPacket *packet) {
 
 void SIOClientImpl::emit(const std::string &endpoint, const std::string &eventname, const std::string &args) {
     CC_LOG_INFO("Emitting event \"%s\"", eventname.c_str());
+    if (_version == SocketIOPacket::SocketIOVersion::V10x) {
+        const std::string &req = _encoder.encodeEvent(endpoint, eventname, args);
+        if (_connected) {
+            _ws->send(req);
+        } else {
+            CC_LOG_INFO("Cant send the message (%s) because disconnected", req.c_str());
+        }
+        return;
+    }
     SocketIOPacket *packet = SocketIOPacket::createPacketWithType("event", _version);
     packet->setEndpoint(endpoint == "/" ? "" : endpoint);
     packet->setEvent(eventname);
@@ -654,14 +701,31 @@ void SIOClientImpl::emit(const std::string &endpoint, const std::string &eventna
     delete packet;
 }
 
+void SIOClientImpl::emitBinary(const std::string &endpoint, const std::string &eventname, const std::vector<std::string_view> &attachments) {
+    CC_LOG_INFO("Emitting binary event \"%s\"", eventname.c_str());
+    if (_version != SocketIOPacket::SocketIOVersion::V10x) {
+        CC_LOG_ERROR("Binary events need socket.io 1.x");
+        return;
+    }
+    if (!_connected) {
+        CC_LOG_INFO("Cant send the binary event (%s) because disconnected", eventname.c_str());
+        return;
+    }
+    _ws->send(_encoder.encodeBinaryEvent(endpoint, eventname, static_cast<uint32_t>(attachments.size())));
+    for (const auto &attachment : attachments) {
+        const std::string &frame = _encoder.encodeAttachment(attachment);
+        _ws->send(reinterpret_cast<const unsigned char *>(frame.data()), static_cast<unsigned int>(frame.size()));
+    }
+}
+
 void SIOClientImpl::onOpen(WebSocket * /*ws*/) {
     _connected = true;
 
     SocketIO::getInstance()->addSocket(_uri.getAuthority(), this);
 
     if (_version == SocketIOPacket::SocketIOVersion::V10x) {
-        std::string s = "5"; //That's a ping https://github.com/Automattic/engine.io-parser/blob/1b8e077b2218f4947a69f5ad18be2a512ed54e93/lib/index.js#L21
-        _ws->send(s.data());
+        //That's an upgrade https://github.com/Automattic/engine.io-parser/blob/1b8e077b2218f4947a69f5ad18be2a512ed54e93/lib/index.js#L21
+        _ws->send(_encoder.encode(SIOEngineType::UPGRADE));
     }
 
     Application::getInstance()->getScheduler()->schedule(CC_CALLBACK_1(SIOClientImpl::heartbeat, this), this, (_heartbeat * .9f), false, "heartbeat");
@@ -674,6 +738,11 @@ void SIOClientImpl::onOpen(WebSocket * /*ws*/) {
 }
 
 void SIOClientImpl::onMessage(WebSocket * /*ws*/, const WebSocket::Data &data) {
+    if (_version == SocketIOPacket::SocketIOVersion::V10x) {
+        onMessageV10x(data);
+        return;
+    }
+
     CC_LOG_INFO("SIOClientImpl::onMessage received: %s", data.bytes);
 
     std::string payload = data.bytes;
@@ -772,114 +841,110 @@ void SIOClientImpl::onMessage(WebSocket * /*ws*/, const WebSocket::Data &data) {
                     break;
             }
         } break;
-        case SocketIOPacket::SocketIOVersion::V10x: {
-            switch (control) {
-                case 0:
-                    CC_LOG_INFO("Not supposed to receive control 0 for websocket");
-                    CC_LOG_INFO("That's not good");
-                    break;
-                case 1:
-                    CC_LOG_INFO("Not supposed to receive control 1 for websocket");
-                    break;
-                case 2:
-                    CC_LOG_INFO("Ping received, send pong");
-                    payload = "3" + payload;
-                    _ws->send(payload);
-                    break;
-                case 3:
-                    CC_LOG_INFO("Pong received");
-                    if (payload == "probe") {
-                        CC_LOG_INFO("Request Update");
-                        _ws->send("5");
-                    }
-                    break;
-                case 4: {
-                    int control2 = payload.at(0) - '0';
-                    CC_LOG_INFO("Message code: [%i]", control2);
+        case SocketIOPacket::SocketIOVersion::V10x:
+            // handled by onMessageV10x
+            break;
+    }
 
-                    std::string endpoint = "";
+    return;
+}
 
-                    std::string::size_type a = payload.find("/");
-                    std::string::size_type b = payload.find("[");
+void SIOClientImpl::onMessageV10x(const WebSocket::Data &data) {
+    SIOPacket packet;
+    switch (_decoder.feed(std::string_view(data.bytes, data.len), data.isBinary, &packet)) {
+        case SIOPacketDecoder::Result::PACKET:
+            onPacketV10x(packet);
+            break;
+        case SIOPacketDecoder::Result::PENDING:
+            break;
+        case SIOPacketDecoder::Result::INVALID:
+            CC_LOG_ERROR("SIOClientImpl::onMessage malformed %s frame of %d bytes", data.isBinary ? "binary" : "text", static_cast<int>(data.len));
+            break;
+    }
+}
 
-                    if (b != std::string::npos) {
-                        if (a != std::string::npos && a < b) {
-                            //we have an endpoint and a payload
-                            endpoint = payload.substr(a, b - (a + 1));
-                        }
-                    } else if (a != std::string::npos) {
-                        //we have an endpoint with no payload
-                        endpoint = payload.substr(a, payload.size() - a);
-                    }
+void SIOClientImpl::onPacketV10x(const SIOPacket &packet) {
+    switch (packet.engineType) {
+        case SIOEngineType::OPEN:
+            CC_LOG_INFO("Not supposed to receive control 0 for websocket");
+            CC_LOG_INFO("That's not good");
+            return;
+        case SIOEngineType::CLOSE:
+            CC_LOG_INFO("Not supposed to receive control 1 for websocket");
+            return;
+        case SIOEngineType::PING:
+            CC_LOG_INFO("Ping received, send pong");
+            _ws->send(_encoder.encode(SIOEngineType::PONG, packet.data));
+            return;
+        case SIOEngineType::PONG:
+            CC_LOG_INFO("Pong received");
+            if (packet.data == "probe") {
+                CC_LOG_INFO("Request Update");
+                _ws->send(_encoder.encode(SIOEngineType::UPGRADE));
+            }
+            return;
+        case SIOEngineType::UPGRADE:
+            CC_LOG_INFO("Upgrade required");
+            return;
+        case SIOEngineType::NOOP:
+            CC_LOG_INFO("Noop\n");
+            return;
+        case SIOEngineType::MESSAGE:
+        case SIOEngineType::INVALID:
+            break;
+    }
 
-                    // we didn't find and endpoint and we are in the default namespace
-                    if (endpoint == "") endpoint = "/";
-
-                    c = getClient(endpoint);
-
-                    payload = payload.substr(1);
-
-                    if (endpoint != "/") payload = payload.substr(endpoint.size());
-                    if (endpoint != "/" && payload != "") payload = payload.substr(1);
-
-                    switch (control2) {
-                        case 0:
-                            CC_LOG_INFO("Socket Connected");
-                            if (c) {
-                                c->onConnect();
-                                c->fireEvent("connect", payload);
-                            }
-                            break;
-                        case 1:
-                            CC_LOG_INFO("Socket Disconnected");
-                            disconnectFromEndpoint(endpoint);
-                            c->fireEvent("disconnect", payload);
-                            break;
-                        case 2: {
-                            CC_LOG_INFO("Event Received (%s)", payload.c_str());
-
-                            std::string::size_type payloadFirstSlashPos = payload.find("\"");
-                            std::string::size_type payloadSecondSlashPos = payload.substr(payloadFirstSlashPos + 1).find("\"");
-
-                            std::string eventname = payload.substr(payloadFirstSlashPos + 1,
-                                                                   payloadSecondSlashPos - payloadFirstSlashPos + 1);
-
-                            CC_LOG_INFO("event name %s between %i and %i", eventname.c_str(),
-                                        payloadFirstSlashPos, payloadSecondSlashPos);
-
-                            payload = payload.substr(payloadSecondSlashPos + 4,
-                                                     payload.size() - (payloadSecondSlashPos + 5));
-
-                            if (c) c->fireEvent(eventname, payload);
-                            if (c) c->getDelegate()->onMessage(c, payload);
-
-                        } break;
-                        case 3:
-                            CC_LOG_INFO("Message Ack");
-                            break;
-                        case 4:
-                            CC_LOG_ERROR("Error");
-                            if (c) c->fireEvent("error", payload);
-                            break;
-                        case 5:
-                            CC_LOG_INFO("Binary Event");
-                            break;
-                        case 6:
-                            CC_LOG_INFO("Binary Ack");
-                            break;
-                    }
-                } break;
-                case 5:
-                    CC_LOG_INFO("Upgrade required");
-                    break;
-                case 6:
-                    CC_LOG_INFO("Noop\n");
-                    break;
+    CC_LOG_INFO("Message code: [%i]", static_cast<int>(packet.type));
+
+    std::string endpoint(packet.nsp);
+    SIOClient *c = getClient(endpoint);
+
+    switch (packet.type) {
+        case SIOPacketType::CONNECT:
+            CC_LOG_INFO("Socket Connected");
+            if (c) {
+                c->onConnect();
+                c->fireEvent("connect", std::string(packet.data));
+            }
+            break;
+        case SIOPacketType::DISCONNECT:
+            CC_LOG_INFO("Socket Disconnected");
+            disconnectFromEndpoint(endpoint);
+            if (c) c->fireEvent("disconnect", std::string(packet.data));
+            break;
+        case SIOPacketType::EVENT:
+        case SIOPacketType::BINARY_EVENT: {
+            std::string_view eventname;
+            std::string_view args;
+            if (!SIOPacketDecoder::splitEvent(packet.data, &eventname, &args)) {
+                CC_LOG_ERROR("Malformed event received");
+                break;
+            }
+            if (!c) break;
+
+            std::string name(eventname);
+            std::string payload(args);
+            CC_LOG_INFO("Event Received (%s)", name.c_str());
+            if (packet.type == SIOPacketType::BINARY_EVENT) {
+                c->fireBinaryEvent(name, payload, _decoder.getAttachments());
+            } else {
+                c->fireEvent(name, payload);
+                c->getDelegate()->onMessage(c, payload);
             }
         } break;
+        case SIOPacketType::ACK:
+            CC_LOG_INFO("Message Ack");
+            break;
+        case SIOPacketType::ERROR:
+            CC_LOG_ERROR("Error");
+            if (c) c->fireEvent("error", std::string(packet.data));
+            break;
+        case SIOPacketType::BINARY_ACK:
+            CC_LOG_INFO("Binary Ack");
+            break;
+        case SIOPacketType::NONE:
+            break;
     }
-
-    return;
 }
 
 void SIOClientImpl::onClose(WebSocket * /*ws*/) {
@@ -943,6 +1008,14 @@ void SIOClient::emit(const std::string &eventname, const std::string &args) {
     }
 }
 
+void SIOClient::emitBinary(const std::string &eventname, const std::vector<std::string_view> &attachments) {
+    if (_connected) {
+        _socket->emitBinary(_path, eventname, attachments);
+    } else {
+        _delegate->onError(this, "Client not yet connected");
+    }
+}
+
 void SIOClient::disconnect() {
     if (_connected) {
         _connected = false;
@@ -978,6 +1051,17 @@ void SIOClient::fireEvent(const std::string &eventName, const std::string &data)
     CC_LOG_INFO("SIOClient::fireEvent no native event with name %s found", eventName.c_str());
 }
 
+void SIOClient::fireBinaryEvent(const std::string &eventName, const std::string &data, const std::vector<std::string_view> &attachments) {
+    CC_LOG_INFO("SIOClient::fireBinaryEvent called with event name: %s and %d attachments", eventName.c_str(), static_cast<int>(attachments.size()));
+
+    _delegate->fireBinaryEventToScript(this, eventName, data, attachments);
+
+    auto iter = _eventRegistry.find(eventName);
+    if (iter != _eventRegistry.end() && iter->second) {
+        iter->second(this, data);
+    }
+}
+
 void SIOClient::setTag(const char *tag) {
     _tag = tag;
 }
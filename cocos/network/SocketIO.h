@@ -28,7 +28,9 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 #include <functional>
 #include "base/Macros.h"
 #include "base/Map.h"
@@ -111,6 +113,16 @@ public:
          * @param data the event's data information.
          */
         virtual void fireEventToScript(SIOClient *client, const std::string &eventName, const std::string &data) { CC_LOG_DEBUG("SIODelegate event '%s' fired with data: %s", eventName.c_str(), data.c_str()); };
+        /**
+         * Fire binary event to script when the related SIOClient object receive a socket.io 1.x binary event.
+         * Falls back to fireEventToScript without the attachments.
+         *
+         * @param client the connected SIOClient object.
+         * @param eventName the event's name.
+         * @param data the event's arguments, every attachment is a {"_placeholder":true,"num":index} object.
+         * @param attachments the bytes of the attachments, only valid during the call.
+         */
+        virtual void fireBinaryEventToScript(SIOClient *client, const std::string &eventName, const std::string &data, const std::vector<std::string_view> & /*attachments*/) { fireEventToScript(client, eventName, data); };
     };
 
     /**
@@ -181,6 +193,7 @@ private:
     uint32_t _instanceId;
 
     void fireEvent(const std::string &eventName, const std::string &data);
+    void fireBinaryEvent(const std::string &eventName, const std::string &data, const std::vector<std::string_view> &attachments);
 
     void onOpen();
     void onConnect();
@@ -226,6 +239,12 @@ public:
      * @param args
      */
     void emit(const std::string &eventname, const std::string &args);
+    /**
+     *  Emit the eventname with binary attachments as arguments, sent as raw websocket frames (socket.io 1.x only).
+     * @param eventname
+     * @param attachments
+     */
+    void emitBinary(const std::string &eventname, const std::vector<std::string_view> &attachments);
     /**
      * Used to register a socket.io event callback.
      * Event argument should be passed using CC_CALLBACK2(&Base::function, this).
@@ -0,0 +1,326 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "network/SocketIOCodec.h"
+
+namespace cc {
+
+namespace network {
+
+namespace {
+
+// engine.io protocol 3 prefixes binary websocket frames with the MESSAGE type as a raw byte
+constexpr char BINARY_MESSAGE_PREFIX = 4;
+
+// Enough for any ack id or attachment count, and far from overflowing
+constexpr size_t MAX_NUMBER_DIGITS = 15;
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+size_t skipSpaces(std::string_view str, size_t pos) {
+    while (pos < str.size() && isSpace(str[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+// Parses the digits at pos, returns false if there are none or too many
+bool parseNumber(std::string_view str, size_t *pos, int64_t *value) {
+    size_t i = *pos;
+    int64_t number = 0;
+    while (i < str.size() && isDigit(str[i])) {
+        if (i - *pos == MAX_NUMBER_DIGITS) {
+            return false;
+        }
+        number = number * 10 + (str[i] - '0');
+        ++i;
+    }
+    if (i == *pos) {
+        return false;
+    }
+    *pos = i;
+    *value = number;
+    return true;
+}
+
+inline bool isBinaryPacket(SIOPacketType type) {
+    return type == SIOPacketType::BINARY_EVENT || type == SIOPacketType::BINARY_ACK;
+}
+
+} // namespace
+
+bool SIOPacketDecoder::decode(std::string_view frame, SIOPacket *packet) {
+    *packet = SIOPacket();
+    if (frame.empty() || frame[0] < '0' || frame[0] > '6') {
+        return false;
+    }
+    packet->engineType = static_cast<SIOEngineType>(frame[0] - '0');
+    if (packet->engineType != SIOEngineType::MESSAGE) {
+        packet->data = frame.substr(1);
+        return true;
+    }
+
+    if (frame.size() < 2 || frame[1] < '0' || frame[1] > '6') {
+        return false;
+    }
+    packet->type = static_cast<SIOPacketType>(frame[1] - '0');
+    size_t pos = 2;
+
+    if (isBinaryPacket(packet->type)) {
+        int64_t attachments = 0;
+        if (!parseNumber(frame, &pos, &attachments) || pos >= frame.size() || frame[pos] != '-' || attachments > UINT32_MAX) {
+            return false;
+        }
+        packet->attachments = static_cast<uint32_t>(attachments);
+        ++pos;
+    }
+
+    if (pos < frame.size() && frame[pos] == '/') {
+        size_t end = frame.find(',', pos);
+        if (end == std::string_view::npos) {
+            packet->nsp = frame.substr(pos);
+            pos = frame.size();
+        } else {
+            packet->nsp = frame.substr(pos, end - pos);
+            pos = end + 1;
+        }
+    }
+
+    if (pos < frame.size() && isDigit(frame[pos]) && !parseNumber(frame, &pos, &packet->ackId)) {
+        return false;
+    }
+
+    packet->data = frame.substr(pos);
+    return true;
+}
+
+bool SIOPacketDecoder::splitEvent(std::string_view data, std::string_view *name, std::string_view *args) {
+    size_t pos = skipSpaces(data, 0);
+    if (pos >= data.size() || data[pos] != '[') {
+        return false;
+    }
+    pos = skipSpaces(data, pos + 1);
+    if (pos >= data.size() || data[pos] != '"') {
+        return false;
+    }
+
+    size_t nameBegin = ++pos;
+    while (pos < data.size() && data[pos] != '"') {
+        pos += data[pos] == '\\' ? 2 : 1;
+    }
+    if (pos >= data.size()) {
+        return false;
+    }
+    *name = data.substr(nameBegin, pos - nameBegin);
+
+    size_t end = data.size();
+    while (end > pos + 1 && isSpace(data[end - 1])) {
+        --end;
+    }
+    if (data[end - 1] != ']' || end - 1 == pos) {
+        return false;
+    }
+    --end;
+
+    pos = skipSpaces(data, pos + 1);
+    if (pos == end) {
+        *args = std::string_view();
+        return true;
+    }
+    if (data[pos] != ',') {
+        return false;
+    }
+    pos = skipSpaces(data, pos + 1);
+    while (end > pos && isSpace(data[end - 1])) {
+        --end;
+    }
+    *args = data.substr(pos, end - pos);
+    return true;
+}
+
+SIOPacketDecoder::Result SIOPacketDecoder::feed(std::string_view frame, bool isBinary, SIOPacket *packet) {
+    if (!_waitingAttachments) {
+        _attachments.clear();
+        if (isBinary || !decode(frame, packet)) {
+            return Result::INVALID;
+        }
+        if (!isBinaryPacket(packet->type) || packet->attachments == 0) {
+            return Result::PACKET;
+        }
+
+        // The frame is gone after this call, keep the header until its attachments are here
+        _pendingFrame.assign(frame.data(), frame.size());
+        decode(_pendingFrame, &_pending);
+        _attachmentData.clear();
+        _attachmentEnds.clear();
+        _waitingAttachments = true;
+        return Result::PENDING;
+    }
+
+    if (!isBinary) {
+        // Control packets may still come in between, another message may not
+        if (decode(frame, packet) && packet->engineType != SIOEngineType::MESSAGE) {
+            return Result::PACKET;
+        }
+        reset();
+        return Result::INVALID;
+    }
+
+    if (frame.empty() || frame[0] != BINARY_MESSAGE_PREFIX) {
+        reset();
+        return Result::INVALID;
+    }
+    _attachmentData.append(frame.data() + 1, frame.size() - 1);
+    _attachmentEnds.push_back(_attachmentData.size());
+    if (_attachmentEnds.size() < _pending.attachments) {
+        return Result::PENDING;
+    }
+
+    size_t begin = 0;
+    for (size_t end : _attachmentEnds) {
+        _attachments.emplace_back(_attachmentData.data() + begin, end - begin);
+        begin = end;
+    }
+    *packet = _pending;
+    _waitingAttachments = false;
+    return Result::PACKET;
+}
+
+void SIOPacketDecoder::reset() {
+    _pendingFrame.clear();
+    _attachmentData.clear();
+    _attachmentEnds.clear();
+    _attachments.clear();
+    _pending = SIOPacket();
+    _waitingAttachments = false;
+}
+
+const std::string &SIOPacketEncoder::encode(SIOEngineType type, std::string_view data) {
+    _buffer.clear();
+    _buffer += static_cast<char>('0' + static_cast<int>(type));
+    _buffer.append(data.data(), data.size());
+    return _buffer;
+}
+
+void SIOPacketEncoder::beginPacket(SIOPacketType type, uint32_t attachments, std::string_view nsp, int64_t ackId, bool hasData) {
+    _buffer.clear();
+    _buffer += static_cast<char>('0' + static_cast<int>(SIOEngineType::MESSAGE));
+    _buffer += static_cast<char>('0' + static_cast<int>(type));
+    if (isBinaryPacket(type)) {
+        _buffer += std::to_string(attachments);
+        _buffer += '-';
+    }
+    bool hasNsp = !nsp.empty() && nsp != "/";
+    if (hasNsp) {
+        _buffer.append(nsp.data(), nsp.size());
+    }
+    if (ackId >= 0) {
+        if (hasNsp) {
+            _buffer += ',';
+            hasNsp = false;
+        }
+        _buffer += std::to_string(ackId);
+    }
+    if (hasNsp && hasData) {
+        _buffer += ',';
+    }
+}
+
+const std::string &SIOPacketEncoder::encode(const SIOPacket &packet) {
+    if (packet.engineType != SIOEngineType::MESSAGE) {
+        return encode(packet.engineType, packet.data);
+    }
+    beginPacket(packet.type, packet.attachments, packet.nsp, packet.ackId, !packet.data.empty());
+    _buffer.append(packet.data.data(), packet.data.size());
+    return _buffer;
+}
+
+const std::string &SIOPacketEncoder::encodeEvent(std::string_view nsp, std::string_view event, std::string_view arg, int64_t ackId) {
+    beginPacket(SIOPacketType::EVENT, 0, nsp, ackId, true);
+    _buffer += '[';
+    appendJSONString(&_buffer, event);
+    _buffer += ',';
+    appendJSONString(&_buffer, arg);
+    _buffer += ']';
+    return _buffer;
+}
+
+const std::string &SIOPacketEncoder::encodeBinaryEvent(std::string_view nsp, std::string_view event, uint32_t attachmentCount, int64_t ackId) {
+    beginPacket(SIOPacketType::BINARY_EVENT, attachmentCount, nsp, ackId, true);
+    _buffer += '[';
+    appendJSONString(&_buffer, event);
+    for (uint32_t i = 0; i < attachmentCount; ++i) {
+        _buffer += R"(,{"_placeholder":true,"num":)";
+        _buffer += std::to_string(i);
+        _buffer += '}';
+    }
+    _buffer += ']';
+    return _buffer;
+}
+
+const std::string &SIOPacketEncoder::encodeAttachment(std::string_view bytes) {
+    _buffer.clear();
+    _buffer += BINARY_MESSAGE_PREFIX;
+    _buffer.append(bytes.data(), bytes.size());
+    return _buffer;
+}
+
+void SIOPacketEncoder::appendJSONString(std::string *out, std::string_view str) {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    out->reserve(out->size() + str.size() + 2);
+    *out += '"';
+    size_t runBegin = 0;
+    for (size_t i = 0; i < str.size(); ++i) {
+        auto c = static_cast<unsigned char>(str[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        // characters that don't need escaping are appended in runs
+        out->append(str.data() + runBegin, i - runBegin);
+        runBegin = i + 1;
+        switch (c) {
+            case '"': *out += "\\\""; break;
+            case '\\': *out += "\\\\"; break;
+            case '\b': *out += "\\b"; break;
+            case '\f': *out += "\\f"; break;
+            case '\n': *out += "\\n"; break;
+            case '\r': *out += "\\r"; break;
+            case '\t': *out += "\\t"; break;
+            default:
+                *out += "\\u00";
+                *out += HEX_DIGITS[c >> 4];
+                *out += HEX_DIGITS[c & 0xF];
+                break;
+        }
+    }
+    out->append(str.data() + runBegin, str.size() - runBegin);
+    *out += '"';
+}
+
+} // namespace network
+
+} // namespace cc
@@ -0,0 +1,157 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "base/Macros.h"
+
+namespace cc {
+
+namespace network {
+
+/**
+ * engine.io packet types, the first character of every text frame.
+ */
+enum class SIOEngineType : uint8_t {
+    OPEN,
+    CLOSE,
+    PING,
+    PONG,
+    MESSAGE,
+    UPGRADE,
+    NOOP,
+    INVALID
+};
+
+/**
+ * socket.io packet types, the second character of an engine.io MESSAGE.
+ */
+enum class SIOPacketType : uint8_t {
+    CONNECT,
+    DISCONNECT,
+    EVENT,
+    ACK,
+    ERROR,
+    BINARY_EVENT,
+    BINARY_ACK,
+    NONE
+};
+
+/**
+ * A decoded packet of the socket.io 1.x websocket transport:
+ * <engine type>[<packet type>[<attachments>-][<namespace>,][<ack id>]]<data>
+ *
+ * The views point into the decoded frame, nothing is copied.
+ */
+struct SIOPacket {
+    SIOEngineType engineType{SIOEngineType::INVALID};
+    SIOPacketType type{SIOPacketType::NONE};
+    uint32_t attachments{0};
+    std::string_view nsp{"/"};
+    int64_t ackId{-1};
+    std::string_view data;
+};
+
+/**
+ * Decodes incoming frames into SIOPacket.
+ *
+ * Text frames are decoded in place. A binary event or ack is followed by one binary frame per
+ * attachment, those are kept by the decoder until the last one arrives. Attachments are raw
+ * bytes, base64 is never involved.
+ */
+class CC_DLL SIOPacketDecoder final {
+public:
+    enum class Result {
+        PACKET,  // packet (and attachments) are complete
+        PENDING, // more binary frames are needed
+        INVALID
+    };
+
+    /**
+     * Decodes one text frame, returns false if it's malformed.
+     */
+    static bool decode(std::string_view frame, SIOPacket *packet);
+
+    /**
+     * Splits the data of an event ["name",arg,...] into the name, without quotes or unescaping,
+     * and the raw JSON of the arguments. args is empty if there are none.
+     */
+    static bool splitEvent(std::string_view data, std::string_view *name, std::string_view *args);
+
+    /**
+     * Feeds the frames of a connection in arrival order. When PACKET is returned, packet and
+     * getAttachments() are valid until the next call.
+     */
+    Result feed(std::string_view frame, bool isBinary, SIOPacket *packet);
+
+    const std::vector<std::string_view> &getAttachments() const { return _attachments; }
+
+    void reset();
+
+private:
+    std::string _pendingFrame;
+    std::string _attachmentData;
+    std::vector<size_t> _attachmentEnds;
+    std::vector<std::string_view> _attachments;
+    SIOPacket _pending;
+    bool _waitingAttachments{false};
+};
+
+/**
+ * Builds outgoing frames into one reused buffer, the returned frame is valid until the next call.
+ */
+class CC_DLL SIOPacketEncoder final {
+public:
+    // A bare engine.io packet, e.g. ping or pong.
+    const std::string &encode(SIOEngineType type, std::string_view data = {});
+
+    // A socket.io packet, packet.data is written as is.
+    const std::string &encode(const SIOPacket &packet);
+
+    // An event with one string argument, ["event","arg"].
+    const std::string &encodeEvent(std::string_view nsp, std::string_view event, std::string_view arg, int64_t ackId = -1);
+
+    // A binary event whose arguments are the placeholders of attachmentCount attachments, each one
+    // has to be sent with encodeAttachment right after it.
+    const std::string &encodeBinaryEvent(std::string_view nsp, std::string_view event, uint32_t attachmentCount, int64_t ackId = -1);
+
+    // The binary frame of an attachment.
+    const std::string &encodeAttachment(std::string_view bytes);
+
+    static void appendJSONString(std::string *out, std::string_view str);
+
+private:
+    void beginPacket(SIOPacketType type, uint32_t attachments, std::string_view nsp, int64_t ackId, bool hasData);
+
+    std::string _buffer;
+};
+
+} // namespace network
+
+} // namespace cc
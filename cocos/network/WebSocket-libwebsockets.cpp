@@ -32,7 +32,6 @@
 #include <cerrno>
 #include <condition_variable>
 #include <csignal>
-#include <list>
 #include <memory> // for std::shared_ptr
 #include <mutex>
 #include <queue>
@@ -40,6 +39,7 @@
 #include <thread>
 #include <vector>
 #include "base/Scheduler.h"
+#include "concurrentqueue/concurrentqueue.h"
 #include "network/Uri.h"
 #include "network/WebSocket.h"
 #include "platform/Application.h"
@@ -55,6 +55,11 @@
 
 #define WS_RX_BUFFER_SIZE              (65536)
 #define WS_RESERVE_RECEIVE_BUFFER_SIZE (4096)
+#define WS_SEND_QUEUE_INITIAL_SIZE     (32)
+// Messages are written back to back in one writable callback until this many bytes went out
+#define WS_WRITE_BATCH_SIZE (65536)
+// The websocket thread is woken up by lws_cancel_service, the timeout only paces lws internal timers
+#define WS_SERVICE_TIMEOUT_MS (100)
 
 #define LOG_TAG "WebSocket.cpp"
 
@@ -172,6 +177,25 @@ static void printWebSocketLog(int level, const char *line) {
 #endif // #if CC_DEBUG > 0
 }
 
+// Outgoing message, the payload is preceded by LWS_PRE bytes for libwebsockets to write the frame header into.
+struct WsSendMessage {
+    WsSendMessage(bool isBinary, const void *data, size_t len)
+    : buffer(new unsigned char[LWS_PRE + len]),
+      length(len),
+      isBinary(isBinary) {
+        if (len > 0) {
+            memcpy(buffer.get() + LWS_PRE, data, len);
+        }
+    }
+
+    unsigned char *payload() const { return buffer.get() + LWS_PRE; }
+
+    std::unique_ptr<unsigned char[]> buffer;
+    size_t                           length{0};
+    size_t                           issued{0};
+    bool                             isBinary{false};
+};
+
 class WebSocketImpl {
 public:
     static void closeAllConnections();
@@ -201,14 +225,18 @@ private:
     void onClientOpenConnectionRequest();
     int  onSocketCallback(struct lws *wsi, enum lws_callback_reasons reason, void *in, ssize_t len);
 
-    int onClientWritable();
-    int onClientReceivedData(void *in, ssize_t len);
+    int  onClientWritable();
+    void requestWritable();
+    void clearSendQueue();
+    int  onClientReceivedData(void *in, ssize_t len);
     int onConnectionOpened();
     int onConnectionError();
     int onConnectionClosed();
 
     struct lws_vhost *createVhost(struct lws_protocols *protocols, int *sslConnection);
 
+    void enqueueSendMessage(bool isBinary, const void *data, size_t len);
+
     cc::network::WebSocket *      _ws;
     cc::network::WebSocket::State _readyState;
     std::mutex                    _readyStateMutex;
@@ -238,21 +266,27 @@ private:
 
     std::string _caFilePath;
 
+    // Sending messages are queued lock free by the cocos thread and written by the websocket thread.
+    moodycamel::ConcurrentQueue<WsSendMessage *> _sendQueue{WS_SEND_QUEUE_INITIAL_SIZE};
+    WsSendMessage *                              _sendingMessage{nullptr}; // partially sent, websocket thread only
+    std::atomic<size_t>                          _bufferedAmount{0};
+    std::atomic<bool>                            _writableRequested{false};
+    bool                                         _isEstablished{false}; // websocket thread only
+
     friend class WsThreadHelper;
     friend class WebSocketCallbackWrapper;
 };
 
 enum WsMsg {
-    WS_MSG_TO_SUBTRHEAD_SENDING_STRING = 0,
-    WS_MSG_TO_SUBTRHEAD_SENDING_BINARY,
-    WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION
+    WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION = 0,
+    WS_MSG_TO_SUBTHREAD_REQUEST_WRITABLE
 };
 
 class WsThreadHelper;
 
 static std::vector<WebSocketImpl *> *websocketInstances = nullptr;
 static std::recursive_mutex          instanceMutex;
-static struct lws_context *          wsContext = nullptr;
+static std::atomic<lws_context *>     wsContext{nullptr};
 static WsThreadHelper *              wsHelper  = nullptr;
 
 #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
@@ -303,20 +337,11 @@ static lws_context_creation_info convertToContextCreationInfo(const struct lws_p
     return info;
 }
 
-class WsMessage {
-public:
-    WsMessage() : id(++idCount) {}
-    unsigned int                  id;
-    unsigned int                  what{0}; // message type
-    cc::network::WebSocket::Data *data{nullptr};
-    void *                        user{nullptr};
-
-private:
-    static unsigned int idCount;
+struct WsMessage {
+    WsMsg          what{WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION};
+    WebSocketImpl *ws{nullptr};
 };
 
-unsigned int WsMessage::idCount = 0;
-
 /**
  *  @brief Websocket thread helper, it's used for sending message between UI thread and websocket thread.
  */
@@ -333,10 +358,8 @@ public:
     // Sends message to Cocos thread. It's needed to be invoked in Websocket thread.
     static void sendMessageToCocosThread(const std::function<void()> &cb);
 
-    // Sends message to Websocket thread. It's needs to be invoked in Cocos thread.
-    void sendMessageToWebSocketThread(WsMessage *msg);
-
-    size_t countBufferdBytes(const WebSocketImpl *ws);
+    // Sends message to Websocket thread and wakes it up. It's thread safe.
+    void sendMessageToWebSocketThread(const WsMessage &msg);
 
     // Waits the sub-thread (websocket thread) to exit,
     void joinWebSocketThread() const;
@@ -349,12 +372,11 @@ protected:
     void wsThreadEntryFunc() const;
 
 public:
-    std::list<WsMessage *> *_subThreadWsMessageQueue;
-    std::mutex              _subThreadWsMessageQueueMutex;
-    std::thread *           _subThreadInstance{nullptr};
+    moodycamel::ConcurrentQueue<WsMessage> _subThreadWsMessageQueue;
+    std::thread *                          _subThreadInstance{nullptr};
 
 private:
-    bool _needQuit{false};
+    std::atomic<bool> _needQuit{false};
 };
 
 // Wrapper for converting websocket callback from static function to member function of WebSocket class.
@@ -383,16 +405,11 @@ public:
 };
 
 // Implementation of WsThreadHelper
-WsThreadHelper::WsThreadHelper()
-
-{
-    _subThreadWsMessageQueue = new (std::nothrow) std::list<WsMessage *>();
-}
+WsThreadHelper::WsThreadHelper() = default;
 
 WsThreadHelper::~WsThreadHelper() {
     joinWebSocketThread();
     CC_SAFE_DELETE(_subThreadInstance);
-    delete _subThreadWsMessageQueue;
 }
 
 bool WsThreadHelper::createWebSocketThread() {
@@ -403,32 +420,29 @@ bool WsThreadHelper::createWebSocketThread() {
 
 void WsThreadHelper::quitWebSocketThread() {
     _needQuit = true;
+    if (wsContext) {
+        lws_cancel_service(wsContext);
+    }
 }
 
 void WsThreadHelper::onSubThreadLoop() {
     if (wsContext) {
-        //        _readyStateMutex.unlock();
-        wsHelper->_subThreadWsMessageQueueMutex.lock();
-        bool isEmpty = wsHelper->_subThreadWsMessageQueue->empty();
-
-        if (!isEmpty) {
-            auto iter = wsHelper->_subThreadWsMessageQueue->begin();
-            for (; iter != wsHelper->_subThreadWsMessageQueue->end();) {
-                auto *msg = (*iter);
-                auto *ws  = static_cast<WebSocketImpl *>(msg->user);
-                // REFINE: ws may be a invalid pointer
-                if (msg->what == WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION) {
-                    ws->onClientOpenConnectionRequest();
-                    delete *iter;
-                    iter = wsHelper->_subThreadWsMessageQueue->erase(iter);
-                } else {
-                    ++iter;
-                }
+        WsMessage msg;
+        while (wsHelper->_subThreadWsMessageQueue.try_dequeue(msg)) {
+            std::lock_guard<std::recursive_mutex> lk(instanceMutex);
+            // The instance may have been destroyed since the message was sent
+            if (websocketInstances == nullptr || std::find(websocketInstances->begin(), websocketInstances->end(), msg.ws) == websocketInstances->end()) {
+                continue;
+            }
+            if (msg.what == WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION) {
+                msg.ws->onClientOpenConnectionRequest();
+            } else if (msg.ws->_isEstablished) {
+                // Not before the connection is established, onConnectionOpened asks for it then
+                lws_callback_on_writable(msg.ws->_wsInstance);
             }
         }
-        wsHelper->_subThreadWsMessageQueueMutex.unlock();
-        // Cause delay 4ms for event WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION
-        lws_service(wsContext, 4);
+        // Returns as soon as there is network activity or lws_cancel_service is called
+        lws_service(wsContext, WS_SERVICE_TIMEOUT_MS);
     }
 }
 
@@ -449,7 +463,7 @@ void WsThreadHelper::onSubThreadStarted() {
 
 void WsThreadHelper::onSubThreadEnded() {
     if (wsContext != nullptr) {
-        lws_context_destroy(wsContext);
+        lws_context_destroy(wsContext.exchange(nullptr));
     }
 }
 
@@ -470,20 +484,12 @@ void WsThreadHelper::sendMessageToCocosThread(const std::function<void()> &cb) {
     cc::Application::getInstance()->getScheduler()->performFunctionInCocosThread(cb);
 }
 
-void WsThreadHelper::sendMessageToWebSocketThread(WsMessage *msg) {
-    std::lock_guard<std::mutex> lk(_subThreadWsMessageQueueMutex);
-    _subThreadWsMessageQueue->push_back(msg);
-}
-
-size_t WsThreadHelper::countBufferdBytes(const WebSocketImpl *ws) {
-    std::lock_guard<std::mutex> lk(_subThreadWsMessageQueueMutex);
-    size_t                      total = 0;
-    for (auto *msg : *_subThreadWsMessageQueue) {
-        if (msg->user == ws && msg->data && (msg->what == WS_MSG_TO_SUBTRHEAD_SENDING_STRING || msg->what == WS_MSG_TO_SUBTRHEAD_SENDING_BINARY)) {
-            total += msg->data->getRemain();
-        }
+void WsThreadHelper::sendMessageToWebSocketThread(const WsMessage &msg) {
+    _subThreadWsMessageQueue.enqueue(msg);
+    // Before the context is created the queue is drained by the first loop anyway
+    if (wsContext) {
+        lws_cancel_service(wsContext);
     }
-    return total;
 }
 
 void WsThreadHelper::joinWebSocketThread() const {
@@ -492,47 +498,6 @@ void WsThreadHelper::joinWebSocketThread() const {
     }
 }
 
-// Define a WebSocket frame
-class WebSocketFrame {
-public:
-    bool init(unsigned char *buf, ssize_t len) {
-        if (buf == nullptr && len > 0) {
-            return false;
-        }
-
-        if (!_data.empty()) {
-            LOGD("WebSocketFrame was initialized, should not init it again!\n");
-            return false;
-        }
-
-        _data.resize(LWS_PRE + len);
-        if (len > 0) {
-            std::copy(buf, buf + len, _data.begin() + LWS_PRE);
-        }
-
-        _payload       = _data.data() + LWS_PRE;
-        _payloadLength = len;
-        _frameLength   = len;
-        return true;
-    }
-
-    void update(ssize_t issued) {
-        _payloadLength -= issued;
-        _payload += issued;
-    }
-
-    unsigned char *getPayload() const { return _payload; }
-    ssize_t        getPayloadLength() const { return _payloadLength; }
-    ssize_t        getFrameLength() const { return _frameLength; }
-
-private:
-    unsigned char *_payload{nullptr};
-    ssize_t        _payloadLength{0};
-
-    ssize_t                    _frameLength{0};
-    std::vector<unsigned char> _data;
-};
-
 //
 
 void WebSocketImpl::closeAllConnections() {
@@ -596,6 +561,9 @@ WebSocketImpl::~WebSocketImpl() {
         }
     }
 
+    // The websocket thread doesn't touch this instance anymore once it's removed from the container
+    clearSendQueue();
+
     if (websocketInstances == nullptr || websocketInstances->empty()) {
         wsHelper->quitWebSocketThread();
         LOGD("before join ws thread\n");
@@ -655,10 +623,7 @@ bool WebSocketImpl::init(const cc::network::WebSocket::Delegate &delegate,
         isWebSocketThreadCreated = false;
     }
 
-    auto *msg = new (std::nothrow) WsMessage();
-    msg->what = WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION;
-    msg->user = this;
-    wsHelper->sendMessageToWebSocketThread(msg);
+    wsHelper->sendMessageToWebSocketThread({WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION, this});
 
     // fixed https://github.com/cocos2d/cocos2d-x/issues/17433
     // createWebSocketThread has to be after message WS_MSG_TO_SUBTHREAD_CREATE_CONNECTION was sent.
@@ -671,7 +636,7 @@ bool WebSocketImpl::init(const cc::network::WebSocket::Delegate &delegate,
 }
 
 size_t WebSocketImpl::getBufferedAmount() const {
-    return wsHelper->countBufferdBytes(this);
+    return _bufferedAmount.load(std::memory_order_relaxed);
 }
 
 std::string WebSocketImpl::getExtensions() const {
@@ -686,18 +651,7 @@ std::string WebSocketImpl::getExtensions() const {
 void WebSocketImpl::send(const std::string &message) {
     if (_readyState == cc::network::WebSocket::State::OPEN) {
         // In main thread
-        auto *data  = new (std::nothrow) cc::network::WebSocket::Data();
-        data->bytes = static_cast<char *>(malloc(message.length() + 1));
-        // Make sure the last byte is '\0'
-        data->bytes[message.length()] = '\0';
-        strcpy(data->bytes, message.c_str());
-        data->len = static_cast<ssize_t>(message.length());
-
-        auto *msg = new (std::nothrow) WsMessage();
-        msg->what = WS_MSG_TO_SUBTRHEAD_SENDING_STRING;
-        msg->data = data;
-        msg->user = this;
-        wsHelper->sendMessageToWebSocketThread(msg);
+        enqueueSendMessage(false, message.data(), message.length());
     } else {
         LOGD("Couldn't send message since websocket wasn't opened!\n");
     }
@@ -706,27 +660,38 @@ void WebSocketImpl::send(const std::string &message) {
 void WebSocketImpl::send(const unsigned char *binaryMsg, unsigned int len) {
     if (_readyState == cc::network::WebSocket::State::OPEN) {
         // In main thread
-        auto *data = new (std::nothrow) cc::network::WebSocket::Data();
-        if (len == 0) {
-            // If data length is zero, allocate 1 byte for safe.
-            data->bytes    = static_cast<char *>(malloc(1));
-            data->bytes[0] = '\0';
-        } else {
-            data->bytes = static_cast<char *>(malloc(len));
-            memcpy(data->bytes, binaryMsg, len);
-        }
-        data->len = len;
-
-        auto *msg = new (std::nothrow) WsMessage();
-        msg->what = WS_MSG_TO_SUBTRHEAD_SENDING_BINARY;
-        msg->data = data;
-        msg->user = this;
-        wsHelper->sendMessageToWebSocketThread(msg);
+        enqueueSendMessage(true, binaryMsg, len);
     } else {
         LOGD("Couldn't send message since websocket wasn't opened!\n");
     }
 }
 
+void WebSocketImpl::enqueueSendMessage(bool isBinary, const void *data, size_t len) {
+    auto *msg = new (std::nothrow) WsSendMessage(isBinary, data, len);
+    _bufferedAmount.fetch_add(len, std::memory_order_relaxed);
+    _sendQueue.enqueue(msg);
+    requestWritable();
+}
+
+void WebSocketImpl::requestWritable() {
+    // Pairs with the fence in onClientWritable, either the websocket thread sees the new message
+    // or this thread sees the flag cleared and asks for another writable callback.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (wsHelper != nullptr && !_writableRequested.exchange(true)) {
+        wsHelper->sendMessageToWebSocketThread({WS_MSG_TO_SUBTHREAD_REQUEST_WRITABLE, this});
+    }
+}
+
+void WebSocketImpl::clearSendQueue() {
+    delete _sendingMessage;
+    _sendingMessage = nullptr;
+    WsSendMessage *msg = nullptr;
+    while (_sendQueue.try_dequeue(msg)) {
+        delete msg;
+    }
+    _bufferedAmount = 0;
+}
+
 void WebSocketImpl::close() {
     if (_closeState != CloseState::NONE) {
         LOGD("close was invoked, don't invoke it again!\n");
@@ -749,6 +714,8 @@ void WebSocketImpl::close() {
         _readyState = cc::network::WebSocket::State::CLOSING;
         _readyStateMutex.unlock();
     }
+    // Closing is done in the next writable callback
+    requestWritable();
 
     {
         std::unique_lock<std::mutex> lkClose(_closeMutex);
@@ -782,6 +749,8 @@ void WebSocketImpl::closeAsync() {
     }
 
     _readyState = cc::network::WebSocket::State::CLOSING;
+    // Closing is done in the next writable callback
+    requestWritable();
 }
 
 cc::network::WebSocket::State WebSocketImpl::getReadyState() const {
@@ -948,130 +917,60 @@ int WebSocketImpl::onClientWritable() {
         }
     }
 
-    do {
-        std::lock_guard<std::mutex> lk(wsHelper->_subThreadWsMessageQueueMutex);
+    _writableRequested = false;
 
-        if (wsHelper->_subThreadWsMessageQueue->empty()) {
+    // Small messages are written back to back instead of waiting for a writable callback each,
+    // large ones go out one fragment per callback so other connections are served in between.
+    size_t written = 0;
+    while (written < WS_WRITE_BATCH_SIZE) {
+        if (_sendingMessage == nullptr && !_sendQueue.try_dequeue(_sendingMessage)) {
             break;
         }
-
-        auto iter = wsHelper->_subThreadWsMessageQueue->begin();
-
-        while (iter != wsHelper->_subThreadWsMessageQueue->end()) {
-            WsMessage *msg = *iter;
-            if (msg->user == this) {
-                break;
-            }
-            ++iter;
+        if (written > 0 && lws_send_pipe_choked(_wsInstance)) {
+            break;
         }
 
-        ssize_t bytesWrite = 0;
-        if (iter != wsHelper->_subThreadWsMessageQueue->end()) {
-            WsMessage *subThreadMsg = *iter;
-
-            auto *data = subThreadMsg->data;
-
-            const ssize_t cBufferSize = WS_RX_BUFFER_SIZE;
-
-            const ssize_t remaining = data->len - data->issued;
-            const ssize_t n         = std::min(remaining, cBufferSize);
-
-            WebSocketFrame *frame = nullptr;
-
-            if (data->ext) {
-                frame = static_cast<WebSocketFrame *>(data->ext);
-            } else {
-                frame        = new (std::nothrow) WebSocketFrame();
-                bool success = frame && frame->init(reinterpret_cast<unsigned char *>(data->bytes + data->issued), n);
-                if (success) {
-                    data->ext = frame;
-                } else { // If frame initialization failed, delete the frame and drop the sending data
-                         // These codes should never be called.
-                    LOGD("WebSocketFrame initialization failed, drop the sending data, msg(%d)\n", (int)subThreadMsg->id);
-                    delete frame;
-                    CC_SAFE_FREE(data->bytes);
-                    CC_SAFE_DELETE(data);
-                    wsHelper->_subThreadWsMessageQueue->erase(iter);
-                    CC_SAFE_DELETE(subThreadMsg);
-                    break;
-                }
-            }
-
-            int writeProtocol;
-
-            if (data->issued == 0) {
-                if (WS_MSG_TO_SUBTRHEAD_SENDING_STRING == subThreadMsg->what) {
-                    writeProtocol = LWS_WRITE_TEXT;
-                } else {
-                    writeProtocol = LWS_WRITE_BINARY;
-                }
-
-                // If we have more than 1 fragment
-                if (data->len > cBufferSize) {
-                    writeProtocol |= LWS_WRITE_NO_FIN;
-                }
-            } else {
-                // we are in the middle of fragments
-                writeProtocol = LWS_WRITE_CONTINUATION;
-                // and if not in the last fragment
-                if (remaining != n) {
-                    writeProtocol |= LWS_WRITE_NO_FIN;
-                }
-            }
-
-            bytesWrite = lws_write(_wsInstance, frame->getPayload(), frame->getPayloadLength(), static_cast<lws_write_protocol>(writeProtocol));
-
-            // Handle the result of lws_write
-            // Buffer overrun?
-            if (bytesWrite < 0) {
-                LOGD("ERROR: msg(%u), lws_write return: %d, but it should be %d, drop this message.\n", subThreadMsg->id, (int)bytesWrite, (int)n);
-                // socket error, we need to close the socket connection
-                CC_SAFE_FREE(data->bytes);
-                delete (static_cast<WebSocketFrame *>(data->ext));
-                data->ext = nullptr;
-                CC_SAFE_DELETE(data);
-                wsHelper->_subThreadWsMessageQueue->erase(iter);
-                CC_SAFE_DELETE(subThreadMsg);
-
-                closeAsync();
-            } else if (bytesWrite < frame->getPayloadLength()) {
-                frame->update(bytesWrite);
-                LOGD("frame wasn't sent completely, bytesWrite: %d, remain: %d\n", (int)bytesWrite, (int)frame->getPayloadLength());
-            }
-            // Do we have another fragments to send?
-            else if (remaining > frame->getFrameLength() && bytesWrite == frame->getPayloadLength()) {
-                // A frame was totally sent, plus data->issued to send next frame
-                LOGD("msg(%u) append: %d + %d = %d\n", subThreadMsg->id, (int)data->issued, (int)frame->getFrameLength(), (int)(data->issued + frame->getFrameLength()));
-                data->issued += frame->getFrameLength();
-                delete (static_cast<WebSocketFrame *>(data->ext));
-                data->ext = nullptr;
-            }
-            // Safely done!
-            else {
-                LOGD("Safely done, msg(%d)!\n", subThreadMsg->id);
-                if (remaining == frame->getFrameLength()) {
-                    LOGD("msg(%u) append: %d + %d = %d\n", subThreadMsg->id, (int)data->issued, (int)frame->getFrameLength(), (int)(data->issued + frame->getFrameLength()));
-                    LOGD("msg(%u) was totally sent!\n", subThreadMsg->id);
-                } else {
-                    LOGD("ERROR: msg(%u), remaining(%d) < bytesWrite(%d)\n", subThreadMsg->id, (int)remaining, (int)frame->getFrameLength());
-                    LOGD("Drop the msg(%u)\n", subThreadMsg->id);
-                    closeAsync();
-                }
+        WsSendMessage *msg       = _sendingMessage;
+        const size_t   remaining = msg->length - msg->issued;
+        const size_t   n         = std::min(remaining, static_cast<size_t>(WS_RX_BUFFER_SIZE));
 
-                CC_SAFE_FREE(data->bytes);
-                delete (static_cast<WebSocketFrame *>(data->ext));
-                data->ext = nullptr;
-                CC_SAFE_DELETE(data);
-                wsHelper->_subThreadWsMessageQueue->erase(iter);
-                CC_SAFE_DELETE(subThreadMsg);
+        int writeProtocol;
+        if (msg->issued == 0) {
+            writeProtocol = msg->isBinary ? LWS_WRITE_BINARY : LWS_WRITE_TEXT;
+        } else {
+            // we are in the middle of fragments
+            writeProtocol = LWS_WRITE_CONTINUATION;
+        }
+        // If not in the last fragment
+        if (remaining != n) {
+            writeProtocol |= LWS_WRITE_NO_FIN;
+        }
 
-                LOGD("-----------------------------------------------------------\n");
-            }
+        // The frame header goes into the LWS_PRE bytes in front of the payload, for a continuation
+        // they belong to the previous fragment which has been sent already.
+        // libwebsockets buffers partial writes itself, a fragment is done unless lws_write fails.
+        int bytesWrite = lws_write(_wsInstance, msg->payload() + msg->issued, n, static_cast<lws_write_protocol>(writeProtocol));
+        if (bytesWrite < 0) {
+            LOGD("ERROR: lws_write return: %d, but it should be %d, drop this message.\n", bytesWrite, (int)n);
+            // socket error, we need to close the socket connection
+            _bufferedAmount.fetch_sub(remaining, std::memory_order_relaxed);
+            delete msg;
+            _sendingMessage = nullptr;
+            closeAsync();
+            break;
         }
 
-    } while (false);
+        msg->issued += n;
+        written += n;
+        _bufferedAmount.fetch_sub(n, std::memory_order_relaxed);
+        if (msg->issued == msg->length) {
+            delete msg;
+            _sendingMessage = nullptr;
+        }
+    }
 
-    if (_wsInstance != nullptr) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if ((_sendingMessage != nullptr || _sendQueue.size_approx() > 0) && !_writableRequested.exchange(true)) {
         lws_callback_on_writable(_wsInstance);
     }
 
@@ -1137,6 +1036,7 @@ int WebSocketImpl::onConnectionOpened() {
     const lws_protocols *lwsSelectedProtocol = lws_get_protocol(_wsInstance);
     _selectedProtocol                        = lwsSelectedProtocol->name;
     LOGD("onConnectionOpened...: %p, client protocols: %s, server selected protocol: %s\n", this, _clientSupportedProtocols.c_str(), _selectedProtocol.c_str());
+    _isEstablished = true;
     /*
      * start the ball rolling,
      * LWS_CALLBACK_CLIENT_WRITEABLE will come next service
@@ -1248,7 +1148,9 @@ int WebSocketImpl::onSocketCallback(struct lws * /*wsi*/, enum lws_callback_reas
             break;
 
         case LWS_CALLBACK_WSI_DESTROY:
-            ret = onConnectionClosed();
+            ret            = onConnectionClosed();
+            _wsInstance    = nullptr;
+            _isEstablished = false;
             break;
 
         case LWS_CALLBACK_CLIENT_RECEIVE:
@@ -38,6 +38,8 @@
 
     #define MAX_MSG_PAYLOAD 2048
     #define SEND_BUFF       1024
+    // bytes written to one connection per writable callback, so others on the same service thread get their turn
+    #define SEND_BATCH      (64 * 1024)
 
 namespace {
 
@@ -120,6 +122,13 @@ namespace network {
             });                                                          \
         } while (0)
 
+    #define RUN_IN_CONNECTION_THREAD(task) \
+        do {                               \
+            scheduleTask([=]() {           \
+                task;                      \
+            });                            \
+        } while (0)
+
     //#define LOGE() CCLOG("WSS: %s", __FUNCTION__)
     #define LOGE()
 
@@ -176,6 +185,8 @@ bool WebSocketServer::close(std::function<void(const std::string &errorMsg)> cal
     }
     _serverState.store(ServerThreadState::STOPPED);
     _onclose_cb = callback;
+    // lws_libuv_stop closes the connections of every service thread from this one, so the others have to be idle
+    stopServiceThreads();
     if (_ctx)
         lws_libuv_stop(_ctx);
     return true;
@@ -226,6 +237,7 @@ void WebSocketServer::listen(std::shared_ptr<WebSocketServer> server, int port,
     info.timeout_secs = 60; //
     info.max_http_header_pool = 1;
     info.user = server.get();
+    info.count_threads = server->_serviceThreadCount;
 
     server->_ctx = lws_create_context(&info);
 
@@ -238,25 +250,40 @@ void WebSocketServer::listen(std::shared_ptr<WebSocketServer> server, int port,
         server->_serverLock.unlock();
         return;
     }
-    uv_loop_t *loop = nullptr;
-    if (lws_uv_initloop(server->_ctx, loop, 0)) {
-        if (callback) {
-            RUN_IN_GAMETHREAD(callback("Error: Failed to create libuv loop!"));
+    // libwebsockets may run fewer service threads than asked for
+    int threadCount = lws_get_count_threads(server->_ctx);
+    for (int tsi = 0; tsi < threadCount; ++tsi) {
+        uv_loop_t *loop = nullptr;
+        if (lws_uv_initloop(server->_ctx, loop, tsi)) {
+            if (callback) {
+                RUN_IN_GAMETHREAD(callback("Error: Failed to create libuv loop!"));
+            }
+            RUN_IN_GAMETHREAD(if (server->_onerror) server->_onerror("websocket listen error, failed to create libuv loop!"));
+            server->_serverState = ServerThreadState::ST_ERROR;
+            server->_serverLock.unlock();
+            server->destroyContext();
+            return;
         }
-        RUN_IN_GAMETHREAD(if (server->_onerror) server->_onerror("websocket listen error, failed to create libuv loop!"));
-        server->_serverState = ServerThreadState::ST_ERROR;
-        server->_serverLock.unlock();
-        server->destroyContext();
-        return;
     }
 
-    loop = lws_uv_getloop(server->_ctx, 0);
-    init_libuv_async_handle(loop, &server->_async);
+    init_libuv_async_handle(lws_uv_getloop(server->_ctx, 0), &server->_async);
+    for (int tsi = 1; tsi < threadCount; ++tsi) {
+        auto service = std::make_unique<ServiceThread>();
+        init_libuv_async_handle(lws_uv_getloop(server->_ctx, tsi), &service->async);
+        server->_serviceThreads.emplace_back(std::move(service));
+    }
     RUN_IN_GAMETHREAD(if (server->_onlistening) server->_onlistening(""));
     RUN_IN_GAMETHREAD(if (server->_onbegin) server->_onbegin());
     RUN_IN_GAMETHREAD(if (callback) callback(""));
 
+    lws_context *ctx = server->_ctx;
+    for (int tsi = 1; tsi < threadCount; ++tsi) {
+        server->_serviceThreads[tsi - 1]->thread = std::thread([ctx, tsi]() {
+            lws_libuv_run(ctx, tsi);
+        });
+    }
     lws_libuv_run(server->_ctx, 0);
+    server->stopServiceThreads();
     uv_close((uv_handle_t *)&server->_async, nullptr);
 
     RUN_IN_GAMETHREAD(if (server->_onclose) server->_onclose(""));
@@ -283,6 +310,46 @@ std::vector<std::shared_ptr<WebSocketServerConnection>> WebSocketServer::getConn
     return ret;
 }
 
+void WebSocketServer::broadcastTextAsync(const std::string &text) {
+    broadcast(std::make_shared<DataFrame>(text));
+}
+
+void WebSocketServer::broadcastBinaryAsync(const void *data, size_t len) {
+    broadcast(std::make_shared<DataFrame>(data, len));
+}
+
+void WebSocketServer::broadcast(const std::shared_ptr<DataFrame> &frame) {
+    // Not under _connsMtx, sending may close a connection which looks itself up in _conns
+    for (auto &conn : getConnections()) {
+        if (conn->getReadyState() == WebSocketServerConnection::OPEN) {
+            conn->sendFrameAsync(frame);
+        }
+    }
+}
+
+uv_async_t *WebSocketServer::getServiceAsync(int tsi) {
+    return tsi == 0 ? &_async : &_serviceThreads[tsi - 1]->async;
+}
+
+// run in service thread 0
+void WebSocketServer::stopServiceThreads() {
+    for (auto &service : _serviceThreads) {
+        if (!service->thread.joinable()) {
+            continue;
+        }
+        uv_async_t *async = &service->async;
+        schedule_task_into_server_thread_task_queue(async, [async]() {
+            uv_close((uv_handle_t *)async, nullptr);
+            uv_stop(async->loop);
+        });
+    }
+    for (auto &service : _serviceThreads) {
+        if (service->thread.joinable()) {
+            service->thread.join();
+        }
+    }
+}
+
 void WebSocketServer::onCreateClient(struct lws *wsi) {
     LOGE();
     std::shared_ptr<WebSocketServerConnection> conn = std::make_shared<WebSocketServerConnection>(wsi);
@@ -377,34 +444,61 @@ void WebSocketServer::destroyContext() {
         delete (AsyncTaskData *)_async.data;
         _async.data = nullptr;
     }
+    for (auto &service : _serviceThreads) {
+        delete (AsyncTaskData *)service->async.data;
+    }
+    _serviceThreads.clear();
 }
 
 WebSocketServerConnection::WebSocketServerConnection(struct lws *wsi) : _wsi(wsi) {
-    uv_loop_t *loop = lws_uv_getloop(lws_get_context(wsi), 0);
-    init_libuv_async_handle(loop, &_async);
+    // Created by the thread accepting the connection, which may not be the one servicing it,
+    // so tasks go through the queue of the owning service thread.
+    auto *server = static_cast<WebSocketServer *>(lws_context_user(lws_get_context(wsi)));
+    _async = server->getServiceAsync(lws_get_tsi(wsi));
 }
 
 WebSocketServerConnection::~WebSocketServerConnection() {
-    if (_async.data) {
-        delete (AsyncTaskData *)_async.data;
-        _async.data = nullptr;
-    }
     CC_LOG_INFO("~destroy ws connection");
 }
 
+void WebSocketServerConnection::scheduleTask(std::function<void()> task) {
+    if (_readyState == ReadyState::CLOSED) {
+        // the service thread may be gone already
+        return;
+    }
+    schedule_task_into_server_thread_task_queue(_async, std::move(task));
+}
+
 bool WebSocketServerConnection::send(std::shared_ptr<DataFrame> data) {
+    if (_readyState == ReadyState::CLOSED) {
+        dropFrame(data, "Connection Closed");
+        return false;
+    }
+    auto * server     = _wsi ? static_cast<WebSocketServer *>(lws_context_user(lws_get_context(_wsi))) : nullptr;
+    size_t maxBacklog = server ? server->getMaxBacklogBytes() : 0;
+    if (maxBacklog > 0 && _backlogBytes >= maxBacklog) {
+        dropFrame(data, "Send buffer full");
+        return false;
+    }
     _sendQueue.emplace_back(data);
+    _backlogFrames++;
+    _backlogBytes += data->size();
     onDrainData();
     return true;
 }
 
+void WebSocketServerConnection::dropFrame(const std::shared_ptr<DataFrame> &frame, const std::string &reason) {
+    _droppedFrames++;
+    frame->onFinish(reason);
+}
+
 void WebSocketServerConnection::sendTextAsync(const std::string &text, std::function<void(const std::string &)> callback) {
     LOGE();
     std::shared_ptr<DataFrame> data = std::make_shared<DataFrame>(text);
     if (callback) {
         DISPATCH_CALLBACK_IN_GAMETHREAD();
     }
-    RUN_IN_SERVERTHREAD(this->send(data));
+    sendFrameAsync(data);
 }
 
 void WebSocketServerConnection::sendBinaryAsync(const void *in, size_t len, std::function<void(const std::string &)> callback) {
@@ -413,7 +507,24 @@ void WebSocketServerConnection::sendBinaryAsync(const void *in, size_t len, std:
     if (callback) {
         DISPATCH_CALLBACK_IN_GAMETHREAD();
     }
-    RUN_IN_SERVERTHREAD(this->send(data));
+    sendFrameAsync(data);
+}
+
+void WebSocketServerConnection::sendFrameAsync(std::shared_ptr<DataFrame> frame) {
+    if (_readyState == ReadyState::CLOSED) {
+        dropFrame(frame, "Connection Closed");
+        return;
+    }
+    RUN_IN_CONNECTION_THREAD(this->send(frame));
+}
+
+WebSocketServerConnection::SendStats WebSocketServerConnection::getSendStats() const {
+    SendStats stats;
+    stats.backlogFrames = _backlogFrames;
+    stats.backlogBytes  = _backlogBytes;
+    stats.sentFrames    = _sentFrames;
+    stats.droppedFrames = _droppedFrames;
+    return stats;
 }
 
 bool WebSocketServerConnection::close(int code, std::string message) {
@@ -428,7 +539,7 @@ bool WebSocketServerConnection::close(int code, std::string message) {
 }
 
 void WebSocketServerConnection::closeAsync(int code, std::string message) {
-    RUN_IN_SERVERTHREAD(this->close(code, message));
+    RUN_IN_CONNECTION_THREAD(this->close(code, message));
 }
 
 void WebSocketServerConnection::onConnected() {
@@ -469,53 +580,57 @@ int WebSocketServerConnection::onDrainData() {
         return -1;
     }
     if (_readyState != ReadyState::OPEN) return 0;
-    unsigned char *p = nullptr;
-    int send_len = 0;
-    int finish_len = 0;
-    int flags = 0;
 
-    std::vector<char> buff(SEND_BUFF + LWS_PRE);
+    // Frames may be shared by connections of other service threads, while lws_write writes the
+    // frame header into the LWS_PRE bytes in front of what it sends, so fragments are staged here.
+    if (_sendBuffer.empty()) {
+        _sendBuffer.resize(SEND_BUFF + LWS_PRE);
+    }
+    unsigned char *p       = _sendBuffer.data() + LWS_PRE;
+    int            written = 0;
 
-    if (!_sendQueue.empty()) {
-        std::shared_ptr<DataFrame> frag = _sendQueue.front();
+    while (!_sendQueue.empty() && written < SEND_BATCH && !lws_send_pipe_choked(_wsi)) {
+        std::shared_ptr<DataFrame> &frag = _sendQueue.front();
 
-        send_len = frag->slice(&p, SEND_BUFF);
+        int send_len = std::min(frag->size() - _sendOffset, SEND_BUFF);
+        int flags    = 0;
 
-        if (frag->isFront()) {
-            if (frag->isBinary()) {
-                flags |= LWS_WRITE_BINARY;
-            }
-            if (frag->isString()) {
-                flags |= LWS_WRITE_TEXT;
-            }
+        if (_sendOffset == 0) {
+            flags |= frag->isBinary() ? LWS_WRITE_BINARY : LWS_WRITE_TEXT;
+        } else {
+            flags |= LWS_WRITE_CONTINUATION;
         }
 
-        if (frag->remain() != send_len) {
+        if (_sendOffset + send_len < frag->size()) {
             // remain bytes > 0
             // not FIN
             flags |= LWS_WRITE_NO_FIN;
         }
 
-        if (!frag->isFront()) {
-            flags |= LWS_WRITE_CONTINUATION;
-        }
-
-        finish_len = lws_write(_wsi, p, send_len, (lws_write_protocol)flags);
+        memcpy(p, frag->getData() + _sendOffset, send_len);
+        int finish_len = lws_write(_wsi, p, send_len, (lws_write_protocol)flags);
 
-        if (finish_len == 0) {
+        if (finish_len == 0 && send_len > 0) {
             frag->onFinish("Connection Closed");
             return -1;
         } else if (finish_len < 0) {
             frag->onFinish("Send Error!");
             return -1;
-        } else {
-            frag->consume(finish_len);
         }
+        _sendOffset += finish_len;
+        _backlogBytes -= finish_len;
+        written += finish_len;
 
-        if (frag->remain() == 0) {
+        if (_sendOffset >= frag->size()) {
             frag->onFinish("");
             _sendQueue.pop_front();
+            _sendOffset = 0;
+            _backlogFrames--;
+            _sentFrames++;
         }
+    }
+
+    if (!_sendQueue.empty()) {
         lws_callback_on_writable(_wsi);
     }
 
@@ -569,8 +684,13 @@ void WebSocketServerConnection::onDestroyClient() {
     if (_wsi) {
         RUN_IN_GAMETHREAD(if (_onclose) _onclose(_closeCode, _closeReason));
         RUN_IN_GAMETHREAD(if (_onend) _onend());
-        uv_close((uv_handle_t *)&_async, nullptr);
     }
+    for (auto &frame : _sendQueue) {
+        dropFrame(frame, "Connection Closed");
+    }
+    _backlogFrames = 0;
+    _backlogBytes  = 0;
+    _sendQueue.clear();
 }
 
 std::vector<std::string> WebSocketServerConnection::getProtocols() {
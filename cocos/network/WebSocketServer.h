@@ -87,7 +87,8 @@ public:
 
     std::string toString();
 
-    unsigned char *getData() { return _underlyingData.data() + LWS_PRE; }
+    unsigned char *      getData() { return _underlyingData.data() + LWS_PRE; }
+    const unsigned char *getData() const { return _underlyingData.data() + LWS_PRE; }
 
 private:
     std::vector<unsigned char>               _underlyingData;
@@ -112,6 +113,22 @@ public:
 
     void sendBinaryAsync(const void *, size_t len, std::function<void(const std::string &)> callback);
 
+    /**
+     * Queue a frame which may be shared with other connections, see WebSocketServer::broadcastTextAsync.
+     * The frame is never modified while being sent, its callback is called once per connection.
+     */
+    void sendFrameAsync(std::shared_ptr<DataFrame> frame);
+
+    struct SendStats {
+        uint32_t backlogFrames{0}; // queued frames, including the one being written
+        uint64_t backlogBytes{0};  // bytes of the queued frames not written yet
+        uint64_t sentFrames{0};
+        uint64_t droppedFrames{0}; // frames discarded since the backlog was full or the connection was gone
+    };
+
+    /** Thread safe */
+    SendStats getSendStats() const;
+
     void closeAsync(int code, std::string reasson);
 
     /** stream is not implemented*/
@@ -169,6 +186,8 @@ public:
 private:
     bool send(std::shared_ptr<DataFrame> data);
     bool close(int code, std::string reasson);
+    void scheduleTask(std::function<void()> task);
+    void dropFrame(const std::shared_ptr<DataFrame> &frame, const std::string &reason);
 
     inline void scheduleSend() {
         if (_wsi)
@@ -186,11 +205,17 @@ private:
     struct lws *                          _wsi = nullptr;
     std::map<std::string, std::string>    _headers;
     std::list<std::shared_ptr<DataFrame>> _sendQueue;
+    int                                   _sendOffset = 0; // bytes of the front frame written
+    std::vector<unsigned char>            _sendBuffer;     // LWS_PRE + SEND_BUFF, fragments are staged here
     std::shared_ptr<DataFrame>            _prevPkg;
     bool                                  _closed      = false;
     std::string                           _closeReason = "close connection";
     int                                   _closeCode   = 1000;
     std::atomic<ReadyState>               _readyState{ReadyState::CLOSED};
+    std::atomic<uint32_t>                 _backlogFrames{0};
+    std::atomic<uint64_t>                 _backlogBytes{0};
+    std::atomic<uint64_t>                 _sentFrames{0};
+    std::atomic<uint64_t>                 _droppedFrames{0};
 
     // Attention: do not reference **this** in callbacks
     std::function<void(int, const std::string &)>   _onclose;
@@ -200,7 +225,7 @@ private:
     std::function<void(std::shared_ptr<DataFrame>)> _ondata;
     std::function<void()>                           _onconnect;
     std::function<void()>                           _onend;
-    uv_async_t                                      _async = {0};
+    uv_async_t *                                    _async = nullptr; // task queue of the service thread owning _wsi
     void *                                          _data  = nullptr;
 
     friend class WebSocketServer;
@@ -216,6 +241,30 @@ public:
 
     std::vector<std::shared_ptr<WebSocketServerConnection>> getConnections() const;
 
+    /**
+     * Send a text frame to every open connection. The payload is copied once and shared by all of them.
+     */
+    void broadcastTextAsync(const std::string &text);
+
+    /**
+     * Send a binary frame to every open connection. The payload is copied once and shared by all of them.
+     */
+    void broadcastBinaryAsync(const void *data, size_t len);
+
+    /**
+     * Service connections on `count` threads, each new connection goes to the least busy one.
+     * Takes effect on the next listen, it's clamped to LWS_MAX_SMP of the libwebsockets build. 1 by default.
+     */
+    void     setServiceThreadCount(uint32_t count) { _serviceThreadCount = std::max(count, 1U); }
+    uint32_t getServiceThreadCount() const { return _serviceThreadCount; }
+
+    /**
+     * Frames sent to a connection which has at least `bytes` queued are dropped and counted in
+     * WebSocketServerConnection::getSendStats, so one slow client can't pile up memory. 0 for no limit (default).
+     */
+    void   setMaxBacklogBytes(size_t bytes) { _maxBacklogBytes = bytes; }
+    size_t getMaxBacklogBytes() const { return _maxBacklogBytes; }
+
     void setOnListening(std::function<void(const std::string &)> cb) {
         _onlistening = cb;
     }
@@ -258,11 +307,24 @@ protected:
 private:
     std::shared_ptr<WebSocketServerConnection> findConnection(struct lws *wsi);
     void                                       destroyContext();
+    void                                       broadcast(const std::shared_ptr<DataFrame> &frame);
+    uv_async_t *                               getServiceAsync(int tsi);
+    void                                       stopServiceThreads();
+
+    // service threads beyond the listening one, which runs service thread 0
+    struct ServiceThread {
+        std::thread thread;
+        uv_async_t  async = {0};
+    };
 
     std::string  _host;
     lws_context *_ctx   = nullptr;
     uv_async_t   _async = {0};
 
+    std::vector<std::unique_ptr<ServiceThread>> _serviceThreads;
+    std::atomic<uint32_t>                       _serviceThreadCount{1};
+    std::atomic<size_t>                         _maxBacklogBytes{0};
+
     mutable std::mutex                                                           _connsMtx;
     std::unordered_map<struct lws *, std::shared_ptr<WebSocketServerConnection>> _conns;
 
@@ -286,6 +348,8 @@ private:
     std::mutex                     _serverLock;
     void *                         _data = nullptr;
 
+    friend class WebSocketServerConnection;
+
 public:
     static int _websocketServerCallback(struct lws *wsi, enum lws_callback_reasons reason,
                                         void *user, void *in, size_t len);
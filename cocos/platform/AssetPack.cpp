@@ -0,0 +1,205 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/AssetPack.h"
+
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+
+#include "base/Log.h"
+#include "platform/FileUtils.h"
+
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace cc {
+
+uint64_t AssetPack::hashPath(const char *path, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(path[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+AssetPack *AssetPack::open(const std::string &fullPath) {
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    int length = MultiByteToWideChar(CP_UTF8, 0, fullPath.c_str(), -1, nullptr, 0);
+    std::wstring widePath(length, 0);
+    MultiByteToWideChar(CP_UTF8, 0, fullPath.c_str(), -1, &widePath[0], length);
+
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    CloseHandle(file);
+    if (!mapping) return nullptr;
+
+    void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data) return nullptr;
+
+    return openWithMemory(static_cast<const unsigned char *>(data), static_cast<size_t>(fileSize.QuadPart), [data]() {
+        UnmapViewOfFile(data);
+    });
+#else
+    int fd = ::open(fullPath.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat statBuf;
+    if (fstat(fd, &statBuf) != 0 || statBuf.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    auto size = static_cast<size_t>(statBuf.st_size);
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) return nullptr;
+
+    return openWithMemory(static_cast<const unsigned char *>(data), size, [data, size]() {
+        munmap(data, size);
+    });
+#endif
+}
+
+AssetPack *AssetPack::openWithMemory(const unsigned char *data, size_t size, ReleaseCallback release) {
+    auto *pack = new AssetPack;
+    if (!pack->init(data, size, std::move(release))) {
+        delete pack;
+        return nullptr;
+    }
+    return pack;
+}
+
+AssetPack::~AssetPack() {
+    if (_release) _release();
+}
+
+bool AssetPack::init(const unsigned char *data, size_t size, ReleaseCallback release) {
+    // take ownership first so the mapping is released on failure too
+    _release = std::move(release);
+    _data = data;
+    _size = size;
+
+    if (size < sizeof(AssetPackHeader)) return false;
+    const auto *header = reinterpret_cast<const AssetPackHeader *>(data);
+    if (header->magic != ASSET_PACK_MAGIC || header->version != ASSET_PACK_VERSION || header->bucketBits > 24) {
+        CC_LOG_ERROR("AssetPack: invalid header");
+        return false;
+    }
+
+    const uint64_t bucketBytes = ((1ULL << header->bucketBits) + 1) * sizeof(uint32_t);
+    const uint64_t entryBytes = static_cast<uint64_t>(header->entryCount) * sizeof(AssetPackEntry);
+    // offsets come from the file, compare against the remaining size so the sums can't wrap
+    if (header->bucketOffset > size || bucketBytes > size - header->bucketOffset ||
+        header->entryOffset > size || entryBytes > size - header->entryOffset ||
+        header->nameOffset > size || header->nameSize > size - header->nameOffset ||
+        header->entryOffset % alignof(AssetPackEntry) ||
+        header->bucketOffset % alignof(uint32_t)) {
+        CC_LOG_ERROR("AssetPack: tables out of range");
+        return false;
+    }
+
+    const auto *entries = reinterpret_cast<const AssetPackEntry *>(data + header->entryOffset);
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        const AssetPackEntry &entry = entries[i];
+        if (entry.offset > size || entry.size > size - entry.offset ||
+            static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > header->nameSize) {
+            CC_LOG_ERROR("AssetPack: entry %u out of range", i);
+            return false;
+        }
+    }
+
+    _header = header;
+    _buckets = reinterpret_cast<const uint32_t *>(data + header->bucketOffset);
+    _entries = entries;
+    _names = reinterpret_cast<const char *>(data + header->nameOffset);
+    return true;
+}
+
+const AssetPackEntry *AssetPack::find(const std::string &path) const {
+    if (!_header || !_header->entryCount) return nullptr;
+
+    const uint64_t hash = hashPath(path.data(), path.size());
+    const uint64_t bucket = _header->bucketBits ? hash >> (64U - _header->bucketBits) : 0U;
+    const uint32_t end = std::min(_buckets[bucket + 1], _header->entryCount);
+    for (uint32_t i = _buckets[bucket]; i < end; ++i) {
+        const AssetPackEntry &entry = _entries[i];
+        if (entry.hash == hash && entry.nameLength == path.size() &&
+            !memcmp(_names + entry.nameOffset, path.data(), path.size())) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool AssetPack::getView(const AssetPackEntry *entry, const unsigned char **data, size_t *size) const {
+    if (entry->compression != AssetPackCompression::STORED) return false;
+    *data = _data + entry->offset;
+    *size = static_cast<size_t>(entry->size);
+    return true;
+}
+
+bool AssetPack::read(const AssetPackEntry *entry, ResizableBuffer *buffer) const {
+    const unsigned char *src = _data + entry->offset;
+    switch (entry->compression) {
+        case AssetPackCompression::STORED:
+            buffer->resize(static_cast<size_t>(entry->size));
+            if (entry->size) memcpy(buffer->buffer(), src, static_cast<size_t>(entry->size));
+            return true;
+        case AssetPackCompression::DEFLATE: {
+            buffer->resize(static_cast<size_t>(entry->rawSize));
+            auto destSize = static_cast<uLongf>(entry->rawSize);
+            int ret = uncompress(static_cast<Bytef *>(buffer->buffer()), &destSize, src, static_cast<uLong>(entry->size));
+            if (ret != Z_OK || destSize != entry->rawSize) {
+                CC_LOG_ERROR("AssetPack: failed to inflate %s", getEntryName(*entry).c_str());
+                return false;
+            }
+            return true;
+        }
+        default:
+            CC_LOG_ERROR("AssetPack: unsupported compression %u for %s", static_cast<uint32_t>(entry->compression), getEntryName(*entry).c_str());
+            return false;
+    }
+}
+
+std::string AssetPack::getEntryName(const AssetPackEntry &entry) const {
+    return std::string(_names + entry.nameOffset, entry.nameLength);
+}
+
+} // namespace cc
@@ -0,0 +1,150 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "base/Macros.h"
+
+namespace cc {
+
+class ResizableBuffer;
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * Read-only asset pack, see tools/asset-pack for the packer.
+ *
+ * Layout, little-endian:
+ *   AssetPackHeader
+ *   bucket table: (1 << bucketBits) + 1 uint32_t, the first entry index of each hash bucket
+ *   entry table: AssetPackEntry[entryCount], sorted by hash
+ *   name blob: normalized relative paths, not null-terminated
+ *   entry data, each entry aligned to 16 bytes, large entries to 4K pages
+ *
+ * Buckets are addressed by the top bits of the 64-bit FNV-1a hash of the path,
+ * so a lookup only compares the few entries sharing a bucket.
+ */
+constexpr uint32_t ASSET_PACK_MAGIC = 0x4B504343U; // "CCPK"
+constexpr uint32_t ASSET_PACK_VERSION = 1U;
+constexpr uint32_t ASSET_PACK_ALIGNMENT = 16U;
+constexpr uint32_t ASSET_PACK_PAGE_ALIGNMENT = 4096U;
+
+enum class AssetPackCompression : uint32_t {
+    STORED,
+    DEFLATE,
+    LZ4,  // reserved, not supported by this reader
+    ZSTD, // reserved, not supported by this reader
+};
+
+struct AssetPackHeader {
+    uint32_t magic{ASSET_PACK_MAGIC};
+    uint32_t version{ASSET_PACK_VERSION};
+    uint32_t entryCount{0};
+    uint32_t bucketBits{0};
+    uint64_t bucketOffset{0};
+    uint64_t entryOffset{0};
+    uint64_t nameOffset{0};
+    uint64_t nameSize{0};
+};
+
+struct AssetPackEntry {
+    uint64_t hash{0};
+    uint64_t offset{0};
+    uint64_t size{0};    // bytes stored in the pack
+    uint64_t rawSize{0}; // bytes after decompression
+    uint32_t nameOffset{0};
+    uint32_t nameLength{0};
+    AssetPackCompression compression{AssetPackCompression::STORED};
+    uint32_t reserved{0};
+};
+
+static_assert(sizeof(AssetPackHeader) == 48, "unexpected asset pack header size");
+static_assert(sizeof(AssetPackEntry) == 48, "unexpected asset pack entry size");
+
+class CC_DLL AssetPack final {
+public:
+    using ReleaseCallback = std::function<void()>;
+
+    static uint64_t hashPath(const char *path, size_t length);
+
+    /**
+     * Maps a pack file from the file system.
+     * @return nullptr if the file can't be mapped or isn't a valid pack.
+     */
+    static AssetPack *open(const std::string &fullPath);
+
+    /**
+     * Wraps pack data already in memory, e.g. an uncompressed asset mapped by the platform.
+     * @param release Invoked when the pack is destroyed, may be empty.
+     */
+    static AssetPack *openWithMemory(const unsigned char *data, size_t size, ReleaseCallback release);
+
+    ~AssetPack();
+
+    AssetPack(const AssetPack &) = delete;
+    AssetPack &operator=(const AssetPack &) = delete;
+
+    /** Finds an entry by its normalized relative path. */
+    const AssetPackEntry *find(const std::string &path) const;
+
+    /**
+     * Returns the mapped bytes of a stored entry without copying.
+     * The view stays valid as long as the pack is alive.
+     * @return false if the entry is compressed.
+     */
+    bool getView(const AssetPackEntry *entry, const unsigned char **data, size_t *size) const;
+
+    /** Copies or decompresses an entry into the buffer. */
+    bool read(const AssetPackEntry *entry, ResizableBuffer *buffer) const;
+
+    uint32_t getEntryCount() const { return _header ? _header->entryCount : 0; }
+    const AssetPackEntry &getEntry(uint32_t index) const { return _entries[index]; }
+    std::string getEntryName(const AssetPackEntry &entry) const;
+
+private:
+    AssetPack() = default;
+
+    bool init(const unsigned char *data, size_t size, ReleaseCallback release);
+
+    const unsigned char *_data{nullptr};
+    size_t _size{0};
+    const AssetPackHeader *_header{nullptr};
+    const uint32_t *_buckets{nullptr};
+    const AssetPackEntry *_entries{nullptr};
+    const char *_names{nullptr};
+    ReleaseCallback _release;
+};
+
+// end of platform group
+/** @} */
+
+} // namespace cc
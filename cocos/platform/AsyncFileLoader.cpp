@@ -0,0 +1,210 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/AsyncFileLoader.h"
+
+#include <algorithm>
+#include <map>
+
+#include "base/Scheduler.h"
+#include "platform/Application.h"
+
+namespace cc {
+
+AsyncFileLoader *AsyncFileLoader::instance = nullptr;
+
+AsyncFileLoader *AsyncFileLoader::getInstance() {
+    if (!instance) {
+        instance = new AsyncFileLoader(DEFAULT_THREAD_COUNT);
+    }
+    return instance;
+}
+
+void AsyncFileLoader::destroyInstance() {
+    delete instance;
+    instance = nullptr;
+}
+
+AsyncFileLoader::AsyncFileLoader(uint32_t threadCount) {
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        _workers.emplace_back(&AsyncFileLoader::workerLoop, this);
+    }
+}
+
+AsyncFileLoader::~AsyncFileLoader() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+        for (auto &it : _batches) it.second->cancelled = true;
+    }
+    _condition.notify_all();
+    for (auto &worker : _workers) worker.join();
+}
+
+uint32_t AsyncFileLoader::loadBatch(const std::vector<FileLoadRequest> &requests, Callback callback) {
+    auto batch = std::make_shared<Batch>();
+    batch->requests = requests;
+    batch->results.resize(requests.size());
+    batch->remaining = static_cast<uint32_t>(requests.size());
+    batch->callback = std::move(callback);
+
+    Task task;
+    task.batch = batch;
+    for (const auto &request : requests) {
+        task.priority = std::max(task.priority, request.priority);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        batch->id = _nextBatchId++;
+        _batches[batch->id] = batch;
+    }
+
+    if (requests.empty()) {
+        complete(batch);
+    } else {
+        push(std::move(task));
+    }
+    return batch->id;
+}
+
+void AsyncFileLoader::cancel(uint32_t batchId) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = _batches.find(batchId);
+    if (iter != _batches.end()) {
+        iter->second->cancelled = true;
+        _batches.erase(iter);
+    }
+}
+
+void AsyncFileLoader::push(Task &&task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        task.sequence = _nextSequence++;
+        _tasks.push(std::move(task));
+    }
+    _condition.notify_one();
+}
+
+void AsyncFileLoader::workerLoop() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this]() { return !_running || !_tasks.empty(); });
+            if (!_running) return;
+            task = std::move(const_cast<Task &>(_tasks.top()));
+            _tasks.pop();
+        }
+
+        if (task.batch->cancelled) continue;
+        if (task.indices.empty()) {
+            resolve(task);
+        } else {
+            read(task);
+        }
+    }
+}
+
+void AsyncFileLoader::resolve(const Task &task) {
+    const std::shared_ptr<Batch> &batch = task.batch;
+    FileUtils *fs = FileUtils::getInstance();
+
+    // group by directory, so that files living together are read back to back
+    std::map<std::string, Task> groups;
+    uint32_t missing = 0;
+    for (uint32_t i = 0; i < batch->requests.size(); ++i) {
+        const FileLoadRequest &request = batch->requests[i];
+        FileLoadResult &result = batch->results[i];
+        result.path = request.path;
+
+        std::string fullPath = request.path.empty() ? std::string() : fs->fullPathForFilename(request.path);
+        if (fullPath.empty()) {
+            result.status = FileUtils::Status::NotExists;
+            ++missing;
+            continue;
+        }
+
+        Task &group = groups[fullPath.substr(0, fullPath.rfind('/') + 1)];
+        group.batch = batch;
+        group.priority = std::max(group.priority, request.priority);
+        group.indices.push_back(i);
+        group.fullPaths.push_back(std::move(fullPath));
+    }
+
+    for (auto &it : groups) {
+        push(std::move(it.second));
+    }
+
+    // the last group may already be done, so account for missing files after queueing
+    if (missing && batch->remaining.fetch_sub(missing) == missing) {
+        complete(batch);
+    }
+}
+
+void AsyncFileLoader::read(const Task &task) {
+    const std::shared_ptr<Batch> &batch = task.batch;
+    FileUtils *fs = FileUtils::getInstance();
+
+    // higher priorities first within the group as well
+    std::vector<uint32_t> order(task.indices.size());
+    for (uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+        return batch->requests[task.indices[lhs]].priority > batch->requests[task.indices[rhs]].priority;
+    });
+
+    for (uint32_t i : order) {
+        if (batch->cancelled) return;
+        FileLoadResult &result = batch->results[task.indices[i]];
+        result.status = fs->getContents(task.fullPaths[i], &result.data);
+    }
+
+    const auto count = static_cast<uint32_t>(task.indices.size());
+    if (batch->remaining.fetch_sub(count) == count) {
+        complete(batch);
+    }
+}
+
+void AsyncFileLoader::complete(const std::shared_ptr<Batch> &batch) {
+    auto deliver = [this, batch]() {
+        // cancelled batches were already removed, as were all of them when the loader was destroyed
+        if (batch->cancelled) return;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _batches.erase(batch->id);
+        }
+        if (batch->callback) batch->callback(batch->results);
+    };
+
+    Application *app = Application::getInstance();
+    if (app && app->getScheduler()) {
+        app->getScheduler()->performFunctionInCocosThread(deliver);
+    } else {
+        // no application, e.g. in tools
+        deliver();
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,137 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/Data.h"
+#include "base/Macros.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+struct FileLoadRequest {
+    std::string path;
+    int priority{0}; // higher priorities are read first
+};
+
+struct FileLoadResult {
+    std::string path; // as requested
+    FileUtils::Status status{FileUtils::Status::NotExists};
+    Data data;
+};
+
+/**
+ * Reads batches of files on dedicated I/O threads.
+ *
+ * Paths are resolved on the I/O threads too, then requests are grouped by directory
+ * (or by directory inside an asset pack) so files that live together are read together.
+ * Groups run in priority order, and each batch completes with a single callback
+ * delivered on the cocos thread.
+ */
+class CC_DLL AsyncFileLoader final {
+public:
+    using Callback = std::function<void(std::vector<FileLoadResult> &results)>;
+
+    static constexpr uint32_t DEFAULT_THREAD_COUNT = 2U;
+
+    static AsyncFileLoader *getInstance();
+    static void destroyInstance();
+
+    /**
+     * Queues a batch of reads.
+     * @param callback Invoked on the cocos thread once every file of the batch was read,
+     *                 results are in the order of the requests.
+     * @return The batch id, can be used to cancel the batch.
+     */
+    uint32_t loadBatch(const std::vector<FileLoadRequest> &requests, Callback callback);
+
+    /** Drops a batch, files not read yet are skipped and the callback won't be invoked. */
+    void cancel(uint32_t batchId);
+
+private:
+    struct Batch {
+        uint32_t id{0};
+        std::vector<FileLoadRequest> requests;
+        std::vector<FileLoadResult> results;
+        std::atomic<uint32_t> remaining{0};
+        std::atomic<bool> cancelled{false};
+        Callback callback;
+    };
+
+    struct Task {
+        std::shared_ptr<Batch> batch;
+        std::vector<uint32_t> indices; // empty for the task resolving the batch
+        std::vector<std::string> fullPaths;
+        int priority{0};
+        uint64_t sequence{0};
+
+        // max-heap on priority, FIFO among equal priorities
+        bool operator<(const Task &rhs) const {
+            return priority < rhs.priority || (priority == rhs.priority && sequence > rhs.sequence);
+        }
+    };
+
+    explicit AsyncFileLoader(uint32_t threadCount);
+    ~AsyncFileLoader();
+
+    void workerLoop();
+    void push(Task &&task);
+    void resolve(const Task &task);
+    void read(const Task &task);
+    void complete(const std::shared_ptr<Batch> &batch);
+
+    static AsyncFileLoader *instance;
+
+    std::vector<std::thread> _workers;
+    std::priority_queue<Task> _tasks;
+    std::unordered_map<uint32_t, std::shared_ptr<Batch>> _batches;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    uint32_t _nextBatchId{1};
+    uint64_t _nextSequence{0};
+    bool _running{true};
+};
+
+// end of platform group
+/** @} */
+
+} // namespace cc
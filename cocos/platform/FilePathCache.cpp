@@ -0,0 +1,150 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/FilePathCache.h"
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace cc {
+
+class FilePathCache::ReadGuard final {
+public:
+    explicit ReadGuard(const FilePathCache *cache) {
+        uint32_t epoch = cache->_epoch.load(std::memory_order_acquire);
+        while (true) {
+            _slot = &cache->_readers[epoch & 1U];
+            _slot->fetch_add(1, std::memory_order_seq_cst);
+            const uint32_t current = cache->_epoch.load(std::memory_order_seq_cst);
+            if (current == epoch) break;
+            // a clear started in between, re-register under the new epoch
+            _slot->fetch_sub(1, std::memory_order_release);
+            epoch = current;
+        }
+    }
+    ~ReadGuard() { _slot->fetch_sub(1, std::memory_order_release); }
+
+private:
+    std::atomic<uint32_t> *_slot{nullptr};
+};
+
+FilePathCache::FilePathCache()
+: _buckets(new std::atomic<Node *>[BUCKET_COUNT]) {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        _buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+    _readers[0].store(0, std::memory_order_relaxed);
+    _readers[1].store(0, std::memory_order_relaxed);
+}
+
+FilePathCache::~FilePathCache() {
+    clear();
+}
+
+bool FilePathCache::find(const std::string &key, std::string *value) const {
+    const size_t hash = std::hash<std::string>{}(key);
+    ReadGuard    guard(this);
+
+    for (const Node *node = _buckets[hash & (BUCKET_COUNT - 1)].load(std::memory_order_acquire); node; node = node->next) {
+        if (node->hash == hash && node->key == key) {
+            if (value) *value = node->value;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FilePathCache::copyTo(std::unordered_map<std::string, std::string> *out) const {
+    ReadGuard guard(this);
+
+    out->clear();
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        for (const Node *node = _buckets[i].load(std::memory_order_acquire); node; node = node->next) {
+            out->emplace(node->key, node->value);
+        }
+    }
+}
+
+void FilePathCache::insert(const std::string &key, const std::string &value) {
+    insert(key, value, generation());
+}
+
+void FilePathCache::insert(const std::string &key, const std::string &value, uint32_t generation) {
+    const size_t                hash = std::hash<std::string>{}(key);
+    std::lock_guard<std::mutex> lock(_writeMutex);
+
+    if (_generation.load(std::memory_order_relaxed) != generation) return;
+
+    if (_size.load(std::memory_order_relaxed) >= MAX_ENTRIES) {
+        clearLocked();
+    }
+
+    std::atomic<Node *> &bucket = _buckets[hash & (BUCKET_COUNT - 1)];
+    Node *               head   = bucket.load(std::memory_order_relaxed);
+    for (const Node *node = head; node; node = node->next) {
+        if (node->hash == hash && node->key == key) return;
+    }
+
+    Node *node  = new Node;
+    node->hash  = hash;
+    node->key   = key;
+    node->value = value;
+    node->next  = head;
+    bucket.store(node, std::memory_order_release);
+    _size.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FilePathCache::clear() {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    _generation.fetch_add(1, std::memory_order_seq_cst);
+    clearLocked();
+}
+
+void FilePathCache::clearLocked() {
+    // chains are detached whole; readers may still be walking them, so nodes stay untouched until reclaimed
+    std::vector<Node *> detached;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        Node *head = _buckets[i].exchange(nullptr, std::memory_order_acq_rel);
+        if (head) detached.push_back(head);
+    }
+    _size.store(0, std::memory_order_relaxed);
+    if (detached.empty()) return;
+
+    const uint32_t oldEpoch = _epoch.fetch_add(1, std::memory_order_seq_cst);
+    while (_readers[oldEpoch & 1U].load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+
+    for (Node *node : detached) {
+        while (node) {
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,114 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "base/Macros.h"
+
+namespace cc {
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * Concurrent cache for resolved file paths.
+ *
+ * Lookups are lock-free and may run on any thread; insertions and clears are
+ * serialized by an internal mutex.
+ *
+ * Readers announce themselves in one of two epoch slots, so clear() can
+ * detach every chain and reclaim the nodes once no reader can still see them.
+ */
+class CC_DLL FilePathCache final {
+public:
+    static constexpr size_t BUCKET_COUNT = 4096U; // must be a power of two
+    static constexpr size_t MAX_ENTRIES  = 65536U;
+
+    FilePathCache();
+    ~FilePathCache();
+
+    FilePathCache(const FilePathCache &) = delete;
+    FilePathCache &operator=(const FilePathCache &) = delete;
+
+    /**
+     * Looks up a key without taking any lock.
+     * @param key The file name as passed to FileUtils.
+     * @param value Receives the cached full path.
+     * @return true if the key is cached.
+     */
+    bool find(const std::string &key, std::string *value) const;
+
+    /** Inserts an entry, keeping the existing one if the key is already cached. */
+    void insert(const std::string &key, const std::string &value);
+
+    /**
+     * Inserts an entry resolved while the cache was at 'generation', or drops it if the cache
+     * was cleared since, so a lookup racing with a clear can't bring back an outdated entry.
+     */
+    void insert(const std::string &key, const std::string &value, uint32_t generation);
+
+    /** Drops every entry. Blocks until concurrent readers have left the old entries. */
+    void clear();
+
+    /** Incremented by every clear(), read it before resolving an entry to insert. */
+    uint32_t generation() const { return _generation.load(std::memory_order_seq_cst); }
+
+    /** Copies every entry into a map, for callers of the legacy FileUtils::getFullPathCache(). */
+    void copyTo(std::unordered_map<std::string, std::string> *out) const;
+
+    size_t size() const { return _size.load(std::memory_order_relaxed); }
+
+private:
+    struct Node {
+        size_t      hash{0};
+        std::string key;
+        std::string value;
+        Node *      next{nullptr};
+    };
+
+    class ReadGuard;
+
+    void clearLocked();
+
+    std::unique_ptr<std::atomic<Node *>[]> _buckets;
+    std::atomic<size_t>                    _size{0};
+    std::atomic<uint32_t>                  _epoch{0};
+    std::atomic<uint32_t>                  _generation{0};
+    mutable std::atomic<uint32_t>          _readers[2];
+    std::mutex                             _writeMutex;
+};
+
+// end of platform group
+/** @} */
+
+} // namespace cc
@@ -31,6 +31,7 @@
 
 #include "base/Data.h"
 #include "base/Log.h"
+#include "base/ValueBinary.h"
 #include "platform/SAXParser.h"
 
 #include "tinyxml2/tinyxml2.h"
@@ -125,6 +126,17 @@ public:
         return _rootArray;
     }
 
+    ValueVector arrayWithDataOfFile(const char *filedata, int filesize) {
+        _resultType = SAX_RESULT_ARRAY;
+        SAXParser parser;
+
+        CCASSERT(parser.init("UTF-8"), "The file format isn't UTF-8");
+        parser.setDelegator(this);
+
+        parser.parse(filedata, filesize);
+        return _rootArray;
+    }
+
     virtual void startElement(void *ctx, const char *name, const char **atts) override {
         CC_UNUSED_PARAM(ctx);
         CC_UNUSED_PARAM(atts);
@@ -278,19 +290,30 @@ ValueMap FileUtils::getValueMapFromFile(const std::string &filename) {
         return ret;
     }
 
+    Data data = getDataFromFile(fullPath);
+    if (BinaryValueReader::isBinaryValue(data.getBytes(), data.getSize())) {
+        return BinaryValueReader(data.getBytes(), data.getSize()).getRoot().toValueMap();
+    }
     DictMaker tMaker;
-    return tMaker.dictionaryWithContentsOfFile(fullPath);
+    return tMaker.dictionaryWithDataOfFile(reinterpret_cast<const char *>(data.getBytes()), static_cast<int>(data.getSize()));
 }
 
 ValueMap FileUtils::getValueMapFromData(const char *filedata, int filesize) {
+    if (BinaryValueReader::isBinaryValue(filedata, filesize)) {
+        return BinaryValueReader(filedata, filesize).getRoot().toValueMap();
+    }
     DictMaker tMaker;
     return tMaker.dictionaryWithDataOfFile(filedata, filesize);
 }
 
 ValueVector FileUtils::getValueVectorFromFile(const std::string &filename) {
     const std::string fullPath = fullPathForFilename(filename);
+    Data data = getDataFromFile(fullPath);
+    if (BinaryValueReader::isBinaryValue(data.getBytes(), data.getSize())) {
+        return BinaryValueReader(data.getBytes(), data.getSize()).getRoot().toValueVector();
+    }
     DictMaker tMaker;
-    return tMaker.arrayWithContentsOfFile(fullPath);
+    return tMaker.arrayWithDataOfFile(reinterpret_cast<const char *>(data.getBytes()), static_cast<int>(data.getSize()));
 }
 
 /*
@@ -337,6 +360,7 @@ bool FileUtils::writeValueMapToFile(const ValueMap &dict, const std::string &ful
     rootEle->LinkEndChild(innerDict);
 
     bool ret = tinyxml2::XML_SUCCESS == doc->SaveFile(getSuitableFOpen(fullPath).c_str());
+    purgeMissingPaths();
 
     delete doc;
     return ret;
@@ -373,6 +397,7 @@ bool FileUtils::writeValueVectorToFile(const ValueVector &vecData, const std::st
     rootEle->LinkEndChild(innerDict);
 
     bool ret = tinyxml2::XML_SUCCESS == doc->SaveFile(getSuitableFOpen(fullPath).c_str());
+    purgeMissingPaths();
 
     delete doc;
     return ret;
@@ -467,6 +492,20 @@ bool FileUtils::writeToFile(const ValueMap &dict, const std::string &fullPath) {
 
 #endif /* (CC_PLATFORM != CC_PLATFORM_MAC_IOS) && (CC_PLATFORM != CC_PLATFORM_MAC_OSX) */
 
+static bool writeBinaryValueToFile(const std::vector<uint8_t> &encoded, const std::string &fullPath) {
+    Data data;
+    data.copy(encoded.data(), static_cast<ssize_t>(encoded.size()));
+    return FileUtils::getInstance()->writeDataToFile(data, fullPath);
+}
+
+bool FileUtils::writeValueMapToBinaryFile(const ValueMap &dict, const std::string &fullPath) {
+    return writeBinaryValueToFile(encodeBinaryValue(dict), fullPath);
+}
+
+bool FileUtils::writeValueVectorToBinaryFile(const ValueVector &vecData, const std::string &fullPath) {
+    return writeBinaryValueToFile(encodeBinaryValue(vecData), fullPath);
+}
+
 // Implement FileUtils
 FileUtils *FileUtils::s_sharedFileUtils = nullptr;
 
@@ -515,6 +554,7 @@ bool FileUtils::writeDataToFile(const Data &data, const std::string &fullPath) {
         fwrite(data.getBytes(), size, 1, fp);
 
         fclose(fp);
+        fileutils->purgeMissingPaths();
 
         return true;
     } while (0);
@@ -524,11 +564,79 @@ bool FileUtils::writeDataToFile(const Data &data, const std::string &fullPath) {
 
 bool FileUtils::init() {
     _searchPathArray.push_back(_defaultResRootPath);
+    publishSearchState();
     return true;
 }
 
 void FileUtils::purgeCachedEntries() {
     _fullPathCache.clear();
+    _missingPathCache.clear();
+}
+
+std::unordered_map<std::string, std::string> FileUtils::getFullPathCache() const {
+    std::unordered_map<std::string, std::string> cache;
+    _fullPathCache.copyTo(&cache);
+    return cache;
+}
+
+void FileUtils::publishSearchState(std::shared_ptr<const std::unordered_set<std::string>> pathIndex, const std::string &pathIndexRoot) {
+    auto state = std::make_shared<SearchState>();
+    state->searchPaths = _searchPathArray;
+    state->pathIndex = std::move(pathIndex);
+    state->pathIndexRoot = pathIndexRoot;
+    std::atomic_store(&_searchState, std::shared_ptr<const SearchState>(std::move(state)));
+
+    // Both found and missing entries depend on the search paths. Lookups still resolving
+    // against the old state see the caches cleared and don't insert their results.
+    _fullPathCache.clear();
+    _missingPathCache.clear();
+}
+
+void FileUtils::publishSearchState() {
+    auto current = getSearchState();
+    publishSearchState(current->pathIndex, current->pathIndexRoot);
+}
+
+FileUtils::PathResolutionStats FileUtils::samplePathResolutionStats() {
+    PathResolutionStats stats;
+    stats.lookups = _lookupCount.load(std::memory_order_relaxed);
+    stats.cacheHits = _cacheHitCount.load(std::memory_order_relaxed);
+    stats.negativeHits = _negativeHitCount.load(std::memory_order_relaxed);
+    stats.statCalls = _statCallCount.load(std::memory_order_relaxed);
+
+    auto now = std::chrono::steady_clock::now();
+    float seconds = std::chrono::duration<float>(now - _lastSampleTime).count();
+    if (seconds > 0.F) {
+        stats.statCallsPerSecond = static_cast<float>(stats.statCalls - _lastSampledStatCalls) / seconds;
+    }
+    _lastSampledStatCalls = stats.statCalls;
+    _lastSampleTime = now;
+    return stats;
+}
+
+bool FileUtils::loadPathIndex(const std::string &manifestPath) {
+    std::string manifest = getStringFromFile(manifestPath);
+    if (manifest.empty()) {
+        CC_LOG_ERROR("Failed to load path index: %s", manifestPath.c_str());
+        return false;
+    }
+
+    auto pathIndex = std::make_shared<std::unordered_set<std::string>>();
+    size_t begin = 0;
+    while (begin < manifest.size()) {
+        size_t end = manifest.find('\n', begin);
+        if (end == std::string::npos) end = manifest.size();
+        std::string line = manifest.substr(begin, end - begin);
+        begin = end + 1;
+
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.compare(0, 2, "./") == 0) line.erase(0, 2);
+        if (!line.empty() && line[0] == '/') line.erase(0, 1);
+        if (line.empty()) continue;
+        pathIndex->insert(normalizePath(line));
+    }
+    publishSearchState(std::move(pathIndex), _defaultResRootPath);
+    return true;
 }
 
 std::string FileUtils::getStringFromFile(const std::string &filename) {
@@ -553,6 +661,10 @@ FileUtils::Status FileUtils::getContents(const std::string &filename, ResizableB
     if (fullPath.empty())
         return Status::NotExists;
 
+    Status packStatus;
+    if (fs->getContentsFromAssetPack(fullPath, buffer, &packStatus))
+        return packStatus;
+
     FILE *fp = fopen(fs->getSuitableFOpen(fullPath).c_str(), "rb");
     if (!fp)
         return Status::OpenFailed;
@@ -581,6 +693,73 @@ FileUtils::Status FileUtils::getContents(const std::string &filename, ResizableB
     return Status::OK;
 }
 
+bool FileUtils::getContentsView(const std::string &filename, const unsigned char **data, size_t *size) {
+    if (getAssetPacks()->empty() || filename.empty())
+        return false;
+
+    std::string relativePath;
+    const AssetPack *pack = findAssetPack(fullPathForFilename(filename), &relativePath);
+    if (!pack)
+        return false;
+
+    const AssetPackEntry *entry = pack->find(relativePath);
+    return entry && pack->getView(entry, data, size);
+}
+
+AssetPack *FileUtils::openAssetPack(const std::string &fullPath) const {
+    return AssetPack::open(fullPath);
+}
+
+const AssetPack *FileUtils::findAssetPack(const std::string &fullPath, std::string *relativePath) const {
+    for (const auto &it : *getAssetPacks()) {
+        const std::string &root = it.first;
+        if (fullPath.size() > root.size() && fullPath.compare(0, root.size(), root) == 0) {
+            *relativePath = fullPath.substr(root.size());
+            return it.second.get();
+        }
+    }
+    return nullptr;
+}
+
+bool FileUtils::getContentsFromAssetPack(const std::string &fullPath, ResizableBuffer *buffer, Status *status) const {
+    if (getAssetPacks()->empty())
+        return false;
+
+    std::string relativePath;
+    const AssetPack *pack = findAssetPack(fullPath, &relativePath);
+    if (!pack)
+        return false;
+
+    const AssetPackEntry *entry = pack->find(relativePath);
+    if (!entry) {
+        *status = Status::NotExists;
+    } else {
+        *status = pack->read(entry, buffer) ? Status::OK : Status::ReadFailed;
+    }
+    return true;
+}
+
+void FileUtils::mountAssetPack(const std::string &searchPath) {
+    // search paths always end with '/'
+    static const std::string PACK_EXTENSION = ".ccpk/";
+    std::shared_ptr<const AssetPackMap> packs = getAssetPacks();
+    if (searchPath.size() <= PACK_EXTENSION.size() ||
+        searchPath.compare(searchPath.size() - PACK_EXTENSION.size(), PACK_EXTENSION.size(), PACK_EXTENSION) != 0 ||
+        packs->count(searchPath)) {
+        return;
+    }
+
+    AssetPack *pack = openAssetPack(searchPath.substr(0, searchPath.size() - 1));
+    if (!pack) {
+        CC_LOG_ERROR("Failed to mount asset pack: %s", searchPath.c_str());
+        return;
+    }
+    // loader threads may hold the old map, publish a new one instead of modifying it
+    auto mounted = std::make_shared<AssetPackMap>(*packs);
+    (*mounted)[searchPath].reset(pack);
+    std::atomic_store(&_assetPacks, std::shared_ptr<const AssetPackMap>(std::move(mounted)));
+}
+
 unsigned char *FileUtils::getFileDataFromZip(const std::string &zipFilePath, const std::string &filename, ssize_t *size) {
     unsigned char *buffer = nullptr;
     unzFile file = nullptr;
@@ -650,25 +829,66 @@ std::string FileUtils::fullPathForFilename(const std::string &filename) const {
         return normalizePath(filename);
     }
 
+    _lookupCount.fetch_add(1, std::memory_order_relaxed);
+
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(filename);
-    if (cacheIter != _fullPathCache.end()) {
-        return cacheIter->second;
+    std::string fullpath;
+    if (_fullPathCache.find(filename, &fullpath)) {
+        _cacheHitCount.fetch_add(1, std::memory_order_relaxed);
+        return fullpath;
+    }
+    if (_missingPathCache.find(filename, nullptr)) {
+        _cacheHitCount.fetch_add(1, std::memory_order_relaxed);
+        _negativeHitCount.fetch_add(1, std::memory_order_relaxed);
+        return "";
     }
 
-    std::string fullpath;
+    // read before the state, so results resolved against a state replaced meanwhile are dropped
+    const uint32_t foundGeneration = _fullPathCache.generation();
+    const uint32_t missingGeneration = _missingPathCache.generation();
+    std::shared_ptr<const SearchState> state = getSearchState();
+    const auto *pathIndex = state->pathIndex.get();
+    const std::string &pathIndexRoot = state->pathIndexRoot;
+
+    std::shared_ptr<const AssetPackMap> packs = getAssetPacks();
+    for (const auto &searchIt : state->searchPaths) {
+        if (!packs->empty()) {
+            auto packIt = packs->find(searchIt);
+            if (packIt != packs->end()) {
+                // Mounted pack, resolved from its index.
+                std::string relativePath = normalizePath(filename);
+                if (packIt->second->find(relativePath)) {
+                    fullpath = searchIt + relativePath;
+                    _fullPathCache.insert(filename, fullpath, foundGeneration);
+                    return fullpath;
+                }
+                continue;
+            }
+        }
 
-    for (const auto &searchIt : _searchPathArray) {
+        if (pathIndex && !pathIndex->empty() && searchIt.compare(0, pathIndexRoot.size(), pathIndexRoot) == 0) {
+            // Indexed search path, no need to ask the file system.
+            fullpath = normalizePath(searchIt + filename);
+            if (fullpath.compare(0, pathIndexRoot.size(), pathIndexRoot) == 0 &&
+                pathIndex->count(fullpath.substr(pathIndexRoot.size()))) {
+                _fullPathCache.insert(filename, fullpath, foundGeneration);
+                return fullpath;
+            }
+            continue;
+        }
+
+        _statCallCount.fetch_add(1, std::memory_order_relaxed);
         fullpath = this->getPathForFilename(filename, searchIt);
 
         if (!fullpath.empty()) {
             // Using the filename passed in as key.
-            _fullPathCache.insert(std::make_pair(filename, fullpath));
+            _fullPathCache.insert(filename, fullpath, foundGeneration);
             return fullpath;
         }
     }
 
-    // The file wasn't found, return empty string.
+    // The file wasn't found, remember it and return empty string.
+    _missingPathCache.insert(filename, "", missingGeneration);
     return "";
 }
 
@@ -694,13 +914,12 @@ const std::string &FileUtils::getDefaultResourceRootPath() const {
 
 void FileUtils::setDefaultResourceRootPath(const std::string &path) {
     if (_defaultResRootPath != path) {
-        _fullPathCache.clear();
         _defaultResRootPath = path;
         if (!_defaultResRootPath.empty() && _defaultResRootPath[_defaultResRootPath.length() - 1] != '/') {
             _defaultResRootPath += '/';
         }
 
-        // Updates search paths
+        // Updates search paths, which also purges the cache
         setSearchPaths(_originalSearchPaths);
     }
 }
@@ -709,7 +928,6 @@ void FileUtils::setSearchPaths(const std::vector<std::string> &searchPaths) {
     bool existDefaultRootPath = false;
     _originalSearchPaths = searchPaths;
 
-    _fullPathCache.clear();
     _searchPathArray.clear();
 
     for (const auto &path : _originalSearchPaths) {
@@ -726,6 +944,7 @@ void FileUtils::setSearchPaths(const std::vector<std::string> &searchPaths) {
         if (!existDefaultRootPath && path == _defaultResRootPath) {
             existDefaultRootPath = true;
         }
+        mountAssetPack(fullPath);
         _searchPathArray.push_back(fullPath);
     }
 
@@ -733,6 +952,8 @@ void FileUtils::setSearchPaths(const std::vector<std::string> &searchPaths) {
         //CC_LOG_DEBUG("Default root path doesn't exist, adding it.");
         _searchPathArray.push_back(_defaultResRootPath);
     }
+
+    publishSearchState();
 }
 
 void FileUtils::addSearchPath(const std::string &searchpath, const bool front) {
@@ -744,6 +965,7 @@ void FileUtils::addSearchPath(const std::string &searchpath, const bool front) {
     if (!path.empty() && path[path.length() - 1] != '/') {
         path += "/";
     }
+    mountAssetPack(path);
     if (front) {
         _originalSearchPaths.insert(_originalSearchPaths.begin(), searchpath);
         _searchPathArray.insert(_searchPathArray.begin(), path);
@@ -751,6 +973,9 @@ void FileUtils::addSearchPath(const std::string &searchpath, const bool front) {
         _originalSearchPaths.push_back(searchpath);
         _searchPathArray.push_back(path);
     }
+
+    // A new search path may shadow cached paths or provide missing files.
+    publishSearchState();
 }
 
 std::string FileUtils::getFullPathForDirectoryAndFilename(const std::string &directory, const std::string &filename) const {
@@ -771,7 +996,12 @@ std::string FileUtils::getFullPathForDirectoryAndFilename(const std::string &dir
 
 bool FileUtils::isFileExist(const std::string &filename) const {
     if (isAbsolutePath(filename)) {
-        return isFileExistInternal(normalizePath(filename));
+        std::string fullpath = normalizePath(filename);
+        std::string relativePath;
+        if (const AssetPack *pack = findAssetPack(fullpath, &relativePath)) {
+            return pack->find(relativePath) != nullptr;
+        }
+        return isFileExistInternal(fullpath);
     } else {
         std::string fullpath = fullPathForFilename(filename);
         if (fullpath.empty())
@@ -793,17 +1023,17 @@ bool FileUtils::isDirectoryExist(const std::string &dirPath) const {
     }
 
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(dirPath);
-    if (cacheIter != _fullPathCache.end()) {
-        return isDirectoryExistInternal(cacheIter->second);
+    std::string cachedPath;
+    if (_fullPathCache.find(dirPath, &cachedPath) && !cachedPath.empty()) {
+        return isDirectoryExistInternal(cachedPath);
     }
 
     std::string fullpath;
-    for (const auto &searchIt : _searchPathArray) {
+    for (const auto &searchIt : getSearchState()->searchPaths) {
         // searchPath + file_path
         fullpath = fullPathForFilename(searchIt + dirPath);
         if (isDirectoryExistInternal(fullpath)) {
-            _fullPathCache.insert(std::make_pair(dirPath, fullpath));
+            _fullPathCache.insert(dirPath, fullpath);
             return true;
         }
     }
@@ -1024,6 +1254,7 @@ bool FileUtils::createDirectory(const std::string &path) {
             closedir(dir);
         }
     }
+    purgeMissingPaths();
     return true;
 }
 
@@ -1081,6 +1312,7 @@ bool FileUtils::renameFile(const std::string &oldfullpath, const std::string &ne
         CC_LOG_ERROR("Fail to rename file %s to %s !Error code is %d", oldfullpath.c_str(), newfullpath.c_str(), errorCode);
         return false;
     }
+    purgeMissingPaths();
     return true;
 }
 
@@ -1106,6 +1338,12 @@ long FileUtils::getFileSize(const std::string &filepath) {
             return 0;
     }
 
+    std::string relativePath;
+    if (const AssetPack *pack = findAssetPack(fullpath, &relativePath)) {
+        const AssetPackEntry *entry = pack->find(relativePath);
+        return entry ? static_cast<long>(entry->rawSize) : -1;
+    }
+
     struct stat info;
     // Get data associated with "crt_stat.c":
     int result = stat(fullpath.c_str(), &info);
@@ -28,14 +28,20 @@
 #ifndef __CC_FILEUTILS_H__
 #define __CC_FILEUTILS_H__
 
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <type_traits>
 
 #include "base/Macros.h"
 #include "base/Value.h"
 #include "base/Data.h"
+#include "platform/AssetPack.h"
+#include "platform/FilePathCache.h"
 
 namespace cc {
 
@@ -152,10 +158,38 @@ public:
     virtual ~FileUtils();
 
     /**
-     *  Purges full path caches.
+     *  Purges full path caches, both found and missing entries.
+     *  Missing entries are dropped whenever the search paths change or a FileUtils write API creates a file,
+     *  call it after creating files under a search path by other means, e.g. with fopen.
      */
     virtual void purgeCachedEntries();
 
+    /**
+     *  Counters of the path resolution done by fullPathForFilename.
+     */
+    struct PathResolutionStats {
+        uint64_t lookups{0};
+        uint64_t cacheHits{0};
+        uint64_t negativeHits{0}; // cache hits on files known not to exist
+        uint64_t statCalls{0};    // lookups that had to query the file system
+        float statCallsPerSecond{0.F};
+    };
+
+    /**
+     *  Returns the accumulated counters; the rate is measured since the previous call.
+     */
+    PathResolutionStats samplePathResolutionStats();
+
+    /**
+     *  Loads a prebuilt index of the files shipped under the default resource root path.
+     *  The manifest is a plain text file with one path per line, relative to the default resource root.
+     *  Lookups under indexed search paths are then answered from memory without touching the file system.
+     *
+     *  @param manifestPath The path of the manifest file.
+     *  @return True if the manifest was loaded.
+     */
+    bool loadPathIndex(const std::string &manifestPath);
+
     /**
      *  Gets string from a file.
      */
@@ -242,6 +276,17 @@ public:
     }
     virtual Status getContents(const std::string &filename, ResizableBuffer *buffer);
 
+    /**
+     *  Gets the contents of a file stored uncompressed in a mounted asset pack without copying.
+     *  Asset packs are mounted by adding a path ending with ".ccpk" to the search paths.
+     *
+     *  @param[in]  filename The resource file name which contains the path.
+     *  @param[out] data Points to the mapped bytes, valid as long as FileUtils is alive.
+     *  @param[out] size The size of the file.
+     *  @return true if a view is available, false if the file is not in a pack or is compressed.
+     */
+    bool getContentsView(const std::string &filename, const unsigned char **data, size_t *size);
+
     /**
      *  Gets resource file data from a zip file.
      *
@@ -379,7 +424,7 @@ public:
 
     /**
      *  Converts the contents of a file to a ValueMap.
-     *  @param filename The filename of the file to gets content.
+     *  @param filename The filename of the file to gets content, either a plist or a binary value file.
      *  @return ValueMap of the file contents.
      *  @note This method is used internally.
      */
@@ -435,6 +480,26 @@ public:
     */
     virtual bool writeValueVectorToFile(const ValueVector &vecData, const std::string &fullPath);
 
+    /**
+    * write ValueMap into a binary value file, which getValueMapFromFile loads much faster than a plist
+    *
+    *@param dict the ValueMap want to save
+    *@param fullPath The full path to the file you want to save
+    *@return bool
+    *@see BinaryValueReader
+    */
+    bool writeValueMapToBinaryFile(const ValueMap &dict, const std::string &fullPath);
+
+    /**
+    * write ValueVector into a binary value file, which getValueVectorFromFile loads much faster than a plist
+    *
+    *@param vecData the ValueVector want to save
+    *@param fullPath The full path to the file you want to save
+    *@return bool
+    *@see BinaryValueReader
+    */
+    bool writeValueVectorToBinaryFile(const ValueVector &vecData, const std::string &fullPath);
+
     /**
     * Windows fopen can't support UTF-8 filename
     * Need convert all parameters fopen and other 3rd-party libs
@@ -552,8 +617,8 @@ public:
      */
     virtual long getFileSize(const std::string &filepath);
 
-    /** Returns the full path cache. */
-    const std::unordered_map<std::string, std::string> &getFullPathCache() const { return _fullPathCache; }
+    /** Returns a copy of the cached full paths. */
+    CC_DEPRECATED_ATTRIBUTE std::unordered_map<std::string, std::string> getFullPathCache() const;
 
     std::string normalizePath(const std::string &path) const;
     std::string getFileDir(const std::string &path) const;
@@ -609,9 +674,66 @@ protected:
      */
     virtual std::string getFullPathForDirectoryAndFilename(const std::string &directory, const std::string &filename) const;
 
+    /**
+     *  Maps an asset pack, platforms may override it to map packs inside the application package.
+     *  @param fullPath The full path of the pack file.
+     *  @return The pack, or nullptr if it can't be opened.
+     */
+    virtual AssetPack *openAssetPack(const std::string &fullPath) const;
+
+    /**
+     *  Finds the mounted pack which contains a full path returned by fullPathForFilename.
+     *  @param[out] relativePath The path of the entry inside the pack.
+     */
+    const AssetPack *findAssetPack(const std::string &fullPath, std::string *relativePath) const;
+
+    using AssetPackMap = std::unordered_map<std::string, std::shared_ptr<AssetPack>>;
+
+    /**
+     *  Returns the mounted packs. The map is replaced, never modified, on mount, so loader threads can keep using it.
+     */
+    std::shared_ptr<const AssetPackMap> getAssetPacks() const { return std::atomic_load(&_assetPacks); }
+
+    /**
+     *  Reads a file from a mounted pack.
+     *  @return false if the full path doesn't belong to a pack, otherwise the read status is stored in 'status'.
+     */
+    bool getContentsFromAssetPack(const std::string &fullPath, ResizableBuffer *buffer, Status *status) const;
+
+    void mountAssetPack(const std::string &searchPath);
+
+    /**
+     *  What lookups need to resolve a file name: the search paths, and the prebuilt file index
+     *  loaded by 'loadPathIndex', relative to 'pathIndexRoot'.
+     */
+    struct SearchState {
+        std::vector<std::string> searchPaths;
+        std::shared_ptr<const std::unordered_set<std::string>> pathIndex;
+        std::string pathIndexRoot;
+    };
+
+    /**
+     *  Returns the search state. It is replaced, never modified, so loader threads can keep using it
+     *  while the search paths are changed.
+     */
+    std::shared_ptr<const SearchState> getSearchState() const { return std::atomic_load(&_searchState); }
+
+    /**
+     *  Publishes '_searchPathArray' with the given index, and purges the path caches which depend on both.
+     *  Call it after every change of '_searchPathArray'.
+     */
+    void publishSearchState(std::shared_ptr<const std::unordered_set<std::string>> pathIndex, const std::string &pathIndexRoot);
+    void publishSearchState();
+
+    /**
+     *  Drops the cached missing paths, called when a file may have been created.
+     */
+    void purgeMissingPaths() const { _missingPathCache.clear(); }
+
     /**
      * The vector contains search paths.
      * The lower index of the element in this vector, the higher priority for this search path.
+     * Only used on the thread changing the search paths, lookups go through 'getSearchState'.
      */
     std::vector<std::string> _searchPathArray;
 
@@ -630,10 +752,29 @@ protected:
     std::string _defaultResRootPath;
 
     /**
-     *  The full path cache. When a file is found, it will be added into this cache.
-     *  This variable is used for improving the performance of file search.
+     *  The full path cache of found files, and the files known to be missing.
+     *  Lookups are lock-free, so paths can be resolved from loader threads.
      */
-    mutable std::unordered_map<std::string, std::string> _fullPathCache;
+    mutable FilePathCache _fullPathCache;
+    mutable FilePathCache _missingPathCache;
+
+    /**
+     *  Mapped asset packs, keyed by their search path. Packs stay mapped until FileUtils is destroyed.
+     *  Copy-on-write, always accessed through std::atomic_load/std::atomic_store.
+     */
+    std::shared_ptr<const AssetPackMap> _assetPacks{std::make_shared<const AssetPackMap>()};
+
+    /**
+     *  Copy-on-write, always accessed through std::atomic_load/std::atomic_store.
+     */
+    std::shared_ptr<const SearchState> _searchState{std::make_shared<const SearchState>()};
+
+    mutable std::atomic<uint64_t> _lookupCount{0};
+    mutable std::atomic<uint64_t> _cacheHitCount{0};
+    mutable std::atomic<uint64_t> _negativeHitCount{0};
+    mutable std::atomic<uint64_t> _statCallCount{0};
+    uint64_t _lastSampledStatCalls{0};
+    std::chrono::steady_clock::time_point _lastSampleTime{std::chrono::steady_clock::now()};
 
     /**
      * Writable path.
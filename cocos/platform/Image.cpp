@@ -263,7 +263,9 @@ Image::Image() : _renderFormat(gfx::Format::UNKNOWN) {
 }
 
 Image::~Image() {
-    CC_SAFE_FREE(_data);
+    if (_ownsData) {
+        CC_SAFE_FREE(_data);
+    }
 }
 
 bool Image::initWithImageFile(const std::string &path) {
@@ -282,7 +284,13 @@ bool Image::initWithImageFile(const std::string &path) {
 }
 
 bool Image::initWithImageData(const unsigned char *data, ssize_t dataLen) {
+    static const ImageDecodeOptions DEFAULT_OPTIONS;
+    return initWithImageData(data, dataLen, DEFAULT_OPTIONS);
+}
+
+bool Image::initWithImageData(const unsigned char *data, ssize_t dataLen, const ImageDecodeOptions &options) {
     bool ret = false;
+    _options = &options;
 
     do {
         CC_BREAK_IF(!data || dataLen <= 0);
@@ -300,6 +308,8 @@ bool Image::initWithImageData(const unsigned char *data, ssize_t dataLen) {
             unpackedLen  = dataLen;
         }
 
+        // inflated buffers are released below, so they can't be referenced
+        _referenceSource = options.referenceSource && unpackedData == data;
         _fileType = detectFormat(unpackedData, unpackedLen);
 
         switch (_fileType) {
@@ -333,9 +343,36 @@ bool Image::initWithImageData(const unsigned char *data, ssize_t dataLen) {
         }
     } while (false);
 
+    _options = nullptr;
     return ret;
 }
 
+unsigned char *Image::allocateData(ssize_t dataLen) {
+    _dataLen = dataLen;
+    if (_options && _options->allocator) {
+        _data = _options->allocator(static_cast<size_t>(dataLen));
+        if (_data) {
+            _ownsData = false;
+            return _data;
+        }
+    }
+    _ownsData = true;
+    _data = static_cast<unsigned char *>(malloc(dataLen * sizeof(unsigned char)));
+    return _data;
+}
+
+void Image::setCompressedData(const unsigned char *data, ssize_t dataLen) {
+    if (_referenceSource) {
+        _dataLen = dataLen;
+        _data = const_cast<unsigned char *>(data);
+        _ownsData = false;
+        return;
+    }
+    if (allocateData(dataLen)) {
+        memcpy(_data, data, dataLen);
+    }
+}
+
 bool Image::isPng(const unsigned char *data, ssize_t dataLen) {
     if (dataLen <= 8) {
         return false;
@@ -538,6 +575,12 @@ bool Image::initWithJpgData(const unsigned char *data, ssize_t dataLen) {
         jpeg_read_header(&cinfo, TRUE);
     #endif
 
+        // scaled decode, the DCT produces the smaller image directly
+        if (_options && _options->jpegScaleDenom > 1) {
+            cinfo.scale_num = 1;
+            cinfo.scale_denom = _options->jpegScaleDenom;
+        }
+
         // we only support RGB or grayscale
         if (cinfo.jpeg_color_space == JCS_GRAYSCALE) {
             _renderFormat = gfx::Format::L8;
@@ -553,9 +596,7 @@ bool Image::initWithJpgData(const unsigned char *data, ssize_t dataLen) {
         _isCompressed = false;
         _width        = cinfo.output_width;
         _height       = cinfo.output_height;
-        _dataLen      = cinfo.output_width * cinfo.output_height * cinfo.output_components;
-        _data         = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
-        CC_BREAK_IF(!_data);
+        CC_BREAK_IF(!allocateData(cinfo.output_width * cinfo.output_height * cinfo.output_components));
 
         /* now actually read the jpeg into the raw buffer */
         /* read one scan line at a time */
@@ -678,9 +719,7 @@ bool Image::initWithPngData(const unsigned char *data, ssize_t dataLen) {
 
         rowbytes = png_get_rowbytes(pngPtr, infoPtr);
 
-        _dataLen = rowbytes * _height;
-        _data    = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
-        if (!_data) {
+        if (!allocateData(rowbytes * _height)) {
             if (rowPointers != nullptr) {
                 free(rowPointers);
             }
@@ -745,9 +784,7 @@ bool Image::initWithPVRv2Data(const unsigned char *data, ssize_t dataLen) {
     _isCompressed    = true;
 
     //Move by size of header
-    _dataLen = dataLen - sizeof(PVRv2TexHeader);
-    _data    = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
-    memcpy(_data, const_cast<unsigned char *>(data) + sizeof(PVRv2TexHeader), _dataLen);
+    setCompressedData(data + sizeof(PVRv2TexHeader), dataLen - sizeof(PVRv2TexHeader));
 
     return true;
 }
@@ -788,9 +825,7 @@ bool Image::initWithPVRv3Data(const unsigned char *data, ssize_t dataLen) {
     _height       = CC_SWAP_INT32_LITTLE_TO_HOST(header->height);
     _isCompressed = true;
 
-    _dataLen = dataLen - (sizeof(PVRv3TexHeader) + header->metadataLength);
-    _data    = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
-    memcpy(_data, static_cast<const unsigned char *>(data) + sizeof(PVRv3TexHeader) + header->metadataLength, _dataLen);
+    setCompressedData(data + sizeof(PVRv3TexHeader) + header->metadataLength, dataLen - (sizeof(PVRv3TexHeader) + header->metadataLength));
 
     return true;
 }
@@ -812,9 +847,7 @@ bool Image::initWithETCData(const unsigned char *data, ssize_t dataLen) {
     }
 
     _renderFormat = gfx::Format::ETC_RGB8;
-    _dataLen      = dataLen - ETC_PKM_HEADER_SIZE;
-    _data         = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
-    memcpy(_data, static_cast<const unsigned char *>(data) + ETC_PKM_HEADER_SIZE, _dataLen);
+    setCompressedData(data + ETC_PKM_HEADER_SIZE, dataLen - ETC_PKM_HEADER_SIZE);
     return true;
 }
 
@@ -841,9 +874,7 @@ bool Image::initWithETC2Data(const unsigned char *data, ssize_t dataLen) {
         _renderFormat = gfx::Format::ETC2_RGBA8;
     }
 
-    _dataLen = dataLen - ETC2_PKM_HEADER_SIZE;
-    _data    = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
-    memcpy(_data, static_cast<const unsigned char *>(data) + ETC2_PKM_HEADER_SIZE, _dataLen);
+    setCompressedData(data + ETC2_PKM_HEADER_SIZE, dataLen - ETC2_PKM_HEADER_SIZE);
     return true;
 }
 
@@ -865,9 +896,7 @@ bool Image::initWithASTCData(const unsigned char *data, ssize_t dataLen) {
 
     _renderFormat = getASTCFormat(header);
 
-    _dataLen = dataLen - ASTC_HEADER_SIZE;
-    _data    = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
-    memcpy(_data, static_cast<const unsigned char *>(data) + ASTC_HEADER_SIZE, _dataLen);
+    setCompressedData(data + ASTC_HEADER_SIZE, dataLen - ASTC_HEADER_SIZE);
     // if (_data == nullptr) {
     //     CCLOG("initWithASTCData: ERROR: Image _data is null!");
     //     return false;
@@ -896,8 +925,7 @@ bool Image::initWithWebpData(const unsigned char *data, ssize_t dataLen) {
         _height                  = config.input.height;
         _isCompressed            = false;
 
-        _dataLen = _width * _height * (config.input.has_alpha ? 4 : 3);
-        _data    = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
+        CC_BREAK_IF(!allocateData(_width * _height * (config.input.has_alpha ? 4 : 3)));
 
         config.output.u.RGBA.rgba        = static_cast<uint8_t *>(_data);
         config.output.u.RGBA.stride      = _width * (config.input.has_alpha ? 4 : 3);
@@ -905,7 +933,7 @@ bool Image::initWithWebpData(const unsigned char *data, ssize_t dataLen) {
         config.output.is_external_memory = 1;
 
         if (WebPDecode(static_cast<const uint8_t *>(data), dataLen, &config) != VP8_STATUS_OK) {
-            free(_data);
+            if (_ownsData) free(_data);
             _data = nullptr;
             break;
         }
@@ -28,6 +28,7 @@
 #pragma once
 
 #include "base/Ref.h"
+#include <functional>
 #include <string>
 #include <map>
 
@@ -37,6 +38,16 @@ namespace gfx {
 enum class Format;
 } // namespace gfx
 
+struct ImageDecodeOptions {
+    // Returns where the decoded pixels of the given byte size should be written, e.g. a staging buffer.
+    // Memory returned here is not owned by the image; return nullptr to let the image allocate it.
+    std::function<unsigned char *(size_t size)> allocator;
+    // Compressed textures point into the source data instead of copying it, the source must outlive the image.
+    bool referenceSource = false;
+    // JPEG only, decodes at 1/N of the size for downsampled mips, N is 1, 2, 4 or 8.
+    unsigned int jpegScaleDenom = 1;
+};
+
 class Image : public Ref {
 public:
     Image();
@@ -65,12 +76,15 @@ public:
 
     bool initWithImageFile(const std::string &path);
     bool initWithImageData(const unsigned char *data, ssize_t dataLen);
+    bool initWithImageData(const unsigned char *data, ssize_t dataLen, const ImageDecodeOptions &options);
 
     // @warning kFmtRawData only support RGBA8888
     bool initWithRawData(const unsigned char *data, ssize_t dataLen, int width, int height, int bitsPerComponent, bool preMulti = false);
 
     // data will be free ouside.
+    // @warning only valid when the image owns its data, see ownsData()
     inline void takeData(unsigned char **outData) {
+        CCASSERT(_ownsData, "data provided by the decode options can't be taken");
         *outData = _data;
         _data = nullptr;
     }
@@ -85,6 +99,8 @@ public:
     inline std::string getFilePath() const { return _filePath; }
 
     inline bool isCompressed() const { return _isCompressed; }
+    // false if the data lives in a buffer provided by the decode options or in the source data
+    inline bool ownsData() const { return _ownsData; }
 
 protected:
     bool initWithJpgData(const unsigned char *data, ssize_t dataLen);
@@ -97,6 +113,9 @@ protected:
     bool initWithETC2Data(const unsigned char *data, ssize_t dataLen);
     bool initWithASTCData(const unsigned char *data, ssize_t dataLen);
 
+    unsigned char *allocateData(ssize_t dataLen);
+    void setCompressedData(const unsigned char *data, ssize_t dataLen);
+
     unsigned char *_data = nullptr;
     ssize_t _dataLen = 0;
     int _width = 0;
@@ -105,6 +124,9 @@ protected:
     gfx::Format _renderFormat;
     std::string _filePath;
     bool _isCompressed = false;
+    bool _ownsData = true;
+    const ImageDecodeOptions *_options = nullptr; // valid during initWithImageData only
+    bool _referenceSource = false;
 
     ~Image() override;
 
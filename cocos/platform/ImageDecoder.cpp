@@ -0,0 +1,144 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/ImageDecoder.h"
+
+#include <algorithm>
+
+#include "base/Data.h"
+#include "base/Scheduler.h"
+#include "platform/Application.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+
+ImageDecoder *ImageDecoder::instance = nullptr;
+
+ImageDecoder *ImageDecoder::getInstance() {
+    if (!instance) {
+        // leave a core to the game and render threads
+        uint32_t cores = std::thread::hardware_concurrency();
+        instance = new ImageDecoder(std::max(1U, std::min(cores > 1 ? cores - 1 : 1U, MAX_THREAD_COUNT)));
+    }
+    return instance;
+}
+
+void ImageDecoder::destroyInstance() {
+    delete instance;
+    instance = nullptr;
+}
+
+ImageDecoder::ImageDecoder(uint32_t threadCount) {
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        _workers.emplace_back(&ImageDecoder::workerLoop, this);
+    }
+}
+
+ImageDecoder::~ImageDecoder() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+        _jobs.clear();
+    }
+    _condition.notify_all();
+    for (auto &worker : _workers) worker.join();
+}
+
+void ImageDecoder::decode(const unsigned char *data, ssize_t dataLen, const ImageDecodeOptions &options, Callback callback, Callback prepare) {
+    Job job;
+    job.data = data;
+    job.dataLen = dataLen;
+    job.options = options;
+    job.callback = std::move(callback);
+    job.prepare = std::move(prepare);
+    push(std::move(job));
+}
+
+void ImageDecoder::decodeFile(const std::string &fullPath, const ImageDecodeOptions &options, Callback callback, Callback prepare) {
+    Job job;
+    job.fullPath = fullPath;
+    job.options = options;
+    job.options.referenceSource = false;
+    job.callback = std::move(callback);
+    job.prepare = std::move(prepare);
+    push(std::move(job));
+}
+
+void ImageDecoder::push(Job &&job) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(std::move(job));
+    }
+    _condition.notify_one();
+}
+
+void ImageDecoder::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this]() { return !_running || !_jobs.empty(); });
+            if (!_running) return;
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+
+        auto *image = new (std::nothrow) Image();
+        bool succeeded = false;
+        if (image) {
+            if (job.fullPath.empty()) {
+                succeeded = image->initWithImageData(job.data, job.dataLen, job.options);
+            } else {
+                Data data = FileUtils::getInstance()->getDataFromFile(job.fullPath);
+                succeeded = !data.isNull() && image->initWithImageData(data.getBytes(), data.getSize(), job.options);
+            }
+        }
+        if (!succeeded) {
+            CC_SAFE_RELEASE_NULL(image);
+        } else if (job.prepare) {
+            job.prepare(image);
+        }
+        deliver(image, std::move(job.callback));
+    }
+}
+
+void ImageDecoder::deliver(Image *image, Callback &&callback) {
+    if (!callback) {
+        CC_SAFE_RELEASE(image);
+        return;
+    }
+
+    Application *app = Application::getInstance();
+    if (app && app->getScheduler()) {
+        app->getScheduler()->performFunctionInCocosThread([image, callback]() {
+            callback(image);
+        });
+    } else {
+        // no application, e.g. in tools
+        callback(image);
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,110 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/Macros.h"
+#include "platform/Image.h"
+
+namespace cc {
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * Decodes images on a bounded set of worker threads.
+ *
+ * Decoders write straight into the buffer returned by ImageDecodeOptions::allocator when
+ * one is provided, e.g. a GFX staging allocation, so the pixels aren't copied again before upload.
+ * Callbacks run on the cocos thread; the image is passed with a reference the callback must release,
+ * or nullptr if decoding failed. Work that should stay off the cocos thread, like converting the pixels
+ * for upload, goes in the optional 'prepare' callback which runs on the worker thread right after decoding.
+ */
+class CC_DLL ImageDecoder final {
+public:
+    using Callback = std::function<void(Image *image)>;
+
+    static constexpr uint32_t MAX_THREAD_COUNT = 4U;
+
+    static ImageDecoder *getInstance();
+    static void destroyInstance();
+
+    /**
+     * Decodes an encoded image in memory.
+     * @param data Must stay valid until the callback is invoked, and as long as the image
+     *             when ImageDecodeOptions::referenceSource is set.
+     * @param options The allocator is invoked on a worker thread.
+     * @param prepare Invoked on the worker thread with the decoded image, skipped if decoding failed.
+     */
+    void decode(const unsigned char *data, ssize_t dataLen, const ImageDecodeOptions &options, Callback callback, Callback prepare = nullptr);
+
+    /**
+     * Reads and decodes an image file, ImageDecodeOptions::referenceSource is ignored.
+     * @param fullPath The full path of the file.
+     */
+    void decodeFile(const std::string &fullPath, const ImageDecodeOptions &options, Callback callback, Callback prepare = nullptr);
+
+    uint32_t getThreadCount() const { return static_cast<uint32_t>(_workers.size()); }
+
+private:
+    struct Job {
+        const unsigned char *data{nullptr};
+        ssize_t dataLen{0};
+        std::string fullPath;
+        ImageDecodeOptions options;
+        Callback callback;
+        Callback prepare;
+    };
+
+    explicit ImageDecoder(uint32_t threadCount);
+    ~ImageDecoder();
+
+    void push(Job &&job);
+    void workerLoop();
+    void deliver(Image *image, Callback &&callback);
+
+    static ImageDecoder *instance;
+
+    std::vector<std::thread> _workers;
+    std::deque<Job> _jobs;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _running{true};
+};
+
+// end of platform group
+/** @} */
+
+} // namespace cc
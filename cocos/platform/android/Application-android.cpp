@@ -35,6 +35,8 @@
 #include "cocos/bindings/event/EventDispatcher.h"
 #include "platform/android/jni/JniHelper.h"
 #include "platform/android/jni/JniCocosActivity.h"
+#include "platform/AsyncFileLoader.h"
+#include "platform/ImageDecoder.h"
 
 #include "pipeline/Define.h"
 #include "pipeline/RenderPipeline.h"
@@ -96,6 +98,9 @@ Application::~Application() {
     AudioEngine::end();
 #endif
 
+    AsyncFileLoader::destroyInstance();
+    ImageDecoder::destroyInstance();
+
     pipeline::RenderPipeline::getInstance()->destroy();
 
     EventDispatcher::destroy();
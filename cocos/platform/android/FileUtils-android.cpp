@@ -183,6 +183,10 @@ FileUtils::Status FileUtilsAndroid::getContents(const std::string &filename, Res
     if (fullPath.empty())
         return FileUtils::Status::NotExists;
 
+    FileUtils::Status packStatus;
+    if (getContentsFromAssetPack(fullPath, buffer, &packStatus))
+        return packStatus;
+
     if (fullPath[0] == '/')
         return FileUtils::getContents(fullPath, buffer);
 
@@ -226,6 +230,29 @@ FileUtils::Status FileUtilsAndroid::getContents(const std::string &filename, Res
     return FileUtils::Status::OK;
 }
 
+AssetPack *FileUtilsAndroid::openAssetPack(const std::string &fullPath) const {
+    if (fullPath[0] == '/' || nullptr == assetmanager)
+        return FileUtils::openAssetPack(fullPath);
+
+    std::string relativePath = fullPath;
+    if (relativePath.find(ASSETS_FOLDER_NAME) == 0)
+        relativePath = relativePath.substr(strlen(ASSETS_FOLDER_NAME));
+
+    // packs stored uncompressed in the APK are memory-mapped by the asset manager
+    AAsset *asset = AAssetManager_open(assetmanager, relativePath.c_str(), AASSET_MODE_BUFFER);
+    if (nullptr == asset)
+        return nullptr;
+
+    const void *data = AAsset_getBuffer(asset);
+    if (nullptr == data) {
+        AAsset_close(asset);
+        return nullptr;
+    }
+    return AssetPack::openWithMemory(static_cast<const unsigned char *>(data), static_cast<size_t>(AAsset_getLength64(asset)), [asset]() {
+        AAsset_close(asset);
+    });
+}
+
 std::string FileUtilsAndroid::getWritablePath() const {
     // Fix for Nexus 10 (Android 4.2 multi-user environment)
     // the path is retrieved through Java Context.getCacheDir() method
@@ -69,6 +69,9 @@ public:
     virtual std::string getWritablePath() const override;
     virtual bool isAbsolutePath(const std::string &strPath) const override;
 
+protected:
+    virtual AssetPack *openAssetPack(const std::string &fullPath) const override;
+
 private:
     virtual bool isFileExistInternal(const std::string &strFilePath) const override;
     virtual bool isDirectoryExistInternal(const std::string &dirPath) const override;
@@ -38,6 +38,7 @@
 #include "platform/FileUtils.h"
 #include "platform/SAXParser.h"
 #include "base/Log.h"
+#include "base/ValueBinary.h"
 
 namespace cc {
 
@@ -313,6 +314,10 @@ ValueMap FileUtilsApple::getValueMapFromFile(const std::string &filename) {
 }
 
 ValueMap FileUtilsApple::getValueMapFromData(const char *filedata, int filesize) {
+    if (BinaryValueReader::isBinaryValue(filedata, filesize)) {
+        return BinaryValueReader(filedata, filesize).getRoot().toValueMap();
+    }
+
     NSData *file = [NSData dataWithBytes:filedata length:filesize];
     NSPropertyListFormat format;
     NSError *error;
@@ -344,7 +349,9 @@ bool FileUtils::writeValueMapToFile(const ValueMap &dict, const std::string &ful
 
     NSString *file = [NSString stringWithUTF8String:fullPath.c_str()];
     // do it atomically
-    return [nsDict writeToFile:file atomically:YES];
+    BOOL result = [nsDict writeToFile:file atomically:YES];
+    purgeMissingPaths();
+    return result;
 }
 
 void FileUtilsApple::valueMapCompact(ValueMap &valueMap) {
@@ -400,6 +407,7 @@ bool FileUtils::writeValueVectorToFile(const ValueVector &vecData, const std::st
     }
 
     [array writeToFile:path atomically:YES];
+    purgeMissingPaths();
 
     return true;
 }
@@ -410,8 +418,16 @@ ValueVector FileUtilsApple::getValueVectorFromFile(const std::string &filename)
     //    pPath = [[NSBundle mainBundle] pathForResource:pPath ofType:pathExtension];
     //    fixing cannot read data using Array::createWithContentsOfFile
     std::string fullPath = fullPathForFilename(filename);
-    NSString *path = [NSString stringWithUTF8String:fullPath.c_str()];
-    NSArray *array = [NSArray arrayWithContentsOfFile:path];
+    Data d = getDataFromFile(fullPath);
+    if (BinaryValueReader::isBinaryValue(d.getBytes(), d.getSize())) {
+        return BinaryValueReader(d.getBytes(), d.getSize()).getRoot().toValueVector();
+    }
+
+    NSData *file = [NSData dataWithBytesNoCopy:d.getBytes() length:d.getSize() freeWhenDone:NO];
+    NSArray *array = [NSPropertyListSerialization propertyListWithData:file options:NSPropertyListImmutable format:nil error:nil];
+    if (![array isKindOfClass:[NSArray class]]) {
+        array = nil;
+    }
 
     ValueVector ret;
 
@@ -436,6 +452,7 @@ bool FileUtilsApple::createDirectory(const std::string &path) {
         CC_LOG_ERROR("Fail to create directory \"%s\": %s", path.c_str(), [error.localizedDescription UTF8String]);
     }
 
+    purgeMissingPaths();
     return result;
 }
 
@@ -36,6 +36,8 @@
 #include "bindings/event/EventDispatcher.h"
 #include "bindings/jswrapper/SeApi.h"
 #include "platform/Device.h"
+#include "platform/AsyncFileLoader.h"
+#include "platform/ImageDecoder.h"
 
 #include "pipeline/Define.h"
 #include "pipeline/RenderPipeline.h"
@@ -147,6 +149,9 @@ Application::~Application() {
     AudioEngine::end();
 #endif
 
+    AsyncFileLoader::destroyInstance();
+    ImageDecoder::destroyInstance();
+
     pipeline::RenderPipeline::getInstance()->destroy();
 
     EventDispatcher::destroy();
@@ -35,6 +35,8 @@
 #include "base/Scheduler.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
 #include "platform/Application.h"
+#include "platform/AsyncFileLoader.h"
+#include "platform/ImageDecoder.h"
 #include "platform/Device.h"
 
 #include "pipeline/Define.h"
@@ -144,6 +146,9 @@ Application::~Application() {
     AudioEngine::end();
 #endif
 
+    AsyncFileLoader::destroyInstance();
+    ImageDecoder::destroyInstance();
+
     pipeline::RenderPipeline::getInstance()->destroy();
 
     EventDispatcher::destroy();
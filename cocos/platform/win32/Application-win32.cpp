@@ -33,6 +33,8 @@
 #include "base/Scheduler.h"
 #include "cocos/bindings/event/EventDispatcher.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
+#include "platform/AsyncFileLoader.h"
+#include "platform/ImageDecoder.h"
 #include "platform/FileUtils.h"
 #include "platform/win32/View-win32.h"
 #include <MMSystem.h>
@@ -69,6 +71,9 @@ Application::~Application() {
     AudioEngine::end();
 #endif
 
+    AsyncFileLoader::destroyInstance();
+    ImageDecoder::destroyInstance();
+
     pipeline::RenderPipeline::getInstance()->destroy();
 
     EventDispatcher::destroy();
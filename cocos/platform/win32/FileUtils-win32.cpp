@@ -108,6 +108,14 @@ std::string FileUtilsWin32::getSuitableFOpen(const std::string &filenameUtf8) co
 }
 
 long FileUtilsWin32::getFileSize(const std::string &filepath) {
+    if (!getAssetPacks()->empty()) {
+        std::string relativePath;
+        if (const AssetPack *pack = findAssetPack(fullPathForFilename(filepath), &relativePath)) {
+            const AssetPackEntry *entry = pack->find(relativePath);
+            return entry ? static_cast<long>(entry->rawSize) : 0;
+        }
+    }
+
     WIN32_FILE_ATTRIBUTE_DATA fad;
     if (!GetFileAttributesEx(StringUtf8ToWideChar(filepath).c_str(), GetFileExInfoStandard, &fad)) {
         return 0; // error condition, could call GetLastError to find out more
@@ -148,6 +156,10 @@ FileUtils::Status FileUtilsWin32::getContents(const std::string &filename, Resiz
     // read the file from hardware
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
 
+    FileUtils::Status packStatus;
+    if (getContentsFromAssetPack(fullPath, buffer, &packStatus))
+        return packStatus;
+
     HANDLE fileHandle = ::CreateFile(StringUtf8ToWideChar(fullPath).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, NULL, nullptr);
     if (fileHandle == INVALID_HANDLE_VALUE)
         return FileUtils::Status::OpenFailed;
@@ -253,6 +265,7 @@ bool FileUtilsWin32::renameFile(const std::string &oldfullpath, const std::strin
     }
 
     if (MoveFile(_wOld.c_str(), _wNew.c_str())) {
+        purgeMissingPaths();
         return true;
     } else {
         CC_LOG_ERROR("Fail to rename file %s to %s !Error code is 0x%x", oldfullpath.c_str(), newfullpath.c_str(), GetLastError());
@@ -317,6 +330,7 @@ bool FileUtilsWin32::createDirectory(const std::string &dirPath) {
             }
         }
     }
+    purgeMissingPaths();
     return true;
 }
 
@@ -28,6 +28,7 @@
 #include "bindings/event/CustomEventTypes.h"
 #include "bindings/event/EventDispatcher.h"
 #include "gfx-agent/DeviceAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 #include "gfx-empty/EmptyDevice.h"
 #include "gfx-validator/DeviceValidator.h"
 
@@ -59,6 +60,12 @@ public:
     static Device *create(const DeviceInfo &info) {
         Device *device = nullptr;
 
+        if (ENABLE_CAPTURE_TRACKING) {
+            DeviceCapture::enableTracking();
+        } else {
+            DeviceCapture::enableTrackingFromEnvironment();
+        }
+
 #ifdef CC_USE_VULKAN
         if (tryCreate<CCVKDevice>(info, &device)) return device;
 #endif
@@ -80,8 +87,18 @@ public:
         return nullptr;
     }
 
+    // headless device for offline tools, e.g. GFX capture replays
+    static Device *createEmpty(const DeviceInfo &info) {
+        Device *device = nullptr;
+
+        if (tryCreate<EmptyDevice>(info, &device)) return device;
+
+        return nullptr;
+    }
+
     static void destroy() {
         CC_SAFE_DESTROY(Device::instance);
+        DeviceCapture::disableTracking();
     }
 
 private:
@@ -120,6 +137,7 @@ private:
 
     static constexpr bool FORCE_DISABLE_VALIDATION{false};
     static constexpr bool FORCE_ENABLE_VALIDATION{false};
+    static constexpr bool ENABLE_CAPTURE_TRACKING{false};
 };
 
 } // namespace gfx
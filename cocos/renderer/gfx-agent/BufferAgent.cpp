@@ -29,11 +29,15 @@
 #include "BufferAgent.h"
 #include "DeviceAgent.h"
 #include "LinearAllocatorPool.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
 
 BufferAgent::~BufferAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+    DeviceAgent::getInstance()->cancelUploads(_actor);
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         BufferDestruct,
@@ -44,6 +48,8 @@ BufferAgent::~BufferAgent() {
 }
 
 void BufferAgent::doInit(const BufferInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_BUFFER, this, info);
+
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         BufferInit,
@@ -55,6 +61,8 @@ void BufferAgent::doInit(const BufferInfo &info) {
 }
 
 void BufferAgent::doInit(const BufferViewInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_BUFFER_VIEW, this, info);
+
     BufferViewInfo actorInfo = info;
     actorInfo.buffer         = static_cast<BufferAgent *>(info.buffer)->getActor();
 
@@ -69,6 +77,8 @@ void BufferAgent::doInit(const BufferViewInfo &info) {
 }
 
 void BufferAgent::doResize(uint size, uint /*count*/) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->track(CaptureOp::BUFFER_RESIZE, this, size);
+
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         BufferResize,
@@ -80,6 +90,8 @@ void BufferAgent::doResize(uint size, uint /*count*/) {
 }
 
 void BufferAgent::doDestroy() {
+    DeviceAgent::getInstance()->cancelUploads(getActor());
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         BufferDestroy,
@@ -90,6 +102,8 @@ void BufferAgent::doDestroy() {
 }
 
 void BufferAgent::update(const void *buffer, uint size) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->updateBuffer(this, buffer, size);
+
     auto *actorBuffer = DeviceAgent::getInstance()->getMainAllocator()->allocate<uint8_t>(size);
     memcpy(actorBuffer, buffer, size);
 
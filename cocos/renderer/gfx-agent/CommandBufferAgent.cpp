@@ -38,6 +38,7 @@
 #include "QueueAgent.h"
 #include "RenderPassAgent.h"
 #include "TextureAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
@@ -65,6 +66,8 @@ void CommandBufferAgent::flushCommands(uint count, CommandBufferAgent *const *cm
 }
 
 CommandBufferAgent::~CommandBufferAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+
     destroyMessageQueue();
 
     ENQUEUE_MESSAGE_1(
@@ -104,6 +107,8 @@ LinearAllocatorPool *CommandBufferAgent::getAllocator() {
 }
 
 void CommandBufferAgent::doInit(const CommandBufferInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_COMMAND_BUFFER, this, info);
+
     initMessageQueue();
 
     CommandBufferInfo actorInfo = info;
@@ -130,6 +135,8 @@ void CommandBufferAgent::doDestroy() {
 }
 
 void CommandBufferAgent::begin(RenderPass *renderPass, uint subpass, Framebuffer *frameBuffer) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_BEGIN, renderPass, subpass, frameBuffer);
+
     ENQUEUE_MESSAGE_4(
         _messageQueue,
         CommandBufferBegin,
@@ -143,6 +150,8 @@ void CommandBufferAgent::begin(RenderPass *renderPass, uint subpass, Framebuffer
 }
 
 void CommandBufferAgent::end() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_END);
+
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferEnd,
         actor, getActor(),
@@ -152,8 +161,13 @@ void CommandBufferAgent::end() {
 }
 
 void CommandBufferAgent::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, int stencil, CommandBuffer *const *secondaryCBs, uint secondaryCBCount) {
-    uint   attachmentCount = static_cast<uint>(renderPass->getColorAttachments().size());
-    Color *actorColors     = nullptr;
+    uint attachmentCount = static_cast<uint>(renderPass->getColorAttachments().size());
+    if (DeviceCapture::isTracking()) {
+        DeviceCapture::getInstance()->command(this, CaptureOp::CMD_BEGIN_RENDER_PASS, renderPass, fbo, renderArea, CaptureArray<Color>{colors, attachmentCount},
+                                              depth, stencil, CaptureArray<CommandBuffer *>{secondaryCBs, secondaryCBCount});
+    }
+
+    Color *actorColors = nullptr;
     if (attachmentCount) {
         actorColors = getAllocator()->allocate<Color>(attachmentCount);
         memcpy(actorColors, colors, sizeof(Color) * attachmentCount);
@@ -184,6 +198,8 @@ void CommandBufferAgent::beginRenderPass(RenderPass *renderPass, Framebuffer *fb
 }
 
 void CommandBufferAgent::endRenderPass() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_END_RENDER_PASS);
+
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferEndRenderPass,
         actor, getActor(),
@@ -194,6 +210,7 @@ void CommandBufferAgent::endRenderPass() {
 
 void CommandBufferAgent::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
     if (!count) return;
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_EXECUTE, CaptureArray<CommandBuffer *>{cmdBuffs, count});
 
     auto **actorCmdBuffs = getAllocator()->allocate<CommandBuffer *>(count);
     for (uint i = 0; i < count; ++i) {
@@ -211,6 +228,8 @@ void CommandBufferAgent::execute(CommandBuffer *const *cmdBuffs, uint32_t count)
 }
 
 void CommandBufferAgent::bindPipelineState(PipelineState *pso) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_BIND_PIPELINE_STATE, pso);
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferBindPipelineState,
         actor, getActor(),
@@ -221,6 +240,8 @@ void CommandBufferAgent::bindPipelineState(PipelineState *pso) {
 }
 
 void CommandBufferAgent::bindDescriptorSet(uint set, DescriptorSet *descriptorSet, uint dynamicOffsetCount, const uint *dynamicOffsets) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_BIND_DESCRIPTOR_SET, set, descriptorSet, CaptureArray<uint>{dynamicOffsets, dynamicOffsetCount});
+
     uint *actorDynamicOffsets = nullptr;
     if (dynamicOffsetCount) {
         actorDynamicOffsets = getAllocator()->allocate<uint>(dynamicOffsetCount);
@@ -240,6 +261,8 @@ void CommandBufferAgent::bindDescriptorSet(uint set, DescriptorSet *descriptorSe
 }
 
 void CommandBufferAgent::bindInputAssembler(InputAssembler *ia) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_BIND_INPUT_ASSEMBLER, ia);
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferBindInputAssembler,
         actor, getActor(),
@@ -250,6 +273,8 @@ void CommandBufferAgent::bindInputAssembler(InputAssembler *ia) {
 }
 
 void CommandBufferAgent::setViewport(const Viewport &vp) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_SET_VIEWPORT, vp);
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetViewport,
         actor, getActor(),
@@ -260,6 +285,8 @@ void CommandBufferAgent::setViewport(const Viewport &vp) {
 }
 
 void CommandBufferAgent::setScissor(const Rect &rect) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_SET_SCISSOR, rect);
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetScissor,
         actor, getActor(),
@@ -270,6 +297,8 @@ void CommandBufferAgent::setScissor(const Rect &rect) {
 }
 
 void CommandBufferAgent::setLineWidth(float width) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_SET_LINE_WIDTH, width);
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetLineWidth,
         actor, getActor(),
@@ -280,6 +309,8 @@ void CommandBufferAgent::setLineWidth(float width) {
 }
 
 void CommandBufferAgent::setDepthBias(float constant, float clamp, float slope) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_SET_DEPTH_BIAS, constant, clamp, slope);
+
     ENQUEUE_MESSAGE_4(
         _messageQueue, CommandBufferSetDepthBias,
         actor, getActor(),
@@ -292,6 +323,8 @@ void CommandBufferAgent::setDepthBias(float constant, float clamp, float slope)
 }
 
 void CommandBufferAgent::setBlendConstants(const Color &constants) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_SET_BLEND_CONSTANTS, constants);
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetBlendConstants,
         actor, getActor(),
@@ -302,6 +335,8 @@ void CommandBufferAgent::setBlendConstants(const Color &constants) {
 }
 
 void CommandBufferAgent::setDepthBound(float minBounds, float maxBounds) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_SET_DEPTH_BOUND, minBounds, maxBounds);
+
     ENQUEUE_MESSAGE_3(
         _messageQueue, CommandBufferSetDepthBound,
         actor, getActor(),
@@ -313,6 +348,8 @@ void CommandBufferAgent::setDepthBound(float minBounds, float maxBounds) {
 }
 
 void CommandBufferAgent::setStencilWriteMask(StencilFace face, uint mask) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_SET_STENCIL_WRITE_MASK, face, mask);
+
     ENQUEUE_MESSAGE_3(
         _messageQueue, CommandBufferSetStencilWriteMask,
         actor, getActor(),
@@ -324,6 +361,8 @@ void CommandBufferAgent::setStencilWriteMask(StencilFace face, uint mask) {
 }
 
 void CommandBufferAgent::setStencilCompareMask(StencilFace face, int ref, uint mask) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_SET_STENCIL_COMPARE_MASK, face, ref, mask);
+
     ENQUEUE_MESSAGE_4(
         _messageQueue, CommandBufferSetStencilCompareMask,
         actor, getActor(),
@@ -336,6 +375,8 @@ void CommandBufferAgent::setStencilCompareMask(StencilFace face, int ref, uint m
 }
 
 void CommandBufferAgent::nextSubpass() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_NEXT_SUBPASS);
+
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferNextSubpass,
         actor, getActor(),
@@ -345,6 +386,8 @@ void CommandBufferAgent::nextSubpass() {
 }
 
 void CommandBufferAgent::draw(const DrawInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_DRAW, info);
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferDraw,
         actor, getActor(),
@@ -355,6 +398,8 @@ void CommandBufferAgent::draw(const DrawInfo &info) {
 }
 
 void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint size) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_UPDATE_BUFFER, buff, CaptureBlob{static_cast<const uint8_t *>(data), size});
+
     MessageQueue *queue = _messageQueue;
 
     auto *actorData = getAllocator()->allocate<uint8_t>(size);
@@ -372,6 +417,8 @@ void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint size)
 }
 
 void CommandBufferAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint count) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->copyBuffersToTexture(this, buffers, texture, regions, count);
+
     LinearAllocatorPool *allocator = getAllocator();
 
     auto *actorRegions = allocator->allocate<BufferTextureCopy>(count);
@@ -405,6 +452,8 @@ void CommandBufferAgent::copyBuffersToTexture(const uint8_t *const *buffers, Tex
 }
 
 void CommandBufferAgent::blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint count, Filter filter) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_BLIT_TEXTURE, srcTexture, dstTexture, CaptureArray<TextureBlit>{regions, count}, filter);
+
     Texture *actorSrcTexture = nullptr;
     Texture *actorDstTexture = nullptr;
     if (srcTexture) actorSrcTexture = static_cast<TextureAgent *>(srcTexture)->getActor();
@@ -427,6 +476,8 @@ void CommandBufferAgent::blitTexture(Texture *srcTexture, Texture *dstTexture, c
 }
 
 void CommandBufferAgent::dispatch(const DispatchInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->command(this, CaptureOp::CMD_DISPATCH, info);
+
     DispatchInfo actorInfo = info;
     if (info.indirectBuffer) actorInfo.indirectBuffer = static_cast<BufferAgent *>(info.indirectBuffer)->getActor();
 
@@ -440,6 +491,8 @@ void CommandBufferAgent::dispatch(const DispatchInfo &info) {
 }
 
 void CommandBufferAgent::pipelineBarrier(const GlobalBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint textureBarrierCount) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->pipelineBarrier(this, barrier, textureBarriers, textures, textureBarrierCount);
+
     TextureBarrier **actorTextureBarriers = nullptr;
     Texture **       actorTextures        = nullptr;
 
@@ -465,5 +518,27 @@ void CommandBufferAgent::pipelineBarrier(const GlobalBarrier *barrier, const Tex
         });
 }
 
+void CommandBufferAgent::beginTimingScope(const String &name) {
+    auto *actorName = getAllocator()->allocate<char>(static_cast<uint>(name.size()) + 1);
+    memcpy(actorName, name.c_str(), name.size() + 1);
+
+    ENQUEUE_MESSAGE_2(
+        _messageQueue, CommandBufferBeginTimingScope,
+        actor, getActor(),
+        name, actorName,
+        {
+            actor->beginTimingScope(name);
+        });
+}
+
+void CommandBufferAgent::endTimingScope() {
+    ENQUEUE_MESSAGE_1(
+        _messageQueue, CommandBufferEndTimingScope,
+        actor, getActor(),
+        {
+            actor->endTimingScope();
+        });
+}
+
 } // namespace gfx
 } // namespace cc
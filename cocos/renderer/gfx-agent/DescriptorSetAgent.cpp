@@ -32,11 +32,14 @@
 #include "DeviceAgent.h"
 #include "SamplerAgent.h"
 #include "TextureAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
 
 DescriptorSetAgent::~DescriptorSetAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         DescriptorSetDestruct,
@@ -47,6 +50,8 @@ DescriptorSetAgent::~DescriptorSetAgent() {
 }
 
 void DescriptorSetAgent::doInit(const DescriptorSetInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_DESCRIPTOR_SET, this, info);
+
     DescriptorSetInfo actorInfo;
     actorInfo.layout = static_cast<DescriptorSetLayoutAgent *>(info.layout)->getActor();
 
@@ -72,6 +77,7 @@ void DescriptorSetAgent::doDestroy() {
 
 void DescriptorSetAgent::update() {
     _isDirty = false;
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->record(CaptureOp::DESCRIPTOR_SET_UPDATE, this);
 
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
@@ -84,6 +90,7 @@ void DescriptorSetAgent::update() {
 
 void DescriptorSetAgent::bindBuffer(uint binding, Buffer *buffer, uint index) {
     DescriptorSet::bindBuffer(binding, buffer, index);
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->record(CaptureOp::DESCRIPTOR_SET_BIND_BUFFER, this, binding, buffer, index);
 
     ENQUEUE_MESSAGE_4(
         DeviceAgent::getInstance()->getMessageQueue(),
@@ -99,6 +106,7 @@ void DescriptorSetAgent::bindBuffer(uint binding, Buffer *buffer, uint index) {
 
 void DescriptorSetAgent::bindTexture(uint binding, Texture *texture, uint index) {
     DescriptorSet::bindTexture(binding, texture, index);
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->record(CaptureOp::DESCRIPTOR_SET_BIND_TEXTURE, this, binding, texture, index);
 
     ENQUEUE_MESSAGE_4(
         DeviceAgent::getInstance()->getMessageQueue(),
@@ -114,6 +122,7 @@ void DescriptorSetAgent::bindTexture(uint binding, Texture *texture, uint index)
 
 void DescriptorSetAgent::bindSampler(uint binding, Sampler *sampler, uint index) {
     DescriptorSet::bindSampler(binding, sampler, index);
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->record(CaptureOp::DESCRIPTOR_SET_BIND_SAMPLER, this, binding, sampler, index);
 
     ENQUEUE_MESSAGE_4(
         DeviceAgent::getInstance()->getMessageQueue(),
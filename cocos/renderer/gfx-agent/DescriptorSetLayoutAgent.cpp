@@ -28,11 +28,14 @@
 
 #include "DeviceAgent.h"
 #include "DescriptorSetLayoutAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
 
 DescriptorSetLayoutAgent::~DescriptorSetLayoutAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         DescriptorSetLayoutDestruct,
@@ -43,6 +46,8 @@ DescriptorSetLayoutAgent::~DescriptorSetLayoutAgent() {
 }
 
 void DescriptorSetLayoutAgent::doInit(const DescriptorSetLayoutInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_DESCRIPTOR_SET_LAYOUT, this, info);
+
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         DescriptorSetLayoutInit,
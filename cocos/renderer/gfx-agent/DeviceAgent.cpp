@@ -41,6 +41,7 @@
 #include "SamplerAgent.h"
 #include "ShaderAgent.h"
 #include "TextureAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
@@ -84,12 +85,23 @@ bool DeviceAgent::doInit(const DeviceInfo &info) {
     }
     static_cast<CommandBufferAgent *>(_cmdBuff)->initMessageQueue();
 
+    if (DeviceCapture::isTracking()) {
+        DeviceCapture::getInstance()->create(CaptureOp::DEVICE_QUEUE, _queue);
+        DeviceCapture::getInstance()->create(CaptureOp::DEVICE_COMMAND_BUFFER, _cmdBuff);
+    }
+
     setMultithreaded(true);
 
     return true;
 }
 
 void DeviceAgent::doDestroy() {
+    for (PendingUpload *upload : _pendingUploads) {
+        releaseUpload(upload);
+    }
+    _pendingUploads.clear();
+    _completedUploads.clear();
+
     ENQUEUE_MESSAGE_1(
         getMessageQueue(), DeviceDestroy,
         actor, getActor(),
@@ -119,6 +131,8 @@ void DeviceAgent::doDestroy() {
 }
 
 void DeviceAgent::resize(uint width, uint height) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->resize(width, height);
+
     ENQUEUE_MESSAGE_3(
         getMessageQueue(), DeviceResize,
         actor, getActor(),
@@ -130,6 +144,9 @@ void DeviceAgent::resize(uint width, uint height) {
 }
 
 void DeviceAgent::acquire() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->acquire();
+    flushUploads();
+
     ENQUEUE_MESSAGE_1(
         _mainEncoder, DeviceAcquire,
         actor, getActor(),
@@ -139,12 +156,19 @@ void DeviceAgent::acquire() {
 }
 
 void DeviceAgent::present() {
-    ENQUEUE_MESSAGE_2(
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->present();
+
+    ENQUEUE_MESSAGE_3(
         _mainEncoder, DevicePresent,
         actor, getActor(),
+        agent, this,
         frameBoundarySemaphore, &_frameBoundarySemaphore,
         {
             actor->present();
+            if (!actor->getTimingScopes().empty()) {
+                std::lock_guard<std::mutex> lock(agent->_timingScopesMutex);
+                agent->_resolvedTimingScopes = actor->getTimingScopes();
+            }
             frameBoundarySemaphore->signal();
         });
 
@@ -153,6 +177,14 @@ void DeviceAgent::present() {
     _currentIndex = (_currentIndex + 1) % (MAX_CPU_FRAME_AHEAD + 1);
     _frameBoundarySemaphore.wait();
 
+    {
+        std::lock_guard<std::mutex> lock(_timingScopesMutex);
+        if (!_resolvedTimingScopes.empty()) {
+            _timingScopes.swap(_resolvedTimingScopes);
+            _resolvedTimingScopes.clear();
+        }
+    }
+
     getMainAllocator()->reset();
     for (CommandBufferAgent *cmdBuff : _cmdBuffRefs) {
         cmdBuff->_allocatorPools[_currentIndex]->reset();
@@ -288,6 +320,8 @@ TextureBarrier *DeviceAgent::createTextureBarrier() {
 }
 
 void DeviceAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->copyBuffersToTexture(buffers, dst, regions, count);
+
     LinearAllocatorPool *allocator = getMainAllocator();
 
     auto *actorRegions = allocator->allocate<BufferTextureCopy>(count);
@@ -320,7 +354,117 @@ void DeviceAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *d
         });
 }
 
+void DeviceAgent::copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) {
+    // captures see streamed uploads as plain copies issued in order
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->copyBuffersToTexture(buffers, dst, regions, count);
+
+    // this is where the decoding thread pays for the staging copy, not the render thread
+    PendingUpload *upload = stageUpload(buffers, static_cast<TextureAgent *>(dst)->getActor(), regions, count, callback);
+
+    std::lock_guard<std::mutex> lock(_uploadMutex);
+    _pendingUploads.push_back(upload);
+}
+
+void DeviceAgent::updateBufferAsync(Buffer *buff, const void *data, uint size, const UploadCallback &callback) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->updateBuffer(buff, data, size);
+
+    PendingUpload *upload = stageUpload(static_cast<BufferAgent *>(buff)->getActor(), data, size, callback);
+
+    std::lock_guard<std::mutex> lock(_uploadMutex);
+    _pendingUploads.push_back(upload);
+}
+
+// The pending uploads refer to actors, called from the main thread before their destruction is enqueued
+void DeviceAgent::cancelUploads(const GFXObject *object) {
+    std::lock_guard<std::mutex> lock(_uploadMutex);
+    for (auto iter = _pendingUploads.begin(); iter != _pendingUploads.end();) {
+        PendingUpload *upload = *iter;
+        if (upload->texture == object || upload->buffer == object) {
+            releaseUpload(upload);
+            iter = _pendingUploads.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void DeviceAgent::setUploadBudget(uint bytesPerFrame) {
+    _uploadBudget = bytesPerFrame;
+
+    ENQUEUE_MESSAGE_2(
+        _mainEncoder, DeviceSetUploadBudget,
+        actor, getActor(),
+        bytesPerFrame, bytesPerFrame,
+        {
+            actor->setUploadBudget(bytesPerFrame);
+        });
+}
+
+void DeviceAgent::onUploadCompleted(const UploadCallback &callback) {
+    std::lock_guard<std::mutex> lock(_uploadMutex);
+    _completedUploads.push_back(callback);
+}
+
+void DeviceAgent::flushUploads() {
+    vector<PendingUpload *> &uploads = _flushedUploads;
+    uploads.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(_uploadMutex);
+
+        uint bytes = 0U;
+        while (!_pendingUploads.empty()) {
+            PendingUpload *upload = _pendingUploads.front();
+            if (bytes && bytes + upload->size > _uploadBudget) break;
+            bytes += upload->size;
+            uploads.push_back(upload);
+            _pendingUploads.pop_front();
+        }
+
+        _uploadCallbacks.swap(_completedUploads);
+    }
+
+    for (const UploadCallback &callback : _uploadCallbacks) {
+        callback();
+    }
+    _uploadCallbacks.clear();
+
+    for (PendingUpload *upload : uploads) {
+        UploadCallback callback;
+        if (upload->callback) {
+            callback = [this, userCallback = upload->callback]() {
+                onUploadCompleted(userCallback);
+            };
+        }
+
+        if (upload->texture) {
+            ENQUEUE_MESSAGE_3(
+                _mainEncoder, DeviceCopyBuffersToTextureAsync,
+                actor, getActor(),
+                upload, upload,
+                callback, callback,
+                {
+                    actor->copyBuffersToTextureAsync(upload->buffers.data(), upload->texture, upload->regions.data(),
+                                                     utils::toUint(upload->regions.size()), callback);
+                    releaseUpload(upload);
+                });
+        } else {
+            ENQUEUE_MESSAGE_3(
+                _mainEncoder, DeviceUpdateBufferAsync,
+                actor, getActor(),
+                upload, upload,
+                callback, callback,
+                {
+                    actor->updateBufferAsync(upload->buffer, upload->data, upload->size, callback);
+                    releaseUpload(upload);
+                });
+        }
+    }
+}
+
 void DeviceAgent::flushCommands(CommandBuffer *const *cmdBuffs, uint count) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->flushCommands(cmdBuffs, count);
+
     if (!_multithreaded) return; // all command buffers are immediately executed
 
     bool multiThreaded = hasFeature(Feature::MULTITHREADED_SUBMISSION);
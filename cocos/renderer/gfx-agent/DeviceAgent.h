@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "base/Agent.h"
 #include "base/threading/Semaphore.h"
 #include "gfx-base/GFXDevice.h"
@@ -83,6 +85,10 @@ public:
     GlobalBarrier *      createGlobalBarrier() override;
     TextureBarrier *     createTextureBarrier() override;
     void                 copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) override;
+    void                 copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) override;
+    void                 updateBufferAsync(Buffer *buff, const void *data, uint size, const UploadCallback &callback) override;
+    void                 setUploadBudget(uint bytesPerFrame) override;
+    void                 cancelUploads(const GFXObject *object) override;
 
     void             flushCommands(CommandBuffer *const *cmdBuffs, uint count) override;
     void             setMultithreaded(bool multithreaded) override;
@@ -113,6 +119,10 @@ protected:
     void releaseSurface(uintptr_t windowHandle) override;
     void acquireSurface(uintptr_t windowHandle) override;
 
+    // uploads are staged on the issuing thread, and submitted to the actor within the per-frame budget
+    void flushUploads();
+    void onUploadCompleted(const UploadCallback &callback);
+
     bool          _multithreaded{false};
     MessageQueue *_mainEncoder{nullptr};
 
@@ -121,6 +131,16 @@ protected:
     Semaphore                     _frameBoundarySemaphore{MAX_CPU_FRAME_AHEAD};
 
     unordered_set<CommandBufferAgent *> _cmdBuffRefs;
+
+    std::mutex                  _uploadMutex;
+    std::deque<PendingUpload *> _pendingUploads;
+    vector<PendingUpload *>     _flushedUploads;
+    vector<UploadCallback>      _completedUploads;
+    vector<UploadCallback>      _uploadCallbacks;
+
+    // written by the actor after presenting, picked up at the frame boundary
+    std::mutex      _timingScopesMutex;
+    TimingScopeList _resolvedTimingScopes;
 };
 
 } // namespace gfx
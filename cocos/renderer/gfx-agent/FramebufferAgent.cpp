@@ -30,11 +30,14 @@
 #include "FramebufferAgent.h"
 #include "RenderPassAgent.h"
 #include "TextureAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
 
 FramebufferAgent::~FramebufferAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         FramebufferDestruct,
@@ -45,6 +48,8 @@ FramebufferAgent::~FramebufferAgent() {
 }
 
 void FramebufferAgent::doInit(const FramebufferInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_FRAMEBUFFER, this, info);
+
     FramebufferInfo actorInfo = info;
     for (uint i = 0u; i < info.colorTextures.size(); ++i) {
         if (info.colorTextures[i]) {
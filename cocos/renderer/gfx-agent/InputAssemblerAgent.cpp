@@ -29,11 +29,14 @@
 #include "BufferAgent.h"
 #include "DeviceAgent.h"
 #include "InputAssemblerAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
 
 InputAssemblerAgent::~InputAssemblerAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         InputAssemblerDestruct,
@@ -44,6 +47,8 @@ InputAssemblerAgent::~InputAssemblerAgent() {
 }
 
 void InputAssemblerAgent::doInit(const InputAssemblerInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_INPUT_ASSEMBLER, this, info);
+
     InputAssemblerInfo actorInfo = info;
     for (uint i = 0u; i < actorInfo.vertexBuffers.size(); ++i) {
         actorInfo.vertexBuffers[i] = static_cast<BufferAgent *>(actorInfo.vertexBuffers[i])->getActor();
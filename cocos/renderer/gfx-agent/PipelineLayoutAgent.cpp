@@ -29,11 +29,14 @@
 #include "DescriptorSetLayoutAgent.h"
 #include "DeviceAgent.h"
 #include "PipelineLayoutAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
 
 PipelineLayoutAgent::~PipelineLayoutAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         PipelineLayoutDestruct,
@@ -44,6 +47,8 @@ PipelineLayoutAgent::~PipelineLayoutAgent() {
 }
 
 void PipelineLayoutAgent::doInit(const PipelineLayoutInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_PIPELINE_LAYOUT, this, info);
+
     PipelineLayoutInfo actorInfo;
     actorInfo.setLayouts.resize(info.setLayouts.size());
     for (uint i = 0u; i < info.setLayouts.size(); i++) {
@@ -31,11 +31,14 @@
 #include "PipelineStateAgent.h"
 #include "RenderPassAgent.h"
 #include "ShaderAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
 
 PipelineStateAgent::~PipelineStateAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         PipelineStateDestruct,
@@ -46,6 +49,8 @@ PipelineStateAgent::~PipelineStateAgent() {
 }
 
 void PipelineStateAgent::doInit(const PipelineStateInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_PIPELINE_STATE, this, info);
+
     PipelineStateInfo actorInfo = info;
     actorInfo.shader = static_cast<ShaderAgent *>(info.shader)->getActor();
     actorInfo.pipelineLayout = static_cast<PipelineLayoutAgent *>(info.pipelineLayout)->getActor();
@@ -31,11 +31,14 @@
 #include "DeviceAgent.h"
 #include "LinearAllocatorPool.h"
 #include "QueueAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
 
 QueueAgent::~QueueAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         QueueDestruct,
@@ -46,6 +49,8 @@ QueueAgent::~QueueAgent() {
 }
 
 void QueueAgent::doInit(const QueueInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_QUEUE, this, info);
+
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         QueueInit,
@@ -68,6 +73,7 @@ void QueueAgent::doDestroy() {
 
 void QueueAgent::submit(CommandBuffer *const *cmdBuffs, uint count) {
     if (!count) return;
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->submit(this, cmdBuffs, count);
 
     LinearAllocatorPool *allocator     = DeviceAgent::getInstance()->getMainAllocator();
     CommandBuffer **     actorCmdBuffs = allocator->allocate<CommandBuffer *>(count);
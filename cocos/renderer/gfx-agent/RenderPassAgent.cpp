@@ -28,11 +28,14 @@
 
 #include "DeviceAgent.h"
 #include "RenderPassAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
 
 RenderPassAgent::~RenderPassAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         RenderPassDestruct,
@@ -43,6 +46,8 @@ RenderPassAgent::~RenderPassAgent() {
 }
 
 void RenderPassAgent::doInit(const RenderPassInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_RENDER_PASS, this, info);
+
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         RenderPassInit,
@@ -29,11 +29,14 @@
 #include "DescriptorSetLayoutAgent.h"
 #include "DeviceAgent.h"
 #include "SamplerAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
 
 SamplerAgent::~SamplerAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         SamplerDestruct,
@@ -44,6 +47,8 @@ SamplerAgent::~SamplerAgent() {
 }
 
 void SamplerAgent::doInit(const SamplerInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_SAMPLER, this, info);
+
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         SamplerInit,
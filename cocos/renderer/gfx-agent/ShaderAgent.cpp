@@ -28,11 +28,14 @@
 
 #include "DeviceAgent.h"
 #include "ShaderAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
 
 ShaderAgent::~ShaderAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         ShaderDestruct,
@@ -43,6 +46,8 @@ ShaderAgent::~ShaderAgent() {
 }
 
 void ShaderAgent::doInit(const ShaderInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_SHADER, this, info);
+
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         ShaderInit,
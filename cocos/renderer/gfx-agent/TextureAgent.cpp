@@ -28,11 +28,15 @@
 
 #include "DeviceAgent.h"
 #include "TextureAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 
 namespace cc {
 namespace gfx {
 
 TextureAgent::~TextureAgent() {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->destroy(this);
+    DeviceAgent::getInstance()->cancelUploads(_actor);
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         TextureDestruct,
@@ -43,6 +47,8 @@ TextureAgent::~TextureAgent() {
 }
 
 void TextureAgent::doInit(const TextureInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_TEXTURE, this, info);
+
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         TextureInit,
@@ -54,6 +60,8 @@ void TextureAgent::doInit(const TextureInfo &info) {
 }
 
 void TextureAgent::doInit(const TextureViewInfo &info) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->create(CaptureOp::CREATE_TEXTURE_VIEW, this, info);
+
     TextureViewInfo actorInfo = info;
     actorInfo.texture         = static_cast<TextureAgent *>(info.texture)->getActor();
 
@@ -68,6 +76,8 @@ void TextureAgent::doInit(const TextureViewInfo &info) {
 }
 
 void TextureAgent::doDestroy() {
+    DeviceAgent::getInstance()->cancelUploads(getActor());
+
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         TextureDestroy,
@@ -78,6 +88,8 @@ void TextureAgent::doDestroy() {
 }
 
 void TextureAgent::doResize(uint width, uint height, uint size) {
+    if (DeviceCapture::isTracking()) DeviceCapture::getInstance()->track(CaptureOp::TEXTURE_RESIZE, this, width, height);
+
     ENQUEUE_MESSAGE_3(
         DeviceAgent::getInstance()->getMessageQueue(),
         TextureResize,
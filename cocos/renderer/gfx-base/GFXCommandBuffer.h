@@ -65,6 +65,10 @@ public:
     virtual void dispatch(const DispatchInfo &info)                                                                                                                                                          = 0;
     virtual void pipelineBarrier(const GlobalBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint textureBarrierCount)                                       = 0;
 
+    // Scopes may nest, GPU durations are resolved asynchronously and show up in Device::getTimingScopes a few frames later.
+    virtual void beginTimingScope(const String &name) {}
+    virtual void endTimingScope() {}
+
     inline void begin();
     inline void begin(RenderPass *renderPass);
     inline void begin(RenderPass *renderPass, uint subpass);
@@ -0,0 +1,240 @@
+/****************************************************************************
+ Copyright (c) 2019-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CoreStd.h"
+
+#include "GFXCommandBundle.h"
+
+namespace cc {
+namespace gfx {
+
+CommandBundle::~CommandBundle() {
+    destroy();
+}
+
+void CommandBundle::doInit(const CommandBufferInfo & /*info*/) {
+}
+
+void CommandBundle::doDestroy() {
+    clear();
+    _isRecording = false;
+}
+
+void CommandBundle::clear() {
+    _cmds.clear();
+    _pipelineStates.clear();
+    _descriptorSets.clear();
+    _dynamicOffsets.clear();
+    _inputAssemblers.clear();
+    _viewports.clear();
+    _scissors.clear();
+    _floats.clear();
+    _colors.clear();
+    _stencilCmds.clear();
+    _drawInfos.clear();
+
+    _numDrawCalls = 0;
+    _numInstances = 0;
+    _numTriangles = 0;
+}
+
+void CommandBundle::begin(RenderPass * /*renderPass*/, uint /*subpass*/, Framebuffer * /*frameBuffer*/) {
+    // capacities are kept, so re-recording a bundle of similar size is allocation-free
+    clear();
+    _isRecording = true;
+}
+
+void CommandBundle::end() {
+    _isRecording = false;
+}
+
+void CommandBundle::beginRenderPass(RenderPass * /*renderPass*/, Framebuffer * /*fbo*/, const Rect & /*renderArea*/, const Color * /*colors*/, float /*depth*/, int /*stencil*/, CommandBuffer *const * /*secondaryCBs*/, uint /*secondaryCBCount*/) {
+    CCASSERT(false, "Command 'beginRenderPass' cannot be recorded in command bundles.");
+}
+
+void CommandBundle::endRenderPass() {
+    CCASSERT(false, "Command 'endRenderPass' cannot be recorded in command bundles.");
+}
+
+void CommandBundle::bindPipelineState(PipelineState *pso) {
+    _pipelineStates.push_back(pso);
+    _cmds.push_back(CmdType::BIND_PIPELINE_STATE);
+}
+
+void CommandBundle::bindDescriptorSet(uint set, DescriptorSet *descriptorSet, uint dynamicOffsetCount, const uint *dynamicOffsets) {
+    _descriptorSets.push_back({set, descriptorSet, utils::toUint(_dynamicOffsets.size()), dynamicOffsetCount});
+    _dynamicOffsets.insert(_dynamicOffsets.end(), dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
+    _cmds.push_back(CmdType::BIND_DESCRIPTOR_SET);
+}
+
+void CommandBundle::bindInputAssembler(InputAssembler *ia) {
+    _inputAssemblers.push_back(ia);
+    _cmds.push_back(CmdType::BIND_INPUT_ASSEMBLER);
+}
+
+void CommandBundle::setViewport(const Viewport &vp) {
+    _viewports.push_back(vp);
+    _cmds.push_back(CmdType::SET_VIEWPORT);
+}
+
+void CommandBundle::setScissor(const Rect &rect) {
+    _scissors.push_back(rect);
+    _cmds.push_back(CmdType::SET_SCISSOR);
+}
+
+void CommandBundle::setLineWidth(float width) {
+    _floats.push_back(width);
+    _cmds.push_back(CmdType::SET_LINE_WIDTH);
+}
+
+void CommandBundle::setDepthBias(float constant, float clamp, float slope) {
+    _floats.push_back(constant);
+    _floats.push_back(clamp);
+    _floats.push_back(slope);
+    _cmds.push_back(CmdType::SET_DEPTH_BIAS);
+}
+
+void CommandBundle::setBlendConstants(const Color &constants) {
+    _colors.push_back(constants);
+    _cmds.push_back(CmdType::SET_BLEND_CONSTANTS);
+}
+
+void CommandBundle::setDepthBound(float minBounds, float maxBounds) {
+    _floats.push_back(minBounds);
+    _floats.push_back(maxBounds);
+    _cmds.push_back(CmdType::SET_DEPTH_BOUND);
+}
+
+void CommandBundle::setStencilWriteMask(StencilFace face, uint mask) {
+    _stencilCmds.push_back({face, 0, mask});
+    _cmds.push_back(CmdType::SET_STENCIL_WRITE_MASK);
+}
+
+void CommandBundle::setStencilCompareMask(StencilFace face, int ref, uint mask) {
+    _stencilCmds.push_back({face, ref, mask});
+    _cmds.push_back(CmdType::SET_STENCIL_COMPARE_MASK);
+}
+
+void CommandBundle::nextSubpass() {
+    CCASSERT(false, "Command 'nextSubpass' cannot be recorded in command bundles.");
+}
+
+void CommandBundle::draw(const DrawInfo &info) {
+    _drawInfos.push_back(info);
+    _cmds.push_back(CmdType::DRAW);
+
+    ++_numDrawCalls;
+    _numInstances += info.instanceCount;
+}
+
+void CommandBundle::updateBuffer(Buffer * /*buff*/, const void * /*data*/, uint /*size*/) {
+    CCASSERT(false, "Command 'updateBuffer' cannot be recorded in command bundles.");
+}
+
+void CommandBundle::copyBuffersToTexture(const uint8_t *const * /*buffers*/, Texture * /*texture*/, const BufferTextureCopy * /*regions*/, uint /*count*/) {
+    CCASSERT(false, "Command 'copyBuffersToTexture' cannot be recorded in command bundles.");
+}
+
+void CommandBundle::blitTexture(Texture * /*srcTexture*/, Texture * /*dstTexture*/, const TextureBlit * /*regions*/, uint /*count*/, Filter /*filter*/) {
+    CCASSERT(false, "Command 'blitTexture' cannot be recorded in command bundles.");
+}
+
+void CommandBundle::execute(CommandBuffer *const * /*cmdBuffs*/, uint32_t /*count*/) {
+    CCASSERT(false, "Command 'execute' cannot be recorded in command bundles.");
+}
+
+void CommandBundle::dispatch(const DispatchInfo & /*info*/) {
+    CCASSERT(false, "Command 'dispatch' cannot be recorded in command bundles.");
+}
+
+void CommandBundle::pipelineBarrier(const GlobalBarrier * /*barrier*/, const TextureBarrier *const * /*textureBarriers*/, const Texture *const * /*textures*/, uint /*textureBarrierCount*/) {
+    CCASSERT(false, "Command 'pipelineBarrier' cannot be recorded in command bundles.");
+}
+
+void CommandBundle::replay(CommandBuffer *cmdBuff) const {
+    CCASSERT(!_isRecording, "Command bundle is still being recorded");
+
+    uint pipelineStateIdx  = 0U;
+    uint descriptorSetIdx  = 0U;
+    uint inputAssemblerIdx = 0U;
+    uint viewportIdx       = 0U;
+    uint scissorIdx        = 0U;
+    uint floatIdx          = 0U;
+    uint colorIdx          = 0U;
+    uint stencilIdx        = 0U;
+    uint drawInfoIdx       = 0U;
+
+    for (const CmdType cmd : _cmds) {
+        switch (cmd) {
+            case CmdType::BIND_PIPELINE_STATE:
+                cmdBuff->bindPipelineState(_pipelineStates[pipelineStateIdx++]);
+                break;
+            case CmdType::BIND_DESCRIPTOR_SET: {
+                const DescriptorSetCmd &ds = _descriptorSets[descriptorSetIdx++];
+                cmdBuff->bindDescriptorSet(ds.set, ds.descriptorSet, ds.dynamicOffsetCount, ds.dynamicOffsetCount ? &_dynamicOffsets[ds.dynamicOffsetIndex] : nullptr);
+                break;
+            }
+            case CmdType::BIND_INPUT_ASSEMBLER:
+                cmdBuff->bindInputAssembler(_inputAssemblers[inputAssemblerIdx++]);
+                break;
+            case CmdType::SET_VIEWPORT:
+                cmdBuff->setViewport(_viewports[viewportIdx++]);
+                break;
+            case CmdType::SET_SCISSOR:
+                cmdBuff->setScissor(_scissors[scissorIdx++]);
+                break;
+            case CmdType::SET_LINE_WIDTH:
+                cmdBuff->setLineWidth(_floats[floatIdx++]);
+                break;
+            case CmdType::SET_DEPTH_BIAS:
+                cmdBuff->setDepthBias(_floats[floatIdx], _floats[floatIdx + 1], _floats[floatIdx + 2]);
+                floatIdx += 3;
+                break;
+            case CmdType::SET_BLEND_CONSTANTS:
+                cmdBuff->setBlendConstants(_colors[colorIdx++]);
+                break;
+            case CmdType::SET_DEPTH_BOUND:
+                cmdBuff->setDepthBound(_floats[floatIdx], _floats[floatIdx + 1]);
+                floatIdx += 2;
+                break;
+            case CmdType::SET_STENCIL_WRITE_MASK: {
+                const StencilCmd &stencil = _stencilCmds[stencilIdx++];
+                cmdBuff->setStencilWriteMask(stencil.face, stencil.mask);
+                break;
+            }
+            case CmdType::SET_STENCIL_COMPARE_MASK: {
+                const StencilCmd &stencil = _stencilCmds[stencilIdx++];
+                cmdBuff->setStencilCompareMask(stencil.face, stencil.ref, stencil.mask);
+                break;
+            }
+            case CmdType::DRAW:
+                cmdBuff->draw(_drawInfos[drawInfoIdx++]);
+                break;
+        }
+    }
+}
+
+} // namespace gfx
+} // namespace cc
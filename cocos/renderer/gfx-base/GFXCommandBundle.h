@@ -0,0 +1,125 @@
+/****************************************************************************
+ Copyright (c) 2019-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "GFXCommandBuffer.h"
+
+namespace cc {
+namespace gfx {
+
+/**
+ * A backend-agnostic command buffer of type BUNDLE.
+ * Render pass contents are logged once and replayed into the executing
+ * primary command buffer every time it is executed, until re-recorded.
+ * Used by backends whose native secondary command buffers cannot be reused
+ * across frames, or cannot be mixed with inline commands inside one subpass.
+ */
+class CC_DLL CommandBundle final : public CommandBuffer {
+public:
+    CommandBundle() = default;
+    ~CommandBundle() override;
+
+    void begin(RenderPass *renderPass, uint subpass, Framebuffer *frameBuffer) override;
+    void end() override;
+    void beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, int stencil, CommandBuffer *const *secondaryCBs, uint secondaryCBCount) override;
+    void endRenderPass() override;
+    void bindPipelineState(PipelineState *pso) override;
+    void bindDescriptorSet(uint set, DescriptorSet *descriptorSet, uint dynamicOffsetCount, const uint *dynamicOffsets) override;
+    void bindInputAssembler(InputAssembler *ia) override;
+    void setViewport(const Viewport &vp) override;
+    void setScissor(const Rect &rect) override;
+    void setLineWidth(float width) override;
+    void setDepthBias(float constant, float clamp, float slope) override;
+    void setBlendConstants(const Color &constants) override;
+    void setDepthBound(float minBounds, float maxBounds) override;
+    void setStencilWriteMask(StencilFace face, uint mask) override;
+    void setStencilCompareMask(StencilFace face, int ref, uint mask) override;
+    void nextSubpass() override;
+    void draw(const DrawInfo &info) override;
+    void updateBuffer(Buffer *buff, const void *data, uint size) override;
+    void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint count) override;
+    void blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint count, Filter filter) override;
+    void execute(CommandBuffer *const *cmdBuffs, uint32_t count) override;
+    void dispatch(const DispatchInfo &info) override;
+    void pipelineBarrier(const GlobalBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint textureBarrierCount) override;
+
+    // record all the logged commands into the specified command buffer
+    void replay(CommandBuffer *cmdBuff) const;
+
+    inline bool isRecording() const { return _isRecording; }
+    inline bool empty() const { return _cmds.empty(); }
+
+protected:
+    void doInit(const CommandBufferInfo &info) override;
+    void doDestroy() override;
+
+    void clear();
+
+    enum class CmdType : uint8_t {
+        BIND_PIPELINE_STATE,
+        BIND_DESCRIPTOR_SET,
+        BIND_INPUT_ASSEMBLER,
+        SET_VIEWPORT,
+        SET_SCISSOR,
+        SET_LINE_WIDTH,
+        SET_DEPTH_BIAS,
+        SET_BLEND_CONSTANTS,
+        SET_DEPTH_BOUND,
+        SET_STENCIL_WRITE_MASK,
+        SET_STENCIL_COMPARE_MASK,
+        DRAW,
+    };
+
+    struct DescriptorSetCmd {
+        uint           set                = 0U;
+        DescriptorSet *descriptorSet      = nullptr;
+        uint           dynamicOffsetIndex = 0U;
+        uint           dynamicOffsetCount = 0U;
+    };
+
+    struct StencilCmd {
+        StencilFace face = StencilFace::ALL;
+        int         ref  = 0;
+        uint        mask = 0U;
+    };
+
+    bool _isRecording = false;
+
+    vector<CmdType>          _cmds;
+    vector<PipelineState *>  _pipelineStates;
+    vector<DescriptorSetCmd> _descriptorSets;
+    vector<uint>             _dynamicOffsets;
+    vector<InputAssembler *> _inputAssemblers;
+    vector<Viewport>         _viewports;
+    vector<Rect>             _scissors;
+    vector<float>            _floats;
+    vector<Color>            _colors;
+    vector<StencilCmd>       _stencilCmds;
+    vector<DrawInfo>         _drawInfos;
+};
+
+} // namespace gfx
+} // namespace cc
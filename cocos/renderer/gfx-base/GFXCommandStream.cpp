@@ -0,0 +1,210 @@
+/****************************************************************************
+ Copyright (c) 2019-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CoreStd.h"
+
+#include "GFXCommandStream.h"
+#include "GFXDescriptorSet.h"
+#include "GFXFramebuffer.h"
+#include "GFXPipelineState.h"
+#include "GFXRenderPass.h"
+
+#include <cstring>
+
+namespace cc {
+namespace gfx {
+
+namespace {
+
+// argument words each opcode takes, UINT_MAX for variable lengths
+constexpr uint ARG_COUNTS[] = {
+    UINT_MAX, // BEGIN_RENDER_PASS
+    0U,       // END_RENDER_PASS
+    1U,       // BIND_PIPELINE_STATE
+    UINT_MAX, // BIND_DESCRIPTOR_SET
+    1U,       // BIND_INPUT_ASSEMBLER
+    6U,       // SET_VIEWPORT
+    4U,       // SET_SCISSOR
+    1U,       // SET_LINE_WIDTH
+    3U,       // SET_DEPTH_BIAS
+    4U,       // SET_BLEND_CONSTANTS
+    2U,       // SET_DEPTH_BOUND
+    2U,       // SET_STENCIL_WRITE_MASK
+    3U,       // SET_STENCIL_COMPARE_MASK
+    1U,       // DRAW
+    7U,       // DRAW_INFO
+    UINT_MAX, // UPDATE_BUFFER
+};
+static_assert(sizeof(ARG_COUNTS) / sizeof(ARG_COUNTS[0]) == static_cast<size_t>(CommandStreamOp::COUNT), "Argument count missing for command stream opcode");
+
+constexpr uint BEGIN_RENDER_PASS_FIXED_ARGS = 8U;
+constexpr uint COLOR_WORDS                  = 4U;
+constexpr uint MAX_COLORS                   = 8U;
+
+float toFloat(uint32_t word) {
+    float value;
+    memcpy(&value, &word, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+void CommandStream::setObject(uint index, GFXObject *object) {
+    if (index >= _objects.size()) {
+        _objects.resize(index + 1, nullptr);
+    }
+    _objects[index] = object;
+}
+
+void CommandStream::clearObjects() {
+    _objects.clear();
+}
+
+template <typename T>
+T *CommandStream::getObject(uint32_t index, ObjectType type) const {
+    if (index >= _objects.size() || !_objects[index] || _objects[index]->getType() != type) {
+        return nullptr;
+    }
+    return static_cast<T *>(_objects[index]);
+}
+
+bool CommandStream::replay(CommandBuffer *cmdBuff, const uint32_t *words, uint wordCount) const {
+    const uint32_t *begin = words;
+    const uint32_t *end   = words + wordCount;
+    while (words < end) {
+        const auto     op       = static_cast<CommandStreamOp>(*words & ((1U << OP_BITS) - 1U));
+        const uint     argCount = *words >> OP_BITS;
+        const uint32_t *args    = words + 1;
+
+        bool valid = op < CommandStreamOp::COUNT && argCount <= static_cast<uint>(end - args);
+        if (valid) {
+            const uint expected = ARG_COUNTS[static_cast<uint>(op)];
+            valid = expected == UINT_MAX || argCount == expected;
+        }
+
+        if (valid) {
+            switch (op) {
+                case CommandStreamOp::BEGIN_RENDER_PASS: {
+                    const uint colorCount = argCount >= BEGIN_RENDER_PASS_FIXED_ARGS ? (argCount - BEGIN_RENDER_PASS_FIXED_ARGS) / COLOR_WORDS : 0U;
+                    auto *     renderPass = getObject<RenderPass>(args[0], ObjectType::RENDER_PASS);
+                    auto *     fbo        = getObject<Framebuffer>(args[1], ObjectType::FRAMEBUFFER);
+                    valid                 = renderPass && fbo && colorCount <= MAX_COLORS && argCount == BEGIN_RENDER_PASS_FIXED_ARGS + colorCount * COLOR_WORDS;
+                    if (valid) {
+                        Rect  renderArea{static_cast<int>(args[2]), static_cast<int>(args[3]), args[4], args[5]};
+                        Color colors[MAX_COLORS];
+                        for (uint i = 0U; i < colorCount; ++i) {
+                            const uint32_t *color = args + BEGIN_RENDER_PASS_FIXED_ARGS + i * COLOR_WORDS;
+                            colors[i]             = {toFloat(color[0]), toFloat(color[1]), toFloat(color[2]), toFloat(color[3])};
+                        }
+                        cmdBuff->beginRenderPass(renderPass, fbo, renderArea, colors, toFloat(args[6]), static_cast<int>(args[7]));
+                    }
+                    break;
+                }
+                case CommandStreamOp::END_RENDER_PASS:
+                    cmdBuff->endRenderPass();
+                    break;
+                case CommandStreamOp::BIND_PIPELINE_STATE: {
+                    auto *pso = getObject<PipelineState>(args[0], ObjectType::PIPELINE_STATE);
+                    valid     = pso != nullptr;
+                    if (valid) {
+                        cmdBuff->bindPipelineState(pso);
+                    }
+                    break;
+                }
+                case CommandStreamOp::BIND_DESCRIPTOR_SET: {
+                    auto *descriptorSet = argCount >= 2U ? getObject<DescriptorSet>(args[1], ObjectType::DESCRIPTOR_SET) : nullptr;
+                    valid               = descriptorSet != nullptr;
+                    if (valid) {
+                        cmdBuff->bindDescriptorSet(args[0], descriptorSet, argCount - 2U, argCount > 2U ? args + 2 : nullptr);
+                    }
+                    break;
+                }
+                case CommandStreamOp::BIND_INPUT_ASSEMBLER: {
+                    auto *ia = getObject<InputAssembler>(args[0], ObjectType::INPUT_ASSEMBLER);
+                    valid    = ia != nullptr;
+                    if (valid) {
+                        cmdBuff->bindInputAssembler(ia);
+                    }
+                    break;
+                }
+                case CommandStreamOp::SET_VIEWPORT:
+                    cmdBuff->setViewport({static_cast<int>(args[0]), static_cast<int>(args[1]), args[2], args[3], toFloat(args[4]), toFloat(args[5])});
+                    break;
+                case CommandStreamOp::SET_SCISSOR:
+                    cmdBuff->setScissor({static_cast<int>(args[0]), static_cast<int>(args[1]), args[2], args[3]});
+                    break;
+                case CommandStreamOp::SET_LINE_WIDTH:
+                    cmdBuff->setLineWidth(toFloat(args[0]));
+                    break;
+                case CommandStreamOp::SET_DEPTH_BIAS:
+                    cmdBuff->setDepthBias(toFloat(args[0]), toFloat(args[1]), toFloat(args[2]));
+                    break;
+                case CommandStreamOp::SET_BLEND_CONSTANTS:
+                    cmdBuff->setBlendConstants({toFloat(args[0]), toFloat(args[1]), toFloat(args[2]), toFloat(args[3])});
+                    break;
+                case CommandStreamOp::SET_DEPTH_BOUND:
+                    cmdBuff->setDepthBound(toFloat(args[0]), toFloat(args[1]));
+                    break;
+                case CommandStreamOp::SET_STENCIL_WRITE_MASK:
+                    cmdBuff->setStencilWriteMask(static_cast<StencilFace>(args[0]), args[1]);
+                    break;
+                case CommandStreamOp::SET_STENCIL_COMPARE_MASK:
+                    cmdBuff->setStencilCompareMask(static_cast<StencilFace>(args[0]), static_cast<int>(args[1]), args[2]);
+                    break;
+                case CommandStreamOp::DRAW: {
+                    auto *ia = getObject<InputAssembler>(args[0], ObjectType::INPUT_ASSEMBLER);
+                    valid    = ia != nullptr;
+                    if (valid) {
+                        cmdBuff->draw(ia);
+                    }
+                    break;
+                }
+                case CommandStreamOp::DRAW_INFO:
+                    cmdBuff->draw({args[0], args[1], args[2], args[3], args[4], args[5], args[6]});
+                    break;
+                case CommandStreamOp::UPDATE_BUFFER: {
+                    auto *buffer = argCount >= 2U ? getObject<Buffer>(args[0], ObjectType::BUFFER) : nullptr;
+                    valid        = buffer != nullptr && args[1] <= (argCount - 2U) * sizeof(uint32_t);
+                    if (valid) {
+                        cmdBuff->updateBuffer(buffer, args + 2, args[1]);
+                    }
+                    break;
+                }
+                case CommandStreamOp::COUNT:
+                    break;
+            }
+        }
+
+        if (!valid) {
+            CC_LOG_ERROR("Malformed command stream: opcode %u with %u arguments at word %u", static_cast<uint>(op), argCount, static_cast<uint>(words - begin));
+            return false;
+        }
+        words = args + argCount;
+    }
+    return true;
+}
+
+} // namespace gfx
+} // namespace cc
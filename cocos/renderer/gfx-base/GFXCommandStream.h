@@ -0,0 +1,107 @@
+/****************************************************************************
+ Copyright (c) 2019-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "GFXCommandBuffer.h"
+
+namespace cc {
+namespace gfx {
+
+/**
+ * Opcodes of the command stream. Every command starts with a header word,
+ * the opcode in the low 8 bits and the number of argument words above them.
+ * Objects are referenced by their index in the stream's object table,
+ * floats are stored by bit pattern.
+ */
+enum class CommandStreamOp : uint8_t {
+    BEGIN_RENDER_PASS,        // renderPass, framebuffer, x, y, width, height, depth (f32), stencil, colors (4 x f32 each)...
+    END_RENDER_PASS,          //
+    BIND_PIPELINE_STATE,      // pipelineState
+    BIND_DESCRIPTOR_SET,      // set, descriptorSet, dynamicOffsets...
+    BIND_INPUT_ASSEMBLER,     // inputAssembler
+    SET_VIEWPORT,             // left, top, width, height, minDepth (f32), maxDepth (f32)
+    SET_SCISSOR,              // x, y, width, height
+    SET_LINE_WIDTH,           // width (f32)
+    SET_DEPTH_BIAS,           // constant (f32), clamp (f32), slope (f32)
+    SET_BLEND_CONSTANTS,      // x (f32), y (f32), z (f32), w (f32)
+    SET_DEPTH_BOUND,          // minBounds (f32), maxBounds (f32)
+    SET_STENCIL_WRITE_MASK,   // face, mask
+    SET_STENCIL_COMPARE_MASK, // face, ref, mask
+    DRAW,                     // inputAssembler, drawn with its own draw info
+    DRAW_INFO,                // vertexCount, firstVertex, indexCount, firstIndex, vertexOffset, instanceCount, firstInstance
+    UPDATE_BUFFER,            // buffer, size, data padded to whole words...
+    COUNT,
+};
+
+/**
+ * Commands encoded by script into memory shared with native, decoded and
+ * recorded into a command buffer with a single call, instead of crossing
+ * the script binding once per command.
+ */
+class CC_DLL CommandStream final : public Object {
+public:
+    static constexpr uint OP_BITS = 8U;
+
+    static constexpr uint32_t header(CommandStreamOp op, uint argCount) {
+        return static_cast<uint32_t>(op) | (argCount << OP_BITS);
+    }
+
+    // the stream doesn't own its storage, which is typically an ArrayBuffer shared with script
+    inline void      setStorage(uint32_t *words, uint capacity);
+    inline uint32_t *getStorage() const { return _storage; }
+    inline uint      getCapacity() const { return _capacity; }
+
+    void setObject(uint index, GFXObject *object);
+    void clearObjects();
+
+    // record the first wordCount words of the storage into the specified command buffer
+    inline bool replay(CommandBuffer *cmdBuff, uint wordCount) const;
+    // stops at the first malformed command, which is reported and skipped with the rest of the stream
+    bool replay(CommandBuffer *cmdBuff, const uint32_t *words, uint wordCount) const;
+
+protected:
+    template <typename T>
+    T *getObject(uint32_t index, ObjectType type) const;
+
+    uint32_t *          _storage  = nullptr;
+    uint                _capacity = 0U;
+    vector<GFXObject *> _objects;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+void CommandStream::setStorage(uint32_t *words, uint capacity) {
+    _storage  = words;
+    _capacity = capacity;
+}
+
+bool CommandStream::replay(CommandBuffer *cmdBuff, uint wordCount) const {
+    CCASSERT(wordCount <= _capacity, "Command stream overflows its storage");
+    return replay(cmdBuff, _storage, wordCount < _capacity ? wordCount : _capacity);
+}
+
+} // namespace gfx
+} // namespace cc
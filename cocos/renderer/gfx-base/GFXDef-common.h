@@ -157,6 +157,8 @@ enum class Feature {
     STENCIL_COMPARE_MASK,
     MULTITHREADED_SUBMISSION,
     COMPUTE_SHADER,
+    MULTI_DRAW_INDIRECT,
+    TIMESTAMP_QUERY,
     COUNT,
 };
 
@@ -680,6 +682,8 @@ enum class QueueType {
 enum class CommandBufferType {
     PRIMARY,
     SECONDARY,
+    // Render pass contents kept alive across frames, replayable until re-recorded
+    BUNDLE,
 };
 
 enum class ClearFlagBit : FlagBits {
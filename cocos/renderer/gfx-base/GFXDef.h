@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "GFXDef-common.h"
 
 namespace cc {
@@ -102,6 +104,21 @@ constexpr DescriptorType DESCRIPTOR_DYNAMIC_TYPE = static_cast<DescriptorType>(
 
 constexpr uint DRAW_INFO_SIZE = 28U;
 
+// per-frame byte budget for asynchronous uploads, at least one upload is always submitted per frame
+constexpr uint DEFAULT_UPLOAD_BUDGET = 8U * 1024U * 1024U;
+
+using UploadCallback = std::function<void()>;
+
+// upper bound of timing scopes recorded per frame, extra scopes are dropped
+constexpr uint MAX_TIMING_SCOPES = 64U;
+
+struct TimingScope {
+    String name;
+    uint   depth   = 0U;
+    float  gpuTime = 0.F; // in milliseconds
+};
+using TimingScopeList = vector<TimingScope>;
+
 extern const FormatInfo GFX_FORMAT_INFOS[];
 extern const uint       GFX_TYPE_SIZES[];
 
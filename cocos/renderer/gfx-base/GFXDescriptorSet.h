@@ -61,6 +61,8 @@ public:
     CC_INLINE Texture *getTexture(uint binding) const { return getTexture(binding, 0u); }
     CC_INLINE Sampler *getSampler(uint binding) const { return getSampler(binding, 0u); }
 
+    CC_INLINE DescriptorSetLayout *getLayout() const { return _layout; }
+
 protected:
     virtual void doInit(const DescriptorSetInfo &info) = 0;
     virtual void doDestroy()                           = 0;
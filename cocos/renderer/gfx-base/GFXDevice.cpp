@@ -73,7 +73,129 @@ bool Device::initialize(const DeviceInfo &info) {
     return doInit(info);
 }
 
+// backends without a dedicated streaming path upload synchronously
+void Device::copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) {
+    copyBuffersToTexture(buffers, dst, regions, count);
+    if (callback) callback();
+}
+
+void Device::updateBufferAsync(Buffer *buff, const void *data, uint size, const UploadCallback &callback) {
+    buff->update(data, size);
+    if (callback) callback();
+}
+
+Device::PendingUpload *Device::stageUpload(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) {
+    auto *upload     = CC_NEW(PendingUpload);
+    upload->texture  = dst;
+    upload->callback = callback;
+    upload->regions.assign(regions, regions + count);
+
+    uint bufferCount = 0U;
+    for (uint i = 0U; i < count; i++) {
+        const BufferTextureCopy &region = regions[i];
+        uint                     size   = formatSize(dst->getFormat(), region.texExtent.width, region.texExtent.height, 1);
+        bufferCount += region.texSubres.layerCount;
+        upload->size += size * region.texSubres.layerCount;
+    }
+
+    upload->data = static_cast<uint8_t *>(CC_MALLOC(upload->size));
+    upload->buffers.resize(bufferCount);
+    uint8_t *dstData = upload->data;
+    for (uint i = 0U, n = 0U; i < count; i++) {
+        const BufferTextureCopy &region = regions[i];
+        uint                     size   = formatSize(dst->getFormat(), region.texExtent.width, region.texExtent.height, 1);
+        for (uint l = 0; l < region.texSubres.layerCount; l++) {
+            memcpy(dstData, buffers[n], size);
+            upload->buffers[n++] = dstData;
+            dstData += size;
+        }
+    }
+    return upload;
+}
+
+Device::PendingUpload *Device::stageUpload(Buffer *buff, const void *data, uint size, const UploadCallback &callback) {
+    auto *upload     = CC_NEW(PendingUpload);
+    upload->buffer   = buff;
+    upload->callback = callback;
+    upload->size     = size;
+    upload->data     = static_cast<uint8_t *>(CC_MALLOC(size));
+    memcpy(upload->data, data, size);
+    return upload;
+}
+
+void Device::releaseUpload(PendingUpload *upload) {
+    CC_FREE(upload->data);
+    CC_DELETE(upload);
+}
+
+bool Device::deferUpload(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) {
+    if (_isReplayingUploads) return false;
+
+    uint size = 0U;
+    for (uint i = 0U; i < count; i++) {
+        const BufferTextureCopy &region = regions[i];
+        size += formatSize(dst->getFormat(), region.texExtent.width, region.texExtent.height, 1) * region.texSubres.layerCount;
+    }
+    // keep the submission order, at least one upload goes through per frame
+    if (_deferredUploads.empty() && (!_uploadBytes || _uploadBytes + size <= _uploadBudget)) {
+        _uploadBytes += size;
+        return false;
+    }
+    _deferredUploads.push_back(stageUpload(buffers, dst, regions, count, callback));
+    return true;
+}
+
+bool Device::deferUpload(Buffer *buff, const void *data, uint size, const UploadCallback &callback) {
+    if (_isReplayingUploads) return false;
+
+    if (_deferredUploads.empty() && (!_uploadBytes || _uploadBytes + size <= _uploadBudget)) {
+        _uploadBytes += size;
+        return false;
+    }
+    _deferredUploads.push_back(stageUpload(buff, data, size, callback));
+    return true;
+}
+
+void Device::cancelUploads(const GFXObject *object) {
+    for (auto iter = _deferredUploads.begin(); iter != _deferredUploads.end();) {
+        PendingUpload *upload = *iter;
+        if (upload->texture == object || upload->buffer == object) {
+            releaseUpload(upload);
+            iter = _deferredUploads.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void Device::flushDeferredUploads() {
+    _uploadBytes        = 0U;
+    _isReplayingUploads = true;
+
+    while (!_deferredUploads.empty()) {
+        PendingUpload *upload = _deferredUploads.front();
+        if (_uploadBytes && _uploadBytes + upload->size > _uploadBudget) break;
+        _uploadBytes += upload->size;
+        _deferredUploads.pop_front();
+
+        if (upload->texture) {
+            copyBuffersToTextureAsync(upload->buffers.data(), upload->texture, upload->regions.data(), utils::toUint(upload->regions.size()), upload->callback);
+        } else {
+            updateBufferAsync(upload->buffer, upload->data, upload->size, upload->callback);
+        }
+        releaseUpload(upload);
+    }
+
+    _isReplayingUploads = false;
+}
+
 void Device::destroy() {
+    // pending callbacks are dropped along with the device
+    for (PendingUpload *upload : _deferredUploads) {
+        releaseUpload(upload);
+    }
+    _deferredUploads.clear();
+
     doDestroy();
 
     _bindingMappingInfo.bufferOffsets.clear();
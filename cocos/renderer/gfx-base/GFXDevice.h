@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "GFXBuffer.h"
 #include "GFXCommandBuffer.h"
 #include "GFXDescriptorSet.h"
@@ -71,6 +73,20 @@ public:
     virtual uint             getNumInstances() const { return _numInstances; }
     virtual uint             getNumTris() const { return _numTriangles; }
 
+    // Asynchronous uploads may be issued from any thread, the source data is copied before returning.
+    // Submissions are rate-limited by the upload budget, and the callback is invoked on the thread
+    // driving the device once the resource is resident. Don't bind the destination before that.
+    virtual void copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback);
+    virtual void updateBufferAsync(Buffer *buff, const void *data, uint size, const UploadCallback &callback);
+    virtual void setUploadBudget(uint bytesPerFrame) { _uploadBudget = bytesPerFrame; }
+    inline uint  getUploadBudget() const { return _uploadBudget; }
+    // Drops the queued uploads of a texture or buffer being destroyed, their callbacks are never invoked.
+    // Backends call it when destroying the resource, on the thread driving the device.
+    virtual void cancelUploads(const GFXObject *object);
+
+    // GPU durations of the timing scopes in the latest resolved frame, empty if TIMESTAMP_QUERY is not supported.
+    inline const TimingScopeList &getTimingScopes() const { return _timingScopes; }
+
     inline CommandBuffer *      createCommandBuffer(const CommandBufferInfo &info);
     inline Queue *              createQueue(const QueueInfo &info);
     inline Buffer *             createBuffer(const BufferInfo &info);
@@ -90,6 +106,7 @@ public:
     inline TextureBarrier *     createTextureBarrier(const TextureBarrierInfo &info);
 
     inline void copyBuffersToTexture(const BufferDataList &buffers, Texture *dst, const BufferTextureCopyList &regions);
+    inline void copyBuffersToTextureAsync(const BufferDataList &buffers, Texture *dst, const BufferTextureCopyList &regions, const UploadCallback &callback);
     inline void flushCommands(const vector<CommandBuffer *> &cmdBuffs);
     inline void flushCommandsForJS(const vector<CommandBuffer *> &cmdBuffs);
 
@@ -146,6 +163,28 @@ protected:
 
     inline Context *getContext() const { return _context; }
 
+    // an asynchronous upload with its source data copied, so it can be submitted later
+    struct PendingUpload {
+        Texture *                 texture = nullptr;
+        Buffer *                  buffer  = nullptr;
+        uint8_t *                 data    = nullptr;
+        uint                      size    = 0U;
+        vector<const uint8_t *>   buffers;
+        vector<BufferTextureCopy> regions;
+        UploadCallback            callback;
+    };
+
+    static PendingUpload *stageUpload(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback);
+    static PendingUpload *stageUpload(Buffer *buff, const void *data, uint size, const UploadCallback &callback);
+    static void           releaseUpload(PendingUpload *upload);
+
+    // Backends call these from their asynchronous upload entries on the device thread.
+    // Returns true if the upload exceeds this frame's budget and has been staged for a later frame.
+    bool deferUpload(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback);
+    bool deferUpload(Buffer *buff, const void *data, uint size, const UploadCallback &callback);
+    // Starts a new budget frame and submits the deferred uploads that fit in it, called on acquire.
+    void flushDeferredUploads();
+
     API                _api       = API::UNKNOWN;
     SurfaceTransform   _transform = SurfaceTransform::IDENTITY;
     String             _deviceName;
@@ -165,8 +204,14 @@ protected:
     uint               _numDrawCalls = 0U;
     uint               _numInstances = 0U;
     uint               _numTriangles = 0U;
+    uint               _uploadBudget = DEFAULT_UPLOAD_BUDGET;
+    TimingScopeList    _timingScopes;
     BindingMappingInfo _bindingMappingInfo;
     DeviceCaps         _caps;
+
+    std::deque<PendingUpload *> _deferredUploads;
+    uint                        _uploadBytes        = 0U;
+    bool                        _isReplayingUploads = false;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -277,6 +322,10 @@ void Device::copyBuffersToTexture(const BufferDataList &buffers, Texture *dst, c
     copyBuffersToTexture(buffers.data(), dst, regions.data(), utils::toUint(regions.size()));
 }
 
+void Device::copyBuffersToTextureAsync(const BufferDataList &buffers, Texture *dst, const BufferTextureCopyList &regions, const UploadCallback &callback) {
+    copyBuffersToTextureAsync(buffers.data(), dst, regions.data(), utils::toUint(regions.size()), callback);
+}
+
 void Device::flushCommands(const vector<CommandBuffer *> &cmdBuffs) {
     flushCommands(cmdBuffs.data(), utils::toUint(cmdBuffs.size()));
 }
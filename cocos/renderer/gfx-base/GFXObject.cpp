@@ -27,11 +27,18 @@
 
 #include "GFXObject.h"
 
+#include <atomic>
+
 namespace cc {
 namespace gfx {
 
+namespace {
+std::atomic<uint> objectIDCounter{0U};
+} // namespace
+
 GFXObject::GFXObject(ObjectType Type)
-: _Type(Type) {}
+: _Type(Type),
+  _objectID(++objectIDCounter) {}
 
 } // namespace gfx
 } // namespace cc
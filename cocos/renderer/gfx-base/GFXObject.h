@@ -37,9 +37,12 @@ public:
     virtual ~GFXObject() = default;
 
     CC_INLINE ObjectType getType() const { return _Type; }
+    // Unique per object, unlike the address or pool slot, which are reused once the object is destroyed
+    CC_INLINE uint getObjectID() const { return _objectID; }
 
 protected:
     ObjectType _Type = ObjectType::UNKNOWN;
+    uint _objectID = 0U;
 };
 
 } // namespace gfx
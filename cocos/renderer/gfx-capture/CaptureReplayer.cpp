@@ -0,0 +1,527 @@
+/****************************************************************************
+ Copyright (c) 2019-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CoreStd.h"
+
+#include "CaptureReplayer.h"
+#include "gfx-base/GFXDevice.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+namespace gfx {
+
+CaptureReplayer::~CaptureReplayer() {
+    destroy();
+}
+
+bool CaptureReplayer::load(const String &path) {
+    _data = FileUtils::getInstance()->getDataFromFile(path);
+    if (_data.getSize() < static_cast<ssize_t>(sizeof(CaptureHeader))) {
+        CC_LOG_ERROR("Invalid GFX capture: %s", path.c_str());
+        return false;
+    }
+
+    memcpy(&_header, _data.getBytes(), sizeof(CaptureHeader));
+    if (_header.magic != CAPTURE_MAGIC || _header.version != CAPTURE_VERSION) {
+        CC_LOG_ERROR("Unsupported GFX capture version: %s", path.c_str());
+        return false;
+    }
+
+    const uint8_t *bytes  = _data.getBytes();
+    const auto     size   = utils::toUint(_data.getSize());
+    uint           offset = sizeof(CaptureHeader);
+
+    _frameStart = size;
+    while (offset + CAPTURE_RECORD_HEADER_SIZE <= size) {
+        if (static_cast<CaptureOp>(bytes[offset]) == CaptureOp::DEVICE_ACQUIRE) {
+            _frameStart = offset;
+            break;
+        }
+        uint payloadSize = 0U;
+        memcpy(&payloadSize, bytes + offset + sizeof(CaptureOp) + sizeof(uint), sizeof(uint));
+        offset += CAPTURE_RECORD_HEADER_SIZE + payloadSize;
+    }
+
+    _restored = false;
+    return true;
+}
+
+bool CaptureReplayer::replayFrames(Device *device, uint loopCount, vector<CaptureFrameStats> *stats) {
+    CCASSERT(!_restored || device == _device, "Captured objects belong to another device");
+    _device = device;
+
+    if (!_restored) {
+        if (!executeRange(sizeof(CaptureHeader), _frameStart, nullptr)) return false;
+        _restored = true;
+    }
+
+    const auto size = utils::toUint(_data.getSize());
+    for (uint i = 0U; i < loopCount; ++i) {
+        if (!executeRange(_frameStart, size, stats)) return false;
+    }
+    return true;
+}
+
+void CaptureReplayer::destroy() {
+    // release in reverse creation order so nothing outlives its dependencies
+    for (uint id = utils::toUint(_objects.size()); id-- > 1U;) {
+        releaseObject(id);
+    }
+    _objects.clear();
+    _owned.clear();
+
+    for (auto &pair : _globalBarriers) {
+        CC_DELETE(pair.second);
+    }
+    _globalBarriers.clear();
+    for (auto &pair : _textureBarriers) {
+        CC_DELETE(pair.second);
+    }
+    _textureBarriers.clear();
+
+    _restored = false;
+}
+
+bool CaptureReplayer::executeRange(uint begin, uint end, vector<CaptureFrameStats> *stats) {
+    const uint8_t *bytes  = _data.getBytes();
+    uint           offset = begin;
+
+    while (offset + CAPTURE_RECORD_HEADER_SIZE <= end) {
+        auto op          = static_cast<CaptureOp>(bytes[offset]);
+        uint id          = 0U;
+        uint payloadSize = 0U;
+        memcpy(&id, bytes + offset + sizeof(CaptureOp), sizeof(uint));
+        memcpy(&payloadSize, bytes + offset + sizeof(CaptureOp) + sizeof(uint), sizeof(uint));
+        offset += CAPTURE_RECORD_HEADER_SIZE;
+
+        if (op >= CaptureOp::COUNT || offset + payloadSize > end) {
+            CC_LOG_ERROR("Corrupted GFX capture record at offset %u", offset);
+            return false;
+        }
+
+        if (stats && op == CaptureOp::DEVICE_ACQUIRE) {
+            stats->emplace_back();
+            _frameBegin = std::chrono::steady_clock::now();
+        }
+
+        CaptureReader reader(bytes + offset, payloadSize, &_objects, _header.payloads != 0U);
+        execute(op, id, reader);
+        offset += payloadSize;
+
+        if (stats && !stats->empty()) {
+            CaptureFrameStats &frame = stats->back();
+            if (op >= CaptureOp::CMD_BEGIN) ++frame.numCommands;
+            if (op == CaptureOp::DEVICE_PRESENT) {
+                frame.cpuTime      = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _frameBegin).count();
+                frame.numDrawCalls = _device->getNumDrawCalls();
+                frame.numInstances = _device->getNumInstances();
+                frame.numTriangles = _device->getNumTris();
+            }
+        }
+    }
+
+    return true;
+}
+
+void CaptureReplayer::bindObject(uint id, GFXObject *object, bool owned) {
+    if (id >= _objects.size()) {
+        _objects.resize(id + 1, nullptr);
+        _owned.resize(id + 1, false);
+    }
+    // looping the captured frames recreates the objects they create
+    releaseObject(id);
+    _objects[id] = object;
+    _owned[id]   = owned;
+}
+
+void CaptureReplayer::releaseObject(uint id) {
+    GFXObject *object = getObject(id);
+    if (!object) return;
+
+    if (_owned[id]) {
+        switch (object->getType()) {
+            case ObjectType::BUFFER: static_cast<Buffer *>(object)->destroy(); break;
+            case ObjectType::TEXTURE: static_cast<Texture *>(object)->destroy(); break;
+            case ObjectType::RENDER_PASS: static_cast<RenderPass *>(object)->destroy(); break;
+            case ObjectType::FRAMEBUFFER: static_cast<Framebuffer *>(object)->destroy(); break;
+            case ObjectType::SAMPLER: static_cast<Sampler *>(object)->destroy(); break;
+            case ObjectType::SHADER: static_cast<Shader *>(object)->destroy(); break;
+            case ObjectType::DESCRIPTOR_SET_LAYOUT: static_cast<DescriptorSetLayout *>(object)->destroy(); break;
+            case ObjectType::PIPELINE_LAYOUT: static_cast<PipelineLayout *>(object)->destroy(); break;
+            case ObjectType::PIPELINE_STATE: static_cast<PipelineState *>(object)->destroy(); break;
+            case ObjectType::DESCRIPTOR_SET: static_cast<DescriptorSet *>(object)->destroy(); break;
+            case ObjectType::INPUT_ASSEMBLER: static_cast<InputAssembler *>(object)->destroy(); break;
+            case ObjectType::COMMAND_BUFFER: static_cast<CommandBuffer *>(object)->destroy(); break;
+            case ObjectType::QUEUE: static_cast<Queue *>(object)->destroy(); break;
+            default: break;
+        }
+        CC_DELETE(object);
+    }
+
+    _objects[id] = nullptr;
+    _owned[id]   = false;
+}
+
+const uint8_t *CaptureReplayer::resolve(const CaptureBlob &blob) {
+    if (blob.data) return blob.data;
+    // captured without payloads, the sizes are all that matter for CPU-side replays
+    if (_scratch.size() < blob.size) _scratch.resize(blob.size, 0U);
+    return _scratch.data();
+}
+
+void CaptureReplayer::execute(CaptureOp op, uint id, CaptureReader &reader) {
+    switch (op) {
+        case CaptureOp::DEVICE_QUEUE: bindObject(id, _device->getQueue(), false); break;
+        case CaptureOp::DEVICE_COMMAND_BUFFER: bindObject(id, _device->getCommandBuffer(), false); break;
+        case CaptureOp::CREATE_QUEUE: {
+            QueueInfo info;
+            reader.io(info);
+            bindObject(id, _device->createQueue(info), true);
+        } break;
+        case CaptureOp::CREATE_COMMAND_BUFFER: {
+            CommandBufferInfo info;
+            reader.io(info);
+            bindObject(id, _device->createCommandBuffer(info), true);
+        } break;
+        case CaptureOp::CREATE_BUFFER: {
+            BufferInfo info;
+            reader.io(info);
+            bindObject(id, _device->createBuffer(info), true);
+        } break;
+        case CaptureOp::CREATE_BUFFER_VIEW: {
+            BufferViewInfo info;
+            reader.io(info);
+            bindObject(id, _device->createBuffer(info), true);
+        } break;
+        case CaptureOp::CREATE_TEXTURE: {
+            TextureInfo info;
+            reader.io(info);
+            bindObject(id, _device->createTexture(info), true);
+        } break;
+        case CaptureOp::CREATE_TEXTURE_VIEW: {
+            TextureViewInfo info;
+            reader.io(info);
+            bindObject(id, _device->createTexture(info), true);
+        } break;
+        case CaptureOp::CREATE_SAMPLER: {
+            SamplerInfo info;
+            reader.io(info);
+            bindObject(id, _device->createSampler(info), true);
+        } break;
+        case CaptureOp::CREATE_SHADER: {
+            ShaderInfo info;
+            reader.io(info);
+            bindObject(id, _device->createShader(info), true);
+        } break;
+        case CaptureOp::CREATE_INPUT_ASSEMBLER: {
+            InputAssemblerInfo info;
+            reader.io(info);
+            bindObject(id, _device->createInputAssembler(info), true);
+        } break;
+        case CaptureOp::CREATE_RENDER_PASS: {
+            RenderPassInfo info;
+            reader.io(info);
+            bindObject(id, _device->createRenderPass(info), true);
+        } break;
+        case CaptureOp::CREATE_FRAMEBUFFER: {
+            FramebufferInfo info;
+            reader.io(info);
+            bindObject(id, _device->createFramebuffer(info), true);
+        } break;
+        case CaptureOp::CREATE_DESCRIPTOR_SET_LAYOUT: {
+            DescriptorSetLayoutInfo info;
+            reader.io(info);
+            bindObject(id, _device->createDescriptorSetLayout(info), true);
+        } break;
+        case CaptureOp::CREATE_PIPELINE_LAYOUT: {
+            PipelineLayoutInfo info;
+            reader.io(info);
+            bindObject(id, _device->createPipelineLayout(info), true);
+        } break;
+        case CaptureOp::CREATE_PIPELINE_STATE: {
+            PipelineStateInfo info;
+            reader.io(info);
+            bindObject(id, _device->createPipelineState(info), true);
+        } break;
+        case CaptureOp::CREATE_DESCRIPTOR_SET: {
+            DescriptorSetInfo info;
+            reader.io(info);
+            bindObject(id, _device->createDescriptorSet(info), true);
+        } break;
+        case CaptureOp::DESTROY: releaseObject(id); break;
+        case CaptureOp::BUFFER_UPDATE: {
+            CaptureBlob blob;
+            reader.io(blob);
+            get<Buffer>(id)->update(resolve(blob), blob.size);
+        } break;
+        case CaptureOp::BUFFER_RESIZE: {
+            uint size = 0U;
+            reader.io(size);
+            get<Buffer>(id)->resize(size);
+        } break;
+        case CaptureOp::TEXTURE_RESIZE: {
+            uint width  = 0U;
+            uint height = 0U;
+            reader.io(width);
+            reader.io(height);
+            get<Texture>(id)->resize(width, height);
+        } break;
+        case CaptureOp::COPY_BUFFERS_TO_TEXTURE: {
+            BufferTextureCopyList regions;
+            vector<CaptureBlob>   blobs;
+            reader.io(regions);
+            reader.io(blobs);
+            BufferDataList buffers(blobs.size());
+            for (size_t i = 0U; i < blobs.size(); ++i) buffers[i] = resolve(blobs[i]);
+            _device->copyBuffersToTexture(buffers, get<Texture>(id), regions);
+        } break;
+        case CaptureOp::DESCRIPTOR_SET_BIND_BUFFER: {
+            uint    binding = 0U;
+            Buffer *buffer  = nullptr;
+            uint    index   = 0U;
+            reader.io(binding);
+            reader.io(buffer);
+            reader.io(index);
+            if (buffer) get<DescriptorSet>(id)->bindBuffer(binding, buffer, index);
+        } break;
+        case CaptureOp::DESCRIPTOR_SET_BIND_TEXTURE: {
+            uint     binding = 0U;
+            Texture *texture = nullptr;
+            uint     index   = 0U;
+            reader.io(binding);
+            reader.io(texture);
+            reader.io(index);
+            if (texture) get<DescriptorSet>(id)->bindTexture(binding, texture, index);
+        } break;
+        case CaptureOp::DESCRIPTOR_SET_BIND_SAMPLER: {
+            uint     binding = 0U;
+            Sampler *sampler = nullptr;
+            uint     index   = 0U;
+            reader.io(binding);
+            reader.io(sampler);
+            reader.io(index);
+            if (sampler) get<DescriptorSet>(id)->bindSampler(binding, sampler, index);
+        } break;
+        case CaptureOp::DESCRIPTOR_SET_UPDATE: get<DescriptorSet>(id)->update(); break;
+        case CaptureOp::DEVICE_RESIZE: {
+            uint width  = 0U;
+            uint height = 0U;
+            reader.io(width);
+            reader.io(height);
+            _device->resize(width, height);
+        } break;
+        case CaptureOp::DEVICE_ACQUIRE: _device->acquire(); break;
+        case CaptureOp::DEVICE_PRESENT: _device->present(); break;
+        case CaptureOp::DEVICE_FLUSH_COMMANDS: {
+            CommandBufferList cmdBuffs;
+            reader.io(cmdBuffs);
+            _device->flushCommands(cmdBuffs.data(), utils::toUint(cmdBuffs.size()));
+        } break;
+        case CaptureOp::QUEUE_SUBMIT: {
+            CommandBufferList cmdBuffs;
+            reader.io(cmdBuffs);
+            get<Queue>(id)->submit(cmdBuffs.data(), utils::toUint(cmdBuffs.size()));
+        } break;
+        default: executeCommand(op, get<CommandBuffer>(id), reader); break;
+    }
+}
+
+void CaptureReplayer::executeCommand(CaptureOp op, CommandBuffer *cmdBuff, CaptureReader &reader) {
+    switch (op) {
+        case CaptureOp::CMD_BEGIN: {
+            RenderPass * renderPass  = nullptr;
+            uint         subpass     = 0U;
+            Framebuffer *framebuffer = nullptr;
+            reader.io(renderPass);
+            reader.io(subpass);
+            reader.io(framebuffer);
+            cmdBuff->begin(renderPass, subpass, framebuffer);
+        } break;
+        case CaptureOp::CMD_END: cmdBuff->end(); break;
+        case CaptureOp::CMD_BEGIN_RENDER_PASS: {
+            RenderPass *      renderPass  = nullptr;
+            Framebuffer *     framebuffer = nullptr;
+            Rect              renderArea;
+            ColorList         colors;
+            float             depth   = 1.0F;
+            int               stencil = 0;
+            CommandBufferList secondaryCBs;
+            reader.io(renderPass);
+            reader.io(framebuffer);
+            reader.io(renderArea);
+            reader.io(colors);
+            reader.io(depth);
+            reader.io(stencil);
+            reader.io(secondaryCBs);
+            cmdBuff->beginRenderPass(renderPass, framebuffer, renderArea, colors.data(), depth, stencil,
+                                     secondaryCBs.data(), utils::toUint(secondaryCBs.size()));
+        } break;
+        case CaptureOp::CMD_END_RENDER_PASS: cmdBuff->endRenderPass(); break;
+        case CaptureOp::CMD_BIND_PIPELINE_STATE: {
+            PipelineState *pso = nullptr;
+            reader.io(pso);
+            cmdBuff->bindPipelineState(pso);
+        } break;
+        case CaptureOp::CMD_BIND_DESCRIPTOR_SET: {
+            uint           set           = 0U;
+            DescriptorSet *descriptorSet = nullptr;
+            vector<uint>   dynamicOffsets;
+            reader.io(set);
+            reader.io(descriptorSet);
+            reader.io(dynamicOffsets);
+            cmdBuff->bindDescriptorSet(set, descriptorSet, utils::toUint(dynamicOffsets.size()), dynamicOffsets.data());
+        } break;
+        case CaptureOp::CMD_BIND_INPUT_ASSEMBLER: {
+            InputAssembler *ia = nullptr;
+            reader.io(ia);
+            cmdBuff->bindInputAssembler(ia);
+        } break;
+        case CaptureOp::CMD_SET_VIEWPORT: {
+            Viewport vp;
+            reader.io(vp);
+            cmdBuff->setViewport(vp);
+        } break;
+        case CaptureOp::CMD_SET_SCISSOR: {
+            Rect rect;
+            reader.io(rect);
+            cmdBuff->setScissor(rect);
+        } break;
+        case CaptureOp::CMD_SET_LINE_WIDTH: {
+            float width = 1.0F;
+            reader.io(width);
+            cmdBuff->setLineWidth(width);
+        } break;
+        case CaptureOp::CMD_SET_DEPTH_BIAS: {
+            float constant = 0.0F;
+            float clamp    = 0.0F;
+            float slope    = 0.0F;
+            reader.io(constant);
+            reader.io(clamp);
+            reader.io(slope);
+            cmdBuff->setDepthBias(constant, clamp, slope);
+        } break;
+        case CaptureOp::CMD_SET_BLEND_CONSTANTS: {
+            Color constants;
+            reader.io(constants);
+            cmdBuff->setBlendConstants(constants);
+        } break;
+        case CaptureOp::CMD_SET_DEPTH_BOUND: {
+            float minBounds = 0.0F;
+            float maxBounds = 1.0F;
+            reader.io(minBounds);
+            reader.io(maxBounds);
+            cmdBuff->setDepthBound(minBounds, maxBounds);
+        } break;
+        case CaptureOp::CMD_SET_STENCIL_WRITE_MASK: {
+            StencilFace face = StencilFace::ALL;
+            uint        mask = 0U;
+            reader.io(face);
+            reader.io(mask);
+            cmdBuff->setStencilWriteMask(face, mask);
+        } break;
+        case CaptureOp::CMD_SET_STENCIL_COMPARE_MASK: {
+            StencilFace face = StencilFace::ALL;
+            int         ref  = 0;
+            uint        mask = 0U;
+            reader.io(face);
+            reader.io(ref);
+            reader.io(mask);
+            cmdBuff->setStencilCompareMask(face, ref, mask);
+        } break;
+        case CaptureOp::CMD_NEXT_SUBPASS: cmdBuff->nextSubpass(); break;
+        case CaptureOp::CMD_DRAW: {
+            DrawInfo info;
+            reader.io(info);
+            cmdBuff->draw(info);
+        } break;
+        case CaptureOp::CMD_UPDATE_BUFFER: {
+            Buffer *    buffer = nullptr;
+            CaptureBlob blob;
+            reader.io(buffer);
+            reader.io(blob);
+            cmdBuff->updateBuffer(buffer, resolve(blob), blob.size);
+        } break;
+        case CaptureOp::CMD_COPY_BUFFERS_TO_TEXTURE: {
+            Texture *             texture = nullptr;
+            BufferTextureCopyList regions;
+            vector<CaptureBlob>   blobs;
+            reader.io(texture);
+            reader.io(regions);
+            reader.io(blobs);
+            BufferDataList buffers(blobs.size());
+            for (size_t i = 0U; i < blobs.size(); ++i) buffers[i] = resolve(blobs[i]);
+            cmdBuff->copyBuffersToTexture(buffers.data(), texture, regions.data(), utils::toUint(regions.size()));
+        } break;
+        case CaptureOp::CMD_BLIT_TEXTURE: {
+            Texture *       srcTexture = nullptr;
+            Texture *       dstTexture = nullptr;
+            TextureBlitList regions;
+            Filter          filter = Filter::LINEAR;
+            reader.io(srcTexture);
+            reader.io(dstTexture);
+            reader.io(regions);
+            reader.io(filter);
+            cmdBuff->blitTexture(srcTexture, dstTexture, regions.data(), utils::toUint(regions.size()), filter);
+        } break;
+        case CaptureOp::CMD_EXECUTE: {
+            CommandBufferList cmdBuffs;
+            reader.io(cmdBuffs);
+            cmdBuff->execute(cmdBuffs.data(), utils::toUint(cmdBuffs.size()));
+        } break;
+        case CaptureOp::CMD_DISPATCH: {
+            DispatchInfo info;
+            reader.io(info);
+            cmdBuff->dispatch(info);
+        } break;
+        case CaptureOp::CMD_PIPELINE_BARRIER: {
+            bool                       hasGlobalBarrier = false;
+            GlobalBarrierInfo          globalBarrierInfo;
+            vector<TextureBarrierInfo> textureBarrierInfos;
+            TextureList                textures;
+            reader.io(hasGlobalBarrier);
+            reader.io(globalBarrierInfo);
+            reader.io(textureBarrierInfos);
+            reader.io(textures);
+
+            GlobalBarrier *globalBarrier = nullptr;
+            if (hasGlobalBarrier) {
+                GlobalBarrier *&barrier = _globalBarriers[GlobalBarrier::computeHash(globalBarrierInfo)];
+                if (!barrier) barrier = _device->createGlobalBarrier(globalBarrierInfo);
+                globalBarrier = barrier;
+            }
+            TextureBarrierList textureBarriers(textureBarrierInfos.size());
+            for (size_t i = 0U; i < textureBarrierInfos.size(); ++i) {
+                TextureBarrier *&barrier = _textureBarriers[TextureBarrier::computeHash(textureBarrierInfos[i])];
+                if (!barrier) barrier = _device->createTextureBarrier(textureBarrierInfos[i]);
+                textureBarriers[i] = barrier;
+            }
+            cmdBuff->pipelineBarrier(globalBarrier, textureBarriers.data(), textures.data(), utils::toUint(textures.size()));
+        } break;
+        default: CC_LOG_WARNING("Unknown GFX capture op %u", static_cast<uint>(op)); break;
+    }
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,94 @@
+/****************************************************************************
+ Copyright (c) 2019-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <chrono>
+
+#include "CaptureStream.h"
+#include "base/Data.h"
+
+namespace cc {
+namespace gfx {
+
+class Device;
+class GlobalBarrier;
+class TextureBarrier;
+
+struct CaptureFrameStats {
+    double cpuTime      = 0.0; // in milliseconds, from acquire to present
+    uint   numDrawCalls = 0U;
+    uint   numInstances = 0U;
+    uint   numTriangles = 0U;
+    uint   numCommands  = 0U;
+};
+
+/**
+ * Plays a capture file back against any device, including EmptyDevice.
+ * Everything before the first acquire restores the captured state and is replayed once,
+ * the captured frames can be looped for as long as a benchmark needs.
+ */
+class CC_DLL CaptureReplayer final {
+public:
+    CaptureReplayer() = default;
+    ~CaptureReplayer();
+
+    bool load(const String &path);
+    bool replayFrames(Device *device, uint loopCount, vector<CaptureFrameStats> *stats);
+    void destroy();
+
+    inline const CaptureHeader &getHeader() const { return _header; }
+
+private:
+    void execute(CaptureOp op, uint id, CaptureReader &reader);
+    void executeCommand(CaptureOp op, CommandBuffer *cmdBuff, CaptureReader &reader);
+    bool executeRange(uint begin, uint end, vector<CaptureFrameStats> *stats);
+
+    void       bindObject(uint id, GFXObject *object, bool owned);
+    void       releaseObject(uint id);
+    GFXObject *getObject(uint id) const { return id < _objects.size() ? _objects[id] : nullptr; }
+    template <typename T>
+    T *get(uint id) const { return static_cast<T *>(getObject(id)); }
+
+    const uint8_t *resolve(const CaptureBlob &blob);
+
+    Device *      _device = nullptr;
+    Data          _data;
+    CaptureHeader _header;
+    uint          _frameStart = 0U;
+    bool          _restored   = false;
+
+    vector<GFXObject *> _objects;
+    vector<bool>        _owned;
+    vector<uint8_t>     _scratch;
+
+    unordered_map<uint, GlobalBarrier *>  _globalBarriers;
+    unordered_map<uint, TextureBarrier *> _textureBarriers;
+
+    std::chrono::steady_clock::time_point _frameBegin;
+};
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,536 @@
+/****************************************************************************
+ Copyright (c) 2019-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/CoreStd.h"
+#include "base/Utils.h"
+#include "gfx-base/GFXDevice.h"
+
+namespace cc {
+namespace gfx {
+
+constexpr uint CAPTURE_MAGIC              = 0x43584647U; // 'GFXC'
+constexpr uint CAPTURE_VERSION            = 1U;
+constexpr uint CAPTURE_RECORD_HEADER_SIZE = sizeof(uint8_t) + 2 * sizeof(uint);
+
+/**
+ * Capture files are a header followed by a flat list of records:
+ * [CaptureOp : uint8][subject object ID : uint32][payload size : uint32][payload]
+ * Object IDs are assigned in creation order, 0 stands for null.
+ * Commands of each command buffer are grouped and emitted on flush or submit,
+ * the same point at which the agent layer hands them over to the render thread.
+ */
+enum class CaptureOp : uint8_t {
+    // resources
+    DEVICE_QUEUE,
+    DEVICE_COMMAND_BUFFER,
+    CREATE_QUEUE,
+    CREATE_COMMAND_BUFFER,
+    CREATE_BUFFER,
+    CREATE_BUFFER_VIEW,
+    CREATE_TEXTURE,
+    CREATE_TEXTURE_VIEW,
+    CREATE_SAMPLER,
+    CREATE_SHADER,
+    CREATE_INPUT_ASSEMBLER,
+    CREATE_RENDER_PASS,
+    CREATE_FRAMEBUFFER,
+    CREATE_DESCRIPTOR_SET_LAYOUT,
+    CREATE_PIPELINE_LAYOUT,
+    CREATE_PIPELINE_STATE,
+    CREATE_DESCRIPTOR_SET,
+    DESTROY,
+    BUFFER_UPDATE,
+    BUFFER_RESIZE,
+    TEXTURE_RESIZE,
+    COPY_BUFFERS_TO_TEXTURE,
+    DESCRIPTOR_SET_BIND_BUFFER,
+    DESCRIPTOR_SET_BIND_TEXTURE,
+    DESCRIPTOR_SET_BIND_SAMPLER,
+    DESCRIPTOR_SET_UPDATE,
+    // frames
+    DEVICE_RESIZE,
+    DEVICE_ACQUIRE,
+    DEVICE_PRESENT,
+    DEVICE_FLUSH_COMMANDS,
+    QUEUE_SUBMIT,
+    // commands
+    CMD_BEGIN,
+    CMD_END,
+    CMD_BEGIN_RENDER_PASS,
+    CMD_END_RENDER_PASS,
+    CMD_BIND_PIPELINE_STATE,
+    CMD_BIND_DESCRIPTOR_SET,
+    CMD_BIND_INPUT_ASSEMBLER,
+    CMD_SET_VIEWPORT,
+    CMD_SET_SCISSOR,
+    CMD_SET_LINE_WIDTH,
+    CMD_SET_DEPTH_BIAS,
+    CMD_SET_BLEND_CONSTANTS,
+    CMD_SET_DEPTH_BOUND,
+    CMD_SET_STENCIL_WRITE_MASK,
+    CMD_SET_STENCIL_COMPARE_MASK,
+    CMD_NEXT_SUBPASS,
+    CMD_DRAW,
+    CMD_UPDATE_BUFFER,
+    CMD_COPY_BUFFERS_TO_TEXTURE,
+    CMD_BLIT_TEXTURE,
+    CMD_EXECUTE,
+    CMD_DISPATCH,
+    CMD_PIPELINE_BARRIER,
+    COUNT,
+};
+
+struct CaptureHeader {
+    uint magic      = CAPTURE_MAGIC;
+    uint version    = CAPTURE_VERSION;
+    API  api        = API::UNKNOWN;
+    uint width      = 0U;
+    uint height     = 0U;
+    uint frameCount = 0U;
+    uint payloads   = 1U; // data payloads are stored, or just their sizes and hashes
+};
+
+// Raw data referenced by an API call, e.g. buffer updates and texture uploads.
+struct CaptureBlob {
+    const uint8_t *data = nullptr;
+    uint           size = 0U;
+    uint           hash = 0U;
+};
+
+// views over caller-owned arrays, laid out the same way as vectors
+template <typename T>
+struct CaptureArray {
+    const T *data  = nullptr;
+    uint     count = 0U;
+};
+
+inline uint computeCaptureHash(const uint8_t *data, uint size) {
+    uint seed = size;
+    for (uint i = 0U; i < size; ++i) {
+        seed ^= data[i] + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
+
+// plain data types that are stored as-is
+template <typename T>
+struct capture_raw : std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value> {};
+template <> struct capture_raw<Rect> : std::true_type {};
+template <> struct capture_raw<Viewport> : std::true_type {};
+template <> struct capture_raw<Color> : std::true_type {};
+template <> struct capture_raw<DrawInfo> : std::true_type {};
+template <> struct capture_raw<BufferTextureCopy> : std::true_type {};
+template <> struct capture_raw<TextureBlit> : std::true_type {};
+template <> struct capture_raw<BufferInfo> : std::true_type {};
+template <> struct capture_raw<TextureInfo> : std::true_type {};
+template <> struct capture_raw<SamplerInfo> : std::true_type {};
+template <> struct capture_raw<QueueInfo> : std::true_type {};
+template <> struct capture_raw<RasterizerState> : std::true_type {};
+template <> struct capture_raw<DepthStencilState> : std::true_type {};
+template <> struct capture_raw<BlendTarget> : std::true_type {};
+
+template <typename T>
+using is_capture_object = std::is_base_of<GFXObject, T>;
+
+class CaptureWriter {
+public:
+    CaptureWriter(vector<uint8_t> *out, const unordered_map<const GFXObject *, uint> *objectIDs, bool payloads)
+    : _out(out), _objectIDs(objectIDs), _payloads(payloads) {}
+
+    template <typename T>
+    std::enable_if_t<capture_raw<T>::value> io(const T &value) {
+        const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+        _out->insert(_out->end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    std::enable_if_t<is_capture_object<T>::value> io(T *const &object) {
+        uint id = 0U;
+        if (object) {
+            auto iter = _objectIDs->find(object);
+            if (iter != _objectIDs->end()) id = iter->second;
+        }
+        io(id);
+    }
+
+    template <typename T>
+    std::enable_if_t<!capture_raw<T>::value> io(const T &value) {
+        serialize(*this, const_cast<T &>(value));
+    }
+
+    template <typename T>
+    void io(const vector<T> &values) {
+        io(utils::toUint(values.size()));
+        for (const auto &value : values) io(value);
+    }
+
+    template <typename T>
+    void io(const CaptureArray<T> &values) {
+        io(values.count);
+        for (uint i = 0U; i < values.count; ++i) io(values.data[i]);
+    }
+
+    void io(const String &value) {
+        io(utils::toUint(value.size()));
+        _out->insert(_out->end(), value.begin(), value.end());
+    }
+
+    void io(const CaptureBlob &blob) {
+        io(blob.size);
+        io(blob.data ? computeCaptureHash(blob.data, blob.size) : blob.hash);
+        if (_payloads && blob.data) {
+            _out->insert(_out->end(), blob.data, blob.data + blob.size);
+        }
+    }
+
+private:
+    vector<uint8_t> *                                 _out       = nullptr;
+    const unordered_map<const GFXObject *, uint> *_objectIDs = nullptr;
+    bool                                              _payloads  = true;
+};
+
+class CaptureReader {
+public:
+    CaptureReader(const uint8_t *data, uint size, const vector<GFXObject *> *objects, bool payloads)
+    : _data(data), _end(data + size), _objects(objects), _payloads(payloads) {}
+
+    template <typename T>
+    std::enable_if_t<capture_raw<T>::value> io(T &value) {
+        CCASSERT(_data + sizeof(T) <= _end, "Capture record overflow");
+        memcpy(&value, _data, sizeof(T));
+        _data += sizeof(T);
+    }
+
+    template <typename T>
+    std::enable_if_t<is_capture_object<T>::value> io(T *&object) {
+        uint id = 0U;
+        io(id);
+        object = id && id < _objects->size() ? static_cast<T *>((*_objects)[id]) : nullptr;
+    }
+
+    template <typename T>
+    std::enable_if_t<!capture_raw<T>::value> io(T &value) {
+        serialize(*this, value);
+    }
+
+    template <typename T>
+    void io(vector<T> &values) {
+        uint size = 0U;
+        io(size);
+        values.resize(size);
+        for (auto &value : values) io(value);
+    }
+
+    void io(String &value) {
+        uint size = 0U;
+        io(size);
+        value.assign(reinterpret_cast<const char *>(_data), size);
+        _data += size;
+    }
+
+    // payloads point into the capture data; missing payloads are left to the caller
+    void io(CaptureBlob &blob) {
+        io(blob.size);
+        io(blob.hash);
+        blob.data = nullptr;
+        if (_payloads) {
+            blob.data = _data;
+            _data += blob.size;
+        }
+    }
+
+    inline bool finished() const { return _data >= _end; }
+
+private:
+    const uint8_t *           _data     = nullptr;
+    const uint8_t *           _end      = nullptr;
+    const vector<GFXObject *> *_objects = nullptr;
+    bool                      _payloads = true;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+template <typename Ar>
+void serialize(Ar &ar, BufferViewInfo &info) {
+    ar.io(info.buffer);
+    ar.io(info.offset);
+    ar.io(info.range);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, TextureViewInfo &info) {
+    ar.io(info.texture);
+    ar.io(info.type);
+    ar.io(info.format);
+    ar.io(info.baseLevel);
+    ar.io(info.levelCount);
+    ar.io(info.baseLayer);
+    ar.io(info.layerCount);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, CommandBufferInfo &info) {
+    ar.io(info.queue);
+    ar.io(info.type);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, DispatchInfo &info) {
+    ar.io(info.groupCountX);
+    ar.io(info.groupCountY);
+    ar.io(info.groupCountZ);
+    ar.io(info.indirectBuffer);
+    ar.io(info.indirectOffset);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, Uniform &info) {
+    ar.io(info.name);
+    ar.io(info.type);
+    ar.io(info.count);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformBlock &info) {
+    ar.io(info.set);
+    ar.io(info.binding);
+    ar.io(info.name);
+    ar.io(info.members);
+    ar.io(info.count);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformSamplerTexture &info) {
+    ar.io(info.set);
+    ar.io(info.binding);
+    ar.io(info.name);
+    ar.io(info.type);
+    ar.io(info.count);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformSampler &info) {
+    ar.io(info.set);
+    ar.io(info.binding);
+    ar.io(info.name);
+    ar.io(info.count);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformTexture &info) {
+    ar.io(info.set);
+    ar.io(info.binding);
+    ar.io(info.name);
+    ar.io(info.type);
+    ar.io(info.count);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformStorageImage &info) {
+    ar.io(info.set);
+    ar.io(info.binding);
+    ar.io(info.name);
+    ar.io(info.type);
+    ar.io(info.count);
+    ar.io(info.memoryAccess);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformStorageBuffer &info) {
+    ar.io(info.set);
+    ar.io(info.binding);
+    ar.io(info.name);
+    ar.io(info.count);
+    ar.io(info.memoryAccess);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformInputAttachment &info) {
+    ar.io(info.set);
+    ar.io(info.binding);
+    ar.io(info.name);
+    ar.io(info.count);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, ShaderStage &info) {
+    ar.io(info.stage);
+    ar.io(info.source);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, Attribute &info) {
+    ar.io(info.name);
+    ar.io(info.format);
+    ar.io(info.isNormalized);
+    ar.io(info.stream);
+    ar.io(info.isInstanced);
+    ar.io(info.location);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, ShaderInfo &info) {
+    ar.io(info.name);
+    ar.io(info.stages);
+    ar.io(info.attributes);
+    ar.io(info.blocks);
+    ar.io(info.buffers);
+    ar.io(info.samplerTextures);
+    ar.io(info.samplers);
+    ar.io(info.textures);
+    ar.io(info.images);
+    ar.io(info.subpassInputs);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, InputAssemblerInfo &info) {
+    ar.io(info.attributes);
+    ar.io(info.vertexBuffers);
+    ar.io(info.indexBuffer);
+    ar.io(info.indirectBuffer);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, ColorAttachment &info) {
+    ar.io(info.format);
+    ar.io(info.sampleCount);
+    ar.io(info.loadOp);
+    ar.io(info.storeOp);
+    ar.io(info.beginAccesses);
+    ar.io(info.endAccesses);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, DepthStencilAttachment &info) {
+    ar.io(info.format);
+    ar.io(info.sampleCount);
+    ar.io(info.depthLoadOp);
+    ar.io(info.depthStoreOp);
+    ar.io(info.stencilLoadOp);
+    ar.io(info.stencilStoreOp);
+    ar.io(info.beginAccesses);
+    ar.io(info.endAccesses);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, SubpassInfo &info) {
+    ar.io(info.inputs);
+    ar.io(info.colors);
+    ar.io(info.resolves);
+    ar.io(info.preserves);
+    ar.io(info.depthStencil);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, SubpassDependency &info) {
+    ar.io(info.srcSubpass);
+    ar.io(info.dstSubpass);
+    ar.io(info.srcAccesses);
+    ar.io(info.dstAccesses);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, RenderPassInfo &info) {
+    ar.io(info.colorAttachments);
+    ar.io(info.depthStencilAttachment);
+    ar.io(info.subpasses);
+    ar.io(info.dependencies);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, GlobalBarrierInfo &info) {
+    ar.io(info.prevAccesses);
+    ar.io(info.nextAccesses);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, TextureBarrierInfo &info) {
+    ar.io(info.prevAccesses);
+    ar.io(info.nextAccesses);
+    ar.io(info.discardContents);
+    ar.io(info.srcQueue);
+    ar.io(info.dstQueue);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, FramebufferInfo &info) {
+    ar.io(info.renderPass);
+    ar.io(info.colorTextures);
+    ar.io(info.depthStencilTexture);
+    ar.io(info.colorMipmapLevels);
+    ar.io(info.depthStencilMipmapLevel);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, DescriptorSetLayoutBinding &info) {
+    ar.io(info.binding);
+    ar.io(info.descriptorType);
+    ar.io(info.count);
+    ar.io(info.stageFlags);
+    ar.io(info.immutableSamplers);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, DescriptorSetLayoutInfo &info) {
+    ar.io(info.bindings);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, DescriptorSetInfo &info) {
+    ar.io(info.layout);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, PipelineLayoutInfo &info) {
+    ar.io(info.setLayouts);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, BlendState &info) {
+    ar.io(info.isA2C);
+    ar.io(info.isIndepend);
+    ar.io(info.blendColor);
+    ar.io(info.targets);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, PipelineStateInfo &info) {
+    ar.io(info.shader);
+    ar.io(info.pipelineLayout);
+    ar.io(info.renderPass);
+    ar.io(info.inputState.attributes);
+    ar.io(info.rasterizerState);
+    ar.io(info.depthStencilState);
+    ar.io(info.blendState);
+    ar.io(info.primitive);
+    ar.io(info.dynamicStates);
+    ar.io(info.bindPoint);
+    ar.io(info.subpass);
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,266 @@
+/****************************************************************************
+ Copyright (c) 2019-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CoreStd.h"
+
+#include <cstdlib>
+#include "DeviceCapture.h"
+#include "gfx-base/GFXDescriptorSet.h"
+#include "gfx-base/GFXDescriptorSetLayout.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXGlobalBarrier.h"
+#include "gfx-base/GFXTexture.h"
+#include "gfx-base/GFXTextureBarrier.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+namespace gfx {
+
+DeviceCapture *DeviceCapture::instance = nullptr;
+
+void DeviceCapture::enableTracking(bool payloads) {
+    if (!instance) instance = CC_NEW(DeviceCapture(payloads));
+}
+
+void DeviceCapture::disableTracking() {
+    CC_SAFE_DELETE(instance);
+}
+
+void DeviceCapture::enableTrackingFromEnvironment() {
+    const char *path = getenv("CC_GFX_CAPTURE");
+    if (!path || !*path) return;
+
+    const char *frames = getenv("CC_GFX_CAPTURE_FRAMES");
+    const char *start  = getenv("CC_GFX_CAPTURE_START");
+    uint        count  = frames ? static_cast<uint>(strtoul(frames, nullptr, 10)) : 1U;
+    if (!count) count = 1U;
+
+    enableTracking();
+    instance->captureFrames(path, count, start ? static_cast<uint>(strtoul(start, nullptr, 10)) : 0U);
+    CC_LOG_INFO("GFX capture: %u frame(s) to %s", count, path);
+}
+
+DeviceCapture::DeviceCapture(bool payloads)
+: _payloads(payloads) {
+}
+
+void DeviceCapture::captureFrames(const String &path, uint frameCount, uint skippedFrames) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    CCASSERT(!_capturing, "Capture already in progress");
+
+    _path          = path;
+    _pendingFrames = frameCount;
+    _skippedFrames = skippedFrames;
+}
+
+uint DeviceCapture::getID(const GFXObject *object) const {
+    if (!object) return 0U;
+    auto iter = _objectIDs.find(object);
+    return iter != _objectIDs.end() ? iter->second : 0U;
+}
+
+void DeviceCapture::destroy(const GFXObject *object) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto iter = _objectIDs.find(object);
+    if (iter == _objectIDs.end()) return;
+
+    if (_capturing) write(&_stream, CaptureOp::DESTROY, iter->second);
+    _objects.erase(iter->second);
+    _commands.erase(iter->second);
+    _objectIDs.erase(iter);
+}
+
+void DeviceCapture::updateBuffer(const GFXObject *buffer, const void *data, uint size) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    uint id   = getID(buffer);
+    auto iter = _objects.find(id);
+    if (iter == _objects.end()) return;
+
+    CaptureBlob blob{static_cast<const uint8_t *>(data), size};
+    // only the latest contents matter for replaying from an arbitrary frame
+    iter->second.contents.clear();
+    write(&iter->second.contents, CaptureOp::BUFFER_UPDATE, id, blob);
+    if (_capturing) write(&_stream, CaptureOp::BUFFER_UPDATE, id, blob);
+}
+
+vector<CaptureBlob> DeviceCapture::getTextureBlobs(const uint8_t *const *buffers, const Texture *texture, const BufferTextureCopy *regions, uint count) {
+    vector<CaptureBlob> blobs;
+    for (uint i = 0U, n = 0U; i < count; i++) {
+        const BufferTextureCopy &region = regions[i];
+        uint                     size   = formatSize(texture->getFormat(), region.texExtent.width, region.texExtent.height, 1);
+        for (uint l = 0; l < region.texSubres.layerCount; l++) {
+            blobs.push_back({buffers[n++], size});
+        }
+    }
+    return blobs;
+}
+
+void DeviceCapture::copyBuffersToTexture(const uint8_t *const *buffers, const Texture *texture, const BufferTextureCopy *regions, uint count) {
+    track(CaptureOp::COPY_BUFFERS_TO_TEXTURE, texture, CaptureArray<BufferTextureCopy>{regions, count},
+          getTextureBlobs(buffers, texture, regions, count));
+}
+
+void DeviceCapture::copyBuffersToTexture(const CommandBuffer *cmdBuff, const uint8_t *const *buffers, const Texture *texture, const BufferTextureCopy *regions, uint count) {
+    command(cmdBuff, CaptureOp::CMD_COPY_BUFFERS_TO_TEXTURE, texture, CaptureArray<BufferTextureCopy>{regions, count},
+            getTextureBlobs(buffers, texture, regions, count));
+}
+
+void DeviceCapture::pipelineBarrier(const CommandBuffer *cmdBuff, const GlobalBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint textureBarrierCount) {
+    // barriers are device-cached objects without agents, so they are stored by value
+    vector<TextureBarrierInfo> textureBarrierInfos(textureBarrierCount);
+    for (uint i = 0U; i < textureBarrierCount; ++i) {
+        textureBarrierInfos[i] = textureBarriers[i]->info();
+    }
+    command(cmdBuff, CaptureOp::CMD_PIPELINE_BARRIER, barrier != nullptr, barrier ? barrier->info() : GlobalBarrierInfo(),
+            textureBarrierInfos, CaptureArray<const Texture *>{textures, textureBarrierCount});
+}
+
+void DeviceCapture::emitCommands(const CommandBuffer *cmdBuff) {
+    auto iter = _commands.find(getID(cmdBuff));
+    if (iter == _commands.end()) return;
+
+    _stream.insert(_stream.end(), iter->second.begin(), iter->second.end());
+    iter->second.clear();
+}
+
+void DeviceCapture::flushCommands(CommandBuffer *const *cmdBuffs, uint count) {
+    if (!_capturing) return;
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_capturing) return; // ended in between
+
+    for (uint i = 0U; i < count; ++i) {
+        emitCommands(cmdBuffs[i]);
+    }
+    write(&_stream, CaptureOp::DEVICE_FLUSH_COMMANDS, 0U, CaptureArray<CommandBuffer *>{cmdBuffs, count});
+}
+
+void DeviceCapture::submit(const Queue *queue, CommandBuffer *const *cmdBuffs, uint count) {
+    if (!_capturing) return;
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_capturing) return; // ended in between
+
+    for (uint i = 0U; i < count; ++i) {
+        emitCommands(cmdBuffs[i]);
+    }
+    write(&_stream, CaptureOp::QUEUE_SUBMIT, getID(queue), CaptureArray<CommandBuffer *>{cmdBuffs, count});
+}
+
+void DeviceCapture::resize(uint width, uint height) {
+    record(CaptureOp::DEVICE_RESIZE, nullptr, width, height);
+}
+
+void DeviceCapture::acquire() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_capturing && _pendingFrames) {
+        if (_skippedFrames) {
+            --_skippedFrames;
+        } else {
+            begin();
+        }
+    }
+    if (_capturing) write(&_stream, CaptureOp::DEVICE_ACQUIRE, 0U);
+}
+
+void DeviceCapture::present() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_capturing) return;
+
+    write(&_stream, CaptureOp::DEVICE_PRESENT, 0U);
+    if (++_capturedFrames >= _pendingFrames) end();
+}
+
+void DeviceCapture::begin() {
+    _capturing      = true;
+    _capturedFrames = 0U;
+    _stream.assign(sizeof(CaptureHeader), 0U);
+    _commands.clear();
+
+    // objects only reference ones created before them, so the ID order is a valid creation order
+    for (const auto &iter : _objects) {
+        const TrackedObject &tracked = iter.second;
+        _stream.insert(_stream.end(), tracked.records.begin(), tracked.records.end());
+        if (tracked.object->getType() == ObjectType::BUFFER) {
+            _stream.insert(_stream.end(), tracked.contents.begin(), tracked.contents.end());
+        }
+    }
+
+    // descriptor bindings and bundle contents may point to anything, so they come last
+    for (const auto &iter : _objects) {
+        const TrackedObject &tracked = iter.second;
+        if (tracked.object->getType() == ObjectType::DESCRIPTOR_SET) {
+            const auto *descriptorSet = static_cast<const DescriptorSet *>(tracked.object);
+            if (!descriptorSet->getLayout()) continue;
+            for (const DescriptorSetLayoutBinding &binding : descriptorSet->getLayout()->getBindings()) {
+                for (uint i = 0U; i < binding.count; ++i) {
+                    if (const Buffer *buffer = descriptorSet->getBuffer(binding.binding, i)) {
+                        write(&_stream, CaptureOp::DESCRIPTOR_SET_BIND_BUFFER, iter.first, binding.binding, buffer, i);
+                    }
+                    if (const Texture *texture = descriptorSet->getTexture(binding.binding, i)) {
+                        write(&_stream, CaptureOp::DESCRIPTOR_SET_BIND_TEXTURE, iter.first, binding.binding, texture, i);
+                    }
+                    if (const Sampler *sampler = descriptorSet->getSampler(binding.binding, i)) {
+                        write(&_stream, CaptureOp::DESCRIPTOR_SET_BIND_SAMPLER, iter.first, binding.binding, sampler, i);
+                    }
+                }
+            }
+            write(&_stream, CaptureOp::DESCRIPTOR_SET_UPDATE, iter.first);
+        } else if (tracked.object->getType() == ObjectType::COMMAND_BUFFER) {
+            // bundles still being recorded are completed by the captured stream
+            _stream.insert(_stream.end(), tracked.contents.begin(), tracked.contents.end());
+            if (tracked.bundled) write(&_stream, CaptureOp::DEVICE_FLUSH_COMMANDS, 0U, 1U, iter.first);
+        }
+    }
+}
+
+void DeviceCapture::end() {
+    Device *device = Device::getInstance();
+
+    CaptureHeader header;
+    header.api        = device->getGfxAPI();
+    header.width      = device->getWidth();
+    header.height     = device->getHeight();
+    header.frameCount = _capturedFrames;
+    header.payloads   = _payloads ? 1U : 0U;
+    memcpy(_stream.data(), &header, sizeof(CaptureHeader));
+
+    Data data;
+    data.copy(_stream.data(), static_cast<ssize_t>(_stream.size()));
+    if (FileUtils::getInstance()->writeDataToFile(data, _path)) {
+        CC_LOG_INFO("GFX capture of %u frames written to %s (%u bytes)", _capturedFrames, _path.c_str(), utils::toUint(_stream.size()));
+    } else {
+        CC_LOG_ERROR("Failed to write GFX capture to %s", _path.c_str());
+    }
+
+    _capturing     = false;
+    _pendingFrames = 0U;
+    _stream.clear();
+    _stream.shrink_to_fit();
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,199 @@
+/****************************************************************************
+ Copyright (c) 2019-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+
+#include "CaptureStream.h"
+#include "gfx-base/GFXCommandBuffer.h"
+
+namespace cc {
+namespace gfx {
+
+/**
+ * Records the API stream issued to the agent layer.
+ * Tracking has to be enabled before the device is created, so that every live object
+ * and the latest contents of its resources can be written out when a capture starts.
+ * A capture begins at the next acquire and ends after the requested number of presents.
+ */
+class CC_DLL DeviceCapture final {
+public:
+    static DeviceCapture *getInstance() { return instance; }
+    static void           enableTracking(bool payloads = true);
+    static void           disableTracking();
+    static inline bool    isTracking() { return instance != nullptr; }
+
+    /**
+     * Runtime switch, no rebuild needed: when the CC_GFX_CAPTURE environment variable names a
+     * capture file, enables tracking and captures CC_GFX_CAPTURE_FRAMES frames (1 by default)
+     * after skipping the first CC_GFX_CAPTURE_START ones (0 by default).
+     */
+    static void enableTrackingFromEnvironment();
+
+    void        captureFrames(const String &path, uint frameCount, uint skippedFrames = 0U);
+    inline bool isCapturing() const { return _capturing; }
+
+    template <typename... Args>
+    void create(CaptureOp op, const GFXObject *object, const Args &...args);
+    template <typename... Args>
+    void track(CaptureOp op, const GFXObject *object, const Args &...args);
+    template <typename... Args>
+    void record(CaptureOp op, const GFXObject *subject, const Args &...args);
+    template <typename... Args>
+    void command(const CommandBuffer *cmdBuff, CaptureOp op, const Args &...args);
+
+    void destroy(const GFXObject *object);
+    void updateBuffer(const GFXObject *buffer, const void *data, uint size);
+    void copyBuffersToTexture(const uint8_t *const *buffers, const Texture *texture, const BufferTextureCopy *regions, uint count);
+    void copyBuffersToTexture(const CommandBuffer *cmdBuff, const uint8_t *const *buffers, const Texture *texture, const BufferTextureCopy *regions, uint count);
+    void pipelineBarrier(const CommandBuffer *cmdBuff, const GlobalBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint textureBarrierCount);
+    void flushCommands(CommandBuffer *const *cmdBuffs, uint count);
+    void submit(const Queue *queue, CommandBuffer *const *cmdBuffs, uint count);
+    void resize(uint width, uint height);
+    void acquire();
+    void present();
+
+private:
+    static DeviceCapture *instance;
+
+    explicit DeviceCapture(bool payloads);
+
+    struct TrackedObject {
+        const GFXObject *object  = nullptr;
+        size_t           created = 0U;    // size of the creation record
+        bool             bundled = false; // a complete bundle is kept in contents
+        vector<uint8_t>  records;         // creation, resizes and uploads, replayed in order
+        vector<uint8_t>  contents;        // latest buffer update, or the recorded bundle commands
+    };
+
+    template <typename... Args>
+    void write(vector<uint8_t> *out, CaptureOp op, uint id, const Args &...args);
+
+    vector<CaptureBlob> getTextureBlobs(const uint8_t *const *buffers, const Texture *texture, const BufferTextureCopy *regions, uint count);
+
+    uint getID(const GFXObject *object) const;
+    void emitCommands(const CommandBuffer *cmdBuff);
+    void begin();
+    void end();
+
+    std::mutex        _mutex;
+    bool              _payloads = true;
+    std::atomic<bool> _capturing{false}; // written under the mutex, also read without it as a fast path
+
+    uint                                   _nextID = 1U;
+    unordered_map<const GFXObject *, uint> _objectIDs;
+    std::map<uint, TrackedObject>          _objects;
+    unordered_map<uint, vector<uint8_t>>   _commands;
+
+    String          _path;
+    uint            _pendingFrames  = 0U;
+    uint            _skippedFrames  = 0U; // acquires to let pass before a requested capture begins
+    uint            _capturedFrames = 0U;
+    vector<uint8_t> _stream;
+};
+
+template <typename... Args>
+void DeviceCapture::write(vector<uint8_t> *out, CaptureOp op, uint id, const Args &...args) {
+    size_t        start = out->size();
+    CaptureWriter writer(out, &_objectIDs, _payloads);
+    writer.io(op);
+    writer.io(id);
+    writer.io(0U);
+    (writer.io(args), ...);
+
+    uint size = utils::toUint(out->size() - start - CAPTURE_RECORD_HEADER_SIZE);
+    memcpy(out->data() + start + sizeof(CaptureOp) + sizeof(uint), &size, sizeof(uint));
+}
+
+template <typename... Args>
+void DeviceCapture::create(CaptureOp op, const GFXObject *object, const Args &...args) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // re-initialized objects are treated as new ones so references always point backwards
+    auto iter = _objectIDs.find(object);
+    if (iter != _objectIDs.end()) {
+        if (_capturing) write(&_stream, CaptureOp::DESTROY, iter->second);
+        _objects.erase(iter->second);
+        _commands.erase(iter->second);
+        _objectIDs.erase(iter);
+    }
+
+    uint id            = _nextID++;
+    _objectIDs[object] = id;
+
+    TrackedObject &tracked = _objects[id];
+    tracked.object         = object;
+    write(&tracked.records, op, id, args...);
+    tracked.created = tracked.records.size();
+    if (_capturing) write(&_stream, op, id, args...);
+}
+
+template <typename... Args>
+void DeviceCapture::track(CaptureOp op, const GFXObject *object, const Args &...args) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    uint id   = getID(object);
+    auto iter = _objects.find(id);
+    if (iter == _objects.end()) return;
+
+    TrackedObject &tracked = iter->second;
+    // resizing discards previous texture uploads, and keeps the record list from growing
+    if (op == CaptureOp::TEXTURE_RESIZE || op == CaptureOp::BUFFER_RESIZE) {
+        tracked.records.resize(tracked.created);
+    }
+    write(&tracked.records, op, id, args...);
+    if (_capturing) write(&_stream, op, id, args...);
+}
+
+template <typename... Args>
+void DeviceCapture::record(CaptureOp op, const GFXObject *subject, const Args &...args) {
+    if (!_capturing) return;
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_capturing) return; // ended in between
+
+    write(&_stream, op, getID(subject), args...);
+}
+
+template <typename... Args>
+void DeviceCapture::command(const CommandBuffer *cmdBuff, CaptureOp op, const Args &...args) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    uint id   = getID(cmdBuff);
+    auto iter = _objects.find(id);
+    if (iter == _objects.end()) return;
+
+    if (cmdBuff->getType() == CommandBufferType::BUNDLE) {
+        // bundles may be replayed long after they are recorded, so always keep the latest
+        TrackedObject &tracked = iter->second;
+        if (op == CaptureOp::CMD_BEGIN) tracked.contents.clear();
+        write(&tracked.contents, op, id, args...);
+        tracked.bundled = op == CaptureOp::CMD_END;
+    }
+    if (_capturing) write(&_commands[id], op, id, args...);
+}
+
+} // namespace gfx
+} // namespace cc
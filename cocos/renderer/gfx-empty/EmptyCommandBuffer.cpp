@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "EmptyCommandBuffer.h"
+#include "EmptyDevice.h"
 
 namespace cc {
 namespace gfx {
@@ -103,5 +104,13 @@ void EmptyCommandBuffer::dispatch(const DispatchInfo &info) {
 void EmptyCommandBuffer::pipelineBarrier(const GlobalBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint textureBarrierCount) {
 }
 
+void EmptyCommandBuffer::beginTimingScope(const String &name) {
+    EmptyDevice::getInstance()->beginTimingScope(name);
+}
+
+void EmptyCommandBuffer::endTimingScope() {
+    EmptyDevice::getInstance()->endTimingScope();
+}
+
 } // namespace gfx
 } // namespace cc
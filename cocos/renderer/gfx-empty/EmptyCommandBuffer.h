@@ -55,6 +55,8 @@ public:
     void execute(CommandBuffer *const *cmdBuffs, uint32_t count) override;
     void dispatch(const DispatchInfo &info) override;
     void pipelineBarrier(const GlobalBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint textureBarrierCount) override;
+    void beginTimingScope(const String &name) override;
+    void endTimingScope() override;
 
 protected:
     void doInit(const CommandBufferInfo &info) override;
@@ -77,7 +77,8 @@ bool EmptyDevice::doInit(const DeviceInfo &info) {
     cmdBuffInfo.queue = _queue;
     _cmdBuff          = createCommandBuffer(cmdBuffInfo);
 
-    _features[static_cast<uint>(Feature::FORMAT_D24S8)] = true;
+    _features[static_cast<uint>(Feature::FORMAT_D24S8)]    = true;
+    _features[static_cast<uint>(Feature::TIMESTAMP_QUERY)] = true;
 
     CC_LOG_INFO("Empty device initialized.");
     CC_LOG_INFO("SCREEN_SIZE: %d x %d", _width, _height);
@@ -102,6 +103,32 @@ void EmptyDevice::acquire() {
 
 void EmptyDevice::present() {
     std::this_thread::sleep_for(std::chrono::milliseconds(16));
+
+    _timingScopes.swap(_pendingTimingScopes);
+    _pendingTimingScopes.clear();
+    _openTimingScopes.clear();
+}
+
+void EmptyDevice::beginTimingScope(const String &name) {
+    if (_pendingTimingScopes.size() >= MAX_TIMING_SCOPES) {
+        _openTimingScopes.emplace_back(UINT_MAX, Clock::now());
+        return;
+    }
+
+    uint index = static_cast<uint>(_pendingTimingScopes.size());
+    _pendingTimingScopes.push_back({name, static_cast<uint>(_openTimingScopes.size()), 0.F});
+    _openTimingScopes.emplace_back(index, Clock::now());
+}
+
+void EmptyDevice::endTimingScope() {
+    if (_openTimingScopes.empty()) return;
+
+    auto scope = _openTimingScopes.back();
+    _openTimingScopes.pop_back();
+    if (scope.first == UINT_MAX) return;
+
+    auto duration                             = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - scope.second);
+    _pendingTimingScopes[scope.first].gpuTime = static_cast<float>(duration.count()) * 1e-3F;
 }
 
 CommandBuffer *EmptyDevice::createCommandBuffer(const CommandBufferInfo &info, bool Emptyhas) {
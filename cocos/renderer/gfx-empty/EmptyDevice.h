@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "gfx-base/GFXDevice.h"
 
 namespace cc {
@@ -74,6 +76,10 @@ public:
     TextureBarrier *     createTextureBarrier() override;
     void                 copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) override;
 
+    // there is no GPU here, timing scopes measure the CPU time in between instead
+    void beginTimingScope(const String &name);
+    void endTimingScope();
+
 protected:
     static EmptyDevice *_instance;
 
@@ -83,6 +89,11 @@ protected:
 
     bool doInit(const DeviceInfo &info) override;
     void doDestroy() override;
+
+    using Clock = std::chrono::steady_clock;
+
+    TimingScopeList                            _pendingTimingScopes;
+    vector<std::pair<uint, Clock::time_point>> _openTimingScopes;
 };
 
 } // namespace gfx
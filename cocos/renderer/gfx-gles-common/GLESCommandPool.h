@@ -42,6 +42,7 @@ enum class GLESCmdType : uint8_t {
     BLIT_TEXTURE,
     DISPATCH,
     BARRIER,
+    QUERY_TIMESTAMP,
     COUNT,
 };
 
@@ -95,6 +95,16 @@ void GLES2CommandBuffer::end() {
     }
     _isInRenderPass = false;
 
+    if (_type == CommandBufferType::BUNDLE) {
+        // only the latest recording of a bundle is kept
+        while (!_pendingPackages.empty()) {
+            GLES2CmdPackage *package = _pendingPackages.front();
+            _cmdAllocator->clearCmds(package);
+            _freePackages.push(package);
+            _pendingPackages.pop();
+        }
+    }
+
     _pendingPackages.push(_curCmdPackage);
     if (!_freePackages.empty()) {
         _curCmdPackage = _freePackages.front();
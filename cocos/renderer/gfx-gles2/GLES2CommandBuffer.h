@@ -39,6 +39,7 @@ public:
     ~GLES2CommandBuffer() override;
 
     friend class GLES2Queue;
+    friend class GLES2PrimaryCommandBuffer;
 
     void begin(RenderPass *renderPass, uint subpass, Framebuffer *frameBuffer) override;
     void end() override;
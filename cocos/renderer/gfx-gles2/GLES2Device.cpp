@@ -268,6 +268,8 @@ void GLES2Device::bindDeviceContext(bool bound) {
 }
 
 CommandBuffer *GLES2Device::createCommandBuffer(const CommandBufferInfo &info, bool hasAgent) {
+    // bundles have to keep their command packages even with agents
+    if (info.type == CommandBufferType::BUNDLE) return CC_NEW(GLES2CommandBuffer);
     if (hasAgent || info.type == CommandBufferType::PRIMARY) return CC_NEW(GLES2PrimaryCommandBuffer);
     return CC_NEW(GLES2CommandBuffer);
 }
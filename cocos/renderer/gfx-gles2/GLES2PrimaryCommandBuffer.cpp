@@ -127,9 +127,16 @@ void GLES2PrimaryCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffe
 
 void GLES2PrimaryCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
     for (uint i = 0; i < count; ++i) {
-        auto *cmdBuff = static_cast<GLES2PrimaryCommandBuffer *>(cmdBuffs[i]);
-
-        if (!cmdBuff->_pendingPackages.empty()) {
+        auto *cmdBuff = static_cast<GLES2CommandBuffer *>(cmdBuffs[i]);
+
+        if (cmdBuff->getType() == CommandBufferType::BUNDLE) {
+            // bundles are replayed as-is and stay valid until re-recorded
+            if (!cmdBuff->_pendingPackages.empty()) {
+                cmdFuncGLES2ExecuteCmds(GLES2Device::getInstance(), cmdBuff->_pendingPackages.front());
+                // states tracked here are overridden by the bundle
+                _isStateInvalid = _curGPUPipelineState != nullptr;
+            }
+        } else if (!cmdBuff->_pendingPackages.empty()) {
             GLES2CmdPackage *cmdPackage = cmdBuff->_pendingPackages.front();
 
             cmdFuncGLES2ExecuteCmds(GLES2Device::getInstance(), cmdPackage);
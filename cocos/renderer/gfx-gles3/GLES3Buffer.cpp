@@ -69,6 +69,7 @@ void GLES3Buffer::doInit(const BufferViewInfo &info) {
 }
 
 void GLES3Buffer::doDestroy() {
+    GLES3Device::getInstance()->cancelUploads(this);
     if (_gpuBuffer) {
         if (!_isBufferView) {
             cmdFuncGLES3DestroyBuffer(GLES3Device::getInstance(), _gpuBuffer);
@@ -94,6 +94,16 @@ void GLES3CommandBuffer::end() {
     }
     _isInRenderPass = false;
 
+    if (_type == CommandBufferType::BUNDLE) {
+        // only the latest recording of a bundle is kept
+        while (!_pendingPackages.empty()) {
+            GLES3CmdPackage *package = _pendingPackages.front();
+            _cmdAllocator->clearCmds(package);
+            _freePackages.push(package);
+            _pendingPackages.pop();
+        }
+    }
+
     _pendingPackages.push(_curCmdPackage);
     if (!_freePackages.empty()) {
         _curCmdPackage = _freePackages.front();
@@ -442,5 +452,25 @@ void GLES3CommandBuffer::pipelineBarrier(const GlobalBarrier *barrier, const Tex
     _curCmdPackage->cmds.push(GLESCmdType::BARRIER);
 }
 
+void GLES3CommandBuffer::beginTimingScope(const String &name) {
+    GLES3GPUTimestampPool *timestampPool = GLES3Device::getInstance()->timestampPool();
+    if (timestampPool) recordTimestamp(timestampPool->begin(name));
+}
+
+void GLES3CommandBuffer::endTimingScope() {
+    GLES3GPUTimestampPool *timestampPool = GLES3Device::getInstance()->timestampPool();
+    if (timestampPool) recordTimestamp(timestampPool->end());
+}
+
+void GLES3CommandBuffer::recordTimestamp(GLuint glQuery) {
+    if (!glQuery) return;
+
+    GLES3CmdQueryTimestamp *cmd = _cmdAllocator->queryTimestampCmdPool.alloc();
+    cmd->glQuery                = glQuery;
+
+    _curCmdPackage->queryTimestampCmds.push(cmd);
+    _curCmdPackage->cmds.push(GLESCmdType::QUERY_TIMESTAMP);
+}
+
 } // namespace gfx
 } // namespace cc
@@ -62,14 +62,18 @@ public:
     void execute(CommandBuffer *const *cmdBuffs, uint32_t count) override;
     void dispatch(const DispatchInfo &info) override;
     void pipelineBarrier(const GlobalBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint textureBarrierCount) override;
+    void beginTimingScope(const String &name) override;
+    void endTimingScope() override;
 
 protected:
     friend class GLES3Queue;
+    friend class GLES3PrimaryCommandBuffer;
 
     void doInit(const CommandBufferInfo &info) override;
     void doDestroy() override;
 
     virtual void bindStates();
+    virtual void recordTimestamp(GLuint glQuery);
 
     GLES3GPUCommandAllocator *_cmdAllocator = nullptr;
     GLES3CmdPackage *_curCmdPackage = nullptr;
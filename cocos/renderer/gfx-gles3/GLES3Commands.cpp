@@ -685,6 +685,20 @@ void cmdFuncGLES3CreateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
         }
     } else if (hasFlag(gpuBuffer->usage, BufferUsageBit::INDIRECT)) {
         gpuBuffer->glTarget = GL_NONE;
+        if (device->useDrawIndirect()) {
+            gpuBuffer->glTarget = GL_DRAW_INDIRECT_BUFFER;
+            gpuBuffer->indirectCmds.resize(gpuBuffer->count);
+            gpuBuffer->indexedIndirectCmds.resize(gpuBuffer->count);
+            GL_CHECK(glGenBuffers(1, &gpuBuffer->glBuffer));
+            if (gpuBuffer->count) {
+                if (device->stateCache()->glDrawIndirectBuffer != gpuBuffer->glBuffer) {
+                    GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gpuBuffer->glBuffer));
+                    device->stateCache()->glDrawIndirectBuffer = gpuBuffer->glBuffer;
+                }
+
+                GL_CHECK(glBufferData(GL_DRAW_INDIRECT_BUFFER, gpuBuffer->count * sizeof(GLES3DrawElementsIndirectCommand), nullptr, glUsage));
+            }
+        }
     } else if ((hasFlag(gpuBuffer->usage, BufferUsageBit::TRANSFER_DST)) ||
                (hasFlag(gpuBuffer->usage, BufferUsageBit::TRANSFER_SRC))) {
         gpuBuffer->buffer   = static_cast<uint8_t *>(CC_MALLOC(gpuBuffer->size));
@@ -751,6 +765,10 @@ void cmdFuncGLES3DestroyBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
                 device->stateCache()->glShaderStorageBuffer = 0;
             }
         }
+        if (device->stateCache()->glDrawIndirectBuffer == gpuBuffer->glBuffer) {
+            GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0));
+            device->stateCache()->glDrawIndirectBuffer = 0;
+        }
         GL_CHECK(glDeleteBuffers(1, &gpuBuffer->glBuffer));
         gpuBuffer->glBuffer = 0;
     }
@@ -814,6 +832,19 @@ void cmdFuncGLES3ResizeBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
     } else if (hasFlag(gpuBuffer->usage, BufferUsageBit::INDIRECT)) {
         gpuBuffer->indirects.resize(gpuBuffer->count);
         gpuBuffer->glTarget = GL_NONE;
+        if (gpuBuffer->glBuffer) {
+            gpuBuffer->glTarget = GL_DRAW_INDIRECT_BUFFER;
+            gpuBuffer->indirectCmds.resize(gpuBuffer->count);
+            gpuBuffer->indexedIndirectCmds.resize(gpuBuffer->count);
+            if (gpuBuffer->count) {
+                if (device->stateCache()->glDrawIndirectBuffer != gpuBuffer->glBuffer) {
+                    GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gpuBuffer->glBuffer));
+                    device->stateCache()->glDrawIndirectBuffer = gpuBuffer->glBuffer;
+                }
+
+                GL_CHECK(glBufferData(GL_DRAW_INDIRECT_BUFFER, gpuBuffer->count * sizeof(GLES3DrawElementsIndirectCommand), nullptr, glUsage));
+            }
+        }
     } else if ((hasFlag(gpuBuffer->usage, BufferUsageBit::TRANSFER_DST)) ||
                (hasFlag(gpuBuffer->usage, BufferUsageBit::TRANSFER_SRC))) {
         if (gpuBuffer->buffer) {
@@ -2300,7 +2331,34 @@ void cmdFuncGLES3Draw(GLES3Device *device, const DrawInfo &drawInfo) {
                     GL_CHECK(glDrawArraysInstanced(glPrimitive, drawInfo.firstIndex, drawInfo.vertexCount, drawInfo.instanceCount));
                 }
             }
+        } else if (gpuInputAssembler->gpuIndirectBuffer->glBuffer) {
+            GLES3GPUBuffer *gpuIndirectBuffer = gpuInputAssembler->gpuIndirectBuffer;
+            GLsizei         drawCount         = gpuIndirectBuffer->drawCount;
+            if (device->stateCache()->glDrawIndirectBuffer != gpuIndirectBuffer->glBuffer) {
+                GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gpuIndirectBuffer->glBuffer));
+                device->stateCache()->glDrawIndirectBuffer = gpuIndirectBuffer->glBuffer;
+            }
+            if (gpuInputAssembler->gpuIndexBuffer && gpuIndirectBuffer->isDrawIndirectByIndex) {
+                if (device->useMultiDrawIndirect()) {
+                    GL_CHECK(glMultiDrawElementsIndirectEXT(glPrimitive, gpuInputAssembler->glIndexType, nullptr, drawCount, 0));
+                } else {
+                    uint8_t *offset = nullptr;
+                    for (GLsizei j = 0; j < drawCount; ++j, offset += sizeof(GLES3DrawElementsIndirectCommand)) {
+                        GL_CHECK(glDrawElementsIndirect(glPrimitive, gpuInputAssembler->glIndexType, offset));
+                    }
+                }
+            } else if (!gpuIndirectBuffer->isDrawIndirectByIndex) {
+                if (device->useMultiDrawIndirect()) {
+                    GL_CHECK(glMultiDrawArraysIndirectEXT(glPrimitive, nullptr, drawCount, 0));
+                } else {
+                    uint8_t *offset = nullptr;
+                    for (GLsizei j = 0; j < drawCount; ++j, offset += sizeof(GLES3DrawArraysIndirectCommand)) {
+                        GL_CHECK(glDrawArraysIndirect(glPrimitive, offset));
+                    }
+                }
+            }
         } else {
+            // CPU emulation
             for (size_t j = 0; j < gpuInputAssembler->gpuIndirectBuffer->indirects.size(); ++j) {
                 const DrawInfo &draw = gpuInputAssembler->gpuIndirectBuffer->indirects[j];
                 if (gpuInputAssembler->gpuIndexBuffer) {
@@ -2343,10 +2401,51 @@ void cmdFuncGLES3MemoryBarrier(GLES3Device * /*device*/, GLbitfield barriers, GL
     if (barriersByRegion) glMemoryBarrierByRegion(barriersByRegion);
 }
 
+void cmdFuncGLES3QueryTimestamp(GLES3Device * /*device*/, GLuint glQuery) {
+    GL_CHECK(glQueryCounterEXT(glQuery, GL_TIMESTAMP_EXT));
+}
+
 void cmdFuncGLES3UpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, const void *buffer, uint offset, uint size) {
     GLES3ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
     if (hasFlag(gpuBuffer->usage, BufferUsageBit::INDIRECT)) {
         memcpy(reinterpret_cast<uint8_t *>(gpuBuffer->indirects.data()) + offset, buffer, size);
+
+        gpuBuffer->drawCount = (offset + size) / sizeof(DrawInfo);
+        if (gpuBuffer->glBuffer && gpuBuffer->drawCount) {
+            const void *dataToUpload  = nullptr;
+            size_t      sizeToUpload  = 0U;
+            size_t      drawInfoCount = gpuBuffer->drawCount;
+            if (gpuBuffer->indirects[0].indexCount) {
+                for (size_t i = 0; i < drawInfoCount; ++i) {
+                    const DrawInfo &drawInfo = gpuBuffer->indirects[i];
+
+                    gpuBuffer->indexedIndirectCmds[i].count         = drawInfo.indexCount;
+                    gpuBuffer->indexedIndirectCmds[i].instanceCount = std::max(drawInfo.instanceCount, 1U);
+                    gpuBuffer->indexedIndirectCmds[i].firstIndex    = drawInfo.firstIndex;
+                    gpuBuffer->indexedIndirectCmds[i].baseVertex    = drawInfo.vertexOffset;
+                }
+                dataToUpload                     = gpuBuffer->indexedIndirectCmds.data();
+                sizeToUpload                     = drawInfoCount * sizeof(GLES3DrawElementsIndirectCommand);
+                gpuBuffer->isDrawIndirectByIndex = true;
+            } else {
+                for (size_t i = 0; i < drawInfoCount; ++i) {
+                    const DrawInfo &drawInfo = gpuBuffer->indirects[i];
+
+                    gpuBuffer->indirectCmds[i].count         = drawInfo.vertexCount;
+                    gpuBuffer->indirectCmds[i].instanceCount = std::max(drawInfo.instanceCount, 1U);
+                    gpuBuffer->indirectCmds[i].first         = drawInfo.firstIndex;
+                }
+                dataToUpload                     = gpuBuffer->indirectCmds.data();
+                sizeToUpload                     = drawInfoCount * sizeof(GLES3DrawArraysIndirectCommand);
+                gpuBuffer->isDrawIndirectByIndex = false;
+            }
+
+            if (device->stateCache()->glDrawIndirectBuffer != gpuBuffer->glBuffer) {
+                GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gpuBuffer->glBuffer));
+                device->stateCache()->glDrawIndirectBuffer = gpuBuffer->glBuffer;
+            }
+            GL_CHECK(glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeToUpload, dataToUpload));
+        }
     } else if (hasFlag(gpuBuffer->usage, BufferUsageBit::TRANSFER_SRC)) {
         memcpy(gpuBuffer->buffer + offset, buffer, size);
     } else {
@@ -2661,6 +2760,11 @@ void cmdFuncGLES3ExecuteCmds(GLES3Device *device, GLES3CmdPackage *cmdPackage) {
                 cmdFuncGLES3BlitTexture(device, cmd->gpuTextureSrc, cmd->gpuTextureDst, cmd->regions, cmd->count, cmd->filter);
                 break;
             }
+            case GLESCmdType::QUERY_TIMESTAMP: {
+                GLES3CmdQueryTimestamp *cmd = cmdPackage->queryTimestampCmds[cmdIdx];
+                cmdFuncGLES3QueryTimestamp(device, cmd->glQuery);
+                break;
+            }
             default:
                 break;
         }
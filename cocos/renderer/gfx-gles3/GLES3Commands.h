@@ -158,6 +158,16 @@ public:
     }
 };
 
+class GLES3CmdQueryTimestamp final : public GLESCmd {
+public:
+    GLuint glQuery = 0U;
+
+    GLES3CmdQueryTimestamp() : GLESCmd(GLESCmdType::QUERY_TIMESTAMP) {}
+    void clear() override {
+        glQuery = 0U;
+    }
+};
+
 class GLES3CmdUpdateBuffer final : public GLESCmd {
 public:
     GLES3GPUBuffer *gpuBuffer = nullptr;
@@ -219,6 +229,7 @@ public:
     CachedArray<GLES3CmdUpdateBuffer *>        updateBufferCmds;
     CachedArray<GLES3CmdCopyBufferToTexture *> copyBufferToTextureCmds;
     CachedArray<GLES3CmdBlitTexture *>         blitTextureCmds;
+    CachedArray<GLES3CmdQueryTimestamp *>      queryTimestampCmds;
 };
 
 class GLES3GPUCommandAllocator final : public Object {
@@ -231,6 +242,7 @@ public:
     CommandPool<GLES3CmdUpdateBuffer>        updateBufferCmdPool;
     CommandPool<GLES3CmdCopyBufferToTexture> copyBufferToTextureCmdPool;
     CommandPool<GLES3CmdBlitTexture>         blitTextureCmdPool;
+    CommandPool<GLES3CmdQueryTimestamp>      queryTimestampCmdPool;
 
     void clearCmds(GLES3CmdPackage *cmdPackage) {
         if (cmdPackage->beginRenderPassCmds.size()) {
@@ -257,6 +269,9 @@ public:
         if (cmdPackage->blitTextureCmds.size()) {
             blitTextureCmdPool.freeCmds(cmdPackage->blitTextureCmds);
         }
+        if (cmdPackage->queryTimestampCmds.size()) {
+            queryTimestampCmdPool.freeCmds(cmdPackage->queryTimestampCmds);
+        }
 
         cmdPackage->cmds.clear();
     }
@@ -270,6 +285,7 @@ public:
         updateBufferCmdPool.release();
         copyBufferToTextureCmdPool.release();
         blitTextureCmdPool.release();
+        queryTimestampCmdPool.release();
     }
 };
 
@@ -303,6 +319,7 @@ CC_GLES3_API void cmdFuncGLES3BlitTexture(GLES3Device *device, GLES3GPUTexture *
 CC_GLES3_API void cmdFuncGLES3ExecuteCmds(GLES3Device *device, GLES3CmdPackage *cmdPackage);
 CC_GLES3_API void cmdFuncGLES3Dispatch(GLES3Device *device, const GLES3GPUDispatchInfo &info);
 CC_GLES3_API void cmdFuncGLES3MemoryBarrier(GLES3Device *device, GLbitfield barriers, GLbitfield barriersByRegion);
+CC_GLES3_API void cmdFuncGLES3QueryTimestamp(GLES3Device *device, GLuint glQuery);
 
 } // namespace gfx
 } // namespace cc
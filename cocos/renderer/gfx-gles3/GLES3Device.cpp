@@ -87,6 +87,7 @@ bool GLES3Device::doInit(const DeviceInfo & info) {
     _gpuStateCache          = CC_NEW(GLES3GPUStateCache);
     _gpuStagingBufferPool   = CC_NEW(GLES3GPUStagingBufferPool);
     _gpuFramebufferCacheMap = CC_NEW(GLES3GPUFramebufferCacheMap(_gpuStateCache));
+    _gpuUploadFences        = CC_NEW(GLES3GPUUploadFences);
 
     bindRenderContext(true);
 
@@ -106,6 +107,17 @@ bool GLES3Device::doInit(const DeviceInfo & info) {
     uint minorVersion = static_cast<GLES3Context *>(_context)->minorVer();
     if (minorVersion) {
         _features[static_cast<uint>(Feature::COMPUTE_SHADER)] = true;
+        _useDrawIndirect                                      = true;
+    }
+
+    if (_useDrawIndirect && checkExtension("multi_draw_indirect")) {
+        _features[static_cast<uint>(Feature::MULTI_DRAW_INDIRECT)] = true;
+        _useMultiDrawIndirect                                      = true;
+    }
+
+    if (checkExtension("disjoint_timer_query")) {
+        _features[static_cast<uint>(Feature::TIMESTAMP_QUERY)] = true;
+        _gpuTimestampPool                                      = CC_NEW(GLES3GPUTimestampPool);
     }
 
     if (checkExtension("color_buffer_float")) {
@@ -200,6 +212,8 @@ bool GLES3Device::doInit(const DeviceInfo & info) {
 }
 
 void GLES3Device::doDestroy() {
+    CC_SAFE_DELETE(_gpuTimestampPool)
+    CC_SAFE_DELETE(_gpuUploadFences)
     CC_SAFE_DELETE(_gpuFramebufferCacheMap)
     CC_SAFE_DELETE(_gpuStagingBufferPool)
     CC_SAFE_DELETE(_gpuStateCache)
@@ -225,6 +239,8 @@ void GLES3Device::resize(uint width, uint height) {
 
 void GLES3Device::acquire() {
     _gpuStagingBufferPool->reset();
+    _gpuUploadFences->update();
+    flushDeferredUploads();
 }
 
 void GLES3Device::present() {
@@ -235,6 +251,8 @@ void GLES3Device::present() {
 
     _context->present();
 
+    if (_gpuTimestampPool) _gpuTimestampPool->resolve(_timingScopes);
+
     // Clear queue stats
     queue->_numDrawCalls = 0;
     queue->_numInstances = 0;
@@ -272,6 +290,8 @@ void GLES3Device::bindDeviceContext(bool bound) {
 uint GLES3Device::getMinorVersion() const { return static_cast<GLES3Context *>(_context)->minorVer(); }
 
 CommandBuffer *GLES3Device::createCommandBuffer(const CommandBufferInfo &info, bool hasAgent) {
+    // bundles have to keep their command packages even with agents
+    if (info.type == CommandBufferType::BUNDLE) return CC_NEW(GLES3CommandBuffer);
     if (hasAgent || info.type == CommandBufferType::PRIMARY) return CC_NEW(GLES3PrimaryCommandBuffer);
     return CC_NEW(GLES3CommandBuffer);
 }
@@ -336,5 +356,20 @@ void GLES3Device::copyBuffersToTexture(const uint8_t *const *buffers, Texture *d
     cmdFuncGLES3CopyBuffersToTexture(this, buffers, static_cast<GLES3Texture *>(dst)->gpuTexture(), regions, count);
 }
 
+// no dedicated transfer queue here, the driver does the pipelining
+void GLES3Device::copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) {
+    if (deferUpload(buffers, dst, regions, count, callback)) return;
+
+    cmdFuncGLES3CopyBuffersToTexture(this, buffers, static_cast<GLES3Texture *>(dst)->gpuTexture(), regions, count);
+    _gpuUploadFences->checkIn(callback);
+}
+
+void GLES3Device::updateBufferAsync(Buffer *buff, const void *data, uint size, const UploadCallback &callback) {
+    if (deferUpload(buff, data, size, callback)) return;
+
+    buff->update(data, size);
+    _gpuUploadFences->checkIn(callback);
+}
+
 } // namespace gfx
 } // namespace cc
@@ -34,6 +34,8 @@ namespace gfx {
 class GLES3Context;
 class GLES3GPUStateCache;
 class GLES3GPUStagingBufferPool;
+class GLES3GPUUploadFences;
+class GLES3GPUTimestampPool;
 class GLES3GPUFramebufferCacheMap;
 
 class CC_GLES3_API GLES3Device final : public Device {
@@ -66,6 +68,7 @@ public:
     inline GLES3GPUStateCache *         stateCache() const { return _gpuStateCache; }
     inline GLES3GPUStagingBufferPool *  stagingBufferPool() const { return _gpuStagingBufferPool; }
     inline GLES3GPUFramebufferCacheMap *framebufferCacheMap() const { return _gpuFramebufferCacheMap; }
+    inline GLES3GPUTimestampPool *      timestampPool() const { return _gpuTimestampPool; }
     inline uint                         getThreadID() const { return _threadID; }
 
     inline bool checkExtension(const String &extension) const {
@@ -76,6 +79,9 @@ public:
 
     uint getMinorVersion() const;
 
+    inline bool useDrawIndirect() const { return _useDrawIndirect; }
+    inline bool useMultiDrawIndirect() const { return _useMultiDrawIndirect; }
+
 protected:
     static GLES3Device *instance;
 
@@ -102,6 +108,8 @@ protected:
     GlobalBarrier *      createGlobalBarrier() override;
     TextureBarrier *     createTextureBarrier() override;
     void                 copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) override;
+    void                 copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) override;
+    void                 updateBufferAsync(Buffer *buff, const void *data, uint size, const UploadCallback &callback) override;
 
     void releaseSurface(uintptr_t windowHandle) override;
     void acquireSurface(uintptr_t windowHandle) override;
@@ -114,10 +122,15 @@ protected:
     GLES3GPUStateCache *         _gpuStateCache          = nullptr;
     GLES3GPUStagingBufferPool *  _gpuStagingBufferPool   = nullptr;
     GLES3GPUFramebufferCacheMap *_gpuFramebufferCacheMap = nullptr;
+    GLES3GPUUploadFences *       _gpuUploadFences        = nullptr;
+    GLES3GPUTimestampPool *      _gpuTimestampPool       = nullptr;
 
     StringArray _extensions;
 
     uint _threadID = 0U;
+
+    bool _useDrawIndirect      = false;
+    bool _useMultiDrawIndirect = false;
 };
 
 } // namespace gfx
@@ -35,6 +35,21 @@
 namespace cc {
 namespace gfx {
 
+struct GLES3DrawArraysIndirectCommand {
+    GLuint count              = 0U;
+    GLuint instanceCount      = 0U;
+    GLuint first              = 0U;
+    GLuint reservedMustBeZero = 0U;
+};
+
+struct GLES3DrawElementsIndirectCommand {
+    GLuint count              = 0U;
+    GLuint instanceCount      = 0U;
+    GLuint firstIndex         = 0U;
+    GLint  baseVertex         = 0;
+    GLuint reservedMustBeZero = 0U;
+};
+
 class GLES3GPUBuffer final : public Object {
 public:
     BufferUsage  usage    = BufferUsage::NONE;
@@ -47,6 +62,12 @@ public:
     GLuint       glOffset = 0;
     uint8_t *    buffer   = nullptr;
     DrawInfoList indirects;
+
+    // server-side copy of the indirect draws, ES 3.1 only
+    bool                                     isDrawIndirectByIndex = false;
+    uint                                     drawCount             = 0U;
+    vector<GLES3DrawArraysIndirectCommand>   indirectCmds;
+    vector<GLES3DrawElementsIndirectCommand> indexedIndirectCmds;
 };
 using GLES3GPUBufferList = vector<GLES3GPUBuffer *>;
 
@@ -312,6 +333,7 @@ public:
     vector<GLuint>              glBindSSBOs;
     vector<GLuint>              glBindSSBOOffsets;
     GLuint                      glDispatchIndirectBuffer = 0;
+    GLuint                      glDrawIndirectBuffer     = 0;
     GLuint                      glVAO                    = 0;
     uint                        texUint                  = 0;
     vector<GLuint>              glTextures;
@@ -484,5 +506,140 @@ private:
     vector<Buffer> _pool;
 };
 
+/**
+ * Tracks asynchronous uploads with fence syncs, callbacks are fired once the GPU has consumed the data.
+ */
+class GLES3GPUUploadFences final : public Object {
+public:
+    ~GLES3GPUUploadFences() override {
+        for (Fence &fence : _fences) {
+            glDeleteSync(fence.glSync);
+        }
+        _fences.clear();
+    }
+
+    void checkIn(const UploadCallback &callback) {
+        if (!callback) return;
+        // uploads issued within the same frame share one fence
+        if (_fences.empty() || _fences.back().frame != _frame) {
+            _fences.push_back({glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), _frame, {}});
+        }
+        _fences.back().callbacks.push_back(callback);
+    }
+
+    void update() {
+        ++_frame;
+        while (!_fences.empty()) {
+            Fence &fence  = _fences.front();
+            GLenum status = glClientWaitSync(fence.glSync, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+
+            glDeleteSync(fence.glSync);
+            vector<UploadCallback> callbacks = std::move(fence.callbacks);
+            _fences.pop_front();
+            for (UploadCallback &callback : callbacks) {
+                callback();
+            }
+        }
+    }
+
+private:
+    struct Fence {
+        GLsync                 glSync = nullptr;
+        uint                   frame  = 0U;
+        vector<UploadCallback> callbacks;
+    };
+    std::deque<Fence> _fences;
+    uint              _frame = 0U;
+};
+
+/**
+ * Timer queries for timing scopes through GL_EXT_disjoint_timer_query.
+ * Queries are ring-buffered across frames and polled without stalling the pipeline.
+ */
+class GLES3GPUTimestampPool final : public Object {
+public:
+    GLES3GPUTimestampPool() {
+        for (Frame &frame : _frames) {
+            frame.glQueries.resize(MAX_TIMING_SCOPES * 2);
+            GL_CHECK(glGenQueries(MAX_TIMING_SCOPES * 2, frame.glQueries.data()));
+        }
+    }
+
+    ~GLES3GPUTimestampPool() override {
+        for (Frame &frame : _frames) {
+            GL_CHECK(glDeleteQueries(MAX_TIMING_SCOPES * 2, frame.glQueries.data()));
+        }
+    }
+
+    // returns the query to be issued, or zero if the scope is dropped
+    GLuint begin(const String &name) {
+        Frame &frame = _frames[_frameIndex];
+        if (frame.scopes.size() >= MAX_TIMING_SCOPES) {
+            frame.openScopes.push_back(UINT_MAX);
+            return 0U;
+        }
+
+        uint index = static_cast<uint>(frame.scopes.size());
+        frame.scopes.push_back({name, static_cast<uint>(frame.openScopes.size()), 0.F});
+        frame.openScopes.push_back(index);
+        return frame.glQueries[index * 2];
+    }
+
+    GLuint end() {
+        Frame &frame = _frames[_frameIndex];
+        if (frame.openScopes.empty()) return 0U;
+
+        uint index = frame.openScopes.back();
+        frame.openScopes.pop_back();
+        return index == UINT_MAX ? 0U : frame.glQueries[index * 2 + 1];
+    }
+
+    // advances to the oldest frame in the ring, results not available by now are dropped
+    void resolve(TimingScopeList &scopes) {
+        _frameIndex  = (_frameIndex + 1) % FRAME_COUNT;
+        Frame &frame = _frames[_frameIndex];
+        if (frame.scopes.empty()) return;
+
+        // the counters are meaningless if a disjoint operation happened in between
+        GLint disjoint = 0;
+        GL_CHECK(glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint));
+
+        bool   valid     = !disjoint && frame.openScopes.empty();
+        uint   count     = static_cast<uint>(frame.scopes.size()) * 2;
+        GLuint available = 0U;
+        for (uint i = 0U; valid && i < count; ++i) {
+            GL_CHECK(glGetQueryObjectuiv(frame.glQueries[i], GL_QUERY_RESULT_AVAILABLE, &available));
+            valid = available;
+        }
+
+        if (valid) {
+            GLuint64 begin = 0U;
+            GLuint64 end   = 0U;
+            for (uint i = 0U; i < frame.scopes.size(); ++i) {
+                GL_CHECK(glGetQueryObjectui64vEXT(frame.glQueries[i * 2], GL_QUERY_RESULT_EXT, &begin));
+                GL_CHECK(glGetQueryObjectui64vEXT(frame.glQueries[i * 2 + 1], GL_QUERY_RESULT_EXT, &end));
+                if (end > begin) frame.scopes[i].gpuTime = static_cast<float>(end - begin) * 1e-6F;
+            }
+            scopes.swap(frame.scopes);
+        }
+
+        frame.scopes.clear();
+        frame.openScopes.clear();
+    }
+
+private:
+    static constexpr uint FRAME_COUNT = 3U;
+
+    struct Frame {
+        vector<GLuint>  glQueries;
+        TimingScopeList scopes;
+        vector<uint>    openScopes;
+    };
+
+    Frame _frames[FRAME_COUNT];
+    uint  _frameIndex = 0U;
+};
+
 } // namespace gfx
 } // namespace cc
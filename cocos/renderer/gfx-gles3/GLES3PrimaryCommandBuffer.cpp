@@ -126,9 +126,16 @@ void GLES3PrimaryCommandBuffer::blitTexture(Texture *srcTexture, Texture *dstTex
 
 void GLES3PrimaryCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
     for (uint i = 0; i < count; ++i) {
-        auto *cmdBuff = static_cast<GLES3PrimaryCommandBuffer *>(cmdBuffs[i]);
-
-        if (!cmdBuff->_pendingPackages.empty()) {
+        auto *cmdBuff = static_cast<GLES3CommandBuffer *>(cmdBuffs[i]);
+
+        if (cmdBuff->getType() == CommandBufferType::BUNDLE) {
+            // bundles are replayed as-is and stay valid until re-recorded
+            if (!cmdBuff->_pendingPackages.empty()) {
+                cmdFuncGLES3ExecuteCmds(GLES3Device::getInstance(), cmdBuff->_pendingPackages.front());
+                // states tracked here are overridden by the bundle
+                _isStateInvalid = _curGPUPipelineState != nullptr;
+            }
+        } else if (!cmdBuff->_pendingPackages.empty()) {
             GLES3CmdPackage *cmdPackage = cmdBuff->_pendingPackages.front();
 
             cmdFuncGLES3ExecuteCmds(GLES3Device::getInstance(), cmdPackage);
@@ -184,5 +191,9 @@ void GLES3PrimaryCommandBuffer::pipelineBarrier(const GlobalBarrier *barrier, co
     cmdFuncGLES3MemoryBarrier(GLES3Device::getInstance(), gpuBarrier->glBarriers, gpuBarrier->glBarriersByRegion);
 }
 
+void GLES3PrimaryCommandBuffer::recordTimestamp(GLuint glQuery) {
+    if (glQuery) cmdFuncGLES3QueryTimestamp(GLES3Device::getInstance(), glQuery);
+}
+
 } // namespace gfx
 } // namespace cc
@@ -51,6 +51,7 @@ protected:
     friend class GLES3Queue;
 
     void bindStates() override;
+    void recordTimestamp(GLuint glQuery) override;
 };
 
 } // namespace gfx
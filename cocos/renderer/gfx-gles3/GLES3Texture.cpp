@@ -61,6 +61,7 @@ void GLES3Texture::doInit(const TextureViewInfo & /*info*/) {
 }
 
 void GLES3Texture::doDestroy() {
+    GLES3Device::getInstance()->cancelUploads(this);
     if (_gpuTexture) {
         cmdFuncGLES3DestroyTexture(GLES3Device::getInstance(), _gpuTexture);
         CC_DELETE(_gpuTexture);
@@ -35,6 +35,7 @@
 #include "MTLRenderPass.h"
 #include "MTLSampler.h"
 #include "MTLTexture.h"
+#include "gfx-base/GFXCommandBundle.h"
 #include <QuartzCore/CAMetalLayer.h>
 
 namespace cc {
@@ -466,6 +467,10 @@ void CCMTLCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Tex
 
 void CCMTLCommandBuffer::execute(CommandBuffer *const *commandBuffs, uint32_t count) {
     for (uint i = 0; i < count; ++i) {
+        if (commandBuffs[i]->getType() == CommandBufferType::BUNDLE) {
+            static_cast<const CommandBundle *>(commandBuffs[i])->replay(this);
+            continue;
+        }
         const auto *commandBuffer = static_cast<const CCMTLCommandBuffer *>(commandBuffs[i]);
         _numDrawCalls += commandBuffer->_numDrawCalls;
         _numInstances += commandBuffer->_numInstances;
@@ -44,6 +44,7 @@
 #include "MTLTexture.h"
 #include "cocos/bindings/event/CustomEventTypes.h"
 #include "cocos/bindings/event/EventDispatcher.h"
+#include "gfx-base/GFXCommandBundle.h"
 
 namespace cc {
 namespace gfx {
@@ -304,6 +305,7 @@ Queue *CCMTLDevice::createQueue() {
 }
 
 CommandBuffer *CCMTLDevice::createCommandBuffer(const CommandBufferInfo &info, bool /*hasAgent*/) {
+    if (info.type == CommandBufferType::BUNDLE) return CC_NEW(CommandBundle);
     return CC_NEW(CCMTLCommandBuffer);
 }
 
@@ -64,6 +64,7 @@ void CommandBufferValidator::doDestroy() {
 void CommandBufferValidator::begin(RenderPass *renderPass, uint subpass, Framebuffer *framebuffer) {
     CCASSERT(!_insideRenderPass, "Already inside an render pass?");
     CCASSERT(_type != CommandBufferType::PRIMARY || !renderPass, "Primary command buffer cannot inherit render passes");
+    CCASSERT(_type != CommandBufferType::BUNDLE || renderPass, "Command bundles must inherit render passes");
 
     // secondary command buffers enter the render pass right here
     _insideRenderPass = !!renderPass;
@@ -79,7 +80,9 @@ void CommandBufferValidator::begin(RenderPass *renderPass, uint subpass, Framebu
 
 void CommandBufferValidator::end() {
     CCASSERT(_type != CommandBufferType::PRIMARY || !_insideRenderPass, "Still inside an render pass?");
+    CCASSERT(!_timingScopeDepth, "Unbalanced timing scopes?");
     _insideRenderPass = false;
+    _timingScopeDepth = 0U;
 
     /////////// execute ///////////
 
@@ -133,6 +136,7 @@ void CommandBufferValidator::execute(CommandBuffer *const *cmdBuffs, uint32_t co
     cmdBuffActors.resize(count);
 
     for (uint i = 0U; i < count; ++i) {
+        CCASSERT(cmdBuffs[i]->getType() != CommandBufferType::BUNDLE || _insideRenderPass, "Command bundles must be executed inside render passes.");
         cmdBuffActors[i] = static_cast<CommandBufferValidator *>(cmdBuffs[i])->getActor();
     }
 
@@ -244,6 +248,7 @@ void CommandBufferValidator::dispatch(const DispatchInfo &info) {
 }
 
 void CommandBufferValidator::pipelineBarrier(const GlobalBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint textureBarrierCount) {
+    CCASSERT(_type != CommandBufferType::BUNDLE, "Command 'pipelineBarrier' cannot be recorded in command bundles.");
 
     /////////// execute ///////////
 
@@ -261,5 +266,24 @@ void CommandBufferValidator::pipelineBarrier(const GlobalBarrier *barrier, const
     _actor->pipelineBarrier(barrier, textureBarriers, actorTextures, textureBarrierCount);
 }
 
+void CommandBufferValidator::beginTimingScope(const String &name) {
+    CCASSERT(_type != CommandBufferType::BUNDLE, "Command 'beginTimingScope' cannot be recorded in command bundles.");
+    CCASSERT(!name.empty(), "Timing scopes should be named.");
+    ++_timingScopeDepth;
+
+    /////////// execute ///////////
+
+    _actor->beginTimingScope(name);
+}
+
+void CommandBufferValidator::endTimingScope() {
+    CCASSERT(_timingScopeDepth, "No timing scope to end.");
+    --_timingScopeDepth;
+
+    /////////// execute ///////////
+
+    _actor->endTimingScope();
+}
+
 } // namespace gfx
 } // namespace cc
@@ -59,6 +59,8 @@ public:
     void execute(CommandBuffer *const *cmdBuffs, uint32_t count) override;
     void dispatch(const DispatchInfo &info) override;
     void pipelineBarrier(const GlobalBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint textureBarrierCount) override;
+    void beginTimingScope(const String &name) override;
+    void endTimingScope() override;
 
     uint getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
     uint getNumInstances() const override { return _actor->getNumInstances(); }
@@ -73,6 +75,7 @@ protected:
 
     bool _insideRenderPass{false};
     bool _commandsFlushed{false};
+    uint _timingScopeDepth{0U};
 };
 
 } // namespace gfx
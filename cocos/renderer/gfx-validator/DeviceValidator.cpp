@@ -122,6 +122,7 @@ void DeviceValidator::acquire() {
 
 void DeviceValidator::present() {
     _actor->present();
+    _timingScopes = _actor->getTimingScopes();
     ++_currentFrame;
 }
 
@@ -237,6 +238,25 @@ void DeviceValidator::copyBuffersToTexture(const uint8_t *const *buffers, Textur
     _actor->copyBuffersToTexture(buffers, textureValidator->getActor(), regions, count);
 }
 
+// may be called from worker threads, so no frame-based redundency checks here
+void DeviceValidator::copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) {
+    CCASSERT(buffers && regions && count, "invalid upload regions");
+
+    _actor->copyBuffersToTextureAsync(buffers, static_cast<TextureValidator *>(dst)->getActor(), regions, count, callback);
+}
+
+void DeviceValidator::updateBufferAsync(Buffer *buff, const void *data, uint size, const UploadCallback &callback) {
+    CCASSERT(size && size <= buff->getSize(), "invalid size");
+    CCASSERT(data, "invalid buffer data");
+
+    _actor->updateBufferAsync(static_cast<BufferValidator *>(buff)->getActor(), data, size, callback);
+}
+
+void DeviceValidator::setUploadBudget(uint bytesPerFrame) {
+    _uploadBudget = bytesPerFrame;
+    _actor->setUploadBudget(bytesPerFrame);
+}
+
 void DeviceValidator::flushCommands(CommandBuffer *const *cmdBuffs, uint count) {
     if (!count) return;
 
@@ -74,6 +74,9 @@ public:
     GlobalBarrier *      createGlobalBarrier() override;
     TextureBarrier *     createTextureBarrier() override;
     void                 copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) override;
+    void                 copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) override;
+    void                 updateBufferAsync(Buffer *buff, const void *data, uint size, const UploadCallback &callback) override;
+    void                 setUploadBudget(uint bytesPerFrame) override;
 
     void             flushCommands(CommandBuffer *const *cmdBuffs, uint count) override;
     void             setMultithreaded(bool multithreaded) override;
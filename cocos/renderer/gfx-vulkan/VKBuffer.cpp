@@ -74,6 +74,7 @@ void CCVKBuffer::createBufferView() {
 }
 
 void CCVKBuffer::doDestroy() {
+    CCVKDevice::getInstance()->cancelUploads(this);
     if (_gpuBufferView) {
         CCVKDevice::getInstance()->gpuDescriptorHub()->disengage(_gpuBufferView);
         CC_DELETE(_gpuBufferView);
@@ -39,6 +39,7 @@
 #include "VKRenderPass.h"
 #include "VKTexture.h"
 #include "VKTextureBarrier.h"
+#include "gfx-base/GFXCommandBundle.h"
 
 namespace cc {
 namespace gfx {
@@ -343,7 +344,7 @@ void CCVKCommandBuffer::draw(const DrawInfo &info) {
     CCVKGPUBuffer *gpuIndirectBuffer = _curGPUInputAssember->gpuIndirectBuffer;
 
     if (gpuIndirectBuffer) {
-        uint           drawInfoCount = gpuIndirectBuffer->count;
+        uint           drawInfoCount = gpuIndirectBuffer->drawCount;
         CCVKGPUDevice *gpuDevice     = CCVKDevice::getInstance()->gpuDevice();
         VkDeviceSize   offset        = gpuIndirectBuffer->startOffset + gpuDevice->curBackBufferIndex * gpuIndirectBuffer->instanceSize;
         if (gpuDevice->useMultiDrawIndirect) {
@@ -379,6 +380,7 @@ void CCVKCommandBuffer::draw(const DrawInfo &info) {
                 }
             }
         }
+        _numDrawCalls += drawInfoCount;
     } else {
         uint instanceCount  = std::max(info.instanceCount, 1U);
         bool hasIndexBuffer = _curGPUInputAssember->gpuIndexBuffer && info.indexCount > 0;
@@ -415,6 +417,10 @@ void CCVKCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint count) {
 
     uint validCount = 0U;
     for (uint i = 0U; i < count; ++i) {
+        if (cmdBuffs[i]->getType() == CommandBufferType::BUNDLE) {
+            static_cast<CommandBundle *>(cmdBuffs[i])->replay(this);
+            continue;
+        }
         auto *cmdBuff = static_cast<CCVKCommandBuffer *>(cmdBuffs[i]);
         if (!cmdBuff->_pendingQueue.empty()) {
             _vkCommandBuffers[validCount++] = cmdBuff->_pendingQueue.front();
@@ -591,5 +597,15 @@ void CCVKCommandBuffer::pipelineBarrier(const GlobalBarrier *barrier, const Text
                          0, nullptr, textureBarrierCount, pImageMemoryBarriers);
 }
 
+void CCVKCommandBuffer::beginTimingScope(const String &name) {
+    CCVKGPUTimestampHub *timestampHub = CCVKDevice::getInstance()->gpuTimestampHub();
+    if (timestampHub) timestampHub->begin(_gpuCommandBuffer->vkCommandBuffer, name);
+}
+
+void CCVKCommandBuffer::endTimingScope() {
+    CCVKGPUTimestampHub *timestampHub = CCVKDevice::getInstance()->gpuTimestampHub();
+    if (timestampHub) timestampHub->end(_gpuCommandBuffer->vkCommandBuffer);
+}
+
 } // namespace gfx
 } // namespace cc
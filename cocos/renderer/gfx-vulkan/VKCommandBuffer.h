@@ -60,6 +60,8 @@ public:
     void execute(CommandBuffer *const *cmdBuffs, uint count) override;
     void dispatch(const DispatchInfo &info) override;
     void pipelineBarrier(const GlobalBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint textureBarrierCount) override;
+    void beginTimingScope(const String &name) override;
+    void endTimingScope() override;
 
     CCVKGPUCommandBuffer *gpuCommandBuffer() const { return _gpuCommandBuffer; }
 
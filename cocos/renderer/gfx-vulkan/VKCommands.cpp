@@ -91,6 +91,19 @@ void cmdFuncCCVKGetDeviceQueue(CCVKDevice *device, CCVKGPUQueue *gpuQueue) {
     const CCVKGPUContext *context = device->gpuContext();
 
     size_t queueCount = context->queueFamilyProperties.size();
+    if (gpuQueue->type == QueueType::TRANSFER) {
+        // prefer the dedicated DMA queues
+        for (size_t i = 0U; i < queueCount; ++i) {
+            const VkQueueFamilyProperties &properties = context->queueFamilyProperties[i];
+            if (properties.queueCount > 0 && (properties.queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+                !(properties.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+                vkGetDeviceQueue(device->gpuDevice()->vkDevice, i, 0, &gpuQueue->vkQueue);
+                gpuQueue->queueFamilyIndex = i;
+                return;
+            }
+        }
+    }
+
     for (size_t i = 0U; i < queueCount; ++i) {
         const VkQueueFamilyProperties &properties    = context->queueFamilyProperties[i];
         const VkBool32                 isPresentable = context->queueFamilyPresentables[i];
@@ -865,6 +878,7 @@ void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const
     if (hasFlag(gpuBuffer->usage, BufferUsageBit::INDIRECT)) {
         size_t      drawInfoCount = size / sizeof(DrawInfo);
         const auto *drawInfo      = static_cast<const DrawInfo *>(buffer);
+        gpuBuffer->drawCount      = drawInfoCount;
         if (drawInfoCount > 0) {
             if (drawInfo->indexCount) {
                 for (size_t i = 0; i < drawInfoCount; ++i) {
@@ -1217,6 +1231,247 @@ void CCVKGPURecycleBin::clear() {
     _count = 0;
 }
 
+CCVKGPUStreamingHub::CCVKGPUStreamingHub(CCVKGPUDevice *device, CCVKGPUQueue *transferQueue, CCVKGPUQueue *graphicsQueue)
+: _device(device),
+  _transferQueue(transferQueue),
+  _graphicsQueue(graphicsQueue) {
+    if (_transferQueue) {
+        VkCommandPoolCreateInfo createInfo{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        createInfo.queueFamilyIndex = _transferQueue->queueFamilyIndex;
+        createInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        VK_CHECK(vkCreateCommandPool(_device->vkDevice, &createInfo, nullptr, &_vkCommandPool));
+    }
+}
+
+CCVKGPUStreamingHub::~CCVKGPUStreamingHub() {
+    // the device is idle by now, pending callbacks are dropped
+    if (_recording) _inFlight.push_back(_recording);
+    for (Batch *batch : _inFlight) {
+        batch->callbacks.clear();
+        retire(batch);
+    }
+    for (Batch *batch : _freeBatches) {
+        if (batch->vkFence) vkDestroyFence(_device->vkDevice, batch->vkFence, nullptr);
+        if (batch->vkSemaphore) vkDestroySemaphore(_device->vkDevice, batch->vkSemaphore, nullptr);
+        CC_DELETE(batch);
+    }
+    _recording = nullptr;
+    _inFlight.clear();
+    _freeBatches.clear();
+
+    if (_vkCommandPool) {
+        vkDestroyCommandPool(_device->vkDevice, _vkCommandPool, nullptr);
+        _vkCommandPool = VK_NULL_HANDLE;
+    }
+}
+
+void CCVKGPUStreamingHub::begin() {
+    if (!_freeBatches.empty()) {
+        _recording = _freeBatches.back();
+        _freeBatches.pop_back();
+    } else {
+        _recording = CC_NEW(Batch);
+        if (_transferQueue) {
+            _recording->cmdBuff.queueFamilyIndex = _transferQueue->queueFamilyIndex;
+
+            VkCommandBufferAllocateInfo allocateInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+            allocateInfo.commandPool        = _vkCommandPool;
+            allocateInfo.commandBufferCount = 1;
+            allocateInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            VK_CHECK(vkAllocateCommandBuffers(_device->vkDevice, &allocateInfo, &_recording->cmdBuff.vkCommandBuffer));
+
+            VkFenceCreateInfo fenceInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+            VK_CHECK(vkCreateFence(_device->vkDevice, &fenceInfo, nullptr, &_recording->vkFence));
+            VkSemaphoreCreateInfo semaphoreInfo{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+            VK_CHECK(vkCreateSemaphore(_device->vkDevice, &semaphoreInfo, nullptr, &_recording->vkSemaphore));
+        }
+    }
+
+    if (_transferQueue) {
+        VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        VK_CHECK(vkBeginCommandBuffer(_recording->cmdBuff.vkCommandBuffer, &beginInfo));
+    }
+}
+
+void CCVKGPUStreamingHub::retire(Batch *batch) {
+    for (Staging &staging : batch->stagingBuffers) {
+        vmaDestroyBuffer(_device->memoryAllocator, staging.vkBuffer, staging.vmaAllocation);
+    }
+    for (UploadCallback &callback : batch->callbacks) {
+        callback();
+    }
+    if (batch->vkFence) {
+        VK_CHECK(vkResetFences(_device->vkDevice, 1, &batch->vkFence));
+        VK_CHECK(vkResetCommandBuffer(batch->cmdBuff.vkCommandBuffer, 0));
+    }
+    batch->stagingBuffers.clear();
+    batch->textures.clear();
+    batch->callbacks.clear();
+    _freeBatches.push_back(batch);
+}
+
+bool CCVKGPUStreamingHub::checkIn(CCVKGPUTexture *gpuTexture, const uint8_t *const *buffers, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) {
+    // mipmap generation needs the graphics queue
+    if (!_transferQueue || hasFlag(gpuTexture->flags, TextureFlagBit::GEN_MIPMAP)) return false;
+
+    bool recorded = _recording && std::find(_recording->textures.begin(), _recording->textures.end(), gpuTexture) != _recording->textures.end();
+    // only fresh textures can be streamed, otherwise the graphics queue already owns it
+    if (!recorded && !gpuTexture->currentAccessTypes.empty()) return false;
+
+    if (!_recording) begin();
+
+    uint         totalSize = 0U;
+    vector<uint> regionSizes(count);
+    for (size_t i = 0U; i < count; ++i) {
+        const BufferTextureCopy &region = regions[i];
+        uint                     w      = region.buffStride > 0 ? region.buffStride : region.texExtent.width;
+        uint                     h      = region.buffTexHeight > 0 ? region.buffTexHeight : region.texExtent.height;
+        totalSize += regionSizes[i]     = formatSize(gpuTexture->format, w, h, region.texExtent.depth);
+    }
+
+    Staging            staging;
+    VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bufferInfo.size  = totalSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+    VmaAllocationInfo res;
+    VK_CHECK(vmaCreateBuffer(_device->memoryAllocator, &bufferInfo, &allocInfo, &staging.vkBuffer, &staging.vmaAllocation, &res));
+    auto *mappedData = static_cast<uint8_t *>(res.pMappedData);
+
+    vector<VkBufferImageCopy> stagingRegions(count);
+    VkDeviceSize              offset = 0;
+    for (size_t i = 0U; i < count; ++i) {
+        const BufferTextureCopy &region        = regions[i];
+        VkBufferImageCopy &      stagingRegion = stagingRegions[i];
+        stagingRegion.bufferOffset             = offset;
+        stagingRegion.bufferRowLength          = region.buffStride;
+        stagingRegion.bufferImageHeight        = region.buffTexHeight;
+        stagingRegion.imageSubresource         = {gpuTexture->aspectMask, region.texSubres.mipLevel, region.texSubres.baseArrayLayer, region.texSubres.layerCount};
+        stagingRegion.imageOffset              = {region.texOffset.x, region.texOffset.y, region.texOffset.z};
+        stagingRegion.imageExtent              = {region.texExtent.width, region.texExtent.height, region.texExtent.depth};
+
+        memcpy(mappedData + offset, buffers[i], regionSizes[i]);
+        offset += regionSizes[i];
+    }
+
+    const CCVKGPUCommandBuffer *gpuCommandBuffer = &_recording->cmdBuff;
+    if (!recorded) {
+        ThsvsImageBarrier barrier{};
+        barrier.image                       = gpuTexture->vkImage;
+        barrier.discardContents             = true;
+        barrier.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+        barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+        barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+        barrier.subresourceRange.aspectMask = gpuTexture->aspectMask;
+        barrier.nextAccessCount             = 1;
+        barrier.pNextAccesses               = &THSVS_ACCESS_TYPES[static_cast<uint>(AccessType::TRANSFER_WRITE)];
+        cmdFuncCCVKImageMemoryBarrier(gpuCommandBuffer, barrier);
+        _recording->textures.push_back(gpuTexture);
+    } else {
+        // guard against WAW hazard
+        VkMemoryBarrier vkBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        vkBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(gpuCommandBuffer->vkCommandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 1, &vkBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    vkCmdCopyBufferToImage(gpuCommandBuffer->vkCommandBuffer, staging.vkBuffer, gpuTexture->vkImage,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, stagingRegions.size(), stagingRegions.data());
+
+    _recording->stagingBuffers.push_back(staging);
+    if (callback) _recording->callbacks.push_back(callback);
+
+    return true;
+}
+
+void CCVKGPUStreamingHub::checkIn(const UploadCallback &callback) {
+    if (!callback) return;
+    if (!_recording) begin();
+    _recording->callbacks.push_back(callback);
+}
+
+void CCVKGPUStreamingHub::flush(CCVKGPUTransportHub *transportHub, CCVKGPUBarrierManager *barrierManager) {
+    if (!_recording) return;
+
+    Batch *batch       = _recording;
+    _recording         = nullptr;
+    batch->submitFrame = _frame;
+
+    if (_transferQueue) {
+        ThsvsImageBarrier barrier{};
+        barrier.discardContents             = false;
+        barrier.srcQueueFamilyIndex         = _transferQueue->queueFamilyIndex;
+        barrier.dstQueueFamilyIndex         = _graphicsQueue->queueFamilyIndex;
+        barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+        barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+        barrier.prevAccessCount             = 1;
+        barrier.pPrevAccesses               = &THSVS_ACCESS_TYPES[static_cast<uint>(AccessType::TRANSFER_WRITE)];
+        barrier.nextAccessCount             = 1;
+        barrier.pNextAccesses               = &THSVS_ACCESS_TYPES[static_cast<uint>(AccessType::TRANSFER_WRITE)];
+
+        // release on the transfer queue
+        for (CCVKGPUTexture *gpuTexture : batch->textures) {
+            barrier.image                       = gpuTexture->vkImage;
+            barrier.subresourceRange.aspectMask = gpuTexture->aspectMask;
+            cmdFuncCCVKImageMemoryBarrier(&batch->cmdBuff, barrier);
+        }
+        VK_CHECK(vkEndCommandBuffer(batch->cmdBuff.vkCommandBuffer));
+
+        VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = &batch->cmdBuff.vkCommandBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores    = &batch->vkSemaphore;
+        VK_CHECK(vkQueueSubmit(_transferQueue->vkQueue, 1, &submitInfo, batch->vkFence));
+
+        CCASSERT(!_graphicsQueue->transferSemaphore, "previous streaming batch is never waited on");
+        _graphicsQueue->transferSemaphore = batch->vkSemaphore;
+
+        // acquire on the graphics queue, the rest is up to the barrier manager
+        transportHub->checkIn([&](const CCVKGPUCommandBuffer *gpuCommandBuffer) {
+            for (CCVKGPUTexture *gpuTexture : batch->textures) {
+                barrier.image                       = gpuTexture->vkImage;
+                barrier.subresourceRange.aspectMask = gpuTexture->aspectMask;
+                cmdFuncCCVKImageMemoryBarrier(gpuCommandBuffer, barrier);
+            }
+        });
+
+        for (CCVKGPUTexture *gpuTexture : batch->textures) {
+            gpuTexture->currentAccessTypes.assign({THSVS_ACCESS_TRANSFER_WRITE});
+            gpuTexture->transferAccess = THSVS_ACCESS_TRANSFER_WRITE;
+            barrierManager->checkIn(gpuTexture);
+        }
+    }
+
+    _inFlight.push_back(batch);
+}
+
+void CCVKGPUStreamingHub::update() {
+    ++_frame;
+
+    for (size_t i = 0U; i < _inFlight.size();) {
+        Batch *batch = _inFlight[i];
+        // the consuming frame has to finish too, before the semaphore can be reused
+        bool done = _frame - batch->submitFrame >= _device->backBufferCount;
+        if (done && batch->vkFence) {
+            done = vkGetFenceStatus(_device->vkDevice, batch->vkFence) == VK_SUCCESS;
+        }
+        if (done) {
+            retire(batch);
+            _inFlight.erase(_inFlight.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+}
+
 void CCVKGPUBarrierManager::update(CCVKGPUTransportHub *transportHub) {
     if (_buffersToBeChecked.empty() && _texturesToBeChecked.empty()) return;
 
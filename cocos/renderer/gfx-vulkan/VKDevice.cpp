@@ -43,6 +43,7 @@
 #include "VKTexture.h"
 #include "VKTextureBarrier.h"
 #include "VKUtils.h"
+#include "gfx-base/GFXCommandBundle.h"
 
 CC_DISABLE_WARNINGS()
 #define VMA_IMPLEMENTATION
@@ -217,6 +218,8 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     _features[static_cast<uint>(Feature::STENCIL_WRITE_MASK)]        = true;
     _features[static_cast<uint>(Feature::MULTITHREADED_SUBMISSION)]  = true;
     _features[static_cast<uint>(Feature::COMPUTE_SHADER)]            = true;
+    _features[static_cast<uint>(Feature::MULTI_DRAW_INDIRECT)]       = deviceFeatures.multiDrawIndirect;
+    _features[static_cast<uint>(Feature::TIMESTAMP_QUERY)]           = gpuContext->physicalDeviceProperties.limits.timestampComputeAndGraphics;
 
     _gpuDevice->useMultiDrawIndirect        = deviceFeatures.multiDrawIndirect;
     _gpuDevice->useDescriptorUpdateTemplate = _gpuDevice->minorVersion > 0 || checkExtension(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
@@ -349,6 +352,20 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     _gpuBarrierManager   = CC_NEW(CCVKGPUBarrierManager(_gpuDevice));
     _gpuDescriptorSetHub = CC_NEW(CCVKGPUDescriptorSetHub(_gpuDevice));
 
+    // streaming only gets its own queue if there is a dedicated transfer queue family
+    CCVKGPUQueue *graphicsQueue = static_cast<CCVKQueue *>(_queue)->gpuQueue();
+    _gpuTransferQueue           = CC_NEW(CCVKGPUQueue);
+    _gpuTransferQueue->type     = QueueType::TRANSFER;
+    cmdFuncCCVKGetDeviceQueue(this, _gpuTransferQueue);
+    if (!_gpuTransferQueue->vkQueue || _gpuTransferQueue->queueFamilyIndex == graphicsQueue->queueFamilyIndex) {
+        CC_SAFE_DELETE(_gpuTransferQueue)
+    }
+    _gpuStreamingHub = CC_NEW(CCVKGPUStreamingHub(_gpuDevice, _gpuTransferQueue, graphicsQueue));
+
+    if (hasFeature(Feature::TIMESTAMP_QUERY)) {
+        _gpuTimestampHub = CC_NEW(CCVKGPUTimestampHub(_gpuDevice, gpuContext->physicalDeviceProperties.limits.timestampPeriod));
+    }
+
     _gpuDescriptorHub->link(_gpuDescriptorSetHub);
 
     cmdFuncCCVKCreateSampler(this, &_gpuDevice->defaultSampler);
@@ -451,6 +468,9 @@ void CCVKDevice::doDestroy() {
     }
     _depthStencilTextures.clear();
 
+    CC_SAFE_DELETE(_gpuStreamingHub)
+    CC_SAFE_DELETE(_gpuTransferQueue)
+
     CC_SAFE_DESTROY(_queue)
     CC_SAFE_DESTROY(_cmdBuff)
 
@@ -460,6 +480,7 @@ void CCVKDevice::doDestroy() {
     CC_SAFE_DELETE(_gpuDescriptorHub)
     CC_SAFE_DELETE(_gpuBarrierManager)
     CC_SAFE_DELETE(_gpuDescriptorSetHub)
+    CC_SAFE_DELETE(_gpuTimestampHub)
 
     uint backBufferCount = static_cast<CCVKContext *>(_context)->gpuContext()->swapchainCreateInfo.minImageCount;
     for (uint i = 0U; i < backBufferCount; i++) {
@@ -545,6 +566,7 @@ void CCVKDevice::acquire() {
 
     _gpuBufferHub->flush(gpuTransportHub());
     _gpuDescriptorSetHub->flush();
+    if (_gpuTimestampHub) _gpuTimestampHub->flush(gpuTransportHub());
 
     _gpuSemaphorePool->reset();
     VkSemaphore acquireSemaphore = _gpuSemaphorePool->alloc();
@@ -557,6 +579,10 @@ void CCVKDevice::acquire() {
 
     queue->gpuQueue()->nextWaitSemaphore   = acquireSemaphore;
     queue->gpuQueue()->nextSignalSemaphore = _gpuSemaphorePool->alloc();
+
+    _gpuStreamingHub->update();
+    flushDeferredUploads();
+    _gpuStreamingHub->flush(gpuTransportHub(), _gpuBarrierManager);
 }
 
 void CCVKDevice::present() {
@@ -589,6 +615,8 @@ void CCVKDevice::present() {
         gpuFencePool()->reset();
         gpuRecycleBin()->clear();
         gpuStagingBufferPool()->reset();
+
+        if (_gpuTimestampHub) _gpuTimestampHub->resolve(_timingScopes);
     }
 }
 
@@ -596,7 +624,10 @@ CCVKGPUFencePool *        CCVKDevice::gpuFencePool() { return _gpuFencePools[_gp
 CCVKGPURecycleBin *       CCVKDevice::gpuRecycleBin() { return _gpuRecycleBins[_gpuDevice->curBackBufferIndex]; }
 CCVKGPUStagingBufferPool *CCVKDevice::gpuStagingBufferPool() { return _gpuStagingBufferPools[_gpuDevice->curBackBufferIndex]; }
 
-CommandBuffer *CCVKDevice::createCommandBuffer(const CommandBufferInfo & /*info*/, bool /*hasAgent*/) {
+CommandBuffer *CCVKDevice::createCommandBuffer(const CommandBufferInfo &info, bool /*hasAgent*/) {
+    // secondary command buffers are tied to one back buffer and cannot share a subpass with inline commands,
+    // so bundles are logged and replayed into the executing command buffer instead
+    if (info.type == CommandBufferType::BUNDLE) return CC_NEW(CommandBundle);
     return CC_NEW(CCVKCommandBuffer);
 }
 
@@ -662,6 +693,22 @@ void CCVKDevice::copyBuffersToTexture(const uint8_t *const *buffers, Texture *ds
     });
 }
 
+void CCVKDevice::copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) {
+    if (deferUpload(buffers, dst, regions, count, callback)) return;
+
+    if (!_gpuStreamingHub->checkIn(static_cast<CCVKTexture *>(dst)->gpuTexture(), buffers, regions, count, callback)) {
+        copyBuffersToTexture(buffers, dst, regions, count);
+        _gpuStreamingHub->checkIn(callback);
+    }
+}
+
+void CCVKDevice::updateBufferAsync(Buffer *buff, const void *data, uint size, const UploadCallback &callback) {
+    if (deferUpload(buff, data, size, callback)) return;
+
+    buff->update(data, size);
+    _gpuStreamingHub->checkIn(callback);
+}
+
 bool CCVKDevice::checkSwapchainStatus() {
     CCVKGPUContext *context = static_cast<CCVKContext *>(_context)->gpuContext();
 
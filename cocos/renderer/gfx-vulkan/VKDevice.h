@@ -39,8 +39,10 @@ class CCVKGPUSwapchain;
 
 class CCVKGPUBufferHub;
 class CCVKGPUTransportHub;
+class CCVKGPUStreamingHub;
 class CCVKGPUDescriptorHub;
 class CCVKGPUSemaphorePool;
+class CCVKGPUTimestampHub;
 class CCVKGPUBarrierManager;
 class CCVKGPUDescriptorSetHub;
 
@@ -88,10 +90,12 @@ public:
 
     inline CCVKGPUBufferHub *       gpuBufferHub() { return _gpuBufferHub; }
     inline CCVKGPUTransportHub *    gpuTransportHub() { return _gpuTransportHub; }
+    inline CCVKGPUStreamingHub *    gpuStreamingHub() { return _gpuStreamingHub; }
     inline CCVKGPUDescriptorHub *   gpuDescriptorHub() { return _gpuDescriptorHub; }
     inline CCVKGPUSemaphorePool *   gpuSemaphorePool() { return _gpuSemaphorePool; }
     inline CCVKGPUBarrierManager *  gpuBarrierManager() { return _gpuBarrierManager; }
     inline CCVKGPUDescriptorSetHub *gpuDescriptorSetHub() { return _gpuDescriptorSetHub; }
+    inline CCVKGPUTimestampHub *    gpuTimestampHub() { return _gpuTimestampHub; }
 
     CCVKGPUFencePool *        gpuFencePool();
     CCVKGPURecycleBin *       gpuRecycleBin();
@@ -122,6 +126,8 @@ protected:
     GlobalBarrier *      createGlobalBarrier() override;
     TextureBarrier *     createTextureBarrier() override;
     void                 copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) override;
+    void                 copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) override;
+    void                 updateBufferAsync(Buffer *buff, const void *data, uint size, const UploadCallback &callback) override;
 
     void destroySwapchain();
     bool checkSwapchainStatus();
@@ -139,10 +145,13 @@ protected:
 
     CCVKGPUBufferHub *       _gpuBufferHub        = nullptr;
     CCVKGPUTransportHub *    _gpuTransportHub     = nullptr;
+    CCVKGPUStreamingHub *    _gpuStreamingHub     = nullptr;
     CCVKGPUDescriptorHub *   _gpuDescriptorHub    = nullptr;
     CCVKGPUSemaphorePool *   _gpuSemaphorePool    = nullptr;
     CCVKGPUDescriptorSetHub *_gpuDescriptorSetHub = nullptr;
     CCVKGPUBarrierManager *  _gpuBarrierManager   = nullptr;
+    CCVKGPUTimestampHub *    _gpuTimestampHub     = nullptr;
+    CCVKGPUQueue *           _gpuTransferQueue    = nullptr;
 
     vector<const char *> _layers;
     vector<const char *> _extensions;
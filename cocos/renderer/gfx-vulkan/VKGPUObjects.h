@@ -151,6 +151,7 @@ public:
     void *      buffer   = nullptr;
 
     bool                                 isDrawIndirectByIndex = false;
+    uint                                 drawCount             = 0U; // valid draws in the indirect buffer
     vector<VkDrawIndirectCommand>        indirectCmds;
     vector<VkDrawIndexedIndirectCommand> indexedIndirectCmds;
 
@@ -222,6 +223,7 @@ public:
     uint                         queueFamilyIndex    = 0U;
     VkSemaphore                  nextWaitSemaphore   = VK_NULL_HANDLE;
     VkSemaphore                  nextSignalSemaphore = VK_NULL_HANDLE;
+    VkSemaphore                  transferSemaphore   = VK_NULL_HANDLE; // streamed uploads to wait for
     VkPipelineStageFlags         submitStageMask     = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
     CachedArray<VkCommandBuffer> commandBuffers;
 };
@@ -1160,6 +1162,60 @@ private:
     VkFence              _fence = VK_NULL_HANDLE;
 };
 
+class CCVKGPUBarrierManager;
+
+/**
+ * Streams texture uploads through a dedicated transfer queue when the device has one.
+ * Uploads are batched into one submission per frame, the queue family ownership is released
+ * on the transfer queue and acquired on the graphics queue, which waits for the batch semaphore.
+ * Batches are retired, staging buffers released and callbacks fired,
+ * once both the transfer fence and the consuming frame have completed.
+ */
+class CCVKGPUStreamingHub final : public Object {
+public:
+    CCVKGPUStreamingHub(CCVKGPUDevice *device, CCVKGPUQueue *transferQueue, CCVKGPUQueue *graphicsQueue);
+    ~CCVKGPUStreamingHub() override;
+
+    inline bool isDedicated() const { return _transferQueue != nullptr; }
+
+    // returns false if the texture can't be streamed, e.g. already in use by the graphics queue
+    bool checkIn(CCVKGPUTexture *gpuTexture, const uint8_t *const *buffers, const BufferTextureCopy *regions, uint count, const UploadCallback &callback);
+    // for uploads recorded on the graphics queue
+    void checkIn(const UploadCallback &callback);
+
+    void flush(CCVKGPUTransportHub *transportHub, CCVKGPUBarrierManager *barrierManager);
+    void update();
+
+private:
+    struct Staging {
+        VkBuffer      vkBuffer      = VK_NULL_HANDLE;
+        VmaAllocation vmaAllocation = VK_NULL_HANDLE;
+    };
+
+    struct Batch {
+        CCVKGPUCommandBuffer     cmdBuff;
+        VkFence                  vkFence     = VK_NULL_HANDLE;
+        VkSemaphore              vkSemaphore = VK_NULL_HANDLE;
+        uint                     submitFrame = 0U;
+        vector<Staging>          stagingBuffers;
+        vector<CCVKGPUTexture *> textures;
+        vector<UploadCallback>   callbacks;
+    };
+
+    void begin();
+    void retire(Batch *batch);
+
+    CCVKGPUDevice *_device        = nullptr;
+    CCVKGPUQueue * _transferQueue = nullptr;
+    CCVKGPUQueue * _graphicsQueue = nullptr;
+    VkCommandPool  _vkCommandPool = VK_NULL_HANDLE;
+    uint           _frame         = 0U;
+
+    Batch *         _recording = nullptr;
+    vector<Batch *> _inFlight;
+    vector<Batch *> _freeBatches;
+};
+
 class CCVKGPUBarrierManager final : public Object {
 public:
     explicit CCVKGPUBarrierManager(CCVKGPUDevice *device)
@@ -1248,5 +1304,108 @@ private:
     CCVKGPUDevice *_device = nullptr;
 };
 
+/**
+ * Timestamp queries for timing scopes, one query pool per back buffer instance.
+ * Results are read back once the back buffer instance is recycled, i.e. a few frames later.
+ */
+class CCVKGPUTimestampHub final : public Object {
+public:
+    CCVKGPUTimestampHub(CCVKGPUDevice *device, float timestampPeriod)
+    : _device(device),
+      _period(timestampPeriod * 1e-6F) {
+        VkQueryPoolCreateInfo createInfo{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+        createInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+        createInfo.queryCount = MAX_TIMING_SCOPES * 2;
+
+        _frames.resize(device->backBufferCount);
+        for (Frame &frame : _frames) {
+            VK_CHECK(vkCreateQueryPool(_device->vkDevice, &createInfo, nullptr, &frame.vkQueryPool));
+        }
+        _results.resize(MAX_TIMING_SCOPES * 4);
+    }
+
+    ~CCVKGPUTimestampHub() override {
+        for (Frame &frame : _frames) {
+            vkDestroyQueryPool(_device->vkDevice, frame.vkQueryPool, nullptr);
+        }
+        _frames.clear();
+    }
+
+    void begin(VkCommandBuffer vkCommandBuffer, const String &name) {
+        Frame &frame = _frames[_device->curBackBufferIndex];
+        // drop the scope if over the limit or the pool is not reset yet, e.g. the frame is not acquired
+        if (frame.resetNeeded || frame.scopes.size() >= MAX_TIMING_SCOPES) {
+            frame.openScopes.push_back(UINT_MAX);
+            return;
+        }
+
+        uint index = utils::toUint(frame.scopes.size());
+        frame.scopes.push_back({name, utils::toUint(frame.openScopes.size()), 0.F});
+        frame.openScopes.push_back(index);
+        vkCmdWriteTimestamp(vkCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.vkQueryPool, index * 2);
+    }
+
+    void end(VkCommandBuffer vkCommandBuffer) {
+        Frame &frame = _frames[_device->curBackBufferIndex];
+        if (frame.openScopes.empty()) return;
+
+        uint index = frame.openScopes.back();
+        frame.openScopes.pop_back();
+        if (index == UINT_MAX) return;
+
+        vkCmdWriteTimestamp(vkCommandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.vkQueryPool, index * 2 + 1);
+    }
+
+    // queries have to be reset before being written again, do it ahead of the frame
+    void flush(CCVKGPUTransportHub *transportHub) {
+        Frame &frame = _frames[_device->curBackBufferIndex];
+        if (!frame.resetNeeded) return;
+
+        transportHub->checkIn([&](const CCVKGPUCommandBuffer *gpuCommandBuffer) {
+            vkCmdResetQueryPool(gpuCommandBuffer->vkCommandBuffer, frame.vkQueryPool, 0, MAX_TIMING_SCOPES * 2);
+        });
+        frame.resetNeeded = false;
+    }
+
+    // should be called after the back buffer instance is known to be idle
+    void resolve(TimingScopeList &scopes) {
+        Frame &frame = _frames[_device->curBackBufferIndex];
+        if (frame.scopes.empty()) return;
+
+        uint queryCount = utils::toUint(frame.scopes.size()) * 2;
+        // each result is followed by its availability, scopes left open are never available
+        VkResult res = vkGetQueryPoolResults(_device->vkDevice, frame.vkQueryPool, 0, queryCount,
+                                             queryCount * 2 * sizeof(uint64_t), _results.data(), 2 * sizeof(uint64_t),
+                                             VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (res == VK_SUCCESS || res == VK_NOT_READY) {
+            for (uint i = 0U; i < frame.scopes.size(); ++i) {
+                const uint64_t *begin = &_results[i * 4];
+                const uint64_t *end   = &_results[i * 4 + 2];
+                if (begin[1] && end[1] && end[0] > begin[0]) {
+                    frame.scopes[i].gpuTime = static_cast<float>(end[0] - begin[0]) * _period;
+                }
+            }
+            scopes.swap(frame.scopes);
+        }
+
+        frame.scopes.clear();
+        frame.openScopes.clear();
+        frame.resetNeeded = true;
+    }
+
+private:
+    struct Frame {
+        VkQueryPool     vkQueryPool = VK_NULL_HANDLE;
+        TimingScopeList scopes;
+        vector<uint>    openScopes;
+        bool            resetNeeded = true;
+    };
+
+    CCVKGPUDevice *  _device = nullptr;
+    float            _period = 0.F; // nanoseconds per tick, converted to milliseconds
+    vector<Frame>    _frames;
+    vector<uint64_t> _results;
+};
+
 } // namespace gfx
 } // namespace cc
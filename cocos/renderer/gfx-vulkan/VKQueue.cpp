@@ -77,10 +77,25 @@ void CCVKQueue::submit(CommandBuffer *const *cmdBuffs, uint count) {
         }
     }
 
+    uint                 waitSemaphoreCount = 0U;
+    VkSemaphore          waitSemaphores[2];
+    VkPipelineStageFlags waitStageMasks[2];
+    if (_gpuQueue->nextWaitSemaphore) {
+        waitSemaphores[waitSemaphoreCount] = _gpuQueue->nextWaitSemaphore;
+        waitStageMasks[waitSemaphoreCount] = _gpuQueue->submitStageMask;
+        ++waitSemaphoreCount;
+    }
+    if (_gpuQueue->transferSemaphore) { // only the first submission after streaming needs to wait
+        waitSemaphores[waitSemaphoreCount] = _gpuQueue->transferSemaphore;
+        waitStageMasks[waitSemaphoreCount] = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        ++waitSemaphoreCount;
+        _gpuQueue->transferSemaphore = VK_NULL_HANDLE;
+    }
+
     VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
-    submitInfo.waitSemaphoreCount   = _gpuQueue->nextWaitSemaphore ? 1 : 0;
-    submitInfo.pWaitSemaphores      = &_gpuQueue->nextWaitSemaphore;
-    submitInfo.pWaitDstStageMask    = &_gpuQueue->submitStageMask;
+    submitInfo.waitSemaphoreCount   = waitSemaphoreCount;
+    submitInfo.pWaitSemaphores      = waitSemaphores;
+    submitInfo.pWaitDstStageMask    = waitStageMasks;
     submitInfo.commandBufferCount   = _gpuQueue->commandBuffers.size();
     submitInfo.pCommandBuffers      = &_gpuQueue->commandBuffers[0];
     submitInfo.signalSemaphoreCount = _gpuQueue->nextSignalSemaphore ? 1 : 0;
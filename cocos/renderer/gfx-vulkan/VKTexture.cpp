@@ -78,6 +78,7 @@ void CCVKTexture::createTextureView() {
 }
 
 void CCVKTexture::doDestroy() {
+    CCVKDevice::getInstance()->cancelUploads(this);
     if (_gpuTextureView) {
         CCVKDevice::getInstance()->gpuRecycleBin()->collect(_gpuTextureView);
         CCVKDevice::getInstance()->gpuDescriptorHub()->disengage(_gpuTextureView);
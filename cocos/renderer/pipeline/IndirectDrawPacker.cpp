@@ -0,0 +1,132 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "IndirectDrawPacker.h"
+#include "PipelineStateManager.h"
+#include "gfx-base/GFXBuffer.h"
+#include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXInputAssembler.h"
+#include "helper/SharedMemory.h"
+
+namespace cc {
+namespace pipeline {
+
+IndirectDrawPacker::IndirectDrawPacker(gfx::Device *device) : _device(device) {
+}
+
+IndirectDrawPacker::~IndirectDrawPacker() {
+    for (auto &slot : _slots) {
+        CC_SAFE_DESTROY(slot.ia);
+        CC_SAFE_DESTROY(slot.indirectBuffer);
+    }
+    _slots.clear();
+}
+
+bool IndirectDrawPacker::isCompatible(const PackedDraw &draw, const PassView *pass, gfx::Shader *shader, gfx::DescriptorSet *descriptorSet, const vector<uint> &dynamicOffsets, const gfx::InputAssembler *ia) {
+    // same pass, shader and vertex layout resolve to the same pipeline state in any render pass
+    return draw.pass == pass && draw.shader == shader && draw.descriptorSet == descriptorSet &&
+           *draw.dynamicOffsets == dynamicOffsets &&
+           draw.ia->getAttributesHash() == ia->getAttributesHash() &&
+           draw.ia->getVertexBuffers() == ia->getVertexBuffers() &&
+           draw.ia->getIndexBuffer() == ia->getIndexBuffer();
+}
+
+void IndirectDrawPacker::add(const PassView *pass, gfx::Shader *shader, gfx::DescriptorSet *descriptorSet, const vector<uint> &dynamicOffsets, gfx::InputAssembler *ia) {
+    // draws already going through an indirect buffer are kept as they are
+    if (_draws.empty() || ia->getIndirectBuffer() || _draws.back().ia->getIndirectBuffer() ||
+        !isCompatible(_draws.back(), pass, shader, descriptorSet, dynamicOffsets, ia)) {
+        _draws.push_back({pass, shader, descriptorSet, &dynamicOffsets, ia, {}});
+    }
+
+    gfx::DrawInfo drawInfo;
+    ia->extractDrawInfo(drawInfo);
+    // an instance count of 0 means a non-instanced draw, which isn't valid in an indirect command
+    drawInfo.instanceCount = std::max(drawInfo.instanceCount, 1U);
+    _draws.back().drawInfos.push_back(drawInfo);
+}
+
+void IndirectDrawPacker::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
+    for (auto &draw : _draws) {
+        if (draw.drawInfos.size() < 2) continue;
+
+        if (_usedSlots == _slots.size()) _slots.emplace_back();
+        auto &slot = _slots[_usedSlots++];
+        const auto size = static_cast<uint>(draw.drawInfos.size() * sizeof(gfx::DrawInfo));
+        if (!slot.indirectBuffer) {
+            slot.indirectBuffer = _device->createBuffer({
+                gfx::BufferUsageBit::INDIRECT | gfx::BufferUsageBit::TRANSFER_DST,
+                gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE,
+                size,
+                sizeof(gfx::DrawInfo),
+            });
+        } else if (slot.indirectBuffer->getSize() < size) {
+            slot.indirectBuffer->resize(size);
+        }
+        cmdBuffer->updateBuffer(slot.indirectBuffer, draw.drawInfos.data(), size);
+
+        // the source input assemblers may not outlive the frame, so the packed one is rebuilt every time
+        CC_SAFE_DESTROY(slot.ia);
+        slot.ia = _device->createInputAssembler({draw.ia->getAttributes(), draw.ia->getVertexBuffers(), draw.ia->getIndexBuffer(), slot.indirectBuffer});
+        draw.ia = slot.ia;
+    }
+
+    for (auto i = _usedSlots; i < _slots.size(); ++i) {
+        CC_SAFE_DESTROY(_slots[i].ia);
+    }
+}
+
+void IndirectDrawPacker::recordCommandBuffer(gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer) {
+    const PassView *lastPass = nullptr;
+    gfx::PipelineState *lastPSO = nullptr;
+    gfx::DescriptorSet *lastDescriptorSet = nullptr;
+    const vector<uint> *lastDynamicOffsets = nullptr;
+    for (const auto &draw : _draws) {
+        if (lastPass != draw.pass) {
+            cmdBuffer->bindDescriptorSet(materialSet, draw.pass->getDescriptorSet());
+            lastPass = draw.pass;
+        }
+        auto *pso = PipelineStateManager::getOrCreatePipelineState(draw.pass, draw.shader, draw.ia, renderPass);
+        if (lastPSO != pso) {
+            cmdBuffer->bindPipelineState(pso);
+            lastPSO = pso;
+        }
+        if (lastDescriptorSet != draw.descriptorSet || lastDynamicOffsets != draw.dynamicOffsets) {
+            cmdBuffer->bindDescriptorSet(localSet, draw.descriptorSet, *draw.dynamicOffsets);
+            lastDescriptorSet = draw.descriptorSet;
+            lastDynamicOffsets = draw.dynamicOffsets;
+        }
+        cmdBuffer->bindInputAssembler(draw.ia);
+        cmdBuffer->draw(draw.ia);
+    }
+}
+
+void IndirectDrawPacker::clear() {
+    _draws.clear();
+    _usedSlots = 0;
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,77 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "Define.h"
+
+namespace cc {
+namespace gfx {
+class Device;
+class RenderPass;
+class CommandBuffer;
+} // namespace gfx
+namespace pipeline {
+struct PassView;
+
+// Consecutive draws sharing the pass, shader, local descriptor set and geometry buffers,
+// and thus the pipeline state, folded into a single indirect draw.
+struct CC_DLL PackedDraw {
+    const PassView *pass = nullptr;
+    gfx::Shader *shader = nullptr;
+    gfx::DescriptorSet *descriptorSet = nullptr;
+    const vector<uint> *dynamicOffsets = nullptr;
+    gfx::InputAssembler *ia = nullptr;
+    gfx::DrawInfoList drawInfos;
+};
+
+class CC_DLL IndirectDrawPacker : public Object {
+public:
+    explicit IndirectDrawPacker(gfx::Device *device);
+    ~IndirectDrawPacker();
+
+    void add(const PassView *pass, gfx::Shader *shader, gfx::DescriptorSet *descriptorSet, const vector<uint> &dynamicOffsets, gfx::InputAssembler *ia);
+    void uploadBuffers(gfx::CommandBuffer *cmdBuffer);
+    void recordCommandBuffer(gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer);
+    void clear();
+
+    CC_INLINE const vector<PackedDraw> &getDraws() const { return _draws; }
+
+private:
+    struct IndirectSlot {
+        gfx::Buffer *indirectBuffer = nullptr;
+        gfx::InputAssembler *ia = nullptr;
+    };
+
+    static bool isCompatible(const PackedDraw &draw, const PassView *pass, gfx::Shader *shader, gfx::DescriptorSet *descriptorSet, const vector<uint> &dynamicOffsets, const gfx::InputAssembler *ia);
+
+    gfx::Device *_device = nullptr;
+    vector<PackedDraw> _draws;
+    vector<IndirectSlot> _slots;
+    uint _usedSlots = 0;
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "RenderFlow.h"
+#include "RenderPipeline.h"
 #include "RenderStage.h"
 
 namespace cc {
@@ -52,8 +53,11 @@ void RenderFlow::activate(RenderPipeline *pipeline) {
 }
 
 void RenderFlow::render(Camera *camera) {
+    StageProfiler &profiler = _pipeline->getProfiler();
     for (auto *const stage : _stages) {
+        profiler.beginScope(stage->getName());
         stage->render(camera);
+        profiler.endScope();
     }
 }
 
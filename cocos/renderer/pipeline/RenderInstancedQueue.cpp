@@ -24,19 +24,33 @@
 ****************************************************************************/
 
 #include "RenderInstancedQueue.h"
+#include "IndirectDrawPacker.h"
 #include "InstancedBuffer.h"
 #include "PipelineStateManager.h"
 #include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDevice.h"
 #include "helper/SharedMemory.h"
 
 namespace cc {
 namespace pipeline {
 
+RenderInstancedQueue::~RenderInstancedQueue() {
+    CC_SAFE_DELETE(_packer);
+}
+
+void RenderInstancedQueue::setIndirectPacking(gfx::Device *device, bool enabled) {
+    CC_SAFE_DELETE(_packer);
+    if (enabled && device->hasFeature(gfx::Feature::MULTI_DRAW_INDIRECT)) {
+        _packer = CC_NEW(IndirectDrawPacker(device));
+    }
+}
+
 void RenderInstancedQueue::clear() {
     for (auto *it : _queues) {
         it->clear();
     }
     _queues.clear();
+    if (_packer) _packer->clear();
 }
 
 void RenderInstancedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
@@ -45,9 +59,26 @@ void RenderInstancedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
             instanceBuffer->uploadBuffers(cmdBuffer);
         }
     }
+
+    if (!_packer) return;
+    _packer->clear();
+    for (auto *instanceBuffer : _queues) {
+        if (!instanceBuffer->hasPendingModels()) continue;
+
+        for (const auto &instance : instanceBuffer->getInstances()) {
+            if (!instance.count) continue;
+            _packer->add(instanceBuffer->getPass(), instance.shader, instance.descriptorSet, instanceBuffer->dynamicOffsets(), instance.ia);
+        }
+    }
+    _packer->uploadBuffers(cmdBuffer);
 }
 
 void RenderInstancedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer) {
+    if (_packer) {
+        _packer->recordCommandBuffer(renderPass, cmdBuffer);
+        return;
+    }
+
     for (auto *instanceBuffer : _queues) {
         if (!instanceBuffer->hasPendingModels()) continue;
 
@@ -55,6 +86,7 @@ void RenderInstancedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::Re
         const auto *pass = instanceBuffer->getPass();
         cmdBuffer->bindDescriptorSet(materialSet, pass->getDescriptorSet());
         gfx::PipelineState *lastPSO = nullptr;
+        gfx::DescriptorSet *lastDescriptorSet = nullptr;
         for (const auto& instance : instances) {
             if (!instance.count) {
                 continue;
@@ -64,7 +96,11 @@ void RenderInstancedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::Re
                 cmdBuffer->bindPipelineState(pso);
                 lastPSO = pso;
             }
-            cmdBuffer->bindDescriptorSet(localSet, instance.descriptorSet, instanceBuffer->dynamicOffsets());
+            // dynamic offsets are shared across the whole buffer
+            if (lastDescriptorSet != instance.descriptorSet) {
+                cmdBuffer->bindDescriptorSet(localSet, instance.descriptorSet, instanceBuffer->dynamicOffsets());
+                lastDescriptorSet = instance.descriptorSet;
+            }
             cmdBuffer->bindInputAssembler(instance.ia);
             cmdBuffer->draw(instance.ia);
         }
@@ -38,19 +38,23 @@ class CommandBuffer;
 namespace pipeline {
 
 class InstancedBuffer;
+class IndirectDrawPacker;
 
 class CC_DLL RenderInstancedQueue : public Object {
 public:
     RenderInstancedQueue() = default;
-    ~RenderInstancedQueue() = default;
+    ~RenderInstancedQueue();
 
     void recordCommandBuffer(gfx::Device *device, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer);
     void add(InstancedBuffer *instancedBuffer);
     void uploadBuffers(gfx::CommandBuffer *cmdBuffer);
     void clear();
+    // Packs draws with the same bindings into indirect draws, where the device supports multi-draw indirect
+    void setIndirectPacking(gfx::Device *device, bool enabled);
 
 private:
     unordered_set<InstancedBuffer *> _queues;
+    IndirectDrawPacker *_packer = nullptr;
 };
 
 } // namespace pipeline
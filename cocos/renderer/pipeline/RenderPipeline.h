@@ -28,6 +28,7 @@
 #include "Define.h"
 #include "PipelineSceneData.h"
 #include "PipelineUBO.h"
+#include "StageProfiler.h"
 #include "base/CoreStd.h"
 #include "helper/DefineMap.h"
 #include "helper/SharedMemory.h"
@@ -75,6 +76,7 @@ public:
     inline PipelineUBO *                           getPipelineUBO() const { return _pipelineUBO; }
     inline const String &                          getConstantMacros() { return _constantMacros; }
     inline gfx::Device *                           getDevice() { return _device; }
+    inline StageProfiler &                         getProfiler() { return _profiler; }
 
 protected:
     static RenderPipeline *instance;
@@ -89,6 +91,7 @@ protected:
     DefineMap                        _macros;
     uint                             _tag = 0;
     String                           _constantMacros;
+    StageProfiler                    _profiler;
 
     gfx::Device *             _device              = nullptr;
     gfx::DescriptorSetLayout *_descriptorSetLayout = nullptr;
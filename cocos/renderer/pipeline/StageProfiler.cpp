@@ -0,0 +1,147 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "StageProfiler.h"
+#include "base/Utils.h"
+#include "gfx-base/GFXDevice.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+namespace pipeline {
+
+namespace {
+void appendEscaped(String &out, const String &str) {
+    for (char c : str) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+}
+} // namespace
+
+void StageProfiler::setEnabled(bool enabled) {
+    if (enabled == _enabled) return;
+
+    _enabled = enabled;
+    _cmdBuff = nullptr;
+    _epoch   = Clock::now();
+    _timings.clear();
+    _frame.clear();
+    _openScopes.clear();
+    _traceFrames.clear();
+}
+
+void StageProfiler::beginFrame(gfx::CommandBuffer *cmdBuff) {
+    if (!_enabled) return;
+
+    _cmdBuff    = cmdBuff;
+    _frameStart = Clock::now();
+    _frame.clear();
+}
+
+void StageProfiler::beginScope(const String &name) {
+    if (!_cmdBuff) return;
+
+    _openScopes.push_back(utils::toUint(_frame.size()));
+    _frame.push_back({name, false, elapsed(Clock::now()), 0U});
+    _cmdBuff->beginTimingScope(name);
+}
+
+void StageProfiler::endScope() {
+    if (!_cmdBuff || _openScopes.empty()) return;
+
+    _cmdBuff->endTimingScope();
+    TraceEvent &event = _frame[_openScopes.back()];
+    event.duration    = elapsed(Clock::now()) - event.start;
+    _openScopes.pop_back();
+}
+
+void StageProfiler::endFrame(gfx::Device *device) {
+    if (!_cmdBuff) return;
+
+    while (!_openScopes.empty()) endScope();
+    _cmdBuff = nullptr;
+
+    _timings.clear();
+    for (const TraceEvent &event : _frame) {
+        StageTiming &timing = findTiming(event.name);
+        timing.cpuTime += static_cast<float>(event.duration) * 1e-3F;
+        ++timing.count;
+    }
+
+    // GPU results come from an earlier frame and carry durations only,
+    // so they are laid out back to back from the start of this frame in the trace
+    vector<uint64_t> cursors{elapsed(_frameStart)};
+    for (const gfx::TimingScope &scope : device->getTimingScopes()) {
+        findTiming(scope.name).gpuTime += scope.gpuTime;
+
+        if (cursors.size() <= scope.depth) cursors.resize(scope.depth + 1, cursors.back());
+        uint64_t start    = cursors[scope.depth];
+        uint64_t duration = static_cast<uint64_t>(scope.gpuTime * 1e3F);
+        cursors[scope.depth] += duration;
+        cursors.resize(scope.depth + 2);
+        cursors[scope.depth + 1] = start;
+
+        _frame.push_back({scope.name, true, start, duration});
+    }
+
+    _traceFrames.push_back(std::move(_frame));
+    _frame.clear();
+    if (_traceFrames.size() > MAX_TRACE_FRAMES) _traceFrames.pop_front();
+}
+
+bool StageProfiler::exportTrace(const String &path) const {
+    String json = "{\"traceEvents\":[";
+    bool   first = true;
+    for (const TraceFrame &frame : _traceFrames) {
+        for (const TraceEvent &event : frame) {
+            if (!first) json += ',';
+            first = false;
+
+            json += "{\"name\":\"";
+            appendEscaped(json, event.name);
+            json += event.gpu ? "\",\"cat\":\"gpu\",\"tid\":1" : "\",\"cat\":\"cpu\",\"tid\":0";
+            json += ",\"ph\":\"X\",\"pid\":0,\"ts\":" + std::to_string(event.start);
+            json += ",\"dur\":" + std::to_string(event.duration) + "}";
+        }
+    }
+    json += "]}";
+
+    return FileUtils::getInstance()->writeStringToFile(json, path);
+}
+
+uint64_t StageProfiler::elapsed(Clock::time_point time) const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(time - _epoch).count());
+}
+
+StageTiming &StageProfiler::findTiming(const String &name) {
+    for (StageTiming &timing : _timings) {
+        if (timing.name == name) return timing;
+    }
+    _timings.push_back({name, 0.F, 0.F, 0U});
+    return _timings.back();
+}
+
+} // namespace pipeline
+} // namespace cc
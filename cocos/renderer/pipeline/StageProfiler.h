@@ -0,0 +1,96 @@
+/****************************************************************************
+ Copyright (c) 2020-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include "base/CoreStd.h"
+
+namespace cc {
+namespace gfx {
+class CommandBuffer;
+class Device;
+} // namespace gfx
+namespace pipeline {
+
+struct CC_DLL StageTiming {
+    String name;
+    float  cpuTime = 0.F; // in milliseconds
+    float  gpuTime = 0.F; // in milliseconds, lags a few frames behind
+    uint   count   = 0U;  // scopes merged into this entry, e.g. one per camera
+};
+using StageTimingList = vector<StageTiming>;
+
+/**
+ * Times render stages on the CPU, and on the GPU through gfx timing scopes.
+ * Per-stage totals of the latest frame are kept for queries,
+ * the last few frames can be exported as a Chrome trace file.
+ */
+class CC_DLL StageProfiler {
+public:
+    static constexpr uint MAX_TRACE_FRAMES = 300U;
+
+    void        setEnabled(bool enabled);
+    inline bool isEnabled() const { return _enabled; }
+
+    void beginFrame(gfx::CommandBuffer *cmdBuff);
+    void endFrame(gfx::Device *device);
+
+    void beginScope(const String &name);
+    void endScope();
+
+    inline const StageTimingList &getTimings() const { return _timings; }
+
+    // in the trace event format, viewable in chrome://tracing
+    bool exportTrace(const String &path) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct TraceEvent {
+        String   name;
+        bool     gpu      = false;
+        uint64_t start    = 0U; // in microseconds since enabled
+        uint64_t duration = 0U; // in microseconds
+    };
+    using TraceFrame = vector<TraceEvent>;
+
+    uint64_t     elapsed(Clock::time_point time) const;
+    StageTiming &findTiming(const String &name);
+
+    bool                _enabled = false;
+    gfx::CommandBuffer *_cmdBuff = nullptr;
+    Clock::time_point   _epoch;
+    Clock::time_point   _frameStart;
+
+    StageTimingList        _timings;
+    TraceFrame             _frame;
+    vector<uint>           _openScopes;
+    std::deque<TraceFrame> _traceFrames;
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -129,6 +129,7 @@ bool DeferredPipeline::activate() {
 
 void DeferredPipeline::render(const vector<uint> &cameras) {
     _commandBuffers[0]->begin();
+    _profiler.beginFrame(_commandBuffers[0]);
     _pipelineUBO->updateGlobalUBO();
     for (const auto cameraId : cameras) {
         auto *camera = GET_CAMERA(cameraId);
@@ -138,6 +139,7 @@ void DeferredPipeline::render(const vector<uint> &cameras) {
             flow->render(camera);
         }
     }
+    _profiler.endFrame(_device);
     _commandBuffers[0]->end();
     _device->flushCommands(_commandBuffers);
     _device->getQueue()->submit(_commandBuffers);
@@ -82,6 +82,10 @@ void PostprocessStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
 void PostprocessStage::destroy() {
 }
 
+void PostprocessStage::setStaticUI(bool value) {
+    _uiPhase->setStatic(value);
+}
+
 void PostprocessStage::render(Camera *camera) {
     auto *pp = dynamic_cast<DeferredPipeline *>(_pipeline);
     assert(pp != nullptr);
@@ -122,6 +122,7 @@ bool ForwardPipeline::activate() {
 
 void ForwardPipeline::render(const vector<uint> &cameras) {
     _commandBuffers[0]->begin();
+    _profiler.beginFrame(_commandBuffers[0]);
     _pipelineUBO->updateGlobalUBO();
     for (const auto cameraId : cameras) {
         auto *camera = GET_CAMERA(cameraId);
@@ -131,6 +132,7 @@ void ForwardPipeline::render(const vector<uint> &cameras) {
             flow->render(camera);
         }
     }
+    _profiler.endFrame(_device);
     _commandBuffers[0]->end();
     _device->flushCommands(_commandBuffers);
     _device->getQueue()->submit(_commandBuffers);
@@ -104,6 +104,7 @@ void ForwardStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
 
     _additiveLightQueue = CC_NEW(RenderAdditiveLightQueue(_pipeline));
     _planarShadowQueue = CC_NEW(PlanarShadowQueue(_pipeline));
+    _instancedQueue->setIndirectPacking(_device, true);
     _uiPhase->activate(pipeline);
 }
 
@@ -116,6 +117,10 @@ void ForwardStage::destroy() {
     RenderStage::destroy();
 }
 
+void ForwardStage::setStaticUI(bool value) {
+    _uiPhase->setStatic(value);
+}
+
 void ForwardStage::render(Camera *camera) {
     _instancedQueue->clear();
     _batchedQueue->clear();
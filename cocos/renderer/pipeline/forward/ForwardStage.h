@@ -51,6 +51,9 @@ public:
     void destroy() override;
     void render(Camera *camera) override;
 
+    // replay UI draws from a pre-recorded command bundle while they stay unchanged
+    void setStaticUI(bool value);
+
 private:
     static RenderStageInfo initInfo;
     ForwardPipeline *_forwrdPipeline = nullptr;
@@ -25,19 +25,42 @@
 
 #include "UIPhase.h"
 #include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDescriptorSet.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXInputAssembler.h"
+#include "gfx-base/GFXRenderPass.h"
+#include "gfx-base/GFXShader.h"
 #include "pipeline/PipelineStateManager.h"
 
 namespace cc {
 namespace pipeline {
 
+namespace {
+// bundles of cameras that haven't rendered UI for this many renders are released
+constexpr uint STALE_BUNDLE_RENDERS = 64;
+} // namespace
+
+UIPhase::~UIPhase() {
+    setStatic(false);
+}
+
 void UIPhase::activate(RenderPipeline *pipeline) {
     _pipeline = pipeline;
     _phaseID  = getPhaseID("default");
 };
 
-void UIPhase::render(Camera *camera, gfx::RenderPass *renderPass) {
-    auto *cmdBuff = _pipeline->getCommandBuffers()[0];
+void UIPhase::setStatic(bool value) {
+    _isStatic = value;
+    if (!_isStatic) {
+        for (auto &pair : _bundles) {
+            CC_SAFE_DESTROY(pair.second.cmdBuff);
+        }
+        _bundles.clear();
+    }
+}
 
+template <typename Func>
+void UIPhase::forEachDraw(Camera *camera, Func func) const {
     const auto *batches    = camera->getScene()->getUIBatches();
     const auto  batchCount = batches[0];
     // Notice: The batches[0] is batchCount
@@ -53,17 +76,75 @@ void UIPhase::render(Camera *camera, gfx::RenderPass *renderPass) {
         for (uint j = 0; j < count; j++) {
             const auto *const pass = batch->getPassView(j);
             if (pass->phase != _phaseID) continue;
-            auto *const shader         = batch->getShader(j);
-            auto *const inputAssembler = batch->getInputAssembler();
-            auto *const ds             = batch->getDescriptorSet();
-            auto *      pso            = cc::pipeline::PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass);
-            cmdBuff->bindPipelineState(pso);
-            cmdBuff->bindDescriptorSet(materialSet, pass->getDescriptorSet());
-            cmdBuff->bindDescriptorSet(localSet, ds);
-            cmdBuff->bindInputAssembler(inputAssembler);
-            cmdBuff->draw(inputAssembler);
+            func(batch, j, pass);
+        }
+    }
+}
+
+void UIPhase::recordCommandBuffer(Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff) {
+    forEachDraw(camera, [&](const UIBatch *batch, uint j, const PassView *pass) {
+        auto *const shader         = batch->getShader(j);
+        auto *const inputAssembler = batch->getInputAssembler();
+        auto *const ds             = batch->getDescriptorSet();
+        auto *      pso            = cc::pipeline::PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass);
+        cmdBuff->bindPipelineState(pso);
+        cmdBuff->bindDescriptorSet(materialSet, pass->getDescriptorSet());
+        cmdBuff->bindDescriptorSet(localSet, ds);
+        cmdBuff->bindInputAssembler(inputAssembler);
+        cmdBuff->draw(inputAssembler);
+    });
+}
+
+void UIPhase::render(Camera *camera, gfx::RenderPass *renderPass) {
+    auto *cmdBuff = _pipeline->getCommandBuffers()[0];
+
+    if (!_isStatic) {
+        recordCommandBuffer(camera, renderPass, cmdBuff);
+        return;
+    }
+
+    // anything that would end up in a different command stream goes into the signature.
+    // Pool ids are reused once their objects are freed, so the objects are told apart by their object ids.
+    _signature.clear();
+    _signature.push_back(renderPass->getHash());
+    forEachDraw(camera, [&](const UIBatch *batch, uint j, const PassView *pass) {
+        auto *const   inputAssembler = batch->getInputAssembler();
+        gfx::DrawInfo drawInfo;
+        inputAssembler->extractDrawInfo(drawInfo);
+        _signature.insert(_signature.end(), {pass->hash, pass->getDescriptorSet()->getObjectID(), batch->getShader(j)->getObjectID(),
+                                             batch->getDescriptorSet()->getObjectID(), inputAssembler->getObjectID(),
+                                             drawInfo.vertexCount, drawInfo.firstVertex, drawInfo.indexCount, drawInfo.firstIndex, drawInfo.instanceCount});
+    });
+
+    ++_renderCount;
+    for (auto iter = _bundles.begin(); iter != _bundles.end();) {
+        if (iter->first != camera && _renderCount - iter->second.lastUse > STALE_BUNDLE_RENDERS) {
+            CC_SAFE_DESTROY(iter->second.cmdBuff);
+            iter = _bundles.erase(iter);
+        } else {
+            ++iter;
         }
     }
+
+    Bundle &bundle = _bundles[camera];
+    bundle.lastUse = _renderCount;
+    if (!bundle.cmdBuff || _signature != bundle.signature) {
+        auto *device = _pipeline->getDevice();
+        if (!bundle.cmdBuff) {
+            bundle.cmdBuff = device->createCommandBuffer({device->getQueue(), gfx::CommandBufferType::BUNDLE});
+        }
+
+        bundle.cmdBuff->begin(renderPass);
+        // bundles do not inherit any state from the executing command buffer
+        bundle.cmdBuff->bindDescriptorSet(globalSet, _pipeline->getDescriptorSet());
+        recordCommandBuffer(camera, renderPass, bundle.cmdBuff);
+        bundle.cmdBuff->end();
+        device->flushCommands(&bundle.cmdBuff, 1);
+
+        bundle.signature.swap(_signature);
+    }
+
+    cmdBuff->execute(&bundle.cmdBuff, 1);
 }
 
 } // namespace pipeline
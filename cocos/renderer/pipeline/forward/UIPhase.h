@@ -32,11 +32,34 @@ namespace pipeline {
 class CC_DLL UIPhase {
 public:
     UIPhase () = default;
+    ~UIPhase();
     void activate(RenderPipeline* pipeline);
     void render(Camera *camera, gfx::RenderPass* renderPass);
+
+    // Static UI is recorded into a command bundle once and replayed every frame,
+    // until the visible batches or their states change.
+    void setStatic(bool value);
+    inline bool isStatic() const { return _isStatic; }
+
 protected:
+    template <typename Func>
+    void forEachDraw(Camera *camera, Func func) const;
+    void recordCommandBuffer(Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff);
+
     RenderPipeline *_pipeline = nullptr;
     uint _phaseID = 0;
+
+    // render() runs once per camera, and each camera sees its own set of visible batches
+    struct Bundle {
+        gfx::CommandBuffer *cmdBuff = nullptr;
+        vector<uint> signature;
+        uint lastUse = 0;
+    };
+
+    bool _isStatic = false;
+    unordered_map<const Camera *, Bundle> _bundles;
+    vector<uint> _signature;
+    uint _renderCount = 0;
 };
 
 }
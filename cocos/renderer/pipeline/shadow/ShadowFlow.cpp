@@ -86,7 +86,9 @@ void ShadowFlow::render(Camera *camera) {
         for (auto *stage : _stages) {
             auto *shadowStage = dynamic_cast<ShadowStage *>(stage);
             shadowStage->setUseData(light, shadowFrameBuffer);
+            _pipeline->getProfiler().beginScope(shadowStage->getName());
             shadowStage->render(camera);
+            _pipeline->getProfiler().endScope();
         }
     }
 
@@ -78,6 +78,13 @@ void localStorageFree() {
     }
 }
 
+// Each call is committed by the Java side, there is nothing pending to write.
+void localStorageFlush() {
+}
+
+void localStorageSetFlushInterval(float /*seconds*/) {
+}
+
 /** sets an item in the LS */
 void localStorageSetItem(const std::string &key, const std::string &value) {
     assert(_initialized);
@@ -55,6 +55,7 @@
  */
 
 #include "storage/local-storage/LocalStorage.h"
+#include "base/Log.h"
 #include "base/Macros.h"
 
 #if (CC_PLATFORM != CC_PLATFORM_ANDROID)
@@ -62,30 +63,171 @@
     #include <stdio.h>
     #include <stdlib.h>
     #include <assert.h>
+    #include <algorithm>
+    #include <chrono>
+    #include <condition_variable>
+    #include <map>
+    #include <mutex>
+    #include <thread>
+    #include <unordered_map>
+    #include <vector>
     #if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
         #include <sqlite3/sqlite3.h>
     #else
         #include <sqlite3.h>
     #endif
 
+// All reads are served from memory, writes are coalesced per key and committed
+// to the database in a single transaction by a background thread.
+
+namespace {
+struct CachedItem {
+    std::string value;
+    uint64_t    order; // mirrors ROWID order, REPLACE moves a key to the end
+};
+
+struct PendingItem {
+    bool        removed;
+    std::string value;
+    uint64_t    order;
+};
+} // namespace
+
 static int _initialized = 0;
 static sqlite3 *_db;
-static sqlite3_stmt *_stmt_select;
 static sqlite3_stmt *_stmt_remove;
 static sqlite3_stmt *_stmt_update;
 static sqlite3_stmt *_stmt_clear;
-static sqlite3_stmt *_stmt_key;
-static sqlite3_stmt *_stmt_count;
+
+// guarded by _cacheMutex
+static std::mutex _cacheMutex;
+static std::unordered_map<std::string, CachedItem> _cache;
+static std::map<uint64_t, std::string> _keys;
+static uint64_t _nextOrder = 0;
+static std::unordered_map<std::string, PendingItem> _pending;
+static bool _pendingClear = false;
+
+// serializes database writes so batches are committed in the order they were taken
+static std::mutex _dbMutex;
+
+static std::thread _flushThread;
+static std::mutex _flushMutex;
+static std::condition_variable _flushCondition;
+static bool _flushThreadExit = false;
+static float _flushInterval = 1.0F;
 
 static void localStorageCreateTable() {
     const char *sql_createtable = "CREATE TABLE IF NOT EXISTS data(key TEXT PRIMARY KEY,value TEXT);";
     sqlite3_stmt *stmt;
     int ok = sqlite3_prepare_v2(_db, sql_createtable, -1, &stmt, nullptr);
-    ok |= sqlite3_step(stmt);
-    ok |= sqlite3_finalize(stmt);
+    if (ok == SQLITE_OK) {
+        ok = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+    }
+
+    if (ok != SQLITE_DONE)
+        CC_LOG_ERROR("Error in CREATE TABLE");
+}
+
+static void localStorageLoad() {
+    const char *sql_load = "SELECT key, value FROM data ORDER BY ROWID ASC;";
+    sqlite3_stmt *stmt;
+    int ok = sqlite3_prepare_v2(_db, sql_load, -1, &stmt, nullptr);
+    if (ok != SQLITE_OK) {
+        CC_LOG_ERROR("Error in loading localStorage");
+        return;
+    }
+    while ((ok = sqlite3_step(stmt)) == SQLITE_ROW) {
+        const unsigned char *key = sqlite3_column_text(stmt, 0);
+        const unsigned char *value = sqlite3_column_text(stmt, 1);
+        if (!key || !value) {
+            continue;
+        }
+        uint64_t order = _nextOrder++;
+        _cache[(const char *)key] = {(const char *)value, order};
+        _keys.emplace(order, (const char *)key);
+    }
+    if (ok != SQLITE_DONE)
+        CC_LOG_ERROR("Error in loading localStorage");
+    sqlite3_finalize(stmt);
+}
+
+// Runs a prepared write statement, returns false on error.
+static bool localStorageStep(sqlite3_stmt *stmt) {
+    int ret = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    return ret == SQLITE_DONE;
+}
+
+// Commits the changes made so far, returns after they are durable.
+// A failed batch is rolled back and retried with the next flush.
+static void localStorageCommit() {
+    std::lock_guard<std::mutex> dbLock(_dbMutex);
+
+    bool clear = false;
+    std::unordered_map<std::string, PendingItem> pending;
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        clear = _pendingClear;
+        _pendingClear = false;
+        pending.swap(_pending);
+    }
+    if (!clear && pending.empty()) {
+        return;
+    }
+
+    // replay the writes in their original order to keep ROWID order in sync with the cache
+    std::vector<const std::pair<const std::string, PendingItem> *> items;
+    items.reserve(pending.size());
+    for (const auto &item : pending) {
+        items.push_back(&item);
+    }
+    std::sort(items.begin(), items.end(), [](const auto *a, const auto *b) { return a->second.order < b->second.order; });
+
+    bool ok = sqlite3_exec(_db, "BEGIN;", nullptr, nullptr, nullptr) == SQLITE_OK;
+    if (ok && clear) {
+        ok = localStorageStep(_stmt_clear);
+    }
+    for (size_t i = 0; ok && i < items.size(); ++i) {
+        const auto *item = items[i];
+        sqlite3_stmt *stmt = item->second.removed ? _stmt_remove : _stmt_update;
+        ok = sqlite3_bind_text(stmt, 1, item->first.c_str(), -1, SQLITE_STATIC) == SQLITE_OK &&
+             (item->second.removed || sqlite3_bind_text(stmt, 2, item->second.value.c_str(), -1, SQLITE_STATIC) == SQLITE_OK) &&
+             localStorageStep(stmt);
+    }
+    ok = ok && sqlite3_exec(_db, "COMMIT;", nullptr, nullptr, nullptr) == SQLITE_OK;
+    if (ok) {
+        return;
+    }
+
+    CC_LOG_ERROR("Error in committing localStorage: %s", sqlite3_errmsg(_db));
+    sqlite3_exec(_db, "ROLLBACK;", nullptr, nullptr, nullptr);
 
-    if (ok != SQLITE_OK && ok != SQLITE_DONE)
-        printf("Error in CREATE TABLE\n");
+    // requeue the batch for the next flush, writes made meanwhile are newer and win
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    if (_pendingClear) {
+        // cleared since, nothing of the batch survives
+        return;
+    }
+    _pendingClear = clear;
+    for (auto &item : pending) {
+        _pending.emplace(item.first, std::move(item.second));
+    }
+}
+
+static void localStorageFlushThread() {
+    std::unique_lock<std::mutex> lock(_flushMutex);
+    while (!_flushThreadExit) {
+        if (_flushInterval > 0.F) {
+            _flushCondition.wait_for(lock, std::chrono::duration<float>(_flushInterval));
+        } else {
+            // only flushed on demand
+            _flushCondition.wait(lock);
+        }
+        lock.unlock();
+        localStorageCommit();
+        lock.lock();
+    }
 }
 
 void localStorageInit(const std::string &fullpath /* = "" */) {
@@ -98,11 +240,10 @@ void localStorageInit(const std::string &fullpath /* = "" */) {
         else
             ret = sqlite3_open(fullpath.c_str(), &_db);
 
-        localStorageCreateTable();
+        // commits append to the write-ahead log instead of rewriting database pages
+        sqlite3_exec(_db, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
 
-        // SELECT
-        const char *sql_select = "SELECT value FROM data WHERE key=?;";
-        ret |= sqlite3_prepare_v2(_db, sql_select, -1, &_stmt_select, nullptr);
+        localStorageCreateTable();
 
         // REPLACE
         const char *sql_update = "REPLACE INTO data (key, value) VALUES (?,?);";
@@ -116,137 +257,127 @@ void localStorageInit(const std::string &fullpath /* = "" */) {
         const char *sql_clear = "DELETE FROM data;";
         ret |= sqlite3_prepare_v2(_db, sql_clear, -1, &_stmt_clear, nullptr);
 
-        // key
-        const char *sql_key = "SELECT key FROM data ORDER BY ROWID ASC;";
-        ret |= sqlite3_prepare_v2(_db, sql_key, -1, &_stmt_key, nullptr);
-
-        //count
-        const char *sql_count = "SELECT COUNT(*) FROM data;";
-        ret |= sqlite3_prepare_v2(_db, sql_count, -1, &_stmt_count, nullptr);
-
         if (ret != SQLITE_OK) {
-            printf("Error initializing DB\n");
+            CC_LOG_ERROR("Error initializing DB");
             // report error
         }
+
+        localStorageLoad();
+
+        _flushThreadExit = false;
+        _flushThread = std::thread(localStorageFlushThread);
         _initialized = 1;
     }
 }
 
 void localStorageFree() {
     if (_initialized) {
-        sqlite3_finalize(_stmt_select);
+        {
+            std::lock_guard<std::mutex> lock(_flushMutex);
+            _flushThreadExit = true;
+        }
+        _flushCondition.notify_one();
+        _flushThread.join();
+        localStorageCommit();
+
         sqlite3_finalize(_stmt_remove);
         sqlite3_finalize(_stmt_update);
+        sqlite3_finalize(_stmt_clear);
 
         sqlite3_close(_db);
 
+        _cache.clear();
+        _keys.clear();
+        _nextOrder = 0;
+
         _initialized = 0;
     }
 }
 
+void localStorageFlush() {
+    if (_initialized) {
+        localStorageCommit();
+    }
+}
+
+void localStorageSetFlushInterval(float seconds) {
+    {
+        std::lock_guard<std::mutex> lock(_flushMutex);
+        _flushInterval = std::max(seconds, 0.F);
+    }
+    _flushCondition.notify_one();
+}
+
 /** sets an item in the LS */
 void localStorageSetItem(const std::string &key, const std::string &value) {
     assert(_initialized);
-    int ok = sqlite3_bind_text(_stmt_update, 1, key.c_str(), -1, SQLITE_TRANSIENT);
-    ok |= sqlite3_bind_text(_stmt_update, 2, value.c_str(), -1, SQLITE_TRANSIENT);
-
-    ok |= sqlite3_step(_stmt_update);
-
-    ok |= sqlite3_reset(_stmt_update);
-
-    if (ok != SQLITE_OK && ok != SQLITE_DONE)
-        printf("Error in localStorage.setItem()\n");
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    uint64_t order = _nextOrder++;
+    auto iter = _cache.find(key);
+    if (iter != _cache.end()) {
+        _keys.erase(iter->second.order);
+        iter->second = {value, order};
+    } else {
+        _cache.emplace(key, CachedItem{value, order});
+    }
+    _keys.emplace(order, key);
+    _pending[key] = {false, value, order};
 }
 
 /** gets an item from the LS */
 bool localStorageGetItem(const std::string &key, std::string *outItem) {
     assert(_initialized);
-    int ok = sqlite3_reset(_stmt_select);
-
-    ok |= sqlite3_bind_text(_stmt_select, 1, key.c_str(), -1, SQLITE_TRANSIENT);
-    ok |= sqlite3_step(_stmt_select);
-    const unsigned char *text = sqlite3_column_text(_stmt_select, 0);
-
-    if (ok != SQLITE_OK && ok != SQLITE_DONE && ok != SQLITE_ROW) {
-        printf("Error in localStorage.getItem()\n");
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    auto iter = _cache.find(key);
+    if (iter == _cache.end()) {
         return false;
-    } else if (!text) {
-        return false;
-    } else {
-        outItem->assign((const char *)text);
-        return true;
     }
+    outItem->assign(iter->second.value);
+    return true;
 }
 
 /** removes an item from the LS */
 void localStorageRemoveItem(const std::string &key) {
     assert(_initialized);
-    int ok = sqlite3_bind_text(_stmt_remove, 1, key.c_str(), -1, SQLITE_TRANSIENT);
-
-    ok |= sqlite3_step(_stmt_remove);
-
-    ok |= sqlite3_reset(_stmt_remove);
-
-    if (ok != SQLITE_OK && ok != SQLITE_DONE)
-        printf("Error in localStorage.removeItem()\n");
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    auto iter = _cache.find(key);
+    if (iter == _cache.end()) {
+        return;
+    }
+    _keys.erase(iter->second.order);
+    _cache.erase(iter);
+    _pending[key] = {true, std::string(), _nextOrder++};
 }
 
 /** removes all items from the LS */
 void localStorageClear() {
     assert(_initialized);
-    int ok = sqlite3_step(_stmt_clear);
-
-    ok |= sqlite3_reset(_stmt_clear);
-
-    if (ok != SQLITE_OK && ok != SQLITE_DONE)
-        printf("Error in localStorage.clear()\n");
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    _cache.clear();
+    _keys.clear();
+    _pending.clear();
+    _pendingClear = true;
 }
 
 /** gets an key from the JS. */
 void localStorageGetKey(const int nIndex, std::string *outKey) {
     assert(_initialized);
     if (nIndex < 0) {
-        printf("Error in input localStorage index Less than zero\n");
+        CC_LOG_ERROR("Error in input localStorage index Less than zero");
         return;
     }
-    int ok = sqlite3_reset(_stmt_key);
-
-    ok |= sqlite3_step(_stmt_key);
-
-    int nCount = 0;
-    const unsigned char *text = nullptr;
-    while (ok == SQLITE_ROW) {
-        if (nCount == nIndex) {
-            text = sqlite3_column_text(_stmt_key, 0);
-            break;
-        }
-
-        ok |= sqlite3_step(_stmt_key);
-        nCount++;
-    }
-
-    if (ok != SQLITE_OK && ok != SQLITE_DONE && ok != SQLITE_ROW) {
-        printf("Error in localStorage.key(n)\n");
-    } else if (!text) {
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    if (static_cast<size_t>(nIndex) >= _keys.size()) {
         return;
-    } else {
-        outKey->assign((const char *)text);
     }
+    outKey->assign(std::next(_keys.begin(), nIndex)->second);
 }
 
 /** gets all items count in the JS. */
 void localStorageGetLength(int &outLength) {
     assert(_initialized);
-    int ok = sqlite3_reset(_stmt_count);
-
-    ok |= sqlite3_step(_stmt_count);
-
-    if (ok != SQLITE_OK && ok != SQLITE_DONE && ok != SQLITE_ROW) {
-        printf("Error in localStorage.length\n");
-        outLength = 0;
-    } else {
-        outLength = sqlite3_column_int(_stmt_count, 0);
-    }
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    outLength = static_cast<int>(_cache.size());
 }
 
 #endif // #if (CC_PLATFORM != CC_PLATFORM_ANDROID)
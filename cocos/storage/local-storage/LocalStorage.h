@@ -41,9 +41,15 @@
 /** Initializes the database. If path is null, it will create an in-memory DB. */
 void CC_DLL localStorageInit(const std::string &fullpath = "");
 
-/** Frees the allocated resources. */
+/** Frees the allocated resources, pending changes are written first. */
 void CC_DLL localStorageFree();
 
+/** Writes the pending changes to the database, returns once they are durable. */
+void CC_DLL localStorageFlush();
+
+/** Sets how often pending changes are written in the background, 0 to only write on localStorageFlush(). Defaults to 1 second. */
+void CC_DLL localStorageSetFlushInterval(float seconds);
+
 /** Sets an item in the JS. */
 void CC_DLL localStorageSetItem(const std::string &key, const std::string &value);
 
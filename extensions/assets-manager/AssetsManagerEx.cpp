@@ -27,17 +27,16 @@
 
 #include <stdio.h>
 #include <errno.h>
+#include <algorithm>
+#if CC_PLATFORM != CC_PLATFORM_WINDOWS
+    #include <unistd.h>
+#endif
 
 #include "base/UTF8.h"
 #include "AsyncTaskPool.h"
+#include "ZipExtractor.h"
 #include "base/Log.h"
 
-#ifdef MINIZIP_FROM_SYSTEM
-    #include <minizip/unzip.h>
-#else // from our embedded sources
-    #include "unzip/unzip.h"
-#endif
-
 NS_CC_EXT_BEGIN
 
 #define VERSION_FILENAME       "version.manifest"
@@ -45,9 +44,6 @@ NS_CC_EXT_BEGIN
 #define TEMP_PACKAGE_SUFFIX    "_temp"
 #define MANIFEST_FILENAME      "project.manifest"
 
-#define BUFFER_SIZE  8192
-#define MAX_FILENAME 512
-
 #define DEFAULT_CONNECTION_TIMEOUT 45
 
 #define SAVE_POINT_INTERVAL 0.1
@@ -55,6 +51,40 @@ NS_CC_EXT_BEGIN
 const std::string AssetsManagerEx::VERSION_ID = "@version";
 const std::string AssetsManagerEx::MANIFEST_ID = "@manifest";
 
+namespace {
+// Manifests may carry any version tag in the md5 field, only real digests are used to verify and deduplicate content.
+bool isMD5Digest(const std::string &md5) {
+    return md5.length() == 32 && md5.find_first_not_of("0123456789abcdefABCDEF") == std::string::npos;
+}
+
+bool linkOrCopyFile(FileUtils *fileUtils, const std::string &from, const std::string &to) {
+    if (fileUtils->isFileExist(to)) {
+        fileUtils->removeFile(to);
+    }
+#if CC_PLATFORM != CC_PLATFORM_WINDOWS
+    if (0 == link(fileUtils->getSuitableFOpen(from).c_str(), fileUtils->getSuitableFOpen(to).c_str())) {
+        return true;
+    }
+#endif
+    FILE *src = fopen(fileUtils->getSuitableFOpen(from).c_str(), "rb");
+    if (!src) {
+        return false;
+    }
+    FILE *dst = fopen(fileUtils->getSuitableFOpen(to).c_str(), "wb");
+    bool ok = dst != nullptr;
+    char buffer[8192];
+    size_t size = 0;
+    while (ok && (size = fread(buffer, 1, sizeof(buffer), src)) > 0) {
+        ok = fwrite(buffer, 1, size, dst) == size;
+    }
+    fclose(src);
+    if (dst) {
+        ok = (0 == fclose(dst)) && ok;
+    }
+    return ok;
+}
+} // namespace
+
 // Implementation of AssetsManagerEx
 
 AssetsManagerEx::AssetsManagerEx(const std::string &manifestUrl, const std::string &storagePath) {
@@ -367,7 +397,7 @@ void AssetsManagerEx::adjustPath(std::string &path) {
     }
 }
 
-bool AssetsManagerEx::decompress(const std::string &zip) {
+bool AssetsManagerEx::decompress(const std::string &zip, const std::unordered_map<std::string, std::string> &expectedMD5s) {
     // Find root path for zip file
     size_t pos = zip.find_last_of("/\\");
     if (pos == std::string::npos) {
@@ -376,115 +406,30 @@ bool AssetsManagerEx::decompress(const std::string &zip) {
     }
     const std::string rootPath = zip.substr(0, pos + 1);
 
-    // Open the zip file
-    unzFile zipfile = unzOpen(FileUtils::getInstance()->getSuitableFOpen(zip).c_str());
-    if (!zipfile) {
-        CC_LOG_DEBUG("AssetsManagerEx : can not open downloaded zip file %s\n", zip.c_str());
-        return false;
-    }
-
-    // Get info about the zip file
-    unz_global_info global_info;
-    if (unzGetGlobalInfo(zipfile, &global_info) != UNZ_OK) {
-        CC_LOG_DEBUG("AssetsManagerEx : can not read file global info of %s\n", zip.c_str());
-        unzClose(zipfile);
-        return false;
-    }
-
-    // Buffer to hold data read from the zip file
-    char readBuffer[BUFFER_SIZE];
-    // Loop to extract all files.
-    uLong i;
-    for (i = 0; i < global_info.number_entry; ++i) {
-        // Get info about current file.
-        unz_file_info fileInfo;
-        char fileName[MAX_FILENAME];
-        if (unzGetCurrentFileInfo(zipfile,
-                                  &fileInfo,
-                                  fileName,
-                                  MAX_FILENAME,
-                                  NULL,
-                                  0,
-                                  NULL,
-                                  0) != UNZ_OK) {
-            CC_LOG_DEBUG("AssetsManagerEx : can not read compressed file info\n");
-            unzClose(zipfile);
-            return false;
-        }
-        const std::string fullPath = rootPath + fileName;
-
-        // Check if this entry is a directory or a file.
-        const size_t filenameLength = strlen(fileName);
-        if (fileName[filenameLength - 1] == '/') {
-            //There are not directory entry in some case.
-            //So we need to create directory when decompressing file entry
-            if (!_fileUtils->createDirectory(basename(fullPath))) {
-                // Failed to create directory
-                CC_LOG_DEBUG("AssetsManagerEx : can not create directory %s\n", fullPath.c_str());
-                unzClose(zipfile);
-                return false;
-            }
-        } else {
-            // Create all directories in advance to avoid issue
-            std::string dir = basename(fullPath);
-            if (!_fileUtils->isDirectoryExist(dir)) {
-                if (!_fileUtils->createDirectory(dir)) {
-                    // Failed to create directory
-                    CC_LOG_DEBUG("AssetsManagerEx : can not create directory %s\n", fullPath.c_str());
-                    unzClose(zipfile);
-                    return false;
-                }
-            }
-            // Entry is a file, so extract it.
-            // Open current file.
-            if (unzOpenCurrentFile(zipfile) != UNZ_OK) {
-                CC_LOG_DEBUG("AssetsManagerEx : can not extract file %s\n", fileName);
-                unzClose(zipfile);
-                return false;
-            }
-
-            // Create a file to store current file.
-            FILE *out = fopen(FileUtils::getInstance()->getSuitableFOpen(fullPath).c_str(), "wb");
-            if (!out) {
-                CC_LOG_DEBUG("AssetsManagerEx : can not create decompress destination file %s (errno: %d)\n", fullPath.c_str(), errno);
-                unzCloseCurrentFile(zipfile);
-                unzClose(zipfile);
-                return false;
-            }
-
-            // Write current file content to destinate file.
-            int error = UNZ_OK;
-            do {
-                error = unzReadCurrentFile(zipfile, readBuffer, BUFFER_SIZE);
-                if (error < 0) {
-                    CC_LOG_DEBUG("AssetsManagerEx : can not read zip file %s, error code is %d\n", fileName, error);
-                    fclose(out);
-                    unzCloseCurrentFile(zipfile);
-                    unzClose(zipfile);
-                    return false;
-                }
-
-                if (error > 0) {
-                    fwrite(readBuffer, error, 1, out);
-                }
-            } while (error > 0);
-
-            fclose(out);
+    ZipExtractor::Options options;
+    if (!expectedMD5s.empty()) {
+        // entries are keyed by their path relative to the temporary storage, as the assets of the manifest
+        const std::string prefix = rootPath.compare(0, _tempStoragePath.size(), _tempStoragePath) == 0 ? rootPath.substr(_tempStoragePath.size()) : "";
+        options.expectedMD5      = [&expectedMD5s, prefix](const std::string &entryName) {
+            auto it = expectedMD5s.find(prefix + entryName);
+            return it != expectedMD5s.end() ? it->second : std::string();
+        };
+    }
+
+    // Only the byte counters are updated, they are polled through getDecompressedBytes
+    std::atomic<bool> totalCollected{false};
+    options.onProgress = [&](uint64_t bytesExtracted, uint64_t /*totalBytesExtracted*/, uint64_t totalBytesExpected) {
+        if (!totalCollected.exchange(true)) {
+            _totalDecompressBytes.fetch_add(totalBytesExpected, std::memory_order_relaxed);
         }
+        _decompressedBytes.fetch_add(bytesExtracted, std::memory_order_relaxed);
+    };
 
-        unzCloseCurrentFile(zipfile);
-
-        // Goto next entry listed in the zip file.
-        if ((i + 1) < global_info.number_entry) {
-            if (unzGoToNextFile(zipfile) != UNZ_OK) {
-                CC_LOG_DEBUG("AssetsManagerEx : can not read next file for decompressing\n");
-                unzClose(zipfile);
-                return false;
-            }
-        }
+    std::string error;
+    if (!ZipExtractor::extract(zip, rootPath, options, &error)) {
+        CC_LOG_DEBUG("AssetsManagerEx : can not decompress %s: %s\n", zip.c_str(), error.c_str());
+        return false;
     }
-
-    unzClose(zipfile);
     return true;
 }
 
@@ -500,6 +445,18 @@ void AssetsManagerEx::decompressDownloadedZip(const std::string &customId, const
     asyncData->zipFile = storagePath;
     asyncData->succeed = false;
 
+    // Collect the digests of the manifest assets, the extracted files are verified against them.
+    // Verification is opt-in as for downloaded files, and md5 may hold any version tag.
+    std::unordered_map<std::string, std::string> expectedMD5s;
+    if (_remoteManifest && _verifyCallback != nullptr) {
+        for (const auto &it : _remoteManifest->getAssets()) {
+            const Manifest::Asset &asset = it.second;
+            if (!asset.compressed && isMD5Digest(asset.md5)) {
+                expectedMD5s.emplace(asset.path, asset.md5);
+            }
+        }
+    }
+
     std::function<void(void *)> decompressFinished = [this](void *param) {
         auto dataInner = reinterpret_cast<AsyncData *>(param);
         if (dataInner->succeed) {
@@ -513,9 +470,9 @@ void AssetsManagerEx::decompressDownloadedZip(const std::string &customId, const
         }
         delete dataInner;
     };
-    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_OTHER, decompressFinished, (void *)asyncData, [this, asyncData]() {
+    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_OTHER, decompressFinished, (void *)asyncData, [this, asyncData, expectedMD5s]() {
         // Decompress all compressed files
-        if (decompress(asyncData->zipFile)) {
+        if (decompress(asyncData->zipFile, expectedMD5s)) {
             asyncData->succeed = true;
         }
         _fileUtils->removeFile(asyncData->zipFile);
@@ -707,6 +664,7 @@ void AssetsManagerEx::prepareUpdate() {
                     unit.customId = it->first;
                     unit.srcUrl = packageUrl + path + "?md5=" + diff.asset.md5;
                     unit.storagePath = _tempStoragePath + path;
+                    unit.md5 = diff.asset.md5;
                     unit.size = diff.asset.size;
                     _downloadUnits.emplace(unit.customId, unit);
                     _tempManifest->setAssetDownloadState(it->first, Manifest::DownloadState::UNSTARTED);
@@ -981,6 +939,32 @@ void AssetsManagerEx::fileSuccess(const std::string &customId, const std::string
     queueDowload();
 }
 
+void AssetsManagerEx::resolveDuplicates(const std::string &customId, const std::string &storagePath, bool succeeded) {
+    auto dupIt = _duplicateUnits.find(customId);
+    if (dupIt == _duplicateUnits.end()) {
+        return;
+    }
+    std::vector<std::string> duplicates = std::move(dupIt->second);
+    _duplicateUnits.erase(dupIt);
+
+    for (const auto &id : duplicates) {
+        auto unitIt = _downloadUnits.find(id);
+        if (unitIt == _downloadUnits.end()) {
+            continue;
+        }
+        const std::string &path = unitIt->second.storagePath;
+        // duplicates go through the regular bookkeeping as if they were in flight
+        _currConcurrentTask++;
+        if (!succeeded) {
+            fileError(id, "The asset sharing its content failed to download");
+        } else if (_fileUtils->createDirectory(basename(path)) && linkOrCopyFile(_fileUtils, storagePath, path)) {
+            fileSuccess(id, path);
+        } else {
+            fileError(id, "Fail to copy the asset sharing its content from " + storagePath);
+        }
+    }
+}
+
 void AssetsManagerEx::onError(const network::DownloadTask &task,
                               int errorCode,
                               int errorCodeInternal,
@@ -994,6 +978,7 @@ void AssetsManagerEx::onError(const network::DownloadTask &task,
         dispatchUpdateEvent(EventAssetsManagerEx::EventCode::ERROR_DOWNLOAD_MANIFEST, task.identifier, errorStr, errorCode, errorCodeInternal);
         _updateState = State::FAIL_TO_UPDATE;
     } else {
+        resolveDuplicates(task.identifier, "", false);
         fileError(task.identifier, errorStr, errorCode, errorCodeInternal);
     }
 }
@@ -1067,9 +1052,11 @@ void AssetsManagerEx::onSuccess(const std::string & /*srcUrl*/, const std::strin
             if (compressed) {
                 decompressDownloadedZip(customId, storagePath);
             } else {
+                resolveDuplicates(customId, storagePath, true);
                 fileSuccess(customId, storagePath);
             }
         } else {
+            resolveDuplicates(customId, storagePath, false);
             fileError(customId, "Asset file verification failed after downloaded");
         }
     }
@@ -1082,8 +1069,25 @@ void AssetsManagerEx::destroyDownloadedVersion() {
 
 void AssetsManagerEx::batchDownload() {
     _queue.clear();
+    _duplicateUnits.clear();
+    // content digest -> unit downloading it
+    std::unordered_map<std::string, std::string> contentUnits;
+    auto &assets = _remoteManifest->getAssets();
     for (auto iter : _downloadUnits) {
         const DownloadUnit &unit = iter.second;
+        auto assetIt = assets.find(unit.customId);
+        bool compressed = assetIt != assets.end() && assetIt->second.compressed;
+        if (!compressed && isMD5Digest(unit.md5)) {
+            std::string md5 = unit.md5;
+            std::transform(md5.begin(), md5.end(), md5.begin(), ::tolower);
+            auto contentIt = contentUnits.emplace(md5, unit.customId);
+            if (!contentIt.second) {
+                // never reports progress, count it as collected without its size
+                _duplicateUnits[contentIt.first->second].push_back(unit.customId);
+                _sizeCollected++;
+                continue;
+            }
+        }
         if (unit.size > 0) {
             _totalSize += unit.size;
             _sizeCollected++;
@@ -1112,7 +1116,9 @@ void AssetsManagerEx::queueDowload() {
         _currConcurrentTask++;
         DownloadUnit &unit = _downloadUnits[key];
         _fileUtils->createDirectory(basename(unit.storagePath));
-        _downloader->createDownloadFileTask(unit.srcUrl, unit.storagePath, unit.customId);
+        // A verify callback replaces the digest check, otherwise the downloader compares the received bytes with it.
+        bool checkMD5 = _verifyCallback == nullptr && isMD5Digest(unit.md5);
+        _downloader->createDownloadFileTask(unit.srcUrl, unit.storagePath, unit.customId, checkMD5 ? unit.md5 : "");
 
         _tempManifest->setAssetDownloadState(key, Manifest::DownloadState::DOWNLOADING);
     }
@@ -27,6 +27,7 @@
 #ifndef __AssetsManagerEx__
 #define __AssetsManagerEx__
 
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -180,6 +181,18 @@ public:
         return _totalToDownload - _totalWaitToDownload;
     };
 
+    /** @brief Gets the byte size already extracted from the downloaded compressed assets, it's updated during the UNZIPPING of each package.
+     */
+    double getDecompressedBytes() const {
+        return static_cast<double>(_decompressedBytes.load(std::memory_order_relaxed));
+    };
+
+    /** @brief Gets the total uncompressed byte size of the compressed assets extracted or being extracted.
+     */
+    double getTotalDecompressBytes() const {
+        return static_cast<double>(_totalDecompressBytes.load(std::memory_order_relaxed));
+    };
+
     /** @brief Function for retrieving the max concurrent task count
      */
     const int getMaxConcurrentTask() const {
@@ -201,6 +214,8 @@ public:
 
     /** @brief Set the verification function for checking whether downloaded asset is correct, e.g. using md5 verification
      * @param callback  The verify callback function
+     * @note Assets with a md5 digest in the manifest are already verified while downloading on platforms
+     * where the downloader supports it, the callback is skipped for them.
      */
     void setVerifyCallback(const VerifyCallback &callback) {
         _verifyCallback = callback;
@@ -236,7 +251,7 @@ protected:
     void parseManifest();
     void startUpdate();
     void updateSucceed();
-    bool decompress(const std::string &filename);
+    bool decompress(const std::string &filename, const std::unordered_map<std::string, std::string> &expectedMD5s = {});
     void decompressDownloadedZip(const std::string &customId, const std::string &storagePath);
 
     /** @brief Update a list of assets under the current AssetsManagerEx context
@@ -259,6 +274,10 @@ protected:
 
     void fileSuccess(const std::string &customId, const std::string &storagePath);
 
+    /** @brief Finish the units sharing the content of customId, by linking or copying its downloaded file
+     */
+    void resolveDuplicates(const std::string &customId, const std::string &storagePath, bool succeeded);
+
     /** @brief  Call back function for error handling,
      the error will then be reported to user's listener registed in addUpdateEventListener
      @param error   The error object contains ErrorCode, message, asset url, asset key
@@ -361,6 +380,9 @@ private:
     //! Download queue
     std::vector<std::string> _queue;
 
+    //! Units with the same content as the key unit, they are not downloaded but resolved from it
+    std::unordered_map<std::string, std::vector<std::string>> _duplicateUnits;
+
     bool _downloadResumed = false;
 
     //! Max concurrent task count for downloading
@@ -390,6 +412,11 @@ private:
     //! Downloaded size for each file
     std::unordered_map<std::string, double> _downloadedSize;
 
+    //! Bytes extracted from compressed assets, written by the decompressing threads
+    std::atomic<uint64_t> _decompressedBytes{0};
+    //! Total uncompressed size of the compressed assets
+    std::atomic<uint64_t> _totalDecompressBytes{0};
+
     //! Total number of assets to download
     int _totalToDownload = 0;
     //! Total number of assets still waiting to be downloaded
@@ -292,6 +292,7 @@ void Manifest::genResumeAssetsList(DownloadUnits *units) const {
             unit.customId = it->first;
             unit.srcUrl = _packageUrl + asset.path;
             unit.storagePath = _manifestRoot + asset.path;
+            unit.md5 = asset.md5;
             unit.size = asset.size;
             units->emplace(unit.customId, unit);
         }
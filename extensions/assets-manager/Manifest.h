@@ -45,6 +45,7 @@ struct DownloadUnit {
     std::string srcUrl;
     std::string storagePath;
     std::string customId;
+    std::string md5;
     float size;
 };
 
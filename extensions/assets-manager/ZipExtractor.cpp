@@ -0,0 +1,264 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "ZipExtractor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "base/Log.h"
+#include "base/UTF8.h"
+#include "base/md5.h"
+#include "platform/FileUtils.h"
+
+#ifdef MINIZIP_FROM_SYSTEM
+    #include <minizip/unzip.h>
+#else // from our embedded sources
+    #include "unzip/unzip.h"
+#endif
+
+#if (CC_PLATFORM != CC_PLATFORM_WINDOWS)
+    #include <fcntl.h>
+#endif
+
+NS_CC_EXT_BEGIN
+
+namespace {
+
+constexpr uint32_t MAX_FILENAME = 512;
+// zlib inflate state and minizip's read buffer, per worker
+constexpr size_t WORKER_OVERHEAD = 64 * 1024;
+
+struct ZipEntry {
+    std::string name;
+    unz_file_pos pos;
+    uint64_t uncompressedSize;
+};
+
+struct ExtractState {
+    const std::string *zipPath;
+    const std::string *destDir;
+    const ZipExtractor::Options *options;
+    std::vector<ZipEntry> entries;
+    uint64_t totalBytes = 0;
+    std::atomic<size_t> next{0};
+    std::atomic<uint64_t> extractedBytes{0};
+    std::atomic<bool> failed{false};
+    std::mutex errorMutex;
+    std::string error;
+
+    void fail(const std::string &message) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!failed.exchange(true)) {
+            error = message;
+            CC_LOG_DEBUG("ZipExtractor : %s\n", message.c_str());
+        }
+    }
+};
+
+void preallocateFile(FILE *fp, uint64_t size) {
+    if (size == 0) return;
+#if (CC_PLATFORM == CC_PLATFORM_MAC_IOS || CC_PLATFORM == CC_PLATFORM_MAC_OSX)
+    fstore_t store = {F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, static_cast<off_t>(size), 0};
+    if (fcntl(fileno(fp), F_PREALLOCATE, &store) == -1) {
+        store.fst_flags = F_ALLOCATEALL;
+        fcntl(fileno(fp), F_PREALLOCATE, &store);
+    }
+#elif (CC_PLATFORM != CC_PLATFORM_WINDOWS)
+    posix_fallocate(fileno(fp), 0, static_cast<off_t>(size));
+#else
+    (void)fp;
+#endif
+}
+
+bool extractEntry(ExtractState *state, unzFile zipFile, const ZipEntry &entry, std::vector<char> *buffer) {
+    const std::string fullPath = *state->destDir + entry.name;
+    if (unzGoToFilePos(zipFile, const_cast<unz_file_pos *>(&entry.pos)) != UNZ_OK || unzOpenCurrentFile(zipFile) != UNZ_OK) {
+        state->fail("can not extract file " + entry.name);
+        return false;
+    }
+
+    FILE *out = fopen(FileUtils::getInstance()->getSuitableFOpen(fullPath).c_str(), "wb");
+    if (!out) {
+        state->fail(StringUtils::format("can not create decompress destination file %s (errno: %d)", fullPath.c_str(), errno));
+        unzCloseCurrentFile(zipFile);
+        return false;
+    }
+    if (state->options->preallocate) preallocateFile(out, entry.uncompressedSize);
+
+    const std::string expectedMD5 = state->options->expectedMD5 ? state->options->expectedMD5(entry.name) : std::string();
+    MD5 md5;
+    bool ok = true;
+    int read;
+    while ((read = unzReadCurrentFile(zipFile, buffer->data(), static_cast<unsigned>(buffer->size()))) > 0) {
+        if (fwrite(buffer->data(), read, 1, out) != 1) {
+            state->fail("can not write file " + fullPath);
+            ok = false;
+            break;
+        }
+        if (!expectedMD5.empty()) md5.update(buffer->data(), read);
+
+        const uint64_t extracted = state->extractedBytes.fetch_add(read) + read;
+        if (state->options->onProgress) state->options->onProgress(read, extracted, state->totalBytes);
+        if (state->failed.load(std::memory_order_relaxed)) {
+            ok = false;
+            break;
+        }
+    }
+    fclose(out);
+
+    if (ok && read < 0) {
+        state->fail(StringUtils::format("can not read zip file %s, error code is %d", entry.name.c_str(), read));
+        ok = false;
+    }
+    // minizip checks the CRC32 of the entry on close once all of it has been read
+    if (unzCloseCurrentFile(zipFile) == UNZ_CRCERROR && ok) {
+        state->fail("CRC mismatch in " + entry.name);
+        ok = false;
+    }
+    if (ok && !expectedMD5.empty() && !md5Equals(md5.finish(), expectedMD5)) {
+        state->fail("MD5 mismatch in " + entry.name);
+        ok = false;
+    }
+    return ok;
+}
+
+void extractWorker(ExtractState *state) {
+    unzFile zipFile = unzOpen(FileUtils::getInstance()->getSuitableFOpen(*state->zipPath).c_str());
+    if (!zipFile) {
+        state->fail("can not open zip file " + *state->zipPath);
+        return;
+    }
+
+    std::vector<char> buffer(state->options->chunkSize);
+    size_t index;
+    while (!state->failed.load(std::memory_order_relaxed) && (index = state->next.fetch_add(1)) < state->entries.size()) {
+        if (!extractEntry(state, zipFile, state->entries[index], &buffer)) break;
+    }
+    unzClose(zipFile);
+}
+
+// Reads the central directory, creates the directories and collects the file entries.
+bool readCentralDirectory(ExtractState *state) {
+    unzFile zipFile = unzOpen(FileUtils::getInstance()->getSuitableFOpen(*state->zipPath).c_str());
+    if (!zipFile) {
+        state->fail("can not open downloaded zip file " + *state->zipPath);
+        return false;
+    }
+
+    unz_global_info globalInfo;
+    if (unzGetGlobalInfo(zipFile, &globalInfo) != UNZ_OK) {
+        state->fail("can not read file global info of " + *state->zipPath);
+        unzClose(zipFile);
+        return false;
+    }
+
+    std::set<std::string> directories;
+    state->entries.reserve(globalInfo.number_entry);
+    for (uLong i = 0; i < globalInfo.number_entry; ++i) {
+        unz_file_info fileInfo;
+        char fileName[MAX_FILENAME];
+        ZipEntry entry;
+        if (unzGetCurrentFileInfo(zipFile, &fileInfo, fileName, MAX_FILENAME, nullptr, 0, nullptr, 0) != UNZ_OK ||
+            unzGetFilePos(zipFile, &entry.pos) != UNZ_OK) {
+            state->fail("can not read compressed file info");
+            unzClose(zipFile);
+            return false;
+        }
+
+        entry.name = fileName;
+        if (!entry.name.empty()) {
+            // There are not directory entries in some case, so the directory of every file is created too
+            const bool isDirectory = entry.name.back() == '/';
+            const size_t slash     = entry.name.find_last_of('/');
+            if (slash != std::string::npos) directories.insert(entry.name.substr(0, slash + 1));
+            if (!isDirectory) {
+                entry.uncompressedSize = fileInfo.uncompressed_size;
+                state->totalBytes += entry.uncompressedSize;
+                state->entries.push_back(std::move(entry));
+            }
+        }
+
+        if (i + 1 < globalInfo.number_entry && unzGoToNextFile(zipFile) != UNZ_OK) {
+            state->fail("can not read next file for decompressing");
+            unzClose(zipFile);
+            return false;
+        }
+    }
+    unzClose(zipFile);
+
+    FileUtils *fileUtils = FileUtils::getInstance();
+    for (const auto &dir : directories) {
+        const std::string fullPath = *state->destDir + dir;
+        if (!fileUtils->isDirectoryExist(fullPath) && !fileUtils->createDirectory(fullPath)) {
+            state->fail("can not create directory " + fullPath);
+            return false;
+        }
+    }
+
+    // largest first so the long entries don't end up alone at the tail
+    std::sort(state->entries.begin(), state->entries.end(), [](const ZipEntry &a, const ZipEntry &b) {
+        return a.uncompressedSize > b.uncompressedSize;
+    });
+    return true;
+}
+
+} // namespace
+
+bool ZipExtractor::extract(const std::string &zipPath, const std::string &destDir, const Options &options, std::string *error) {
+    ExtractState state;
+    state.zipPath = &zipPath;
+    state.destDir = &destDir;
+    state.options = &options;
+
+    if (readCentralDirectory(&state) && !state.entries.empty()) {
+        uint32_t threadCount = options.threadCount;
+        if (threadCount == 0) threadCount = std::max(2U, std::thread::hardware_concurrency()) - 1;
+        const size_t budgetThreads = std::max<size_t>(1, options.memoryBudget / (options.chunkSize + WORKER_OVERHEAD));
+        threadCount                = static_cast<uint32_t>(std::min({static_cast<size_t>(threadCount), budgetThreads, state.entries.size()}));
+
+        // the calling thread works too
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (uint32_t i = 1; i < threadCount; ++i) {
+            workers.emplace_back(extractWorker, &state);
+        }
+        extractWorker(&state);
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    if (state.failed && error) *error = state.error;
+    return !state.failed;
+}
+
+NS_CC_EXT_END
@@ -0,0 +1,64 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "extensions/ExtensionExport.h"
+#include "extensions/ExtensionMacros.h"
+
+NS_CC_EXT_BEGIN
+
+/**
+ * Extracts a zip archive with a pool of worker threads.
+ *
+ * The central directory is read once, then entries are inflated concurrently, largest first,
+ * each worker streaming its entry to disk in fixed size chunks, so the memory in use is bounded
+ * by the number of workers times the chunk size. Output files are preallocated where the
+ * platform supports it. Every entry is checked against its CRC32, and against an MD5 when
+ * expectedMD5 provides one.
+ */
+class CC_EX_DLL ZipExtractor final {
+public:
+    struct Options {
+        // 0 picks one thread per core, minus the calling thread's core
+        uint32_t threadCount = 0;
+        // upper bound of the extraction buffers in use at the same time
+        size_t memoryBudget = 32 * 1024 * 1024;
+        size_t chunkSize    = 256 * 1024;
+        bool preallocate    = true;
+        // returns the expected MD5 of an entry (hex), or an empty string to skip the check
+        std::function<std::string(const std::string &entryName)> expectedMD5;
+        // invoked from worker threads after every chunk written, like Downloader::onTaskProgress
+        std::function<void(uint64_t bytesExtracted, uint64_t totalBytesExtracted, uint64_t totalBytesExpected)> onProgress;
+    };
+
+    // Extracts zipPath into destDir (ending with '/'), returns false and fills error on failure.
+    static bool extract(const std::string &zipPath, const std::string &destDir, const Options &options, std::string *error = nullptr);
+};
+
+NS_CC_EXT_END
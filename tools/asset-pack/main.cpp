@@ -0,0 +1,274 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <zlib.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cocos/base/ZipUtils.h"
+#include "cocos/platform/AssetPack.h"
+#include "cocos/platform/FileUtils.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// entries at least this large are page aligned so they can be mapped and read without straddling pages
+constexpr uint64_t PAGE_ALIGNMENT_THRESHOLD = 64U * 1024U;
+// compressed data is only kept when it saves at least this much
+constexpr double MIN_COMPRESSION_RATIO = 0.9;
+
+struct PackInput {
+    std::string name;
+    std::vector<unsigned char> data;
+    uint64_t rawSize{0};
+    cc::AssetPackCompression compression{cc::AssetPackCompression::STORED};
+    cc::AssetPackEntry entry;
+};
+
+bool readFile(const fs::path &path, std::vector<unsigned char> *data) {
+    FILE *fp = fopen(path.string().c_str(), "rb");
+    if (!fp) return false;
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    data->resize(size > 0 ? static_cast<size_t>(size) : 0U);
+    size_t read = data->empty() ? 0U : fread(data->data(), 1, data->size(), fp);
+    fclose(fp);
+    return read == data->size();
+}
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+int pack(const fs::path &inputDir, const std::string &output, bool deflate) {
+    std::vector<PackInput> inputs;
+    for (const auto &it : fs::recursive_directory_iterator(inputDir)) {
+        if (!it.is_regular_file()) continue;
+
+        PackInput input;
+        input.name = fs::relative(it.path(), inputDir).generic_string();
+        if (!readFile(it.path(), &input.data)) {
+            fprintf(stderr, "failed to read %s\n", it.path().string().c_str());
+            return 1;
+        }
+        input.rawSize = input.data.size();
+
+        if (deflate && !input.data.empty()) {
+            uLongf compressedSize = compressBound(static_cast<uLong>(input.data.size()));
+            std::vector<unsigned char> compressed(compressedSize);
+            if (compress2(compressed.data(), &compressedSize, input.data.data(), static_cast<uLong>(input.data.size()), Z_BEST_COMPRESSION) == Z_OK &&
+                compressedSize < input.data.size() * MIN_COMPRESSION_RATIO) {
+                compressed.resize(compressedSize);
+                input.data.swap(compressed);
+                input.compression = cc::AssetPackCompression::DEFLATE;
+            }
+        }
+
+        input.entry.hash = cc::AssetPack::hashPath(input.name.data(), input.name.size());
+        inputs.push_back(std::move(input));
+    }
+
+    std::sort(inputs.begin(), inputs.end(), [](const PackInput &lhs, const PackInput &rhs) {
+        return lhs.entry.hash < rhs.entry.hash || (lhs.entry.hash == rhs.entry.hash && lhs.name < rhs.name);
+    });
+
+    cc::AssetPackHeader header;
+    header.entryCount = static_cast<uint32_t>(inputs.size());
+    while (header.bucketBits < 24U && (1U << header.bucketBits) < header.entryCount) ++header.bucketBits;
+
+    const uint32_t bucketCount = 1U << header.bucketBits;
+    std::vector<uint32_t> buckets(bucketCount + 1, header.entryCount);
+    for (uint32_t i = header.entryCount; i-- > 0;) {
+        uint64_t bucket = header.bucketBits ? inputs[i].entry.hash >> (64U - header.bucketBits) : 0U;
+        buckets[bucket] = i;
+    }
+    // empty buckets start where the next non-empty one does
+    for (uint32_t b = bucketCount; b-- > 0;) {
+        buckets[b] = std::min(buckets[b], buckets[b + 1]);
+    }
+
+    std::string names;
+    for (auto &input : inputs) {
+        input.entry.nameOffset = static_cast<uint32_t>(names.size());
+        input.entry.nameLength = static_cast<uint32_t>(input.name.size());
+        names += input.name;
+    }
+
+    header.bucketOffset = sizeof(cc::AssetPackHeader);
+    header.entryOffset = alignUp(header.bucketOffset + buckets.size() * sizeof(uint32_t), alignof(cc::AssetPackEntry));
+    header.nameOffset = header.entryOffset + inputs.size() * sizeof(cc::AssetPackEntry);
+    header.nameSize = names.size();
+
+    uint64_t offset = header.nameOffset + header.nameSize;
+    for (auto &input : inputs) {
+        offset = alignUp(offset, input.data.size() >= PAGE_ALIGNMENT_THRESHOLD ? cc::ASSET_PACK_PAGE_ALIGNMENT : cc::ASSET_PACK_ALIGNMENT);
+        input.entry.offset = offset;
+        input.entry.size = input.data.size();
+        input.entry.rawSize = input.rawSize;
+        input.entry.compression = input.compression;
+        offset += input.data.size();
+    }
+
+    FILE *fp = fopen(output.c_str(), "wb");
+    if (!fp) {
+        fprintf(stderr, "failed to open %s\n", output.c_str());
+        return 1;
+    }
+
+    std::vector<unsigned char> image(offset, 0);
+    memcpy(image.data(), &header, sizeof(header));
+    memcpy(image.data() + header.bucketOffset, buckets.data(), buckets.size() * sizeof(uint32_t));
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        memcpy(image.data() + header.entryOffset + i * sizeof(cc::AssetPackEntry), &inputs[i].entry, sizeof(cc::AssetPackEntry));
+        if (!inputs[i].data.empty()) memcpy(image.data() + inputs[i].entry.offset, inputs[i].data.data(), inputs[i].data.size());
+    }
+    if (!names.empty()) memcpy(image.data() + header.nameOffset, names.data(), names.size());
+
+    bool succeeded = fwrite(image.data(), 1, image.size(), fp) == image.size();
+    fclose(fp);
+    fprintf(stderr, "%u entries, %llu bytes\n", header.entryCount, static_cast<unsigned long long>(image.size()));
+    return succeeded ? 0 : 1;
+}
+
+int list(const std::string &path) {
+    std::unique_ptr<cc::AssetPack> pack(cc::AssetPack::open(path));
+    if (!pack) {
+        fprintf(stderr, "failed to open %s\n", path.c_str());
+        return 1;
+    }
+
+    printf("name,offset,size,raw_size,compression\n");
+    for (uint32_t i = 0; i < pack->getEntryCount(); ++i) {
+        const cc::AssetPackEntry &entry = pack->getEntry(i);
+        printf("%s,%llu,%llu,%llu,%u\n", pack->getEntryName(entry).c_str(), static_cast<unsigned long long>(entry.offset),
+               static_cast<unsigned long long>(entry.size), static_cast<unsigned long long>(entry.rawSize), static_cast<uint32_t>(entry.compression));
+    }
+    return 0;
+}
+
+template <typename Func>
+double measure(uint32_t iterations, Func &&func) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Compares open + read latency of every pack entry against the same files loose on disk and in a zip.
+int bench(const std::string &packPath, const fs::path &looseDir, const std::string &zipPath, uint32_t iterations) {
+    std::unique_ptr<cc::AssetPack> pack(cc::AssetPack::open(packPath));
+    if (!pack) {
+        fprintf(stderr, "failed to open %s\n", packPath.c_str());
+        return 1;
+    }
+
+    std::vector<std::string> names;
+    for (uint32_t i = 0; i < pack->getEntryCount(); ++i) names.push_back(pack->getEntryName(pack->getEntry(i)));
+
+    std::vector<unsigned char> data;
+    cc::ResizableBufferAdapter<std::vector<unsigned char>> buffer(&data);
+    size_t touched = 0U;
+
+    double packTime = measure(iterations, [&]() {
+        for (const auto &name : names) {
+            const cc::AssetPackEntry *entry = pack->find(name);
+            const unsigned char *view = nullptr;
+            size_t size = 0U;
+            // stored entries are consumed in place, compressed ones have to be inflated
+            if (pack->getView(entry, &view, &size)) {
+                touched += size ? view[size - 1] : 0U;
+            } else {
+                pack->read(entry, &buffer);
+            }
+        }
+    });
+
+    double looseTime = measure(iterations, [&]() {
+        for (const auto &name : names) readFile(looseDir / name, &data);
+    });
+
+    double zipTime = 0.0;
+    if (!zipPath.empty()) {
+        cc::ZipFile zip(zipPath);
+        zipTime = measure(iterations, [&]() {
+            for (const auto &name : names) zip.getFileData(name, &buffer);
+        });
+    }
+
+    const double reads = static_cast<double>(names.size()) * iterations;
+    printf("backend,total_ms,us_per_file\n");
+    printf("pack,%.3f,%.3f\n", packTime, packTime * 1000.0 / reads);
+    printf("loose,%.3f,%.3f\n", looseTime, looseTime * 1000.0 / reads);
+    if (!zipPath.empty()) printf("zip,%.3f,%.3f\n", zipTime, zipTime * 1000.0 / reads);
+    fprintf(stderr, "%zu files, %u iterations (%zu)\n", names.size(), iterations, touched);
+    return 0;
+}
+
+void usage(const char *program) {
+    fprintf(stderr,
+            "usage: %s pack <input-dir> <output.ccpk> [--deflate]\n"
+            "       %s list <pack.ccpk>\n"
+            "       %s bench <pack.ccpk> <loose-dir> [--zip <file.zip>] [--iterations N]\n",
+            program, program, program);
+}
+
+} // namespace
+
+// Builds, lists and benchmarks read-only asset packs, see cocos/platform/AssetPack.h for the format.
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (!strcmp(argv[1], "pack") && argc >= 4) {
+        bool deflate = argc >= 5 && !strcmp(argv[4], "--deflate");
+        return pack(argv[2], argv[3], deflate);
+    }
+    if (!strcmp(argv[1], "list")) {
+        return list(argv[2]);
+    }
+    if (!strcmp(argv[1], "bench") && argc >= 4) {
+        std::string zipPath;
+        uint32_t iterations = 10U;
+        for (int i = 4; i < argc; ++i) {
+            if (!strcmp(argv[i], "--zip") && i + 1 < argc) {
+                zipPath = argv[++i];
+            } else if (!strcmp(argv[i], "--iterations") && i + 1 < argc) {
+                iterations = static_cast<uint32_t>(atoi(argv[++i]));
+            }
+        }
+        return bench(argv[2], argv[3], zipPath, std::max(iterations, 1U));
+    }
+
+    usage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,143 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "cocos/platform/AsyncFileLoader.h"
+#include "cocos/platform/FileUtils.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Writes `count` files of `size` bytes, spread over 64 directories like a build's import folders.
+std::vector<std::string> createFiles(const std::string &root, uint32_t count, uint32_t size) {
+    std::vector<std::string> paths;
+    std::vector<char> content(size);
+    for (uint32_t i = 0; i < size; ++i) content[i] = static_cast<char>(i * 31);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string dir = "d" + std::to_string(i % 64) + "/";
+        std::filesystem::create_directories(root + dir);
+        paths.push_back(dir + "f" + std::to_string(i) + ".bin");
+        FILE *fp = fopen((root + paths.back()).c_str(), "wb");
+        if (!fp) {
+            fprintf(stderr, "can't write %s\n", (root + paths.back()).c_str());
+            return {};
+        }
+        fwrite(content.data(), 1, content.size(), fp);
+        fclose(fp);
+    }
+    return paths;
+}
+
+// What scene loading did before: resolve and read each file on the calling thread.
+// The contents are kept until the end, as the batch keeps them until its callback.
+double sequential(const std::vector<std::string> &paths, size_t *bytes) {
+    cc::FileUtils *fs = cc::FileUtils::getInstance();
+    fs->purgeCachedEntries();
+
+    std::vector<cc::Data> contents(paths.size());
+    auto start = Clock::now();
+    *bytes = 0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        contents[i] = fs->getDataFromFile(paths[i]);
+        *bytes += contents[i].getSize();
+    }
+    return millisecondsSince(start);
+}
+
+// One batch on the loader threads, `blocked` is how long the calling thread was busy queueing it.
+double batched(const std::vector<std::string> &paths, size_t *bytes, double *blocked) {
+    cc::FileUtils::getInstance()->purgeCachedEntries();
+
+    std::vector<cc::FileLoadRequest> requests(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) requests[i].path = paths[i];
+
+    std::promise<size_t> done;
+    auto start = Clock::now();
+    cc::AsyncFileLoader::getInstance()->loadBatch(requests, [&done](std::vector<cc::FileLoadResult> &results) {
+        size_t total = 0;
+        for (const auto &result : results) total += result.data.getSize();
+        done.set_value(total);
+    });
+    *blocked = millisecondsSince(start);
+    *bytes = done.get_future().get();
+    return millisecondsSince(start);
+}
+
+} // namespace
+
+// Compares AsyncFileLoader batches against sequential FileUtils::getDataFromFile calls.
+// Files are read back right after being written, so both paths run on a warm page cache;
+// drop the caches between runs (e.g. echo 3 > /proc/sys/vm/drop_caches) to measure cold reads.
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <scratch-dir> [count] [file-size] [iterations]\n", argv[0]);
+        return 1;
+    }
+    std::string root = argv[1];
+    if (root.back() != '/') root += '/';
+    uint32_t count = argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 5000U;
+    uint32_t size = argc > 3 ? static_cast<uint32_t>(atoi(argv[3])) : 16384U;
+    uint32_t iterations = argc > 4 ? std::max(static_cast<uint32_t>(atoi(argv[4])), 1U) : 5U;
+
+    std::vector<std::string> paths = createFiles(root, count, size);
+    if (paths.empty()) return 1;
+    cc::FileUtils::getInstance()->addSearchPath(root);
+
+    double bestSequential = 1e30;
+    double bestBatched = 1e30;
+    double bestBlocked = 1e30;
+    size_t sequentialBytes = 0;
+    size_t batchedBytes = 0;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        double blocked = 0.0;
+        bestSequential = std::min(bestSequential, sequential(paths, &sequentialBytes));
+        bestBatched = std::min(bestBatched, batched(paths, &batchedBytes, &blocked));
+        bestBlocked = std::min(bestBlocked, blocked);
+    }
+    cc::AsyncFileLoader::destroyInstance();
+
+    if (sequentialBytes != batchedBytes) {
+        fprintf(stderr, "read %zu bytes sequentially but %zu in the batch\n", sequentialBytes, batchedBytes);
+        return 1;
+    }
+    printf("%u files of %u bytes, best of %u\n", count, size, iterations);
+    printf("sequential getDataFromFile: %10.2f ms\n", bestSequential);
+    printf("AsyncFileLoader batch:      %10.2f ms (%.1fx), caller blocked %.3f ms\n", bestBatched, bestSequential / bestBatched, bestBlocked);
+
+    std::filesystem::remove_all(root);
+    return 0;
+}
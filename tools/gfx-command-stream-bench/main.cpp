@@ -0,0 +1,201 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "renderer/gfx-base/GFXCommandStream.h"
+#include "renderer/gfx-base/GFXDescriptorSet.h"
+#include "renderer/gfx-base/GFXPipelineState.h"
+
+using namespace cc::gfx;
+
+namespace {
+
+class BenchPipelineState final : public PipelineState {
+protected:
+    void doInit(const PipelineStateInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+class BenchDescriptorSet final : public DescriptorSet {
+public:
+    void update() override {}
+
+protected:
+    void doInit(const DescriptorSetInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+class BenchInputAssembler final : public InputAssembler {
+public:
+    explicit BenchInputAssembler(uint indexCount) { _indexCount = indexCount; }
+
+protected:
+    void doInit(const InputAssemblerInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+// Only counts, so what's measured is the cost of getting the commands to the command buffer
+class CountingCommandBuffer final : public CommandBuffer {
+public:
+    uint64_t checksum = 0U;
+
+    void begin(RenderPass * /*renderPass*/, uint /*subpass*/, Framebuffer * /*frameBuffer*/) override {}
+    void end() override {}
+    void beginRenderPass(RenderPass * /*renderPass*/, Framebuffer * /*fbo*/, const Rect & /*renderArea*/, const Color * /*colors*/, float /*depth*/, int /*stencil*/, CommandBuffer *const * /*secondaryCBs*/, uint /*secondaryCBCount*/) override {}
+    void endRenderPass() override {}
+    void bindPipelineState(PipelineState *pso) override { checksum += reinterpret_cast<uintptr_t>(pso); }
+    void bindDescriptorSet(uint set, DescriptorSet *descriptorSet, uint dynamicOffsetCount, const uint *dynamicOffsets) override {
+        checksum += set + reinterpret_cast<uintptr_t>(descriptorSet) + (dynamicOffsetCount ? dynamicOffsets[0] : 0U);
+    }
+    void bindInputAssembler(InputAssembler *ia) override { checksum += reinterpret_cast<uintptr_t>(ia); }
+    void setViewport(const Viewport &vp) override { checksum += vp.width; }
+    void setScissor(const Rect &rect) override { checksum += rect.width; }
+    void setLineWidth(float /*width*/) override {}
+    void setDepthBias(float /*constant*/, float /*clamp*/, float /*slope*/) override {}
+    void setBlendConstants(const Color & /*constants*/) override {}
+    void setDepthBound(float /*minBounds*/, float /*maxBounds*/) override {}
+    void setStencilWriteMask(StencilFace /*face*/, uint /*mask*/) override {}
+    void setStencilCompareMask(StencilFace /*face*/, int /*ref*/, uint /*mask*/) override {}
+    void nextSubpass() override {}
+    void draw(const DrawInfo &info) override { checksum += info.indexCount; }
+    void updateBuffer(Buffer * /*buff*/, const void * /*data*/, uint size) override { checksum += size; }
+    void copyBuffersToTexture(const uint8_t *const * /*buffers*/, Texture * /*texture*/, const BufferTextureCopy * /*regions*/, uint /*count*/) override {}
+    void blitTexture(Texture * /*srcTexture*/, Texture * /*dstTexture*/, const TextureBlit * /*regions*/, uint /*count*/, Filter /*filter*/) override {}
+    void execute(CommandBuffer *const * /*cmdBuffs*/, uint32_t /*count*/) override {}
+    void dispatch(const DispatchInfo & /*info*/) override {}
+    void pipelineBarrier(const GlobalBarrier * /*barrier*/, const TextureBarrier *const * /*textureBarriers*/, const Texture *const * /*textures*/, uint /*textureBarrierCount*/) override {}
+
+protected:
+    void doInit(const CommandBufferInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+// A 2D batch: pipeline, material and local descriptor sets, input assembler and draw
+struct Batch {
+    uint psoIndex;
+    uint materialIndex;
+    uint localIndex;
+    uint iaIndex;
+    uint dynamicOffset;
+};
+
+template <typename F>
+double measure(uint32_t iterations, const F &f) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        f();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+} // namespace
+
+// Usage: gfx-command-stream-bench [draws] [frames]
+int main(int argc, char **argv) {
+    uint     draws  = argc > 1 ? static_cast<uint>(atoi(argv[1])) : 10000U;
+    uint32_t frames = argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 200U;
+
+    constexpr uint PIPELINE_STATES = 8U;
+    constexpr uint DESCRIPTOR_SETS = 64U;
+    constexpr uint INPUT_ASSEMBLERS = 256U;
+
+    std::vector<BenchPipelineState>  pipelineStates(PIPELINE_STATES);
+    std::vector<BenchDescriptorSet>  descriptorSets(DESCRIPTOR_SETS);
+    std::vector<BenchInputAssembler> inputAssemblers;
+    inputAssemblers.reserve(INPUT_ASSEMBLERS);
+
+    CommandStream stream;
+    uint          objectCount = 0U;
+    for (auto &pso : pipelineStates) stream.setObject(objectCount++, &pso);
+    for (auto &ds : descriptorSets) stream.setObject(objectCount++, &ds);
+    for (uint i = 0U; i < INPUT_ASSEMBLERS; ++i) {
+        inputAssemblers.emplace_back(6U * (i + 1U));
+        stream.setObject(objectCount++, &inputAssemblers.back());
+    }
+
+    std::vector<Batch> batches(draws);
+    for (uint i = 0U; i < draws; ++i) {
+        batches[i] = {i / 1000U % PIPELINE_STATES, PIPELINE_STATES + i / 100U % DESCRIPTOR_SETS, PIPELINE_STATES + i % DESCRIPTOR_SETS,
+                      PIPELINE_STATES + DESCRIPTOR_SETS + i % INPUT_ASSEMBLERS, (i % 16U) * 256U};
+    }
+
+    // The words script writes into the shared ArrayBuffer, 18 per draw
+    std::vector<uint32_t> storage(draws * 18U);
+    stream.setStorage(storage.data(), static_cast<uint>(storage.size()));
+    auto encode = [&]() {
+        uint32_t *words = stream.getStorage();
+        uint      count = 0U;
+        for (const Batch &batch : batches) {
+            words[count++] = CommandStream::header(CommandStreamOp::BIND_PIPELINE_STATE, 1U);
+            words[count++] = batch.psoIndex;
+            words[count++] = CommandStream::header(CommandStreamOp::BIND_DESCRIPTOR_SET, 2U);
+            words[count++] = 1U;
+            words[count++] = batch.materialIndex;
+            words[count++] = CommandStream::header(CommandStreamOp::BIND_DESCRIPTOR_SET, 3U);
+            words[count++] = 2U;
+            words[count++] = batch.localIndex;
+            words[count++] = batch.dynamicOffset;
+            words[count++] = CommandStream::header(CommandStreamOp::BIND_INPUT_ASSEMBLER, 1U);
+            words[count++] = batch.iaIndex;
+            words[count++] = CommandStream::header(CommandStreamOp::DRAW, 1U);
+            words[count++] = batch.iaIndex;
+        }
+        return count;
+    };
+
+    // through a pointer the compiler can't see through, so the calls are virtual like in the engine
+    CountingCommandBuffer   directBuffer;
+    CommandBuffer *volatile directPtr  = &directBuffer;
+    CommandBuffer &         direct     = *directPtr;
+    double                  directTime = measure(frames, [&]() {
+        for (const Batch &batch : batches) {
+            direct.bindPipelineState(&pipelineStates[batch.psoIndex]);
+            direct.bindDescriptorSet(1U, &descriptorSets[batch.materialIndex - PIPELINE_STATES]);
+            direct.bindDescriptorSet(2U, &descriptorSets[batch.localIndex - PIPELINE_STATES], 1U, &batch.dynamicOffset);
+            direct.bindInputAssembler(&inputAssemblers[batch.iaIndex - PIPELINE_STATES - DESCRIPTOR_SETS]);
+            direct.draw(&inputAssemblers[batch.iaIndex - PIPELINE_STATES - DESCRIPTOR_SETS]);
+        }
+    });
+
+    uint wordCount  = encode();
+    double encodeTime = measure(frames, [&]() { wordCount = encode(); });
+
+    CountingCommandBuffer replayed;
+    bool                  ok         = true;
+    double                replayTime = measure(frames, [&]() { ok &= stream.replay(&replayed, wordCount); });
+
+    if (!ok || directBuffer.checksum != replayed.checksum) {
+        printf("replayed commands don't match the direct calls\n");
+        return 1;
+    }
+
+    printf("%u draws (5 commands each, %u words), %u frames\n", draws, wordCount, frames);
+    printf("direct calls   %8.1f us/frame  %5.1f ns/draw\n", directTime * 1e6, directTime * 1e9 / draws);
+    printf("stream encode  %8.1f us/frame  %5.1f ns/draw\n", encodeTime * 1e6, encodeTime * 1e9 / draws);
+    printf("stream replay  %8.1f us/frame  %5.1f ns/draw, 1 binding call per frame instead of %u\n", replayTime * 1e6, replayTime * 1e9 / draws, draws * 5U);
+    return 0;
+}
@@ -0,0 +1,88 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "cocos/bindings/event/EventDispatcher.h"
+#include "cocos/renderer/GFXDeviceManager.h"
+#include "cocos/renderer/gfx-capture/CaptureReplayer.h"
+
+// Replays a GFX capture and prints per-frame CPU statistics as CSV.
+// usage: gfx-replay <capture-file> [--loops N] [--native]
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <capture-file> [--loops N] [--native]\n", argv[0]);
+        return 1;
+    }
+
+    const char *path   = argv[1];
+    uint        loops  = 1U;
+    bool        native = false;
+    for (int i = 2; i < argc; ++i) {
+        if (!strcmp(argv[i], "--loops") && i + 1 < argc) {
+            loops = static_cast<uint>(atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--native")) {
+            native = true;
+        }
+    }
+
+    cc::EventDispatcher::init();
+
+    auto *replayer = new cc::gfx::CaptureReplayer;
+    if (!replayer->load(path)) return 1;
+
+    // the capture header carries the original surface size
+    cc::gfx::DeviceInfo info;
+    info.width        = replayer->getHeader().width;
+    info.height       = replayer->getHeader().height;
+    info.nativeWidth  = info.width;
+    info.nativeHeight = info.height;
+
+    cc::gfx::Device *device = native ? cc::gfx::DeviceManager::create(info) : cc::gfx::DeviceManager::createEmpty(info);
+    if (!device) {
+        fprintf(stderr, "failed to create device\n");
+        return 1;
+    }
+
+    cc::vector<cc::gfx::CaptureFrameStats> stats;
+    bool                                   succeeded = replayer->replayFrames(device, loops, &stats);
+
+    printf("frame,cpu_ms,draw_calls,instances,triangles,commands\n");
+    double total = 0.0;
+    for (size_t i = 0U; i < stats.size(); ++i) {
+        const cc::gfx::CaptureFrameStats &frame = stats[i];
+        printf("%zu,%.4f,%u,%u,%u,%u\n", i, frame.cpuTime, frame.numDrawCalls, frame.numInstances, frame.numTriangles, frame.numCommands);
+        total += frame.cpuTime;
+    }
+    if (!stats.empty()) {
+        fprintf(stderr, "%zu frames, %.4f ms per frame on average\n", stats.size(), total / static_cast<double>(stats.size()));
+    }
+
+    delete replayer;
+    cc::gfx::DeviceManager::destroy();
+    cc::EventDispatcher::destroy();
+
+    return succeeded ? 0 : 1;
+}
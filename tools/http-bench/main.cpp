@@ -0,0 +1,90 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cocos/network/HttpClient.h"
+#include "cocos/platform/Application.h"
+
+using cc::network::HttpClient;
+using cc::network::HttpRequest;
+using cc::network::HttpResponse;
+using Clock = std::chrono::steady_clock;
+
+// Sends small GET requests all at once to a local HTTP server, e.g. `python3 -m http.server 8000`,
+// and reports how long the whole batch took and the latency of each request.
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <url> [requests = 1000] [max concurrent requests = 8, 0 for unlimited]\n", argv[0]);
+        return 1;
+    }
+    std::string url           = argv[1];
+    uint32_t    requests      = argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 1000U;
+    uint32_t    maxConcurrent = argc > 3 ? static_cast<uint32_t>(atoi(argv[3])) : 8U;
+
+    cc::Application app(1, 1);
+    auto *          scheduler = app.getScheduler().get();
+    auto *          client    = HttpClient::getInstance();
+    client->setMaxConcurrentRequests(maxConcurrent);
+
+    std::vector<double> latencies;
+    uint32_t            failed = 0;
+    auto                start  = Clock::now();
+    for (uint32_t i = 0; i < requests; ++i) {
+        auto *request = new HttpRequest();
+        request->setUrl(url);
+        request->setRequestType(HttpRequest::Type::GET);
+        auto sent = Clock::now();
+        request->setResponseCallback([&, sent](HttpClient * /*client*/, HttpResponse *response) {
+            latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - sent).count());
+            if (!response->isSucceed()) {
+                ++failed;
+            }
+        });
+        client->send(request);
+        request->release();
+    }
+
+    auto deadline = Clock::now() + std::chrono::seconds(120);
+    while (latencies.size() < requests && Clock::now() < deadline) {
+        scheduler->update(0.F);
+        std::this_thread::yield();
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) { return latencies.empty() ? 0.0 : latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    printf("%zu/%u requests, %u failed, max concurrent %u\n", latencies.size(), requests, failed, maxConcurrent);
+    printf("total %10.2f ms %10.0f req/s   latency p50 %8.2f ms  p99 %8.2f ms  max %8.2f ms\n",
+           elapsedMs, latencies.size() * 1000.0 / elapsedMs, percentile(0.5), percentile(0.99), percentile(1.0));
+
+    HttpClient::destroyInstance();
+    return latencies.size() == requests ? 0 : 1;
+}
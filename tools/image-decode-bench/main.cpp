@@ -0,0 +1,125 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "cocos/base/Data.h"
+#include "cocos/platform/FileUtils.h"
+#include "cocos/platform/Image.h"
+#include "cocos/platform/ImageDecoder.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Decodes the image `count` times on the calling thread, as jsb.loadImage's callers did before.
+double sequential(const cc::Data &encoded, uint32_t count) {
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < count; ++i) {
+        auto *image = new cc::Image();
+        if (!image->initWithImageData(encoded.getBytes(), encoded.getSize())) {
+            fprintf(stderr, "decode failed\n");
+        }
+        image->release();
+    }
+    return millisecondsSince(start);
+}
+
+// Decodes the image `count` times on the ImageDecoder threads, into `staging` if it's not empty.
+double threaded(const cc::Data &encoded, uint32_t count, std::vector<unsigned char> *staging) {
+    cc::ImageDecodeOptions options;
+    if (!staging->empty()) {
+        // one slot per decode, like a ring of staging buffers
+        size_t slotSize = staging->size() / count;
+        auto next = std::make_shared<std::atomic<uint32_t>>(0);
+        options.allocator = [staging, slotSize, next](size_t size) -> unsigned char * {
+            return size <= slotSize ? staging->data() + slotSize * next->fetch_add(1) : nullptr;
+        };
+    }
+
+    std::atomic<uint32_t> remaining{count};
+    std::promise<void> done;
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::ImageDecoder::getInstance()->decode(encoded.getBytes(), encoded.getSize(), options, [&remaining, &done](cc::Image *image) {
+            if (!image) {
+                fprintf(stderr, "decode failed\n");
+            }
+            CC_SAFE_RELEASE(image);
+            if (--remaining == 0) done.set_value();
+        });
+    }
+    done.get_future().wait();
+    return millisecondsSince(start);
+}
+
+} // namespace
+
+// Compares decoding images on the calling thread with the ImageDecoder threads,
+// with and without writing the pixels into caller-provided buffers.
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <image-file> [count] [iterations]\n", argv[0]);
+        return 1;
+    }
+    uint32_t count = argc > 2 ? std::max(static_cast<uint32_t>(atoi(argv[2])), 1U) : 64U;
+    uint32_t iterations = argc > 3 ? std::max(static_cast<uint32_t>(atoi(argv[3])), 1U) : 3U;
+
+    cc::Data encoded = cc::FileUtils::getInstance()->getDataFromFile(argv[1]);
+    auto *probe = new cc::Image();
+    if (encoded.isNull() || !probe->initWithImageData(encoded.getBytes(), encoded.getSize())) {
+        fprintf(stderr, "can't decode %s\n", argv[1]);
+        return 1;
+    }
+    std::vector<unsigned char> staging(static_cast<size_t>(probe->getDataLen()) * count);
+    std::vector<unsigned char> noStaging;
+    printf("%s: %dx%d, %u decodes on %u threads, best of %u\n", argv[1], probe->getWidth(), probe->getHeight(),
+           count, cc::ImageDecoder::getInstance()->getThreadCount(), iterations);
+    probe->release();
+
+    double bestSequential = 1e30;
+    double bestThreaded = 1e30;
+    double bestStaged = 1e30;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        bestSequential = std::min(bestSequential, sequential(encoded, count));
+        bestThreaded = std::min(bestThreaded, threaded(encoded, count, &noStaging));
+        bestStaged = std::min(bestStaged, threaded(encoded, count, &staging));
+    }
+    cc::ImageDecoder::destroyInstance();
+
+    printf("calling thread:              %10.2f ms\n", bestSequential);
+    printf("ImageDecoder:                %10.2f ms (%.1fx)\n", bestThreaded, bestSequential / bestThreaded);
+    printf("ImageDecoder, into staging:  %10.2f ms (%.1fx)\n", bestStaged, bestSequential / bestStaged);
+    return 0;
+}
@@ -0,0 +1,200 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <chrono>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "cocos/bindings/event/EventDispatcher.h"
+#include "cocos/renderer/GFXDeviceManager.h"
+
+using namespace cc::gfx;
+
+namespace {
+
+// Only counts, so what's measured is the cost of recording the draws, not of the driver executing them
+class CountingCommandBuffer final : public CommandBuffer {
+public:
+    uint commands  = 0U;
+    uint drawCalls = 0U;
+    uint draws     = 0U;
+
+    void begin(RenderPass * /*renderPass*/, uint /*subpass*/, Framebuffer * /*frameBuffer*/) override {}
+    void end() override {}
+    void beginRenderPass(RenderPass * /*renderPass*/, Framebuffer * /*fbo*/, const Rect & /*renderArea*/, const Color * /*colors*/, float /*depth*/, int /*stencil*/, CommandBuffer *const * /*secondaryCBs*/, uint /*secondaryCBCount*/) override {}
+    void endRenderPass() override {}
+    void bindPipelineState(PipelineState * /*pso*/) override { ++commands; }
+    void bindDescriptorSet(uint /*set*/, DescriptorSet * /*descriptorSet*/, uint /*dynamicOffsetCount*/, const uint * /*dynamicOffsets*/) override { ++commands; }
+    void bindInputAssembler(InputAssembler *ia) override {
+        ++commands;
+        _ia = ia;
+    }
+    void setViewport(const Viewport & /*vp*/) override {}
+    void setScissor(const Rect & /*rect*/) override {}
+    void setLineWidth(float /*width*/) override {}
+    void setDepthBias(float /*constant*/, float /*clamp*/, float /*slope*/) override {}
+    void setBlendConstants(const Color & /*constants*/) override {}
+    void setDepthBound(float /*minBounds*/, float /*maxBounds*/) override {}
+    void setStencilWriteMask(StencilFace /*face*/, uint /*mask*/) override {}
+    void setStencilCompareMask(StencilFace /*face*/, int /*ref*/, uint /*mask*/) override {}
+    void nextSubpass() override {}
+    void draw(const DrawInfo & /*info*/) override {
+        ++commands;
+        ++drawCalls;
+        draws += _ia->getIndirectBuffer() ? _indirectCount : 1U;
+    }
+    void updateBuffer(Buffer *buff, const void * /*data*/, uint size) override {
+        ++commands;
+        if (hasFlag(buff->getUsage(), BufferUsageBit::INDIRECT)) _indirectCount = size / sizeof(DrawInfo);
+    }
+    void copyBuffersToTexture(const uint8_t *const * /*buffers*/, Texture * /*texture*/, const BufferTextureCopy * /*regions*/, uint /*count*/) override {}
+    void blitTexture(Texture * /*srcTexture*/, Texture * /*dstTexture*/, const TextureBlit * /*regions*/, uint /*count*/, Filter /*filter*/) override {}
+    void execute(CommandBuffer *const * /*cmdBuffs*/, uint32_t /*count*/) override {}
+    void dispatch(const DispatchInfo & /*info*/) override {}
+    void pipelineBarrier(const GlobalBarrier * /*barrier*/, const TextureBarrier *const * /*textureBarriers*/, const Texture *const * /*textures*/, uint /*textureBarrierCount*/) override {}
+
+protected:
+    void doInit(const CommandBufferInfo & /*info*/) override {}
+    void doDestroy() override {}
+
+private:
+    InputAssembler *_ia            = nullptr;
+    uint            _indirectCount = 0U;
+};
+
+template <typename F>
+double measure(uint32_t iterations, const F &f) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        f();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+} // namespace
+
+// Records draws sharing one pipeline state, descriptor set and geometry buffers, the draw-call-bound case
+// the instanced queue's indirect packing targets, once draw by draw and once packed into a multi-draw indirect.
+// Usage: indirect-draw-bench [draws] [frames]
+int main(int argc, char **argv) {
+    uint     draws  = argc > 1 ? static_cast<uint>(atoi(argv[1])) : 10000U;
+    uint32_t frames = argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 200U;
+    if (!draws) return 1;
+
+    constexpr uint INDICES_PER_DRAW = 36U; // a cube each
+
+    cc::EventDispatcher::init();
+    DeviceInfo info;
+    info.width        = 1;
+    info.height       = 1;
+    info.nativeWidth  = 1;
+    info.nativeHeight = 1;
+    Device *device    = DeviceManager::createEmpty(info);
+    if (!device) {
+        fprintf(stderr, "failed to create device\n");
+        return 1;
+    }
+
+    AttributeList attributes{{"a_position", Format::RGB32F}};
+    Buffer *      vertexBuffer = device->createBuffer({BufferUsageBit::VERTEX, MemoryUsageBit::DEVICE, draws * 8U * 12U, 12U});
+    Buffer *      indexBuffer  = device->createBuffer({BufferUsageBit::INDEX, MemoryUsageBit::DEVICE, draws * INDICES_PER_DRAW * 2U, 2U});
+
+    // one input assembler per draw, each selecting its own range of the shared buffers
+    std::vector<InputAssembler *> inputAssemblers(draws);
+    for (uint i = 0U; i < draws; ++i) {
+        inputAssemblers[i] = device->createInputAssembler({attributes, {vertexBuffer}, indexBuffer});
+        inputAssemblers[i]->setFirstIndex(i * INDICES_PER_DRAW);
+        inputAssemblers[i]->setIndexCount(INDICES_PER_DRAW);
+        inputAssemblers[i]->setVertexOffset(i * 8U);
+    }
+
+    Buffer *indirectBuffer = device->createBuffer({BufferUsageBit::INDIRECT | BufferUsageBit::TRANSFER_DST, MemoryUsageBit::HOST | MemoryUsageBit::DEVICE,
+                                                   static_cast<uint>(draws * sizeof(DrawInfo)), sizeof(DrawInfo)});
+    InputAssembler *packedIA = device->createInputAssembler({attributes, {vertexBuffer}, indexBuffer, indirectBuffer});
+    PipelineState *      pso           = device->createPipelineState({});
+    DescriptorSetLayout *layout        = device->createDescriptorSetLayout({});
+    DescriptorSet *      descriptorSet = device->createDescriptorSet({layout});
+
+    // through a pointer the compiler can't see through, so the calls are virtual like in the engine
+    CountingCommandBuffer   directBuffer;
+    CommandBuffer *volatile directPtr = &directBuffer;
+    CommandBuffer &         direct    = *directPtr;
+    double                  directTime = measure(frames, [&]() {
+        for (auto *ia : inputAssemblers) {
+            direct.bindPipelineState(pso);
+            direct.bindDescriptorSet(2U, descriptorSet);
+            direct.bindInputAssembler(ia);
+            direct.draw(ia);
+        }
+    });
+
+    // what the packer does each frame: fold the compatible draws, upload them and issue one draw
+    CountingCommandBuffer   packedBuffer;
+    CommandBuffer *volatile packedPtr = &packedBuffer;
+    CommandBuffer &         packed    = *packedPtr;
+    DrawInfoList            drawInfos;
+    double                  packedTime = measure(frames, [&]() {
+        drawInfos.clear();
+        const InputAssembler *first = inputAssemblers[0];
+        for (auto *ia : inputAssemblers) {
+            if (ia->getVertexBuffers() != first->getVertexBuffers() || ia->getIndexBuffer() != first->getIndexBuffer()) break;
+            DrawInfo drawInfo;
+            ia->extractDrawInfo(drawInfo);
+            drawInfo.instanceCount = std::max(drawInfo.instanceCount, 1U);
+            drawInfos.push_back(drawInfo);
+        }
+        packed.updateBuffer(indirectBuffer, drawInfos.data(), static_cast<uint>(drawInfos.size() * sizeof(DrawInfo)));
+        packed.bindPipelineState(pso);
+        packed.bindDescriptorSet(2U, descriptorSet);
+        packed.bindInputAssembler(packedIA);
+        packed.draw(packedIA);
+    });
+
+    if (directBuffer.draws != packedBuffer.draws) {
+        printf("packed draws don't match the direct ones\n");
+        return 1;
+    }
+
+    printf("%u draws sharing bindings and buffers, %u frames\n", draws, frames);
+    printf("per draw  %8.1f us/frame  %5.1f ns/draw  %u draw calls  %u commands per frame\n",
+           directTime * 1e6, directTime * 1e9 / draws, directBuffer.drawCalls / frames, directBuffer.commands / frames);
+    printf("packed    %8.1f us/frame  %5.1f ns/draw  %u draw calls  %u commands per frame\n",
+           packedTime * 1e6, packedTime * 1e9 / draws, packedBuffer.drawCalls / frames, packedBuffer.commands / frames);
+
+    CC_SAFE_DESTROY(descriptorSet);
+    CC_SAFE_DESTROY(layout);
+    CC_SAFE_DESTROY(pso);
+    CC_SAFE_DESTROY(packedIA);
+    CC_SAFE_DESTROY(indirectBuffer);
+    for (auto *ia : inputAssemblers) {
+        CC_SAFE_DESTROY(ia);
+    }
+    CC_SAFE_DESTROY(indexBuffer);
+    CC_SAFE_DESTROY(vertexBuffer);
+    DeviceManager::destroy();
+    cc::EventDispatcher::destroy();
+    return 0;
+}
@@ -0,0 +1,108 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "cocos/bindings/jswrapper/SeApi.h"
+#include "cocos/bindings/manual/jsb_conversions.h"
+
+namespace {
+
+// seval_to_Vec3 and seval_to_Mat4 as they were, looking properties up by C string
+bool legacyToVec3(const se::Value &v, cc::Vec3 *pt) {
+    se::Object *obj = v.toObject();
+    se::Value x;
+    se::Value y;
+    se::Value z;
+    if (!obj->getProperty("x", &x) || !obj->getProperty("y", &y) || !obj->getProperty("z", &z)) {
+        return false;
+    }
+    pt->x = x.toFloat();
+    pt->y = y.toFloat();
+    pt->z = z.toFloat();
+    return true;
+}
+
+bool legacyToMat4(const se::Value &v, cc::Mat4 *mat) {
+    se::Object *obj = v.toObject();
+    se::Value tmp;
+    std::string prefix = "m";
+    for (uint32_t i = 0; i < 16; ++i) {
+        std::string name = i < 10 ? prefix + "0" + std::to_string(i) : prefix + std::to_string(i);
+        if (!obj->getProperty(name.c_str(), &tmp)) {
+            return false;
+        }
+        mat->m[i] = tmp.toFloat();
+    }
+    return true;
+}
+
+template <typename F>
+double measure(uint32_t iterations, const F &f) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        f();
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+} // namespace
+
+// Usage: jsb-conversion-bench [iterations]
+int main(int argc, char **argv) {
+    uint32_t iterations = argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 1000000;
+
+    se::ScriptEngine *engine = se::ScriptEngine::getInstance();
+    if (!engine->start()) {
+        printf("Failed to start the script engine\n");
+        return 1;
+    }
+
+    {
+        se::AutoHandleScope hs;
+        se::Value vec3;
+        se::Value mat4;
+        se::Value mat4Array;
+        engine->evalString("({x: 1, y: 2, z: 3})", -1, &vec3);
+        engine->evalString("({m00: 1, m01: 0, m02: 0, m03: 0, m04: 0, m05: 1, m06: 0, m07: 0,"
+                           "  m08: 0, m09: 0, m10: 1, m11: 0, m12: 5, m13: 6, m14: 7, m15: 1})",
+                           -1, &mat4);
+        engine->evalString("new Float32Array([1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 5, 6, 7, 1])", -1, &mat4Array);
+
+        cc::Vec3 v;
+        cc::Mat4 m;
+        printf("%u conversions, ns per call\n", iterations);
+        printf("Vec3 C string keys  %8.1f\n", measure(iterations, [&]() { legacyToVec3(vec3, &v); }));
+        printf("Vec3 seval_to_Vec3  %8.1f\n", measure(iterations, [&]() { seval_to_Vec3(vec3, &v); }));
+        printf("Mat4 C string keys  %8.1f\n", measure(iterations, [&]() { legacyToMat4(mat4, &m); }));
+        printf("Mat4 seval_to_Mat4  %8.1f\n", measure(iterations, [&]() { seval_to_Mat4(mat4, &m); }));
+        printf("Mat4 Float32Array   %8.1f\n", measure(iterations, [&]() { seval_to_Mat4(mat4Array, &m); }));
+    }
+
+    se::ScriptEngine::destroyInstance();
+    return 0;
+}
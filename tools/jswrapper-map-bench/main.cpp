@@ -0,0 +1,133 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "base/Object.h"
+#include "bindings/jswrapper/MappingUtils.h"
+
+namespace {
+
+volatile uintptr_t sink = 0;
+
+struct BenchObject : public cc::Object {
+    explicit BenchObject(size_t id) : id(id) {}
+    size_t id;
+};
+
+// Stands in for the se::Object bound to a native object
+se::Object *scriptObjectOf(const BenchObject *obj) {
+    return reinterpret_cast<se::Object *>(obj->id + 1);
+}
+
+struct Result {
+    double create;
+    double lookup;
+    double destroy;
+};
+
+template <typename F>
+double measure(const F &f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Creates the objects, looks them up in a shuffled order the given rounds, then destroys them
+template <typename Map, typename Find>
+Result run(Map &map, size_t count, uint32_t rounds, const std::vector<size_t> &order, const Find &find) {
+    std::vector<BenchObject *> objects(count);
+    Result result;
+    result.create = measure([&]() {
+        for (size_t i = 0; i < count; ++i) {
+            objects[i] = new BenchObject(i);
+            map.emplace(objects[i], scriptObjectOf(objects[i]));
+        }
+    });
+    result.lookup = measure([&]() {
+        for (uint32_t r = 0; r < rounds; ++r) {
+            for (size_t i : order) {
+                // Conversions read the native object anyway, so it's in cache for every map
+                sink += objects[i]->id + reinterpret_cast<uintptr_t>(find(objects[i]));
+            }
+        }
+    });
+    result.destroy = measure([&]() {
+        for (size_t i : order) {
+            map.erase(objects[i]);
+            delete objects[i];
+        }
+    });
+    return result;
+}
+
+void print(const char *name, const Result &result, const Result &baseline, size_t count, uint32_t rounds) {
+    printf("%-22s create %8.1f ns  lookup %6.1f ns (%.1fx)  destroy %8.1f ns\n", name,
+           result.create * 1e9 / count,
+           result.lookup * 1e9 / (count * rounds), baseline.lookup / result.lookup,
+           result.destroy * 1e9 / count);
+}
+
+} // namespace
+
+// Usage: jswrapper-map-bench [objects] [lookupRounds]
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(atoi(argv[1])) : 200000;
+    uint32_t rounds = argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 20;
+
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+    std::unordered_map<void *, se::Object *> unorderedMap;
+    Result baseline = run(unorderedMap, count, rounds, order, [&](BenchObject *obj) {
+        auto iter = unorderedMap.find(obj);
+        return iter == unorderedMap.end() ? nullptr : iter->second;
+    });
+
+    se::NativePtrMap<se::Object *> ptrMap;
+    Result hashed = run(ptrMap, count, rounds, order, [&](BenchObject *obj) {
+        auto iter = ptrMap.find(obj);
+        return iter == ptrMap.end() ? nullptr : iter->second;
+    });
+
+    se::NativePtrMap<se::Object *> hintedMap;
+    Result hinted = run(hintedMap, count, rounds, order, [&](BenchObject *obj) {
+        auto iter = hintedMap.find(obj, obj->getScriptMappingHint());
+        return iter == hintedMap.end() ? nullptr : iter->second;
+    });
+
+    printf("%zu objects, %u lookup rounds\n", count, rounds);
+    print("std::unordered_map", baseline, baseline, count, rounds);
+    print("NativePtrMap", hashed, baseline, count, rounds);
+    print("NativePtrMap + hint", hinted, baseline, count, rounds);
+    return 0;
+}
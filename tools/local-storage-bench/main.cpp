@@ -0,0 +1,72 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "cocos/storage/local-storage/LocalStorage.h"
+
+namespace {
+
+// Runs `count` setItem calls over `keys` distinct keys, returns the time in ms including the final flush.
+double measure(const std::string &dbPath, uint32_t count, uint32_t keys, bool writeThrough) {
+    std::remove(dbPath.c_str());
+    localStorageInit(dbPath);
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < count; ++i) {
+        localStorageSetItem("key" + std::to_string(i % keys), "{\"level\":" + std::to_string(i) + ",\"coins\":1234567}");
+        if (writeThrough) {
+            localStorageFlush();
+        }
+    }
+    localStorageFlush();
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    localStorageFree();
+    std::remove(dbPath.c_str());
+    return elapsed;
+}
+
+} // namespace
+
+// Compares the write-behind localStorage against committing every setItem, which is what it did before.
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <db-path> [count] [distinct-keys]\n", argv[0]);
+        return 1;
+    }
+    std::string dbPath = argv[1];
+    uint32_t count = argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 10000U;
+    uint32_t keys = argc > 3 ? static_cast<uint32_t>(atoi(argv[3])) : 100U;
+
+    double writeThrough = measure(dbPath, count, keys, true);
+    double writeBehind = measure(dbPath, count, keys, false);
+    printf("%u setItem calls over %u keys\n", count, keys);
+    printf("commit per call: %10.2f ms\n", writeThrough);
+    printf("write-behind:    %10.2f ms (%.1fx)\n", writeBehind, writeThrough / writeBehind);
+    return 0;
+}
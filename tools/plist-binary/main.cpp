@@ -0,0 +1,172 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include "cocos/base/ValueBinary.h"
+#include "cocos/platform/FileUtils.h"
+
+namespace {
+
+// Heap accounting for the benchmark, every block is prefixed with its size.
+std::atomic<size_t> liveBytes{0};
+std::atomic<size_t> peakBytes{0};
+std::atomic<size_t> allocations{0};
+constexpr size_t BLOCK_HEADER = alignof(std::max_align_t);
+
+void *allocate(size_t size) {
+    auto *block = static_cast<unsigned char *>(malloc(size + BLOCK_HEADER));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    memcpy(block, &size, sizeof(size));
+    size_t live = liveBytes += size;
+    size_t peak = peakBytes.load();
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live)) {
+    }
+    ++allocations;
+    return block + BLOCK_HEADER;
+}
+
+void deallocate(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto *block = static_cast<unsigned char *>(ptr) - BLOCK_HEADER;
+    size_t size = 0;
+    memcpy(&size, block, sizeof(size));
+    liveBytes -= size;
+    free(block);
+}
+
+struct Sample {
+    double ms = 0.0;
+    size_t peakBytes = 0;
+    size_t allocations = 0;
+};
+
+// Runs `load` `iterations` times, returns the average time and the heap usage of one run.
+template <typename F>
+Sample measure(uint32_t iterations, F &&load) {
+    Sample sample;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        size_t base = liveBytes.load();
+        peakBytes = base;
+        allocations = 0;
+        auto start = std::chrono::steady_clock::now();
+        load();
+        sample.ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        sample.peakBytes = peakBytes.load() - base;
+        sample.allocations = allocations.load();
+    }
+    sample.ms /= iterations;
+    return sample;
+}
+
+void print(const char *name, const Sample &sample) {
+    printf("%-24s %10.3f ms %12zu bytes peak %10zu allocations\n", name, sample.ms, sample.peakBytes, sample.allocations);
+}
+
+int convert(const std::string &input, const std::string &output) {
+    auto *fileUtils = cc::FileUtils::getInstance();
+    cc::ValueMap map = fileUtils->getValueMapFromFile(input);
+    bool ok = false;
+    if (!map.empty()) {
+        ok = fileUtils->writeValueMapToBinaryFile(map, output);
+    } else {
+        cc::ValueVector vector = fileUtils->getValueVectorFromFile(input);
+        ok = !vector.empty() && fileUtils->writeValueVectorToBinaryFile(vector, output);
+    }
+    if (!ok) {
+        fprintf(stderr, "failed to convert %s\n", input.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+int bench(const std::string &input, uint32_t iterations) {
+    auto *fileUtils = cc::FileUtils::getInstance();
+    cc::Data xml = fileUtils->getDataFromFile(input);
+    if (xml.isNull()) {
+        fprintf(stderr, "can't read %s\n", input.c_str());
+        return 1;
+    }
+    cc::ValueMap map = fileUtils->getValueMapFromData(reinterpret_cast<const char *>(xml.getBytes()), static_cast<int>(xml.getSize()));
+    if (map.empty()) {
+        fprintf(stderr, "%s isn't a dictionary plist\n", input.c_str());
+        return 1;
+    }
+    std::vector<uint8_t> binary = cc::encodeBinaryValue(map);
+    // a key in the middle, what a sprite frame lookup does
+    cc::BinaryValueReader probe(binary.data(), binary.size());
+    std::string key = probe.getRoot().keyAt(probe.getRoot().size() / 2);
+
+    printf("%s: xml %zd bytes, binary %zu bytes\n", input.c_str(), static_cast<ssize_t>(xml.getSize()), binary.size());
+    print("xml full load", measure(iterations, [&]() {
+              fileUtils->getValueMapFromData(reinterpret_cast<const char *>(xml.getBytes()), static_cast<int>(xml.getSize()));
+          }));
+    print("binary full load", measure(iterations, [&]() {
+              fileUtils->getValueMapFromData(reinterpret_cast<const char *>(binary.data()), static_cast<int>(binary.size()));
+          }));
+    print("binary lazy lookup", measure(iterations, [&]() {
+              cc::BinaryValueReader reader(binary.data(), binary.size());
+              reader.getRoot().find(key.c_str()).toValue();
+          }));
+    return 0;
+}
+
+void usage(const char *program) {
+    fprintf(stderr, "usage: %s convert <input.plist> <output>\n", program);
+    fprintf(stderr, "       %s bench <input.plist> [iterations]\n", program);
+}
+
+} // namespace
+
+void *operator new(size_t size) { return allocate(size); }
+void *operator new[](size_t size) { return allocate(size); }
+void operator delete(void *ptr) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, size_t /*size*/) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, size_t /*size*/) noexcept { deallocate(ptr); }
+
+// Converts XML plists to the binary value format read by FileUtils::getValueMapFromFile,
+// and compares the load time and heap usage of both.
+int main(int argc, char **argv) {
+    if (argc >= 4 && !strcmp(argv[1], "convert")) {
+        return convert(argv[2], argv[3]);
+    }
+    if (argc >= 3 && !strcmp(argv[1], "bench")) {
+        uint32_t iterations = argc > 3 ? static_cast<uint32_t>(atoi(argv[3])) : 20U;
+        return bench(argv[2], std::max(iterations, 1U));
+    }
+    usage(argv[0]);
+    return 1;
+}
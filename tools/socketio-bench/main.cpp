@@ -0,0 +1,118 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "network/SocketIOCodec.h"
+
+using cc::network::SIOPacket;
+using cc::network::SIOPacketDecoder;
+using cc::network::SIOPacketEncoder;
+
+namespace {
+
+volatile size_t sink = 0;
+
+// The string handling SIOClientImpl::onMessage used for socket.io 1.x events before the codec
+void parseWithStrings(const char *bytes) {
+    std::string payload = bytes;
+    int control = atoi(payload.substr(0, 1).c_str());
+    payload = payload.substr(1, payload.size() - 1);
+    if (control != 4) return;
+
+    std::string endpoint = "";
+    std::string::size_type a = payload.find("/");
+    std::string::size_type b = payload.find("[");
+    if (b != std::string::npos) {
+        if (a != std::string::npos && a < b) {
+            endpoint = payload.substr(a, b - (a + 1));
+        }
+    } else if (a != std::string::npos) {
+        endpoint = payload.substr(a, payload.size() - a);
+    }
+    if (endpoint == "") endpoint = "/";
+
+    payload = payload.substr(1);
+    if (endpoint != "/") payload = payload.substr(endpoint.size());
+    if (endpoint != "/" && payload != "") payload = payload.substr(1);
+
+    std::string::size_type payloadFirstSlashPos = payload.find("\"");
+    std::string::size_type payloadSecondSlashPos = payload.substr(payloadFirstSlashPos + 1).find("\"");
+    std::string eventname = payload.substr(payloadFirstSlashPos + 1, payloadSecondSlashPos - payloadFirstSlashPos + 1);
+    payload = payload.substr(payloadSecondSlashPos + 4, payload.size() - (payloadSecondSlashPos + 5));
+    sink += endpoint.size() + eventname.size() + payload.size();
+}
+
+void parseWithCodec(const char *bytes, size_t length) {
+    SIOPacket packet;
+    std::string_view name;
+    std::string_view args;
+    if (SIOPacketDecoder::decode(std::string_view(bytes, length), &packet) && SIOPacketDecoder::splitEvent(packet.data, &name, &args)) {
+        sink += packet.nsp.size() + name.size() + args.size();
+    }
+}
+
+template <typename F>
+double measure(uint32_t iterations, const F &f) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        f(i);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// Usage: socketio-bench [messages] [payloadBytes]
+int main(int argc, char **argv) {
+    uint32_t messages = argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 1000000;
+    size_t payloadBytes = argc > 2 ? static_cast<size_t>(atoi(argv[2])) : 64;
+
+    // A mix of namespaces and event names the size of typical game state updates
+    SIOPacketEncoder encoder;
+    std::vector<std::string> frames;
+    const char *namespaces[] = {"/", "/game", "/chat", "/lobby"};
+    for (int i = 0; i < 64; ++i) {
+        frames.push_back(encoder.encodeEvent(namespaces[i % 4], "state" + std::to_string(i), std::string(payloadBytes, 'a' + i % 26)));
+    }
+
+    double legacy = measure(messages, [&](uint32_t i) { parseWithStrings(frames[i % frames.size()].c_str()); });
+    double codec = measure(messages, [&](uint32_t i) {
+        const std::string &frame = frames[i % frames.size()];
+        parseWithCodec(frame.data(), frame.size());
+    });
+    double encode = measure(messages, [&](uint32_t i) {
+        sink += encoder.encodeEvent(namespaces[i % 4], "state", frames[i % frames.size()]).size();
+    });
+
+    printf("%u events, %zu byte payload\n", messages, payloadBytes);
+    printf("decode strings %10.0f msg/s\n", messages / legacy);
+    printf("decode codec   %10.0f msg/s  (%.1fx)\n", messages / codec, legacy / codec);
+    printf("encode codec   %10.0f msg/s\n", messages / encode);
+    return 0;
+}
@@ -0,0 +1,116 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "cocos/base/CompressedTextureDecoder.h"
+#include "cocos/base/job-system/JobSystem.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Case {
+    const char *name;
+    cc::gfx::Format format;
+    uint32_t blockWidth;
+    uint32_t blockHeight;
+    uint32_t blockBytes;
+};
+
+void setBits(uint8_t *block, uint32_t start, uint32_t count, uint32_t value) {
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t bit = start + i;
+        if ((value >> i) & 1) block[bit >> 3] |= 1 << (bit & 7);
+    }
+}
+
+// Random ETC and EAC blocks are all valid. Random ASTC blocks are mostly reserved encodings which
+// decode to the error color, so those are single partition LDR blocks with random endpoints and weights.
+std::vector<uint8_t> makeBlocks(const Case &c, uint32_t blockCount) {
+    std::mt19937 rng(42);
+    std::vector<uint8_t> data(static_cast<size_t>(blockCount) * c.blockBytes);
+    for (auto &byte : data) byte = static_cast<uint8_t>(rng());
+    if (c.format < cc::gfx::Format::ASTC_RGBA_4X4) return data;
+
+    for (uint32_t i = 0; i < blockCount; ++i) {
+        uint8_t *block = data.data() + static_cast<size_t>(i) * c.blockBytes;
+        uint8_t weights[16];
+        memcpy(weights, block, sizeof(weights));
+        memset(block, 0, c.blockBytes);
+        setBits(block, 0, 11, 0x42);         // 4x4 weight grid, 2 bit weights
+        setBits(block, 13, 4, 8);            // direct RGB endpoints
+        for (uint32_t e = 0; e < 6; ++e) setBits(block, 17 + e * 8, 8, static_cast<uint8_t>(rng()));
+        for (uint32_t w = 0; w < 16; ++w) setBits(block, 126 - 2 * w, 2, weights[w] & 3);
+    }
+    return data;
+}
+
+double decodeMilliseconds(const Case &c, const std::vector<uint8_t> &src, uint32_t size, bool multiThreaded, uint32_t iterations) {
+    std::vector<uint8_t> dst(cc::getDecodedTextureSize(size, size, cc::DecodedTextureFormat::RGBA8));
+    double best = 1e30;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        auto start = Clock::now();
+        if (!cc::decodeCompressedTexture(c.format, src.data(), src.size(), size, size, cc::DecodedTextureFormat::RGBA8, dst.data(), multiThreaded)) {
+            fprintf(stderr, "%s: decode failed\n", c.name);
+            return 0.0;
+        }
+        best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+} // namespace
+
+// Measures the software fallback decoders, on the calling thread and spread across the job system.
+int main(int argc, char **argv) {
+    uint32_t size = argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 2048U;
+    uint32_t iterations = argc > 2 ? std::max(static_cast<uint32_t>(atoi(argv[2])), 1U) : 5U;
+
+    const Case cases[] = {
+        {"ETC1 RGB8", cc::gfx::Format::ETC_RGB8, 4, 4, 8},
+        {"ETC2 RGB8", cc::gfx::Format::ETC2_RGB8, 4, 4, 8},
+        {"ETC2 RGBA8", cc::gfx::Format::ETC2_RGBA8, 4, 4, 16},
+        {"EAC RG11", cc::gfx::Format::EAC_RG11, 4, 4, 16},
+        {"ASTC 4x4", cc::gfx::Format::ASTC_RGBA_4X4, 4, 4, 16},
+        {"ASTC 8x8", cc::gfx::Format::ASTC_RGBA_8X8, 8, 8, 16},
+    };
+
+    printf("%ux%u, first mip level, best of %u, %u job threads\n", size, size, iterations, cc::JobSystem::getInstance()->threadCount());
+    printf("%-12s %14s %14s %10s\n", "format", "1 thread", "job system", "MPix/s");
+    for (const auto &c : cases) {
+        const uint32_t blockCount = ((size + c.blockWidth - 1) / c.blockWidth) * ((size + c.blockHeight - 1) / c.blockHeight);
+        std::vector<uint8_t> src = makeBlocks(c, blockCount);
+        double single = decodeMilliseconds(c, src, size, false, iterations);
+        double threaded = decodeMilliseconds(c, src, size, true, iterations);
+        printf("%-12s %11.2f ms %11.2f ms %10.1f\n", c.name, single, threaded, size * size / (threaded * 1000.0));
+    }
+    cc::JobSystem::destroyInstance();
+    return 0;
+}
@@ -0,0 +1,193 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cocos/network/WebSocket.h"
+#include "cocos/network/WebSocketServer.h"
+#include "cocos/platform/Application.h"
+
+#if !(USE_SOCKET > 0) || !(USE_WEBSOCKET_SERVER > 0)
+    #error "websocket-bench needs USE_SOCKET and USE_WEBSOCKET_SERVER"
+#endif
+
+using cc::network::WebSocket;
+using cc::network::WebSocketServer;
+using cc::network::WebSocketServerConnection;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+int64_t nowMicroseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Records the round trip of echoed messages, which carry their send time in front of the padding.
+class Client : public WebSocket::Delegate {
+public:
+    void onOpen(WebSocket * /*ws*/) override { opened = true; }
+    void onMessage(WebSocket * /*ws*/, const WebSocket::Data &data) override {
+        latencies.push_back(nowMicroseconds() - std::strtoll(data.bytes, nullptr, 10));
+    }
+    void onClose(WebSocket * /*ws*/) override { closed = true; }
+    void onError(WebSocket * /*ws*/, const WebSocket::ErrorCode & /*error*/) override { closed = true; }
+
+    void send(size_t size) {
+        std::string message = std::to_string(nowMicroseconds());
+        message.resize(std::max(size, message.size() + 1), ' ');
+        ws->send(message);
+    }
+
+    WebSocket *          ws{nullptr};
+    bool                 opened{false};
+    bool                 closed{false};
+    std::vector<int64_t> latencies;
+};
+
+template <typename Predicate>
+bool pumpUntil(cc::Scheduler *scheduler, Predicate &&done) {
+    auto deadline = Clock::now() + std::chrono::seconds(30);
+    while (!done()) {
+        if (Clock::now() > deadline) {
+            return false;
+        }
+        scheduler->update(0.F);
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+void report(const char *name, std::vector<Client> &clients, double elapsedMs) {
+    std::vector<int64_t> latencies;
+    for (auto &client : clients) {
+        latencies.insert(latencies.end(), client.latencies.begin(), client.latencies.end());
+        client.latencies.clear();
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) { return latencies.empty() ? 0 : latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    printf("%-10s %8zu msgs %10.2f ms %10.0f msgs/s   rtt p50 %6lld us  p99 %6lld us  max %6lld us\n",
+           name, latencies.size(), elapsedMs, latencies.size() * 1000.0 / elapsedMs,
+           static_cast<long long>(percentile(0.5)), static_cast<long long>(percentile(0.99)), static_cast<long long>(percentile(1.0)));
+}
+
+} // namespace
+
+// Echoes messages through the bundled WebSocketServer on localhost. "ping-pong" keeps one message in flight
+// per connection to measure latency, "burst" sends everything at once to measure throughput and "broadcast"
+// has the server send every message to all connections.
+int main(int argc, char **argv) {
+    uint32_t connections = argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 16U;
+    uint32_t messages    = argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 1000U;
+    size_t   size        = argc > 3 ? static_cast<size_t>(atoi(argv[3])) : 64U;
+    int      port        = argc > 4 ? atoi(argv[4]) : 18080;
+    uint32_t threads     = argc > 5 ? static_cast<uint32_t>(atoi(argv[5])) : 1U;
+
+    cc::Application app(1, 1);
+    auto *          scheduler = app.getScheduler().get();
+
+    auto server    = std::make_shared<WebSocketServer>();
+    bool listening = false;
+    server->setServiceThreadCount(threads);
+    server->setOnConnection([](const std::shared_ptr<WebSocketServerConnection> &conn) {
+        std::weak_ptr<WebSocketServerConnection> weak = conn;
+        conn->setOnText([weak](const std::shared_ptr<cc::network::DataFrame> &frame) {
+            if (auto conn = weak.lock()) {
+                conn->sendTextAsync(frame->toString(), nullptr);
+            }
+        });
+    });
+    WebSocketServer::listenAsync(server, port, "127.0.0.1", [&](const std::string &error) {
+        if (!error.empty()) {
+            fprintf(stderr, "listen failed: %s\n", error.c_str());
+            exit(1);
+        }
+        listening = true;
+    });
+    pumpUntil(scheduler, [&]() { return listening; });
+
+    std::vector<Client> clients(connections);
+    std::string         url = "ws://127.0.0.1:" + std::to_string(port);
+    for (auto &client : clients) {
+        client.ws = new WebSocket();
+        client.ws->init(client, url);
+    }
+    if (!pumpUntil(scheduler, [&]() { return std::all_of(clients.begin(), clients.end(), [](const Client &c) { return c.opened; }); })) {
+        fprintf(stderr, "connecting timed out\n");
+        return 1;
+    }
+    printf("%u connections, %u messages each, %zu bytes, %u service threads\n", connections, messages, size, threads);
+
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < messages; ++i) {
+        for (auto &client : clients) {
+            client.send(size);
+        }
+        pumpUntil(scheduler, [&]() { return std::all_of(clients.begin(), clients.end(), [&](const Client &c) { return c.latencies.size() > i; }); });
+    }
+    report("ping-pong", clients, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < messages; ++i) {
+        for (auto &client : clients) {
+            client.send(size);
+        }
+    }
+    pumpUntil(scheduler, [&]() { return std::all_of(clients.begin(), clients.end(), [&](const Client &c) { return c.latencies.size() >= messages; }); });
+    report("burst", clients, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < messages; ++i) {
+        std::string message = std::to_string(nowMicroseconds());
+        message.resize(std::max(size, message.size() + 1), ' ');
+        server->broadcastTextAsync(message);
+    }
+    pumpUntil(scheduler, [&]() { return std::all_of(clients.begin(), clients.end(), [&](const Client &c) { return c.latencies.size() >= messages; }); });
+    report("broadcast", clients, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+    uint64_t sent    = 0;
+    uint64_t dropped = 0;
+    for (auto &conn : server->getConnections()) {
+        auto stats = conn->getSendStats();
+        sent += stats.sentFrames;
+        dropped += stats.droppedFrames;
+    }
+    printf("server sent %llu frames, dropped %llu\n", static_cast<unsigned long long>(sent), static_cast<unsigned long long>(dropped));
+
+    for (auto &client : clients) {
+        client.ws->closeAsync();
+    }
+    pumpUntil(scheduler, [&]() { return std::all_of(clients.begin(), clients.end(), [](const Client &c) { return c.closed; }); });
+    for (auto &client : clients) {
+        client.ws->release();
+    }
+    server->closeAsync();
+    return 0;
+}
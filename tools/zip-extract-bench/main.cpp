@@ -0,0 +1,103 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include "extensions/assets-manager/ZipExtractor.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Extracts the archive `iterations` times into a fresh directory, returns the average time in ms.
+double measure(const std::string &zipPath, const fs::path &outDir, const cc::extension::ZipExtractor::Options &options, uint32_t iterations,
+               uint64_t *bytes) {
+    double total = 0.0;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        std::error_code ec;
+        fs::remove_all(outDir, ec);
+        fs::create_directories(outDir, ec);
+
+        cc::extension::ZipExtractor::Options opts = options;
+        opts.onProgress = [bytes](uint64_t /*bytesExtracted*/, uint64_t /*totalBytesExtracted*/, uint64_t totalBytesExpected) {
+            *bytes = totalBytesExpected;
+        };
+
+        std::string error;
+        auto start = std::chrono::steady_clock::now();
+        if (!cc::extension::ZipExtractor::extract(zipPath, outDir.string() + "/", opts, &error)) {
+            fprintf(stderr, "extraction failed: %s\n", error.c_str());
+            return -1.0;
+        }
+        total += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    return total / iterations;
+}
+
+void usage(const char *program) {
+    fprintf(stderr, "usage: %s <package.zip> <output-dir> [--threads N] [--iterations N]\n", program);
+}
+
+} // namespace
+
+// Compares the parallel extraction of AssetsManagerEx against the previous sequential one:
+// a single thread inflating 8KB at a time without preallocation.
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    cc::extension::ZipExtractor::Options parallel;
+    uint32_t iterations = 3U;
+    for (int i = 3; i < argc; ++i) {
+        if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+            parallel.threadCount = static_cast<uint32_t>(atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--iterations") && i + 1 < argc) {
+            iterations = std::max(static_cast<uint32_t>(atoi(argv[++i])), 1U);
+        }
+    }
+
+    cc::extension::ZipExtractor::Options sequential;
+    sequential.threadCount = 1;
+    sequential.chunkSize   = 8192;
+    sequential.preallocate = false;
+
+    uint64_t bytes = 0;
+    const fs::path outDir(argv[2]);
+    const double sequentialTime = measure(argv[1], outDir, sequential, iterations, &bytes);
+    const double parallelTime   = measure(argv[1], outDir, parallel, iterations, &bytes);
+    if (sequentialTime < 0.0 || parallelTime < 0.0) return 1;
+
+    const double megabytes = static_cast<double>(bytes) / (1024.0 * 1024.0);
+    printf("mode,avg_ms,mb_per_s\n");
+    printf("sequential,%.3f,%.2f\n", sequentialTime, megabytes * 1000.0 / sequentialTime);
+    printf("parallel,%.3f,%.2f\n", parallelTime, megabytes * 1000.0 / parallelTime);
+    return 0;
+}
@@ -0,0 +1,180 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/bindings/dop/BufferPool.h"
+#include "cocos/bindings/jswrapper/SeApi.h"
+#include <map>
+#include <random>
+
+using se::BufferPool;
+
+namespace {
+
+struct Entry {
+    uint32_t tag;
+    uint32_t pad[3];
+};
+
+// ArrayBuffers still held by the allocator of the pool
+uint countChunkBuffers(const BufferPool &pool) {
+    uint count = 0;
+    for (uint i = 0; i < pool.getChunkCount(); ++i) {
+        if (pool.getChunk(i) != nullptr) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+// chunks are ArrayBuffers, so the tests need a running engine
+class bufferPoolTest : public testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(se::ScriptEngine::getInstance()->start());
+    }
+
+    void TearDown() override {
+        se::ScriptEngine::getInstance()->cleanup();
+    }
+};
+
+} // namespace
+
+TEST_F(bufferPoolTest, allocFreeCompact) {
+    se::AutoHandleScope      hs;
+    BufferPool               pool(se::PoolType::NODE, 4, sizeof(Entry)); // 16 entries per chunk
+    std::map<uint, uint32_t> live;                                        // id -> tag
+    std::mt19937             rng(1);
+    uint32_t                 tag = 1;
+
+    for (int i = 0; i < 1000; ++i) {
+        uint id = pool.alloc();
+        EXPECT_TRUE(pool.isLive(id));
+        pool.getTypedObject<Entry>(id)->tag = tag;
+        live[id]                            = tag++;
+    }
+    EXPECT_EQ(pool.getStats().liveEntries, 1000U);
+    EXPECT_EQ(pool.getStats().chunks, 63U);
+
+    // free most of them, randomly
+    for (auto it = live.begin(); it != live.end();) {
+        if (rng() % 10 != 0) {
+            pool.free(it->first);
+            it = live.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    EXPECT_EQ(pool.getStats().liveEntries, live.size());
+
+    cc::vector<uint> translation;
+    pool.compact(&translation);
+    std::map<uint, uint> moved;
+    for (size_t i = 0; i < translation.size(); i += 2) {
+        moved[translation[i]] = translation[i + 1];
+    }
+    std::map<uint, uint32_t> remapped;
+    for (const auto &e : live) {
+        auto iter    = moved.find(e.first);
+        uint id      = iter != moved.end() ? iter->second : e.first;
+        remapped[id] = e.second;
+    }
+    EXPECT_EQ(remapped.size(), live.size());
+    for (const auto &e : remapped) {
+        EXPECT_TRUE(pool.isLive(e.first));
+        EXPECT_EQ(pool.getTypedObject<Entry>(e.first)->tag, e.second);
+    }
+    EXPECT_EQ(pool.getStats().chunks, (live.size() + 15) / 16);
+    EXPECT_EQ(countChunkBuffers(pool), pool.getStats().chunks);
+
+    // allocations after compaction fill the holes first, then grow
+    for (int i = 0; i < 100; ++i) {
+        uint id = pool.alloc();
+        EXPECT_EQ(pool.getTypedObject<Entry>(id)->tag, 0U);
+        pool.getTypedObject<Entry>(id)->tag = tag;
+        remapped[id]                        = tag++;
+    }
+    for (const auto &e : remapped) {
+        EXPECT_EQ(pool.getTypedObject<Entry>(e.first)->tag, e.second);
+    }
+    EXPECT_EQ(pool.getStats().liveEntries, remapped.size());
+
+    for (const auto &e : remapped) {
+        pool.free(e.first);
+    }
+    uint chunks = pool.getStats().chunks;
+    EXPECT_EQ(pool.releaseEmptyChunks(), chunks);
+    EXPECT_EQ(pool.getStats().chunks, 0U);
+    EXPECT_EQ(pool.getChunkCount(), 0U);
+    EXPECT_EQ(countChunkBuffers(pool), 0U);
+}
+
+TEST_F(bufferPoolTest, legacyChunks) {
+    se::AutoHandleScope hs;
+    BufferPool          pool(se::PoolType::PASS, 3, 8);
+    pool.allocateNewChunk();
+    EXPECT_EQ(pool.getStats().liveEntries, 8U);
+
+    pool.free(BufferPool::getPoolFlag() | 3);
+    EXPECT_EQ(pool.alloc(), BufferPool::getPoolFlag() | 3);
+    EXPECT_NE(pool.getChunk(0), nullptr);
+    EXPECT_EQ(pool.releaseEmptyChunks(), 0U);
+}
+
+TEST_F(bufferPoolTest, releasedSlotReuse) {
+    se::AutoHandleScope hs;
+    BufferPool          pool(se::PoolType::MODEL, 2, 8); // 4 entries per chunk
+    uint                ids[12];
+    for (auto &id : ids) {
+        id = pool.alloc();
+    }
+    for (int i = 4; i < 8; ++i) {
+        pool.free(ids[i]);
+    }
+    EXPECT_EQ(pool.releaseEmptyChunks(), 1U);
+    EXPECT_EQ(pool.getChunkCount(), 3U);
+    EXPECT_EQ(pool.getChunk(1), nullptr);
+    EXPECT_FALSE(pool.isLive(ids[4]));
+
+    // freeing an entry of a released chunk again is ignored
+    pool.free(ids[4]);
+    uint id = pool.alloc();
+    EXPECT_EQ((id >> 2) & 0xff, 1U);
+    EXPECT_EQ(pool.getStats().chunks, 3U);
+}
+
+TEST_F(bufferPoolTest, releasedIndices) {
+    se::AutoHandleScope hs;
+    BufferPool          pool(se::PoolType::NODE, 2, 8);
+    for (int i = 0; i < 4; ++i) {
+        pool.alloc(); // fills chunk 0
+    }
+    uint id = pool.alloc();
+    pool.free(id);
+
+    cc::vector<uint> released;
+    EXPECT_EQ(pool.releaseEmptyChunks(&released), 1U);
+    ASSERT_EQ(released.size(), 1U);
+    EXPECT_EQ(released[0], 1U);
+}
@@ -0,0 +1,88 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/platform/FilePathCache.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using cc::FilePathCache;
+
+TEST(filePathCacheTest, insertFindClear) {
+    FilePathCache cache;
+    std::string   value;
+    EXPECT_FALSE(cache.find("a.png", &value));
+
+    cache.insert("a.png", "/res/a.png");
+    cache.insert("a.png", "/other/a.png");
+    EXPECT_TRUE(cache.find("a.png", &value));
+    EXPECT_EQ(value, "/res/a.png");
+    EXPECT_TRUE(cache.find("a.png", nullptr));
+
+    cache.clear();
+    EXPECT_FALSE(cache.find("a.png", &value));
+}
+
+TEST(filePathCacheTest, staleGenerationIsDropped) {
+    FilePathCache  cache;
+    const uint32_t generation = cache.generation();
+
+    // a lookup resolved against the old search paths finishes after the clear
+    cache.clear();
+    cache.insert("a.png", "/old/a.png", generation);
+    EXPECT_FALSE(cache.find("a.png", nullptr));
+
+    cache.insert("a.png", "/new/a.png", cache.generation());
+    std::string value;
+    EXPECT_TRUE(cache.find("a.png", &value));
+    EXPECT_EQ(value, "/new/a.png");
+}
+
+TEST(filePathCacheTest, concurrentReadersAndClears) {
+    FilePathCache     cache;
+    std::atomic<bool> stop{false};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&cache, &stop, t]() {
+            std::string value;
+            for (int i = 0; !stop.load(); ++i) {
+                const std::string key = std::to_string((i + t) % 256);
+                if (cache.find(key, &value)) {
+                    EXPECT_EQ(value, "/res/" + key);
+                } else {
+                    cache.insert(key, "/res/" + key, cache.generation());
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 200; ++i) {
+        cache.clear();
+        std::this_thread::yield();
+    }
+    stop.store(true);
+    for (auto &reader : readers) {
+        reader.join();
+    }
+}
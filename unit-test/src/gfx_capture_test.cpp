@@ -0,0 +1,224 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/platform/FileUtils.h"
+#include "cocos/renderer/gfx-capture/CaptureReplayer.h"
+#include "cocos/renderer/gfx-capture/DeviceCapture.h"
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace cc::gfx;
+
+namespace {
+
+// Keeps every update it receives
+class TestBuffer final : public Buffer {
+public:
+    std::vector<std::vector<uint8_t>> updates;
+
+    void update(const void *buffer, uint size) override {
+        const auto *bytes = static_cast<const uint8_t *>(buffer);
+        updates.emplace_back(bytes, bytes + size);
+    }
+
+protected:
+    void doInit(const BufferInfo & /*info*/) override {}
+    void doInit(const BufferViewInfo & /*info*/) override {}
+    void doResize(uint /*size*/, uint /*count*/) override {}
+    void doDestroy() override {}
+};
+
+class TestQueue final : public Queue {
+public:
+    uint submits = 0U;
+
+    void submit(CommandBuffer *const * /*cmdBuffs*/, uint /*count*/) override { ++submits; }
+
+protected:
+    void doInit(const QueueInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+// Only buffers and the device queue are needed to replay the captures below
+class TestDevice final : public Device {
+public:
+    TestDevice() { _queue = &queue; }
+    ~TestDevice() override { _queue = nullptr; }
+
+    TestQueue                 queue;
+    std::vector<TestBuffer *> buffers;
+    uint                      acquires = 0U;
+    uint                      presents = 0U;
+
+    void resize(uint /*width*/, uint /*height*/) override {}
+    void acquire() override { ++acquires; }
+    void present() override { ++presents; }
+
+protected:
+    bool doInit(const DeviceInfo & /*info*/) override { return true; }
+    void doDestroy() override {}
+
+    CommandBuffer *      createCommandBuffer(const CommandBufferInfo & /*info*/, bool /*hasAgent*/) override { return nullptr; }
+    Queue *              createQueue() override { return nullptr; }
+    Buffer *             createBuffer() override {
+        buffers.push_back(CC_NEW(TestBuffer));
+        return buffers.back();
+    }
+    Texture *            createTexture() override { return nullptr; }
+    Sampler *            createSampler() override { return nullptr; }
+    Shader *             createShader() override { return nullptr; }
+    InputAssembler *     createInputAssembler() override { return nullptr; }
+    RenderPass *         createRenderPass() override { return nullptr; }
+    Framebuffer *        createFramebuffer() override { return nullptr; }
+    DescriptorSet *      createDescriptorSet() override { return nullptr; }
+    DescriptorSetLayout *createDescriptorSetLayout() override { return nullptr; }
+    PipelineLayout *     createPipelineLayout() override { return nullptr; }
+    PipelineState *      createPipelineState() override { return nullptr; }
+    GlobalBarrier *      createGlobalBarrier() override { return nullptr; }
+    TextureBarrier *     createTextureBarrier() override { return nullptr; }
+    void                 copyBuffersToTexture(const uint8_t *const * /*buffers*/, Texture * /*dst*/, const BufferTextureCopy * /*regions*/, uint /*count*/) override {}
+};
+
+std::vector<uint8_t> makeData(uint8_t seed) {
+    std::vector<uint8_t> data(16);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(seed + i);
+    return data;
+}
+
+} // namespace
+
+TEST(gfxCaptureTest, roundTrip) {
+    TestDevice device;
+    TestQueue  queue;
+    TestBuffer buffer;
+    BufferInfo info{BufferUsageBit::UNIFORM, MemoryUsageBit::DEVICE, 16U, 16U};
+    buffer.initialize(info);
+
+    const auto before = makeData(1U);
+    const auto during = makeData(100U);
+    const auto path   = cc::FileUtils::getInstance()->getWritablePath() + "gfx_capture_test.gfxc";
+
+    DeviceCapture::enableTracking(true);
+    DeviceCapture *capture = DeviceCapture::getInstance();
+    capture->create(CaptureOp::DEVICE_QUEUE, &queue);
+    capture->create(CaptureOp::CREATE_BUFFER, &buffer, info);
+    capture->updateBuffer(&buffer, before.data(), 16U);
+
+    // nothing is captured before the next acquire
+    capture->captureFrames(path, 1U);
+    EXPECT_FALSE(capture->isCapturing());
+    capture->acquire();
+    EXPECT_TRUE(capture->isCapturing());
+    capture->updateBuffer(&buffer, during.data(), 16U);
+    capture->submit(&queue, nullptr, 0U);
+    capture->present();
+    EXPECT_FALSE(capture->isCapturing());
+    capture->destroy(&buffer);
+    DeviceCapture::disableTracking();
+
+    CaptureReplayer replayer;
+    ASSERT_TRUE(replayer.load(path));
+    EXPECT_EQ(replayer.getHeader().frameCount, 1U);
+
+    std::vector<CaptureFrameStats> stats;
+    ASSERT_TRUE(replayer.replayFrames(&device, 2U, &stats));
+    EXPECT_EQ(stats.size(), 2U);
+    EXPECT_EQ(device.acquires, 2U);
+    EXPECT_EQ(device.presents, 2U);
+    // the captured queue maps onto the replaying device's queue
+    EXPECT_EQ(device.queue.submits, 2U);
+    EXPECT_EQ(queue.submits, 0U);
+
+    // the latest contents restore the buffer once, the frame's update is replayed with every loop
+    ASSERT_EQ(device.buffers.size(), 1U);
+    const auto &updates = device.buffers[0]->updates;
+    ASSERT_EQ(updates.size(), 3U);
+    EXPECT_EQ(updates[0], before);
+    EXPECT_EQ(updates[1], during);
+    EXPECT_EQ(updates[2], during);
+
+    replayer.destroy();
+    buffer.destroy();
+}
+
+#if (CC_PLATFORM != CC_PLATFORM_WINDOWS) // no setenv
+TEST(gfxCaptureTest, environmentSwitch) {
+    TestDevice device;
+    unsetenv("CC_GFX_CAPTURE");
+    DeviceCapture::enableTrackingFromEnvironment();
+    EXPECT_FALSE(DeviceCapture::isTracking());
+
+    const auto path = cc::FileUtils::getInstance()->getWritablePath() + "gfx_capture_environment.gfxc";
+    setenv("CC_GFX_CAPTURE", path.c_str(), 1);
+    setenv("CC_GFX_CAPTURE_FRAMES", "2", 1);
+    setenv("CC_GFX_CAPTURE_START", "1", 1);
+    DeviceCapture::enableTrackingFromEnvironment();
+    unsetenv("CC_GFX_CAPTURE");
+    unsetenv("CC_GFX_CAPTURE_FRAMES");
+    unsetenv("CC_GFX_CAPTURE_START");
+    ASSERT_TRUE(DeviceCapture::isTracking());
+
+    // the first frame is skipped, the next two are captured
+    DeviceCapture *capture = DeviceCapture::getInstance();
+    capture->acquire();
+    EXPECT_FALSE(capture->isCapturing());
+    capture->present();
+    for (uint i = 0U; i < 2U; ++i) {
+        capture->acquire();
+        EXPECT_TRUE(capture->isCapturing());
+        capture->present();
+    }
+    EXPECT_FALSE(capture->isCapturing());
+    DeviceCapture::disableTracking();
+
+    CaptureReplayer replayer;
+    ASSERT_TRUE(replayer.load(path));
+    EXPECT_EQ(replayer.getHeader().frameCount, 2U);
+    replayer.destroy();
+}
+#endif
+
+TEST(gfxCaptureTest, corruptedFile) {
+    TestDevice device;
+    const auto path = cc::FileUtils::getInstance()->getWritablePath() + "gfx_capture_corrupted.gfxc";
+
+    CaptureHeader header;
+    header.frameCount = 1U;
+    std::vector<uint8_t> bytes(sizeof(CaptureHeader));
+    memcpy(bytes.data(), &header, sizeof(CaptureHeader));
+    // an acquire whose payload size runs past the end of the file
+    bytes.push_back(static_cast<uint8_t>(CaptureOp::DEVICE_ACQUIRE));
+    bytes.insert(bytes.end(), {0U, 0U, 0U, 0U, 0xffU, 0U, 0U, 0U});
+
+    cc::Data data;
+    data.copy(bytes.data(), static_cast<ssize_t>(bytes.size()));
+    ASSERT_TRUE(cc::FileUtils::getInstance()->writeDataToFile(data, path));
+
+    CaptureReplayer replayer;
+    ASSERT_TRUE(replayer.load(path));
+    std::vector<CaptureFrameStats> stats;
+    EXPECT_FALSE(replayer.replayFrames(&device, 1U, &stats));
+    EXPECT_EQ(device.acquires, 0U);
+}
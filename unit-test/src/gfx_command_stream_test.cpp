@@ -0,0 +1,191 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/renderer/gfx-base/GFXCommandStream.h"
+#include "cocos/renderer/gfx-base/GFXDescriptorSet.h"
+#include "cocos/renderer/gfx-base/GFXPipelineState.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace cc::gfx;
+
+namespace {
+
+class TestPipelineState final : public PipelineState {
+protected:
+    void doInit(const PipelineStateInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+class TestDescriptorSet final : public DescriptorSet {
+public:
+    void update() override {}
+
+protected:
+    void doInit(const DescriptorSetInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+class TestInputAssembler final : public InputAssembler {
+public:
+    TestInputAssembler() { _indexCount = 6U; }
+
+protected:
+    void doInit(const InputAssemblerInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+// Logs the commands it receives
+class TestCommandBuffer final : public CommandBuffer {
+public:
+    std::vector<std::string> log;
+
+    void begin(RenderPass * /*renderPass*/, uint /*subpass*/, Framebuffer * /*frameBuffer*/) override {}
+    void end() override {}
+    void beginRenderPass(RenderPass * /*renderPass*/, Framebuffer * /*fbo*/, const Rect & /*renderArea*/, const Color * /*colors*/, float /*depth*/, int /*stencil*/, CommandBuffer *const * /*secondaryCBs*/, uint /*secondaryCBCount*/) override { log.emplace_back("beginRenderPass"); }
+    void endRenderPass() override { log.emplace_back("endRenderPass"); }
+    void bindPipelineState(PipelineState *pso) override { log.emplace_back(pso ? "bindPipelineState" : "bindPipelineState(null)"); }
+    void bindDescriptorSet(uint set, DescriptorSet * /*descriptorSet*/, uint dynamicOffsetCount, const uint *dynamicOffsets) override {
+        std::string entry = "bindDescriptorSet " + std::to_string(set);
+        for (uint i = 0U; i < dynamicOffsetCount; ++i) entry += " " + std::to_string(dynamicOffsets[i]);
+        log.push_back(entry);
+    }
+    void bindInputAssembler(InputAssembler * /*ia*/) override { log.emplace_back("bindInputAssembler"); }
+    void setViewport(const Viewport &vp) override { log.push_back("setViewport " + std::to_string(vp.left) + " " + std::to_string(vp.width) + " " + std::to_string(vp.maxDepth)); }
+    void setScissor(const Rect &rect) override { log.push_back("setScissor " + std::to_string(rect.x) + " " + std::to_string(rect.height)); }
+    void setLineWidth(float /*width*/) override {}
+    void setDepthBias(float /*constant*/, float /*clamp*/, float /*slope*/) override {}
+    void setBlendConstants(const Color & /*constants*/) override {}
+    void setDepthBound(float /*minBounds*/, float /*maxBounds*/) override {}
+    void setStencilWriteMask(StencilFace /*face*/, uint /*mask*/) override {}
+    void setStencilCompareMask(StencilFace /*face*/, int /*ref*/, uint /*mask*/) override {}
+    void nextSubpass() override {}
+    void draw(const DrawInfo &info) override { log.push_back("draw " + std::to_string(info.indexCount) + " " + std::to_string(info.firstIndex)); }
+    void updateBuffer(Buffer * /*buff*/, const void * /*data*/, uint /*size*/) override {}
+    void copyBuffersToTexture(const uint8_t *const * /*buffers*/, Texture * /*texture*/, const BufferTextureCopy * /*regions*/, uint /*count*/) override {}
+    void blitTexture(Texture * /*srcTexture*/, Texture * /*dstTexture*/, const TextureBlit * /*regions*/, uint /*count*/, Filter /*filter*/) override {}
+    void execute(CommandBuffer *const * /*cmdBuffs*/, uint32_t /*count*/) override {}
+    void dispatch(const DispatchInfo & /*info*/) override {}
+    void pipelineBarrier(const GlobalBarrier * /*barrier*/, const TextureBarrier *const * /*textureBarriers*/, const Texture *const * /*textures*/, uint /*textureBarrierCount*/) override {}
+
+protected:
+    void doInit(const CommandBufferInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+uint32_t floatBits(float value) {
+    uint32_t bits = 0U;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+void write(std::vector<uint32_t> *words, CommandStreamOp op, std::initializer_list<uint32_t> args) {
+    words->push_back(CommandStream::header(op, static_cast<uint>(args.size())));
+    words->insert(words->end(), args);
+}
+
+} // namespace
+
+TEST(gfxCommandStreamTest, replay) {
+    TestPipelineState  pso;
+    TestDescriptorSet  descriptorSet;
+    TestInputAssembler ia;
+    TestCommandBuffer  cmdBuff;
+
+    CommandStream stream;
+    stream.setObject(0, &pso);
+    stream.setObject(1, &descriptorSet);
+    stream.setObject(2, &ia);
+
+    std::vector<uint32_t> words;
+    write(&words, CommandStreamOp::SET_VIEWPORT, {static_cast<uint32_t>(-4), 0, 640, 480, floatBits(0.F), floatBits(1.F)});
+    write(&words, CommandStreamOp::SET_SCISSOR, {8, 0, 640, 480});
+    write(&words, CommandStreamOp::BIND_PIPELINE_STATE, {0});
+    write(&words, CommandStreamOp::BIND_DESCRIPTOR_SET, {0, 1});
+    write(&words, CommandStreamOp::BIND_DESCRIPTOR_SET, {2, 1, 256, 512});
+    write(&words, CommandStreamOp::BIND_INPUT_ASSEMBLER, {2});
+    write(&words, CommandStreamOp::DRAW, {2});
+    write(&words, CommandStreamOp::DRAW_INFO, {0, 0, 3, 12, 0, 1, 0});
+
+    stream.setStorage(words.data(), static_cast<uint>(words.size()));
+    EXPECT_TRUE(stream.replay(&cmdBuff, static_cast<uint>(words.size())));
+
+    const std::vector<std::string> expected = {
+        "setViewport -4 640 1.000000",
+        "setScissor 8 480",
+        "bindPipelineState",
+        "bindDescriptorSet 0",
+        "bindDescriptorSet 2 256 512",
+        "bindInputAssembler",
+        "draw 6 0",
+        "draw 3 12",
+    };
+    EXPECT_EQ(cmdBuff.log, expected);
+
+    // only the given prefix of the storage is replayed
+    cmdBuff.log.clear();
+    EXPECT_TRUE(stream.replay(&cmdBuff, 12));
+    EXPECT_EQ(cmdBuff.log.size(), 2);
+}
+
+TEST(gfxCommandStreamTest, malformed) {
+    TestPipelineState  pso;
+    TestInputAssembler ia;
+    TestCommandBuffer  cmdBuff;
+
+    CommandStream stream;
+    stream.setObject(0, &pso);
+    stream.setObject(3, &ia);
+
+    // objects of the wrong type or outside of the table are rejected
+    std::vector<uint32_t> words;
+    write(&words, CommandStreamOp::BIND_PIPELINE_STATE, {0});
+    write(&words, CommandStreamOp::BIND_PIPELINE_STATE, {3});
+    write(&words, CommandStreamOp::DRAW, {0});
+    EXPECT_FALSE(stream.replay(&cmdBuff, words.data(), static_cast<uint>(words.size())));
+    EXPECT_EQ(cmdBuff.log, std::vector<std::string>{"bindPipelineState"});
+
+    words.clear();
+    write(&words, CommandStreamOp::BIND_INPUT_ASSEMBLER, {7});
+    EXPECT_FALSE(stream.replay(&cmdBuff, words.data(), static_cast<uint>(words.size())));
+
+    // wrong argument counts, truncated streams and unknown opcodes
+    words.clear();
+    write(&words, CommandStreamOp::SET_SCISSOR, {0, 0, 1});
+    EXPECT_FALSE(stream.replay(&cmdBuff, words.data(), static_cast<uint>(words.size())));
+
+    words.clear();
+    write(&words, CommandStreamOp::DRAW_INFO, {0, 0, 3, 0, 0, 1, 0});
+    EXPECT_FALSE(stream.replay(&cmdBuff, words.data(), static_cast<uint>(words.size()) - 1));
+
+    words = {CommandStream::header(CommandStreamOp::COUNT, 0)};
+    EXPECT_FALSE(stream.replay(&cmdBuff, words.data(), 1));
+
+    words.clear();
+    write(&words, CommandStreamOp::UPDATE_BUFFER, {0, 64, 0});
+    EXPECT_FALSE(stream.replay(&cmdBuff, words.data(), static_cast<uint>(words.size())));
+
+    EXPECT_EQ(cmdBuff.log.size(), 1);
+}
@@ -0,0 +1,147 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/storage/local-storage/LocalStorage.h"
+#include <cstdio>
+#include <string>
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    #include <sqlite3/sqlite3.h>
+#else
+    #include <sqlite3.h>
+#endif
+
+namespace {
+
+const char *DB_PATH = "local_storage_test.sqlite";
+
+void reopen() {
+    localStorageFree();
+    localStorageInit(DB_PATH);
+}
+
+std::string getItem(const std::string &key) {
+    std::string value;
+    EXPECT_TRUE(localStorageGetItem(key, &value)) << key;
+    return value;
+}
+
+std::string getKey(int index) {
+    std::string key;
+    localStorageGetKey(index, &key);
+    return key;
+}
+
+class LocalStorageTest : public testing::Test {
+protected:
+    void SetUp() override {
+        std::remove(DB_PATH);
+        localStorageInit(DB_PATH);
+        localStorageSetFlushInterval(0.F);
+    }
+
+    void TearDown() override {
+        localStorageFree();
+        std::remove(DB_PATH);
+    }
+};
+
+} // namespace
+
+TEST_F(LocalStorageTest, readsPendingWrites) {
+    localStorageSetItem("a", "1");
+    localStorageSetItem("a", "2");
+    localStorageSetItem("b", "3");
+    EXPECT_EQ(getItem("a"), "2");
+    EXPECT_EQ(getItem("b"), "3");
+
+    std::string value;
+    EXPECT_FALSE(localStorageGetItem("c", &value));
+}
+
+TEST_F(LocalStorageTest, persistsOnFree) {
+    localStorageSetItem("a", "1");
+    localStorageSetItem("b", "2");
+    localStorageRemoveItem("b");
+    reopen();
+
+    int length = 0;
+    localStorageGetLength(length);
+    EXPECT_EQ(length, 1);
+    EXPECT_EQ(getItem("a"), "1");
+}
+
+TEST_F(LocalStorageTest, keepsKeyOrderAcrossFlush) {
+    localStorageSetItem("a", "1");
+    localStorageSetItem("b", "2");
+    localStorageSetItem("c", "3");
+    localStorageFlush();
+    // replacing a key moves it to the end
+    localStorageSetItem("a", "4");
+    EXPECT_EQ(getKey(0), "b");
+    EXPECT_EQ(getKey(2), "a");
+    reopen();
+
+    EXPECT_EQ(getKey(0), "b");
+    EXPECT_EQ(getKey(1), "c");
+    EXPECT_EQ(getKey(2), "a");
+    EXPECT_EQ(getKey(3), "");
+    EXPECT_EQ(getItem("a"), "4");
+}
+
+TEST_F(LocalStorageTest, clearDropsEarlierWrites) {
+    localStorageSetItem("a", "1");
+    localStorageFlush();
+    localStorageSetItem("b", "2");
+    localStorageClear();
+    localStorageSetItem("c", "3");
+    reopen();
+
+    int length = 0;
+    localStorageGetLength(length);
+    EXPECT_EQ(length, 1);
+    EXPECT_EQ(getKey(0), "c");
+}
+
+TEST_F(LocalStorageTest, retriesFailedCommit) {
+    localStorageSetItem("a", "1");
+    localStorageFlush();
+
+    // another connection holds the write lock, so the next commit fails and is rolled back
+    sqlite3 *other = nullptr;
+    ASSERT_EQ(sqlite3_open(DB_PATH, &other), SQLITE_OK);
+    ASSERT_EQ(sqlite3_exec(other, "BEGIN EXCLUSIVE;", nullptr, nullptr, nullptr), SQLITE_OK);
+    localStorageSetItem("a", "2");
+    localStorageSetItem("b", "3");
+    localStorageFlush();
+    sqlite3_exec(other, "COMMIT;", nullptr, nullptr, nullptr);
+    sqlite3_close(other);
+
+    // newer writes win over the requeued ones
+    localStorageSetItem("b", "4");
+    localStorageFlush();
+    reopen();
+
+    EXPECT_EQ(getItem("a"), "2");
+    EXPECT_EQ(getItem("b"), "4");
+}
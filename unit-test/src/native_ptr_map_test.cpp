@@ -0,0 +1,135 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/bindings/jswrapper/MappingUtils.h"
+#include <random>
+#include <unordered_map>
+
+using se::NativePtrMap;
+
+namespace {
+void *ptrAt(size_t i) {
+    return reinterpret_cast<void *>((i + 1) * 16);
+}
+} // namespace
+
+TEST(nativePtrMapTest, emplaceFindErase) {
+    NativePtrMap<int> map;
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_TRUE(map.emplace(ptrAt(i), i).second);
+    }
+    EXPECT_EQ(map.size(), 10000);
+    EXPECT_FALSE(map.emplace(ptrAt(5), -1).second);
+    EXPECT_EQ(map.find(ptrAt(5))->second, 5);
+    EXPECT_TRUE(map.find(ptrAt(10000)) == map.end());
+
+    for (int i = 0; i < 10000; i += 2) {
+        EXPECT_EQ(map.erase(ptrAt(i)), 1);
+    }
+    EXPECT_EQ(map.erase(ptrAt(0)), 0);
+    EXPECT_EQ(map.size(), 5000);
+    for (int i = 0; i < 10000; ++i) {
+        auto iter = map.find(ptrAt(i));
+        if (i % 2 == 0) {
+            EXPECT_TRUE(iter == map.end());
+        } else {
+            ASSERT_TRUE(iter != map.end());
+            EXPECT_EQ(iter->second, i);
+        }
+    }
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.begin() == map.end());
+}
+
+TEST(nativePtrMapTest, eraseWhileIterating) {
+    NativePtrMap<int> map;
+    for (int i = 0; i < 5000; ++i) {
+        map.emplace(ptrAt(i * 7), i);
+    }
+
+    size_t visited = 0;
+    for (auto iter = map.begin(); iter != map.end();) {
+        ++visited;
+        if (iter->second % 3 == 0) {
+            iter = map.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    EXPECT_EQ(visited, 5000);
+    EXPECT_EQ(map.size(), 5000 - 1667);
+
+    size_t remaining = 0;
+    for (const auto &e : static_cast<const NativePtrMap<int> &>(map)) {
+        EXPECT_NE(e.second % 3, 0);
+        ++remaining;
+    }
+    EXPECT_EQ(remaining, map.size());
+}
+
+TEST(nativePtrMapTest, hint) {
+    NativePtrMap<int> map;
+    map.reserve(100);
+    uint32_t hint = NativePtrMap<int>::NO_HINT;
+    map.emplace(ptrAt(1), 1);
+    EXPECT_EQ(map.find(ptrAt(1), &hint)->second, 1);
+    EXPECT_NE(hint, NativePtrMap<int>::NO_HINT);
+    EXPECT_EQ(map.find(ptrAt(1), &hint)->second, 1);
+
+    // A stale hint falls back to hashing
+    for (int i = 2; i < 1000; ++i) {
+        map.emplace(ptrAt(i), i);
+    }
+    EXPECT_EQ(map.find(ptrAt(1), &hint)->second, 1);
+    map.erase(ptrAt(1));
+    EXPECT_TRUE(map.find(ptrAt(1), &hint) == map.end());
+}
+
+TEST(nativePtrMapTest, matchesUnorderedMap) {
+    NativePtrMap<size_t> map;
+    std::unordered_map<void *, size_t> reference;
+    std::mt19937 rng(42);
+    for (size_t i = 0; i < 200000; ++i) {
+        void *key = ptrAt(rng() % 4096);
+        switch (rng() % 3) {
+            case 0:
+                EXPECT_EQ(map.emplace(key, i).second, reference.emplace(key, i).second);
+                break;
+            case 1:
+                EXPECT_EQ(map.erase(key), reference.erase(key));
+                break;
+            default: {
+                auto iter = map.find(key);
+                auto refIter = reference.find(key);
+                ASSERT_EQ(iter == map.end(), refIter == reference.end());
+                if (refIter != reference.end()) {
+                    EXPECT_EQ(iter->second, refIter->second);
+                }
+            } break;
+        }
+        ASSERT_EQ(map.size(), reference.size());
+    }
+}
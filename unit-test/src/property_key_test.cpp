@@ -0,0 +1,96 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/bindings/jswrapper/SeApi.h"
+#include "cocos/bindings/manual/jsb_conversions.h"
+
+namespace {
+
+const se::PropertyKey KEY_X("x");
+const se::PropertyKey KEY_Y("y");
+const se::PropertyKey KEY_Z("z");
+
+class PropertyKeyTest : public testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(se::ScriptEngine::getInstance()->start());
+    }
+
+    void TearDown() override {
+        se::ScriptEngine::getInstance()->cleanup();
+    }
+};
+
+} // namespace
+
+TEST(propertyKeyTest, uniqueIndices) {
+    const se::PropertyKey other("x");
+    EXPECT_STREQ(KEY_X.getName(), "x");
+    EXPECT_NE(KEY_X.getIndex(), KEY_Y.getIndex());
+    EXPECT_NE(KEY_X.getIndex(), other.getIndex());
+}
+
+TEST_F(PropertyKeyTest, getMatchesStringLookup) {
+    se::AutoHandleScope hs;
+    se::Value obj;
+    ASSERT_TRUE(se::ScriptEngine::getInstance()->evalString("({x: 1, y: 'two'})", -1, &obj));
+
+    // the second lookup hits the cached engine string
+    for (int i = 0; i < 2; ++i) {
+        se::Value x;
+        se::Value y;
+        ASSERT_TRUE(obj.toObject()->getProperty(KEY_X, &x));
+        ASSERT_TRUE(obj.toObject()->getProperty(KEY_Y, &y));
+        EXPECT_EQ(x.toInt32(), 1);
+        EXPECT_EQ(y.toString(), "two");
+    }
+
+    se::Value z;
+    EXPECT_FALSE(obj.toObject()->getProperty(KEY_Z, &z));
+}
+
+TEST_F(PropertyKeyTest, setIsVisibleByName) {
+    se::AutoHandleScope hs;
+    se::HandleObject obj(se::Object::createPlainObject());
+    ASSERT_TRUE(obj->setProperty(KEY_Z, se::Value(3)));
+
+    se::Value z;
+    ASSERT_TRUE(obj->getProperty("z", &z));
+    EXPECT_EQ(z.toInt32(), 3);
+}
+
+TEST_F(PropertyKeyTest, survivesEngineRestart) {
+    // the cached engine strings belong to the previous isolate, they are created again
+    se::ScriptEngine::getInstance()->cleanup();
+    ASSERT_TRUE(se::ScriptEngine::getInstance()->start());
+
+    se::AutoHandleScope hs;
+    se::Value obj;
+    ASSERT_TRUE(se::ScriptEngine::getInstance()->evalString("({x: 4, y: 5, z: 6})", -1, &obj));
+    cc::Vec3 v;
+    ASSERT_TRUE(seval_to_Vec3(obj, &v));
+    EXPECT_FLOAT_EQ(v.x, 4.F);
+    EXPECT_FLOAT_EQ(v.y, 5.F);
+    EXPECT_FLOAT_EQ(v.z, 6.F);
+}
@@ -0,0 +1,141 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/base/Scheduler.h"
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using cc::PerformPriority;
+using cc::Scheduler;
+
+TEST(schedulerTest, performInPriorityOrder) {
+    Scheduler        scheduler;
+    std::vector<int> order;
+    scheduler.performFunctionInCocosThread([&]() { order.push_back(2); }, PerformPriority::LOW);
+    scheduler.performFunctionInCocosThread([&]() { order.push_back(1); });
+    scheduler.performFunctionInCocosThread([&]() { order.push_back(0); }, PerformPriority::HIGH);
+    scheduler.performFunctionInCocosThread([&]() { order.push_back(3); }, PerformPriority::LOW);
+    EXPECT_EQ(scheduler.getPerformStats().executed, 0);
+
+    scheduler.update(0.F);
+    EXPECT_EQ(order, std::vector<int>({0, 1, 2, 3}));
+    EXPECT_EQ(scheduler.getPerformStats().executed, 4);
+    EXPECT_EQ(scheduler.getPerformStats().deferred, 0);
+}
+
+TEST(schedulerTest, performQueuedWhilePerformingInNextFrame) {
+    Scheduler scheduler;
+    int       count = 0;
+    scheduler.performFunctionInCocosThread([&]() {
+        ++count;
+        scheduler.performFunctionInCocosThread([&]() { ++count; });
+    });
+    scheduler.update(0.F);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(scheduler.getPerformStats().pending[static_cast<size_t>(PerformPriority::NORMAL)], 1);
+    scheduler.update(0.F);
+    EXPECT_EQ(count, 2);
+}
+
+TEST(schedulerTest, performBudget) {
+    Scheduler scheduler;
+    scheduler.setPerformBudget(0.001F);
+    auto sleep = []() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); };
+    int  high   = 0;
+    int  normal = 0;
+    for (int i = 0; i < 3; ++i) {
+        scheduler.performFunctionInCocosThread(sleep, PerformPriority::LOW);
+        scheduler.performFunctionInCocosThread([&]() { ++high; }, PerformPriority::HIGH);
+        scheduler.performFunctionInCocosThread([&]() { ++normal; });
+    }
+
+    // Only LOW priority is budgeted, it makes progress one frame at a time.
+    for (uint32_t i = 0; i < 3; ++i) {
+        scheduler.update(0.F);
+        EXPECT_EQ(high, 3);
+        EXPECT_EQ(normal, 3);
+        EXPECT_EQ(scheduler.getPerformStats().deferred, 2 - i);
+    }
+    EXPECT_GT(scheduler.getPerformStats().maxLatency, 0.F);
+
+    scheduler.setPerformBudget(0.F);
+    for (int i = 0; i < 3; ++i) {
+        scheduler.performFunctionInCocosThread(sleep, PerformPriority::LOW);
+    }
+    scheduler.update(0.F);
+    EXPECT_EQ(scheduler.getPerformStats().executed, 3);
+}
+
+TEST(schedulerTest, removeAllFunctionsToBePerformed) {
+    Scheduler scheduler;
+    int       count = 0;
+    scheduler.setPerformBudget(0.F);
+    scheduler.performFunctionInCocosThread([&]() {
+        ++count;
+        scheduler.removeAllFunctionsToBePerformedInCocosThread();
+    });
+    scheduler.performFunctionInCocosThread([&]() { ++count; });
+    scheduler.update(0.F);
+    EXPECT_EQ(count, 1);
+
+    scheduler.performFunctionInCocosThread([&]() { ++count; });
+    scheduler.removeAllFunctionsToBePerformedInCocosThread();
+    scheduler.update(0.F);
+    EXPECT_EQ(count, 1);
+
+    scheduler.performFunctionInCocosThread([&]() { ++count; });
+    scheduler.update(0.F);
+    EXPECT_EQ(count, 2);
+}
+
+TEST(schedulerTest, performFromManyThreads) {
+    constexpr int THREAD_COUNT = 4;
+    constexpr int TASK_COUNT   = 10000;
+
+    Scheduler                scheduler;
+    std::vector<int>         last(THREAD_COUNT, -1);
+    bool                     ordered = true;
+    std::vector<std::thread> producers;
+    scheduler.setPerformBudget(0.F);
+    for (int t = 0; t < THREAD_COUNT; ++t) {
+        producers.emplace_back([&, t]() {
+            const std::string tag(64, 'x'); // larger than the inline buffer
+            for (int i = 0; i < TASK_COUNT; ++i) {
+                scheduler.performFunctionInCocosThread([&, t, i, tag]() {
+                    ordered = ordered && last[t] == i - 1 && tag.size() == 64;
+                    last[t] = i;
+                });
+            }
+        });
+    }
+    while (last != std::vector<int>(THREAD_COUNT, TASK_COUNT - 1)) {
+        scheduler.update(0.F);
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(ordered);
+}
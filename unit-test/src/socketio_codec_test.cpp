@@ -0,0 +1,187 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/network/SocketIOCodec.h"
+#include <random>
+
+using cc::network::SIOEngineType;
+using cc::network::SIOPacket;
+using cc::network::SIOPacketDecoder;
+using cc::network::SIOPacketEncoder;
+using cc::network::SIOPacketType;
+
+TEST(socketIOCodecTest, decode) {
+    SIOPacket packet;
+    EXPECT_TRUE(SIOPacketDecoder::decode("2probe", &packet));
+    EXPECT_EQ(packet.engineType, SIOEngineType::PING);
+    EXPECT_EQ(packet.data, "probe");
+
+    EXPECT_TRUE(SIOPacketDecoder::decode("40", &packet));
+    EXPECT_EQ(packet.type, SIOPacketType::CONNECT);
+    EXPECT_EQ(packet.nsp, "/");
+    EXPECT_TRUE(packet.data.empty());
+
+    EXPECT_TRUE(SIOPacketDecoder::decode("40/chat", &packet));
+    EXPECT_EQ(packet.nsp, "/chat");
+
+    EXPECT_TRUE(SIOPacketDecoder::decode(R"(42/chat,17["say","hi"])", &packet));
+    EXPECT_EQ(packet.engineType, SIOEngineType::MESSAGE);
+    EXPECT_EQ(packet.type, SIOPacketType::EVENT);
+    EXPECT_EQ(packet.nsp, "/chat");
+    EXPECT_EQ(packet.ackId, 17);
+    EXPECT_EQ(packet.data, R"(["say","hi"])");
+
+    EXPECT_TRUE(SIOPacketDecoder::decode(R"(452-["file",{"_placeholder":true,"num":0},{"_placeholder":true,"num":1}])", &packet));
+    EXPECT_EQ(packet.type, SIOPacketType::BINARY_EVENT);
+    EXPECT_EQ(packet.attachments, 2);
+    EXPECT_EQ(packet.ackId, -1);
+
+    EXPECT_FALSE(SIOPacketDecoder::decode("", &packet));
+    EXPECT_FALSE(SIOPacketDecoder::decode("9", &packet));
+    EXPECT_FALSE(SIOPacketDecoder::decode("4", &packet));
+    EXPECT_FALSE(SIOPacketDecoder::decode("45[]", &packet));
+    EXPECT_FALSE(SIOPacketDecoder::decode("42" + std::string(20, '1') + "[]", &packet));
+}
+
+TEST(socketIOCodecTest, splitEvent) {
+    std::string_view name;
+    std::string_view args;
+    EXPECT_TRUE(SIOPacketDecoder::splitEvent(R"(["say","hi",{"a":[1]}])", &name, &args));
+    EXPECT_EQ(name, "say");
+    EXPECT_EQ(args, R"("hi",{"a":[1]})");
+
+    EXPECT_TRUE(SIOPacketDecoder::splitEvent(R"( [ "a\"b" ] )", &name, &args));
+    EXPECT_EQ(name, R"(a\"b)");
+    EXPECT_TRUE(args.empty());
+
+    EXPECT_FALSE(SIOPacketDecoder::splitEvent(R"(["say")", &name, &args));
+    EXPECT_FALSE(SIOPacketDecoder::splitEvent(R"(["say" 1])", &name, &args));
+    EXPECT_FALSE(SIOPacketDecoder::splitEvent(R"({"say":1})", &name, &args));
+    EXPECT_FALSE(SIOPacketDecoder::splitEvent(R"(["say\"])", &name, &args));
+}
+
+TEST(socketIOCodecTest, encode) {
+    SIOPacketEncoder encoder;
+    EXPECT_EQ(encoder.encode(SIOEngineType::PING), "2");
+    EXPECT_EQ(encoder.encode(SIOEngineType::PONG, "probe"), "3probe");
+    EXPECT_EQ(encoder.encodeEvent("/", "say", "hi"), R"(42["say","hi"])");
+    EXPECT_EQ(encoder.encodeEvent("/chat", "say", "a\"\n\x01", 3), R"(42/chat,3["say","a\"\n\u0001"])");
+    EXPECT_EQ(encoder.encodeBinaryEvent("", "file", 1), R"(451-["file",{"_placeholder":true,"num":0}])");
+
+    SIOPacket connect;
+    connect.engineType = SIOEngineType::MESSAGE;
+    connect.type = SIOPacketType::CONNECT;
+    connect.nsp = "/chat";
+    EXPECT_EQ(encoder.encode(connect), "40/chat");
+
+    // the buffer is reused
+    const char *data = encoder.encodeEvent("/", "say", std::string(100, 'x')).data();
+    EXPECT_EQ(encoder.encodeEvent("/", "say", "y").data(), data);
+}
+
+TEST(socketIOCodecTest, binaryAttachments) {
+    SIOPacketEncoder encoder;
+    SIOPacketDecoder decoder;
+    SIOPacket packet;
+
+    std::string header = encoder.encodeBinaryEvent("/chat", "file", 2, 5);
+    EXPECT_EQ(decoder.feed(header, false, &packet), SIOPacketDecoder::Result::PENDING);
+    header.assign(header.size(), '\0'); // the decoder mustn't keep pointing at the frame
+
+    EXPECT_EQ(decoder.feed(encoder.encode(SIOEngineType::PONG), false, &packet), SIOPacketDecoder::Result::PACKET);
+    EXPECT_EQ(packet.engineType, SIOEngineType::PONG);
+
+    std::string first = encoder.encodeAttachment(std::string_view("\x00\x01\x02", 3));
+    EXPECT_EQ(decoder.feed(first, true, &packet), SIOPacketDecoder::Result::PENDING);
+    std::string second = encoder.encodeAttachment("abc");
+    EXPECT_EQ(decoder.feed(second, true, &packet), SIOPacketDecoder::Result::PACKET);
+
+    EXPECT_EQ(packet.type, SIOPacketType::BINARY_EVENT);
+    EXPECT_EQ(packet.nsp, "/chat");
+    EXPECT_EQ(packet.ackId, 5);
+    ASSERT_EQ(decoder.getAttachments().size(), 2);
+    EXPECT_EQ(decoder.getAttachments()[0], std::string_view("\x00\x01\x02", 3));
+    EXPECT_EQ(decoder.getAttachments()[1], "abc");
+
+    // stray attachment
+    EXPECT_EQ(decoder.feed(second, true, &packet), SIOPacketDecoder::Result::INVALID);
+    // a message while attachments are expected
+    EXPECT_EQ(decoder.feed(encoder.encodeBinaryEvent("/", "file", 1), false, &packet), SIOPacketDecoder::Result::PENDING);
+    EXPECT_EQ(decoder.feed(encoder.encodeEvent("/", "say", "hi"), false, &packet), SIOPacketDecoder::Result::INVALID);
+    EXPECT_EQ(decoder.feed(encoder.encodeEvent("/", "say", "hi"), false, &packet), SIOPacketDecoder::Result::PACKET);
+}
+
+TEST(socketIOCodecTest, fuzz) {
+    SIOPacketEncoder encoder;
+    std::mt19937 rng(20211019);
+    const char alphabet[] = "0123456789-/,[]\"\\{}: ab";
+
+    for (int i = 0; i < 20000; ++i) {
+        // round trip of a generated packet
+        SIOPacket in;
+        in.engineType = SIOEngineType::MESSAGE;
+        in.type = static_cast<SIOPacketType>(rng() % 7);
+        in.attachments = in.type == SIOPacketType::BINARY_EVENT || in.type == SIOPacketType::BINARY_ACK ? rng() % 4 : 0;
+        std::string nsp = rng() % 2 ? "/" : "/n" + std::to_string(rng() % 100);
+        in.nsp = nsp;
+        in.ackId = rng() % 3 ? -1 : static_cast<int64_t>(rng() % 100000);
+        std::string data = rng() % 4 ? "[\"e" + std::to_string(rng()) + "\"]" : "";
+        in.data = data;
+
+        std::string frame = encoder.encode(in);
+        SIOPacket out;
+        ASSERT_TRUE(SIOPacketDecoder::decode(frame, &out)) << frame;
+        EXPECT_EQ(out.type, in.type) << frame;
+        EXPECT_EQ(out.attachments, in.attachments) << frame;
+        EXPECT_EQ(out.nsp, in.nsp) << frame;
+        EXPECT_EQ(out.ackId, in.ackId) << frame;
+        EXPECT_EQ(out.data, in.data) << frame;
+
+        // random mutations mustn't read out of bounds or produce views outside of the frame
+        std::string mutated = frame;
+        for (int m = rng() % 4; m >= 0; --m) {
+            size_t pos = mutated.empty() ? 0 : rng() % mutated.size();
+            switch (rng() % 3) {
+                case 0: mutated.insert(pos, 1, alphabet[rng() % (sizeof(alphabet) - 1)]); break;
+                case 1:
+                    if (!mutated.empty()) mutated.erase(pos, 1);
+                    break;
+                default: mutated.resize(pos); break;
+            }
+        }
+        std::string_view view(mutated);
+        if (SIOPacketDecoder::decode(view, &out)) {
+            if (!out.data.empty()) {
+                EXPECT_GE(out.data.data(), view.data());
+                EXPECT_LE(out.data.data() + out.data.size(), view.data() + view.size());
+            }
+            std::string_view name;
+            std::string_view args;
+            if (SIOPacketDecoder::splitEvent(out.data, &name, &args)) {
+                EXPECT_GE(name.data(), out.data.data());
+                EXPECT_LE(args.data() + args.size(), out.data.data() + out.data.size());
+            }
+        }
+    }
+}
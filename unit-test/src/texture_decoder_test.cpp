@@ -0,0 +1,157 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/base/CompressedTextureDecoder.h"
+#include <vector>
+
+namespace {
+
+using Pixels = std::vector<uint8_t>;
+
+Pixels decode(cc::gfx::Format format, const uint8_t *block, size_t size, uint32_t width = 4, uint32_t height = 4) {
+    Pixels pixels(cc::getDecodedTextureSize(width, height, cc::DecodedTextureFormat::RGBA8));
+    EXPECT_TRUE(cc::decodeCompressedTexture(format, block, size, width, height, cc::DecodedTextureFormat::RGBA8, pixels.data(), false));
+    return pixels;
+}
+
+void expectPixel(const Pixels &pixels, uint32_t width, uint32_t x, uint32_t y, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    const uint8_t *p = pixels.data() + (y * width + x) * 4;
+    EXPECT_EQ(p[0], r) << "x " << x << " y " << y;
+    EXPECT_EQ(p[1], g) << "x " << x << " y " << y;
+    EXPECT_EQ(p[2], b) << "x " << x << " y " << y;
+    EXPECT_EQ(p[3], a) << "x " << x << " y " << y;
+}
+
+void setBits(uint8_t *block, uint32_t start, uint32_t count, uint32_t value) {
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t bit = start + i;
+        if ((value >> i) & 1) block[bit >> 3] |= 1 << (bit & 7);
+    }
+}
+
+} // namespace
+
+TEST(textureDecoderTest, etc1Individual) {
+    // R 15/0, G 8/8, B 0/15, codewords 0 and 7, vertical split, all pixel indices 0 (+a)
+    const uint8_t block[8] = {0xF0, 0x88, 0x0F, 0x1C, 0, 0, 0, 0};
+    Pixels pixels          = decode(cc::gfx::Format::ETC_RGB8, block, sizeof(block));
+    for (uint32_t y = 0; y < 4; ++y) {
+        expectPixel(pixels, 4, 0, y, 255, 138, 2, 255);
+        expectPixel(pixels, 4, 1, y, 255, 138, 2, 255);
+        expectPixel(pixels, 4, 2, y, 47, 183, 255, 255);
+        expectPixel(pixels, 4, 3, y, 47, 183, 255, 255);
+    }
+}
+
+TEST(textureDecoderTest, etc1Differential) {
+    // R 16 with delta -1, G and B 0, codewords 0, horizontal split, all pixel indices 3 (-b)
+    const uint8_t block[8] = {0x87, 0x00, 0x00, 0x03, 0xFF, 0xFF, 0xFF, 0xFF};
+    Pixels pixels          = decode(cc::gfx::Format::ETC_RGB8, block, sizeof(block));
+    for (uint32_t x = 0; x < 4; ++x) {
+        expectPixel(pixels, 4, x, 0, 124, 0, 0, 255);
+        expectPixel(pixels, 4, x, 1, 124, 0, 0, 255);
+        expectPixel(pixels, 4, x, 2, 115, 0, 0, 255);
+        expectPixel(pixels, 4, x, 3, 115, 0, 0, 255);
+    }
+}
+
+TEST(textureDecoderTest, etc2Planar) {
+    // blue overflows in differential mode: planar, origin blue 26, all other components 0
+    const uint8_t block[8] = {0x00, 0x00, 0xF9, 0x02, 0, 0, 0, 0};
+    Pixels pixels          = decode(cc::gfx::Format::ETC2_RGB8, block, sizeof(block));
+    expectPixel(pixels, 4, 0, 0, 0, 0, 105, 255);
+    expectPixel(pixels, 4, 3, 0, 0, 0, 26, 255);
+    expectPixel(pixels, 4, 0, 3, 0, 0, 26, 255);
+    expectPixel(pixels, 4, 3, 3, 0, 0, 0, 255);
+}
+
+TEST(textureDecoderTest, eacAlpha) {
+    // base 128, multiplier 1, table 0, all indices 4 (+2), followed by an ETC1 style black block
+    uint8_t block[16] = {128, 0x10, 0x92, 0x49, 0x24, 0x92, 0x49, 0x24};
+    Pixels pixels     = decode(cc::gfx::Format::ETC2_RGBA8, block, sizeof(block));
+    for (uint32_t i = 0; i < 16; ++i) {
+        expectPixel(pixels, 4, i % 4, i / 4, 2, 2, 2, 130);
+    }
+}
+
+TEST(textureDecoderTest, astcVoidExtent) {
+    uint8_t block[16] = {0xFC, 0xFD, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    const uint16_t color[4] = {0x1234, 0x5678, 0x9ABC, 0xFFFF};
+    memcpy(block + 8, color, sizeof(color));
+    Pixels pixels = decode(cc::gfx::Format::ASTC_RGBA_6X6, block, sizeof(block), 6, 6);
+    for (uint32_t i = 0; i < 36; ++i) {
+        expectPixel(pixels, 6, i % 6, i / 6, 0x12, 0x56, 0x9A, 0xFF);
+    }
+}
+
+TEST(textureDecoderTest, astcSinglePartition) {
+    // 4x4 weight grid with 2 bit weights, direct RGB endpoints black to white,
+    // each row uses weights 0, 1, 2, 3.
+    uint8_t block[16] = {};
+    setBits(block, 0, 11, 0x42);
+    setBits(block, 13, 4, 8);
+    const uint8_t endpoints[6] = {0, 255, 0, 255, 0, 255};
+    for (uint32_t i = 0; i < 6; ++i) setBits(block, 17 + i * 8, 8, endpoints[i]);
+    for (uint32_t i = 0; i < 16; ++i) {
+        const uint32_t weight = i % 4;
+        setBits(block, 127 - 2 * i, 1, weight & 1);
+        setBits(block, 126 - 2 * i, 1, weight >> 1);
+    }
+
+    Pixels pixels = decode(cc::gfx::Format::ASTC_RGBA_4X4, block, sizeof(block));
+    const uint8_t expected[4] = {0, 84, 171, 255};
+    for (uint32_t y = 0; y < 4; ++y) {
+        for (uint32_t x = 0; x < 4; ++x) {
+            expectPixel(pixels, 4, x, y, expected[x], expected[x], expected[x], 255);
+        }
+    }
+}
+
+TEST(textureDecoderTest, astcErrorColor) {
+    // HDR void extent block
+    uint8_t block[16] = {0xFC, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    Pixels pixels     = decode(cc::gfx::Format::ASTC_RGBA_4X4, block, sizeof(block));
+    expectPixel(pixels, 4, 1, 2, 255, 0, 255, 255);
+}
+
+TEST(textureDecoderTest, partialBlocksAndRGB565) {
+    const uint8_t block[8] = {0xF0, 0x88, 0x0F, 0x1C, 0, 0, 0, 0};
+    Pixels pixels          = decode(cc::gfx::Format::ETC_RGB8, block, sizeof(block), 3, 2);
+    EXPECT_EQ(pixels.size(), 3 * 2 * 4);
+    expectPixel(pixels, 3, 1, 1, 255, 138, 2, 255);
+    expectPixel(pixels, 3, 2, 1, 47, 183, 255, 255);
+
+    uint8_t rgb565[4 * 4 * 2];
+    EXPECT_TRUE(cc::decodeCompressedTexture(cc::gfx::Format::ETC_RGB8, block, sizeof(block), 4, 4, cc::DecodedTextureFormat::RGB565, rgb565, false));
+    const uint16_t expected = ((255 >> 3) << 11) | ((138 >> 2) << 5) | (2 >> 3);
+    EXPECT_EQ(rgb565[0] | (rgb565[1] << 8), expected);
+}
+
+TEST(textureDecoderTest, rejectsInvalidInput) {
+    uint8_t block[8] = {};
+    uint8_t pixels[64];
+    EXPECT_FALSE(cc::isSoftwareDecodable(cc::gfx::Format::PVRTC_RGBA4));
+    EXPECT_FALSE(cc::decodeCompressedTexture(cc::gfx::Format::PVRTC_RGBA4, block, sizeof(block), 4, 4, cc::DecodedTextureFormat::RGBA8, pixels));
+    EXPECT_FALSE(cc::decodeCompressedTexture(cc::gfx::Format::ETC_RGB8, block, sizeof(block), 8, 4, cc::DecodedTextureFormat::RGBA8, pixels));
+}
@@ -0,0 +1,126 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/base/ValueBinary.h"
+#include <cstring>
+
+namespace {
+
+cc::ValueMap makeSample() {
+    cc::ValueMap frame;
+    frame["frame"] = cc::Value("{{2,2},{64,32}}");
+    frame["rotated"] = cc::Value(true);
+    frame["offset"] = cc::Value(-1.5);
+
+    cc::ValueMap frames;
+    frames["hero_01.png"] = cc::Value(frame);
+    frames["hero_02.png"] = cc::Value(frame);
+
+    cc::ValueVector ints{cc::Value(1), cc::Value(-2), cc::Value(3)};
+    cc::ValueVector floats{cc::Value(0.5F), cc::Value(1.25F)};
+    cc::ValueVector doubles{cc::Value(0.1), cc::Value(2.5)};
+    cc::ValueVector mixed{cc::Value("a"), cc::Value(7), cc::Value(cc::ValueVector())};
+
+    cc::ValueMapIntKey byId;
+    byId[42] = cc::Value("answer");
+    byId[-1] = cc::Value(static_cast<unsigned char>(9));
+
+    cc::ValueMap root;
+    root["frames"] = cc::Value(frames);
+    root["ints"] = cc::Value(ints);
+    root["floats"] = cc::Value(floats);
+    root["doubles"] = cc::Value(doubles);
+    root["mixed"] = cc::Value(mixed);
+    root["byId"] = cc::Value(byId);
+    root["count"] = cc::Value(3U);
+    root["empty"] = cc::Value(cc::ValueMap());
+    return root;
+}
+
+} // namespace
+
+TEST(valueBinaryTest, roundTrip) {
+    cc::ValueMap sample = makeSample();
+    auto encoded = cc::encodeBinaryValue(sample);
+    ASSERT_TRUE(cc::BinaryValueReader::isBinaryValue(encoded.data(), encoded.size()));
+
+    cc::BinaryValueReader reader(encoded.data(), encoded.size());
+    ASSERT_TRUE(reader.isValid());
+    cc::ValueMap decoded = reader.getRoot().toValueMap();
+    EXPECT_EQ(cc::Value(decoded), cc::Value(sample));
+}
+
+TEST(valueBinaryTest, lazyLookup) {
+    auto encoded = cc::encodeBinaryValue(makeSample());
+    cc::BinaryValueReader reader(encoded.data(), encoded.size());
+    auto root = reader.getRoot();
+
+    auto frame = root.find("frames").find("hero_02.png");
+    EXPECT_EQ(frame.getType(), cc::Value::Type::MAP);
+    EXPECT_STREQ(frame.find("frame").asCString(), "{{2,2},{64,32}}");
+    EXPECT_TRUE(frame.find("rotated").asBool());
+    EXPECT_DOUBLE_EQ(frame.find("offset").asDouble(), -1.5);
+    EXPECT_TRUE(root.find("frames").find("hero_03.png").isNull());
+
+    auto ints = root.find("ints");
+    EXPECT_EQ(ints.getType(), cc::Value::Type::VECTOR);
+    EXPECT_EQ(ints.size(), 3U);
+    EXPECT_EQ(ints[1].asInt(), -2);
+    EXPECT_TRUE(ints[3].isNull());
+    EXPECT_FLOAT_EQ(root.find("floats")[1].asFloat(), 1.25F);
+    EXPECT_DOUBLE_EQ(root.find("doubles")[0].asDouble(), 0.1);
+
+    EXPECT_STREQ(root.find("byId").find(42).asCString(), "answer");
+    EXPECT_EQ(root.find("byId").find(-1).asByte(), 9);
+    EXPECT_EQ(root.find("count").asUnsignedInt(), 3U);
+
+    // keys are sorted
+    EXPECT_STREQ(root.keyAt(0), "byId");
+    EXPECT_STREQ(root.keyAt(7), "mixed");
+    EXPECT_EQ(root.keyAt(8), nullptr);
+}
+
+TEST(valueBinaryTest, internsStrings) {
+    cc::ValueVector repeated(100, cc::Value("the same rather long string value"));
+    auto encoded = cc::encodeBinaryValue(repeated);
+    EXPECT_LT(encoded.size(), 100 * 8 + 200);
+}
+
+TEST(valueBinaryTest, rejectsCorruptedData) {
+    auto encoded = cc::encodeBinaryValue(makeSample());
+    for (size_t size = 0; size < encoded.size(); ++size) {
+        cc::BinaryValueReader reader(encoded.data(), size);
+        reader.getRoot().toValue();
+    }
+
+    auto corrupted = encoded;
+    for (size_t i = 16; i < corrupted.size(); i += 3) {
+        corrupted[i] ^= 0x5A;
+        cc::BinaryValueReader reader(corrupted.data(), corrupted.size());
+        reader.getRoot().toValue();
+    }
+
+    const char xml[] = "<?xml version=\"1.0\"?><plist></plist>";
+    EXPECT_FALSE(cc::BinaryValueReader::isBinaryValue(xml, sizeof(xml)));
+}